@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ *
+ * \ingroup http
+ * \brief Memory footprint of ThreeGppHttpSatelliteClient applications.
+ *
+ * The benchmark creates a number of clients in the same way as
+ * ThreeGppHttpSatelliteClientHelper does, i.e., through an ObjectFactory, and
+ * measures the growth of the heap in between. Only the applications are
+ * counted, not the nodes, Internet stacks, or sockets of a complete scenario.
+ * Each client creates its private ThreeGppHttpVariables instance upon
+ * construction. Optionally, the clients share a single instance instead (see
+ * ThreeGppHttpHelper::SetShareVariables()) and have their `Rx` trace source
+ * connected, which shows the cost of the first connected trace source.
+ *
+ * The result is printed in CSV format, e.g.:
+ *
+ *     $ ./ns3 run "http-client-memory-benchmark --clients=100000 --shareVariables=1"
+ *     clients,share_variables,connected_traces,object_bytes,heap_bytes_per_client
+ *     100000,1,0,...
+ *
+ * The object size is `sizeof (ThreeGppHttpSatelliteClient)`, and the heap
+ * bytes per client include it. The heap usage is read with `mallinfo2 ()`,
+ * so the last column is only available with the GNU C library 2.33 or later.
+ */
+
+#include <ns3/applications-module.h>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/traffic-module.h>
+
+#include <iostream>
+#include <vector>
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HTTP_CLIENT_MEMORY_BENCHMARK_MALLINFO
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("HttpClientMemoryBenchmark");
+
+/**
+ * \return the number of bytes currently allocated from the heap, or zero if
+ *         not available.
+ */
+static uint64_t
+GetHeapUsage()
+{
+#ifdef HTTP_CLIENT_MEMORY_BENCHMARK_MALLINFO
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+/// A trace sink which does nothing.
+static void
+RxSink(Ptr<const Packet> packet, const Address& from)
+{
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numOfClients = 100000;
+    bool shareVariables = false;
+    bool connectTraces = false;
+
+    CommandLine cmd;
+    cmd.AddValue("clients", "Number of clients to create", numOfClients);
+    cmd.AddValue("shareVariables",
+                 "Let all clients share one ThreeGppHttpVariables instance",
+                 shareVariables);
+    cmd.AddValue("connectTraces", "Connect the Rx trace source of every client", connectTraces);
+    cmd.Parse(argc, argv);
+
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::ThreeGppHttpSatelliteClient");
+    if (shareVariables)
+    {
+        factory.Set("Variables", PointerValue(CreateObject<ThreeGppHttpVariables>()));
+    }
+
+    std::vector<Ptr<ThreeGppHttpSatelliteClient>> clients;
+    clients.reserve(numOfClients);
+
+    // The first client initializes the type and attribute information, which
+    // is not part of the footprint of each client.
+    Ptr<ThreeGppHttpSatelliteClient> warmUp = factory.Create<ThreeGppHttpSatelliteClient>();
+
+    const uint64_t heapBefore = GetHeapUsage();
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        Ptr<ThreeGppHttpSatelliteClient> client = factory.Create<ThreeGppHttpSatelliteClient>();
+        if (connectTraces)
+        {
+            client->TraceConnectWithoutContext("Rx", MakeCallback(&RxSink));
+        }
+        clients.push_back(client);
+    }
+    const uint64_t heapAfter = GetHeapUsage();
+
+    const double bytesPerClient =
+        (numOfClients > 0 && heapAfter > heapBefore)
+            ? static_cast<double>(heapAfter - heapBefore) / numOfClients
+            : 0.0;
+
+    std::cout << "clients,share_variables,connected_traces,object_bytes,heap_bytes_per_client"
+              << std::endl;
+    std::cout << numOfClients << "," << shareVariables << "," << connectTraces << ","
+              << sizeof(ThreeGppHttpSatelliteClient) << "," << bytesPerClient << std::endl;
+
+#ifndef HTTP_CLIENT_MEMORY_BENCHMARK_MALLINFO
+    std::cerr << "Heap usage is not available on this platform" << std::endl;
+#endif
+
+    clients.clear();
+    warmUp = nullptr;
+    Simulator::Destroy();
+    return 0;
+}
@@ -112,15 +112,15 @@ main(int argc, char* argv[])
         LogComponentEnable("NrtvTcpClient", LOG_DEBUG);
         LogComponentEnable("NrtvTcpServer", LOG_DEBUG);
 
-        LogComponentEnable("PacketSink", LOG_PREFIX_ALL);
+        LogComponentEnable("NrtvUdpClient", LOG_PREFIX_ALL);
         LogComponentEnable("NrtvUdpServer", LOG_PREFIX_ALL);
-        LogComponentEnable("PacketSink", LOG_WARN);
+        LogComponentEnable("NrtvUdpClient", LOG_WARN);
         LogComponentEnable("NrtvUdpServer", LOG_WARN);
-        LogComponentEnable("PacketSink", LOG_ERROR);
+        LogComponentEnable("NrtvUdpClient", LOG_ERROR);
         LogComponentEnable("NrtvUdpServer", LOG_ERROR);
-        LogComponentEnable("PacketSink", LOG_INFO);
+        LogComponentEnable("NrtvUdpClient", LOG_INFO);
         LogComponentEnable("NrtvUdpServer", LOG_INFO);
-        LogComponentEnable("PacketSink", LOG_DEBUG);
+        LogComponentEnable("NrtvUdpClient", LOG_DEBUG);
         LogComponentEnable("NrtvUdpServer", LOG_DEBUG);
     }
     /// End of log components ///
@@ -32,6 +32,12 @@
  *
  *     $ ./waf --run="nrtv-variables-plot --numOfSamples=1000000"
  *
+ * The samples may be drawn by several threads in parallel, each of them using
+ * its own NrtvVariables instance with a different stream number, i.e., an
+ * independent random number substream, for example:
+ *
+ *     $ ./waf --run="nrtv-variables-plot --numOfSamples=10000000 --numOfThreads=4"
+ *
  * The script generates the following files in the ns-3 project root directory:
  * - `nrtv-slice-size.plt`
  * - `nrtv-slice-encoding-delay.plt`
@@ -62,52 +68,82 @@ int
 main(int argc, char* argv[])
 {
     uint32_t numOfSamples = 100000;
+    uint32_t numOfThreads = 1;
 
     // read command line arguments given by the user
     CommandLine cmd;
     cmd.AddValue("numOfSamples",
                  "Number of samples taken from each random number distribution",
                  numOfSamples);
+    cmd.AddValue("numOfThreads",
+                 "Number of threads drawing the samples in parallel",
+                 numOfThreads);
     cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(numOfThreads == 0, "At least one thread is required");
 
-    Ptr<NrtvVariables> nrtvVariables = CreateObject<NrtvVariables>();
-    // nrtvVariables->SetStream (99);
+    // one instance per thread, each using an independent substream
+    std::vector<Ptr<NrtvVariables>> nrtvVariables;
+    std::vector<Callback<uint32_t>> numOfFrames;
+    std::vector<Callback<uint32_t>> sliceSize;
+    std::vector<Callback<uint64_t>> sliceEncodingDelay;
+    std::vector<Callback<double>> idleTime;
+    for (uint32_t i = 0; i < numOfThreads; i++)
+    {
+        Ptr<NrtvVariables> variables = CreateObject<NrtvVariables>();
+        if (numOfThreads > 1)
+        {
+            variables->SetStream(i);
+        }
+        nrtvVariables.push_back(variables);
+        numOfFrames.push_back(MakeCallback(&NrtvVariables::GetNumOfFrames, variables));
+        sliceSize.push_back(MakeCallback(&NrtvVariables::GetSliceSize, variables));
+        sliceEncodingDelay.push_back(
+            MakeCallback(&NrtvVariables::GetSliceEncodingDelayMilliSeconds, variables));
+        idleTime.push_back(MakeCallback(&NrtvVariables::GetIdleTimeSeconds, variables));
+    }
 
-    HistogramPlotHelper::Plot<uint32_t>(MakeCallback(&NrtvVariables::GetNumOfFrames, nrtvVariables),
-                                        "nrtv-num-of-frames",
-                                        "Histogram of number of frames in NRTV traffic model",
-                                        "Number of frames",
-                                        numOfSamples,
-                                        100, // bin width = 100 frames
-                                        static_cast<double>(nrtvVariables->GetNumOfFramesMean()));
+    Ptr<NrtvVariables> first = nrtvVariables.front();
+    const double numOfFramesMean = static_cast<double>(first->GetNumOfFramesMean());
+    const double sliceEncodingDelayMean = first->GetSliceEncodingDelayMean().GetMilliSeconds();
+    const double sliceEncodingDelayMax = first->GetSliceEncodingDelayMax().GetMilliSeconds();
+    const double idleTimeMean = first->GetIdleTimeMean().GetSeconds();
 
-    HistogramPlotHelper::Plot<uint32_t>(MakeCallback(&NrtvVariables::GetSliceSize, nrtvVariables),
-                                        "nrtv-slice-size",
-                                        "Histogram of slice size in NRTV traffic model",
-                                        "Slice size (in bytes)",
-                                        numOfSamples,
-                                        5, // bin width = 5 bytes
-                                        nrtvVariables->GetSliceSizeMean(),
-                                        nrtvVariables->GetSliceSizeMax());
+    HistogramPlotHelper::Plot<uint32_t>(
+        numOfFrames,
+        "nrtv-num-of-frames",
+        "Histogram of number of frames in NRTV traffic model",
+        "Number of frames",
+        numOfSamples,
+        HistogramPlotHelper::Histogram(100, 2 * exp(1) * numOfFramesMean), // 100 frames
+        numOfFramesMean);
+
+    HistogramPlotHelper::Plot<uint32_t>(
+        sliceSize,
+        "nrtv-slice-size",
+        "Histogram of slice size in NRTV traffic model",
+        "Slice size (in bytes)",
+        numOfSamples,
+        HistogramPlotHelper::Histogram(5, 1.1 * first->GetSliceSizeMax()), // 5 bytes
+        first->GetSliceSizeMean());
 
     HistogramPlotHelper::Plot<uint64_t>(
-        MakeCallback(&NrtvVariables::GetSliceEncodingDelayMilliSeconds, nrtvVariables),
+        sliceEncodingDelay,
         "nrtv-slice-encoding-delay",
         "Histogram of slice encoding delay in NRTV traffic model",
         "Slice encoding delay (in milliseconds)",
         numOfSamples,
-        1, // bin width = 1 ms
-        nrtvVariables->GetSliceEncodingDelayMean().GetMilliSeconds(),
-        nrtvVariables->GetSliceEncodingDelayMax().GetMilliSeconds());
+        HistogramPlotHelper::Histogram(1, 1.1 * sliceEncodingDelayMax), // 1 ms
+        sliceEncodingDelayMean);
 
+    // the idle time spans several orders of magnitude, hence the log-scaled bins
     HistogramPlotHelper::Plot<double>(
-        MakeCallback(&NrtvVariables::GetIdleTimeSeconds, nrtvVariables),
+        idleTime,
         "nrtv-idle-time",
         "Histogram of client idle time in NRTV traffic model",
         "Idle time (in seconds)",
         numOfSamples,
-        1, // bar width = 1 second
-        nrtvVariables->GetIdleTimeMean().GetSeconds());
+        HistogramPlotHelper::Histogram::CreateLogScale(0.01, 10, 100 * idleTimeMean),
+        idleTimeMean);
 
     return 0;
 
@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ *
+ * \ingroup applicationstats
+ * \brief Micro-benchmark of the sender identifier look-up used by the
+ *        application statistics helpers with the `SENDER` identifier type.
+ *
+ * The benchmark emulates the per-packet work done by the trace sinks of
+ * ApplicationStatsDelayHelper and ApplicationStatsThroughputHelper, i.e.,
+ * resolving the sender address into an identifier and forwarding a sample to
+ * the collector associated with that identifier. Two implementations are
+ * compared:
+ * - `map`: the former implementation, based on an ordered map of Address
+ *   followed by a CollectorMap::Get() and a GetObject() call; and
+ * - `table`: the current implementation, based on
+ *   ApplicationStatsAddressTable and a vector of collectors.
+ *
+ * The result is printed as the number of callbacks per second, e.g.:
+ *
+ *     $ ./ns3 run "stats-address-lookup-benchmark --senders=10000"
+ */
+
+#include <ns3/application-stats-address-table.h>
+#include <ns3/collector-map.h>
+#include <ns3/core-module.h>
+#include <ns3/enum.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/unit-conversion-collector.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("StatsAddressLookupBenchmark");
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numOfSenders = 1000;
+    uint32_t numOfCallbacks = 10000000;
+    uint32_t subnetStride = 1;
+
+    CommandLine cmd;
+    cmd.AddValue("senders", "Number of sender addresses (and identifiers)", numOfSenders);
+    cmd.AddValue("callbacks", "Number of callbacks to be executed", numOfCallbacks);
+    cmd.AddValue("stride",
+                 "Distance between consecutive sender addresses, "
+                 "use a large value to emulate sparse addressing",
+                 subnetStride);
+    cmd.Parse(argc, argv);
+
+    // Prepare the senders' addresses and the identifiers associated with them.
+    const Ipv4Address base("10.0.0.1");
+    std::vector<Address> senders;
+    std::map<const Address, uint32_t> identifierMap;
+    ApplicationStatsAddressTable addressTable;
+    for (uint32_t i = 0; i < numOfSenders; i++)
+    {
+        const Ipv4Address addr(base.Get() + i * subnetStride);
+        senders.push_back(InetSocketAddress(addr, 9));
+        identifierMap[addr] = i;
+        addressTable.Add(addr, i);
+    }
+    addressTable.Build();
+
+    // Prepare one collector per identifier.
+    CollectorMap collectorMap;
+    collectorMap.SetType("ns3::UnitConversionCollector");
+    collectorMap.SetAttribute("ConversionType", EnumValue(UnitConversionCollector::TRANSPARENT));
+    std::vector<Ptr<UnitConversionCollector>> collectorList;
+    for (uint32_t i = 0; i < numOfSenders; i++)
+    {
+        collectorMap.Create(i);
+        collectorList.push_back(collectorMap.Get(i)->GetObject<UnitConversionCollector>());
+    }
+
+    // Use a fixed pseudo-random order of senders, shared by both runs.
+    std::vector<uint32_t> order(numOfCallbacks);
+    uint32_t x = 1;
+    for (uint32_t i = 0; i < numOfCallbacks; i++)
+    {
+        x = x * 1664525 + 1013904223; // linear congruential generator
+        order[i] = x % numOfSenders;
+    }
+
+    // The former implementation.
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numOfCallbacks; i++)
+    {
+        const Address& from = senders[order[i]];
+        const Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
+        std::map<const Address, uint32_t>::const_iterator it = identifierMap.find(ipv4Addr);
+        NS_ASSERT(it != identifierMap.end());
+        Ptr<DataCollectionObject> collector = collectorMap.Get(it->second);
+        Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector>();
+        c->TraceSinkDouble(0.0, 1.0);
+    }
+    const double mapSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The current implementation.
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numOfCallbacks; i++)
+    {
+        const Address& from = senders[order[i]];
+        const Ipv4Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
+        const uint32_t identifier = addressTable.Lookup(ipv4Addr);
+        NS_ASSERT(identifier != ApplicationStatsAddressTable::INVALID_IDENTIFIER);
+        collectorList[identifier]->TraceSinkDouble(0.0, 1.0);
+    }
+    const double tableSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "senders= " << numOfSenders << " callbacks= " << numOfCallbacks
+              << " table= " << (addressTable.IsDense() ? "direct-indexed" : "sorted") << std::endl;
+    std::cout << "map:   " << numOfCallbacks / mapSeconds << " callbacks/s" << std::endl;
+    std::cout << "table: " << numOfCallbacks / tableSeconds << " callbacks/s" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+
+} // end of `int main (int argc, char *argv[])`
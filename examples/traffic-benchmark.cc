@@ -0,0 +1,635 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ *
+ * \ingroup traffic
+ * \brief Benchmark suite of the traffic module's hot paths.
+ *
+ * Two kinds of benchmarks are included:
+ * - scenario benchmarks (`nrtv-tcp`, `nrtv-udp`, `http`, and `cbr`), which
+ *   simulate one server connected to N clients through point-to-point links
+ *   (a star topology) and measure the number of events executed per second and
+ *   the wall-clock time spent per simulated second; and
+ * - micro-benchmarks (`rx-buffer`, `header`, and `stats`), which repeat
+ *   operations on NrtvTcpClientRxBuffer, NrtvHeader, and the sinks of the
+ *   application statistics helpers, and measure the number of operations per
+ *   second. See also stats-address-lookup-benchmark for the sender identifier
+ *   look-up of the statistics helpers.
+ *
+ * Every scenario benchmark runs once for each number of clients given in the
+ * `clients` argument. With `stats=true`, the global throughput (and delay, if
+ * the client exports an `RxDelay` trace source) statistics are installed with
+ * the `OUTPUT_SUMMARY` output type, so that the cost of the statistics
+ * callbacks can be seen by comparing with a run without them. If the module is
+ * built with its instrumentation counters (see TrafficCounterRegistry), the
+ * counters of each scenario run are dumped into a separate text file.
+ *
+ * The results are printed in CSV format, one row per measurement, e.g.:
+ *
+ *     $ ./ns3 run "traffic-benchmark --benchmarks=nrtv-tcp,header --clients=10,100"
+ *     benchmark,clients,operations,sim_seconds,setup_seconds,wall_seconds,...
+ *     nrtv-tcp,10,...
+ *
+ * The columns are: the benchmark name, the number of clients (zero for
+ * micro-benchmarks), the number of events executed (or operations repeated),
+ * the simulated time, the wall-clock time of setting up the scenario, the
+ * wall-clock time of the simulation (or the repetitions), the operations per
+ * wall-clock second, and the wall-clock seconds per simulated second (zero for
+ * micro-benchmarks). The `output` argument writes the same rows into a file.
+ */
+
+#include <ns3/applications-module.h>
+#include <ns3/core-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/network-module.h>
+#include <ns3/point-to-point-module.h>
+#include <ns3/traffic-module.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TrafficBenchmark");
+
+/// Clock used for all measurements.
+typedef std::chrono::steady_clock BenchmarkClock;
+
+/// One row of the results.
+struct BenchmarkResult
+{
+    std::string name;    ///< Name of the benchmark.
+    uint32_t clients;    ///< Number of clients, or zero for micro-benchmarks.
+    uint64_t operations; ///< Number of events (or operations) executed.
+    double simSeconds;   ///< Simulated time, or zero for micro-benchmarks.
+    double setupSeconds; ///< Wall-clock time of setting up the scenario.
+    double wallSeconds;  ///< Wall-clock time of the measurement.
+};
+
+/**
+ * \param start the beginning of the measured period.
+ * \return the wall-clock seconds elapsed since `start`.
+ */
+static double
+GetElapsedSeconds(BenchmarkClock::time_point start)
+{
+    return std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+}
+
+/**
+ * \param os the output stream.
+ */
+static void
+PrintHeading(std::ostream& os)
+{
+    os << "benchmark,clients,operations,sim_seconds,setup_seconds,wall_seconds,"
+       << "operations_per_second,wall_seconds_per_sim_second\n";
+}
+
+/**
+ * \param os the output stream.
+ * \param result the result to print as a CSV row.
+ */
+static void
+PrintResult(std::ostream& os, const BenchmarkResult& result)
+{
+    const double opsPerSecond =
+        (result.wallSeconds > 0.0) ? (result.operations / result.wallSeconds) : 0.0;
+    const double wallPerSimSecond =
+        (result.simSeconds > 0.0) ? (result.wallSeconds / result.simSeconds) : 0.0;
+    os << result.name << "," << result.clients << "," << result.operations << ","
+       << result.simSeconds << "," << result.setupSeconds << "," << result.wallSeconds << ","
+       << opsPerSecond << "," << wallPerSimSecond << "\n";
+}
+
+/**
+ * \param str a comma-separated list.
+ * \return the non-empty items of the list.
+ */
+static std::vector<std::string>
+SplitList(const std::string& str)
+{
+    std::vector<std::string> items;
+    std::istringstream iss(str);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// SCENARIO BENCHMARKS ////////////////////////////////////////////////////////
+
+/// Nodes and addresses of the star topology.
+struct StarTopology
+{
+    Ptr<Node> server;                     ///< The hub node.
+    NodeContainer clients;                ///< The leaf nodes.
+    std::vector<Ipv4Address> serverAddrs; ///< Address of the server on each link.
+    std::vector<Ipv4Address> clientAddrs; ///< Address of each client.
+};
+
+/**
+ * \param numOfClients number of leaf nodes.
+ * \return a server connected to every client by a dedicated point-to-point link.
+ *
+ * Every link has its own /30 subnet, so the server reaches its clients through
+ * the routes of its directly connected interfaces, while every client reaches
+ * the server through the address of the server on the same link. Thus, no
+ * global routing is needed, even with thousands of clients.
+ */
+static StarTopology
+CreateStarTopology(uint32_t numOfClients)
+{
+    StarTopology star;
+    star.server = CreateObject<Node>();
+    star.clients.Create(numOfClients);
+
+    InternetStackHelper stack;
+    stack.Install(star.server);
+    stack.Install(star.clients);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    for (uint32_t i = 0; i < numOfClients; i++)
+    {
+        NetDeviceContainer devices = pointToPoint.Install(star.server, star.clients.Get(i));
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+        star.serverAddrs.push_back(interfaces.GetAddress(0));
+        star.clientAddrs.push_back(interfaces.GetAddress(1));
+        address.NewNetwork();
+    }
+
+    return star;
+
+} // end of `StarTopology CreateStarTopology (uint32_t)`
+
+/**
+ * \param star the topology.
+ * \param protocolTid either TcpSocketFactory or UdpSocketFactory.
+ * \param[out] senders the NRTV server.
+ * \param[out] receivers the NRTV clients.
+ *
+ * Equivalent with NrtvHelper::InstallUsingIpv4(), except that each client is
+ * given the server address on its own link.
+ */
+static void
+InstallNrtv(const StarTopology& star,
+            TypeId protocolTid,
+            ApplicationContainer& senders,
+            ApplicationContainer& receivers)
+{
+    NrtvServerHelper serverHelper(protocolTid, Address());
+    if (protocolTid == TcpSocketFactory::GetTypeId())
+    {
+        serverHelper.SetAttribute("LocalAddress", AddressValue(Ipv4Address::GetAny()));
+        senders = serverHelper.Install(star.server);
+        for (uint32_t i = 0; i < star.clients.GetN(); i++)
+        {
+            NrtvClientHelper clientHelper(protocolTid, star.serverAddrs[i]);
+            receivers.Add(clientHelper.Install(star.clients.Get(i)));
+        }
+    }
+    else
+    {
+        senders = serverHelper.Install(star.server);
+        Ptr<NrtvUdpServer> serverApp = senders.Get(0)->GetObject<NrtvUdpServer>();
+        NS_ASSERT(serverApp != nullptr);
+        for (uint32_t i = 0; i < star.clients.GetN(); i++)
+        {
+            const InetSocketAddress local(star.clientAddrs[i], serverApp->GetRemotePort());
+            NrtvClientHelper clientHelper(protocolTid, local);
+            receivers.Add(clientHelper.Install(star.clients.Get(i)));
+            serverApp->AddClient(star.clientAddrs[i]);
+        }
+    }
+}
+
+/**
+ * \param star the topology.
+ * \param[out] senders the HTTP server.
+ * \param[out] receivers the HTTP clients.
+ */
+static void
+InstallHttp(const StarTopology& star,
+            ApplicationContainer& senders,
+            ApplicationContainer& receivers)
+{
+    ThreeGppHttpServerHelper serverHelper(Ipv4Address::GetAny());
+    senders = serverHelper.Install(star.server);
+    for (uint32_t i = 0; i < star.clients.GetN(); i++)
+    {
+        ThreeGppHttpSatelliteClientHelper clientHelper(star.serverAddrs[i]);
+        receivers.Add(clientHelper.Install(star.clients.Get(i)));
+    }
+}
+
+/**
+ * \param star the topology.
+ * \param[out] senders the CBR applications, one in each client.
+ * \param[out] receivers the packet sink in the server.
+ */
+static void
+InstallCbr(const StarTopology& star,
+           ApplicationContainer& senders,
+           ApplicationContainer& receivers)
+{
+    const uint16_t port = 9;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    receivers = sinkHelper.Install(star.server);
+    for (uint32_t i = 0; i < star.clients.GetN(); i++)
+    {
+        CbrHelper cbrHelper("ns3::UdpSocketFactory", InetSocketAddress(star.serverAddrs[i], port));
+        senders.Add(cbrHelper.Install(star.clients.Get(i)));
+    }
+}
+
+/**
+ * \brief Simulate a scenario benchmark.
+ * \param name name of the scenario.
+ * \param numOfClients number of clients.
+ * \param simTime length of the simulation.
+ * \param enableStats whether to install the statistics helpers.
+ * \return the measurement.
+ */
+static BenchmarkResult
+RunScenario(const std::string& name, uint32_t numOfClients, Time simTime, bool enableStats)
+{
+    NS_LOG_FUNCTION(name << numOfClients << simTime << enableStats);
+
+    BenchmarkResult result;
+    result.name = enableStats ? (name + "-stats") : name;
+    result.clients = numOfClients;
+    result.simSeconds = simTime.GetSeconds();
+
+    const BenchmarkClock::time_point setupStart = BenchmarkClock::now();
+    const StarTopology star = CreateStarTopology(numOfClients);
+    ApplicationContainer senders;
+    ApplicationContainer receivers;
+    if (name == "nrtv-tcp")
+    {
+        InstallNrtv(star, TcpSocketFactory::GetTypeId(), senders, receivers);
+    }
+    else if (name == "nrtv-udp")
+    {
+        InstallNrtv(star, UdpSocketFactory::GetTypeId(), senders, receivers);
+    }
+    else if (name == "http")
+    {
+        InstallHttp(star, senders, receivers);
+    }
+    else
+    {
+        NS_ASSERT(name == "cbr");
+        InstallCbr(star, senders, receivers);
+    }
+
+    Ptr<ApplicationStatsHelperContainer> stat;
+    if (enableStats)
+    {
+        stat = CreateObject<ApplicationStatsHelperContainer>();
+        stat->SetName("traffic-benchmark-" + name);
+        stat->AddSenderApplications(senders);
+        stat->AddReceiverApplications(receivers);
+        stat->SetTraceSourceName("Rx");
+        stat->AddGlobalThroughput(ApplicationStatsHelper::OUTPUT_SUMMARY);
+        TypeId::TraceSourceInformation info;
+        if (receivers.Get(0)->GetInstanceTypeId().LookupTraceSourceByName("RxDelay", &info))
+        {
+            stat->SetTraceSourceName("RxDelay");
+            stat->AddGlobalDelay(ApplicationStatsHelper::OUTPUT_SUMMARY);
+        }
+    }
+    result.setupSeconds = GetElapsedSeconds(setupStart);
+
+    const uint64_t eventsBefore = Simulator::GetEventCount();
+    const BenchmarkClock::time_point runStart = BenchmarkClock::now();
+    Simulator::Stop(simTime);
+    Simulator::Run();
+    result.wallSeconds = GetElapsedSeconds(runStart);
+    result.operations = Simulator::GetEventCount() - eventsBefore;
+
+    stat = nullptr;
+    Simulator::Destroy();
+
+    if (TrafficCounterRegistry::IsEnabled())
+    {
+        std::ostringstream oss;
+        oss << "traffic-benchmark-" << result.name << "-" << numOfClients << "-counters.txt";
+        TrafficCounterRegistry::DumpToFile(oss.str());
+        TrafficCounterRegistry::Clear();
+    }
+
+    return result;
+
+} // end of `BenchmarkResult RunScenario (...)`
+
+// MICRO-BENCHMARKS ///////////////////////////////////////////////////////////
+
+/**
+ * \param sliceSize content size of each video slice.
+ * \param segmentSize size of the TCP segments delivering the slices.
+ * \param iterations number of slices to push and pop.
+ * \param reassemble whether to pop the slices by PopVideoSlice() instead of
+ *                   PopVideoSliceHeader().
+ * \return the measurement, counting slices as operations.
+ */
+static BenchmarkResult
+RunRxBuffer(uint32_t sliceSize, uint32_t segmentSize, uint64_t iterations, bool reassemble)
+{
+    BenchmarkResult result;
+    result.name = reassemble ? "rx-buffer-pop-slice" : "rx-buffer-pop-header";
+    result.clients = 0;
+    result.simSeconds = 0.0;
+    result.operations = iterations;
+
+    // Split one slice into segments, which are then pushed over and over again.
+    const BenchmarkClock::time_point setupStart = BenchmarkClock::now();
+    NrtvHeader header;
+    header.SetNumOfFrames(1);
+    header.SetNumOfSlices(1);
+    header.SetSliceSize(sliceSize);
+    Ptr<Packet> slice = Create<Packet>(sliceSize);
+    slice->AddHeader(header);
+    std::vector<Ptr<const Packet>> segments;
+    for (uint32_t offset = 0; offset < slice->GetSize(); offset += segmentSize)
+    {
+        const uint32_t length = std::min(segmentSize, slice->GetSize() - offset);
+        segments.push_back(slice->CreateFragment(offset, length));
+    }
+    Ptr<NrtvTcpClientRxBuffer> rxBuffer = Create<NrtvTcpClientRxBuffer>();
+    result.setupSeconds = GetElapsedSeconds(setupStart);
+
+    uint64_t popped = 0;
+    const BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        for (const Ptr<const Packet>& segment : segments)
+        {
+            rxBuffer->PushPacket(segment);
+        }
+        while (rxBuffer->HasVideoSlice())
+        {
+            if (reassemble)
+            {
+                popped += rxBuffer->PopVideoSlice()->GetSize();
+            }
+            else
+            {
+                popped += rxBuffer->PopVideoSliceHeader().GetSliceSize();
+            }
+        }
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+
+    NS_ABORT_MSG_UNLESS(rxBuffer->IsEmpty() && popped > 0, "Corrupted Rx buffer");
+    return result;
+
+} // end of `BenchmarkResult RunRxBuffer (...)`
+
+/**
+ * \param iterations number of headers to add and remove.
+ * \return the measurements of NrtvHeader serialization, deserialization, and
+ *         NrtvHeader::PeekSliceSize().
+ */
+static std::vector<BenchmarkResult>
+RunHeader(uint64_t iterations)
+{
+    std::vector<BenchmarkResult> results;
+    BenchmarkResult result;
+    result.clients = 0;
+    result.simSeconds = 0.0;
+    result.setupSeconds = 0.0;
+    result.operations = iterations;
+
+    NrtvHeader header;
+    header.SetNumOfFrames(100);
+    header.SetNumOfSlices(4);
+    header.SetSliceSize(1100);
+    uint64_t checksum = 0;
+
+    result.name = "header-serialize";
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        Ptr<Packet> packet = Create<Packet>(1100);
+        header.SetFrameNumber(i % 100);
+        packet->AddHeader(header);
+        checksum += packet->GetSize();
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+    results.push_back(result);
+
+    Ptr<Packet> packet = Create<Packet>(1100);
+    packet->AddHeader(header);
+
+    result.name = "header-deserialize";
+    start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        NrtvHeader copy;
+        packet->PeekHeader(copy);
+        checksum += copy.GetSliceSize();
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+    results.push_back(result);
+
+    result.name = "header-peek-slice-size";
+    start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        checksum += NrtvHeader::PeekSliceSize(packet);
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+    results.push_back(result);
+
+    NS_LOG_INFO("Checksum " << checksum);
+    return results;
+
+} // end of `std::vector<BenchmarkResult> RunHeader (uint64_t)`
+
+/**
+ * \param iterations number of samples to pass to each sink.
+ * \return the measurements of the `OUTPUT_SUMMARY` sink (ApplicationStatsSummary),
+ *         the `OUTPUT_SCATTER_BINARY_FILE` sink (ApplicationStatsBinaryWriter),
+ *         and the jitter estimator of the NRTV client.
+ */
+static std::vector<BenchmarkResult>
+RunStats(uint64_t iterations)
+{
+    std::vector<BenchmarkResult> results;
+    BenchmarkResult result;
+    result.clients = 0;
+    result.simSeconds = 0.0;
+    result.setupSeconds = 0.0;
+    result.operations = iterations;
+
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    std::vector<double> samples(4096);
+    for (double& sample : samples)
+    {
+        sample = uniform->GetValue(0.001, 0.1);
+    }
+    const uint64_t mask = samples.size() - 1;
+
+    result.name = "stats-summary";
+    ApplicationStatsSummary summary;
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        summary.AddSample(samples[i & mask]);
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+    results.push_back(result);
+
+    result.name = "stats-binary-writer";
+    const std::string fileName = "traffic-benchmark-stats.bin";
+    {
+        Ptr<ApplicationStatsBinaryWriter> writer =
+            Create<ApplicationStatsBinaryWriter>(fileName,
+                                                 "time_sec",
+                                                 "delay_sec",
+                                                 std::vector<std::string>(1, "global"));
+        Callback<void, double, double> sink = writer->GetSink(0);
+        start = BenchmarkClock::now();
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            sink(i * 0.001, samples[i & mask]);
+        }
+        writer->Close();
+        result.wallSeconds = GetElapsedSeconds(start);
+    }
+    results.push_back(result);
+    std::remove(fileName.c_str());
+
+    result.name = "stats-jitter";
+    JitterEstimator jitter;
+    start = BenchmarkClock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        jitter.AddDelay(Seconds(samples[i & mask]));
+    }
+    result.wallSeconds = GetElapsedSeconds(start);
+    results.push_back(result);
+
+    NS_LOG_INFO("Mean " << summary.GetMean() << ", jitter " << jitter.GetJitter());
+    return results;
+
+} // end of `std::vector<BenchmarkResult> RunStats (uint64_t)`
+
+int
+main(int argc, char* argv[])
+{
+    std::string benchmarks = "nrtv-tcp,nrtv-udp,http,cbr,rx-buffer,header,stats";
+    std::string clients = "10,100,1000,10000";
+    double simTime = 10.0;
+    uint64_t iterations = 1000000;
+    bool enableStats = false;
+    std::string output;
+
+    CommandLine cmd;
+    cmd.AddValue("benchmarks", "Comma-separated list of benchmarks to run", benchmarks);
+    cmd.AddValue("clients", "Comma-separated list of numbers of clients", clients);
+    cmd.AddValue("simTime", "Simulation time of each scenario in seconds", simTime);
+    cmd.AddValue("iterations", "Number of repetitions of each micro-benchmark", iterations);
+    cmd.AddValue("stats", "Install the statistics helpers in the scenarios", enableStats);
+    cmd.AddValue("output", "Name of a CSV file to write the results into", output);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> numOfClients;
+    for (const std::string& item : SplitList(clients))
+    {
+        numOfClients.push_back(std::stoul(item));
+        NS_ABORT_MSG_IF(numOfClients.back() == 0, "The number of clients must be positive");
+    }
+
+    std::ofstream ofs;
+    if (!output.empty())
+    {
+        ofs.open(output.c_str());
+        NS_ABORT_MSG_UNLESS(ofs.is_open(), "Unable to open file " << output);
+        PrintHeading(ofs);
+    }
+    PrintHeading(std::cout);
+
+    for (const std::string& name : SplitList(benchmarks))
+    {
+        std::vector<BenchmarkResult> results;
+        if (name == "nrtv-tcp" || name == "nrtv-udp" || name == "http" || name == "cbr")
+        {
+            for (uint32_t n : numOfClients)
+            {
+                results.push_back(RunScenario(name, n, Seconds(simTime), enableStats));
+                PrintResult(std::cout, results.back());
+            }
+        }
+        else
+        {
+            if (name == "rx-buffer")
+            {
+                results.push_back(RunRxBuffer(1100, 536, iterations, false));
+                results.push_back(RunRxBuffer(1100, 536, iterations, true));
+            }
+            else if (name == "header")
+            {
+                results = RunHeader(iterations);
+            }
+            else if (name == "stats")
+            {
+                results = RunStats(iterations);
+            }
+            else
+            {
+                NS_FATAL_ERROR("Unknown benchmark " << name);
+            }
+
+            for (const BenchmarkResult& result : results)
+            {
+                PrintResult(std::cout, result);
+            }
+        }
+
+        if (ofs.is_open())
+        {
+            for (const BenchmarkResult& result : results)
+            {
+                PrintResult(ofs, result);
+            }
+        }
+    }
+
+    return 0;
+
+} // end of `int main (int argc, char *argv[])`
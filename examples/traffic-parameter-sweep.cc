@@ -0,0 +1,401 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ *
+ * \ingroup traffic
+ * \brief Parameter sweep of the NRTV or HTTP point-to-point scenario, running
+ *        independent replications in parallel.
+ *
+ * The sweep is defined by a grid of attribute default values and a number of
+ * replications (RNG runs). Every point of the cartesian product of the grid,
+ * combined with every run, is a job. Jobs are executed by a pool of at most
+ * `jobs` worker processes, each job in a freshly forked process, because the
+ * ns-3 simulator is a process-wide singleton and cannot host several
+ * simulations concurrently. Since the jobs share nothing, the throughput of
+ * the sweep scales with the number of cores.
+ *
+ * Every job installs the global throughput and delay statistics of the client
+ * with the `OUTPUT_SUMMARY` output type. After a job is finished, its summary
+ * files are merged into a single results table and then removed. Each row of
+ * the table contains the job index, the grid values, the run, the metric, and
+ * the columns of the summary file (count, mean, standard deviation, minimum,
+ * maximum, and the 50th, 95th, and 99th percentiles).
+ *
+ * The grid is a semicolon-separated list of attributes, each followed by a
+ * comma-separated list of values, e.g.:
+ *
+ *     $ ./ns3 run "traffic-parameter-sweep --scenario=nrtv --runs=10 --jobs=8
+ *           --grid=ns3::NrtvVariables::NumOfSlices=2,4,8;
+ *                  ns3::NrtvVariables::FrameInterval=42ms,100ms"
+ *
+ * (without the line break inside the grid)
+ *
+ * produces 3 x 2 x 10 = 60 jobs, whose results are written into
+ * "sweep-results.txt".
+ */
+
+#include <ns3/applications-module.h>
+#include <ns3/core-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/network-module.h>
+#include <ns3/point-to-point-module.h>
+#include <ns3/traffic-module.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TrafficParameterSweep");
+
+/// An attribute of the grid and the values it takes.
+struct SweepParameter
+{
+    std::string name;                ///< Full attribute name, e.g., "ns3::X::Y".
+    std::vector<std::string> values; ///< Values in string form.
+};
+
+/// One simulation of the sweep.
+struct SweepJob
+{
+    uint32_t index;                  ///< Index of the job, unique within the sweep.
+    std::vector<std::string> values; ///< Value of each grid parameter.
+    uint32_t run;                    ///< RNG run number.
+};
+
+/**
+ * \param str the string to split.
+ * \param delimiter the separating character.
+ * \return the non-empty tokens of the string.
+ */
+static std::vector<std::string>
+Split(const std::string& str, char delimiter)
+{
+    std::vector<std::string> tokens;
+    std::istringstream iss(str);
+    std::string token;
+    while (std::getline(iss, token, delimiter))
+    {
+        if (!token.empty())
+        {
+            tokens.push_back(token);
+        }
+    }
+    return tokens;
+}
+
+/**
+ * \param grid the grid description given in the command line.
+ * \return the parameters of the grid.
+ *
+ * Every value is validated by setting it as the attribute default value, so
+ * that a typo aborts the sweep before any job is started.
+ */
+static std::vector<SweepParameter>
+ParseGrid(const std::string& grid)
+{
+    std::vector<SweepParameter> parameters;
+    for (const std::string& entry : Split(grid, ';'))
+    {
+        const std::string::size_type pos = entry.find('=');
+        NS_ABORT_MSG_IF(pos == std::string::npos, "Invalid grid entry " << entry);
+        SweepParameter parameter;
+        parameter.name = entry.substr(0, pos);
+        parameter.values = Split(entry.substr(pos + 1), ',');
+        NS_ABORT_MSG_IF(parameter.values.empty(), "No values for " << parameter.name);
+        for (const std::string& value : parameter.values)
+        {
+            NS_ABORT_MSG_UNLESS(Config::SetDefaultFailSafe(parameter.name, StringValue(value)),
+                                "Invalid value " << value << " for " << parameter.name);
+        }
+        parameters.push_back(parameter);
+    }
+    return parameters;
+}
+
+/**
+ * \param parameters the parameters of the grid.
+ * \param numOfRuns number of replications of each grid point.
+ * \return every combination of the grid values and run numbers.
+ */
+static std::vector<SweepJob>
+CreateJobs(const std::vector<SweepParameter>& parameters, uint32_t numOfRuns)
+{
+    uint32_t numOfPoints = 1;
+    for (const SweepParameter& parameter : parameters)
+    {
+        numOfPoints *= parameter.values.size();
+    }
+
+    std::vector<SweepJob> jobs;
+    for (uint32_t point = 0; point < numOfPoints; point++)
+    {
+        // Decode the point index as a mixed-radix number, one digit per parameter.
+        std::vector<std::string> values;
+        uint32_t rest = point;
+        for (const SweepParameter& parameter : parameters)
+        {
+            values.push_back(parameter.values[rest % parameter.values.size()]);
+            rest /= parameter.values.size();
+        }
+
+        for (uint32_t run = 1; run <= numOfRuns; run++)
+        {
+            SweepJob job;
+            job.index = jobs.size();
+            job.values = values;
+            job.run = run;
+            jobs.push_back(job);
+        }
+    }
+    return jobs;
+}
+
+/**
+ * \param job the job.
+ * \return prefix of the summary files written by the job.
+ */
+static std::string
+GetJobPrefix(const SweepJob& job)
+{
+    std::ostringstream oss;
+    oss << "sweep-job-" << job.index;
+    return oss.str();
+}
+
+/**
+ * \brief Simulate one job. Invoked in the worker process.
+ * \param job the job.
+ * \param parameters the parameters of the grid.
+ * \param scenario either "nrtv" or "http".
+ * \param simTime length of the simulation.
+ */
+static void
+RunJob(const SweepJob& job,
+       const std::vector<SweepParameter>& parameters,
+       const std::string& scenario,
+       Time simTime)
+{
+    NS_LOG_FUNCTION(job.index << job.run);
+
+    for (uint32_t i = 0; i < parameters.size(); i++)
+    {
+        Config::SetDefault(parameters[i].name, StringValue(job.values[i]));
+    }
+    RngSeedManager::SetRun(job.run);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    ApplicationContainer serverApps;
+    ApplicationContainer clientApps;
+    if (scenario == "nrtv")
+    {
+        NrtvHelper nrtvHelper(TcpSocketFactory::GetTypeId());
+        nrtvHelper.InstallUsingIpv4(nodes.Get(1), nodes.Get(0));
+        serverApps = nrtvHelper.GetServer();
+        clientApps = nrtvHelper.GetClients();
+    }
+    else if (scenario == "http")
+    {
+        ThreeGppHttpServerHelper serverHelper(interfaces.GetAddress(1));
+        ThreeGppHttpSatelliteClientHelper clientHelper(interfaces.GetAddress(1));
+        serverApps = serverHelper.Install(nodes.Get(1));
+        clientApps = clientHelper.Install(nodes.Get(0));
+    }
+    else
+    {
+        NS_FATAL_ERROR("Unknown scenario " << scenario << ", use either nrtv or http");
+    }
+
+    {
+        // Both clients export `Rx` and `RxDelay` trace sources of the expected signatures.
+        Ptr<ApplicationStatsHelperContainer> stat = CreateObject<ApplicationStatsHelperContainer>();
+        stat->SetName(GetJobPrefix(job));
+        stat->AddSenderApplications(serverApps);
+        stat->AddReceiverApplications(clientApps);
+        stat->SetTraceSourceName("Rx");
+        stat->AddGlobalThroughput(ApplicationStatsHelper::OUTPUT_SUMMARY);
+        stat->SetTraceSourceName("RxDelay");
+        stat->AddGlobalDelay(ApplicationStatsHelper::OUTPUT_SUMMARY);
+
+        Simulator::Stop(simTime);
+        Simulator::Run();
+
+        // The summary files are written when the helpers are disposed, i.e., here.
+    }
+
+    Simulator::Destroy();
+
+} // end of `void RunJob (...)`
+
+/**
+ * \brief Append the summary files of a finished job into the results table,
+ *        and then remove them.
+ * \param job the finished job.
+ * \param ofs the results table.
+ * \return false if any of the summary files is missing.
+ */
+static bool
+MergeJobResults(const SweepJob& job, std::ostream& ofs)
+{
+    static const char* const METRICS[] = {"throughput", "delay"};
+    bool isComplete = true;
+
+    for (const char* metric : METRICS)
+    {
+        const std::string fileName = GetJobPrefix(job) + "-global-" + metric + "-summary.txt";
+        std::ifstream ifs(fileName.c_str());
+        if (!ifs.is_open())
+        {
+            NS_LOG_WARN("Missing summary file " << fileName);
+            isComplete = false;
+            continue;
+        }
+
+        std::string line;
+        std::getline(ifs, line); // skip the heading
+        while (std::getline(ifs, line))
+        {
+            // Drop the identifier name, which is always the same global identifier.
+            std::istringstream iss(line);
+            std::string identifier;
+            iss >> identifier;
+            std::string columns;
+            std::getline(iss, columns);
+
+            ofs << job.index;
+            for (const std::string& value : job.values)
+            {
+                ofs << " " << value;
+            }
+            ofs << " " << job.run << " " << metric << columns << "\n";
+        }
+
+        ifs.close();
+        std::remove(fileName.c_str());
+    }
+
+    return isComplete;
+
+} // end of `bool MergeJobResults (const SweepJob &, std::ostream &)`
+
+int
+main(int argc, char* argv[])
+{
+    std::string scenario = "nrtv";
+    std::string grid = "ns3::NrtvVariables::NumOfSlices=2,4,8";
+    uint32_t numOfRuns = 4;
+    uint32_t numOfWorkers = std::max(1U, std::thread::hardware_concurrency());
+    double simTime = 60.0;
+    std::string output = "sweep-results.txt";
+
+    CommandLine cmd;
+    cmd.AddValue("scenario", "Either nrtv (over TCP) or http", scenario);
+    cmd.AddValue("grid", "Semicolon-separated list of attribute=value1,value2,...", grid);
+    cmd.AddValue("runs", "Number of replications (RNG runs) of each grid point", numOfRuns);
+    cmd.AddValue("jobs", "Maximum number of jobs running in parallel", numOfWorkers);
+    cmd.AddValue("simTime", "Simulation time of each job in seconds", simTime);
+    cmd.AddValue("output", "Name of the merged results file", output);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(numOfRuns == 0, "At least one run is required");
+    NS_ABORT_MSG_IF(numOfWorkers == 0, "At least one worker is required");
+
+    const std::vector<SweepParameter> parameters = ParseGrid(grid);
+    const std::vector<SweepJob> jobs = CreateJobs(parameters, numOfRuns);
+
+    std::ofstream ofs(output.c_str());
+    NS_ABORT_MSG_UNLESS(ofs.is_open(), "Unable to open file " << output);
+    ofs << "job";
+    for (const SweepParameter& parameter : parameters)
+    {
+        ofs << " " << parameter.name;
+    }
+    ofs << " run metric count mean stddev min max p50 p95 p99\n";
+
+    std::cout << "Running " << jobs.size() << " jobs on " << numOfWorkers << " workers"
+              << std::endl;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::map<pid_t, uint32_t> running; // process ID -> job index
+    uint32_t next = 0;
+    uint32_t numOfFailures = 0;
+    while (next < jobs.size() || !running.empty())
+    {
+        if (next < jobs.size() && running.size() < numOfWorkers)
+        {
+            const pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "Unable to fork a worker process");
+            if (pid == 0)
+            {
+                RunJob(jobs[next], parameters, scenario, Seconds(simTime));
+                _exit(0);
+            }
+            running[pid] = next;
+            next++;
+            continue;
+        }
+
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, 0);
+        NS_ABORT_MSG_IF(pid < 0, "Unable to wait for the worker processes");
+        std::map<pid_t, uint32_t>::iterator it = running.find(pid);
+        NS_ASSERT(it != running.end());
+        const SweepJob& job = jobs[it->second];
+        running.erase(it);
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !MergeJobResults(job, ofs))
+        {
+            std::cerr << "Job " << job.index << " failed" << std::endl;
+            numOfFailures++;
+        }
+    }
+
+    ofs.close();
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Finished " << jobs.size() - numOfFailures << " of " << jobs.size() << " jobs in "
+              << elapsed << " s, results written into " << output << std::endl;
+
+    return (numOfFailures == 0) ? 0 : 1;
+
+} // end of `int main (int argc, char *argv[])`
@@ -20,6 +20,9 @@
 
 #include "cbr-helper.h"
 
+#include "ns3/cbr-multi-flow-application.h"
+
+#include "ns3/abort.h"
 #include "ns3/data-rate.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/names.h"
@@ -36,12 +39,26 @@ CbrHelper::CbrHelper(std::string protocol, Address address)
     m_factory.SetTypeId("ns3::CbrApplication");
     m_factory.Set("Protocol", StringValue(protocol));
     m_factory.Set("Remote", AddressValue(address));
+    m_multiFlowFactory.SetTypeId("ns3::CbrMultiFlowApplication");
+    m_multiFlowFactory.Set("Protocol", StringValue(protocol));
 }
 
 void
 CbrHelper::SetAttribute(std::string name, const AttributeValue& value)
 {
-    m_factory.Set(name, value);
+    TypeId::AttributeInformation info;
+    const bool isCbr = m_factory.GetTypeId().LookupAttributeByName(name, &info);
+    const bool isMultiFlow = m_multiFlowFactory.GetTypeId().LookupAttributeByName(name, &info);
+    NS_ABORT_MSG_UNLESS(isCbr || isMultiFlow, "Invalid attribute " << name);
+
+    if (isCbr)
+    {
+        m_factory.Set(name, value);
+    }
+    if (isMultiFlow)
+    {
+        m_multiFlowFactory.Set(name, value);
+    }
 }
 
 ApplicationContainer
@@ -69,6 +86,20 @@ CbrHelper::Install(NodeContainer c) const
     return apps;
 }
 
+ApplicationContainer
+CbrHelper::InstallMultiFlow(Ptr<Node> node, const std::vector<Address>& remotes) const
+{
+    Ptr<CbrMultiFlowApplication> app = m_multiFlowFactory.Create<CbrMultiFlowApplication>();
+    for (std::vector<Address>::const_iterator it = remotes.begin(); it != remotes.end(); ++it)
+    {
+        app->AddFlow(*it);
+    }
+
+    node->AddApplication(app);
+
+    return ApplicationContainer(app);
+}
+
 Ptr<Application>
 CbrHelper::InstallPriv(Ptr<Node> node) const
 {
@@ -84,6 +115,8 @@ CbrHelper::SetConstantTraffic(Time interval, uint32_t packetSize)
 {
     m_factory.Set("Interval", TimeValue(interval));
     m_factory.Set("PacketSize", UintegerValue(packetSize));
+    m_multiFlowFactory.Set("Interval", TimeValue(interval));
+    m_multiFlowFactory.Set("PacketSize", UintegerValue(packetSize));
 }
 
 } // namespace ns3
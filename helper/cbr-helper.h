@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -57,6 +58,9 @@ class CbrHelper
     /**
      * Helper function used to set the underlying application attributes.
      *
+     * The attribute is set on ns3::CbrApplication and on
+     * ns3::CbrMultiFlowApplication, whichever of them supports it.
+     *
      * \param name the name of the application attribute to set
      * \param value the value of the application attribute to set
      */
@@ -99,6 +103,19 @@ class CbrHelper
      */
     ApplicationContainer Install(std::string nodeName) const;
 
+    /**
+     * Install a single ns3::CbrMultiFlowApplication on the node, driving one
+     * flow to each of the given remote addresses, configured with all the
+     * attributes set with SetAttribute. The remote address given to the
+     * constructor is not used.
+     *
+     * \param node The node on which the application will be installed.
+     * \param remotes The destination addresses of the flows.
+     * \returns Container of Ptr to the application installed.
+     */
+    ApplicationContainer InstallMultiFlow(Ptr<Node> node,
+                                          const std::vector<Address>& remotes) const;
+
   private:
     /**
      * \internal
@@ -112,6 +129,7 @@ class CbrHelper
     std::string m_protocol;
     Address m_remote;
     ObjectFactory m_factory;
+    ObjectFactory m_multiFlowFactory; ///< Factory of CbrMultiFlowApplication.
 };
 
 } // namespace ns3
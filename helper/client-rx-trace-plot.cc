@@ -21,12 +21,17 @@
 
 #include "client-rx-trace-plot.h"
 
+#include <ns3/abort.h>
 #include <ns3/address.h>
+#include <ns3/boolean.h>
 #include <ns3/log.h>
 #include <ns3/nrtv-tcp-client.h>
 #include <ns3/packet-sink.h>
 #include <ns3/packet.h>
 #include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <cmath>
 
 #include <fstream>
 
@@ -39,7 +44,12 @@ NS_OBJECT_ENSURE_REGISTERED(ClientRxTracePlot);
 
 ClientRxTracePlot::ClientRxTracePlot(Ptr<Application> clientApp, std::string outputName)
     : m_client(clientApp),
-      m_outputName(outputName)
+      m_outputName(outputName),
+      m_isStreaming(false),
+      m_chunkSize(4096),
+      m_binWidth(Seconds(0)),
+      m_currentBin(-1),
+      m_binBytes(0)
 {
     NS_LOG_FUNCTION(this << m_client << m_outputName);
 
@@ -48,7 +58,12 @@ ClientRxTracePlot::ClientRxTracePlot(Ptr<Application> clientApp, std::string out
 
 ClientRxTracePlot::ClientRxTracePlot(Ptr<Application> clientApp)
     : m_client(clientApp),
-      m_outputName("client-trace")
+      m_outputName("client-trace"),
+      m_isStreaming(false),
+      m_chunkSize(4096),
+      m_binWidth(Seconds(0)),
+      m_currentBin(-1),
+      m_binBytes(0)
 {
     NS_LOG_FUNCTION(this << m_client << m_outputName);
 
@@ -80,9 +95,27 @@ ClientRxTracePlot::~ClientRxTracePlot()
 TypeId
 ClientRxTracePlot::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::ClientTracePlot").SetParent<Object>()
-        // for future attributes to configure how the plot is drawn?
-        ;
+    static TypeId tid =
+        TypeId("ns3::ClientTracePlot")
+            .SetParent<Object>()
+            .AddAttribute("Streaming",
+                          "If true, the samples are written into a separate data file in "
+                          "chunks during the simulation, instead of being kept in memory.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ClientRxTracePlot::m_isStreaming),
+                          MakeBooleanChecker())
+            .AddAttribute("ChunkSize",
+                          "Number of samples written into the data file at a time, when "
+                          "streaming.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&ClientRxTracePlot::m_chunkSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("BinWidth",
+                          "If positive, the bytes received are aggregated into bins of this "
+                          "width, and each bin is plotted as one sample.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ClientRxTracePlot::m_binWidth),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -104,10 +137,19 @@ ClientRxTracePlot::Plot()
 {
     NS_LOG_FUNCTION(this << m_outputName);
 
+    FlushBin();
+
+    if (m_isStreaming)
+    {
+        PlotStreamed();
+        return;
+    }
+
     Gnuplot plot(m_outputName + ".png");
     plot.SetTitle("NRTV Client Traffic Trace");
     plot.SetTerminal("png");
-    plot.SetLegend("Time (in seconds)", "Bytes received");
+    plot.SetLegend("Time (in seconds)",
+                   m_binWidth.IsStrictlyPositive() ? "Bytes received per bin" : "Bytes received");
     plot.AddDataset(m_packet);
     const std::string plotFileName = m_outputName + ".plt";
     std::ofstream plotFile(plotFileName.c_str());
@@ -120,7 +162,89 @@ ClientRxTracePlot::RxCallback(Ptr<const Packet> packet, const Address& from)
 {
     NS_LOG_FUNCTION(this << packet << from);
     m_counter++;
-    m_packet.Add(Simulator::Now().GetSeconds(), static_cast<double>(packet->GetSize()));
+
+    if (!m_binWidth.IsStrictlyPositive())
+    {
+        AddSample(Simulator::Now().GetSeconds(), static_cast<double>(packet->GetSize()));
+        return;
+    }
+
+    const int64_t bin = Simulator::Now().GetTimeStep() / m_binWidth.GetTimeStep();
+    if (bin != m_currentBin)
+    {
+        FlushBin();
+        m_currentBin = bin;
+    }
+    m_binBytes += packet->GetSize();
+}
+
+void
+ClientRxTracePlot::FlushBin()
+{
+    if (m_binBytes > 0)
+    {
+        AddSample((m_binWidth * m_currentBin).GetSeconds(), static_cast<double>(m_binBytes));
+        m_binBytes = 0;
+    }
+}
+
+void
+ClientRxTracePlot::AddSample(double time, double bytes)
+{
+    if (!m_isStreaming)
+    {
+        m_packet.Add(time, bytes);
+        return;
+    }
+
+    m_chunk.push_back(std::make_pair(time, bytes));
+    if (m_chunk.size() >= m_chunkSize)
+    {
+        FlushChunk();
+    }
+}
+
+void
+ClientRxTracePlot::FlushChunk()
+{
+    NS_LOG_FUNCTION(this << m_chunk.size());
+
+    if (!m_dataFile.is_open())
+    {
+        const std::string dataFileName = m_outputName + ".dat";
+        m_dataFile.open(dataFileName.c_str(), std::ios::out | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(m_dataFile.is_open(), "Unable to open file " << dataFileName);
+    }
+
+    for (std::vector<std::pair<double, double>>::const_iterator it = m_chunk.begin();
+         it != m_chunk.end();
+         ++it)
+    {
+        m_dataFile << it->first << " " << it->second << "\n";
+    }
+
+    m_chunk.clear();
+}
+
+void
+ClientRxTracePlot::PlotStreamed()
+{
+    NS_LOG_FUNCTION(this << m_outputName);
+
+    FlushChunk();
+    m_dataFile.close();
+
+    const std::string plotFileName = m_outputName + ".plt";
+    std::ofstream plotFile(plotFileName.c_str());
+    plotFile << "set terminal png\n"
+             << "set output \"" << m_outputName << ".png\"\n"
+             << "set title \"NRTV Client Traffic Trace\"\n"
+             << "set xlabel \"Time (in seconds)\"\n"
+             << "set ylabel \""
+             << (m_binWidth.IsStrictlyPositive() ? "Bytes received per bin" : "Bytes received")
+             << "\"\n"
+             << "plot \"" << m_outputName << ".dat\" using 1:2 title \"Packet\" with impulses\n";
+    plotFile.close();
 }
 
 } // namespace ns3
@@ -24,9 +24,14 @@
 
 #include <ns3/application.h>
 #include <ns3/gnuplot.h>
+#include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
 
+#include <fstream>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -59,6 +64,15 @@ class PacketSink;
  *
  * The above command generates a new file "client-trace.png" in the same
  * directory.
+ *
+ * By default, every received packet is kept in memory until the end of the
+ * simulation. For long simulations, the `Streaming` attribute may be enabled.
+ * In that case, the samples are written in chunks of `ChunkSize` samples into
+ * a separate data file, e.g., "client-trace.dat", which is referred by the
+ * Gnuplot file written at the end of the simulation. Moreover, a positive
+ * `BinWidth` attribute aggregates the received bytes into time bins, so that
+ * each bin is plotted as one sample instead of one sample per packet. The
+ * two attributes may be combined to keep the memory usage constant.
  */
 class ClientRxTracePlot : public Object
 {
@@ -113,6 +127,24 @@ class ClientRxTracePlot : public Object
     /// Generating the plot.
     void Plot();
 
+    /// Writing the remaining samples and the Gnuplot file which refers to the
+    /// streamed data file.
+    void PlotStreamed();
+
+    /**
+     * \brief Add a sample to the plot, either in memory or via the chunk
+     *        buffer of the data file.
+     * \param time the time of the sample in seconds.
+     * \param bytes the number of bytes received.
+     */
+    void AddSample(double time, double bytes);
+
+    /// Write the samples in the chunk buffer into the data file.
+    void FlushChunk();
+
+    /// Add the bytes of the current bin as a sample, if there are any.
+    void FlushBin();
+
     // TRACE CALLBACK FUNCTIONS
 
     void RxCallback(Ptr<const Packet> packet, const Address& from);
@@ -122,6 +154,15 @@ class ClientRxTracePlot : public Object
     Gnuplot2dDataset m_packet; ///< Size of every packet received.
     u_int32_t m_counter;
 
+    bool m_isStreaming;   ///< `Streaming` attribute.
+    uint32_t m_chunkSize; ///< `ChunkSize` attribute.
+    Time m_binWidth;      ///< `BinWidth` attribute.
+    /// Samples waiting to be written into the data file.
+    std::vector<std::pair<double, double>> m_chunk;
+    std::ofstream m_dataFile; ///< The data file in streaming mode.
+    int64_t m_currentBin;     ///< Index of the current bin.
+    uint64_t m_binBytes;      ///< Number of bytes received in the current bin.
+
 }; // end of `class ClientRxTracePlot`
 
 } // namespace ns3
@@ -0,0 +1,295 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "histogram-plot-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("HistogramPlotHelper");
+
+namespace ns3
+{
+
+// HISTOGRAM //////////////////////////////////////////////////////////////////
+
+HistogramPlotHelper::Histogram::Histogram(double binWidth, double max)
+    : m_isLogScale(false),
+      m_binWidth(binWidth),
+      m_min(0.0),
+      m_binsPerDecade(0),
+      m_max(max),
+      m_numOfSamples(0),
+      m_numOfUnderflows(0),
+      m_numOfOverflows(0),
+      m_sum(0.0)
+{
+    NS_ABORT_MSG_UNLESS(binWidth > 0.0, "Bin width must be positive");
+}
+
+HistogramPlotHelper::Histogram
+HistogramPlotHelper::Histogram::CreateLogScale(double min, uint32_t binsPerDecade, double max)
+{
+    NS_ABORT_MSG_UNLESS(min > 0.0, "The first bin of a log-scaled histogram must be positive");
+    NS_ABORT_MSG_UNLESS(binsPerDecade > 0, "At least one bin per decade is required");
+    Histogram histogram(1.0, max);
+    histogram.m_isLogScale = true;
+    histogram.m_min = min;
+    histogram.m_binsPerDecade = binsPerDecade;
+    return histogram;
+}
+
+void
+HistogramPlotHelper::Histogram::Add(double value)
+{
+    m_numOfSamples++;
+    m_sum += value;
+
+    if (value < (m_isLogScale ? m_min : 0.0))
+    {
+        m_numOfUnderflows++;
+        return;
+    }
+
+    if (m_max > 0.0 && value > m_max)
+    {
+        m_numOfOverflows++;
+        return;
+    }
+
+    const double position = m_isLogScale ? std::log10(value / m_min) * m_binsPerDecade
+                                         : value / m_binWidth;
+    const uint32_t index = static_cast<uint32_t>(position);
+    if (index >= m_bins.size())
+    {
+        m_bins.resize(index + 1, 0);
+    }
+    m_bins[index]++;
+}
+
+void
+HistogramPlotHelper::Histogram::Merge(const Histogram& other)
+{
+    NS_ASSERT_MSG(m_isLogScale == other.m_isLogScale && m_binWidth == other.m_binWidth &&
+                      m_min == other.m_min && m_binsPerDecade == other.m_binsPerDecade &&
+                      m_max == other.m_max,
+                  "Unable to merge histograms of different layouts");
+
+    if (other.m_bins.size() > m_bins.size())
+    {
+        m_bins.resize(other.m_bins.size(), 0);
+    }
+    for (uint32_t i = 0; i < other.m_bins.size(); i++)
+    {
+        m_bins[i] += other.m_bins[i];
+    }
+
+    m_numOfSamples += other.m_numOfSamples;
+    m_numOfUnderflows += other.m_numOfUnderflows;
+    m_numOfOverflows += other.m_numOfOverflows;
+    m_sum += other.m_sum;
+}
+
+HistogramPlotHelper::Histogram
+HistogramPlotHelper::Histogram::CreateEmpty() const
+{
+    Histogram histogram(*this);
+    histogram.m_bins.clear();
+    histogram.m_numOfSamples = 0;
+    histogram.m_numOfUnderflows = 0;
+    histogram.m_numOfOverflows = 0;
+    histogram.m_sum = 0.0;
+    return histogram;
+}
+
+bool
+HistogramPlotHelper::Histogram::IsLogScale() const
+{
+    return m_isLogScale;
+}
+
+double
+HistogramPlotHelper::Histogram::GetMax() const
+{
+    return m_max;
+}
+
+uint64_t
+HistogramPlotHelper::Histogram::GetNumOfSamples() const
+{
+    return m_numOfSamples;
+}
+
+double
+HistogramPlotHelper::Histogram::GetMean() const
+{
+    return (m_numOfSamples == 0) ? 0.0 : m_sum / static_cast<double>(m_numOfSamples);
+}
+
+double
+HistogramPlotHelper::Histogram::GetQuantile(double q) const
+{
+    NS_ASSERT_MSG(q >= 0.0 && q <= 1.0, "Invalid quantile " << q);
+
+    if (m_numOfSamples == 0)
+    {
+        return 0.0;
+    }
+
+    const double target = q * static_cast<double>(m_numOfSamples);
+    double cumulative = static_cast<double>(m_numOfUnderflows);
+    if (target <= cumulative)
+    {
+        return GetBinStart(0);
+    }
+
+    for (uint32_t i = 0; i < m_bins.size(); i++)
+    {
+        const double count = static_cast<double>(m_bins[i]);
+        if (count > 0.0 && target <= cumulative + count)
+        {
+            // linear interpolation within the bin
+            const double fraction = (target - cumulative) / count;
+            return GetBinStart(i) + fraction * (GetBinEnd(i) - GetBinStart(i));
+        }
+        cumulative += count;
+    }
+
+    // the quantile falls among the samples above the maximum
+    return (m_max > 0.0) ? m_max : GetBinEnd(m_bins.size() - 1);
+
+} // end of `double GetQuantile (double) const`
+
+uint32_t
+HistogramPlotHelper::Histogram::GetNumOfBins() const
+{
+    return m_bins.size();
+}
+
+double
+HistogramPlotHelper::Histogram::GetBinStart(uint32_t index) const
+{
+    return m_isLogScale ? m_min * std::pow(10.0, static_cast<double>(index) / m_binsPerDecade)
+                        : index * m_binWidth;
+}
+
+double
+HistogramPlotHelper::Histogram::GetBinEnd(uint32_t index) const
+{
+    return GetBinStart(index + 1);
+}
+
+uint64_t
+HistogramPlotHelper::Histogram::GetBinCount(uint32_t index) const
+{
+    NS_ASSERT_MSG(index < m_bins.size(), "Invalid bin index " << index);
+    return m_bins[index];
+}
+
+// HISTOGRAM PLOT HELPER //////////////////////////////////////////////////////
+
+void
+HistogramPlotHelper::WritePlot(const Histogram& histogram,
+                               std::string name,
+                               std::string plotTitle,
+                               std::string axisLabel,
+                               double referenceMean,
+                               double xMax)
+{
+    std::string plotFileName = name + ".plt";
+    std::ofstream ofs(plotFileName.c_str());
+
+    if (!ofs.is_open())
+    {
+        NS_FATAL_ERROR("Unable to write to " << plotFileName);
+    }
+
+    const uint64_t numOfSamples = histogram.GetNumOfSamples();
+
+    ofs << "set terminal png\n";
+    ofs << "set output '" << name << ".png'\n";
+
+    ofs << "set title '" << plotTitle << "'\n";
+    ofs << "set xlabel '" << axisLabel << "'\n";
+    ofs << "set ylabel 'Frequency (out of " << numOfSamples << " samples)'\n";
+
+    if (histogram.IsLogScale())
+    {
+        ofs << "set logscale x\n";
+        if (xMax > 0.0)
+        {
+            ofs << "set xrange [" << histogram.GetBinStart(0) << ":" << xMax << "]\n";
+        }
+    }
+    else if (xMax > 0.0)
+    {
+        ofs << "set xrange [0:" << xMax << "]\n";
+    }
+
+    // ignoring negative values (if any)
+    ofs << "set yrange [0:]\n";
+    // so that tics don't step on the histogram
+    ofs << "set tics out nomirror\n";
+    // definition of the histogram plot, where the third column is the bar width
+    ofs << "plot '-' using 1:2:3 with boxes notitle, "
+        << "'-' title 'Reference mean' with points, "
+        << "'-' title 'Actual mean' with points, "
+        << "'-' title 'Median' with points, "
+        << "'-' title '95th percentile' with points\n";
+
+    // write only the non-empty bins, as (center, frequency, width)
+    for (uint32_t i = 0; i < histogram.GetNumOfBins(); i++)
+    {
+        const uint64_t count = histogram.GetBinCount(i);
+        if (count == 0)
+        {
+            continue;
+        }
+
+        const double start = histogram.GetBinStart(i);
+        const double end = histogram.GetBinEnd(i);
+        const double center = histogram.IsLogScale() ? std::sqrt(start * end) : 0.5 * (start + end);
+        ofs << center << " " << (static_cast<double>(count) / numOfSamples) << " " << (end - start)
+            << "\n";
+    }
+    ofs << "e\n"; // separator between series
+
+    // write the reference mean data point
+    ofs << referenceMean << " 0\n";
+    ofs << "e\n"; // separator between series
+
+    // write the actual mean, median, and 95th percentile data points
+    ofs << histogram.GetMean() << " 0\n";
+    ofs << "e\n";
+    ofs << histogram.GetQuantile(0.5) << " 0\n";
+    ofs << "e\n";
+    ofs << histogram.GetQuantile(0.95) << " 0\n";
+    ofs << "e\n";
+
+    ofs.close();
+
+    std::cout << "Output file written: " << plotFileName << std::endl;
+
+} // end of `void WritePlot (...)`
+
+} // namespace ns3
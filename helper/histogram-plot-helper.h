@@ -22,10 +22,14 @@
 #ifndef HISTOGRAM_PLOT_HELPER_H
 #define HISTOGRAM_PLOT_HELPER_H
 
+#include <ns3/assert.h>
 #include <ns3/callback.h>
 
 #include <cmath>
-#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace ns3
 {
@@ -78,6 +82,104 @@ namespace ns3
 class HistogramPlotHelper
 {
   public:
+    /**
+     * \brief In-memory histogram of samples, with either fixed-width or
+     *        log-scaled bins.
+     *
+     * Besides counting the samples in each bin, the histogram keeps their exact
+     * sum, so the mean is exact, while the quantiles are interpolated within the
+     * bins. Samples below the first bin (e.g., negative values) and above the
+     * optional maximum value are counted separately, so the memory usage is
+     * bounded by the number of bins.
+     */
+    class Histogram
+    {
+      public:
+        /**
+         * \brief Create a histogram with fixed-width bins, starting from zero.
+         * \param binWidth the width of each bin.
+         * \param max if positive, the samples above this value are not binned.
+         */
+        Histogram(double binWidth, double max = 0.0);
+
+        /**
+         * \brief Create a histogram with log-scaled bins.
+         * \param min the lower end of the first bin, must be positive.
+         * \param binsPerDecade the number of bins between a value and ten times
+         *                      the value.
+         * \param max if positive, the samples above this value are not binned.
+         * \return the new histogram.
+         */
+        static Histogram CreateLogScale(double min, uint32_t binsPerDecade, double max = 0.0);
+
+        /**
+         * \param value a new sample.
+         */
+        void Add(double value);
+
+        /**
+         * \brief Add all the samples of another histogram of the same layout.
+         * \param other a histogram created with the same arguments.
+         */
+        void Merge(const Histogram& other);
+
+        /// \return a copy of this histogram without any sample.
+        Histogram CreateEmpty() const;
+
+        /// \return true if the bins are log-scaled.
+        bool IsLogScale() const;
+
+        /// \return the upper limit of the binned samples, or zero if unlimited.
+        double GetMax() const;
+
+        /// \return the number of samples added.
+        uint64_t GetNumOfSamples() const;
+
+        /// \return the exact mean of the samples, or zero without any sample.
+        double GetMean() const;
+
+        /**
+         * \param q the quantile to compute, between 0 and 1, e.g., 0.5 for the
+         *          median.
+         * \return the quantile, interpolated within the bin in which it falls.
+         */
+        double GetQuantile(double q) const;
+
+        /// \return the number of bins which have been allocated.
+        uint32_t GetNumOfBins() const;
+
+        /**
+         * \param index the index of a bin.
+         * \return the lower end of the bin.
+         */
+        double GetBinStart(uint32_t index) const;
+
+        /**
+         * \param index the index of a bin.
+         * \return the upper end of the bin.
+         */
+        double GetBinEnd(uint32_t index) const;
+
+        /**
+         * \param index the index of a bin.
+         * \return the number of samples in the bin.
+         */
+        uint64_t GetBinCount(uint32_t index) const;
+
+      private:
+        bool m_isLogScale;            ///< True if the bins are log-scaled.
+        double m_binWidth;            ///< Width of a fixed-width bin.
+        double m_min;                 ///< Lower end of the first log-scaled bin.
+        uint32_t m_binsPerDecade;     ///< Number of log-scaled bins per decade.
+        double m_max;                 ///< Upper limit of binned samples, or zero.
+        std::vector<uint64_t> m_bins; ///< Number of samples per bin.
+        uint64_t m_numOfSamples;      ///< Number of samples, including unbinned ones.
+        uint64_t m_numOfUnderflows;   ///< Number of samples below the first bin.
+        uint64_t m_numOfOverflows;    ///< Number of samples above the maximum.
+        double m_sum;                 ///< Sum of all samples.
+
+    }; // end of `class Histogram`
+
     /**
      * \brief Write a Gnuplot file of a histogram from a given random variable.
      *
@@ -123,10 +225,13 @@ class HistogramPlotHelper
      * vertical bars. The height of the bar is the frequency of observations in
      * the interval over all the retrieved random value samples.
      *
+     * The samples are binned in memory and only the bins are written to the
+     * file, so the file size does not depend on the number of samples.
+     *
      * The function also computes the mean of all the retrieved samples and print
-     * it on the histogram as the "actual mean". In addition, a "reference mean",
-     * which is provided as an argument, is also printed on the histogram for
-     * comparison purpose.
+     * it on the histogram as the "actual mean", together with the median and the
+     * 95th percentile. In addition, a "reference mean", which is provided as an
+     * argument, is also printed on the histogram for comparison purpose.
      */
     template <typename T>
     static void Plot(Callback<T> valueStream,
@@ -137,10 +242,59 @@ class HistogramPlotHelper
                      T binWidth,
                      double referenceMean,
                      T max = 0);
+
+    /**
+     * \brief Write a Gnuplot file of a histogram with the given bin layout,
+     *        drawing the samples from several random variables in parallel.
+     *
+     * \param valueStreams callbacks to the functions that return a random value
+     *                     of type `T`; each callback is invoked by its own
+     *                     thread, so each of them must use its own random
+     *                     variable objects, e.g., with different stream numbers
+     * \param name the name of the plot, which determines the output file name
+     * \param plotTitle the text to be printed on top of the histogram
+     * \param axisLabel the text to be printed as the label of the histogram's
+     *                  X axis
+     * \param numOfSamples the total number of samples, evenly distributed
+     *                     among the callbacks
+     * \param layout an empty histogram, which determines the bins, e.g.,
+     *               created by Histogram::CreateLogScale()
+     * \param referenceMean a mean value to be printed on the histogram for
+     *                      comparison purpose
+     *
+     * With a single callback, no thread is created. The output is otherwise the
+     * same as Plot().
+     */
+    template <typename T>
+    static void Plot(const std::vector<Callback<T>>& valueStreams,
+                     std::string name,
+                     std::string plotTitle,
+                     std::string axisLabel,
+                     uint32_t numOfSamples,
+                     const Histogram& layout,
+                     double referenceMean);
+
+    /**
+     * \brief Write a Gnuplot file of an already filled histogram.
+     * \param histogram the histogram to plot.
+     * \param name the name of the plot, which determines the output file name
+     * \param plotTitle the text to be printed on top of the histogram
+     * \param axisLabel the text to be printed as the label of the histogram's
+     *                  X axis
+     * \param referenceMean a mean value to be printed on the histogram for
+     *                      comparison purpose
+     * \param xMax the upper end of the X axis, or zero for automatic range
+     */
+    static void WritePlot(const Histogram& histogram,
+                          std::string name,
+                          std::string plotTitle,
+                          std::string axisLabel,
+                          double referenceMean,
+                          double xMax);
 };
 
 /*
- * The following method is defined here in .h file, because static templated
+ * The following methods are defined here in .h file, because static templated
  * function like this is not visible to the linker if put in .cc file.
  */
 
@@ -155,21 +309,7 @@ HistogramPlotHelper::Plot(Callback<T> valueStream,
                           double referenceMean,
                           T max)
 {
-    std::string plotFileName = name + ".plt";
-    std::ofstream ofs(plotFileName.c_str());
-
-    if (!ofs.is_open())
-    {
-        NS_FATAL_ERROR("Unable to write to " << plotFileName);
-    }
-
-    ofs << "set terminal png" << std::endl;
-    ofs << "set output '" << name << ".png'" << std::endl;
-
-    ofs << "set title '" << plotTitle << "'" << std::endl;
-    ofs << "set xlabel '" << axisLabel << "'" << std::endl;
-    ofs << "set ylabel 'Frequency (out of " << numOfSamples << " samples)'" << std::endl;
-
+    double xMax;
     if (static_cast<uint32_t>(max) == 0)
     {
         /*
@@ -177,53 +317,77 @@ HistogramPlotHelper::Plot(Callback<T> valueStream,
          * "automatically" here. Nothing really special in the formula, just a
          * value that produces rather good-looking results.
          */
-        ofs << "set xrange [0:" << 2 * exp(1) * referenceMean << "]" << std::endl;
+        xMax = 2 * exp(1) * referenceMean;
     }
     else
     {
         // add 10% offset on top of the specified maximum value
-        ofs << "set xrange [0:" << 1.1 * max << "]" << std::endl;
+        xMax = 1.1 * max;
     }
 
-    // ignoring negative values (if any)
-    ofs << "set yrange [0:]" << std::endl;
-    // so that tics don't step on the histogram
-    ofs << "set tics out nomirror" << std::endl;
-    // the width of each bar
-    ofs << "set boxwidth " << binWidth << std::endl;
-    // the function to determine which bin a sample belongs to
-    ofs << "bin(x)=" << binWidth << "*floor(x/" << binWidth << ")"
-        << "+" << (0.5 * binWidth) << std::endl;
-    // definition of the histogram plot
-    ofs << "plot '-' using (bin($1)):(1.0/" << numOfSamples << ") "
-        << "smooth freq with boxes notitle, "
-        << "'-' title 'Reference mean' with points, "
-        << "'-' title 'Actual mean' with points" << std::endl;
-
-    // start writing the data points for the histogram
-    T value;
-    T sum = 0;
+    // samples beyond the plotted range are not binned, but still count in the mean
+    Histogram histogram(static_cast<double>(binWidth), xMax);
     for (uint32_t i = 0; i < numOfSamples; i++)
     {
-        value = valueStream();
-        sum += value;
-        ofs << valueStream() << std::endl;
+        histogram.Add(static_cast<double>(valueStream()));
     }
-    ofs << "e" << std::endl; // separator between series
 
-    // write the reference mean data point
-    ofs << referenceMean << " 0" << std::endl;
-    ofs << "e" << std::endl; // separator between series
+    WritePlot(histogram, name, plotTitle, axisLabel, referenceMean, xMax);
 
-    // write the actual mean data point
-    ofs << (sum / static_cast<double>(numOfSamples)) << " 0" << std::endl;
-    ofs << "e" << std::endl; // separator between series
+} // end of `void Plot (...)`
 
-    ofs.close();
+template <typename T>
+void
+HistogramPlotHelper::Plot(const std::vector<Callback<T>>& valueStreams,
+                          std::string name,
+                          std::string plotTitle,
+                          std::string axisLabel,
+                          uint32_t numOfSamples,
+                          const Histogram& layout,
+                          double referenceMean)
+{
+    NS_ASSERT_MSG(!valueStreams.empty(), "At least one value stream is required");
+    const uint32_t numOfThreads = valueStreams.size();
 
-    std::cout << "Output file written: " << plotFileName << std::endl;
+    // each thread fills its own histogram, so no locking is needed
+    std::vector<Histogram> histograms(numOfThreads, layout.CreateEmpty());
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numOfThreads; t++)
+    {
+        const uint32_t n =
+            numOfSamples / numOfThreads + ((t < numOfSamples % numOfThreads) ? 1 : 0);
+        Histogram* histogram = &histograms[t];
+        const Callback<T>* valueStream = &valueStreams[t];
+        auto draw = [histogram, valueStream, n]() {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                histogram->Add(static_cast<double>((*valueStream)()));
+            }
+        };
 
-} // end of `void Plot (...)`
+        if (numOfThreads == 1)
+        {
+            draw();
+        }
+        else
+        {
+            threads.emplace_back(draw);
+        }
+    }
+
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        it->join();
+    }
+
+    for (uint32_t t = 1; t < numOfThreads; t++)
+    {
+        histograms[0].Merge(histograms[t]);
+    }
+
+    WritePlot(histograms[0], name, plotTitle, axisLabel, referenceMean, layout.GetMax());
+
+} // end of `void Plot (const std::vector<Callback<T>> &, ...)`
 
 } // namespace ns3
 
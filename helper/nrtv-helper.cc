@@ -26,12 +26,18 @@
 
 #include "nrtv-helper.h"
 
+#include <ns3/fatal-error.h>
 #include <ns3/inet-socket-address.h>
 #include <ns3/ipv4.h>
 #include <ns3/names.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
 #include <ns3/string.h>
+#include <ns3/uinteger.h>
 
 #include <map>
+#include <sstream>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -54,8 +60,7 @@ NrtvClientHelper::NrtvClientHelper(TypeId protocolTid, Address address)
     }
     else
     {
-        m_factory.SetTypeId("ns3::PacketSink");
-        m_factory.Set("Protocol", TypeIdValue(protocolTid));
+        m_factory.SetTypeId("ns3::NrtvUdpClient");
         m_factory.Set("Local", AddressValue(address));
     }
 }
@@ -119,6 +124,25 @@ void
 NrtvServerHelper::SetAttribute(std::string name, const AttributeValue& value)
 {
     m_factory.Set(name, value);
+    m_attributes[name] = value.Copy();
+}
+
+void
+NrtvServerHelper::GetAttribute(std::string name, AttributeValue& value) const
+{
+    TypeId::AttributeInformation info;
+    if (!m_factory.GetTypeId().LookupAttributeByName(name, &info))
+    {
+        NS_FATAL_ERROR("Invalid attribute " << name << " for "
+                                            << m_factory.GetTypeId().GetName());
+    }
+
+    std::map<std::string, Ptr<AttributeValue>>::const_iterator it = m_attributes.find(name);
+    Ptr<const AttributeValue> source = (it == m_attributes.end()) ? info.initialValue : it->second;
+    if (!value.DeserializeFromString(source->SerializeToString(info.checker), info.checker))
+    {
+        NS_FATAL_ERROR("Attribute " << name << " does not fit the given value");
+    }
 }
 
 ApplicationContainer
@@ -198,57 +222,106 @@ NrtvHelper::SetVariablesAttribute(std::string name, const AttributeValue& value)
 ApplicationContainer
 NrtvHelper::InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes)
 {
-    ApplicationContainer ret; // the return value of the function
-    bool tcpInUse = m_protocolTid == TypeId::LookupByName("ns3::TcpSocketFactory");
-
     Ptr<Ipv4> ipv4 = serverNode->GetObject<Ipv4>();
     if (ipv4 == nullptr)
     {
         NS_FATAL_ERROR("No IPv4 object is found within the server node " << serverNode);
     }
-    else
-    {
-        /// Still unclear if the hard-coded indices below will work in any possible cases.
-        const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
-        const Ipv4Address serverAddress = interfaceAddress.GetLocal();
 
+    /// Still unclear if the hard-coded indices below will work in any possible cases.
+    const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
+    return InstallUsingIpv4(serverNode, interfaceAddress.GetLocal(), clientNodes);
+}
+
+ApplicationContainer
+NrtvHelper::InstallUsingIpv4(Ptr<Node> serverNode,
+                             Ipv4Address serverAddress,
+                             NodeContainer clientNodes)
+{
+    ApplicationContainer ret; // the return value of the function
+    bool tcpInUse = m_protocolTid == TypeId::LookupByName("ns3::TcpSocketFactory");
+    const uint32_t systemId = Simulator::GetSystemId();
+
+    if (tcpInUse)
+        m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+
+    if (m_nrtvVariables->GetViewSubstreams())
+    {
+        // Every application draws from its own view of the same collection.
+        m_serverHelper->SetAttribute("Variables", PointerValue(m_nrtvVariables));
         if (tcpInUse)
-            m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+            m_clientHelper->SetAttribute("NrtvConfigurationVariables",
+                                         PointerValue(m_nrtvVariables));
+    }
 
+    m_lastInstalledServer = ApplicationContainer();
+    if (serverNode->GetSystemId() == systemId)
+    {
         m_lastInstalledServer = m_serverHelper->Install(serverNode);
         ret.Add(m_lastInstalledServer);
+    }
 
-        if (tcpInUse)
+    // Only the client nodes simulated by this process get an application.
+    NodeContainer localClientNodes;
+    for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++)
+    {
+        if ((*it)->GetSystemId() == systemId)
+            localClientNodes.Add(*it);
+    }
+
+    if (tcpInUse)
+    {
+        // If TCP server is used, installation is straightforward.
+        m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
+        m_lastInstalledClients = m_clientHelper->Install(localClientNodes);
+    }
+    else
+    {
+        // If UDP is used, we need to configure NrtvUdpClient "Local" attribute
+        // for each client node after installation. The port is read from the
+        // server helper when the server node is remote.
+        m_lastInstalledClients = ApplicationContainer();
+        Ptr<NrtvUdpServer> serverApp;
+        uint16_t serverRemotePort;
+        if (m_lastInstalledServer.GetN() > 0)
         {
-            // If TCP server is used, installation is straightforward.
-            m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
-            m_lastInstalledClients = m_clientHelper->Install(clientNodes);
+            serverApp = m_lastInstalledServer.Get(0)->GetObject<NrtvUdpServer>();
+            serverRemotePort = serverApp->GetRemotePort();
         }
         else
         {
-            // If UDP is used, we need to configure PacketSink "Local" attribute
-            // for each client node after installation.
-            m_lastInstalledClients = ApplicationContainer();
-            Ptr<NrtvUdpServer> serverApp = m_lastInstalledServer.Get(0)->GetObject<NrtvUdpServer>();
-            for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++)
+            UintegerValue remotePort;
+            m_serverHelper->GetAttribute("RemotePort", remotePort);
+            serverRemotePort = remotePort.Get();
+        }
+
+        for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++)
+        {
+            Ptr<Ipv4> clientIpv4 = (*it)->GetObject<Ipv4>();
+            const Ipv4InterfaceAddress clientInterfaceAddress = clientIpv4->GetAddress(1, 0);
+            const Ipv4Address clientAddress = clientInterfaceAddress.GetLocal();
+            if ((*it)->GetSystemId() == systemId)
             {
-                Ptr<Ipv4> clientIpv4 = (*it)->GetObject<Ipv4>();
-                const Ipv4InterfaceAddress clientInterfaceAddress = clientIpv4->GetAddress(1, 0);
-                const Ipv4Address clientAddress = clientInterfaceAddress.GetLocal();
                 ApplicationContainer apps = m_clientHelper->Install((*it));
                 for (auto it2 = apps.Begin(); it2 != apps.End(); it2++)
                     (*it2)->SetAttribute(
                         "Local",
-                        AddressValue(InetSocketAddress(clientAddress, serverApp->GetRemotePort())));
+                        AddressValue(InetSocketAddress(clientAddress, serverRemotePort)));
                 m_lastInstalledClients.Add(apps);
-                serverApp->AddClient(clientAddress, m_nrtvVariables->GetNumOfVideos());
             }
+            if (serverApp != nullptr)
+                serverApp->AddClient(clientAddress, m_nrtvVariables->GetNumOfVideos());
         }
-        ret.Add(m_lastInstalledClients);
     }
+    ret.Add(m_lastInstalledClients);
+
+    m_shardNodes.assign(1, serverNode);
+    m_shardServers.assign(1, m_lastInstalledServer);
+    m_shardClients.assign(1, m_lastInstalledClients);
 
     return ret;
-}
+
+} // end of `ApplicationContainer InstallUsingIpv4 (Ptr<Node>, Ipv4Address, NodeContainer)`
 
 ApplicationContainer
 NrtvHelper::InstallUsingIpv4(Ptr<Node> serverNode, Ptr<Node> clientNode)
@@ -256,6 +329,89 @@ NrtvHelper::InstallUsingIpv4(Ptr<Node> serverNode, Ptr<Node> clientNode)
     return InstallUsingIpv4(serverNode, NodeContainer(clientNode));
 }
 
+ApplicationContainer
+NrtvHelper::InstallUsingIpv4(NodeContainer serverNodes, NodeContainer clientNodes)
+{
+    const std::vector<NodeContainer> shards = m_shardHelper.Assign(serverNodes, clientNodes);
+    std::vector<Ptr<Node>> shardNodes;
+    std::vector<ApplicationContainer> shardServers;
+    std::vector<ApplicationContainer> shardClients;
+    ApplicationContainer allServers;
+    ApplicationContainer allClients;
+
+    for (uint32_t i = 0; i < serverNodes.GetN(); i++)
+    {
+        InstallUsingIpv4(serverNodes.Get(i), shards[i]);
+        shardNodes.push_back(serverNodes.Get(i));
+        shardServers.push_back(m_lastInstalledServer);
+        shardClients.push_back(m_lastInstalledClients);
+        allServers.Add(m_lastInstalledServer);
+        allClients.Add(m_lastInstalledClients);
+    }
+
+    m_shardNodes = shardNodes;
+    m_shardServers = shardServers;
+    m_shardClients = shardClients;
+    m_lastInstalledServer = allServers;
+    m_lastInstalledClients = allClients;
+
+    ApplicationContainer ret(allServers);
+    ret.Add(allClients);
+    return ret;
+
+} // end of `ApplicationContainer InstallUsingIpv4 (NodeContainer, NodeContainer)`
+
+void
+NrtvHelper::SetShardPolicy(ServerShardHelper::ShardPolicy_t policy)
+{
+    m_shardHelper.SetPolicy(policy);
+}
+
+void
+NrtvHelper::ResetShards()
+{
+    m_shardHelper.Reset();
+}
+
+uint32_t
+NrtvHelper::GetNumOfShards() const
+{
+    return m_shardServers.size();
+}
+
+ApplicationContainer
+NrtvHelper::GetShardServer(uint32_t shard) const
+{
+    NS_ASSERT_MSG(shard < m_shardServers.size(), "Invalid shard " << shard);
+    return m_shardServers[shard];
+}
+
+ApplicationContainer
+NrtvHelper::GetShardClients(uint32_t shard) const
+{
+    NS_ASSERT_MSG(shard < m_shardClients.size(), "Invalid shard " << shard);
+    return m_shardClients[shard];
+}
+
+std::map<std::string, ApplicationContainer>
+NrtvHelper::GetShardInformation() const
+{
+    std::map<std::string, ApplicationContainer> ret;
+    for (uint32_t i = 0; i < m_shardNodes.size(); i++)
+    {
+        std::ostringstream oss;
+        oss << "server-" << m_shardNodes[i]->GetId();
+        ret[oss.str()] = m_shardClients[i];
+    }
+    return ret;
+}
+
+int64_t
+NrtvHelper::AssignStreams(int64_t stream)
+{
+    return m_nrtvVariables->AssignStreams(stream);
+}
+
 ApplicationContainer
 NrtvHelper::GetClients() const
 {
@@ -34,8 +34,10 @@
 #include <ns3/nrtv-udp-server.h>
 #include <ns3/nrtv-variables.h>
 #include <ns3/object-factory.h>
+#include <ns3/server-shard-helper.h>
 
 #include <map>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -170,6 +172,15 @@ class NrtvServerHelper
      */
     ApplicationContainer Install(std::string nodeName) const;
 
+    /**
+     * \brief Get the value of an attribute as it would be given to the
+     *        NrtvServer installed next, without creating the application.
+     *
+     * \param name the name of the attribute
+     * \param value the value set with SetAttribute(), or else the default value
+     */
+    void GetAttribute(std::string name, AttributeValue& value) const;
+
   private:
     /**
      * \internal
@@ -182,6 +193,8 @@ class NrtvServerHelper
     Ptr<Application> InstallPriv(Ptr<Node> node) const;
 
     ObjectFactory m_factory;
+    /// Values given to SetAttribute(), indexed by the name of the attribute.
+    std::map<std::string, Ptr<AttributeValue>> m_attributes;
 
 }; // end of `class NrtvServerHelper`
 
@@ -195,7 +208,7 @@ class NrtvHelper
   public:
     /**
      * \brief Create a NrtvHelper to make it easier to work with
-     *        NrtvTcpClient and NrtvTcpServer or alternatively PacketSink
+     *        NrtvTcpClient and NrtvTcpServer or alternatively NrtvUdpClient
      *        and NrtvUdpServer applications.
      *
      * \param protocolTid The TypeId of the protocol to be used by the server
@@ -207,7 +220,7 @@ class NrtvHelper
     virtual ~NrtvHelper();
 
     /**
-     * \brief Helper function used to set the underlying NrtvTcpClient or PacketSink
+     * \brief Helper function used to set the underlying NrtvTcpClient or NrtvUdpClient
      *        application attributes, but *not* the socket attributes.
      *
      * \param name the name of the application attribute to set
@@ -227,14 +240,29 @@ class NrtvHelper
 
     /**
      * \brief Helper function used to set the NrtvVariables attributes
-     *        used by this helper instance. Currently, only number of videos
-     *        specified in the Variables class is used.
+     *        used by this helper instance. Unless the `ViewSubstreams`
+     *        attribute is enabled, only number of videos specified in the
+     *        Variables class is used.
      *
      * \param name the name of the application attribute to set
      * \param value the value of the application attribute to set
      */
     void SetVariablesAttribute(std::string name, const AttributeValue& value);
 
+    /**
+     * \brief Assign fixed random variable streams to the NrtvVariables instance
+     *        of this helper, see NrtvVariables::AssignStreams().
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this helper
+     *
+     * If the `ViewSubstreams` attribute of the variables is enabled (see
+     * SetVariablesAttribute()), the installed servers and TCP clients share
+     * the NrtvVariables instance of this helper, each of them drawing from
+     * its own substream of the stream assigned here.
+     */
+    int64_t AssignStreams(int64_t stream);
+
     /**
      * \brief Install an Nrtv Server application and several Nrtv client
      *        applications, in which each client is connected using IPv4 to the
@@ -252,9 +280,41 @@ class NrtvHelper
      * with SetClientAttribute() and SetServerAttribute(). Pointers to these
      * applications can be retrieved afterwards by calling GetClients() and
      * GetServer() methods separately.
+     *
+     * The address of the server is taken from the first interface of the
+     * server node. See the other overload for use with the distributed
+     * simulator.
      */
     ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes);
 
+    /**
+     * \brief Install an Nrtv Server application and several Nrtv client
+     *        applications, in which each client is connected using IPv4 to the
+     *        server at the given address.
+     *
+     * \param serverNode the node on which an NrtvServer will be installed
+     * \param serverAddress the IPv4 address of the server node, which is used
+     *                      as is, without reading the IPv4 object of the node
+     * \param clientNodes the set of nodes on which NrtvClient applications will
+     *                    be installed
+     * \return container of Ptr to the server and client applications installed
+     *         on the local system
+     *
+     * Suitable for the distributed simulator, where each process calls this
+     * method with the same arguments. Applications are installed only on the
+     * nodes whose system ID matches Simulator::GetSystemId(), so GetServer()
+     * is empty in every process but the one owning the server node. Without
+     * the distributed simulator, every node is local.
+     *
+     * With UDP, the server must know the address of every client, so the
+     * addresses are read from the first interface of the client nodes, which
+     * must therefore be configured in every process, as the distributed
+     * simulator anyway requires.
+     */
+    ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode,
+                                          Ipv4Address serverAddress,
+                                          NodeContainer clientNodes);
+
     /**
      * \brief Install an Nrtv Server application and an Nrtv client
      *        applications, in which each client is connected using IPv4 to the
@@ -274,6 +334,76 @@ class NrtvHelper
      */
     ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode, Ptr<Node> clientNode);
 
+    /**
+     * \brief Install an Nrtv Server application on each of several server
+     *        nodes and several Nrtv client applications, in which each client
+     *        is connected using IPv4 to one of the servers.
+     *
+     * \param serverNodes the nodes on which NrtvServer applications will be
+     *                    installed
+     * \param clientNodes the set of nodes on which NrtvClient applications will
+     *                    be installed
+     * \return container of Ptr to the server and client applications installed
+     *
+     * \warning The given nodes must have Internet stack installed properly
+     *          before this method can be called.
+     *
+     * The clients are split between the servers according to the policy given
+     * to SetShardPolicy(), so that no single server (and server node) has to
+     * handle all the clients. Each server and its clients are then installed
+     * like with the single-server overload, reading the address of the server
+     * from the first interface of the server node.
+     *
+     * GetServer() and GetClients() return all the servers and all the clients,
+     * while GetShardServer() and GetShardClients() return those of a single
+     * server. The load counted by the policy accumulates over consecutive
+     * calls of this method, until ResetShards() is called.
+     */
+    ApplicationContainer InstallUsingIpv4(NodeContainer serverNodes, NodeContainer clientNodes);
+
+    /**
+     * \param policy the policy of splitting the clients between the servers in
+     *               the subsequent calls of the sharded InstallUsingIpv4()
+     *               (round-robin by default)
+     */
+    void SetShardPolicy(ServerShardHelper::ShardPolicy_t policy);
+
+    /// Forget the clients counted by the `SHARD_LEAST_LOADED` shard policy.
+    void ResetShards();
+
+    /**
+     * \return the number of servers installed by the previous call of
+     *         InstallUsingIpv4(), i.e., one unless the sharded overload was
+     *         used, or zero if it has never been called before
+     */
+    uint32_t GetNumOfShards() const;
+
+    /**
+     * \param shard index of the server, less than GetNumOfShards()
+     * \return an application container containing the server of the shard, or
+     *         an empty container if the server node is not simulated by this
+     *         process
+     */
+    ApplicationContainer GetShardServer(uint32_t shard) const;
+
+    /**
+     * \param shard index of the server, less than GetNumOfShards()
+     * \return an application container containing the clients connected to
+     *         the server of the shard
+     */
+    ApplicationContainer GetShardClients(uint32_t shard) const;
+
+    /**
+     * \brief Group the clients by their server, e.g., as the receiver
+     *        information of an ApplicationStatsHelper with
+     *        `IDENTIFIER_RECEIVER`, so that the statistics are computed per
+     *        server.
+     *
+     * \return the clients of each shard, named `server-<node ID>` after the
+     *         server node
+     */
+    std::map<std::string, ApplicationContainer> GetShardInformation() const;
+
     /**
      * \brief Retrieve pointers to the NRTV clients which were installed by the
      *        previous call of Install().
@@ -298,6 +428,10 @@ class NrtvHelper
     Ptr<NrtvVariables> m_nrtvVariables;
     ApplicationContainer m_lastInstalledClients;
     ApplicationContainer m_lastInstalledServer;
+    ServerShardHelper m_shardHelper;
+    std::vector<Ptr<Node>> m_shardNodes;
+    std::vector<ApplicationContainer> m_shardServers;
+    std::vector<ApplicationContainer> m_shardClients;
 
     /**
      * TypeId of the protocol to be used
@@ -0,0 +1,157 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "server-shard-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+
+NS_LOG_COMPONENT_DEFINE("ServerShardHelper");
+
+namespace ns3
+{
+
+std::string // static
+ServerShardHelper::GetShardPolicyName(ServerShardHelper::ShardPolicy_t policy)
+{
+    switch (policy)
+    {
+    case ServerShardHelper::SHARD_ROUND_ROBIN:
+        return "SHARD_ROUND_ROBIN";
+    case ServerShardHelper::SHARD_HASH:
+        return "SHARD_HASH";
+    case ServerShardHelper::SHARD_LEAST_LOADED:
+        return "SHARD_LEAST_LOADED";
+    default:
+        NS_FATAL_ERROR("ServerShardHelper - Invalid shard policy");
+        break;
+    }
+
+    NS_FATAL_ERROR("ServerShardHelper - Invalid shard policy");
+    return "";
+}
+
+ServerShardHelper::ServerShardHelper(ShardPolicy_t policy)
+    : m_policy(policy),
+      m_nextServer(0)
+{
+    NS_LOG_FUNCTION(this << GetShardPolicyName(policy));
+}
+
+void
+ServerShardHelper::SetPolicy(ShardPolicy_t policy)
+{
+    NS_LOG_FUNCTION(this << GetShardPolicyName(policy));
+    m_policy = policy;
+}
+
+ServerShardHelper::ShardPolicy_t
+ServerShardHelper::GetPolicy() const
+{
+    return m_policy;
+}
+
+std::vector<NodeContainer>
+ServerShardHelper::Assign(NodeContainer serverNodes, NodeContainer clientNodes)
+{
+    NS_LOG_FUNCTION(this << serverNodes.GetN() << clientNodes.GetN());
+    NS_ABORT_MSG_IF(serverNodes.GetN() == 0, "At least one server node is required");
+
+    std::vector<NodeContainer> ret(serverNodes.GetN());
+    for (NodeContainer::Iterator it = clientNodes.Begin(); it != clientNodes.End(); ++it)
+    {
+        const uint32_t i = Choose(serverNodes, *it);
+        NS_LOG_INFO(this << " client node " << (*it)->GetId() << " is assigned to server node "
+                         << serverNodes.Get(i)->GetId());
+        ret[i].Add(*it);
+        m_loads[serverNodes.Get(i)->GetId()]++;
+    }
+
+    return ret;
+}
+
+void
+ServerShardHelper::AddLoad(Ptr<Node> serverNode, uint32_t numOfClients)
+{
+    NS_LOG_FUNCTION(this << serverNode->GetId() << numOfClients);
+    m_loads[serverNode->GetId()] += numOfClients;
+}
+
+uint32_t
+ServerShardHelper::GetLoad(Ptr<Node> serverNode) const
+{
+    std::map<uint32_t, uint32_t>::const_iterator it = m_loads.find(serverNode->GetId());
+    return (it == m_loads.end()) ? 0 : it->second;
+}
+
+void
+ServerShardHelper::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_loads.clear();
+    m_nextServer = 0;
+}
+
+uint32_t
+ServerShardHelper::Choose(const NodeContainer& serverNodes, Ptr<Node> clientNode)
+{
+    const uint32_t n = serverNodes.GetN();
+
+    switch (m_policy)
+    {
+    case SHARD_ROUND_ROBIN: {
+        const uint32_t i = m_nextServer % n;
+        m_nextServer = i + 1;
+        return i;
+    }
+
+    case SHARD_HASH: {
+        // Multiplicative hashing spreads consecutive node IDs, and the choice
+        // does not depend on the order or the number of the client nodes.
+        const uint32_t hash = clientNode->GetId() * 2654435761U;
+        return static_cast<uint32_t>((static_cast<uint64_t>(hash) * n) >> 32);
+    }
+
+    case SHARD_LEAST_LOADED: {
+        // Ties go to the server which comes first.
+        uint32_t best = 0;
+        uint32_t bestLoad = GetLoad(serverNodes.Get(0));
+        for (uint32_t i = 1; i < n; i++)
+        {
+            const uint32_t load = GetLoad(serverNodes.Get(i));
+            if (load < bestLoad)
+            {
+                best = i;
+                bestLoad = load;
+            }
+        }
+        return best;
+    }
+
+    default:
+        NS_FATAL_ERROR("ServerShardHelper - Invalid shard policy " << m_policy);
+        break;
+    }
+
+    return 0;
+
+} // end of `uint32_t Choose (const NodeContainer &, Ptr<Node>)`
+
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SERVER_SHARD_HELPER_H
+#define SERVER_SHARD_HELPER_H
+
+#include <ns3/node-container.h>
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief Assigns client nodes to one of several server nodes.
+ *
+ * Used by the sharded install methods of NrtvHelper and ThreeGppHttpHelper,
+ * which install one server application on each server node and connect each
+ * client to the server chosen by this class, instead of connecting every
+ * client to a single server application.
+ *
+ * The helper remembers how many clients it has assigned to each server node
+ * (see GetLoad()), so that consecutive calls of Assign() keep balancing the
+ * load, e.g., when clients are installed in several batches.
+ */
+class ServerShardHelper
+{
+  public:
+    /**
+     * \enum ShardPolicy_t
+     * \brief Policies of choosing the server of a client.
+     */
+    typedef enum
+    {
+        /// The servers take turns, continuing from where the previous call stopped.
+        SHARD_ROUND_ROBIN = 0,
+        /// The server is chosen by a hash of the ID of the client node.
+        SHARD_HASH,
+        /// The server with the smallest number of clients assigned so far is chosen.
+        SHARD_LEAST_LOADED
+    } ShardPolicy_t;
+
+    /**
+     * \param policy a shard policy.
+     * \return the name of the policy in string.
+     */
+    static std::string GetShardPolicyName(ShardPolicy_t policy);
+
+    /**
+     * \brief Create a new helper.
+     * \param policy the policy of choosing the server of a client.
+     */
+    ServerShardHelper(ShardPolicy_t policy = SHARD_ROUND_ROBIN);
+
+    /**
+     * \param policy the policy of choosing the server of a client in the
+     *               subsequent calls of Assign().
+     */
+    void SetPolicy(ShardPolicy_t policy);
+
+    /**
+     * \return the policy of choosing the server of a client.
+     */
+    ShardPolicy_t GetPolicy() const;
+
+    /**
+     * \brief Split the client nodes between the server nodes.
+     * \param serverNodes the candidate servers, which must not be empty.
+     * \param clientNodes the clients to be assigned.
+     * \return one container of client nodes per server node, in the same order
+     *         as the server nodes; a container is empty if no client is
+     *         assigned to the corresponding server.
+     *
+     * The relative order of the client nodes is preserved within each
+     * container.
+     */
+    std::vector<NodeContainer> Assign(NodeContainer serverNodes, NodeContainer clientNodes);
+
+    /**
+     * \brief Account for clients which are connected to a server by other
+     *        means, so that the `SHARD_LEAST_LOADED` policy takes them into
+     *        account.
+     * \param serverNode the server node.
+     * \param numOfClients number of clients to be added to the load.
+     */
+    void AddLoad(Ptr<Node> serverNode, uint32_t numOfClients);
+
+    /**
+     * \param serverNode a server node.
+     * \return number of clients assigned to the server node so far.
+     */
+    uint32_t GetLoad(Ptr<Node> serverNode) const;
+
+    /// Forget the load of every server and restart the round-robin turns.
+    void Reset();
+
+  private:
+    /**
+     * \param serverNodes the candidate servers.
+     * \param clientNode the client to be assigned.
+     * \return index of the chosen server within the candidates.
+     */
+    uint32_t Choose(const NodeContainer& serverNodes, Ptr<Node> clientNode);
+
+    ShardPolicy_t m_policy;               ///< Policy of choosing the server.
+    uint32_t m_nextServer;                ///< Turn of the round-robin policy.
+    std::map<uint32_t, uint32_t> m_loads; ///< Number of clients, indexed by server node ID.
+
+}; // end of `class ServerShardHelper`
+
+} // namespace ns3
+
+#endif /* SERVER_SHARD_HELPER_H */
@@ -29,8 +29,12 @@
 
 #include <ns3/ipv4.h>
 #include <ns3/names.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
 #include <ns3/three-gpp-http-satellite-helper.h>
 
+#include <sstream>
+
 namespace ns3
 {
 
@@ -135,6 +139,7 @@ ThreeGppHttpSatelliteServerHelper::InstallPriv(Ptr<Node> node) const
 // THREE GPP HTTP HELPER ////////////////////////////////////////////////////////////////
 
 ThreeGppHttpHelper::ThreeGppHttpHelper()
+    : m_shareVariables(false)
 {
     Address invalidAddr;
     m_clientHelper = new ThreeGppHttpSatelliteClientHelper(invalidAddr);
@@ -166,32 +171,67 @@ ThreeGppHttpHelper::SetVariablesAttribute(std::string name, const AttributeValue
     m_httpVariables->SetAttribute(name, value);
 }
 
+void
+ThreeGppHttpHelper::SetShareVariables(bool shareVariables)
+{
+    m_shareVariables = shareVariables;
+}
+
 ApplicationContainer
 ThreeGppHttpHelper::InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes)
 {
-    ApplicationContainer ret; // the return value of the function
-
     Ptr<Ipv4> ipv4 = serverNode->GetObject<Ipv4>();
     if (ipv4 == nullptr)
     {
         NS_FATAL_ERROR("No IPv4 object is found within the server node " << serverNode);
     }
-    else
-    {
-        /// Still unclear if the hard-coded indices below will work in any possible cases.
-        const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
-        const Ipv4Address serverAddress = interfaceAddress.GetLocal();
 
-        m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
+    /// Still unclear if the hard-coded indices below will work in any possible cases.
+    const Ipv4InterfaceAddress interfaceAddress = ipv4->GetAddress(1, 0);
+    return InstallUsingIpv4(serverNode, interfaceAddress.GetLocal(), clientNodes);
+}
+
+ApplicationContainer
+ThreeGppHttpHelper::InstallUsingIpv4(Ptr<Node> serverNode,
+                                     Ipv4Address serverAddress,
+                                     NodeContainer clientNodes)
+{
+    ApplicationContainer ret; // the return value of the function
+    const uint32_t systemId = Simulator::GetSystemId();
+
+    m_serverHelper->SetAttribute("LocalAddress", AddressValue(serverAddress));
 
+    m_lastInstalledServer = ApplicationContainer();
+    if (serverNode->GetSystemId() == systemId)
+    {
         m_lastInstalledServer = m_serverHelper->Install(serverNode);
         ret.Add(m_lastInstalledServer);
+    }
 
-        m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
-        m_lastInstalledClients = m_clientHelper->Install(clientNodes);
-        ret.Add(m_lastInstalledClients);
+    // Only the client nodes simulated by this process get an application.
+    NodeContainer localClientNodes;
+    for (auto it = clientNodes.Begin(); it != clientNodes.End(); it++)
+    {
+        if ((*it)->GetSystemId() == systemId)
+        {
+            localClientNodes.Add(*it);
+        }
     }
 
+    m_clientHelper->SetAttribute("RemoteServerAddress", AddressValue(serverAddress));
+    Ptr<ThreeGppHttpVariables> variables;
+    if (m_shareVariables)
+    {
+        variables = m_httpVariables;
+    }
+    m_clientHelper->SetAttribute("Variables", PointerValue(variables));
+    m_lastInstalledClients = m_clientHelper->Install(localClientNodes);
+    ret.Add(m_lastInstalledClients);
+
+    m_shardNodes.assign(1, serverNode);
+    m_shardServers.assign(1, m_lastInstalledServer);
+    m_shardClients.assign(1, m_lastInstalledClients);
+
     return ret;
 }
 
@@ -201,6 +241,82 @@ ThreeGppHttpHelper::InstallUsingIpv4(Ptr<Node> serverNode, Ptr<Node> clientNode)
     return InstallUsingIpv4(serverNode, NodeContainer(clientNode));
 }
 
+ApplicationContainer
+ThreeGppHttpHelper::InstallUsingIpv4(NodeContainer serverNodes, NodeContainer clientNodes)
+{
+    const std::vector<NodeContainer> shards = m_shardHelper.Assign(serverNodes, clientNodes);
+    std::vector<Ptr<Node>> shardNodes;
+    std::vector<ApplicationContainer> shardServers;
+    std::vector<ApplicationContainer> shardClients;
+    ApplicationContainer allServers;
+    ApplicationContainer allClients;
+
+    for (uint32_t i = 0; i < serverNodes.GetN(); i++)
+    {
+        InstallUsingIpv4(serverNodes.Get(i), shards[i]);
+        shardNodes.push_back(serverNodes.Get(i));
+        shardServers.push_back(m_lastInstalledServer);
+        shardClients.push_back(m_lastInstalledClients);
+        allServers.Add(m_lastInstalledServer);
+        allClients.Add(m_lastInstalledClients);
+    }
+
+    m_shardNodes = shardNodes;
+    m_shardServers = shardServers;
+    m_shardClients = shardClients;
+    m_lastInstalledServer = allServers;
+    m_lastInstalledClients = allClients;
+
+    ApplicationContainer ret(allServers);
+    ret.Add(allClients);
+    return ret;
+}
+
+void
+ThreeGppHttpHelper::SetShardPolicy(ServerShardHelper::ShardPolicy_t policy)
+{
+    m_shardHelper.SetPolicy(policy);
+}
+
+void
+ThreeGppHttpHelper::ResetShards()
+{
+    m_shardHelper.Reset();
+}
+
+uint32_t
+ThreeGppHttpHelper::GetNumOfShards() const
+{
+    return m_shardServers.size();
+}
+
+ApplicationContainer
+ThreeGppHttpHelper::GetShardServer(uint32_t shard) const
+{
+    NS_ASSERT_MSG(shard < m_shardServers.size(), "Invalid shard " << shard);
+    return m_shardServers[shard];
+}
+
+ApplicationContainer
+ThreeGppHttpHelper::GetShardClients(uint32_t shard) const
+{
+    NS_ASSERT_MSG(shard < m_shardClients.size(), "Invalid shard " << shard);
+    return m_shardClients[shard];
+}
+
+std::map<std::string, ApplicationContainer>
+ThreeGppHttpHelper::GetShardInformation() const
+{
+    std::map<std::string, ApplicationContainer> ret;
+    for (uint32_t i = 0; i < m_shardNodes.size(); i++)
+    {
+        std::ostringstream oss;
+        oss << "server-" << m_shardNodes[i]->GetId();
+        ret[oss.str()] = m_shardClients[i];
+    }
+    return ret;
+}
+
 ApplicationContainer
 ThreeGppHttpHelper::GetClients() const
 {
@@ -31,11 +31,17 @@
 #define THREE_GPP_HTTP_SATELLITE_HELPER_H
 
 #include <ns3/application-container.h>
+#include <ns3/ipv4-address.h>
 #include <ns3/node-container.h>
 #include <ns3/object-factory.h>
+#include <ns3/server-shard-helper.h>
 #include <ns3/three-gpp-http-helper.h>
 #include <ns3/three-gpp-http-variables.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace ns3
 {
 
@@ -214,6 +220,23 @@ class ThreeGppHttpHelper
      */
     void SetVariablesAttribute(std::string name, const AttributeValue& value);
 
+    /**
+     * \brief Let all clients installed afterwards draw from the same
+     *        ThreeGppHttpVariables instance, i.e., the one configured by
+     *        SetVariablesAttribute().
+     *
+     * \param shareVariables if true, the clients share a single instance of the
+     *                       variables and its random variables, which saves
+     *                       memory with a large number of clients. Otherwise
+     *                       (the default), each client creates its own instance
+     *                       upon construction.
+     *
+     * Sharing the variables does not change their distributions, but the
+     * clients then consume a common stream of random numbers, so the
+     * individual samples differ from those of the unshared configuration.
+     */
+    void SetShareVariables(bool shareVariables);
+
     /**
      * \brief Install an ThreeGppHttp Server application and several ThreeGppHttp client
      *        applications, in which each client is connected using IPv4 to the
@@ -231,9 +254,36 @@ class ThreeGppHttpHelper
      * with SetClientAttribute() and SetServerAttribute(). Pointers to these
      * applications can be retrieved afterwards by calling GetClients() and
      * GetServer() methods separately.
+     *
+     * The address of the server is taken from the first interface of the
+     * server node. See the other overload for use with the distributed
+     * simulator.
      */
     ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode, NodeContainer clientNodes);
 
+    /**
+     * \brief Install an ThreeGppHttp Server application and several ThreeGppHttp client
+     *        applications, in which each client is connected using IPv4 to the
+     *        server at the given address.
+     *
+     * \param serverNode the node on which an ThreeGppHttpServer will be installed
+     * \param serverAddress the IPv4 address of the server node, which is used
+     *                      as is, without reading the IPv4 object of the node
+     * \param clientNodes the set of nodes on which ThreeGppHttpClient applications will
+     *                    be installed
+     * \return container of Ptr to the server and client applications installed
+     *         on the local system
+     *
+     * Suitable for the distributed simulator, where each process calls this
+     * method with the same arguments. Applications are installed only on the
+     * nodes whose system ID matches Simulator::GetSystemId(), so GetServer()
+     * is empty in every process but the one owning the server node. Without
+     * the distributed simulator, every node is local.
+     */
+    ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode,
+                                          Ipv4Address serverAddress,
+                                          NodeContainer clientNodes);
+
     /**
      * \brief Install an ThreeGppHttp Server application and an ThreeGppHttp client
      *        applications, in which each client is connected using IPv4 to the
@@ -253,6 +303,70 @@ class ThreeGppHttpHelper
      */
     ApplicationContainer InstallUsingIpv4(Ptr<Node> serverNode, Ptr<Node> clientNode);
 
+    /**
+     * \brief Install an ThreeGppHttp Server application on each of several
+     *        server nodes and several ThreeGppHttp client applications, in
+     *        which each client is connected using IPv4 to one of the servers.
+     *
+     * \param serverNodes the nodes on which ThreeGppHttpServer applications
+     *                    will be installed
+     * \param clientNodes the set of nodes on which ThreeGppHttpClient applications will
+     *                    be installed
+     * \return container of Ptr to the server and client applications installed
+     *
+     * \warning The given nodes must have Internet stack installed properly
+     *          before this method can be called.
+     *
+     * The clients are split between the servers according to the policy given
+     * to SetShardPolicy(), and each server and its clients are then installed
+     * like with the single-server overload. GetServer() and GetClients()
+     * return all the servers and all the clients, while GetShardServer() and
+     * GetShardClients() return those of a single server.
+     */
+    ApplicationContainer InstallUsingIpv4(NodeContainer serverNodes, NodeContainer clientNodes);
+
+    /**
+     * \param policy the policy of splitting the clients between the servers in
+     *               the subsequent calls of the sharded InstallUsingIpv4()
+     *               (round-robin by default)
+     */
+    void SetShardPolicy(ServerShardHelper::ShardPolicy_t policy);
+
+    /// Forget the clients counted by the `SHARD_LEAST_LOADED` shard policy.
+    void ResetShards();
+
+    /**
+     * \return the number of servers installed by the previous call of
+     *         InstallUsingIpv4(), i.e., one unless the sharded overload was
+     *         used, or zero if it has never been called before
+     */
+    uint32_t GetNumOfShards() const;
+
+    /**
+     * \param shard index of the server, less than GetNumOfShards()
+     * \return an application container containing the server of the shard, or
+     *         an empty container if the server node is not simulated by this
+     *         process
+     */
+    ApplicationContainer GetShardServer(uint32_t shard) const;
+
+    /**
+     * \param shard index of the server, less than GetNumOfShards()
+     * \return an application container containing the clients connected to
+     *         the server of the shard
+     */
+    ApplicationContainer GetShardClients(uint32_t shard) const;
+
+    /**
+     * \brief Group the clients by their server, e.g., as the receiver
+     *        information of an ApplicationStatsHelper with
+     *        `IDENTIFIER_RECEIVER`.
+     *
+     * \return the clients of each shard, named `server-<node ID>` after the
+     *         server node
+     */
+    std::map<std::string, ApplicationContainer> GetShardInformation() const;
+
     /**
      * \brief Retrieve pointers to the 3GPP HTTP clients which were installed by the
      *        previous call of Install().
@@ -275,8 +389,13 @@ class ThreeGppHttpHelper
     ThreeGppHttpSatelliteServerHelper* m_serverHelper;
     ThreeGppHttpSatelliteClientHelper* m_clientHelper;
     Ptr<ThreeGppHttpVariables> m_httpVariables;
+    bool m_shareVariables;
     ApplicationContainer m_lastInstalledClients;
     ApplicationContainer m_lastInstalledServer;
+    ServerShardHelper m_shardHelper;
+    std::vector<Ptr<Node>> m_shardNodes;
+    std::vector<ApplicationContainer> m_shardServers;
+    std::vector<ApplicationContainer> m_shardClients;
 
 }; // end of `class ThreeGppHttpHelper`
 
@@ -21,13 +21,17 @@
 #include "cbr-application.h"
 
 #include "traffic-time-tag.h"
+#include "traffic-timestamp-header.h"
 
+#include <ns3/abort.h>
 #include <ns3/boolean.h>
+#include <ns3/enum.h>
 #include <ns3/inet-socket-address.h>
 #include <ns3/inet6-socket-address.h>
 #include <ns3/log.h>
 #include <ns3/node.h>
 #include <ns3/packet.h>
+#include <ns3/pointer.h>
 #include <ns3/random-variable-stream.h>
 #include <ns3/simulator.h>
 #include <ns3/socket-factory.h>
@@ -37,6 +41,9 @@
 #include <ns3/udp-socket-factory.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <sstream>
+
 NS_LOG_COMPONENT_DEFINE("CbrApplication");
 
 namespace ns3
@@ -78,6 +85,69 @@ CbrApplication::GetTypeId(void)
                           BooleanValue(false),
                           MakeBooleanAccessor(&CbrApplication::m_isStatisticsTagsEnabled),
                           MakeBooleanChecker())
+            .AddAttribute("UsePacketTemplate",
+                          "If true, every packet is a copy-on-write copy of a payload built "
+                          "once, instead of a new packet. All the copies share the UID of "
+                          "the template.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CbrApplication::m_isPacketTemplateEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableTimestampHeader",
+                          "If true, and EnableStatisticsTags is true, the send time is "
+                          "written into a TrafficTimestampHeader at the beginning of the "
+                          "payload instead of a TrafficTimeTag. The packet size is not "
+                          "affected, but must be at least the size of the header.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CbrApplication::m_isTimestampHeaderEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("RateEnvelope",
+                          "Cyclic piecewise-constant envelope of the packet rate, given as "
+                          "comma-separated `duration:multiplier` segments, e.g., "
+                          "\"6h:0.2,18h:1.0\". Empty string disables the envelope.",
+                          StringValue(""),
+                          MakeStringAccessor(&CbrApplication::SetRateEnvelope,
+                                             &CbrApplication::GetRateEnvelope),
+                          MakeStringChecker())
+            .AddAttribute("EnableOnOff",
+                          "If true, packets are sent only during the on periods.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CbrApplication::m_isOnOffEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("OnTime",
+                          "A random variable for the duration of an on period in seconds.",
+                          StringValue("ns3::ExponentialRandomVariable[Mean=1.0]"),
+                          MakePointerAccessor(&CbrApplication::m_onTime),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("OffTime",
+                          "A random variable for the duration of an off period in seconds.",
+                          StringValue("ns3::ExponentialRandomVariable[Mean=1.0]"),
+                          MakePointerAccessor(&CbrApplication::m_offTime),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("ScheduleChunkSize",
+                          "Number of transmission times computed at a time when the packet "
+                          "rate follows a rate envelope or on/off periods.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&CbrApplication::m_scheduleChunkSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ScheduleLogMode",
+                          "Whether the transmission times under a rate profile are recorded "
+                          "into the schedule log, or replayed from it. Must be set before "
+                          "`ScheduleLogFile`.",
+                          EnumValue(TrafficScheduleLog::DISABLED),
+                          MakeEnumAccessor(&CbrApplication::m_scheduleLogMode),
+                          MakeEnumChecker(TrafficScheduleLog::DISABLED,
+                                          "DISABLED",
+                                          TrafficScheduleLog::RECORD,
+                                          "RECORD",
+                                          TrafficScheduleLog::REPLAY,
+                                          "REPLAY"))
+            .AddAttribute("ScheduleLogFile",
+                          "Name of the schedule log file (see TrafficScheduleLog). Empty "
+                          "means neither recording nor replaying.",
+                          StringValue(""),
+                          MakeStringAccessor(&CbrApplication::SetScheduleLogFile,
+                                             &CbrApplication::GetScheduleLogFile),
+                          MakeStringChecker())
             .AddTraceSource("Tx",
                             "A new packet is created and is sent",
                             MakeTraceSourceAccessor(&CbrApplication::m_txTrace),
@@ -90,7 +160,15 @@ CbrApplication::CbrApplication()
       m_pktSize(0),
       m_lastStartTime(Seconds(0)),
       m_totTxBytes(0),
-      m_isStatisticsTagsEnabled(false)
+      m_isStatisticsTagsEnabled(false),
+      m_isPacketTemplateEnabled(false),
+      m_isTimestampHeaderEnabled(false),
+      m_isOnOffEnabled(false),
+      m_scheduleChunkSize(1),
+      m_phase(0.0),
+      m_segmentIndex(0),
+      m_isOn(true),
+      m_scheduleLogMode(TrafficScheduleLog::DISABLED)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -113,12 +191,73 @@ CbrApplication::GetRemote(void) const
     return m_peer;
 }
 
+void
+CbrApplication::SetRateEnvelope(std::string envelope)
+{
+    NS_LOG_FUNCTION(this << envelope);
+
+    std::vector<std::pair<Time, double>> segments;
+    bool hasPositiveRate = false;
+    std::istringstream iss(envelope);
+    std::string segment;
+
+    while (std::getline(iss, segment, ','))
+    {
+        const std::string::size_type colon = segment.find(':');
+        NS_ABORT_MSG_IF(colon == std::string::npos,
+                        "Invalid segment '" << segment << "' in rate envelope " << envelope);
+        const Time duration(segment.substr(0, colon));
+        const double multiplier = std::stod(segment.substr(colon + 1));
+        NS_ABORT_MSG_UNLESS(duration.IsStrictlyPositive(),
+                            "Invalid duration in rate envelope " << envelope);
+        NS_ABORT_MSG_IF(multiplier < 0.0, "Negative multiplier in rate envelope " << envelope);
+        hasPositiveRate = hasPositiveRate || (multiplier > 0.0);
+        segments.push_back(std::make_pair(duration, multiplier));
+    }
+
+    NS_ABORT_MSG_IF(!segments.empty() && !hasPositiveRate,
+                    "Rate envelope " << envelope << " never sends any packet");
+    m_rateEnvelopeString = envelope;
+    m_rateEnvelope.swap(segments);
+}
+
+std::string
+CbrApplication::GetRateEnvelope() const
+{
+    return m_rateEnvelopeString;
+}
+
+void
+CbrApplication::SetScheduleLogFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName << m_scheduleLogMode);
+    m_scheduleLogFile = fileName;
+    m_scheduleLog.Open(fileName, m_scheduleLogMode);
+}
+
+std::string
+CbrApplication::GetScheduleLogFile() const
+{
+    return m_scheduleLogFile;
+}
+
+int64_t
+CbrApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_onTime->SetStream(stream);
+    m_offTime->SetStream(stream + 1);
+    return 2;
+}
+
 void
 CbrApplication::DoDispose(void)
 {
     NS_LOG_FUNCTION(this);
 
     m_socket = nullptr;
+    m_packetTemplate = nullptr;
+    m_scheduleLog.Close();
     // chain up
     Application::DoDispose();
 }
@@ -129,9 +268,14 @@ CbrApplication::StartApplication() // Called at time specified by Start
 {
     NS_LOG_FUNCTION(this);
 
+    NS_ABORT_MSG_IF(m_isStatisticsTagsEnabled && m_isTimestampHeaderEnabled &&
+                        (m_pktSize < TrafficTimestampHeader::GetStaticSerializedSize()),
+                    "PacketSize " << m_pktSize << " is too small for the timestamp header");
+
     // Create the socket if not already
     if (!m_socket)
     {
+        TRAFFIC_COUNTERS_REGISTER(m_counters, "ns3::CbrApplication", GetNode()->GetId());
         m_socket = Socket::CreateSocket(GetNode(), m_tid);
         m_socket->Bind();
 
@@ -150,6 +294,7 @@ CbrApplication::StopApplication() // Called at time specified by Stop
     NS_LOG_FUNCTION(this);
 
     Simulator::Cancel(m_sendEvent);
+    m_schedule.clear();
 
     if (m_socket != nullptr)
     {
@@ -174,25 +319,156 @@ CbrApplication::ScheduleNextTx()
 {
     NS_LOG_FUNCTION(this);
 
-    m_sendEvent = Simulator::Schedule(m_interval, &CbrApplication::SendPacket, this);
+    if (!HasRateProfile())
+    {
+        m_sendEvent = Simulator::Schedule(m_interval, &CbrApplication::SendPacket, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        return;
+    }
+
+    Time txTime;
+    if (m_scheduleLog.IsReplaying())
+    {
+        txTime = m_scheduleStartTime + m_scheduleLog.ReplayTime(LOG_TX_TIME);
+    }
+    else
+    {
+        if (m_schedule.empty())
+        {
+            ComputeScheduleChunk();
+        }
+
+        NS_ASSERT(!m_schedule.empty());
+        txTime = m_schedule.front();
+        m_schedule.pop_front();
+        // only the transmissions actually scheduled, not the whole chunk
+        m_scheduleLog.Record(LOG_TX_TIME, txTime - m_scheduleStartTime);
+    }
+
+    NS_ASSERT(txTime >= Simulator::Now());
+    m_sendEvent = Simulator::Schedule(txTime - Simulator::Now(), &CbrApplication::SendPacket, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+}
+
+bool
+CbrApplication::HasRateProfile() const
+{
+    return !m_rateEnvelope.empty() || m_isOnOffEnabled;
+}
+
+void
+CbrApplication::ResetSchedule()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_schedule.clear();
+    m_scheduleStartTime = Simulator::Now();
+    m_cursorTime = m_scheduleStartTime;
+    m_phase = 0.0;
+    m_segmentIndex = 0;
+    m_segmentEndTime =
+        m_rateEnvelope.empty() ? Time::Max() : m_cursorTime + m_rateEnvelope.front().first;
+    m_isOn = true;
+    m_periodEndTime = (m_isOnOffEnabled && !m_scheduleLog.IsReplaying())
+                          ? m_cursorTime + Seconds(m_onTime->GetValue())
+                          : Time::Max();
 }
 
+void
+CbrApplication::ComputeScheduleChunk()
+{
+    NS_LOG_FUNCTION(this << m_scheduleChunkSize);
+
+    for (uint32_t i = 0; i < m_scheduleChunkSize; i++)
+    {
+        m_schedule.push_back(ComputeNextTxTime());
+    }
+
+    NS_LOG_LOGIC(this << " scheduled transmissions until " << m_schedule.back().GetSeconds());
+}
+
+Time
+CbrApplication::ComputeNextTxTime()
+{
+    NS_ABORT_MSG_UNLESS(m_interval.IsStrictlyPositive(),
+                        "A rate profile requires a positive interval");
+    const double baseRate = 1.0 / m_interval.GetSeconds(); // packets per second
+
+    /*
+     * Walk through the constant-rate pieces delimited by the envelope segments
+     * and the on/off periods, until a whole interval has elapsed.
+     */
+    while (true)
+    {
+        const double multiplier =
+            m_rateEnvelope.empty() ? 1.0 : m_rateEnvelope[m_segmentIndex].second;
+        const double rate = m_isOn ? multiplier * baseRate : 0.0;
+        const Time boundary = std::min(m_segmentEndTime, m_periodEndTime);
+
+        if (rate > 0.0)
+        {
+            const Time txTime = m_cursorTime + Seconds((1.0 - m_phase) / rate);
+            if (txTime <= boundary)
+            {
+                m_cursorTime = txTime;
+                m_phase = 0.0;
+                return txTime;
+            }
+
+            m_phase += rate * (boundary - m_cursorTime).GetSeconds();
+        }
+
+        m_cursorTime = boundary;
+
+        if (boundary == m_segmentEndTime)
+        {
+            m_segmentIndex = (m_segmentIndex + 1) % m_rateEnvelope.size();
+            m_segmentEndTime += m_rateEnvelope[m_segmentIndex].first;
+        }
+
+        if (boundary == m_periodEndTime)
+        {
+            m_isOn = !m_isOn;
+            const double duration = m_isOn ? m_onTime->GetValue() : m_offTime->GetValue();
+            m_periodEndTime += Seconds(duration);
+            NS_LOG_LOGIC(this << " " << (m_isOn ? "on" : "off") << " period from "
+                              << m_cursorTime.GetSeconds() << " for " << duration << " seconds");
+        }
+    }
+
+} // end of `Time ComputeNextTxTime ()`
+
 void
 CbrApplication::SendPacket()
 {
     NS_LOG_FUNCTION(this);
 
     NS_ASSERT(m_sendEvent.IsExpired());
-    Ptr<Packet> packet = Create<Packet>(m_pktSize);
+    Ptr<Packet> packet;
 
-    if (m_isStatisticsTagsEnabled)
+    if (!m_isStatisticsTagsEnabled)
+    {
+        packet = CreatePayload(m_pktSize);
+    }
+    else if (m_isTimestampHeaderEnabled)
+    {
+        const uint32_t headerSize = TrafficTimestampHeader::GetStaticSerializedSize();
+        NS_ASSERT_MSG(m_pktSize >= headerSize, "PacketSize is too small for the timestamp header");
+        packet = CreatePayload(m_pktSize - headerSize);
+        packet->AddHeader(TrafficTimestampHeader(Simulator::Now()));
+    }
+    else
     {
+        packet = CreatePayload(m_pktSize);
         packet->AddPacketTag(TrafficTimeTag(Simulator::Now()));
     }
 
+    TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
     m_txTrace(packet);
     m_socket->Send(packet);
     m_totTxBytes += m_pktSize;
+
+#ifdef NS3_LOG_ENABLE
     if (InetSocketAddress::IsMatchingType(m_peer))
     {
         NS_LOG_INFO("At time " << Simulator::Now().GetSeconds() << "s cbr application sent "
@@ -209,11 +485,29 @@ CbrApplication::SendPacket()
                                << Inet6SocketAddress::ConvertFrom(m_peer).GetPort() << " total Tx "
                                << m_totTxBytes << " bytes");
     }
-    m_lastStartTime = Simulator::Now();
+#endif /* NS3_LOG_ENABLE */
 
+    m_lastStartTime = Simulator::Now();
     ScheduleNextTx();
 }
 
+Ptr<Packet>
+CbrApplication::CreatePayload(uint32_t size)
+{
+    if (!m_isPacketTemplateEnabled)
+    {
+        return Create<Packet>(size);
+    }
+
+    if (m_packetTemplate == nullptr || m_packetTemplate->GetSize() != size)
+    {
+        NS_LOG_LOGIC(this << " building a packet template of " << size << " bytes");
+        m_packetTemplate = Create<Packet>(size);
+    }
+
+    return m_packetTemplate->Copy();
+}
+
 void
 CbrApplication::ConnectionSucceeded(Ptr<Socket> socket)
 {
@@ -222,6 +516,7 @@ CbrApplication::ConnectionSucceeded(Ptr<Socket> socket)
     // Insure no pending event
     Simulator::Cancel(m_sendEvent);
 
+    ResetSchedule();
     ScheduleNextTx();
 }
 
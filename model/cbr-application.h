@@ -27,10 +27,19 @@
 #include <ns3/nstime.h>
 #include <ns3/ptr.h>
 #include <ns3/traced-callback.h>
+#include <ns3/traffic-counters.h>
+#include <ns3/traffic-schedule-log.h>
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
 
+class Packet;
+class RandomVariableStream;
 class Socket;
 
 /**
@@ -48,6 +57,43 @@ class Socket;
  *
  * If the underlying socket type supports broadcast, this application
  * will automatically enable the SetAllowBroadcast(true) socket option.
+ *
+ * The packet rate may optionally follow a rate profile, e.g., to emulate a
+ * diurnal load within a single simulation:
+ * - the `RateEnvelope` attribute is a cyclic, piecewise-constant envelope of
+ *   segments `duration:multiplier`, separated by commas, e.g.,
+ *   "6h:0.2,12h:1.0,6h:0.5". During each segment, packets are sent at the
+ *   multiplier times the rate given by `Interval`. A multiplier of zero
+ *   silences the segment. The envelope starts when the socket is connected
+ *   and repeats once its last segment has ended; and
+ * - if `EnableOnOff` is true, the application alternates between on and off
+ *   periods, whose durations are drawn from the `OnTime` and `OffTime`
+ *   random variables, beginning with an on period. No packet is sent during
+ *   an off period.
+ *
+ * Both may be used together. The transmission times under a rate profile are
+ * computed lazily, `ScheduleChunkSize` packets at a time, so neither the
+ * segment boundaries nor the on/off transitions require any simulator event
+ * or attribute update of their own. Partial intervals are carried across the
+ * boundaries, so the long-term packet rate follows the profile exactly.
+ *
+ * Under a rate profile, the `ScheduleLogMode` and `ScheduleLogFile` attributes
+ * make the application record its transmission times, relative to the start of
+ * the profile, into a TrafficScheduleLog, or replay them from it instead of
+ * evaluating the profile (see SetScheduleLogFile()). Without a rate profile,
+ * the transmission times are fixed by `Interval` and nothing is logged.
+ *
+ * By default, every packet is created anew and, with `EnableStatisticsTags`,
+ * carries its send time in a TrafficTimeTag. Two attributes instead make the
+ * transmission cheaper:
+ * - with `UsePacketTemplate`, every packet is a copy-on-write copy of a
+ *   payload built once, which avoids allocating a new buffer and new
+ *   metadata per packet. All the copies share the UID of the template; and
+ * - with `EnableTimestampHeader`, the send time is written into a
+ *   TrafficTimestampHeader at the beginning of the payload instead of a tag,
+ *   so that nothing needs to be copied along with the packet through the
+ *   layers. The packet size stays `PacketSize`, which must then be at least
+ *   the size of the header.
  */
 class CbrApplication : public Application
 {
@@ -85,6 +131,41 @@ class CbrApplication : public Application
         m_pktSize = packetSize;
     }
 
+    /**
+     * \param envelope the rate envelope, in the format of the `RateEnvelope`
+     *                 attribute, or an empty string to disable it.
+     */
+    void SetRateEnvelope(std::string envelope);
+
+    /**
+     * \return the rate envelope, in the format of the `RateEnvelope` attribute.
+     */
+    std::string GetRateEnvelope() const;
+
+    /**
+     * \param fileName name of the schedule log file, or an empty string to
+     *                 neither record nor replay.
+     *
+     * The log is opened in the mode given by the `ScheduleLogMode` attribute,
+     * so the mode must be set first. Each application becomes a new owner of
+     * the log, so the applications must be created in the same order when
+     * recording and when replaying.
+     */
+    void SetScheduleLogFile(std::string fileName);
+
+    /**
+     * \return name of the schedule log file, or an empty string if none.
+     */
+    std::string GetScheduleLogFile() const;
+
+    /**
+     * \brief Assign a fixed random variable stream number to the random
+     *        variables used by this application.
+     * \param stream first stream index to use.
+     * \return the number of stream indices assigned.
+     */
+    int64_t AssignStreams(int64_t stream);
+
   protected:
     /// Do dispose actions.
     virtual void DoDispose(void);
@@ -98,9 +179,39 @@ class CbrApplication : public Application
     uint32_t m_totTxBytes; // Total bytes sent so far
     EventId m_sendEvent;   // Event id of pending "send packet" event
     TypeId m_tid;
-    bool m_isStatisticsTagsEnabled; ///< `EnableStatisticsTags` attribute.
+    bool m_isStatisticsTagsEnabled;  ///< `EnableStatisticsTags` attribute.
+    bool m_isPacketTemplateEnabled;  ///< `UsePacketTemplate` attribute.
+    bool m_isTimestampHeaderEnabled; ///< `EnableTimestampHeader` attribute.
+    Ptr<Packet> m_packetTemplate;    ///< Payload copied by every packet, if enabled.
     TracedCallback<Ptr<const Packet>> m_txTrace;
 
+    std::string m_rateEnvelopeString; ///< `RateEnvelope` attribute.
+    /// Parsed `RateEnvelope` attribute, as (duration, multiplier) pairs.
+    std::vector<std::pair<Time, double>> m_rateEnvelope;
+    bool m_isOnOffEnabled;               ///< `EnableOnOff` attribute.
+    Ptr<RandomVariableStream> m_onTime;  ///< `OnTime` attribute.
+    Ptr<RandomVariableStream> m_offTime; ///< `OffTime` attribute.
+    uint32_t m_scheduleChunkSize;        ///< `ScheduleChunkSize` attribute.
+
+    std::deque<Time> m_schedule; ///< Precomputed transmission times.
+    Time m_cursorTime;           ///< Time up to which the profile has been evaluated.
+    double m_phase;              ///< Fraction of an interval elapsed at #m_cursorTime.
+    uint32_t m_segmentIndex;     ///< Current segment of the envelope.
+    Time m_segmentEndTime;       ///< End time of the current segment.
+    bool m_isOn;                 ///< True during an on period.
+    Time m_periodEndTime;        ///< End time of the current on or off period.
+    Time m_scheduleStartTime;    ///< Start time of the rate profile.
+
+    /// Variables logged in the schedule log.
+    typedef enum
+    {
+        LOG_TX_TIME = 0
+    } LogVariable_t;
+
+    TrafficScheduleLog::Mode_t m_scheduleLogMode; ///< `ScheduleLogMode` attribute.
+    std::string m_scheduleLogFile;                ///< `ScheduleLogFile` attribute.
+    TrafficScheduleLogHandle m_scheduleLog;       ///< Membership in the schedule log.
+
     // inherited from Application base class.
     virtual void StartApplication(void); // Called at time specified by Start
     virtual void StopApplication(void);  // Called at time specified by Stop
@@ -108,9 +219,33 @@ class CbrApplication : public Application
     /// Create and send packet by scheduling next TX event.
     void SendPacket();
 
+    /**
+     * \param size the size of the payload in bytes.
+     * \return a new packet, or a copy of #m_packetTemplate if enabled, which
+     *         is rebuilt whenever the size changes.
+     */
+    Ptr<Packet> CreatePayload(uint32_t size);
+
     /// schedule next packet sending
     void ScheduleNextTx();
 
+    /**
+     * \return true if the packet rate follows a rate envelope or on/off
+     *         periods.
+     */
+    bool HasRateProfile() const;
+
+    /// Start evaluating the rate profile from the current time.
+    void ResetSchedule();
+
+    /// Append the next `ScheduleChunkSize` transmission times to #m_schedule.
+    void ComputeScheduleChunk();
+
+    /**
+     * \return the time of the next transmission according to the rate profile.
+     */
+    Time ComputeNextTxTime();
+
     /**
      * Callback method to handle connection succeeded events
      *
@@ -124,6 +259,9 @@ class CbrApplication : public Application
      * \param socket Pointer to socket.
      */
     void ConnectionFailed(Ptr<Socket> socket);
+
+    /// Instrumentation counters (if enabled).
+    TRAFFIC_COUNTERS_DECLARE(m_counters)
 };
 
 } // namespace ns3
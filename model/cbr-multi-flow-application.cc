@@ -0,0 +1,397 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "cbr-multi-flow-application.h"
+
+#include "traffic-time-tag.h"
+
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/pointer.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/socket-factory.h>
+#include <ns3/socket.h>
+#include <ns3/string.h>
+#include <ns3/trace-source-accessor.h>
+#include <ns3/udp-socket-factory.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("CbrMultiFlowApplication");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CbrMultiFlowApplication);
+
+TypeId
+CbrMultiFlowApplication::GetTypeId(void)
+{
+    static TypeId tid =
+        TypeId("ns3::CbrMultiFlowApplication")
+            .SetParent<Application>()
+            .AddConstructor<CbrMultiFlowApplication>()
+            .AddAttribute("PacketSize",
+                          "The size of constant packets sent by every flow.",
+                          UintegerValue(512),
+                          MakeUintegerAccessor(&CbrMultiFlowApplication::m_pktSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Interval",
+                          "Interval to send constant packets, used by the flows which are "
+                          "added without their own interval.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&CbrMultiFlowApplication::m_interval),
+                          MakeTimeChecker())
+            .AddAttribute("TickDuration",
+                          "Granularity of the timer wheel. Transmission times are rounded to "
+                          "the nearest tick.",
+                          TimeValue(MilliSeconds(1)),
+                          MakeTimeAccessor(&CbrMultiFlowApplication::m_tickDuration),
+                          MakeTimeChecker())
+            .AddAttribute("WheelSize",
+                          "Number of slots in the timer wheel.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&CbrMultiFlowApplication::m_wheelSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("StartOffset",
+                          "A random variable in seconds, drawn once per flow to shift the "
+                          "first transmission of the flow.",
+                          StringValue("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
+                          MakePointerAccessor(&CbrMultiFlowApplication::m_startOffset),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use. Must be connectionless.",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&CbrMultiFlowApplication::m_tid),
+                          MakeTypeIdChecker())
+            .AddAttribute("EnableStatisticsTags",
+                          "If true, some tags will be added to each transmitted packet to assist "
+                          "with statistics computation",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CbrMultiFlowApplication::m_isStatisticsTagsEnabled),
+                          MakeBooleanChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&CbrMultiFlowApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+CbrMultiFlowApplication::CbrMultiFlowApplication()
+    : m_socket(nullptr),
+      m_numOfScheduledFlows(0),
+      m_currentTick(0),
+      m_nextTick(0),
+      m_isRunning(false),
+      m_pktSize(0),
+      m_wheelSize(1),
+      m_isStatisticsTagsEnabled(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CbrMultiFlowApplication::~CbrMultiFlowApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+CbrMultiFlowApplication::AddFlow(const Address& remote)
+{
+    return AddFlow(remote, m_interval);
+}
+
+uint32_t
+CbrMultiFlowApplication::AddFlow(const Address& remote, Time interval)
+{
+    NS_LOG_FUNCTION(this << remote << interval.GetSeconds());
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "Interval must be greater than zero");
+
+    Flow_t flow;
+    flow.remote = remote;
+    flow.interval = interval;
+    flow.intervalTicks = 0; // computed when the flow starts
+    flow.dueTick = 0;
+    flow.txBytes = 0;
+    m_flows.push_back(flow);
+
+    const uint32_t flowIndex = m_flows.size() - 1;
+    if (m_isRunning)
+    {
+        StartFlow(flowIndex);
+        ScheduleNextTick();
+    }
+
+    return flowIndex;
+}
+
+uint32_t
+CbrMultiFlowApplication::GetNumOfFlows() const
+{
+    return m_flows.size();
+}
+
+const Address&
+CbrMultiFlowApplication::GetRemote(uint32_t flowIndex) const
+{
+    NS_ASSERT_MSG(flowIndex < m_flows.size(), "Invalid flow index " << flowIndex);
+    return m_flows[flowIndex].remote;
+}
+
+uint64_t
+CbrMultiFlowApplication::GetSent(uint32_t flowIndex) const
+{
+    NS_ASSERT_MSG(flowIndex < m_flows.size(), "Invalid flow index " << flowIndex);
+    return m_flows[flowIndex].txBytes;
+}
+
+uint64_t
+CbrMultiFlowApplication::GetSent() const
+{
+    uint64_t total = 0;
+    for (std::vector<Flow_t>::const_iterator it = m_flows.begin(); it != m_flows.end(); ++it)
+    {
+        total += it->txBytes;
+    }
+    return total;
+}
+
+Ptr<Socket>
+CbrMultiFlowApplication::GetSocket() const
+{
+    return m_socket;
+}
+
+int64_t
+CbrMultiFlowApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_startOffset->SetStream(stream);
+    return 1;
+}
+
+void
+CbrMultiFlowApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_socket = nullptr;
+    m_wheel.clear();
+    // chain up
+    Application::DoDispose();
+}
+
+void
+CbrMultiFlowApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_tickDuration.IsStrictlyPositive(),
+                        "Tick duration must be greater than zero");
+
+    if (m_socket == nullptr)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        NS_ABORT_MSG_IF(m_socket->GetSocketType() == Socket::NS3_SOCK_STREAM,
+                        "CbrMultiFlowApplication supports only connectionless protocols");
+        m_socket->Bind();
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+
+    m_wheel.assign(m_wheelSize, std::vector<uint32_t>());
+    m_numOfScheduledFlows = 0;
+    m_wheelStartTime = Simulator::Now();
+    m_currentTick = 0;
+    m_nextTick = 0;
+    m_isRunning = true;
+
+    for (uint32_t i = 0; i < m_flows.size(); i++)
+    {
+        StartFlow(i);
+    }
+
+    NS_LOG_INFO(this << " started " << m_flows.size() << " flows");
+    ScheduleNextTick();
+}
+
+void
+CbrMultiFlowApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_isRunning = false;
+    Simulator::Cancel(m_tickEvent);
+    m_wheel.clear();
+    m_numOfScheduledFlows = 0;
+
+    if (m_socket != nullptr)
+    {
+        m_socket->Close();
+    }
+    else
+    {
+        NS_LOG_WARN("CbrMultiFlowApplication found null socket to close in StopApplication");
+    }
+}
+
+void
+CbrMultiFlowApplication::StartFlow(uint32_t flowIndex)
+{
+    NS_ASSERT(flowIndex < m_flows.size());
+    Flow_t& flow = m_flows[flowIndex];
+
+    const double offset = m_startOffset->GetValue();
+    NS_ABORT_MSG_IF(offset < 0.0, "Negative start offset " << offset);
+    flow.intervalTicks = std::max<uint64_t>(ToTicks(flow.interval), 1);
+    flow.dueTick = GetNowTick() + flow.intervalTicks + ToTicks(Seconds(offset));
+    NS_LOG_LOGIC(this << " flow " << flowIndex << " is first due at tick " << flow.dueTick);
+
+    InsertIntoWheel(flowIndex);
+}
+
+void
+CbrMultiFlowApplication::InsertIntoWheel(uint32_t flowIndex)
+{
+    m_wheel[m_flows[flowIndex].dueTick % m_wheelSize].push_back(flowIndex);
+    m_numOfScheduledFlows++;
+}
+
+uint64_t
+CbrMultiFlowApplication::ToTicks(Time time) const
+{
+    const int64_t tick = m_tickDuration.GetTimeStep();
+    return (time.GetTimeStep() + tick / 2) / tick;
+}
+
+uint64_t
+CbrMultiFlowApplication::GetNowTick() const
+{
+    const int64_t tick = m_tickDuration.GetTimeStep();
+    return ((Simulator::Now() - m_wheelStartTime).GetTimeStep() + tick - 1) / tick;
+}
+
+void
+CbrMultiFlowApplication::Tick()
+{
+    NS_LOG_FUNCTION(this << m_nextTick);
+    NS_ASSERT(m_isRunning);
+    m_currentTick = m_nextTick;
+
+    /*
+     * Take the whole slot aside, because sending a packet may invoke trace
+     * sinks which add new flows into the wheel.
+     */
+    std::vector<uint32_t>& slot = m_wheel[m_currentTick % m_wheelSize];
+    NS_ASSERT(m_dueFlows.empty());
+    m_dueFlows.swap(slot);
+    m_numOfScheduledFlows -= m_dueFlows.size();
+
+    for (std::vector<uint32_t>::const_iterator it = m_dueFlows.begin(); it != m_dueFlows.end();
+         ++it)
+    {
+        const uint32_t flowIndex = *it;
+        if (m_flows[flowIndex].dueTick == m_currentTick)
+        {
+            SendPacket(flowIndex);
+
+            if (!m_isRunning)
+            {
+                // a trace sink has stopped the application
+                m_dueFlows.clear();
+                return;
+            }
+
+            m_flows[flowIndex].dueTick += m_flows[flowIndex].intervalTicks;
+        }
+        else
+        {
+            // due in one of the next rounds of the wheel
+            NS_ASSERT(m_flows[flowIndex].dueTick > m_currentTick);
+        }
+
+        InsertIntoWheel(flowIndex);
+    }
+
+    m_dueFlows.clear();
+    ScheduleNextTick();
+
+} // end of `void Tick ()`
+
+void
+CbrMultiFlowApplication::ScheduleNextTick()
+{
+    Simulator::Cancel(m_tickEvent);
+
+    if (m_numOfScheduledFlows == 0)
+    {
+        NS_LOG_INFO(this << " no flow to schedule");
+        return;
+    }
+
+    /*
+     * Skip the empty slots. A non-empty slot may hold only flows due in the
+     * next rounds of the wheel, but it is never later than the earliest due
+     * flow, so no transmission is missed.
+     */
+    uint64_t nextTick = std::max(GetNowTick(), m_currentTick + 1);
+    while (m_wheel[nextTick % m_wheelSize].empty())
+    {
+        nextTick++;
+    }
+
+    const int64_t tick = m_tickDuration.GetTimeStep();
+    const Time delay = m_wheelStartTime + TimeStep(tick * nextTick) - Simulator::Now();
+    NS_LOG_LOGIC(this << " next tick is " << nextTick << " in " << delay.GetSeconds()
+                      << " seconds");
+    m_nextTick = nextTick;
+    m_tickEvent = Simulator::Schedule(delay, &CbrMultiFlowApplication::Tick, this);
+
+} // end of `void ScheduleNextTick ()`
+
+void
+CbrMultiFlowApplication::SendPacket(uint32_t flowIndex)
+{
+    NS_LOG_FUNCTION(this << flowIndex);
+
+    Ptr<Packet> packet = Create<Packet>(m_pktSize);
+
+    if (m_isStatisticsTagsEnabled)
+    {
+        packet->AddPacketTag(TrafficTimeTag(Simulator::Now()));
+    }
+
+    m_txTrace(packet);
+
+    if (!m_isRunning)
+    {
+        return;
+    }
+
+    // the trace sinks may have added flows, so look up the flow only now
+    Flow_t& flow = m_flows[flowIndex];
+    m_socket->SendTo(packet, 0, flow.remote);
+    flow.txBytes += m_pktSize;
+}
+
+} // namespace ns3
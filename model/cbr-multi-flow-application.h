@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef CBR_MULTI_FLOW_APPLICATION_H
+#define CBR_MULTI_FLOW_APPLICATION_H
+
+#include <ns3/address.h>
+#include <ns3/application.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/traced-callback.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+class Socket;
+class RandomVariableStream;
+
+/**
+ * \ingroup traffic
+ *
+ * \brief Generate CBR traffic to many destinations from a single application.
+ *
+ * A lightweight replacement of installing one CbrApplication per flow, meant
+ * for background load consisting of thousands of flows. Each flow, added by
+ * AddFlow(), sends a packet of `PacketSize` bytes to its destination every
+ * interval. All flows share a single unconnected socket, and are scheduled
+ * through a hashed timer wheel which fires at most one simulator event per
+ * tick of `TickDuration`, regardless of the number of flows. Ticks without
+ * any flow due are skipped.
+ *
+ * Consequently, the transmission times are rounded to the nearest tick, and
+ * the interval of each flow is rounded to a whole number of ticks (at least
+ * one). The tick should therefore be a divisor of the intervals in use.
+ *
+ * As in CbrApplication, the first packet of a flow is sent one interval after
+ * the flow starts, i.e., after the application starts or after the flow is
+ * added, whichever is later. In addition, each flow is shifted by a start
+ * offset drawn from the `StartOffset` random variable, so that the flows do
+ * not send their packets in synchronized bursts.
+ *
+ * Because the flows share one socket, they share the same source address and
+ * port. Only connectionless protocols (e.g., UDP) are supported; for TCP
+ * traffic, use CbrApplication instead.
+ */
+class CbrMultiFlowApplication : public Application
+{
+  public:
+    static TypeId GetTypeId(void);
+
+    /// Constructor for multi-flow CBR application.
+    CbrMultiFlowApplication();
+
+    /// Destructor for multi-flow CBR application.
+    virtual ~CbrMultiFlowApplication();
+
+    /**
+     * \brief Add a new flow using the interval given by the `Interval`
+     *        attribute.
+     * \param remote the destination address of the flow.
+     * \return the index of the new flow, starting from 0.
+     */
+    uint32_t AddFlow(const Address& remote);
+
+    /**
+     * \brief Add a new flow with its own interval.
+     * \param remote the destination address of the flow.
+     * \param interval the interval between packets of the flow, which must be
+     *                 greater than zero.
+     * \return the index of the new flow, starting from 0.
+     */
+    uint32_t AddFlow(const Address& remote, Time interval);
+
+    /**
+     * \return the number of flows added to the application.
+     */
+    uint32_t GetNumOfFlows() const;
+
+    /**
+     * \param flowIndex the index of a flow, as returned by AddFlow().
+     * \return the destination address of the flow.
+     */
+    const Address& GetRemote(uint32_t flowIndex) const;
+
+    /**
+     * \param flowIndex the index of a flow, as returned by AddFlow().
+     * \return the number of bytes sent by the flow.
+     */
+    uint64_t GetSent(uint32_t flowIndex) const;
+
+    /**
+     * \return the number of bytes sent by all flows.
+     */
+    uint64_t GetSent() const;
+
+    /// Get the pointer to the socket shared by the flows.
+    Ptr<Socket> GetSocket() const;
+
+    /**
+     * \brief Assign a fixed random variable stream number to the random
+     *        variables used by this application.
+     * \param stream first stream index to use.
+     * \return the number of stream indices assigned.
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    // Inherited from Object base class.
+    virtual void DoDispose();
+
+  private:
+    /// State of a single flow.
+    struct Flow_t
+    {
+        Address remote;         ///< Destination address.
+        Time interval;          ///< Interval between packets.
+        uint64_t intervalTicks; ///< Interval between packets in ticks.
+        uint64_t dueTick;       ///< Tick of the next transmission.
+        uint64_t txBytes;       ///< Number of bytes sent so far.
+    };
+
+    // inherited from Application base class.
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+    /**
+     * \brief Draw the start offset of a flow and put the flow into the wheel.
+     * \param flowIndex the index of the flow.
+     */
+    void StartFlow(uint32_t flowIndex);
+
+    /**
+     * \brief Put a flow into the wheel slot of its due tick.
+     * \param flowIndex the index of the flow.
+     */
+    void InsertIntoWheel(uint32_t flowIndex);
+
+    /**
+     * \param time a duration.
+     * \return the duration in whole ticks, rounded to the nearest tick.
+     */
+    uint64_t ToTicks(Time time) const;
+
+    /**
+     * \return the earliest tick which is not earlier than the current time.
+     */
+    uint64_t GetNowTick() const;
+
+    /// Send a packet of every flow due at the current tick.
+    void Tick();
+
+    /// Schedule Tick() at the earliest tick which has flows in its slot.
+    void ScheduleNextTick();
+
+    /**
+     * \brief Create and send a packet of a flow.
+     * \param flowIndex the index of the flow.
+     */
+    void SendPacket(uint32_t flowIndex);
+
+    Ptr<Socket> m_socket;                       ///< Socket shared by all flows.
+    std::vector<Flow_t> m_flows;                ///< All the flows.
+    std::vector<std::vector<uint32_t>> m_wheel; ///< Flow indices, per slot.
+    std::vector<uint32_t> m_dueFlows;           ///< Scratch space used by Tick().
+    uint32_t m_numOfScheduledFlows;             ///< Number of flows in the wheel.
+    Time m_wheelStartTime;                      ///< Time of tick 0.
+    uint64_t m_currentTick;                     ///< Tick processed by the last Tick().
+    uint64_t m_nextTick;                        ///< Tick of the pending Tick() event.
+    bool m_isRunning;                           ///< True between start and stop.
+    EventId m_tickEvent;                        ///< Event of the next Tick().
+
+    uint32_t m_pktSize;                          ///< `PacketSize` attribute.
+    Time m_interval;                             ///< `Interval` attribute.
+    Time m_tickDuration;                         ///< `TickDuration` attribute.
+    uint32_t m_wheelSize;                        ///< `WheelSize` attribute.
+    Ptr<RandomVariableStream> m_startOffset;     ///< `StartOffset` attribute.
+    TypeId m_tid;                                ///< `Protocol` attribute.
+    bool m_isStatisticsTagsEnabled;              ///< `EnableStatisticsTags` attribute.
+    TracedCallback<Ptr<const Packet>> m_txTrace; ///< `Tx` trace source.
+
+}; // end of `class CbrMultiFlowApplication`
+
+} // namespace ns3
+
+#endif /* CBR_MULTI_FLOW_APPLICATION_H */
@@ -0,0 +1,114 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "jitter-estimator.h"
+
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/traffic-time-tag.h>
+#include <ns3/traffic-timestamp-header.h>
+
+#include <cmath>
+
+namespace ns3
+{
+
+JitterEstimator::JitterEstimator()
+    : m_numOfSamples(0),
+      m_jitter(0.0)
+{
+}
+
+void
+JitterEstimator::AddDelay(Time delay)
+{
+    if (m_numOfSamples == 0)
+    {
+        m_minDelay = delay;
+    }
+    else
+    {
+        // RFC 3550 section 6.4.1, with D computed from the one-way delays.
+        const double d = std::fabs(static_cast<double>((delay - m_lastDelay).GetTimeStep()));
+        m_jitter += (d - m_jitter) / 16.0;
+        m_minDelay = Min(m_minDelay, delay);
+    }
+
+    m_lastDelay = delay;
+    m_numOfSamples++;
+}
+
+bool
+JitterEstimator::AddPacket(Ptr<const Packet> packet)
+{
+    Time senderTimestamp;
+    TrafficTimeTag timeTag;
+    if (packet->PeekPacketTag(timeTag))
+    {
+        senderTimestamp = timeTag.GetSenderTimestamp();
+    }
+    else if (!TrafficTimestampHeader::PeekSenderTimestamp(packet, senderTimestamp))
+    {
+        return false;
+    }
+
+    AddDelay(Simulator::Now() - senderTimestamp);
+    return true;
+}
+
+uint32_t
+JitterEstimator::GetNumOfSamples() const
+{
+    return m_numOfSamples;
+}
+
+bool
+JitterEstimator::HasJitter() const
+{
+    return m_numOfSamples >= 2;
+}
+
+Time
+JitterEstimator::GetJitter() const
+{
+    return TimeStep(static_cast<uint64_t>(std::llround(m_jitter)));
+}
+
+Time
+JitterEstimator::GetDelayVariation() const
+{
+    return m_lastDelay - m_minDelay;
+}
+
+Time
+JitterEstimator::GetMinDelay() const
+{
+    return m_minDelay;
+}
+
+void
+JitterEstimator::Reset()
+{
+    m_numOfSamples = 0;
+    m_lastDelay = Time();
+    m_minDelay = Time();
+    m_jitter = 0.0;
+}
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef JITTER_ESTIMATOR_H
+#define JITTER_ESTIMATOR_H
+
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \ingroup traffic
+ * \brief Estimator of the interarrival jitter and the packet delay variation
+ *        of a single flow.
+ *
+ * The jitter is the smoothed mean deviation of the one-way delay as defined
+ * by RFC 3550, i.e., J = J + (|D| - J) / 16, where D is the difference between
+ * the delays of two consecutive packets. The packet delay variation is the
+ * delay of the last packet relative to the smallest delay seen so far.
+ *
+ * The estimator keeps only a handful of scalars, so it can be embedded by
+ * value in applications and trace sinks without any allocation per sample.
+ * Delays can be given directly (AddDelay()), or read from the TrafficTimeTag
+ * or the TrafficTimestampHeader of a received packet (AddPacket()), e.g., at a
+ * PacketSink receiving traffic of CbrApplication.
+ */
+class JitterEstimator
+{
+  public:
+    /// Create an estimator without any sample.
+    JitterEstimator();
+
+    /**
+     * \brief Update the estimates with the delay of a newly received packet.
+     * \param delay the one-way delay of the packet, which may also be zero.
+     */
+    void AddDelay(Time delay);
+
+    /**
+     * \brief Update the estimates with the delay of a packet carrying a
+     *        TrafficTimeTag or beginning with a TrafficTimestampHeader,
+     *        computed against the current simulation time.
+     * \param packet the received packet.
+     * \return false if the packet carries neither of them, in which case the
+     *         estimates are not updated.
+     */
+    bool AddPacket(Ptr<const Packet> packet);
+
+    /**
+     * \return the number of delay samples added since the last Reset().
+     */
+    uint32_t GetNumOfSamples() const;
+
+    /**
+     * \return true if at least two delay samples have been added, i.e., the
+     *         jitter is defined.
+     */
+    bool HasJitter() const;
+
+    /**
+     * \return the RFC 3550 interarrival jitter, or zero if HasJitter() is false.
+     */
+    Time GetJitter() const;
+
+    /**
+     * \return the delay of the last packet minus the smallest delay so far.
+     */
+    Time GetDelayVariation() const;
+
+    /**
+     * \return the smallest delay so far.
+     */
+    Time GetMinDelay() const;
+
+    /// Forget all samples, e.g., at the beginning of a new flow.
+    void Reset();
+
+  private:
+    uint32_t m_numOfSamples; ///< Number of delay samples.
+    Time m_lastDelay;        ///< Delay of the last packet.
+    Time m_minDelay;         ///< Smallest delay so far.
+    double m_jitter;         ///< Smoothed jitter, in time steps.
+
+}; // end of `class JitterEstimator`
+
+} // namespace ns3
+
+#endif /* JITTER_ESTIMATOR_H */
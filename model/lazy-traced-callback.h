@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LAZY_TRACED_CALLBACK_H
+#define LAZY_TRACED_CALLBACK_H
+
+#include <ns3/callback.h>
+#include <ns3/traced-callback.h>
+
+#include <memory>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief A drop-in replacement of TracedCallback which costs a single pointer
+ *        until something is connected to it.
+ *
+ * TracedCallback keeps its sinks in a list which is part of the object, so an
+ * application with many trace sources carries the empty lists even when none
+ * of them is ever connected, which adds up with a large number of
+ * applications. This class allocates the underlying TracedCallback only upon
+ * the first connection, and firing an unconnected trace source is a single
+ * pointer comparison.
+ *
+ * The class provides the same connection methods as TracedCallback, so it can
+ * be registered with MakeTraceSourceAccessor() like any other trace source:
+ *
+ *     ns3::LazyTracedCallback<Ptr<const Packet>> m_txTrace;
+ *     ...
+ *     .AddTraceSource("Tx",
+ *                     "A packet has been sent.",
+ *                     MakeTraceSourceAccessor(&MyApplication::m_txTrace),
+ *                     "ns3::Packet::TracedCallback")
+ *
+ * Once allocated, the underlying TracedCallback is kept until the owner is
+ * destroyed, even if all sinks are disconnected.
+ */
+template <typename... Ts>
+class LazyTracedCallback
+{
+  public:
+    /**
+     * \brief Append a callback to the chain, without a context.
+     * \param callback the callback to add.
+     */
+    void ConnectWithoutContext(const CallbackBase& callback)
+    {
+        Allocate();
+        m_impl->ConnectWithoutContext(callback);
+    }
+
+    /**
+     * \brief Append a callback to the chain, with a context.
+     * \param callback the callback to add.
+     * \param path the context, which is bound as the first argument.
+     */
+    void Connect(const CallbackBase& callback, std::string path)
+    {
+        Allocate();
+        m_impl->Connect(callback, path);
+    }
+
+    /**
+     * \brief Remove a callback which was connected without a context.
+     * \param callback the callback to remove.
+     */
+    void DisconnectWithoutContext(const CallbackBase& callback)
+    {
+        if (m_impl != nullptr)
+        {
+            m_impl->DisconnectWithoutContext(callback);
+        }
+    }
+
+    /**
+     * \brief Remove a callback which was connected with a context.
+     * \param callback the callback to remove.
+     * \param path the context which was given to Connect().
+     */
+    void Disconnect(const CallbackBase& callback, std::string path)
+    {
+        if (m_impl != nullptr)
+        {
+            m_impl->Disconnect(callback, path);
+        }
+    }
+
+    /**
+     * \brief Invoke all connected callbacks, if any.
+     * \param args the arguments given to the callbacks.
+     */
+    void operator()(Ts... args) const
+    {
+        if (m_impl != nullptr)
+        {
+            (*m_impl)(args...);
+        }
+    }
+
+    /**
+     * \return true if no callback is connected, e.g., to skip the preparation
+     *         of expensive arguments.
+     */
+    bool IsEmpty() const
+    {
+        return (m_impl == nullptr) || m_impl->IsEmpty();
+    }
+
+  private:
+    /// Create #m_impl, if it does not exist yet.
+    void Allocate()
+    {
+        if (m_impl == nullptr)
+        {
+            m_impl = std::make_unique<TracedCallback<Ts...>>();
+        }
+    }
+
+    /// The actual trace source, or null until the first connection.
+    std::unique_ptr<TracedCallback<Ts...>> m_impl;
+
+}; // end of `class LazyTracedCallback`
+
+} // namespace ns3
+
+#endif /* LAZY_TRACED_CALLBACK_H */
@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nrtv-feedback-header.h"
+
+#include <ns3/log.h>
+
+NS_LOG_COMPONENT_DEFINE("NrtvFeedbackHeader");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrtvFeedbackHeader);
+
+NrtvFeedbackHeader::NrtvFeedbackHeader()
+    : m_throughput(0),
+      m_bufferLevelMs(0),
+      m_stallCount(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+NrtvFeedbackHeader::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::NrtvFeedbackHeader")
+                            .SetParent<Header>()
+                            .AddConstructor<NrtvFeedbackHeader>();
+    return tid;
+}
+
+uint32_t
+NrtvFeedbackHeader::GetStaticSerializedSize()
+{
+    return SERIALIZED_SIZE;
+}
+
+void
+NrtvFeedbackHeader::SetThroughput(uint64_t throughput)
+{
+    NS_LOG_FUNCTION(this << throughput);
+    m_throughput = throughput;
+}
+
+uint64_t
+NrtvFeedbackHeader::GetThroughput() const
+{
+    return m_throughput;
+}
+
+void
+NrtvFeedbackHeader::SetBufferLevel(Time bufferLevel)
+{
+    NS_LOG_FUNCTION(this << bufferLevel.GetSeconds());
+    NS_ASSERT_MSG(!bufferLevel.IsStrictlyNegative(), "Negative buffer level " << bufferLevel);
+    m_bufferLevelMs = static_cast<uint32_t>(bufferLevel.GetMilliSeconds());
+}
+
+Time
+NrtvFeedbackHeader::GetBufferLevel() const
+{
+    return MilliSeconds(m_bufferLevelMs);
+}
+
+void
+NrtvFeedbackHeader::SetStallCount(uint32_t stallCount)
+{
+    NS_LOG_FUNCTION(this << stallCount);
+    m_stallCount = stallCount;
+}
+
+uint32_t
+NrtvFeedbackHeader::GetStallCount() const
+{
+    return m_stallCount;
+}
+
+uint32_t
+NrtvFeedbackHeader::GetSerializedSize() const
+{
+    return SERIALIZED_SIZE;
+}
+
+void
+NrtvFeedbackHeader::Print(std::ostream& os) const
+{
+    os << "(throughput: " << m_throughput << " bufferLevelMs: " << m_bufferLevelMs
+       << " stallCount: " << m_stallCount << ")";
+}
+
+void
+NrtvFeedbackHeader::Serialize(Buffer::Iterator start) const
+{
+    NS_LOG_FUNCTION(this << &start);
+    Buffer::Iterator i = start;
+    i.WriteHtonU64(m_throughput);
+    i.WriteHtonU32(m_bufferLevelMs);
+    i.WriteHtonU32(m_stallCount);
+}
+
+uint32_t
+NrtvFeedbackHeader::Deserialize(Buffer::Iterator start)
+{
+    NS_LOG_FUNCTION(this << &start);
+    Buffer::Iterator i = start;
+    m_throughput = i.ReadNtohU64();
+    m_bufferLevelMs = i.ReadNtohU32();
+    m_stallCount = i.ReadNtohU32();
+    return GetSerializedSize();
+}
+
+TypeId
+NrtvFeedbackHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+} // namespace ns3
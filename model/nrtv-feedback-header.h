@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NRTV_FEEDBACK_HEADER_H
+#define NRTV_FEEDBACK_HEADER_H
+
+#include <ns3/header.h>
+#include <ns3/nstime.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup nrtv
+ * \brief Packet header of the feedback sent by NrtvTcpClient to NrtvTcpServer
+ *        in the adaptive bitrate mode.
+ *
+ * The header is 16 bytes in length and makes up the whole feedback packet.
+ * There are 3 fields in the header:
+ * - throughput measured by the client since its previous feedback (8 bytes)
+ *   in bits per second;
+ * - playout buffer level (4 bytes) in milliseconds, i.e., the length of the
+ *   frames received but not played yet; and
+ * - number of stalls (4 bytes) in the current video so far.
+ *
+ * The header has a fixed size, so the server finds the feedback boundaries in
+ * the TCP byte stream by reading GetStaticSerializedSize() bytes at a time.
+ */
+class NrtvFeedbackHeader : public Header
+{
+  public:
+    /// Create a plain new instance of NRTV feedback header.
+    NrtvFeedbackHeader();
+
+    // Inherited from ObjectBase base class
+    static TypeId GetTypeId(void);
+
+    /// Size of the header in bytes.
+    static constexpr uint32_t SERIALIZED_SIZE = 16;
+
+    /**
+     * \return the size of the header in bytes, i.e., the same value as
+     *         GetSerializedSize()
+     */
+    static uint32_t GetStaticSerializedSize();
+
+    /**
+     * \param throughput the value for the "throughput" field in bits per second
+     */
+    void SetThroughput(uint64_t throughput);
+
+    /**
+     * \return the current value of the "throughput" field in bits per second
+     */
+    uint64_t GetThroughput() const;
+
+    /**
+     * \param bufferLevel the value for the "buffer level" field, truncated to
+     *                    milliseconds
+     */
+    void SetBufferLevel(Time bufferLevel);
+
+    /**
+     * \return the current value of the "buffer level" field
+     */
+    Time GetBufferLevel() const;
+
+    /**
+     * \param stallCount the value for the "number of stalls" field
+     */
+    void SetStallCount(uint32_t stallCount);
+
+    /**
+     * \return the current value of the "number of stalls" field
+     */
+    uint32_t GetStallCount() const;
+
+    // Inherited from Header base class
+    virtual uint32_t GetSerializedSize() const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    // Inherited from ObjectBase base class
+    virtual TypeId GetInstanceTypeId() const;
+
+  private:
+    uint64_t m_throughput;    ///< Throughput field in bits per second.
+    uint32_t m_bufferLevelMs; ///< Buffer level field in milliseconds.
+    uint32_t m_stallCount;    ///< Number of stalls field.
+
+}; // end of `class NrtvFeedbackHeader`
+
+} // namespace ns3
+
+#endif /* NRTV_FEEDBACK_HEADER_H */
@@ -22,7 +22,9 @@
 #include "nrtv-header.h"
 
 #include <ns3/log.h>
+#include <ns3/packet.h>
 #include <ns3/simulator.h>
+#include <ns3/traffic-timestamp.h>
 
 NS_LOG_COMPONENT_DEFINE("NrtvHeader");
 
@@ -49,6 +51,26 @@ NrtvHeader::GetTypeId(void)
     return tid;
 }
 
+uint32_t
+NrtvHeader::GetStaticSerializedSize()
+{
+    return (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL) ? FULL_SERIALIZED_SIZE
+                                                                        : COMPACT_SERIALIZED_SIZE;
+}
+
+uint32_t
+NrtvHeader::PeekSliceSize(Ptr<const Packet> packet)
+{
+    uint8_t buffer[SLICE_SIZE_OFFSET + 4];
+    NS_ASSERT_MSG(packet->GetSize() >= sizeof(buffer), "The packet contains no NRTV header");
+    packet->CopyData(buffer, sizeof(buffer));
+
+    // The field is in network byte order, see Serialize().
+    const uint8_t* field = buffer + SLICE_SIZE_OFFSET;
+    return (static_cast<uint32_t>(field[0]) << 24) | (static_cast<uint32_t>(field[1]) << 16) |
+           (static_cast<uint32_t>(field[2]) << 8) | static_cast<uint32_t>(field[3]);
+}
+
 void
 NrtvHeader::SetFrameNumber(uint32_t frameNumber)
 {
@@ -123,7 +145,7 @@ NrtvHeader::GetArrivalTime() const
 uint32_t
 NrtvHeader::GetSerializedSize() const
 {
-    return 24;
+    return GetStaticSerializedSize();
 }
 
 void
@@ -144,7 +166,15 @@ NrtvHeader::Serialize(Buffer::Iterator start) const
     i.WriteHtonU16(m_sliceNumber);
     i.WriteHtonU16(m_numOfSlices);
     i.WriteHtonU32(m_sliceSize);
-    i.WriteHtonU64(m_arrivalTime.GetNanoSeconds());
+
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        i.WriteHtonU64(m_arrivalTime.GetNanoSeconds());
+    }
+    else
+    {
+        i.WriteHtonU32(TrafficTimestamp::EncodeCompact(m_arrivalTime));
+    }
 }
 
 uint32_t
@@ -157,7 +187,15 @@ NrtvHeader::Deserialize(Buffer::Iterator start)
     m_sliceNumber = i.ReadNtohU16();
     m_numOfSlices = i.ReadNtohU16();
     m_sliceSize = i.ReadNtohU32();
-    m_arrivalTime = NanoSeconds(i.ReadNtohU64());
+
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        m_arrivalTime = NanoSeconds(i.ReadNtohU64());
+    }
+    else
+    {
+        m_arrivalTime = TrafficTimestamp::DecodeCompact(i.ReadNtohU32(), Simulator::Now());
+    }
     return GetSerializedSize();
 }
 
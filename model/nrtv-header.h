@@ -24,10 +24,13 @@
 
 #include <ns3/header.h>
 #include <ns3/nstime.h>
+#include <ns3/ptr.h>
 
 namespace ns3
 {
 
+class Packet;
+
 /**
  * \ingroup nrtv
  * \brief Simple packet header for use in NRTV traffic models.
@@ -40,6 +43,13 @@ namespace ns3
  * - slice size in bytes, not including the header (4 bytes); and
  * - arrival time (8 bytes) in nanoseconds.
  *
+ * If a compact timestamp encoding is selected through
+ * TrafficTimestamp::SetEncoding(), the arrival time field is only 4 bytes
+ * long, making the header 20 bytes in length. The receiver restores the full
+ * arrival time when deserializing the header, so GetArrivalTime() and the
+ * packet delay computed from it are not affected, as long as the delay is
+ * shorter than the wrap-around period of the encoding.
+ *
  * The following is the usage example in the case of sending a packet. First,
  * create a plain header:
  *
@@ -84,7 +94,10 @@ namespace ns3
  *       }
  *
  * Instead of Packet::RemoveHeader(), we may use Packet::PeekHeader() if we
- * want to keep the header in the packet.
+ * want to keep the header in the packet. If only the slice size is needed,
+ * e.g., to find the slice boundaries in a TCP byte stream, PeekSliceSize()
+ * reads the field directly from the first bytes of the packet, without
+ * deserializing the whole header.
  *
  * \warning You will get an error if you invoke Packet::RemoveHeader() or
  *          Packet::PeekHeader() on a packet smaller than 24 bytes,
@@ -99,6 +112,31 @@ class NrtvHeader : public Header
     // Inherited from ObjectBase base class
     static TypeId GetTypeId(void);
 
+    /// Size of the header in bytes when the full timestamp encoding is used.
+    static constexpr uint32_t FULL_SERIALIZED_SIZE = 24;
+
+    /// Size of the header in bytes when a compact timestamp encoding is used.
+    static constexpr uint32_t COMPACT_SERIALIZED_SIZE = 20;
+
+    /// Offset of the "slice size" field from the beginning of the header.
+    static constexpr uint32_t SLICE_SIZE_OFFSET = 12;
+
+    /**
+     * \return the size of the header in bytes with the timestamp encoding
+     *         currently in use, i.e., the same value as GetSerializedSize(),
+     *         but without the need of creating a header instance
+     */
+    static uint32_t GetStaticSerializedSize();
+
+    /**
+     * \brief Read the "slice size" field of the header at the beginning of a
+     *        packet, without deserializing the rest of the header.
+     * \param packet a packet which begins with an NRTV header, or at least
+     *               with its first 16 bytes
+     * \return the value of the "slice size" field
+     */
+    static uint32_t PeekSliceSize(Ptr<const Packet> packet);
+
     /**
      * \param frameNumber the value for the "frame number" field of this header
      *                    instance
@@ -25,6 +25,7 @@
 #include <ns3/inet-socket-address.h>
 #include <ns3/inet6-socket-address.h>
 #include <ns3/log.h>
+#include <ns3/nrtv-feedback-header.h>
 #include <ns3/nrtv-header.h>
 #include <ns3/nrtv-variables.h>
 #include <ns3/pointer.h>
@@ -35,6 +36,9 @@
 #include <ns3/uinteger.h>
 #include <ns3/unused.h>
 
+#include <algorithm>
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE("NrtvTcpClient");
 
 namespace ns3
@@ -48,15 +52,22 @@ NrtvTcpClient::NrtvTcpClient()
     : m_state(NOT_STARTED),
       m_socket(0),
       m_rxBuffer(Create<NrtvTcpClientRxBuffer>()),
-      m_nrtvVariables(CreateObject<NrtvVariables>()),
-      m_lastDelay(0)
+      m_rxBufferCapacity(0),
+      m_recvBatchSize(0),
+      m_totalRx(0),
+      m_lastFeedbackRx(0),
+      m_rxBufferOccupancy(0),
+      m_numOfBufferedFrames(0),
+      m_numOfPlayedFrames(0),
+      m_numOfFramesInVideo(0),
+      m_stallCount(0),
+      m_isPlaying(false),
+      m_hasStartedPlayout(false),
+      m_frameStatsNumber(0),
+      m_frameStatsNumOfSlices(0),
+      m_frameStatsSize(0)
 {
     NS_LOG_FUNCTION(this);
-
-    m_dejitterBufferWindowSize = m_nrtvVariables->GetDejitterBufferWindowSize();
-    NS_LOG_INFO(this << " this client application uses"
-                     << " a de-jitter buffer window size of "
-                     << m_dejitterBufferWindowSize.GetSeconds() << " seconds");
 }
 
 TypeId
@@ -81,27 +92,86 @@ NrtvTcpClient::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvTcpClient::m_remoteServerPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("RxBufferCapacity",
+                          "Maximum number of bytes kept in the Rx buffer, or zero for an "
+                          "unbounded buffer. Received data is read from the socket at most "
+                          "this many bytes at a time, and the rest is left to the TCP flow "
+                          "control. Must not be less than the largest video slice including "
+                          "its NRTV header.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NrtvTcpClient::m_rxBufferCapacity),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("RecvBatchSize",
+                          "If not zero, received data is drained from the socket with reads "
+                          "of up to this many bytes, without logging each read, and the "
+                          "complete video slices are taken out of the Rx buffer in one pass "
+                          "afterwards. If zero, slices are taken out after every read.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NrtvTcpClient::m_recvBatchSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AbrFeedbackInterval",
+                          "Interval of the feedback on the throughput and the playout buffer "
+                          "sent to the server for the adaptive bitrate mode. Zero disables "
+                          "the feedback.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&NrtvTcpClient::m_abrFeedbackInterval),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource("Rx",
                             "One packet of has been received (not necessarily a "
                             "single video slice)",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_rxTrace),
                             "ns3::Packet::PacketAddressTracedCallback")
+            .AddTraceSource("RxBufferOccupancy",
+                            "Number of bytes in the Rx buffer, i.e., of the video slice "
+                            "which has not been completely received yet",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_rxBufferOccupancy),
+                            "ns3::TracedValueCallback::Uint32")
             .AddTraceSource("RxDelay",
                             "Received a whole slice with delay information",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_rxDelayTrace),
                             "ns3::ApplicationDelayProbe::PacketDelayAddressCallback")
             .AddTraceSource("RxJitter",
-                            "Received a packet with jitter information",
+                            "Received a whole slice, with the RFC 3550 interarrival jitter of "
+                            "the video so far",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_rxJitterTrace),
                             "ns3::ApplicationDelayProbe::PacketDelayAddressCallback")
+            .AddTraceSource("RxPdv",
+                            "Received a whole slice, with its delay relative to the smallest "
+                            "delay of the video so far",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_rxPdvTrace),
+                            "ns3::ApplicationDelayProbe::PacketDelayAddressCallback")
             .AddTraceSource("RxSlice",
-                            "Received a whole slice",
+                            "Received a whole slice. The slice is re-assembled into a "
+                            "packet only if this trace source is connected",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_rxSliceTrace),
                             "ns3::Packet::TracedCallback")
             .AddTraceSource("RxFrame",
                             "Received a whole frame",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_rxFrameTrace),
                             "ns3::NrtvTcpClient::RxFrameCallback")
+            .AddTraceSource("RxFrameStats",
+                            "Received a whole frame, with its size, the delay since the "
+                            "earliest timestamp of its slices, and the largest slice delay",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_rxFrameStatsTrace),
+                            "ns3::NrtvTcpClient::RxFrameStatsCallback")
+            .AddTraceSource("PlayoutFrame",
+                            "A frame has been played out from the de-jitter buffer",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_playoutFrameTrace),
+                            "ns3::NrtvTcpClient::RxFrameCallback")
+            .AddTraceSource("PlayoutStartupDelay",
+                            "The playout of a video has begun, after the given delay since "
+                            "the connection was established",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_playoutStartupDelayTrace),
+                            "ns3::Time::TracedCallback")
+            .AddTraceSource("PlayoutStall",
+                            "The playout has stalled because the next frame has not been "
+                            "received yet",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_playoutStallTrace),
+                            "ns3::NrtvTcpClient::StallCallback")
+            .AddTraceSource("PlayoutStallDuration",
+                            "The playout has resumed after a stall of the given duration",
+                            MakeTraceSourceAccessor(&NrtvTcpClient::m_playoutStallDurationTrace),
+                            "ns3::Time::TracedCallback")
             .AddTraceSource("StateTransition",
                             "Trace fired upon every NRTV client state transition",
                             MakeTraceSourceAccessor(&NrtvTcpClient::m_stateTransitionTrace),
@@ -139,6 +209,12 @@ NrtvTcpClient::GetRemoteServerPort() const
     return m_remoteServerPort;
 }
 
+uint64_t
+NrtvTcpClient::GetTotalRx() const
+{
+    return m_totalRx;
+}
+
 NrtvTcpClient::State_t
 NrtvTcpClient::GetState() const
 {
@@ -198,10 +274,23 @@ NrtvTcpClient::StartApplication()
 
     if (m_state == NOT_STARTED)
     {
-        const Time connectionOpenDelay = m_nrtvVariables->GetConnectionOpenDelay();
+        TRAFFIC_COUNTERS_REGISTER(m_counters, "ns3::NrtvTcpClient", GetNode()->GetId());
+#ifdef NS3_TRAFFIC_COUNTERS_ENABLE
+        m_rxBuffer->SetCounters(m_counters);
+#endif
+        m_rxBuffer->SetCapacity(m_rxBufferCapacity);
+
+        m_dejitterBufferWindowSize = GetVariablesView()->GetDejitterBufferWindowSize();
+        m_frameInterval = GetVariablesView()->GetFrameInterval();
+        NS_LOG_INFO(this << " this client application uses"
+                         << " a de-jitter buffer window size of "
+                         << m_dejitterBufferWindowSize.GetSeconds() << " seconds");
+
+        const Time connectionOpenDelay = GetVariablesView()->GetConnectionOpenDelay();
         NS_LOG_INFO(this << " NRTV TCP client started - " << connectionOpenDelay.GetSeconds()
                          << " seconds before opening connection.");
         Simulator::Schedule(connectionOpenDelay, &NrtvTcpClient::OpenConnection, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     }
     else
     {
@@ -216,6 +305,7 @@ NrtvTcpClient::StopApplication()
 
     SwitchToState(STOPPED);
     CancelAllPendingEvents();
+    CancelPlayoutEvents();
     CloseConnection();
 }
 
@@ -228,7 +318,16 @@ NrtvTcpClient::ConnectionSucceededCallback(Ptr<Socket> socket)
     {
         NS_ASSERT_MSG(m_socket == socket, "Invalid socket");
         socket->SetRecvCallback(MakeCallback(&NrtvTcpClient::ReceivedDataCallback, this));
+        ResetPlayout();
         SwitchToState(RECEIVING);
+
+        if (m_abrFeedbackInterval.IsStrictlyPositive())
+        {
+            m_lastFeedbackRx = m_totalRx;
+            m_eventSendFeedback =
+                Simulator::Schedule(m_abrFeedbackInterval, &NrtvTcpClient::SendFeedback, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        }
     }
     else
     {
@@ -246,6 +345,7 @@ NrtvTcpClient::ConnectionFailedCallback(Ptr<Socket> socket)
         if (socket->GetErrno() != Socket::ERROR_NOTERROR)
         {
             m_eventRetryConnection = Simulator::ScheduleNow(&NrtvTcpClient::RetryConnection, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
         }
     }
     else
@@ -261,10 +361,11 @@ NrtvTcpClient::NormalCloseCallback(Ptr<Socket> socket)
 
     CancelAllPendingEvents();
     SwitchToState(IDLE);
-    const Time idleTime = m_nrtvVariables->GetIdleTime();
+    const Time idleTime = GetVariablesView()->GetIdleTime();
     NS_LOG_INFO(this << " a video has just completed, now waiting for " << idleTime.GetSeconds()
                      << " seconds before the next video");
     Simulator::Schedule(idleTime, &NrtvTcpClient::OpenConnection, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
 }
 
 void
@@ -274,6 +375,7 @@ NrtvTcpClient::ErrorCloseCallback(Ptr<Socket> socket)
 
     CancelAllPendingEvents();
     m_eventRetryConnection = Simulator::ScheduleNow(&NrtvTcpClient::RetryConnection, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     /// \todo This won't work because the socket is already closed
 }
 
@@ -282,12 +384,18 @@ NrtvTcpClient::ReceivedDataCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
-    if (m_state == RECEIVING)
+    if (m_state == RECEIVING && m_recvBatchSize > 0)
+    {
+        ReceiveBatch(socket);
+    }
+    else if (m_state == RECEIVING)
     {
         Ptr<Packet> packet;
         Address from;
 
-        while ((packet = socket->RecvFrom(from)))
+        // In a bounded Rx buffer, never read more than it can take.
+        while (!m_rxBuffer->IsFull() &&
+               (packet = socket->RecvFrom(m_rxBuffer->GetFreeSpace(), 0, from)))
         {
             if (packet->GetSize() == 0)
             {
@@ -314,14 +422,25 @@ NrtvTcpClient::ReceivedDataCallback(Ptr<Socket> socket)
 #endif /* NS3_LOG_ENABLE */
 
             m_rxBuffer->PushPacket(packet);
+            m_rxBufferOccupancy = m_rxBuffer->GetTotalBytes();
+            m_totalRx += packet->GetSize();
             m_rxTrace(packet, from);
 
             while (m_rxBuffer->HasVideoSlice())
             {
                 ReceiveVideoSlice(from);
             }
+            m_rxBufferOccupancy = m_rxBuffer->GetTotalBytes();
+
+            /*
+             * Complete slices have been taken out, so a buffer which is still
+             * full holds an incomplete slice which would never fit in.
+             */
+            NS_ABORT_MSG_IF(m_rxBuffer->IsFull(),
+                            "RxBufferCapacity of " << m_rxBufferCapacity
+                                                   << " bytes is too small for a video slice");
 
-        } // end of `while ((packet = socket->RecvFrom (from)))`
+        } // end of `while (... socket->RecvFrom (...))`
 
     } // end of  `if (m_state == RECEIVING)`
     else
@@ -331,6 +450,68 @@ NrtvTcpClient::ReceivedDataCallback(Ptr<Socket> socket)
 
 } // end of `void ReceivedDataCallback (Ptr<Socket> socket)`
 
+void
+NrtvTcpClient::ReceiveBatch(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    NS_ASSERT(m_recvBatchSize > 0);
+
+    Address from;
+    bool isDrained = false;
+    uint32_t numOfReads = 0;
+    uint32_t numOfBytes = 0;
+
+    while (!isDrained)
+    {
+        // Fill the Rx buffer as far as the socket and the capacity allow.
+        while (!m_rxBuffer->IsFull())
+        {
+            const uint32_t maxSize = std::min(m_recvBatchSize, m_rxBuffer->GetFreeSpace());
+            Ptr<Packet> packet = socket->RecvFrom(maxSize, 0, from);
+            if (packet == nullptr || packet->GetSize() == 0)
+            {
+                isDrained = true; // no more data or EOF
+                break;
+            }
+
+            numOfReads++;
+            numOfBytes += packet->GetSize();
+            m_rxBuffer->PushPacket(packet);
+            m_totalRx += packet->GetSize();
+            m_rxTrace(packet, from);
+        }
+        m_rxBufferOccupancy = m_rxBuffer->GetTotalBytes();
+
+        while (m_rxBuffer->HasVideoSlice())
+        {
+            ReceiveVideoSlice(from);
+        }
+        m_rxBufferOccupancy = m_rxBuffer->GetTotalBytes();
+
+        NS_ABORT_MSG_IF(m_rxBuffer->IsFull(),
+                        "RxBufferCapacity of " << m_rxBufferCapacity
+                                               << " bytes is too small for a video slice");
+    }
+
+    NS_LOG_INFO(this << " drained " << numOfBytes << " bytes in " << numOfReads << " read(s)");
+
+} // end of `void ReceiveBatch (Ptr<Socket> socket)`
+
+Ptr<NrtvVariablesView>
+NrtvTcpClient::GetVariablesView()
+{
+    if (m_nrtvVariablesView == nullptr)
+    {
+        if (m_nrtvVariables == nullptr)
+        {
+            m_nrtvVariables = CreateObject<NrtvVariables>();
+        }
+        m_nrtvVariablesView = m_nrtvVariables->CreateView();
+    }
+
+    return m_nrtvVariablesView;
+}
+
 void
 NrtvTcpClient::OpenConnection()
 {
@@ -374,7 +555,10 @@ NrtvTcpClient::OpenConnection()
         // NS_UNUSED (ret); // mute compiler warning
         NS_ASSERT_MSG(m_socket != nullptr, "Failed creating socket");
 
-        m_socket->ShutdownSend();
+        if (m_abrFeedbackInterval.IsZero())
+        {
+            m_socket->ShutdownSend(); // the feedback is the only upstream data
+        }
         m_socket->SetConnectCallback(
             MakeCallback(&NrtvTcpClient::ConnectionSucceededCallback, this),
             MakeCallback(&NrtvTcpClient::ConnectionFailedCallback, this));
@@ -439,44 +623,217 @@ NrtvTcpClient::ReceiveVideoSlice(const Address& from)
 {
     NS_LOG_FUNCTION(this << from);
 
-    Ptr<Packet> slice = m_rxBuffer->PopVideoSlice();
-
     NrtvHeader nrtvHeader;
+    Ptr<Packet> slice;
 
-    NS_ASSERT_MSG(slice->GetSize() >= nrtvHeader.GetSerializedSize(),
-                  "The video slice contains no NRTV header");
+    if (m_rxSliceTrace.IsEmpty())
+    {
+        // nobody is interested in the slice content, so skip re-assembling it
+        nrtvHeader = m_rxBuffer->PopVideoSliceHeader();
+    }
+    else
+    {
+        slice = m_rxBuffer->PopVideoSlice();
+        NS_ASSERT_MSG(slice->GetSize() >= NrtvHeader::GetStaticSerializedSize(),
+                      "The video slice contains no NRTV header");
+        slice->PeekHeader(nrtvHeader);
+        NS_ASSERT(nrtvHeader.GetSliceSize() + NrtvHeader::GetStaticSerializedSize() ==
+                  slice->GetSize());
+    }
 
-    slice->PeekHeader(nrtvHeader);
     const uint32_t frameNumber = nrtvHeader.GetFrameNumber();
     const uint32_t numOfFrames = nrtvHeader.GetNumOfFrames();
     const uint16_t sliceNumber = nrtvHeader.GetSliceNumber();
     const uint16_t numOfSlices = nrtvHeader.GetNumOfSlices();
     const uint32_t sliceSize = nrtvHeader.GetSliceSize();
-    NS_ASSERT(sliceSize + nrtvHeader.GetSerializedSize() == slice->GetSize());
 
     const Time delay = Simulator::Now() - nrtvHeader.GetArrivalTime();
     NS_LOG_INFO(this << " received a " << sliceSize << "-byte video slice"
                      << " for frame " << frameNumber << " and slice " << sliceNumber
                      << " (delay= " << delay.GetSeconds() << ")");
 
-    m_rxSliceTrace(slice);
+    if (slice != nullptr)
+    {
+        m_rxSliceTrace(slice);
+    }
     m_rxDelayTrace(delay, from);
-    if (m_lastDelay.IsZero() == false)
+    if (!m_rxJitterTrace.IsEmpty() || !m_rxPdvTrace.IsEmpty())
+    {
+        m_jitterEstimator.AddDelay(delay);
+        if (m_jitterEstimator.HasJitter())
+        {
+            m_rxJitterTrace(m_jitterEstimator.GetJitter(), from);
+        }
+        m_rxPdvTrace(m_jitterEstimator.GetDelayVariation(), from);
+    }
+
+    // accumulate the figures of the frame, discarding those of an unfinished one
+    const Time arrivalTime = Simulator::Now() - delay;
+    if (m_frameStatsNumOfSlices == 0 || m_frameStatsNumber != frameNumber)
     {
-        Time jitter = Abs(delay - m_lastDelay);
-        m_rxJitterTrace(jitter, from);
+        m_frameStatsNumber = frameNumber;
+        m_frameStatsNumOfSlices = 0;
+        m_frameStatsSize = 0;
+        m_frameStatsFirstArrival = arrivalTime;
+        m_frameStatsMaxDelay = delay;
     }
-    m_lastDelay = delay;
+    m_frameStatsNumOfSlices++;
+    m_frameStatsSize += sliceSize;
+    m_frameStatsFirstArrival = std::min(m_frameStatsFirstArrival, arrivalTime);
+    m_frameStatsMaxDelay = std::max(m_frameStatsMaxDelay, delay);
 
     if (sliceNumber == numOfSlices)
     {
         // this is the last slice of the frame
         m_rxFrameTrace(frameNumber, numOfFrames);
+        m_rxFrameStatsTrace(frameNumber,
+                            m_frameStatsSize,
+                            Simulator::Now() - m_frameStatsFirstArrival,
+                            m_frameStatsMaxDelay,
+                            from);
+        m_frameStatsNumOfSlices = 0;
+        if (!m_hasStartedPlayout && m_numOfBufferedFrames == 0 && m_numOfPlayedFrames == 0 &&
+            frameNumber > 1)
+        {
+            // the video has been resumed from a checkpoint by the server
+            m_numOfPlayedFrames = frameNumber - 1;
+        }
+        BufferFrame(numOfFrames);
     }
 
     return sliceSize;
 }
 
+void
+NrtvTcpClient::ResetPlayout()
+{
+    NS_LOG_FUNCTION(this);
+
+    CancelPlayoutEvents();
+    m_jitterEstimator.Reset();
+    m_frameStatsNumOfSlices = 0;
+    m_sessionStartTime = Simulator::Now();
+    m_numOfBufferedFrames = 0;
+    m_numOfPlayedFrames = 0;
+    m_numOfFramesInVideo = 0;
+    m_stallCount = 0;
+    m_isPlaying = false;
+    m_hasStartedPlayout = false;
+}
+
+void
+NrtvTcpClient::BufferFrame(uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << numOfFrames);
+
+    m_numOfFramesInVideo = numOfFrames;
+    m_numOfBufferedFrames++;
+    NS_LOG_INFO(this << " playout buffer now contains " << m_numOfBufferedFrames << " frame(s)");
+
+    if (!m_isPlaying && Simulator::IsExpired(m_eventStartPlayout))
+    {
+        // hold the frame for the de-jitter buffer window before playing it
+        m_eventStartPlayout =
+            Simulator::Schedule(m_dejitterBufferWindowSize, &NrtvTcpClient::StartPlayout, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+    }
+}
+
+void
+NrtvTcpClient::StartPlayout()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_isPlaying);
+    NS_ASSERT(m_numOfBufferedFrames > 0);
+
+    if (m_hasStartedPlayout)
+    {
+        const Time stallDuration = Simulator::Now() - m_stallStartTime;
+        NS_LOG_INFO(this << " playout resumes after a stall of " << stallDuration.GetSeconds()
+                         << " seconds");
+        m_playoutStallDurationTrace(stallDuration);
+    }
+    else
+    {
+        const Time startupDelay = Simulator::Now() - m_sessionStartTime;
+        NS_LOG_INFO(this << " playout begins after a startup delay of "
+                         << startupDelay.GetSeconds() << " seconds");
+        m_hasStartedPlayout = true;
+        m_playoutStartupDelayTrace(startupDelay);
+    }
+
+    m_isPlaying = true;
+    PlayFrame();
+}
+
+void
+NrtvTcpClient::PlayFrame()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_isPlaying);
+
+    if (m_numOfBufferedFrames == 0)
+    {
+        if (m_numOfFramesInVideo > 0 && m_numOfPlayedFrames >= m_numOfFramesInVideo)
+        {
+            NS_LOG_INFO(this << " playout of the video has finished");
+        }
+        else
+        {
+            m_stallCount++;
+            m_stallStartTime = Simulator::Now();
+            NS_LOG_INFO(this << " playout stalls for the " << m_stallCount << "-th time");
+            m_playoutStallTrace(m_stallCount);
+        }
+
+        m_isPlaying = false;
+        return;
+    }
+
+    m_numOfBufferedFrames--;
+    m_numOfPlayedFrames++;
+    m_playoutFrameTrace(m_numOfPlayedFrames, m_numOfFramesInVideo);
+    m_eventPlayFrame = Simulator::Schedule(m_frameInterval, &NrtvTcpClient::PlayFrame, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+
+} // end of `void PlayFrame ()`
+
+void
+NrtvTcpClient::SendFeedback()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_state != RECEIVING)
+    {
+        return;
+    }
+
+    NrtvFeedbackHeader feedback;
+    feedback.SetThroughput(static_cast<uint64_t>((m_totalRx - m_lastFeedbackRx) * 8 /
+                                                 m_abrFeedbackInterval.GetSeconds()));
+    feedback.SetBufferLevel(m_frameInterval * m_numOfBufferedFrames);
+    feedback.SetStallCount(m_stallCount);
+    m_lastFeedbackRx = m_totalRx;
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(feedback);
+    NS_LOG_INFO(this << " sending feedback " << feedback);
+    m_socket->Send(packet);
+
+    m_eventSendFeedback =
+        Simulator::Schedule(m_abrFeedbackInterval, &NrtvTcpClient::SendFeedback, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+}
+
+void
+NrtvTcpClient::CancelPlayoutEvents()
+{
+    NS_LOG_FUNCTION(this);
+
+    Simulator::Cancel(m_eventStartPlayout);
+    Simulator::Cancel(m_eventPlayFrame);
+}
+
 void
 NrtvTcpClient::CancelAllPendingEvents()
 {
@@ -489,6 +846,8 @@ NrtvTcpClient::CancelAllPendingEvents()
                          << " seconds");
         Simulator::Cancel(m_eventRetryConnection);
     }
+
+    Simulator::Cancel(m_eventSendFeedback);
 }
 
 void
@@ -507,11 +866,55 @@ NrtvTcpClient::SwitchToState(NrtvTcpClient::State_t state)
 
 NS_LOG_COMPONENT_DEFINE("NrtvTcpClientRxBuffer");
 
-NrtvTcpClientRxBuffer::NrtvTcpClientRxBuffer()
-    : m_totalBytes(0),
-      m_sizeOfVideoSlice(0)
+NrtvTcpClientRxBuffer::NrtvTcpClientRxBuffer(uint32_t capacity)
+    : m_rxBuffer(16),
+      m_head(0),
+      m_numOfPackets(0),
+      m_capacity(capacity),
+      m_frontOffset(0),
+      m_totalBytes(0),
+      m_hasNextHeader(false)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << capacity);
+}
+
+void
+NrtvTcpClientRxBuffer::SetCapacity(uint32_t capacity)
+{
+    NS_LOG_FUNCTION(this << capacity);
+    NS_ASSERT_MSG(capacity == 0 || capacity >= m_totalBytes,
+                  "The buffer already contains " << m_totalBytes << " bytes");
+    m_capacity = capacity;
+}
+
+uint32_t
+NrtvTcpClientRxBuffer::GetCapacity() const
+{
+    return m_capacity;
+}
+
+uint32_t
+NrtvTcpClientRxBuffer::GetTotalBytes() const
+{
+    return m_totalBytes;
+}
+
+uint32_t
+NrtvTcpClientRxBuffer::GetFreeSpace() const
+{
+    if (m_capacity == 0)
+    {
+        return std::numeric_limits<uint32_t>::max();
+    }
+
+    NS_ASSERT(m_capacity >= m_totalBytes);
+    return m_capacity - m_totalBytes;
+}
+
+bool
+NrtvTcpClientRxBuffer::IsFull() const
+{
+    return m_capacity != 0 && m_totalBytes >= m_capacity;
 }
 
 bool
@@ -519,12 +922,12 @@ NrtvTcpClientRxBuffer::IsEmpty() const
 {
     if (m_totalBytes == 0)
     {
-        NS_ASSERT(m_rxBuffer.size() == 0);
+        NS_ASSERT(m_numOfPackets == 0);
         return true;
     }
     else
     {
-        NS_ASSERT(m_rxBuffer.size() > 0);
+        NS_ASSERT(m_numOfPackets > 0);
         return false;
     }
 }
@@ -532,8 +935,8 @@ NrtvTcpClientRxBuffer::IsEmpty() const
 bool
 NrtvTcpClientRxBuffer::HasVideoSlice() const
 {
-    NrtvHeader header;
-    return m_totalBytes >= (m_sizeOfVideoSlice + header.GetSerializedSize());
+    return m_hasNextHeader &&
+           m_totalBytes >= (m_nextHeader.GetSliceSize() + NrtvHeader::GetStaticSerializedSize());
 }
 
 void
@@ -542,55 +945,42 @@ NrtvTcpClientRxBuffer::PushPacket(Ptr<const Packet> packet)
     const uint32_t packetSize = packet->GetSize();
     NS_LOG_FUNCTION(this << packet << packetSize);
 
-    if (m_sizeOfVideoSlice == 0)
+    if (packetSize == 0)
     {
-        // we don't know the size of slice yet
-        NrtvHeader header;
+        return;
+    }
 
-        if (IsEmpty())
-        {
-            m_rxBuffer.push_back(packet->Copy());
-        }
-        else
-        {
-            /*
-             * The existing packet in the buffer must be a very small packet that
-             * contains part of the header. So we combine it together with this
-             * packet.
-             */
-            NS_ASSERT(m_rxBuffer.size() == 1);
-            const uint32_t priorRemain = m_rxBuffer.back()->GetSize();
-            NS_ASSERT(priorRemain < header.GetSerializedSize());
-            NS_LOG_LOGIC(this << " combining a " << priorRemain << "-byte"
-                              << " left over from previous slice with " << packetSize
-                              << " bytes of packet");
-            m_rxBuffer.back()->AddAtEnd(packet);
-        }
+    NS_ASSERT_MSG(packetSize <= GetFreeSpace(),
+                  "A packet of " << packetSize << " bytes exceeds the free space of "
+                                 << GetFreeSpace() << " bytes");
 
-        NS_ASSERT(m_rxBuffer.size() == 1);
-        if (m_rxBuffer.back()->GetSize() >= header.GetSerializedSize())
-        {
-            m_sizeOfVideoSlice = PeekSliceSize(m_rxBuffer.back());
-            NS_LOG_INFO(this << " now expecting a video slice of " << m_sizeOfVideoSlice
-                             << " bytes");
-        }
-        else
+    if (m_numOfPackets == m_rxBuffer.size())
+    {
+        // the ring is full, so double its size and unwrap the packets
+        std::vector<Ptr<const Packet>> ring(2 * m_rxBuffer.size());
+        for (uint32_t i = 0; i < m_numOfPackets; i++)
         {
-            /*
-             * Still not enough packets to constitute a 24-byte header (sigh).
-             * m_sizeOfVideoSlice stays at zero.
-             */
+            ring[i] = GetPacket(i);
         }
+        m_rxBuffer.swap(ring);
+        m_head = 0;
+        NS_LOG_LOGIC(this << " ring grown to " << m_rxBuffer.size() << " packets");
     }
-    else
-    {
-        m_rxBuffer.push_back(packet->Copy());
-    }
+
+    /*
+     * The packet is kept by reference. It will not be modified afterwards,
+     * because consumed bytes are tracked using m_frontOffset instead.
+     */
+    m_rxBuffer[(m_head + m_numOfPackets) & (m_rxBuffer.size() - 1)] = packet;
+    m_numOfPackets++;
 
     // increase the buffer size counter
     m_totalBytes += packetSize;
-    NS_LOG_DEBUG(this << " Rx buffer now contains " << m_rxBuffer.size() << " packet(s)"
+    TRAFFIC_COUNTERS_MAX(m_counters, RX_BUFFER_HIGH_WATER_MARK, m_totalBytes);
+    NS_LOG_DEBUG(this << " Rx buffer now contains " << m_numOfPackets << " packet(s)"
                       << " (" << m_totalBytes << " bytes)");
+
+    ReadNextHeader();
 }
 
 Ptr<Packet>
@@ -599,90 +989,189 @@ NrtvTcpClientRxBuffer::PopVideoSlice()
     NS_LOG_FUNCTION(this);
     NS_ASSERT_MSG(!IsEmpty(), "Unable to pop from an empty Rx buffer");
     NS_ASSERT_MSG(HasVideoSlice(), "Not enough packets to constitute a complete video slice");
-    NS_ASSERT(PeekSliceSize(m_rxBuffer.front()) == m_sizeOfVideoSlice);
 
-    Ptr<Packet> slice = Create<Packet>();
-    NrtvHeader header;
-    const uint32_t expectedPacketSize = m_sizeOfVideoSlice + header.GetSerializedSize();
-    uint32_t bytesToFetch = expectedPacketSize;
+    const uint32_t expectedPacketSize =
+        m_nextHeader.GetSliceSize() + NrtvHeader::GetStaticSerializedSize();
+    Ptr<Packet> slice = PeekBytes(expectedPacketSize);
+    NS_ASSERT(slice->GetSize() == expectedPacketSize);
+    RemoveBytes(expectedPacketSize);
+    return slice;
+}
+
+NrtvHeader
+NrtvTcpClientRxBuffer::PopVideoSliceHeader()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!IsEmpty(), "Unable to pop from an empty Rx buffer");
+    NS_ASSERT_MSG(HasVideoSlice(), "Not enough packets to constitute a complete video slice");
+
+    const NrtvHeader header = m_nextHeader; // RemoveBytes() reads the next one
+    RemoveBytes(header.GetSliceSize() + NrtvHeader::GetStaticSerializedSize());
+    return header;
+}
+
+Ptr<Packet>
+NrtvTcpClientRxBuffer::PeekBytes(uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << size);
+    NS_ASSERT(size <= m_totalBytes);
+
+    Ptr<Packet> result = Create<Packet>();
+    TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
+    TRAFFIC_COUNTERS_ADD(m_counters, BYTES_COPIED, size);
+    uint32_t offset = m_frontOffset;
+    uint32_t bytesToFetch = size;
+    uint32_t index = 0;
 
     while (bytesToFetch > 0)
     {
-        NS_ASSERT(!m_rxBuffer.empty()); // ensure that front() is not undefined
-        const uint32_t packetSize = m_rxBuffer.front()->GetSize();
-        NS_LOG_INFO(this << " using a " << packetSize << "-byte packet"
+        NS_ASSERT(index < m_numOfPackets);
+        const Ptr<const Packet>& packet = GetPacket(index);
+        const uint32_t packetSize = packet->GetSize();
+        const uint32_t available = packetSize - offset;
+        NS_LOG_INFO(this << " using " << std::min(available, bytesToFetch) << " bytes of a "
+                         << packetSize << "-byte packet"
                          << " to compose a video slice"
                          << " (" << bytesToFetch << " bytes to go)");
 
-        if (packetSize <= bytesToFetch)
+        if (offset == 0 && packetSize <= bytesToFetch)
         {
             // absorb the whole packet
-            slice->AddAtEnd(m_rxBuffer.front());
+            result->AddAtEnd(packet);
             bytesToFetch -= packetSize;
-            m_rxBuffer.pop_front();
         }
         else
         {
-            // absorb only the first part of the packet
-            slice->AddAtEnd(m_rxBuffer.front()->CreateFragment(0, bytesToFetch));
-
-            // leave the second part in the buffer
-            const uint32_t residueBytes = packetSize - bytesToFetch;
-            NS_LOG_LOGIC(this << " setting aside " << residueBytes << " bytes"
-                              << " for the next video slice");
-            m_rxBuffer.front()->RemoveAtStart(bytesToFetch);
-            NS_ASSERT(m_rxBuffer.front()->GetSize() == residueBytes);
-            bytesToFetch = 0; // this exits the loop
+            // absorb only part of the packet
+            const uint32_t fragmentSize = std::min(available, bytesToFetch);
+            result->AddAtEnd(packet->CreateFragment(offset, fragmentSize));
+            bytesToFetch -= fragmentSize;
         }
 
+        offset = 0;
+        ++index;
+
     } // end of `while (bytesToFetch > 0)`
 
-    const uint32_t packetSize = slice->GetSize();
-    NS_ASSERT(packetSize == expectedPacketSize);
+    return result;
+
+} // end of `Ptr<Packet> PeekBytes (uint32_t size) const`
+
+void
+NrtvTcpClientRxBuffer::RemoveBytes(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    NS_ASSERT(size <= m_totalBytes);
+
+    uint32_t bytesToRemove = size;
+
+    while (bytesToRemove > 0)
+    {
+        NS_ASSERT(m_numOfPackets > 0); // ensure that the first packet is not undefined
+        const uint32_t available = GetPacket(0)->GetSize() - m_frontOffset;
+
+        if (available <= bytesToRemove)
+        {
+            // the whole remaining part of the packet is consumed
+            bytesToRemove -= available;
+            PopFrontPacket();
+            m_frontOffset = 0;
+        }
+        else
+        {
+            // leave the second part in the buffer
+            m_frontOffset += bytesToRemove;
+            TRAFFIC_COUNTERS_ADD(m_counters, REASSEMBLY_SPLITS, 1);
+            NS_LOG_LOGIC(this << " setting aside " << (available - bytesToRemove) << " bytes"
+                              << " for the next video slice");
+            bytesToRemove = 0; // this exits the loop
+        }
+    }
 
     // deplete the buffer size counter
-    NS_ASSERT(m_totalBytes >= packetSize);
-    m_totalBytes -= packetSize;
-    NS_LOG_DEBUG(this << " Rx buffer now contains " << m_rxBuffer.size() << " packet(s)"
+    m_totalBytes -= size;
+    NS_LOG_DEBUG(this << " Rx buffer now contains " << m_numOfPackets << " packet(s)"
                       << " (" << m_totalBytes << " bytes)");
 
     // determine the size of next slice to receive
-    if (m_rxBuffer.empty())
+    m_hasNextHeader = false;
+    ReadNextHeader();
+
+} // end of `void RemoveBytes (uint32_t size)`
+
+void
+NrtvTcpClientRxBuffer::ReadNextHeader()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_hasNextHeader)
+    {
+        return;
+    }
+
+    if (m_totalBytes < NrtvHeader::GetStaticSerializedSize())
     {
         /*
-         * The buffer is empty, so we can only tell about the next slice later
-         * after the next packet is received.
+         * Either the buffer is empty, or it contains only part of the header,
+         * so the rest will come in the next packet.
          */
-        m_sizeOfVideoSlice = 0;
+        NS_LOG_INFO(this << " cannot read the header yet");
+        return;
     }
-    else if (m_rxBuffer.front()->GetSize() >= header.GetSerializedSize())
+
+    PeekHeaderBytes()->PeekHeader(m_nextHeader);
+    m_hasNextHeader = true;
+    NS_LOG_INFO(this << " now expecting a video slice of " << m_nextHeader.GetSliceSize()
+                     << " bytes");
+
+} // end of `void ReadNextHeader ()`
+
+const Ptr<const Packet>&
+NrtvTcpClientRxBuffer::GetPacket(uint32_t index) const
+{
+    NS_ASSERT(index < m_numOfPackets);
+    return m_rxBuffer[(m_head + index) & (m_rxBuffer.size() - 1)];
+}
+
+void
+NrtvTcpClientRxBuffer::PopFrontPacket()
+{
+    NS_ASSERT(m_numOfPackets > 0);
+    m_rxBuffer[m_head] = nullptr; // release the reference
+    m_head = (m_head + 1) & (m_rxBuffer.size() - 1);
+    m_numOfPackets--;
+}
+
+#ifdef NS3_TRAFFIC_COUNTERS_ENABLE
+void
+NrtvTcpClientRxBuffer::SetCounters(Ptr<TrafficCounters> counters)
+{
+    m_counters = counters;
+}
+#endif /* NS3_TRAFFIC_COUNTERS_ENABLE */
+
+Ptr<const Packet>
+NrtvTcpClientRxBuffer::PeekHeaderBytes() const
+{
+    const uint32_t headerSize = NrtvHeader::GetStaticSerializedSize();
+    NS_ASSERT(m_totalBytes >= headerSize);
+    const Ptr<const Packet>& front = GetPacket(0);
+
+    if (m_frontOffset == 0 && front->GetSize() >= headerSize)
     {
-        // the buffer is not empty and we can read an NRTV header from it
-        m_sizeOfVideoSlice = PeekSliceSize(m_rxBuffer.front());
-        NS_LOG_INFO(this << " now expecting a video slice of " << m_sizeOfVideoSlice << " bytes");
+        // the usual case, where the header can be read directly from the packet
+        return front;
     }
     else
     {
-        // the buffer is not empty, but we cannot read an NRTV header
-        m_sizeOfVideoSlice = 0;
-        NS_LOG_INFO(this << " cannot read the header yet,"
-                         << " it must have been split,"
-                         << " so the rest will come in the next packet");
+        /*
+         * The header is located in the middle of the packet or it has been split
+         * across packets, so compose a temporary packet containing only the header.
+         */
+        NS_LOG_LOGIC(this << " composing the header from an offset of " << m_frontOffset
+                          << " bytes");
+        return PeekBytes(headerSize);
     }
-
-    return slice;
-
-} // end of `Ptr<Packet> PopVideoSlice ()`
-
-uint32_t // static
-NrtvTcpClientRxBuffer::PeekSliceSize(Ptr<const Packet> packet)
-{
-    NS_LOG_FUNCTION(packet << packet->GetSize());
-    NrtvHeader nrtvHeader;
-    NS_ASSERT_MSG(packet->GetSize() >= nrtvHeader.GetSerializedSize(),
-                  "The packet contains no NRTV header");
-    packet->PeekHeader(nrtvHeader);
-    return nrtvHeader.GetSliceSize();
 }
 
 } // namespace ns3
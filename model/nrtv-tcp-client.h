@@ -25,17 +25,22 @@
 
 #include <ns3/address.h>
 #include <ns3/application.h>
+#include <ns3/jitter-estimator.h>
+#include <ns3/nrtv-header.h>
 #include <ns3/nstime.h>
 #include <ns3/packet.h>
 #include <ns3/traced-callback.h>
+#include <ns3/traced-value.h>
+#include <ns3/traffic-counters.h>
 
-#include <list>
+#include <vector>
 
 namespace ns3
 {
 
 class Socket;
 class NrtvVariables;
+class NrtvVariablesView;
 class NrtvTcpClientRxBuffer;
 
 /**
@@ -53,6 +58,28 @@ class NrtvTcpClientRxBuffer;
  * between videos (e.g., commenting or picking the next video). After the IDLE
  * timer expires, the application restarts again by sending another connection
  * request.
+ *
+ * Received frames are played out through a de-jitter buffer. The playout of a
+ * video begins once the first frame has been held in the buffer for the
+ * de-jitter buffer window size (see NrtvVariables), and then continues with
+ * one frame per frame interval. If the next frame has not been completely
+ * received by the time it should be played, the playout stalls (rebuffers)
+ * until that frame has again been held for the de-jitter buffer window size.
+ * The `PlayoutStartupDelay`, `PlayoutStall`, and `PlayoutStallDuration`
+ * trace sources report these events.
+ *
+ * The `RxDelay`, `RxJitter`, and `RxPdv` trace sources are fired for every
+ * slice. If only per-frame figures are needed, the `RxFrameStats` trace source
+ * is fired once per frame instead, with the size of the frame, the delay until
+ * the frame has been completely received, and the largest delay of its slices
+ * (see also ApplicationStatsFrameDelayHelper). The jitter of the slices is
+ * only estimated while `RxJitter` or `RxPdv` is connected.
+ *
+ * If the `AbrFeedbackInterval` attribute is not zero, the client periodically
+ * sends feedback (see NrtvFeedbackHeader) to the server while receiving a
+ * video, with the throughput since the previous feedback, the playout buffer
+ * level, and the number of stalls so far. The server uses the feedback to
+ * adapt the bitrate of the video (see NrtvVideoWorker).
  */
 class NrtvTcpClient : public Application
 {
@@ -98,6 +125,13 @@ class NrtvTcpClient : public Application
      */
     uint16_t GetRemoteServerPort() const;
 
+    /**
+     * \return the total number of bytes received from the socket so far,
+     *         i.e., the sum of the sizes of the packets passed to the `Rx`
+     *         trace source
+     */
+    uint64_t GetTotalRx() const;
+
     /// The possible states of the application.
     enum State_t
     {
@@ -129,6 +163,37 @@ class NrtvTcpClient : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * \brief Common callback signature for `RxFrame` and `PlayoutFrame` trace
+     *        sources.
+     * \param frameNumber the number of the frame within the video.
+     * \param numOfFrames the number of frames in the video.
+     */
+    typedef void (*RxFrameCallback)(uint32_t frameNumber, uint32_t numOfFrames);
+
+    /**
+     * \brief Callback signature for `PlayoutStall` trace source.
+     * \param stallCount the number of stalls so far in the current video,
+     *                   including this one.
+     */
+    typedef void (*StallCallback)(uint32_t stallCount);
+
+    /**
+     * \brief Callback signature for `RxFrameStats` trace source.
+     * \param frameNumber the number of the frame within the video.
+     * \param frameSize the sum of the slice sizes of the frame in bytes, not
+     *                  including the NRTV headers.
+     * \param frameDelay the time since the earliest timestamp of the slices of
+     *                   the frame until the frame has been completely received.
+     * \param maxSliceDelay the largest delay among the slices of the frame.
+     * \param from the address of the server.
+     */
+    typedef void (*RxFrameStatsCallback)(uint32_t frameNumber,
+                                         uint32_t frameSize,
+                                         const Time& frameDelay,
+                                         const Time& maxSliceDelay,
+                                         const Address& from);
+
   protected:
     // Inherited from Object base class
     virtual void DoDispose();
@@ -170,6 +235,21 @@ class NrtvTcpClient : public Application
      */
     void ReceivedDataCallback(Ptr<Socket> socket);
 
+    /**
+     * \brief Drain the socket with reads of up to `RecvBatchSize` bytes into
+     *        the Rx buffer, and then take out all complete video slices in one
+     *        pass. Used by ReceivedDataCallback() when `RecvBatchSize` is not
+     *        zero.
+     * \param socket The socket bound to remote server address
+     */
+    void ReceiveBatch(Ptr<Socket> socket);
+
+    /**
+     * \return the view of the random variable collection, creating the
+     *         collection and the view if needed
+     */
+    Ptr<NrtvVariablesView> GetVariablesView();
+
     /**
      * Open connection to the server.
      */
@@ -192,6 +272,40 @@ class NrtvTcpClient : public Application
      */
     uint32_t ReceiveVideoSlice(const Address& from);
 
+    /**
+     * Start a new video session in the playout buffer and the jitter estimator.
+     */
+    void ResetPlayout();
+
+    /**
+     * Put a completely received frame into the playout buffer.
+     * \param numOfFrames Number of frames in the video.
+     */
+    void BufferFrame(uint32_t numOfFrames);
+
+    /**
+     * Begin or resume the playout, after the de-jitter buffer window since the
+     * first buffered frame has passed.
+     */
+    void StartPlayout();
+
+    /**
+     * Play the next frame from the playout buffer, or stall if the buffer is
+     * empty.
+     */
+    void PlayFrame();
+
+    /**
+     * Send feedback on the throughput and the playout buffer to the server,
+     * and schedule the next feedback.
+     */
+    void SendFeedback();
+
+    /**
+     * Cancel the playout events.
+     */
+    void CancelPlayoutEvents();
+
     /**
      * Cancel reconnection event.
      */
@@ -217,17 +331,49 @@ class NrtvTcpClient : public Application
 
     /**
      * The random variable collection instance which is used as a source for
-     * client behavior, e.g. idle time between videos.
+     * client behavior, e.g. idle time between videos. Created on the first
+     * draw unless given through the attribute.
      */
     Ptr<NrtvVariables> m_nrtvVariables;
 
+    /// View of #m_nrtvVariables used by this client, created on the first draw.
+    Ptr<NrtvVariablesView> m_nrtvVariablesView;
+
     Address m_remoteServerAddress; ///!< Remote server address
     uint16_t m_remoteServerPort;   ///!< Remote server port
-
-    Time m_lastDelay; /// Last delay measurement. Used to compute jitter.
+    uint32_t m_rxBufferCapacity;   ///!< `RxBufferCapacity` attribute
+    uint32_t m_recvBatchSize;      ///!< `RecvBatchSize` attribute
+    Time m_abrFeedbackInterval;    ///!< `AbrFeedbackInterval` attribute
+    uint64_t m_totalRx;            ///!< Total bytes received from the socket
+    uint64_t m_lastFeedbackRx;     ///!< Value of #m_totalRx at the previous feedback
+
+    JitterEstimator m_jitterEstimator; ///< Jitter of the slices of the current video
+
+    // FRAME STATISTICS
+
+    uint32_t m_frameStatsNumber;       ///< Frame whose slices are being accumulated
+    uint32_t m_frameStatsNumOfSlices;  ///< Slices of the frame received so far
+    uint32_t m_frameStatsSize;         ///< Bytes of the frame received so far
+    Time m_frameStatsFirstArrival;     ///< Earliest timestamp of the slices of the frame
+    Time m_frameStatsMaxDelay;         ///< Largest delay of the slices of the frame
+
+    // PLAYOUT BUFFER
+
+    Time m_frameInterval;              ///< Playout interval between frames
+    Time m_sessionStartTime;           ///< Time when the current video session began
+    Time m_stallStartTime;             ///< Time when the current stall began
+    uint32_t m_numOfBufferedFrames;    ///< Frames received but not played yet
+    uint32_t m_numOfPlayedFrames;      ///< Frames played in the current video
+    uint32_t m_numOfFramesInVideo;     ///< Number of frames in the current video
+    uint32_t m_stallCount;             ///< Number of stalls in the current video
+    bool m_isPlaying;                  ///< True while frames are played out
+    bool m_hasStartedPlayout;          ///< True after the startup of the current video
 
     // TRACE SOURCES
 
+    /// Number of bytes in the Rx buffer, i.e., of the incomplete video slice.
+    TracedValue<uint32_t> m_rxBufferOccupancy;
+
     /**
      * \brief Trace source for packet being received.
      *
@@ -249,7 +395,8 @@ class NrtvTcpClient : public Application
     TracedCallback<const Time&, const Address&> m_rxDelayTrace;
 
     /**
-     * \brief Trace source for packet jitter upon receiving of a packet.
+     * \brief Trace source for RFC 3550 interarrival jitter upon receiving of a
+     *        slice, starting from the second slice of a video.
      *
      * Example signature of callback function (with context):
      *
@@ -258,6 +405,17 @@ class NrtvTcpClient : public Application
      */
     TracedCallback<const Time&, const Address&> m_rxJitterTrace;
 
+    /**
+     * \brief Trace source for packet delay variation upon receiving of a slice,
+     *        i.e., the slice delay relative to the smallest delay of the video.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void RxPdvCallback (std::string context, Time variation,
+     *                         const Address & from);
+     */
+    TracedCallback<const Time&, const Address&> m_rxPdvTrace;
+
     /**
      * \brief Trace source for an entire slice being constructed from the buffer.
      *
@@ -277,6 +435,56 @@ class NrtvTcpClient : public Application
      */
     TracedCallback<uint32_t, uint32_t> m_rxFrameTrace;
 
+    /**
+     * \brief Trace source for the aggregated figures of a frame, fired once
+     *        all slices of the frame have been received.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void RxFrameStatsCallback (std::string context, uint32_t frameNumber,
+     *                                uint32_t frameSize, Time frameDelay,
+     *                                Time maxSliceDelay, const Address & from);
+     */
+    TracedCallback<uint32_t, uint32_t, const Time&, const Time&, const Address&>
+        m_rxFrameStatsTrace;
+
+    /**
+     * \brief Trace source for a frame being played out from the buffer.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void PlayoutFrameCallback (std::string context,
+     *                                uint32_t frameNumber, uint32_t numOfFrames);
+     */
+    TracedCallback<uint32_t, uint32_t> m_playoutFrameTrace;
+
+    /**
+     * \brief Trace source for the delay until the playout of a video begins.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void PlayoutStartupDelayCallback (std::string context, Time delay);
+     */
+    TracedCallback<Time> m_playoutStartupDelayTrace;
+
+    /**
+     * \brief Trace source for the playout running out of frames.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void PlayoutStallCallback (std::string context, uint32_t stallCount);
+     */
+    TracedCallback<uint32_t> m_playoutStallTrace;
+
+    /**
+     * \brief Trace source for the playout resuming after a stall.
+     *
+     * Example signature of callback function (with context):
+     *
+     *     void PlayoutStallDurationCallback (std::string context, Time duration);
+     */
+    TracedCallback<Time> m_playoutStallDurationTrace;
+
     /**
      * \brief Trace source for application state changing.
      *
@@ -290,18 +498,79 @@ class NrtvTcpClient : public Application
     // EVENTS
 
     EventId m_eventRetryConnection; ///<! Event for retrying connection
+    EventId m_eventStartPlayout;    ///<! Event for beginning or resuming the playout
+    EventId m_eventPlayFrame;       ///<! Event for playing the next frame
+    EventId m_eventSendFeedback;    ///<! Event for sending the next feedback
+
+    /// Instrumentation counters, shared with the Rx buffer (if enabled).
+    TRAFFIC_COUNTERS_DECLARE(m_counters)
 
 }; // end of `class NrtvTcpClient`
 
 /**
  * \brief Receive (possibly) fragmented packets from NrtvServer and re-assemble
  *        them to the original video slices they were sent.
+ *
+ * Received packets are kept by reference, i.e., they are not copied into the
+ * buffer. The buffer tracks the boundary of the next video slice as a byte
+ * offset within the first packet, and parses the NRTV header of the next slice
+ * only once, as soon as enough bytes have been received.
+ *
+ * A video slice can be taken out from the buffer in two ways. PopVideoSlice()
+ * re-assembles the slice into a new packet, which is useful when the slice
+ * content is needed. PopVideoSliceHeader() on the other hand simply discards
+ * the bytes of the slice and returns only the parsed header, thus avoiding the
+ * cost of composing a new packet.
+ *
+ * The header of the next video slice is deserialized once, as soon as its
+ * bytes have been received, and kept until the slice is popped. A header which
+ * does not begin a packet is composed into a temporary packet only for this
+ * single read.
+ *
+ * The packet references are kept in a ring, which grows only when it is full,
+ * so a steady flow of packets does not allocate memory. The number of bytes in
+ * the buffer may be bounded by a capacity (see SetCapacity()). The owner is
+ * expected to read from the socket at most GetFreeSpace() bytes at a time, and
+ * to stop reading when IsFull(), leaving the rest of the data to the flow
+ * control of the transport protocol.
  */
 class NrtvTcpClientRxBuffer : public SimpleRefCount<NrtvTcpClientRxBuffer>
 {
   public:
-    /// Create an empty instance of Rx buffer.
-    NrtvTcpClientRxBuffer();
+    /**
+     * \brief Create an empty instance of Rx buffer.
+     * \param capacity the maximum number of bytes in the buffer, or zero for
+     *                 an unbounded buffer
+     */
+    NrtvTcpClientRxBuffer(uint32_t capacity = 0);
+
+    /**
+     * \param capacity the maximum number of bytes in the buffer, or zero for
+     *                 an unbounded buffer; must not be less than the number of
+     *                 bytes currently in the buffer
+     */
+    void SetCapacity(uint32_t capacity);
+
+    /**
+     * \return the maximum number of bytes in the buffer, or zero if unbounded
+     */
+    uint32_t GetCapacity() const;
+
+    /**
+     * \return the number of unconsumed bytes in the buffer
+     */
+    uint32_t GetTotalBytes() const;
+
+    /**
+     * \return the number of bytes which can still be pushed into the buffer, or
+     *         the largest 32-bit integer if the buffer is unbounded
+     */
+    uint32_t GetFreeSpace() const;
+
+    /**
+     * \return true if the buffer is bounded and no more bytes can be pushed
+     */
+    bool IsFull() const;
 
     /**
      * \brief Check if the buffer is empty.
@@ -311,7 +580,8 @@ class NrtvTcpClientRxBuffer : public SimpleRefCount<NrtvTcpClientRxBuffer>
 
     /**
      * \brief Check if the buffer contains at least one complete video slice.
-     *        If at least one slice is found, PopVideoSlice() can be called.
+     *        If at least one slice is found, PopVideoSlice() or
+     *        PopVideoSliceHeader() can be called.
      * \return true if the buffer contains at least a complete video slice.
      */
     bool HasVideoSlice() const;
@@ -321,7 +591,8 @@ class NrtvTcpClientRxBuffer : public SimpleRefCount<NrtvTcpClientRxBuffer>
      * \param packet the packet data to be added
      *
      * \warning If the packet is the first packet of a video slice, it must
-     *          contain an NrtvHeader.
+     *          contain an NrtvHeader. The packet size must not exceed
+     *          GetFreeSpace().
      */
     void PushPacket(Ptr<const Packet> packet);
 
@@ -335,21 +606,82 @@ class NrtvTcpClientRxBuffer : public SimpleRefCount<NrtvTcpClientRxBuffer>
      */
     Ptr<Packet> PopVideoSlice();
 
-  private:
     /**
-     * \param packet the packet to be read
-     * \return the slice size field of the NRTV header embedded in the packet
+     * \brief Remove the next video slice from the buffer without re-assembling
+     *        it into a packet.
+     * \return the NRTV header of the removed video slice
      *
-     * \warning An NRTV header must be found in the beginning of the packet.
+     * \warning As pre-conditions, IsEmpty() must be false and HasVideoSlice()
+     *          must be true before calling this method.
+     */
+    NrtvHeader PopVideoSliceHeader();
+
+#ifdef NS3_TRAFFIC_COUNTERS_ENABLE
+    /**
+     * \param counters the instrumentation counters of the owning client, which
+     *                 receive the Rx buffer high-water mark, the reassembly
+     *                 splits, and the bytes copied into composed packets.
      */
-    static uint32_t PeekSliceSize(Ptr<const Packet> packet);
+    void SetCounters(Ptr<TrafficCounters> counters);
+#endif /* NS3_TRAFFIC_COUNTERS_ENABLE */
+
+  private:
+    /**
+     * \brief Compose a new packet out of the first bytes in the buffer, without
+     *        removing them from the buffer.
+     * \param size the number of bytes to be copied, must not exceed the number
+     *             of bytes in the buffer
+     * \return the resulting packet
+     */
+    Ptr<Packet> PeekBytes(uint32_t size) const;
+
+    /**
+     * \brief Discard the first bytes in the buffer.
+     * \param size the number of bytes to be discarded, must not exceed the
+     *             number of bytes in the buffer
+     */
+    void RemoveBytes(uint32_t size);
+
+    /**
+     * \brief Compose a new packet out of the bytes of the next NRTV header, or
+     *        simply return the first packet if it begins with the whole header.
+     * \return a packet beginning with the next NRTV header
+     */
+    Ptr<const Packet> PeekHeaderBytes() const;
+
+    /**
+     * \brief Deserialize the NRTV header of the next video slice, if it is not
+     *        read yet and the buffer contains enough bytes for doing so.
+     */
+    void ReadNextHeader();
+
+    /**
+     * \param index position of a packet, starting from the first packet
+     * \return the packet at the given position of the ring
+     */
+    const Ptr<const Packet>& GetPacket(uint32_t index) const;
+
+    /// Take out the first packet of the ring.
+    void PopFrontPacket();
 
-    /// The buffer, containing copies of packets received.
-    std::list<Ptr<Packet>> m_rxBuffer;
-    /// Overall size of buffer in bytes (including header).
+    /// Ring of references to the packets received, its size is a power of two.
+    std::vector<Ptr<const Packet>> m_rxBuffer;
+    /// Position of the first packet in #m_rxBuffer.
+    uint32_t m_head;
+    /// Number of packets in #m_rxBuffer.
+    uint32_t m_numOfPackets;
+    /// Maximum number of bytes in the buffer, or zero if unbounded.
+    uint32_t m_capacity;
+    /// Number of bytes of the first packet in the buffer which have been consumed.
+    uint32_t m_frontOffset;
+    /// Overall size of unconsumed bytes in the buffer (including header).
     uint32_t m_totalBytes;
-    /// The expected size of the next video slice (zero if size is not yet known).
-    uint32_t m_sizeOfVideoSlice;
+    /// True if the header of the next video slice has been read.
+    bool m_hasNextHeader;
+    /// The header of the next video slice (valid only if m_hasNextHeader is true).
+    NrtvHeader m_nextHeader;
+    /// Instrumentation counters of the owning client (if enabled).
+    TRAFFIC_COUNTERS_DECLARE(m_counters)
 
 }; // end of `class NrtvTcpClientRxBuffer`
 
@@ -22,18 +22,24 @@
 #include "nrtv-tcp-server.h"
 
 #include <ns3/address-utils.h>
+#include <ns3/enum.h>
 #include <ns3/inet-socket-address.h>
 #include <ns3/inet6-socket-address.h>
 #include <ns3/log.h>
+#include <ns3/nrtv-feedback-header.h>
+#include <ns3/nrtv-variables.h>
 #include <ns3/nrtv-video-worker.h>
 #include <ns3/packet.h>
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 #include <ns3/socket.h>
+#include <ns3/string.h>
 #include <ns3/tcp-socket-factory.h>
 #include <ns3/uinteger.h>
 #include <ns3/unused.h>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("NrtvTcpServer");
 
 namespace ns3
@@ -43,9 +49,16 @@ NS_OBJECT_ENSURE_REGISTERED(NrtvTcpServer);
 
 NrtvTcpServer::NrtvTcpServer()
     : m_state(NOT_STARTED),
-      m_initialSocket(0)
+      m_initialSocket(0),
+      m_numOfAccepted(0),
+      m_checkpointMode(TrafficScheduleLog::DISABLED)
 {
     NS_LOG_FUNCTION(this);
+    m_workerPool.SetTxCallback(MakeCallback(&NrtvTcpServer::NotifyTxSlice, this));
+    m_workerPool.SetVideoCompletedCallback(
+        MakeCallback(&NrtvTcpServer::NotifyVideoCompleted, this));
+    m_workerPool.SetQualitySwitchCallback(
+        MakeCallback(&NrtvTcpServer::NotifyQualitySwitch, this));
 }
 
 TypeId
@@ -66,10 +79,49 @@ NrtvTcpServer::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvTcpServer::m_localPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Variables",
+                          "Random variable collection shared by the video workers through "
+                          "views. If not set, each worker creates its own collection.",
+                          PointerValue(),
+                          MakePointerAccessor(&NrtvTcpServer::m_nrtvVariables),
+                          MakePointerChecker<NrtvVariables>())
+            .AddAttribute("CheckpointMode",
+                          "Whether the progress of the videos is saved into the checkpoint, "
+                          "or restored from it. Must be set before `CheckpointFile`.",
+                          EnumValue(TrafficScheduleLog::DISABLED),
+                          MakeEnumAccessor(&NrtvTcpServer::m_checkpointMode),
+                          MakeEnumChecker(TrafficScheduleLog::DISABLED,
+                                          "DISABLED",
+                                          TrafficScheduleLog::RECORD,
+                                          "SAVE",
+                                          TrafficScheduleLog::REPLAY,
+                                          "RESTORE"))
+            .AddAttribute("CheckpointFile",
+                          "Name of the checkpoint file (see TrafficScheduleLog). Empty means "
+                          "neither saving nor restoring.",
+                          StringValue(""),
+                          MakeStringAccessor(&NrtvTcpServer::SetCheckpointFile,
+                                             &NrtvTcpServer::GetCheckpointFile),
+                          MakeStringChecker())
+            .AddAttribute("CheckpointTime",
+                          "Simulation time when the progress is saved in the SAVE mode.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&NrtvTcpServer::m_checkpointTime),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource("Tx",
                             "A packet has been sent",
                             MakeTraceSourceAccessor(&NrtvTcpServer::m_txTrace),
                             "ns3::Packet::TracedCallback")
+            .AddTraceSource("RxFeedback",
+                            "A feedback report has been received from a client in the "
+                            "adaptive bitrate mode",
+                            MakeTraceSourceAccessor(&NrtvTcpServer::m_rxFeedbackTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("QualitySwitch",
+                            "A video worker has switched its quality level in the adaptive "
+                            "bitrate mode",
+                            MakeTraceSourceAccessor(&NrtvTcpServer::m_qualitySwitchTrace),
+                            "ns3::NrtvTcpServer::QualitySwitchCallback")
             .AddTraceSource("StateTransition",
                             "Trace fired upon every NRTV server state transition",
                             MakeTraceSourceAccessor(&NrtvTcpServer::m_stateTransitionTrace),
@@ -122,6 +174,20 @@ NrtvTcpServer::GetStateString(NrtvTcpServer::State_t state)
     }
 }
 
+void
+NrtvTcpServer::SetCheckpointFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName << m_checkpointMode);
+    m_checkpointFile = fileName;
+    m_checkpoint.Open(fileName, m_checkpointMode);
+}
+
+std::string
+NrtvTcpServer::GetCheckpointFile() const
+{
+    return m_checkpointFile;
+}
+
 void
 NrtvTcpServer::DoDispose()
 {
@@ -132,6 +198,7 @@ NrtvTcpServer::DoDispose()
         StopApplication();
     }
 
+    m_workerPool.Clear();
     Application::DoDispose(); // chain up
 }
 
@@ -142,6 +209,8 @@ NrtvTcpServer::StartApplication()
 
     if (m_state == NOT_STARTED)
     {
+        m_workerPool.SetVariables(m_nrtvVariables);
+
         if (m_initialSocket == nullptr)
         {
             m_initialSocket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
@@ -176,13 +245,27 @@ NrtvTcpServer::StartApplication()
         } // end of `if (m_initialSocket == nullptr)`
 
         NS_ASSERT_MSG(m_initialSocket != nullptr, "Failed creating socket");
-        m_initialSocket->ShutdownRecv();
+        if (!NrtvVideoWorker::IsAbrEnabledByDefault())
+        {
+            // The accepted sockets inherit this, so they would never notify
+            // the feedback of the clients.
+            m_initialSocket->ShutdownRecv();
+        }
         m_initialSocket->SetAcceptCallback(
             MakeCallback(&NrtvTcpServer::ConnectionRequestCallback, this),
             MakeCallback(&NrtvTcpServer::NewConnectionCreatedCallback, this));
         m_initialSocket->SetCloseCallbacks(MakeCallback(&NrtvTcpServer::NormalCloseCallback, this),
                                            MakeCallback(&NrtvTcpServer::ErrorCloseCallback, this));
 
+        if (m_checkpoint.IsRecording())
+        {
+            const Time delay = (m_checkpointTime > Simulator::Now())
+                                   ? m_checkpointTime - Simulator::Now()
+                                   : Seconds(0);
+            m_eventSaveCheckpoint =
+                Simulator::Schedule(delay, &NrtvTcpServer::SaveCheckpoint, this);
+        }
+
         SwitchToState(STARTED);
         for (auto w = m_workers.begin(); w != m_workers.end(); w++)
             w->second->ChangeState(NrtvVideoWorker::READY);
@@ -201,17 +284,20 @@ NrtvTcpServer::StopApplication()
     NS_LOG_FUNCTION(this);
 
     SwitchToState(STOPPED);
+    Simulator::Cancel(m_eventSaveCheckpoint);
 
     // close all accepted sockets
     for (std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::iterator it = m_workers.begin();
          it != m_workers.end();
          ++it)
     {
+        m_workerPool.Release(it->second); // detach the worker before closing
         it->first->Close();
         it->first->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        it->first->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
     }
 
-    // destroy all workers
+    // return all workers to the pool
     m_workers.clear();
 
     // stop listening
@@ -234,10 +320,23 @@ NrtvTcpServer::NewConnectionCreatedCallback(Ptr<Socket> socket, const Address& a
 {
     NS_LOG_FUNCTION(this << socket << address);
 
-    Ptr<NrtvVideoWorker> worker = Create<NrtvVideoWorker>(socket);
-    worker->SetTxCallback(MakeCallback(&NrtvTcpServer::NotifyTxSlice, this));
-    worker->SetVideoCompletedCallback(MakeCallback(&NrtvTcpServer::NotifyVideoCompleted, this));
+    Ptr<NrtvVideoWorker> worker = m_workerPool.Acquire(socket, m_numOfAccepted++);
     m_workers[socket] = worker;
+    socket->SetRecvCallback(MakeCallback(&NrtvTcpServer::ReceivedFeedbackCallback, this));
+
+    if (m_checkpoint.HasValue(CKPT_NUM_OF_FRAMES))
+    {
+        NrtvVideoWorker::Progress_t progress;
+        progress.numOfFrames = m_checkpoint.ReplayInteger(CKPT_NUM_OF_FRAMES);
+        progress.numOfFramesServed = m_checkpoint.ReplayInteger(CKPT_FRAMES_SERVED);
+        progress.numOfSlices =
+            static_cast<uint16_t>(m_checkpoint.ReplayInteger(CKPT_NUM_OF_SLICES));
+        progress.frameInterval = m_checkpoint.ReplayTime(CKPT_FRAME_INTERVAL);
+        progress.traceStartFrame = m_checkpoint.ReplayInteger(CKPT_TRACE_START_FRAME);
+        progress.nextFrameDelay = m_checkpoint.ReplayTime(CKPT_NEXT_FRAME_DELAY);
+        worker->Resume(progress);
+    }
+
     if (GetState() == STARTED)
     {
         worker->ChangeState(NrtvVideoWorker::READY);
@@ -274,6 +373,36 @@ NrtvTcpServer::ErrorCloseCallback(Ptr<Socket> socket)
     }
 }
 
+void
+NrtvTcpServer::ReceivedFeedbackCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    // the feedback has a fixed size, so read it one header at a time
+    const uint32_t size = NrtvFeedbackHeader::GetStaticSerializedSize();
+    while (socket->GetRxAvailable() >= size)
+    {
+        Ptr<Packet> packet = socket->Recv(size, 0);
+        if (packet == nullptr || packet->GetSize() < size)
+        {
+            break;
+        }
+
+        m_rxFeedbackTrace(packet);
+        NrtvFeedbackHeader feedback;
+        packet->RemoveHeader(feedback);
+        NS_LOG_INFO(this << " received feedback " << feedback << " from socket " << socket);
+
+        std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::iterator it = m_workers.find(socket);
+        if (it != m_workers.end())
+        {
+            it->second->ReceiveFeedback(feedback.GetThroughput(),
+                                        feedback.GetBufferLevel(),
+                                        feedback.GetStallCount());
+        }
+    }
+}
+
 void
 NrtvTcpServer::NotifyTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet)
 {
@@ -283,17 +412,66 @@ NrtvTcpServer::NotifyTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet)
 }
 
 void
-NrtvTcpServer::NotifyVideoCompleted(Ptr<Socket> socket)
+NrtvTcpServer::NotifyVideoCompleted(Ptr<Socket> socket, uint32_t handle)
 {
-    NS_LOG_FUNCTION(this << socket);
+    NS_LOG_FUNCTION(this << socket << handle);
 
     // remove the worker entry
     std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::iterator it = m_workers.find(socket);
     NS_ASSERT(it != m_workers.end());
-    m_workers.erase(it); // This will destroy the worker
-    socket->Close();     // Close the socket, client app will request reconnection
+    Ptr<NrtvVideoWorker> worker = it->second;
+    m_workers.erase(it);
+    m_workerPool.Release(worker); // keep the worker for the next connection
+    socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    socket->Close();              // Close the socket, client app will request reconnection
 }
 
+void
+NrtvTcpServer::NotifyQualitySwitch(Ptr<Socket> socket, uint32_t oldLevel, uint32_t newLevel)
+{
+    NS_LOG_FUNCTION(this << socket << oldLevel << newLevel);
+    m_qualitySwitchTrace(oldLevel, newLevel);
+}
+
+void
+NrtvTcpServer::SaveCheckpoint()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Sorted by handle, i.e., in the order the connections were accepted.
+    std::vector<std::pair<uint32_t, NrtvVideoWorker::Progress_t>> videos;
+    for (std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::const_iterator it = m_workers.begin();
+         it != m_workers.end();
+         ++it)
+    {
+        NrtvVideoWorker::Progress_t progress;
+        if (it->second->GetProgress(progress))
+        {
+            videos.push_back(std::make_pair(it->second->GetHandle(), progress));
+        }
+    }
+    std::sort(videos.begin(),
+              videos.end(),
+              [](const std::pair<uint32_t, NrtvVideoWorker::Progress_t>& a,
+                 const std::pair<uint32_t, NrtvVideoWorker::Progress_t>& b) {
+                  return a.first < b.first;
+              });
+
+    for (uint32_t i = 0; i < videos.size(); i++)
+    {
+        const NrtvVideoWorker::Progress_t& progress = videos[i].second;
+        m_checkpoint.Record(CKPT_NUM_OF_FRAMES, progress.numOfFrames);
+        m_checkpoint.Record(CKPT_FRAMES_SERVED, progress.numOfFramesServed);
+        m_checkpoint.Record(CKPT_NUM_OF_SLICES, static_cast<uint32_t>(progress.numOfSlices));
+        m_checkpoint.Record(CKPT_FRAME_INTERVAL, progress.frameInterval);
+        m_checkpoint.Record(CKPT_TRACE_START_FRAME, progress.traceStartFrame);
+        m_checkpoint.Record(CKPT_NEXT_FRAME_DELAY, progress.nextFrameDelay);
+    }
+
+    NS_LOG_INFO(this << " saved a checkpoint of " << videos.size() << " videos in progress");
+
+} // end of `void SaveCheckpoint ()`
+
 void
 NrtvTcpServer::SwitchToState(NrtvTcpServer::State_t state)
 {
@@ -24,9 +24,13 @@
 
 #include <ns3/address.h>
 #include <ns3/application.h>
+#include <ns3/event-id.h>
 #include <ns3/nstime.h>
 #include <ns3/traced-callback.h>
 
+#include <ns3/nrtv-video-worker.h>
+#include <ns3/traffic-schedule-log.h>
+
 #include <map>
 
 namespace ns3
@@ -34,7 +38,6 @@ namespace ns3
 
 class Socket;
 class NrtvVariables;
-class NrtvVideoWorker;
 
 /**
  * \ingroup nrtv
@@ -50,6 +53,21 @@ class NrtvVideoWorker;
  *
  * The application maintains several workers (NrtvTcpServerVideoWorker). Each
  * worker is responsible for sending a single video for a single client.
+ *
+ * If the clients send feedback (see the `AbrFeedbackInterval` attribute of
+ * NrtvTcpClient), the feedback is passed to the worker of the client, which
+ * adapts the bitrate of the video if the `AbrQualityLevels` attribute of
+ * NrtvVideoWorker is set. The `RxFeedback` trace source reports every
+ * feedback received, and the `QualitySwitch` trace source every switch of the
+ * quality level. The listening socket only accepts incoming data if the
+ * default value of `AbrQualityLevels` has more than one level when the
+ * application starts, since the accepted sockets inherit its setting.
+ *
+ * The progress of the videos being sent can be saved into a checkpoint and
+ * restored in later runs (see SetCheckpointFile()). Upon restoring, the
+ * connections accepted first continue the saved videos in the order their
+ * connections were accepted in the saving run, from the frame following the
+ * one in progress.
  */
 class NrtvTcpServer : public Application
 {
@@ -101,6 +119,29 @@ class NrtvTcpServer : public Application
      */
     static std::string GetStateString(State_t state);
 
+    /**
+     * \param fileName name of the checkpoint file, or an empty string to
+     *                 neither save nor restore a checkpoint
+     *
+     * The checkpoint is opened in the mode given by the `CheckpointMode`
+     * attribute, so the mode must be set first. Each server becomes a new
+     * owner of the checkpoint (see TrafficScheduleLog), so the servers must be
+     * created in the same order when saving and when restoring.
+     */
+    void SetCheckpointFile(std::string fileName);
+
+    /**
+     * \return name of the checkpoint file, or an empty string if none
+     */
+    std::string GetCheckpointFile() const;
+
+    /**
+     * \brief Callback signature for `QualitySwitch` trace source.
+     * \param oldLevel the index of the previous quality level
+     * \param newLevel the index of the new quality level
+     */
+    typedef void (*QualitySwitchCallback)(uint32_t oldLevel, uint32_t newLevel);
+
   protected:
     // Inherited from Object base class
     virtual void DoDispose();
@@ -117,28 +158,66 @@ class NrtvTcpServer : public Application
     void NormalCloseCallback(Ptr<Socket> socket);
     void ErrorCloseCallback(Ptr<Socket> socket);
 
+    /// Invoked when feedback arrives from a client through an accepted socket.
+    void ReceivedFeedbackCallback(Ptr<Socket> socket);
+
     /// Invoked by NrtvVideoWorker instance after transmitting a video slice.
     void NotifyTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet);
 
     /// Invoked by NrtvVideoWorker instance after completed a video.
-    void NotifyVideoCompleted(Ptr<Socket> socket);
+    void NotifyVideoCompleted(Ptr<Socket> socket, uint32_t handle);
+
+    /// Invoked by NrtvVideoWorker instance after switching the quality level.
+    void NotifyQualitySwitch(Ptr<Socket> socket, uint32_t oldLevel, uint32_t newLevel);
 
     void SwitchToState(State_t state);
 
+    /// Variables of the checkpoint, each of them stored as a separate channel.
+    enum CheckpointVariable_t
+    {
+        CKPT_NUM_OF_FRAMES = 0, ///< See NrtvVideoWorker::Progress_t.
+        CKPT_FRAMES_SERVED,     ///< See NrtvVideoWorker::Progress_t.
+        CKPT_NUM_OF_SLICES,     ///< See NrtvVideoWorker::Progress_t.
+        CKPT_FRAME_INTERVAL,    ///< See NrtvVideoWorker::Progress_t.
+        CKPT_TRACE_START_FRAME, ///< See NrtvVideoWorker::Progress_t.
+        CKPT_NEXT_FRAME_DELAY   ///< See NrtvVideoWorker::Progress_t.
+    };
+
+    /// Write the progress of the videos being sent into #m_checkpoint.
+    void SaveCheckpoint();
+
     State_t m_state;
     Ptr<Socket> m_initialSocket;
 
     /// Keeping all the active workers.
     std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>> m_workers;
 
+    /// Idle workers, reused for the next connections.
+    NrtvVideoWorkerPool m_workerPool;
+
+    /// Number of connections accepted so far, also the handle of the next worker.
+    uint32_t m_numOfAccepted;
+
+    /// Membership in the checkpoint, closed unless `CheckpointFile` is set.
+    TrafficScheduleLogHandle m_checkpoint;
+
+    /// An event of SaveCheckpoint(), scheduled upon start in the `SAVE` mode.
+    EventId m_eventSaveCheckpoint;
+
     // ATTRIBUTES
 
     Address m_localAddress;
     uint16_t m_localPort;
+    Ptr<NrtvVariables> m_nrtvVariables;          ///< Given to the workers, may be null.
+    TrafficScheduleLog::Mode_t m_checkpointMode; ///< `CheckpointMode` attribute.
+    std::string m_checkpointFile;                ///< `CheckpointFile` attribute.
+    Time m_checkpointTime;                       ///< `CheckpointTime` attribute.
 
     // TRACE SOURCES
 
     TracedCallback<Ptr<const Packet>> m_txTrace;
+    TracedCallback<Ptr<const Packet>> m_rxFeedbackTrace;
+    TracedCallback<uint32_t, uint32_t> m_qualitySwitchTrace;
     TracedCallback<std::string, std::string> m_stateTransitionTrace;
 
 }; // end of `class NrtvTcpServer`
@@ -0,0 +1,462 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nrtv-udp-client.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/nrtv-header.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/socket.h>
+#include <ns3/udp-socket-factory.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("NrtvUdpClient");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(NrtvUdpClient);
+
+NrtvUdpClient::NrtvUdpClient()
+    : m_socket(0),
+      m_totalRx(0),
+      m_hasLatest(false),
+      m_latestFrame(0),
+      m_latestSlice(0),
+      m_firstFrame(0),
+      m_numOfReceivedSlices(0),
+      m_numOfLostSlices(0),
+      m_numOfReorderedSlices(0),
+      m_numOfDuplicateSlices(0),
+      m_numOfLateSlices(0),
+      m_numOfCompleteFrames(0),
+      m_numOfIncompleteFrames(0),
+      m_numOfLostFrames(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+NrtvUdpClient::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrtvUdpClient")
+            .SetParent<Application>()
+            .AddConstructor<NrtvUdpClient>()
+            .AddAttribute("Local",
+                          "The address on which to bind the listening socket",
+                          AddressValue(),
+                          MakeAddressAccessor(&NrtvUdpClient::m_local),
+                          MakeAddressChecker())
+            .AddAttribute("WindowSize",
+                          "Number of the most recent frames tracked for lost, duplicate, and "
+                          "reordered slices",
+                          UintegerValue(32),
+                          MakeUintegerAccessor(&NrtvUdpClient::m_windowSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxSlicesPerFrame",
+                          "Number of bits in the bitmap of received slices of each frame. "
+                          "Must not be less than the number of slices in any frame.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&NrtvUdpClient::m_maxSlicesPerFrame),
+                          MakeUintegerChecker<uint32_t>(1, 65535))
+            .AddTraceSource("Rx",
+                            "A packet has been received",
+                            MakeTraceSourceAccessor(&NrtvUdpClient::m_rxTrace),
+                            "ns3::Packet::PacketAddressTracedCallback")
+            .AddTraceSource("RxDelay",
+                            "Received a slice with delay information",
+                            MakeTraceSourceAccessor(&NrtvUdpClient::m_rxDelayTrace),
+                            "ns3::ApplicationDelayProbe::PacketDelayAddressCallback")
+            .AddTraceSource("RxFrame",
+                            "Received a whole frame",
+                            MakeTraceSourceAccessor(&NrtvUdpClient::m_rxFrameTrace),
+                            "ns3::NrtvTcpClient::RxFrameCallback")
+            .AddTraceSource("RxFrameDelay",
+                            "Received a whole frame, with the delay since the earliest "
+                            "timestamp of its slices",
+                            MakeTraceSourceAccessor(&NrtvUdpClient::m_rxFrameDelayTrace),
+                            "ns3::ApplicationDelayProbe::PacketDelayAddressCallback")
+            .AddTraceSource("SliceLoss",
+                            "A frame has slid out of the window with some of its slices lost",
+                            MakeTraceSourceAccessor(&NrtvUdpClient::m_sliceLossTrace),
+                            "ns3::NrtvUdpClient::SliceLossCallback");
+    return tid;
+}
+
+uint64_t
+NrtvUdpClient::GetTotalRx() const
+{
+    return m_totalRx;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfReceivedSlices() const
+{
+    return m_numOfReceivedSlices;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfLostSlices() const
+{
+    return m_numOfLostSlices;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfReorderedSlices() const
+{
+    return m_numOfReorderedSlices;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfDuplicateSlices() const
+{
+    return m_numOfDuplicateSlices;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfLateSlices() const
+{
+    return m_numOfLateSlices;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfCompleteFrames() const
+{
+    return m_numOfCompleteFrames;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfIncompleteFrames() const
+{
+    return m_numOfIncompleteFrames;
+}
+
+uint64_t
+NrtvUdpClient::GetNumOfLostFrames() const
+{
+    return m_numOfLostFrames;
+}
+
+void
+NrtvUdpClient::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_socket = nullptr;
+    Application::DoDispose(); // chain up
+}
+
+void
+NrtvUdpClient::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_window.empty())
+    {
+        const uint32_t numOfBits = m_windowSize * m_maxSlicesPerFrame;
+        m_window.resize(m_windowSize);
+        m_bitmap.assign((numOfBits + 63) / 64, 0);
+        for (uint32_t i = 0; i < m_windowSize; i++)
+        {
+            m_window[i].isUsed = false;
+        }
+    }
+
+    if (m_socket == nullptr)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        if (m_socket->Bind(m_local) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+    }
+
+    m_socket->SetRecvCallback(MakeCallback(&NrtvUdpClient::ReceivedDataCallback, this));
+}
+
+void
+NrtvUdpClient::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_socket != nullptr)
+    {
+        m_socket->Close();
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+}
+
+void
+NrtvUdpClient::ReceivedDataCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    Ptr<Packet> packet;
+    Address from;
+
+    while ((packet = socket->RecvFrom(from)))
+    {
+        if (packet->GetSize() == 0)
+        {
+            break; // EOF
+        }
+
+        m_totalRx += packet->GetSize();
+        m_rxTrace(packet, from);
+        ReceiveVideoSlice(packet, from);
+    }
+}
+
+void
+NrtvUdpClient::ReceiveVideoSlice(Ptr<const Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << packet << from);
+
+    if (packet->GetSize() < NrtvHeader::GetStaticSerializedSize())
+    {
+        NS_LOG_WARN(this << " received a packet too small for an NRTV header");
+        return;
+    }
+
+    NrtvHeader nrtvHeader;
+    packet->PeekHeader(nrtvHeader);
+    const uint32_t frameNumber = nrtvHeader.GetFrameNumber();
+    const uint32_t numOfFrames = nrtvHeader.GetNumOfFrames();
+    const uint16_t sliceNumber = nrtvHeader.GetSliceNumber();
+    const uint16_t numOfSlices = nrtvHeader.GetNumOfSlices();
+    const Time arrivalTime = nrtvHeader.GetArrivalTime();
+
+    const Time delay = Simulator::Now() - arrivalTime;
+    NS_LOG_INFO(this << " received a video slice for frame " << frameNumber << " and slice "
+                     << sliceNumber << " (delay= " << delay.GetSeconds() << ")");
+    m_rxDelayTrace(delay, from);
+
+    if (sliceNumber == 0 || sliceNumber > numOfSlices)
+    {
+        NS_LOG_WARN(this << " invalid slice number " << sliceNumber << " of " << numOfSlices);
+        return;
+    }
+
+    NS_ABORT_MSG_IF(numOfSlices > m_maxSlicesPerFrame,
+                    "Frame " << frameNumber << " has " << numOfSlices << " slices,"
+                             << " which is more than MaxSlicesPerFrame=" << m_maxSlicesPerFrame);
+
+    bool isBehind =
+        m_hasLatest && (frameNumber < m_latestFrame ||
+                        (frameNumber == m_latestFrame && sliceNumber < m_latestSlice));
+
+    if (isBehind && arrivalTime > m_latestArrivalTime)
+    {
+        // the position goes backwards while the time goes forwards
+        NS_LOG_INFO(this << " a new video has begun");
+        FlushWindow();
+        isBehind = false;
+    }
+
+    if (!m_hasLatest)
+    {
+        m_hasLatest = true;
+        m_latestFrame = frameNumber;
+        m_firstFrame = frameNumber;
+    }
+    else if (frameNumber > m_latestFrame)
+    {
+        AdvanceWindow(frameNumber);
+    }
+    else if (static_cast<uint64_t>(frameNumber) + m_windowSize <= m_latestFrame)
+    {
+        NS_LOG_LOGIC(this << " frame " << frameNumber << " has already left the window");
+        m_numOfLateSlices++;
+        return;
+    }
+
+    m_firstFrame = std::min(m_firstFrame, frameNumber);
+
+    const uint32_t slot = GetSlot(frameNumber);
+    FrameSlot_t& frame = m_window[slot];
+    if (!frame.isUsed || frame.frameNumber != frameNumber)
+    {
+        NS_ASSERT(!frame.isUsed);
+        frame.isUsed = true;
+        frame.frameNumber = frameNumber;
+        frame.numOfSlices = numOfSlices;
+        frame.numOfReceived = 0;
+        frame.lastSlice = 0;
+        frame.firstArrivalTime = arrivalTime;
+        for (uint32_t i = 0; i < m_maxSlicesPerFrame; i++)
+        {
+            const uint32_t bit = slot * m_maxSlicesPerFrame + i;
+            m_bitmap[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+        }
+    }
+
+    const uint32_t bit = slot * m_maxSlicesPerFrame + sliceNumber - 1;
+    uint64_t& word = m_bitmap[bit / 64];
+    const uint64_t mask = uint64_t(1) << (bit % 64);
+    if (word & mask)
+    {
+        NS_LOG_LOGIC(this << " duplicate of slice " << sliceNumber << " of frame "
+                          << frameNumber);
+        m_numOfDuplicateSlices++;
+        return;
+    }
+    word |= mask;
+
+    if (isBehind)
+    {
+        m_numOfReorderedSlices++;
+    }
+    else
+    {
+        m_latestSlice = sliceNumber;
+        m_latestArrivalTime = arrivalTime;
+    }
+
+    m_numOfReceivedSlices++;
+    frame.numOfReceived++;
+    frame.lastSlice = std::max(frame.lastSlice, sliceNumber);
+    frame.firstArrivalTime = std::min(frame.firstArrivalTime, arrivalTime);
+
+    if (frame.numOfReceived == frame.numOfSlices)
+    {
+        m_numOfCompleteFrames++;
+        m_rxFrameTrace(frameNumber, numOfFrames);
+        m_rxFrameDelayTrace(Simulator::Now() - frame.firstArrivalTime, from);
+    }
+
+} // end of `void ReceiveVideoSlice (Ptr<const Packet>, const Address &)`
+
+void
+NrtvUdpClient::AdvanceWindow(uint32_t frameNumber)
+{
+    NS_LOG_FUNCTION(this << m_latestFrame << frameNumber);
+    NS_ASSERT(m_hasLatest && frameNumber > m_latestFrame);
+
+    // the frames from the oldest one in the window until (frameNumber - m_windowSize)
+    const uint64_t oldest = std::max<uint64_t>(
+        m_firstFrame,
+        (m_latestFrame + 1 > m_windowSize) ? (m_latestFrame + 1 - m_windowSize) : 0);
+    const uint64_t newest = static_cast<uint64_t>(frameNumber);
+
+    if (oldest + m_windowSize <= newest)
+    {
+        const uint64_t last = newest - m_windowSize; // the last frame leaving the window
+        const uint64_t numOfLeaving = last - oldest + 1;
+        uint64_t numOfRetired = 0;
+
+        if (numOfLeaving >= m_windowSize)
+        {
+            for (uint32_t slot = 0; slot < m_windowSize; slot++)
+            {
+                if (m_window[slot].isUsed && m_window[slot].frameNumber <= last)
+                {
+                    RetireFrame(slot);
+                    numOfRetired++;
+                }
+            }
+        }
+        else
+        {
+            for (uint64_t f = oldest; f <= last; f++)
+            {
+                const uint32_t slot = GetSlot(f);
+                if (m_window[slot].isUsed && m_window[slot].frameNumber == f)
+                {
+                    RetireFrame(slot);
+                    numOfRetired++;
+                }
+            }
+        }
+
+        // the rest have never been seen
+        m_numOfLostFrames += numOfLeaving - numOfRetired;
+    }
+
+    m_latestFrame = frameNumber;
+
+} // end of `void AdvanceWindow (uint32_t)`
+
+void
+NrtvUdpClient::FlushWindow()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_hasLatest)
+    {
+        return;
+    }
+
+    const uint64_t oldest = std::max<uint64_t>(
+        m_firstFrame,
+        (m_latestFrame + 1 > m_windowSize) ? (m_latestFrame + 1 - m_windowSize) : 0);
+    const uint64_t numOfFrames = m_latestFrame - oldest + 1;
+    uint64_t numOfRetired = 0;
+
+    for (uint32_t slot = 0; slot < m_windowSize; slot++)
+    {
+        if (m_window[slot].isUsed)
+        {
+            RetireFrame(slot);
+            numOfRetired++;
+        }
+    }
+
+    NS_ASSERT(numOfRetired <= numOfFrames);
+    m_numOfLostFrames += numOfFrames - numOfRetired;
+    m_hasLatest = false;
+}
+
+void
+NrtvUdpClient::RetireFrame(uint32_t slot)
+{
+    FrameSlot_t& frame = m_window[slot];
+    NS_ASSERT(frame.isUsed);
+
+    // only the gaps below the last slice received are known to be lost
+    const uint32_t numOfLostSlices = frame.lastSlice - frame.numOfReceived;
+    NS_LOG_LOGIC(this << " frame " << frame.frameNumber << " leaves the window with "
+                      << frame.numOfReceived << " of " << frame.numOfSlices << " slices, "
+                      << numOfLostSlices << " lost");
+
+    if (numOfLostSlices > 0)
+    {
+        m_numOfLostSlices += numOfLostSlices;
+        m_sliceLossTrace(frame.frameNumber, numOfLostSlices);
+    }
+
+    if (frame.numOfReceived < frame.numOfSlices)
+    {
+        m_numOfIncompleteFrames++;
+    }
+
+    frame.isUsed = false;
+}
+
+uint32_t
+NrtvUdpClient::GetSlot(uint32_t frameNumber) const
+{
+    return frameNumber % m_windowSize;
+}
+
+} // namespace ns3
@@ -0,0 +1,239 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NRTV_UDP_CLIENT_H
+#define NRTV_UDP_CLIENT_H
+
+#include <ns3/address.h>
+#include <ns3/application.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/traced-callback.h>
+
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+class Socket;
+
+/**
+ * \ingroup nrtv
+ * \brief Model application which simulates the traffic of a client of a Near
+ *        Real-Time Video (NRTV) service over UDP, i.e., the receiver of the
+ *        packets sent by NrtvUdpServer.
+ *
+ * The application listens to a UDP port and parses the NrtvHeader of every
+ * received packet, each of them carrying one video slice. Unlike TCP, UDP may
+ * lose, duplicate, and reorder the slices, which is tracked within a sliding
+ * window over the most recent frames of the video:
+ * - a slice is *reordered* if it arrives after a slice positioned later in
+ *   the video, i.e., of a later frame, or a later slice of the same frame;
+ * - a slice is a *duplicate* if the same slice has already been received;
+ * - a slice is *late* if its frame has already slid out of the window;
+ * - a frame is *complete* once all its slices have been received, at which
+ *   point the `RxFrame` and `RxFrameDelay` trace sources are fired; and
+ * - when a frame slides out of the window, the slices missing below the last
+ *   slice received of the frame are counted as *lost*. A frame of which no
+ *   slice has ever been received is counted as a lost frame.
+ *
+ * The window is a ring of `WindowSize` frames, with a bitmap of
+ * `MaxSlicesPerFrame` bits for each frame, so the memory used by the client
+ * is fixed regardless of the length of the video or the number of slices
+ * received. A new video is detected when the position within the video goes
+ * backwards while the timestamp of the slice goes forwards, in which case the
+ * frames of the previous video are flushed out of the window.
+ *
+ * NrtvVideoWorker skips the last slices of a frame if their encoding does not
+ * fit into the frame interval. The client cannot tell such slices apart from
+ * the ones lost at the end of a frame, so neither are counted as lost, but the
+ * frame is never complete.
+ */
+class NrtvUdpClient : public Application
+{
+  public:
+    /// Creates a new instance of NRTV UDP client application.
+    NrtvUdpClient();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * \return the total number of bytes received from the socket so far,
+     *         i.e., the sum of the sizes of the packets passed to the `Rx`
+     *         trace source
+     */
+    uint64_t GetTotalRx() const;
+
+    /**
+     * \return the number of distinct video slices received so far
+     */
+    uint64_t GetNumOfReceivedSlices() const;
+
+    /**
+     * \return the number of video slices counted as lost so far
+     */
+    uint64_t GetNumOfLostSlices() const;
+
+    /**
+     * \return the number of video slices received out of order so far
+     */
+    uint64_t GetNumOfReorderedSlices() const;
+
+    /**
+     * \return the number of duplicate video slices received so far
+     */
+    uint64_t GetNumOfDuplicateSlices() const;
+
+    /**
+     * \return the number of video slices received after their frame has slid
+     *         out of the window
+     */
+    uint64_t GetNumOfLateSlices() const;
+
+    /**
+     * \return the number of frames of which all the slices have been received
+     */
+    uint64_t GetNumOfCompleteFrames() const;
+
+    /**
+     * \return the number of frames which have slid out of the window before
+     *         being complete, not including the lost frames
+     */
+    uint64_t GetNumOfIncompleteFrames() const;
+
+    /**
+     * \return the number of frames of which no slice has been received
+     */
+    uint64_t GetNumOfLostFrames() const;
+
+    /**
+     * \brief Callback signature for `SliceLoss` trace source.
+     * \param frameNumber the number of the frame within the video.
+     * \param numOfLostSlices the number of slices of the frame counted as lost.
+     */
+    typedef void (*SliceLossCallback)(uint32_t frameNumber, uint32_t numOfLostSlices);
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+    // Inherited from Application base class
+    virtual void StartApplication();
+    virtual void StopApplication();
+
+  private:
+    /// The record of a frame within the window.
+    struct FrameSlot_t
+    {
+        bool isUsed;            ///< False if the slot is empty.
+        uint32_t frameNumber;   ///< Number of the frame within the video.
+        uint16_t numOfSlices;   ///< Number of slices in the frame.
+        uint16_t numOfReceived; ///< Number of distinct slices received.
+        uint16_t lastSlice;     ///< The highest slice number received.
+        Time firstArrivalTime;  ///< The earliest timestamp of the slices received.
+    };
+
+    /**
+     * Invoked when a packet is received by the socket.
+     * \param socket the listening socket
+     */
+    void ReceivedDataCallback(Ptr<Socket> socket);
+
+    /**
+     * \brief Track a received video slice.
+     * \param packet the packet carrying the slice, beginning with its NRTV
+     *               header
+     * \param from the address of the sender
+     */
+    void ReceiveVideoSlice(Ptr<const Packet> packet, const Address& from);
+
+    /**
+     * \brief Slide the window forward so that the given frame becomes the
+     *        latest frame in the window, retiring the frames sliding out.
+     * \param frameNumber the new latest frame
+     */
+    void AdvanceWindow(uint32_t frameNumber);
+
+    /**
+     * \brief Retire all the frames in the window, e.g., when a new video
+     *        begins, and make the window empty.
+     */
+    void FlushWindow();
+
+    /**
+     * \brief Account the lost slices of a frame sliding out of the window and
+     *        make its slot empty.
+     * \param slot index of the frame in #m_window
+     */
+    void RetireFrame(uint32_t slot);
+
+    /**
+     * \param frameNumber the number of a frame within the video
+     * \return the index of the frame in #m_window
+     */
+    uint32_t GetSlot(uint32_t frameNumber) const;
+
+    Ptr<Socket> m_socket; ///< The listening socket.
+    uint64_t m_totalRx;   ///< Number of bytes received so far.
+
+    /// Ring of records of the frames in the window.
+    std::vector<FrameSlot_t> m_window;
+    /// Bitmap of the received slices, #m_maxSlicesPerFrame bits per slot.
+    std::vector<uint64_t> m_bitmap;
+    /// True if at least one slice of the current video has been received.
+    bool m_hasLatest;
+    /// Frame number of the latest slice received in the current video.
+    uint32_t m_latestFrame;
+    /// Slice number of the latest slice received in the current video.
+    uint16_t m_latestSlice;
+    /// Timestamp of the latest slice received in the current video.
+    Time m_latestArrivalTime;
+    /// The earliest frame number received in the current video.
+    uint32_t m_firstFrame;
+
+    uint64_t m_numOfReceivedSlices;   ///< Number of distinct slices received.
+    uint64_t m_numOfLostSlices;       ///< Number of slices counted as lost.
+    uint64_t m_numOfReorderedSlices;  ///< Number of slices received out of order.
+    uint64_t m_numOfDuplicateSlices;  ///< Number of duplicate slices received.
+    uint64_t m_numOfLateSlices;       ///< Number of slices received out of the window.
+    uint64_t m_numOfCompleteFrames;   ///< Number of frames received completely.
+    uint64_t m_numOfIncompleteFrames; ///< Number of frames retired before complete.
+    uint64_t m_numOfLostFrames;       ///< Number of frames without any slices received.
+
+    // ATTRIBUTES
+
+    Address m_local;              ///< `Local` attribute.
+    uint32_t m_windowSize;        ///< `WindowSize` attribute.
+    uint32_t m_maxSlicesPerFrame; ///< `MaxSlicesPerFrame` attribute.
+
+    // TRACE SOURCES
+
+    TracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
+    TracedCallback<const Time&, const Address&> m_rxDelayTrace;
+    TracedCallback<uint32_t, uint32_t> m_rxFrameTrace;
+    TracedCallback<const Time&, const Address&> m_rxFrameDelayTrace;
+    TracedCallback<uint32_t, uint32_t> m_sliceLossTrace;
+
+}; // end of `class NrtvUdpClient`
+
+} // namespace ns3
+
+#endif /* NRTV_UDP_CLIENT_H */
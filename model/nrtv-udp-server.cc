@@ -49,10 +49,14 @@ NS_OBJECT_ENSURE_REGISTERED(NrtvUdpServer);
 
 NrtvUdpServer::NrtvUdpServer()
     : m_state(NOT_STARTED),
-      m_remotePort(0)
+      m_remotePort(0),
+      m_sharedStream(false)
 {
     NS_LOG_FUNCTION(this);
     m_nrtvVariables = CreateObject<NrtvVariables>();
+    m_workerPool.SetTxCallback(MakeCallback(&NrtvUdpServer::NotifyTxSlice, this));
+    m_workerPool.SetVideoCompletedCallback(
+        MakeCallback(&NrtvUdpServer::NotifyVideoCompleted, this));
 }
 
 TypeId
@@ -72,6 +76,13 @@ NrtvUdpServer::GetTypeId()
                           UintegerValue(1935), // the default port for Adobe Flash video
                           MakeUintegerAccessor(&NrtvUdpServer::m_remotePort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("SharedStream",
+                          "If true, a single video stream is generated and every "
+                          "video slice is sent to all the clients, instead of "
+                          "generating a separate stream for each client.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrtvUdpServer::m_sharedStream),
+                          MakeBooleanChecker())
             .AddTraceSource("Tx",
                             "A packet has been sent",
                             MakeTraceSourceAccessor(&NrtvUdpServer::m_txTrace),
@@ -132,6 +143,7 @@ NrtvUdpServer::DoDispose()
         StopApplication();
     }
 
+    m_workerPool.Clear();
     Application::DoDispose(); // chain up
 }
 
@@ -142,15 +154,34 @@ NrtvUdpServer::StartApplication()
 
     if (m_state == NOT_STARTED)
     {
+        // The workers use their own collections unless views are meant to be shared.
+        if (m_nrtvVariables->GetViewSubstreams())
+        {
+            m_workerPool.SetVariables(m_nrtvVariables);
+        }
+
         SwitchToState(STARTED);
         NS_LOG_INFO(this << " NRTV UDP server was started - "
                          << " Starting workers...");
 
-        for (auto w = m_workers.begin(); w != m_workers.end(); w++)
+        for (std::vector<ClientRecord_t>::iterator it = m_clients.begin();
+             it != m_clients.end();
+             ++it)
+        {
+            if (it->worker != nullptr)
+            {
+                Simulator::Schedule(m_nrtvVariables->GetConnectionOpenDelay(),
+                                    &NrtvVideoWorker::ChangeState,
+                                    it->worker,
+                                    NrtvVideoWorker::READY);
+            }
+        }
+
+        if (m_sharedWorker != nullptr)
         {
             Simulator::Schedule(m_nrtvVariables->GetConnectionOpenDelay(),
                                 &NrtvVideoWorker::ChangeState,
-                                w->second,
+                                m_sharedWorker,
                                 NrtvVideoWorker::READY);
         }
     }
@@ -174,37 +205,80 @@ NrtvUdpServer::StopApplication()
 
     SwitchToState(STOPPED);
 
-    // close all accepted sockets
-    for (std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>>::iterator it = m_workers.begin();
-         it != m_workers.end();
+    // close all sockets with an active worker, and clear the workers
+    for (std::vector<ClientRecord_t>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        if (it->worker != nullptr)
+        {
+            m_workerPool.Release(it->worker); // detach the worker before closing
+            it->worker = nullptr;
+            it->socket->Close();
+            it->socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        }
+    }
+
+    // the same for the shared stream and its subscribers
+    if (m_sharedWorker != nullptr)
+    {
+        m_workerPool.Release(m_sharedWorker);
+        m_sharedWorker = nullptr;
+    }
+    Simulator::Cancel(m_sharedVideoEvent);
+    for (std::vector<uint32_t>::const_iterator it = m_subscribers.begin();
+         it != m_subscribers.end();
          ++it)
     {
-        it->first->Close();
-        it->first->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        m_clients[*it].socket->Close();
+        m_clients[*it].socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     }
-    // Clear video workers
-    m_workers.clear();
+    m_subscribers.clear();
 }
 
 void
 NrtvUdpServer::NotifyTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet)
 {
     NS_LOG_FUNCTION(this << socket << packet << packet->GetSize());
+
+    if (socket == nullptr)
+    {
+        // a slice of the shared stream, to be sent to every subscriber
+        for (std::vector<uint32_t>::const_iterator it = m_subscribers.begin();
+             it != m_subscribers.end();
+             ++it)
+        {
+            m_clients[*it].socket->Send(packet->Copy());
+            m_txTrace(packet);
+        }
+        NS_LOG_INFO("NrtvUdpServer sent " << packet->GetSize() << " bytes to "
+                                          << m_subscribers.size() << " clients.");
+        return;
+    }
+
     NS_LOG_INFO("NrtvUdpServer sent " << packet->GetSize() << " bytes.");
     m_txTrace(packet);
 }
 
 void
-NrtvUdpServer::NotifyVideoCompleted(Ptr<Socket> socket)
+NrtvUdpServer::NotifyVideoCompleted(Ptr<Socket> socket, uint32_t slot)
 {
-    NS_LOG_FUNCTION(this << socket);
+    NS_LOG_FUNCTION(this << socket << slot);
+
+    if (slot == SHARED_STREAM_HANDLE)
+    {
+        NotifySharedVideoCompleted();
+        return;
+    }
+
+    NS_ASSERT(slot < m_clients.size());
 
-    auto it = m_workers.find(socket);
-    NS_ASSERT(it != m_workers.end());
-    m_workers.erase(it); // this will destroy the worker
-    videosLeft[socket]--;
+    ClientRecord_t& client = m_clients[slot];
+    NS_ASSERT(client.socket == socket);
+    NS_ASSERT(client.worker != nullptr);
+    m_workerPool.Release(client.worker); // keep the worker for the next video
+    client.worker = nullptr;
+    client.videosLeft--;
 
-    if (videosLeft[socket] == 0)
+    if (client.videosLeft == 0)
     {
         socket->Close();
         NS_LOG_LOGIC(this << " a video has just completed. "
@@ -215,7 +289,7 @@ NrtvUdpServer::NotifyVideoCompleted(Ptr<Socket> socket)
 
     // Socket was not closed, so we will re-use it for the next video.
     // This has to be done since there is no connection between UDP
-    // client and server, and client (PacketSink) does not have
+    // client and server, and client (NrtvUdpClient) does not have
     // capability to request a new video.
 
     // Wait until the next video.
@@ -223,7 +297,7 @@ NrtvUdpServer::NotifyVideoCompleted(Ptr<Socket> socket)
     NS_LOG_LOGIC(this << " a video has just completed, now waiting for " << idleTime.GetSeconds()
                       << " seconds before the next video");
 
-    Simulator::Schedule(idleTime, &NrtvUdpServer::AddVideoWorker, this, socket);
+    Simulator::Schedule(idleTime, &NrtvUdpServer::AddVideoWorker, this, slot);
 }
 
 void
@@ -255,27 +329,110 @@ NrtvUdpServer::AddClient(Address remoteAddress, uint32_t numberOfVideos)
 
     // Create an entry of how many videos are to be streamed to this socket
     // before disconnecting.
-    videosLeft[socket] = numberOfVideos;
+    ClientRecord_t client;
+    client.socket = socket;
+    client.videosLeft = numberOfVideos;
+    m_clients.push_back(client);
 
-    // Assign video worker for the socket
-    AddVideoWorker(socket);
+    if (m_sharedStream)
+    {
+        if (numberOfVideos == 0)
+        {
+            NS_LOG_INFO("NrtvUdpServer has no video to stream to " << remoteAddress);
+            return;
+        }
+
+        // Subscribe the client to the shared stream, starting it if idle.
+        m_subscribers.push_back(m_clients.size() - 1);
+        if (m_sharedWorker == nullptr && Simulator::IsExpired(m_sharedVideoEvent))
+        {
+            StartSharedVideo();
+        }
+    }
+    else
+    {
+        // Assign video worker for the socket
+        AddVideoWorker(m_clients.size() - 1);
+    }
 
     NS_LOG_INFO("NrtvUdpServer will stream " << numberOfVideos << " videos to " << remoteAddress);
 } // end of `void AddClient ()`
 
 void
-NrtvUdpServer::AddVideoWorker(Ptr<Socket> socket)
+NrtvUdpServer::AddVideoWorker(uint32_t slot)
 {
-    Ptr<NrtvVideoWorker> worker = CreateObject<NrtvVideoWorker>(socket);
-    m_workers[socket] = worker;
-    worker->SetTxCallback(MakeCallback(&NrtvUdpServer::NotifyTxSlice, this));
-    worker->SetVideoCompletedCallback(MakeCallback(&NrtvUdpServer::NotifyVideoCompleted, this));
+    NS_LOG_FUNCTION(this << slot);
+    NS_ASSERT(slot < m_clients.size());
+
+    ClientRecord_t& client = m_clients[slot];
+    NS_ASSERT(client.worker == nullptr);
+    Ptr<NrtvVideoWorker> worker = m_workerPool.Acquire(client.socket, slot);
+    client.worker = worker;
     if (GetState() == STARTED)
     {
         worker->ChangeState(NrtvVideoWorker::READY);
     }
 }
 
+void
+NrtvUdpServer::StartSharedVideo()
+{
+    NS_LOG_FUNCTION(this << m_subscribers.size());
+    NS_ASSERT(m_sharedWorker == nullptr);
+
+    // The shared worker has no socket which would tell the node it runs on.
+    m_workerPool.SetNodeId(GetNode()->GetId());
+    m_sharedWorker = m_workerPool.Acquire(nullptr, SHARED_STREAM_HANDLE);
+    if (GetState() == STARTED)
+    {
+        m_sharedWorker->ChangeState(NrtvVideoWorker::READY);
+    }
+}
+
+void
+NrtvUdpServer::NotifySharedVideoCompleted()
+{
+    NS_LOG_FUNCTION(this << m_subscribers.size());
+    NS_ASSERT(m_sharedWorker != nullptr);
+
+    m_workerPool.Release(m_sharedWorker); // keep the worker for the next video
+    m_sharedWorker = nullptr;
+
+    // Every subscriber has seen one more video, disconnect those which are done.
+    std::vector<uint32_t>::iterator last = m_subscribers.begin();
+    for (std::vector<uint32_t>::iterator it = m_subscribers.begin(); it != m_subscribers.end();
+         ++it)
+    {
+        ClientRecord_t& client = m_clients[*it];
+        client.videosLeft--;
+
+        if (client.videosLeft == 0)
+        {
+            client.socket->Close();
+            NS_LOG_LOGIC(this << " client in slot " << *it << " is now disconnected");
+        }
+        else
+        {
+            *last = *it;
+            ++last;
+        }
+    }
+    m_subscribers.erase(last, m_subscribers.end());
+
+    if (m_subscribers.empty())
+    {
+        NS_LOG_LOGIC(this << " no more subscribers, the shared stream is now idle");
+        return;
+    }
+
+    // Wait until the next video.
+    const Time idleTime = m_nrtvVariables->GetIdleTime();
+    NS_LOG_LOGIC(this << " a shared video has just completed, now waiting for "
+                      << idleTime.GetSeconds() << " seconds before the next video");
+    m_sharedVideoEvent = Simulator::Schedule(idleTime, &NrtvUdpServer::StartSharedVideo, this);
+
+} // end of `void NotifySharedVideoCompleted ()`
+
 void
 NrtvUdpServer::SwitchToState(NrtvUdpServer::State_t state)
 {
@@ -26,9 +26,10 @@
 #include <ns3/application.h>
 #include <ns3/callback.h>
 #include <ns3/event-id.h>
+#include <ns3/nrtv-video-worker.h>
 #include <ns3/traced-callback.h>
 
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -36,7 +37,6 @@ namespace ns3
 class Packet;
 class Socket;
 class NrtvVariables;
-class NrtvVideoWorker;
 
 /**
  * \ingroup nrtv
@@ -49,6 +49,14 @@ class NrtvVideoWorker;
  *
  * When the transmission of a whole video is completed, the application becomes
  * idle for a random length of time, and then resumes with another video.
+ *
+ * By default, every client has its own video worker, which independently
+ * generates the videos streamed to the client. When the `SharedStream`
+ * attribute is enabled, a single video worker generates one stream of videos,
+ * like a broadcast TV channel, and every video slice is sent to all the
+ * clients. A client joins the ongoing video when added, and is disconnected
+ * after the given number of videos has been completed. The `Tx` trace source
+ * is still fired once for each packet sent to each client.
  */
 class NrtvUdpServer : public Application
 {
@@ -123,28 +131,68 @@ class NrtvUdpServer : public Application
     /// Invoked by NrtvVideoWorker instance after transmitting a video slice.
     void NotifyTxSlice(Ptr<Socket> socket, Ptr<const Packet> packet);
 
-    /// Invoked by NrtvVideoWorker instance after completed a video.
-    void NotifyVideoCompleted(Ptr<Socket> socket);
+    /**
+     * Invoked by NrtvVideoWorker instance after completed a video.
+     * \param socket the socket of the client.
+     * \param slot index of the client's record in #m_clients.
+     */
+    void NotifyVideoCompleted(Ptr<Socket> socket, uint32_t slot);
 
     /**
-     * Add a video worker for the socket. Socket is assumed to be
+     * Add a video worker for the client. The client's socket is assumed to be
      * bound to remote address.
+     * \param slot index of the client's record in #m_clients.
+     */
+    void AddVideoWorker(uint32_t slot);
+
+    /**
+     * Start a new video of the shared stream, to be sent to all the
+     * subscribed clients. Used in `SharedStream` mode.
+     */
+    void StartSharedVideo();
+
+    /**
+     * Invoked after a video of the shared stream has been completed. Used in
+     * `SharedStream` mode.
      */
-    void AddVideoWorker(Ptr<Socket> socket);
+    void NotifySharedVideoCompleted();
 
     /**
      * Switches the state of the application.
      */
     void SwitchToState(State_t state);
 
-    State_t m_state;                            ///< Internal state of the application
-    std::map<Ptr<Socket>, uint32_t> videosLeft; ///< Videos left to be streamed to the socket.
-    std::map<Ptr<Socket>, Ptr<NrtvVideoWorker>> m_workers; ///< Worker memory
+    /// The worker handle of the shared stream, distinct from any client slot.
+    static const uint32_t SHARED_STREAM_HANDLE = 0xFFFFFFFF;
+
+    /// State of a single client added by AddClient().
+    struct ClientRecord_t
+    {
+        Ptr<Socket> socket;           ///< Socket connected to the client.
+        Ptr<NrtvVideoWorker> worker;  ///< The active worker, or null while idle.
+        uint32_t videosLeft;          ///< Videos left to be streamed to the client.
+    };
+
+    State_t m_state; ///< Internal state of the application
+    /**
+     * Clients, in the order they were added. The index of a record is used as
+     * the handle of the client's worker, so records are never moved or removed.
+     */
+    std::vector<ClientRecord_t> m_clients;
+    NrtvVideoWorkerPool m_workerPool; ///< Idle workers, reused for the next videos.
     Ptr<NrtvVariables> m_nrtvVariables; ///< Nrtv variable collection of this instance
 
+    /// The worker generating the shared stream, or null while idle.
+    Ptr<NrtvVideoWorker> m_sharedWorker;
+    /// Slots of the clients subscribed to the shared stream.
+    std::vector<uint32_t> m_subscribers;
+    /// The pending start of the next video of the shared stream.
+    EventId m_sharedVideoEvent;
+
     // ATTRIBUTES
 
     uint16_t m_remotePort;
+    bool m_sharedStream; ///< `SharedStream` attribute.
 
     // TRACE SOURCES
 
@@ -21,14 +21,18 @@
 
 #include "nrtv-variables.h"
 
+#include <ns3/boolean.h>
 #include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
 #include <ns3/pointer.h>
+#include <ns3/rng-seed-manager.h>
 #include <ns3/rng-stream.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
 #include <cmath>
 
 NS_LOG_COMPONENT_DEFINE("NrtvVariables");
@@ -48,10 +52,16 @@ NrtvVariables::NrtvVariables()
       m_idleTimeRng(CreateObject<ExponentialRandomVariable>()),
       m_numberOfVideosRng(CreateObject<ConstantRandomVariable>()),
       m_connectionOpenDelayRng(CreateObject<UniformRandomVariable>()),
+      m_videoTraceStartRng(CreateObject<UniformRandomVariable>()),
       m_numOfFramesMean(3000),
       m_numOfFramesStdDev(2400),
       m_numOfFramesMin(200),
-      m_numOfFramesMax(36000)
+      m_numOfFramesMax(36000),
+      m_stream(-1),
+      m_viewSubstreams(false),
+      m_viewStream(-1),
+      m_numOfViews(0),
+      m_scheduleLogMode(TrafficScheduleLog::DISABLED)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,6 +79,46 @@ NrtvVariables::GetTypeId()
                           IntegerValue(-1),
                           MakeIntegerAccessor(&NrtvVariables::SetStream),
                           MakeIntegerChecker<int64_t>())
+            .AddAttribute("VariateBlockSize",
+                          "Number of variates drawn at a time for the number of frames, "
+                          "slice size, slice encoding delay, and idle time. "
+                          "Zero means drawing every value separately.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NrtvVariables::SetVariateBlockSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ViewSubstreams",
+                          "If true, every view created by CreateView () draws from its own "
+                          "RNG substream instead of the random variables of this object.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NrtvVariables::SetViewSubstreams,
+                                              &NrtvVariables::GetViewSubstreams),
+                          MakeBooleanChecker())
+            .AddAttribute("VideoTraceFile",
+                          "Name of a video trace file (see NrtvVideoTrace) whose frames and "
+                          "slices are replayed instead of drawing them. Empty means drawing "
+                          "the slices from the random distributions.",
+                          StringValue(""),
+                          MakeStringAccessor(&NrtvVariables::SetVideoTraceFile,
+                                             &NrtvVariables::GetVideoTraceFile),
+                          MakeStringChecker())
+            .AddAttribute("ScheduleLogMode",
+                          "Whether the drawn values are recorded into the schedule log, or "
+                          "replayed from it. Must be set before `ScheduleLogFile`.",
+                          EnumValue(TrafficScheduleLog::DISABLED),
+                          MakeEnumAccessor(&NrtvVariables::m_scheduleLogMode),
+                          MakeEnumChecker(TrafficScheduleLog::DISABLED,
+                                          "DISABLED",
+                                          TrafficScheduleLog::RECORD,
+                                          "RECORD",
+                                          TrafficScheduleLog::REPLAY,
+                                          "REPLAY"))
+            .AddAttribute("ScheduleLogFile",
+                          "Name of the schedule log file (see TrafficScheduleLog). Empty "
+                          "means neither recording nor replaying.",
+                          StringValue(""),
+                          MakeStringAccessor(&NrtvVariables::SetScheduleLogFile,
+                                             &NrtvVariables::GetScheduleLogFile),
+                          MakeStringChecker())
 
             // NUMBER OF FRAMES
             .AddAttribute("NumOfFramesMean",
@@ -181,7 +231,25 @@ NrtvVariables::GetTypeId()
 uint32_t
 NrtvVariables::GetNumOfFrames()
 {
-    return GetBoundedInteger(m_numOfFramesRng, m_numOfFramesMin, m_numOfFramesMax);
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayInteger(LOG_NUM_OF_FRAMES);
+    }
+
+    uint32_t value;
+    if (m_numOfFramesTable != nullptr)
+    {
+        m_numOfFramesTable->SetIntegerBounds(static_cast<uint32_t>(m_numOfFramesMin),
+                                             static_cast<uint32_t>(m_numOfFramesMax));
+        value = m_numOfFramesTable->GetInteger();
+    }
+    else
+    {
+        value = static_cast<uint32_t>(
+            GetBoundedInteger(m_numOfFramesRng, m_numOfFramesMin, m_numOfFramesMax));
+    }
+
+    return m_scheduleLog.Record(LOG_NUM_OF_FRAMES, value);
 }
 
 Time
@@ -199,18 +267,38 @@ NrtvVariables::GetNumOfSlices()
 uint32_t
 NrtvVariables::GetSliceSize()
 {
-    return m_sliceSizeRng->GetInteger();
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayInteger(LOG_SLICE_SIZE);
+    }
+
+    const uint32_t value = (m_sliceSizeTable != nullptr) ? m_sliceSizeTable->GetInteger()
+                                                         : m_sliceSizeRng->GetInteger();
+    return m_scheduleLog.Record(LOG_SLICE_SIZE, value);
 }
 
 Time
 NrtvVariables::GetSliceEncodingDelay()
 {
-    return MilliSeconds(m_sliceEncodingDelayRng->GetInteger());
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayTime(LOG_SLICE_ENCODING_DELAY);
+    }
+
+    const uint32_t value = (m_sliceEncodingDelayTable != nullptr)
+                               ? m_sliceEncodingDelayTable->GetInteger()
+                               : m_sliceEncodingDelayRng->GetInteger();
+    return m_scheduleLog.Record(LOG_SLICE_ENCODING_DELAY, MilliSeconds(value));
 }
 
 uint64_t
 NrtvVariables::GetSliceEncodingDelayMilliSeconds()
 {
+    if (m_sliceEncodingDelayTable != nullptr)
+    {
+        return m_sliceEncodingDelayTable->GetInteger();
+    }
+
     return m_sliceEncodingDelayRng->GetInteger();
 }
 
@@ -223,18 +311,36 @@ NrtvVariables::GetDejitterBufferWindowSize()
 Time
 NrtvVariables::GetIdleTime()
 {
-    return Seconds(m_idleTimeRng->GetValue());
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayTime(LOG_IDLE_TIME);
+    }
+
+    const double value = (m_idleTimeTable != nullptr) ? m_idleTimeTable->GetValue()
+                                                      : m_idleTimeRng->GetValue();
+    return m_scheduleLog.Record(LOG_IDLE_TIME, Seconds(value));
 }
 
 Time
 NrtvVariables::GetConnectionOpenDelay()
 {
-    return Seconds(m_connectionOpenDelayRng->GetValue());
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayTime(LOG_CONNECTION_OPEN_DELAY);
+    }
+
+    const Time value = Seconds(m_connectionOpenDelayRng->GetValue());
+    return m_scheduleLog.Record(LOG_CONNECTION_OPEN_DELAY, value);
 }
 
 double
 NrtvVariables::GetIdleTimeSeconds()
 {
+    if (m_idleTimeTable != nullptr)
+    {
+        return m_idleTimeTable->GetValue();
+    }
+
     return m_idleTimeRng->GetValue();
 }
 
@@ -250,6 +356,132 @@ NrtvVariables::SetStream(int64_t stream)
     m_sliceEncodingDelayRng->SetStream(stream);
     m_dejitterBufferWindowSizeRng->SetStream(stream);
     m_idleTimeRng->SetStream(stream);
+    m_videoTraceStartRng->SetStream(stream);
+
+    m_stream = stream;
+    if (m_numOfFramesTable != nullptr)
+    {
+        m_numOfFramesTable->SetStream(stream);
+        m_sliceSizeTable->SetStream(stream);
+        m_sliceEncodingDelayTable->SetStream(stream);
+        m_idleTimeTable->SetStream(stream);
+    }
+}
+
+void
+NrtvVariables::SetVariateBlockSize(uint32_t blockSize)
+{
+    NS_LOG_FUNCTION(this << blockSize);
+
+    if (blockSize == 0)
+    {
+        m_numOfFramesTable = nullptr;
+        m_sliceSizeTable = nullptr;
+        m_sliceEncodingDelayTable = nullptr;
+        m_idleTimeTable = nullptr;
+        return;
+    }
+
+    m_numOfFramesTable = Create<RandomVariateTable>(m_numOfFramesRng, blockSize);
+    m_sliceSizeTable = Create<RandomVariateTable>(m_sliceSizeRng, blockSize);
+    m_sliceEncodingDelayTable = Create<RandomVariateTable>(m_sliceEncodingDelayRng, blockSize);
+    m_idleTimeTable = Create<RandomVariateTable>(m_idleTimeRng, blockSize);
+
+    if (m_stream >= 0)
+    {
+        m_numOfFramesTable->SetStream(m_stream);
+        m_sliceSizeTable->SetStream(m_stream);
+        m_sliceEncodingDelayTable->SetStream(m_stream);
+        m_idleTimeTable->SetStream(m_stream);
+    }
+}
+
+int64_t
+NrtvVariables::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    SetStream(stream);
+    m_viewStream = stream + 1;
+    return 2;
+}
+
+Ptr<NrtvVariablesView>
+NrtvVariables::CreateView()
+{
+    NS_LOG_FUNCTION(this << m_numOfViews);
+    return Create<NrtvVariablesView>(this, m_numOfViews++);
+}
+
+void
+NrtvVariables::SetViewSubstreams(bool viewSubstreams)
+{
+    NS_LOG_FUNCTION(this << viewSubstreams);
+    m_viewSubstreams = viewSubstreams;
+}
+
+bool
+NrtvVariables::GetViewSubstreams() const
+{
+    return m_viewSubstreams;
+}
+
+void
+NrtvVariables::SetVideoTraceFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_videoTraceFile = fileName;
+    m_videoTrace = fileName.empty() ? nullptr : NrtvVideoTrace::Open(fileName);
+}
+
+std::string
+NrtvVariables::GetVideoTraceFile() const
+{
+    return m_videoTraceFile;
+}
+
+Ptr<const NrtvVideoTrace>
+NrtvVariables::GetVideoTrace() const
+{
+    return m_videoTrace;
+}
+
+uint32_t
+NrtvVariables::GetVideoTraceStartFrame()
+{
+    if (m_scheduleLog.IsReplaying())
+    {
+        return m_scheduleLog.ReplayInteger(LOG_VIDEO_TRACE_START_FRAME);
+    }
+
+    NS_ASSERT_MSG(m_videoTrace != nullptr, "No video trace");
+    const uint32_t value = m_videoTraceStartRng->GetInteger(0, m_videoTrace->GetNumOfFrames() - 1);
+    return m_scheduleLog.Record(LOG_VIDEO_TRACE_START_FRAME, value);
+}
+
+void
+NrtvVariables::SetScheduleLogFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName << m_scheduleLogMode);
+    m_scheduleLogFile = fileName;
+    m_scheduleLog.Open(fileName, m_scheduleLogMode);
+}
+
+std::string
+NrtvVariables::GetScheduleLogFile() const
+{
+    return m_scheduleLogFile;
+}
+
+uint64_t
+NrtvVariables::GetViewStream()
+{
+    if (m_viewStream < 0)
+    {
+        m_viewStream = static_cast<int64_t>(RngSeedManager::GetNextStreamIndex());
+        NS_LOG_INFO(this << " views use automatically allocated stream " << m_viewStream);
+    }
+
+    return static_cast<uint64_t>(m_viewStream);
 }
 
 // NUMBER OF FRAMES PER VIDEO ATTRIBUTE SETTER AND GETTER METHODS /////////////
@@ -315,6 +547,7 @@ NrtvVariables::SetSliceSizeMax(uint32_t max)
 {
     NS_LOG_FUNCTION(this << max);
     m_sliceSizeRng->SetAttribute("Bound", DoubleValue(static_cast<double>(max)));
+    ResetVariateTables();
 }
 
 void
@@ -322,6 +555,7 @@ NrtvVariables::SetSliceSizeShape(double shape)
 {
     NS_LOG_FUNCTION(this << shape);
     m_sliceSizeRng->SetAttribute("Shape", DoubleValue(shape));
+    ResetVariateTables();
 }
 
 void
@@ -329,6 +563,7 @@ NrtvVariables::SetSliceSizeScale(double scale)
 {
     NS_LOG_FUNCTION(this << scale);
     SetParetoScale(m_sliceSizeRng, scale);
+    ResetVariateTables();
 }
 
 double
@@ -362,6 +597,7 @@ NrtvVariables::SetSliceEncodingDelayMax(Time max)
     NS_LOG_FUNCTION(this << max.GetSeconds());
     m_sliceEncodingDelayRng->SetAttribute("Bound",
                                           DoubleValue(static_cast<double>(max.GetMilliSeconds())));
+    ResetVariateTables();
 }
 
 void
@@ -376,6 +612,7 @@ NrtvVariables::SetSliceEncodingDelayShape(double shape)
     }
 
     m_sliceEncodingDelayRng->SetAttribute("Shape", DoubleValue(shape));
+    ResetVariateTables();
 }
 
 void
@@ -383,6 +620,7 @@ NrtvVariables::SetSliceEncodingDelayScale(double scale)
 {
     NS_LOG_FUNCTION(this << scale);
     SetParetoScale(m_sliceEncodingDelayRng, scale);
+    ResetVariateTables();
 }
 
 Time
@@ -424,6 +662,7 @@ NrtvVariables::SetIdleTimeMean(Time mean)
 {
     NS_LOG_FUNCTION(this << mean.GetSeconds());
     m_idleTimeRng->SetAttribute("Mean", DoubleValue(mean.GetSeconds()));
+    ResetVariateTables();
 }
 
 Time
@@ -480,6 +719,220 @@ NrtvVariables::RefreshLogNormalParameters(Ptr<LogNormalRandomVariable> random,
     // updating attributes of the log normal
     random->SetAttribute("Mu", DoubleValue(mu));
     random->SetAttribute("Sigma", DoubleValue(sigma));
+    ResetVariateTables();
+}
+
+void
+NrtvVariables::ResetVariateTables()
+{
+    if (m_numOfFramesTable != nullptr)
+    {
+        m_numOfFramesTable->Reset();
+        m_sliceSizeTable->Reset();
+        m_sliceEncodingDelayTable->Reset();
+        m_idleTimeTable->Reset();
+    }
+}
+
+// NRTV VARIABLES VIEW ////////////////////////////////////////////////////////
+
+NrtvVariablesView::NrtvVariablesView(Ptr<NrtvVariables> variables, uint32_t index)
+    : m_variables(variables),
+      m_index(index)
+{
+    NS_LOG_FUNCTION(this << variables << index);
+    NS_ASSERT(variables != nullptr);
+}
+
+uint32_t
+NrtvVariablesView::GetNumOfFrames()
+{
+    if (!m_variables->m_viewSubstreams)
+    {
+        return m_variables->GetNumOfFrames();
+    }
+
+    TrafficScheduleLogHandle& log = m_variables->m_scheduleLog;
+    const uint32_t logVariable = GetLogVariable(NrtvVariables::LOG_NUM_OF_FRAMES);
+    if (log.IsReplaying())
+    {
+        return log.ReplayInteger(logVariable);
+    }
+
+    Ptr<LogNormalRandomVariable> random = m_variables->m_numOfFramesRng;
+    const double mu = random->GetMu();
+    const double sigma = random->GetSigma();
+    uint64_t value;
+    do
+    {
+        const double r = std::sqrt(-2.0 * std::log(GetUniform(random)));
+        const double theta = 2.0 * M_PI * GetUniform(random);
+        value = static_cast<uint64_t>(std::exp(mu + sigma * r * std::cos(theta)));
+    } while (value < m_variables->m_numOfFramesMin || value > m_variables->m_numOfFramesMax);
+
+    return log.Record(logVariable, static_cast<uint32_t>(value));
+}
+
+Time
+NrtvVariablesView::GetFrameInterval()
+{
+    return m_variables->GetFrameInterval();
+}
+
+uint16_t
+NrtvVariablesView::GetNumOfSlices()
+{
+    return m_variables->GetNumOfSlices();
+}
+
+uint32_t
+NrtvVariablesView::GetSliceSize()
+{
+    if (!m_variables->m_viewSubstreams)
+    {
+        return m_variables->GetSliceSize();
+    }
+
+    TrafficScheduleLogHandle& log = m_variables->m_scheduleLog;
+    const uint32_t logVariable = GetLogVariable(NrtvVariables::LOG_SLICE_SIZE);
+    if (log.IsReplaying())
+    {
+        return log.ReplayInteger(logVariable);
+    }
+
+    return log.Record(logVariable,
+                      static_cast<uint32_t>(GetPareto(m_variables->m_sliceSizeRng)));
+}
+
+Time
+NrtvVariablesView::GetSliceEncodingDelay()
+{
+    if (!m_variables->m_viewSubstreams)
+    {
+        return m_variables->GetSliceEncodingDelay();
+    }
+
+    TrafficScheduleLogHandle& log = m_variables->m_scheduleLog;
+    const uint32_t logVariable = GetLogVariable(NrtvVariables::LOG_SLICE_ENCODING_DELAY);
+    if (log.IsReplaying())
+    {
+        return log.ReplayTime(logVariable);
+    }
+
+    const double delay = GetPareto(m_variables->m_sliceEncodingDelayRng);
+    return log.Record(logVariable, MilliSeconds(static_cast<uint32_t>(delay)));
+}
+
+Time
+NrtvVariablesView::GetDejitterBufferWindowSize()
+{
+    return m_variables->GetDejitterBufferWindowSize();
+}
+
+Time
+NrtvVariablesView::GetIdleTime()
+{
+    if (!m_variables->m_viewSubstreams)
+    {
+        return m_variables->GetIdleTime();
+    }
+
+    TrafficScheduleLogHandle& log = m_variables->m_scheduleLog;
+    const uint32_t logVariable = GetLogVariable(NrtvVariables::LOG_IDLE_TIME);
+    if (log.IsReplaying())
+    {
+        return log.ReplayTime(logVariable);
+    }
+
+    Ptr<ExponentialRandomVariable> random = m_variables->m_idleTimeRng;
+    const double mean = random->GetMean();
+    const double bound = random->GetBound();
+    double value;
+    do
+    {
+        value = -mean * std::log(GetUniform(random));
+    } while (bound > 0.0 && value > bound);
+
+    return log.Record(logVariable, Seconds(value));
+}
+
+Time
+NrtvVariablesView::GetConnectionOpenDelay()
+{
+    return m_variables->GetConnectionOpenDelay();
+}
+
+uint32_t
+NrtvVariablesView::GetVideoTraceStartFrame()
+{
+    if (!m_variables->m_viewSubstreams)
+    {
+        return m_variables->GetVideoTraceStartFrame();
+    }
+
+    TrafficScheduleLogHandle& log = m_variables->m_scheduleLog;
+    const uint32_t logVariable = GetLogVariable(NrtvVariables::LOG_VIDEO_TRACE_START_FRAME);
+    if (log.IsReplaying())
+    {
+        return log.ReplayInteger(logVariable);
+    }
+
+    NS_ASSERT_MSG(m_variables->m_videoTrace != nullptr, "No video trace");
+    const uint32_t numOfFrames = m_variables->m_videoTrace->GetNumOfFrames();
+    const uint32_t frame =
+        static_cast<uint32_t>(GetUniform(m_variables->m_videoTraceStartRng) * numOfFrames);
+    return log.Record(logVariable, std::min(frame, numOfFrames - 1));
+}
+
+Ptr<NrtvVariables>
+NrtvVariablesView::GetVariables() const
+{
+    return m_variables;
+}
+
+uint32_t
+NrtvVariablesView::GetIndex() const
+{
+    return m_index;
+}
+
+double
+NrtvVariablesView::GetUniform(Ptr<RandomVariableStream> source)
+{
+    if (m_rng == nullptr)
+    {
+        // Substreams of different runs must not overlap either.
+        const uint64_t substream = (static_cast<uint64_t>(m_index) << 32) +
+                                   RngSeedManager::GetRun();
+        m_rng.reset(
+            new RngStream(RngSeedManager::GetSeed(), m_variables->GetViewStream(), substream));
+        NS_LOG_INFO(this << " view " << m_index << " uses substream " << substream);
+    }
+
+    const double u = m_rng->RandU01();
+    return source->IsAntithetic() ? (1.0 - u) : u;
+}
+
+uint32_t
+NrtvVariablesView::GetLogVariable(uint32_t variable) const
+{
+    // The parent itself uses the numbers below 256.
+    return ((m_index + 1) << 8) | variable;
+}
+
+double
+NrtvVariablesView::GetPareto(Ptr<ParetoRandomVariable> random)
+{
+    const double scale = random->GetScale();
+    const double exponent = 1.0 / random->GetShape();
+    const double bound = random->GetBound();
+    double value;
+    do
+    {
+        value = scale / std::pow(GetUniform(random), exponent);
+    } while (bound > 0.0 && value > bound);
+
+    return value;
 }
 
 } // namespace ns3
@@ -22,13 +22,22 @@
 #ifndef NRTV_VARIABLES_H
 #define NRTV_VARIABLES_H
 
+#include <ns3/nrtv-video-trace.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/random-variable-stream.h>
+#include <ns3/random-variate-table.h>
+#include <ns3/rng-stream.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/traffic-schedule-log.h>
+
+#include <memory>
 
 namespace ns3
 {
 
+class NrtvVariablesView;
+
 /**
  * \ingroup nrtv
  * \brief Container of various random variables for assisting the generation of
@@ -54,6 +63,33 @@ namespace ns3
  * Most parameters of the random distributions are configurable via attributes
  * and methods of this class.
  *
+ * By default, every value is drawn separately from its random variable. If the
+ * `VariateBlockSize` attribute is set to a non-zero value, the number of frames,
+ * slice size, slice encoding delay, and idle time are instead handed out from
+ * RandomVariateTable instances, which draw and truncate that many variates at a
+ * time. The values are still reproducible for a given stream number, but form
+ * a different sequence than the one drawn without the tables.
+ *
+ * A single instance may be shared by many applications through lightweight
+ * views (see CreateView() and NrtvVariablesView), which use the distribution
+ * parameters of this object. If the `ViewSubstreams` attribute is enabled,
+ * each view draws from its own RNG substream instead of the random variables
+ * of this object, so that the values of one client do not depend on the
+ * activity of the other clients.
+ *
+ * If the `VideoTraceFile` attribute is set, NrtvVideoWorker replays the
+ * frame intervals, the number of slices per frame, the slice sizes, and the
+ * slice encoding delays from the given NrtvVideoTrace instead of drawing them,
+ * while the number of frames per video is still drawn. The trace is mapped
+ * into memory once and shared by every NrtvVariables instance using the same
+ * file.
+ *
+ * The `ScheduleLogMode` and `ScheduleLogFile` attributes make the instance
+ * record the number of frames, slice sizes, slice encoding delays, idle times,
+ * connection opening delays, and video trace start frames into a
+ * TrafficScheduleLog, or replay them from it instead of drawing them (see
+ * SetScheduleLogFile()). The values drawn by each view are logged separately.
+ *
  * References:
  * [1] NGMN Alliance, "NGMN Radio Access Performance Evaluation Methodology",
  *     v1.0, January 2008.
@@ -190,6 +226,86 @@ class NrtvVariables : public Object
      */
     void SetStream(int64_t stream);
 
+    /**
+     * \brief Enable or disable block sampling of the most frequently drawn
+     *        random values.
+     * \param blockSize number of variates drawn at a time, or zero to draw
+     *                  every value separately from its random variable.
+     */
+    void SetVariateBlockSize(uint32_t blockSize);
+
+    /**
+     * \brief Assign fixed random variable streams to the random variables used
+     *        by this model and to the views created from it.
+     * \param stream first stream index to use.
+     * \return the number of stream indices assigned, i.e., 2
+     *
+     * The random variables of this object use \p stream (see SetStream()),
+     * while the views use \p stream + 1 with a different substream each,
+     * determined by the index of the view and the run number.
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * \brief Create a new view sharing the distribution parameters of this
+     *        object.
+     * \return the view, indexed in the order of creation
+     */
+    Ptr<NrtvVariablesView> CreateView();
+
+    /**
+     * \param viewSubstreams if true, the views draw from their own substreams,
+     *                       otherwise they draw from the random variables of
+     *                       this object.
+     */
+    void SetViewSubstreams(bool viewSubstreams);
+
+    /**
+     * \return true if the views draw from their own substreams.
+     */
+    bool GetViewSubstreams() const;
+
+    /**
+     * \param fileName name of the video trace file to replay (see
+     *                 NrtvVideoTrace), or an empty string to draw the slices
+     *                 from the random distributions.
+     */
+    void SetVideoTraceFile(std::string fileName);
+
+    /**
+     * \return name of the video trace file, or an empty string if none
+     */
+    std::string GetVideoTraceFile() const;
+
+    /**
+     * \return the video trace to replay, or null if `VideoTraceFile` is not set
+     */
+    Ptr<const NrtvVideoTrace> GetVideoTrace() const;
+
+    /**
+     * \brief Get a random frame of the video trace where a new video begins.
+     * \return index of the frame, uniformly distributed over the trace
+     *
+     * Must not be invoked unless `VideoTraceFile` is set.
+     */
+    uint32_t GetVideoTraceStartFrame();
+
+    /**
+     * \param fileName name of the schedule log file, or an empty string to
+     *                 neither record nor replay
+     *
+     * The log is opened in the mode given by the `ScheduleLogMode` attribute,
+     * so the mode must be set first. Each NrtvVariables instance becomes a new
+     * owner of the log, so the instances must be configured in the same order
+     * when recording and when replaying.
+     */
+    void SetScheduleLogFile(std::string fileName);
+
+    /**
+     * \return name of the schedule log file, or an empty string if none
+     */
+    std::string GetScheduleLogFile() const;
+
     // THE REST ARE THE NOT-SO-USEFUL METHODS
 
     // NUMBER OF FRAMES SETTER METHOD
@@ -238,14 +354,33 @@ class NrtvVariables : public Object
     uint32_t GetNumOfVideos() const;
 
   private:
+    friend class NrtvVariablesView;
+
+    /// Variables logged in the schedule log.
+    typedef enum
+    {
+        LOG_NUM_OF_FRAMES = 0,
+        LOG_SLICE_SIZE,
+        LOG_SLICE_ENCODING_DELAY,
+        LOG_IDLE_TIME,
+        LOG_CONNECTION_OPEN_DELAY,
+        LOG_VIDEO_TRACE_START_FRAME
+    } LogVariable_t;
+
     // HELPER METHODS
 
+    // Get the stream used by the views, allocating one automatically if not assigned yet
+    uint64_t GetViewStream();
+
     // Get a bounded integer from a random variable stream
     uint64_t GetBoundedInteger(Ptr<RandomVariableStream> random, double min, double max);
 
     // Set scale of a ParetoRandomVariable
     void SetParetoScale(Ptr<ParetoRandomVariable> random, double scale);
 
+    // Discard the values remaining in the variate tables, if any
+    void ResetVariateTables();
+
     // Refresh Log-normal distribution mu (location) and sigma (scale) according to mean and
     // standard deviation
     void RefreshLogNormalParameters(Ptr<LogNormalRandomVariable> random,
@@ -263,15 +398,128 @@ class NrtvVariables : public Object
     Ptr<ExponentialRandomVariable> m_idleTimeRng;
     Ptr<RandomVariableStream> m_numberOfVideosRng;
     Ptr<RandomVariableStream> m_connectionOpenDelayRng;
+    Ptr<UniformRandomVariable> m_videoTraceStartRng;
+
+    // BLOCK-SAMPLED VARIATES (NULL UNLESS `VariateBlockSize` IS NON-ZERO)
+
+    Ptr<RandomVariateTable> m_numOfFramesTable;
+    Ptr<RandomVariateTable> m_sliceSizeTable;
+    Ptr<RandomVariateTable> m_sliceEncodingDelayTable;
+    Ptr<RandomVariateTable> m_idleTimeTable;
 
     // HELPER VARIABLES
     double m_numOfFramesMean;
     double m_numOfFramesStdDev;
     double m_numOfFramesMin;
     double m_numOfFramesMax;
+    int64_t m_stream;
+
+    // VIEWS
+    bool m_viewSubstreams;
+    int64_t m_viewStream;
+    uint32_t m_numOfViews;
+
+    // VIDEO TRACE
+    std::string m_videoTraceFile;
+    Ptr<NrtvVideoTrace> m_videoTrace;
+
+    // SCHEDULE LOG
+    TrafficScheduleLog::Mode_t m_scheduleLogMode;
+    std::string m_scheduleLogFile;
+    TrafficScheduleLogHandle m_scheduleLog;
 
 }; // end of `class NrtvVariables`
 
+/**
+ * \ingroup nrtv
+ * \brief Per-client source of NRTV random values, sharing the distribution
+ *        parameters of an NrtvVariables instance.
+ *
+ * Created by NrtvVariables::CreateView(), typically by each application on
+ * its first draw. The methods have the same meaning as those of
+ * NrtvVariables.
+ *
+ * If `ViewSubstreams` of the parent is disabled, every method simply forwards
+ * to the parent, so all views of the same parent share its random variables.
+ * Otherwise, the number of frames, slice size, slice encoding delay, and idle
+ * time are drawn by inverse transform (Box-Muller transform for the number of
+ * frames) from a private RngStream, which is created on the first draw. The
+ * substream is selected by the index of the view and the run number, so the
+ * values of a view are reproducible regardless of other views. A view only
+ * keeps the state of one RngStream, instead of the nine random variable
+ * objects of a full NrtvVariables instance. The start frame of the video
+ * trace is drawn from the same RngStream. Constant values and the connection
+ * opening delay, whose distribution is arbitrary, are always taken from the
+ * parent.
+ */
+class NrtvVariablesView : public SimpleRefCount<NrtvVariablesView>
+{
+  public:
+    /**
+     * \brief Create a new view. Use NrtvVariables::CreateView() instead.
+     * \param variables the parent holding the distribution parameters.
+     * \param index index of the view among the views of the parent.
+     */
+    NrtvVariablesView(Ptr<NrtvVariables> variables, uint32_t index);
+
+    /// \return see NrtvVariables::GetNumOfFrames()
+    uint32_t GetNumOfFrames();
+
+    /// \return see NrtvVariables::GetFrameInterval()
+    Time GetFrameInterval();
+
+    /// \return see NrtvVariables::GetNumOfSlices()
+    uint16_t GetNumOfSlices();
+
+    /// \return see NrtvVariables::GetSliceSize()
+    uint32_t GetSliceSize();
+
+    /// \return see NrtvVariables::GetSliceEncodingDelay()
+    Time GetSliceEncodingDelay();
+
+    /// \return see NrtvVariables::GetDejitterBufferWindowSize()
+    Time GetDejitterBufferWindowSize();
+
+    /// \return see NrtvVariables::GetIdleTime()
+    Time GetIdleTime();
+
+    /// \return see NrtvVariables::GetConnectionOpenDelay()
+    Time GetConnectionOpenDelay();
+
+    /// \return see NrtvVariables::GetVideoTraceStartFrame()
+    uint32_t GetVideoTraceStartFrame();
+
+    /// \return the parent holding the distribution parameters
+    Ptr<NrtvVariables> GetVariables() const;
+
+    /// \return index of the view among the views of the parent
+    uint32_t GetIndex() const;
+
+  private:
+    /**
+     * \param source the random variable whose `Antithetic` attribute applies.
+     * \return a uniform value in (0, 1) from the substream of this view.
+     */
+    double GetUniform(Ptr<RandomVariableStream> source);
+
+    /**
+     * \param random the variable holding the scale, shape, and bound parameters.
+     * \return a truncated Pareto variate from the substream of this view.
+     */
+    double GetPareto(Ptr<ParetoRandomVariable> random);
+
+    /**
+     * \param variable a variable of the parent.
+     * \return the number of the variable of this view in the schedule log
+     */
+    uint32_t GetLogVariable(uint32_t variable) const;
+
+    Ptr<NrtvVariables> m_variables;   ///< Parent holding the distribution parameters.
+    uint32_t m_index;                 ///< Index of the view among the views of the parent.
+    std::unique_ptr<RngStream> m_rng; ///< Substream of this view, created on the first draw.
+
+}; // end of `class NrtvVariablesView`
+
 } // namespace ns3
 
 #endif /* NRTV_VARIABLES_H */
@@ -0,0 +1,237 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nrtv-video-trace.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("NrtvVideoTrace");
+
+namespace ns3
+{
+
+const char NrtvVideoTrace::MAGIC[8] = {'N', 'R', 'T', 'V', 'T', 'R', 'A', 'C'};
+
+namespace
+{
+
+/// Size of the file header in bytes.
+const uint32_t HEADER_SIZE =
+    sizeof(NrtvVideoTrace::MAGIC) + 4 * sizeof(uint32_t) + sizeof(uint64_t);
+
+/// \return the traces currently mapped into memory, indexed by file name
+std::map<std::string, NrtvVideoTrace*>&
+GetOpenTraces()
+{
+    static std::map<std::string, NrtvVideoTrace*> openTraces;
+    return openTraces;
+}
+
+} // namespace
+
+Ptr<NrtvVideoTrace>
+NrtvVideoTrace::Open(std::string fileName)
+{
+    NS_LOG_FUNCTION(fileName);
+
+    std::map<std::string, NrtvVideoTrace*>& openTraces = GetOpenTraces();
+    std::map<std::string, NrtvVideoTrace*>::iterator it = openTraces.find(fileName);
+    if (it != openTraces.end())
+    {
+        NS_LOG_INFO("sharing the already mapped trace " << fileName);
+        return Ptr<NrtvVideoTrace>(it->second);
+    }
+
+    Ptr<NrtvVideoTrace> trace = Ptr<NrtvVideoTrace>(new NrtvVideoTrace(fileName), false);
+    openTraces[fileName] = PeekPointer(trace);
+    return trace;
+}
+
+void
+NrtvVideoTrace::Write(std::string fileName,
+                      const std::vector<Time>& frameTimes,
+                      const std::vector<std::vector<Slice_t>>& frameSlices,
+                      Time duration)
+{
+    NS_LOG_FUNCTION(fileName << frameTimes.size() << duration.As(Time::S));
+    NS_ABORT_MSG_IF(frameTimes.empty(), "A trace needs at least one frame");
+    NS_ABORT_MSG_UNLESS(frameTimes.size() == frameSlices.size(),
+                        "Every frame needs a list of slices");
+    NS_ABORT_MSG_IF(GetOpenTraces().count(fileName) > 0,
+                    "Unable to overwrite the trace " << fileName << " while it is in use");
+
+    std::vector<Frame_t> frames(frameTimes.size());
+    std::vector<Slice_t> slices;
+    for (uint32_t i = 0; i < frameTimes.size(); i++)
+    {
+        NS_ABORT_MSG_IF(frameSlices[i].empty(), "Frame " << i << " has no slice");
+        frames[i].timestamp = (frameTimes[i] - frameTimes[0]).GetNanoSeconds();
+        frames[i].firstSlice = slices.size();
+        frames[i].numOfSlices = frameSlices[i].size();
+        slices.insert(slices.end(), frameSlices[i].begin(), frameSlices[i].end());
+    }
+
+    std::ofstream ofs(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(ofs.is_open(), "Unable to open file " << fileName);
+
+    const uint32_t header[4] = {0x01020304,
+                                VERSION,
+                                static_cast<uint32_t>(frames.size()),
+                                static_cast<uint32_t>(slices.size())};
+    const uint64_t end = (duration - frameTimes[0]).GetNanoSeconds();
+    ofs.write(MAGIC, sizeof(MAGIC));
+    ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(&end), sizeof(end));
+    ofs.write(reinterpret_cast<const char*>(&frames[0]), frames.size() * sizeof(Frame_t));
+    ofs.write(reinterpret_cast<const char*>(&slices[0]), slices.size() * sizeof(Slice_t));
+    NS_ABORT_MSG_UNLESS(ofs.good(), "Unable to write file " << fileName);
+
+} // end of `void Write (...)`
+
+NrtvVideoTrace::NrtvVideoTrace(std::string fileName)
+    : m_fileName(fileName),
+      m_mapping(nullptr),
+      m_mappingSize(0),
+      m_numOfFrames(0),
+      m_frames(nullptr),
+      m_slices(nullptr)
+{
+    NS_LOG_FUNCTION(this << fileName);
+
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Unable to open file " << fileName);
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) != 0, "Unable to stat file " << fileName);
+    m_mappingSize = st.st_size;
+    NS_ABORT_MSG_IF(m_mappingSize < HEADER_SIZE, fileName << " is not a video trace file");
+
+    // The pages are shared with every other process mapping the same file.
+    m_mapping = mmap(nullptr, m_mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping stays valid
+    NS_ABORT_MSG_IF(m_mapping == MAP_FAILED, "Unable to map file " << fileName);
+
+    const char* data = static_cast<const char*>(m_mapping);
+    NS_ABORT_MSG_UNLESS(std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0,
+                        fileName << " is not a video trace file");
+    uint32_t header[4];
+    uint64_t duration;
+    std::memcpy(header, data + sizeof(MAGIC), sizeof(header));
+    std::memcpy(&duration, data + sizeof(MAGIC) + sizeof(header), sizeof(duration));
+    NS_ABORT_MSG_UNLESS(header[0] == 0x01020304, fileName << " has a different byte order");
+    NS_ABORT_MSG_UNLESS(header[1] == VERSION, fileName << " has unsupported version " << header[1]);
+
+    m_numOfFrames = header[2];
+    const uint32_t numOfSlices = header[3];
+    NS_ABORT_MSG_IF(m_numOfFrames == 0, fileName << " has no frame");
+    NS_ABORT_MSG_UNLESS(m_mappingSize == HEADER_SIZE + uint64_t(m_numOfFrames) * sizeof(Frame_t) +
+                                             uint64_t(numOfSlices) * sizeof(Slice_t),
+                        fileName << " has an invalid size");
+
+    // The header keeps the records aligned to 8 bytes.
+    m_frames = reinterpret_cast<const Frame_t*>(data + HEADER_SIZE);
+    m_slices = reinterpret_cast<const Slice_t*>(m_frames + m_numOfFrames);
+
+    for (uint32_t i = 0; i < m_numOfFrames; i++)
+    {
+        const Frame_t& frame = m_frames[i];
+        NS_ABORT_MSG_IF(frame.numOfSlices == 0 || frame.numOfSlices > 0xFFFF,
+                        fileName << " has an invalid number of slices in frame " << i);
+        NS_ABORT_MSG_IF(uint64_t(frame.firstSlice) + frame.numOfSlices > numOfSlices,
+                        fileName << " has invalid slices in frame " << i);
+        NS_ABORT_MSG_IF(i > 0 && frame.timestamp <= m_frames[i - 1].timestamp,
+                        fileName << " has a decreasing timestamp in frame " << i);
+    }
+    NS_ABORT_MSG_IF(duration <= m_frames[m_numOfFrames - 1].timestamp,
+                    fileName << " ends before its last frame");
+    m_lastInterval = NanoSeconds(duration - m_frames[m_numOfFrames - 1].timestamp);
+
+    NS_LOG_INFO(this << " mapped " << m_mappingSize << " bytes of " << fileName << " with "
+                     << m_numOfFrames << " frames and " << numOfSlices << " slices");
+
+} // end of `NrtvVideoTrace (std::string)`
+
+NrtvVideoTrace::~NrtvVideoTrace()
+{
+    NS_LOG_FUNCTION(this);
+    GetOpenTraces().erase(m_fileName);
+    munmap(m_mapping, m_mappingSize);
+}
+
+std::string
+NrtvVideoTrace::GetFileName() const
+{
+    return m_fileName;
+}
+
+uint32_t
+NrtvVideoTrace::GetNumOfFrames() const
+{
+    return m_numOfFrames;
+}
+
+Time
+NrtvVideoTrace::GetFrameInterval(uint32_t frame) const
+{
+    NS_ASSERT_MSG(frame < m_numOfFrames, "Invalid frame " << frame);
+    if (frame + 1 == m_numOfFrames)
+    {
+        return m_lastInterval;
+    }
+
+    return NanoSeconds(m_frames[frame + 1].timestamp - m_frames[frame].timestamp);
+}
+
+uint16_t
+NrtvVideoTrace::GetNumOfSlices(uint32_t frame) const
+{
+    NS_ASSERT_MSG(frame < m_numOfFrames, "Invalid frame " << frame);
+    return m_frames[frame].numOfSlices;
+}
+
+uint32_t
+NrtvVideoTrace::GetSliceSize(uint32_t frame, uint16_t slice) const
+{
+    return GetSlice(frame, slice).size;
+}
+
+Time
+NrtvVideoTrace::GetSliceEncodingDelay(uint32_t frame, uint16_t slice) const
+{
+    return MicroSeconds(GetSlice(frame, slice).encodingDelay);
+}
+
+const NrtvVideoTrace::Slice_t&
+NrtvVideoTrace::GetSlice(uint32_t frame, uint16_t slice) const
+{
+    NS_ASSERT_MSG(frame < m_numOfFrames, "Invalid frame " << frame);
+    NS_ASSERT_MSG(slice < m_frames[frame].numOfSlices,
+                  "Invalid slice " << slice << " of frame " << frame);
+    return m_slices[m_frames[frame].firstSlice + slice];
+}
+
+} // namespace ns3
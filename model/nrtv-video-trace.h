@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NRTV_VIDEO_TRACE_H
+#define NRTV_VIDEO_TRACE_H
+
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup nrtv
+ * \brief Read-only, memory-mapped video encoder trace, replayed by
+ *        NrtvVideoWorker instead of the random slice sizes and encoding delays
+ *        of NrtvVariables.
+ *
+ * The trace is opened using Open(), which maps the file into memory only once
+ * per file name, so that every worker using the same file shares the same
+ * pages. The trace is never copied nor modified, and every worker walks
+ * through it using its own frame index (see
+ * NrtvVariables::GetVideoTraceStartFrame()).
+ *
+ * All integers are in the byte order of the host, as written by Write(). The
+ * file begins with a header:
+ * - magic string `NRTVTRAC` (8 bytes);
+ * - byte order marker 0x01020304 (uint32);
+ * - format version, currently 1 (uint32);
+ * - number of frames, F (uint32);
+ * - total number of slices, S (uint32); and
+ * - duration of the trace in nanoseconds, i.e., the end of the last frame
+ *   (uint64).
+ *
+ * The header is followed by F frame records (see Frame_t) and then by S slice
+ * records (see Slice_t). The slices of a frame are consecutive in the slice
+ * records, and the timestamps of the frames are strictly increasing and
+ * less than the duration.
+ */
+class NrtvVideoTrace : public SimpleRefCount<NrtvVideoTrace>
+{
+  public:
+    /// The magic string at the beginning of the file.
+    static const char MAGIC[8];
+
+    /// Version of the file format.
+    static const uint32_t VERSION = 1;
+
+    /// A frame record of the trace file.
+    struct Frame_t
+    {
+        uint64_t timestamp;   ///< Start of the frame in nanoseconds since the first frame.
+        uint32_t firstSlice;  ///< Index of the first slice record of the frame.
+        uint32_t numOfSlices; ///< Number of slices in the frame, at least one.
+    };
+
+    /// A slice record of the trace file.
+    struct Slice_t
+    {
+        uint32_t size;          ///< Size of the slice content in bytes.
+        uint32_t encodingDelay; ///< Microseconds since the previous slice, or the frame start.
+    };
+
+    /**
+     * \brief Get the trace stored in a file, mapping the file into memory if it
+     *        is not in use yet.
+     * \param fileName name of the trace file.
+     * \return the trace, shared with every other user of the same file name
+     *
+     * The simulation is aborted if the file cannot be mapped or is not a valid
+     * trace file. The file is unmapped when the last user releases the trace.
+     */
+    static Ptr<NrtvVideoTrace> Open(std::string fileName);
+
+    /**
+     * \brief Write a trace file.
+     * \param fileName name of the output file.
+     * \param frameTimes start time of each frame, strictly increasing.
+     * \param frameSlices the slices of each frame, at least one per frame.
+     * \param duration end of the last frame, i.e., when the first frame is
+     *                 repeated after the last one.
+     *
+     * The file must not be in use by Open() at the same time.
+     */
+    static void Write(std::string fileName,
+                      const std::vector<Time>& frameTimes,
+                      const std::vector<std::vector<Slice_t>>& frameSlices,
+                      Time duration);
+
+    /// Unmap the file.
+    ~NrtvVideoTrace();
+
+    /// \return name of the trace file
+    std::string GetFileName() const;
+
+    /// \return number of frames in the trace, at least one
+    uint32_t GetNumOfFrames() const;
+
+    /**
+     * \param frame index of the frame, less than GetNumOfFrames().
+     * \return length of time until the next frame, where the frame after the
+     *         last one is the first one, due at the end of the trace
+     */
+    Time GetFrameInterval(uint32_t frame) const;
+
+    /**
+     * \param frame index of the frame, less than GetNumOfFrames().
+     * \return number of slices in the frame
+     */
+    uint16_t GetNumOfSlices(uint32_t frame) const;
+
+    /**
+     * \param frame index of the frame, less than GetNumOfFrames().
+     * \param slice index of the slice within the frame.
+     * \return size of the slice content in bytes
+     */
+    uint32_t GetSliceSize(uint32_t frame, uint16_t slice) const;
+
+    /**
+     * \param frame index of the frame, less than GetNumOfFrames().
+     * \param slice index of the slice within the frame.
+     * \return encoding delay since the previous slice, or the frame start
+     */
+    Time GetSliceEncodingDelay(uint32_t frame, uint16_t slice) const;
+
+  private:
+    /**
+     * \brief Map a trace file into memory and validate it.
+     * \param fileName name of the trace file.
+     */
+    NrtvVideoTrace(std::string fileName);
+
+    /**
+     * \param frame index of the frame.
+     * \param slice index of the slice within the frame.
+     * \return the slice record
+     */
+    const Slice_t& GetSlice(uint32_t frame, uint16_t slice) const;
+
+    std::string m_fileName;  ///< Name of the trace file.
+    void* m_mapping;         ///< Start of the mapped file.
+    uint64_t m_mappingSize;  ///< Size of the mapped file in bytes.
+    uint32_t m_numOfFrames;  ///< Number of frame records.
+    const Frame_t* m_frames; ///< Frame records inside the mapped file.
+    const Slice_t* m_slices; ///< Slice records inside the mapped file.
+    Time m_lastInterval;     ///< Interval between the last frame and the end of the trace.
+
+}; // end of `class NrtvVideoTrace`
+
+} // namespace ns3
+
+#endif /* NRTV_VIDEO_TRACE_H */
@@ -21,17 +21,25 @@
 
 #include "nrtv-video-worker.h"
 
+#include <ns3/abort.h>
 #include <ns3/boolean.h>
+#include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/nrtv-header.h>
 #include <ns3/nrtv-variables.h>
+#include <ns3/nrtv-video-trace.h>
 #include <ns3/packet.h>
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 #include <ns3/socket.h>
+#include <ns3/string.h>
 #include <ns3/uinteger.h>
 #include <ns3/unused.h>
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 NS_LOG_COMPONENT_DEFINE("NrtvVideoWorker");
 
 namespace ns3
@@ -50,26 +58,34 @@ NrtvVideoWorker::NrtvVideoWorker()
     NS_FATAL_ERROR("Default constructor not supported.");
 }
 
-NrtvVideoWorker::NrtvVideoWorker(Ptr<Socket> socket)
-    : m_socket(socket),
+NrtvVideoWorker::NrtvVideoWorker(Ptr<Socket> socket,
+                                 uint32_t handle,
+                                 Ptr<NrtvVariables> variables,
+                                 uint32_t nodeId)
+    : m_socket(),
+      m_handle(0),
+      m_isReleased(true),
       m_state(NrtvVideoWorker::NOT_READY),
+      m_numOfFrames(0),
       m_numOfFramesServed(0),
-      m_numOfSlicesServed(0)
+      m_numOfSlices(0),
+      m_numOfSlicesServed(0),
+      m_sliceBatching(false),
+      m_traceStartFrame(0),
+      m_traceFrame(0),
+      m_isResumed(false),
+      m_abrSafetyFactor(0.8),
+      m_qualityLevel(0),
+      m_abrTxBytes(0),
+      m_abrStallCount(0)
 {
-    NS_LOG_FUNCTION(this << socket);
+    NS_LOG_FUNCTION(this << socket << handle << variables << nodeId);
 
-    m_nrtvVariables = CreateObject<NrtvVariables>();
-    m_frameInterval = m_nrtvVariables->GetFrameInterval(); // frame rate
-    m_numOfFrames = m_nrtvVariables->GetNumOfFrames();     // length of video
-    NS_ASSERT(m_numOfFrames > 0);
-    m_numOfSlices = m_nrtvVariables->GetNumOfSlices(); // slices per frame
-    NS_ASSERT(m_numOfSlices > 0);
-    NS_LOG_INFO(this << " this video is " << m_numOfFrames << " frames long"
-                     << " (each frame is " << m_frameInterval.GetMilliSeconds()
-                     << " ms long and made of " << m_numOfSlices << " slices)");
-
-    socket->SetCloseCallbacks(MakeCallback(&NrtvVideoWorker::NormalCloseCallback, this),
-                              MakeCallback(&NrtvVideoWorker::ErrorCloseCallback, this));
+    m_nrtvVariables = (variables != nullptr) ? variables : CreateObject<NrtvVariables>();
+    TRAFFIC_COUNTERS_REGISTER(m_counters,
+                              "ns3::NrtvVideoWorker",
+                              (socket != nullptr) ? socket->GetNode()->GetId() : nodeId);
+    Reset(socket, handle);
 }
 
 void
@@ -77,13 +93,9 @@ NrtvVideoWorker::DoDispose()
 {
     NS_LOG_FUNCTION(this);
 
-    // close the socket
-    m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
-                                MakeNullCallback<void, Ptr<Socket>>());
-    m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     // m_socket->Close (); // Do not close the socket, leave it for the application.
-
-    CancelAllPendingEvents();
+    Release();
+    Object::DoDispose(); // chain up
 }
 
 TypeId
@@ -101,7 +113,45 @@ NrtvVideoWorker::GetTypeId()
                                           "Maximum size of a slice",
                                           UintegerValue(536),
                                           MakeUintegerAccessor(&NrtvVideoWorker::m_maxSliceSize),
-                                          MakeUintegerChecker<uint32_t>(200, 1500));
+                                          MakeUintegerChecker<uint32_t>(200, 1500))
+                            .AddAttribute("SliceBatching",
+                                          "If true, the encoding delays and sizes of all "
+                                          "slices of a frame are drawn at the start of the "
+                                          "frame and the slices are emitted by a single "
+                                          "self-rescheduling event. The transmitted slices "
+                                          "are identical to the per-slice mode.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&NrtvVideoWorker::m_sliceBatching),
+                                          MakeBooleanChecker())
+                            .AddAttribute("AbrQualityLevels",
+                                          "Comma-separated quality levels of the adaptive "
+                                          "bitrate mode in ascending order, each of them a "
+                                          "fraction in (0, 1] of the bitrate of the video, "
+                                          "e.g., \"0.25,0.5,1\". Empty string disables the "
+                                          "adaptive bitrate.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&NrtvVideoWorker::SetAbrQualityLevels,
+                                                             &NrtvVideoWorker::GetAbrQualityLevels),
+                                          MakeStringChecker())
+                            .AddAttribute("AbrSafetyFactor",
+                                          "The client falls behind if the throughput it "
+                                          "reports is less than this fraction of the bitrate "
+                                          "sent since its previous feedback.",
+                                          DoubleValue(0.8),
+                                          MakeDoubleAccessor(&NrtvVideoWorker::m_abrSafetyFactor),
+                                          MakeDoubleChecker<double>(0.0, 1.0))
+                            .AddAttribute("AbrLowBufferLevel",
+                                          "The quality goes down if the playout buffer level "
+                                          "reported by the client is below this.",
+                                          TimeValue(Seconds(2)),
+                                          MakeTimeAccessor(&NrtvVideoWorker::m_abrLowBufferLevel),
+                                          MakeTimeChecker())
+                            .AddAttribute("AbrHighBufferLevel",
+                                          "The quality may go up only if the playout buffer "
+                                          "level reported by the client is at least this.",
+                                          TimeValue(Seconds(4)),
+                                          MakeTimeAccessor(&NrtvVideoWorker::m_abrHighBufferLevel),
+                                          MakeTimeChecker());
     return tid;
 }
 
@@ -110,15 +160,29 @@ NrtvVideoWorker::ChangeState(SendState_t state)
 {
     if (m_state == state)
         return; // If state is not changed, do nothing
+    if (m_isReleased)
+    {
+        NS_LOG_LOGIC(this << " ignoring state change of a released worker");
+        return;
+    }
+    m_state = state;
     if (state == NrtvVideoWorker::READY)
     {
         // It is OK to start scheduling frames
-        m_eventNewFrame = Simulator::ScheduleNow(&NrtvVideoWorker::NewFrame, this);
+        if (m_isResumed)
+        {
+            m_eventNewFrame = Simulator::Schedule(m_resumeDelay, &NrtvVideoWorker::NewFrame, this);
+        }
+        else
+        {
+            m_eventNewFrame = Simulator::ScheduleNow(&NrtvVideoWorker::NewFrame, this);
+        }
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     }
     else
     {
         CancelAllPendingEvents(); // cancel any scheduled transmission
-        m_videoCompletedCallback(m_socket);
+        m_videoCompletedCallback(m_socket, m_handle);
     }
 }
 
@@ -129,11 +193,259 @@ NrtvVideoWorker::SetTxCallback(Callback<void, Ptr<Socket>, Ptr<const Packet>> ca
 }
 
 void
-NrtvVideoWorker::SetVideoCompletedCallback(Callback<void, Ptr<Socket>> callback)
+NrtvVideoWorker::SetVideoCompletedCallback(Callback<void, Ptr<Socket>, uint32_t> callback)
 {
     m_videoCompletedCallback = callback;
 }
 
+void
+NrtvVideoWorker::SetQualitySwitchCallback(
+    Callback<void, Ptr<Socket>, uint32_t, uint32_t> callback)
+{
+    m_qualitySwitchCallback = callback;
+}
+
+void
+NrtvVideoWorker::SetAbrQualityLevels(std::string levels)
+{
+    NS_LOG_FUNCTION(this << levels);
+
+    std::vector<double> values;
+    std::istringstream iss(levels);
+    std::string level;
+
+    while (std::getline(iss, level, ','))
+    {
+        const double value = std::stod(level);
+        NS_ABORT_MSG_UNLESS(value > 0.0 && value <= 1.0,
+                            "Invalid quality level " << value << " in " << levels);
+        NS_ABORT_MSG_IF(!values.empty() && value <= values.back(),
+                        "Quality levels " << levels << " are not in ascending order");
+        values.push_back(value);
+    }
+
+    m_abrLevelsString = levels;
+    m_abrLevels.swap(values);
+    m_qualityLevel = m_abrLevels.empty() ? 0 : m_abrLevels.size() - 1;
+}
+
+std::string
+NrtvVideoWorker::GetAbrQualityLevels() const
+{
+    return m_abrLevelsString;
+}
+
+// static
+bool
+NrtvVideoWorker::IsAbrEnabledByDefault()
+{
+    TypeId::AttributeInformation info;
+    if (!GetTypeId().LookupAttributeByName("AbrQualityLevels", &info))
+    {
+        NS_FATAL_ERROR("Missing attribute AbrQualityLevels");
+    }
+
+    // A single level cannot be switched, see ReceiveFeedback().
+    const std::string levels = info.initialValue->SerializeToString(info.checker);
+    return levels.find(',') != std::string::npos;
+}
+
+uint32_t
+NrtvVideoWorker::GetQualityLevel() const
+{
+    return m_qualityLevel;
+}
+
+void
+NrtvVideoWorker::ReceiveFeedback(uint64_t throughput, Time bufferLevel, uint32_t stallCount)
+{
+    NS_LOG_FUNCTION(this << throughput << bufferLevel.GetSeconds() << stallCount);
+
+    if (m_abrLevels.size() < 2 || m_isReleased)
+    {
+        return;
+    }
+
+    const Time elapsed = Simulator::Now() - m_abrLastFeedbackTime;
+    const bool hasStalled = stallCount > m_abrStallCount;
+    const uint32_t oldLevel = m_qualityLevel;
+    uint32_t level = oldLevel;
+
+    if (m_abrTxBytes > 0 && elapsed.IsStrictlyPositive())
+    {
+        const double bitrate = 8.0 * m_abrTxBytes / elapsed.GetSeconds();
+        const bool isBehind = throughput < m_abrSafetyFactor * bitrate;
+
+        if (isBehind && bufferLevel < m_abrHighBufferLevel)
+        {
+            // the highest lower level which the throughput can sustain
+            const double fullBitrate = bitrate / m_abrLevels[m_qualityLevel];
+            level = 0;
+            for (uint32_t i = 1; i < oldLevel; i++)
+            {
+                if (m_abrLevels[i] * fullBitrate <= throughput)
+                {
+                    level = i;
+                }
+            }
+        }
+        else if (!isBehind && !hasStalled && bufferLevel >= m_abrHighBufferLevel &&
+                 level + 1 < m_abrLevels.size())
+        {
+            level++; // one step at a time
+        }
+    }
+
+    if ((hasStalled || bufferLevel < m_abrLowBufferLevel) && level == oldLevel && level > 0)
+    {
+        level--;
+    }
+
+    m_abrTxBytes = 0;
+    m_abrLastFeedbackTime = Simulator::Now();
+    m_abrStallCount = stallCount;
+
+    if (level != oldLevel)
+    {
+        NS_LOG_INFO(this << " switching from quality level " << oldLevel << " ("
+                         << m_abrLevels[oldLevel] << ") to " << level << " ("
+                         << m_abrLevels[level] << ")");
+        m_qualityLevel = level;
+        if (!m_qualitySwitchCallback.IsNull())
+        {
+            m_qualitySwitchCallback(m_socket, oldLevel, level);
+        }
+    }
+
+} // end of `void ReceiveFeedback (uint64_t, Time, uint32_t)`
+
+uint32_t
+NrtvVideoWorker::GetHandle() const
+{
+    return m_handle;
+}
+
+bool
+NrtvVideoWorker::GetProgress(Progress_t& progress) const
+{
+    if (m_isReleased || m_state != NrtvVideoWorker::READY || m_numOfFramesServed == 0 ||
+        m_numOfFramesServed >= m_numOfFrames || Simulator::IsExpired(m_eventNewFrame))
+    {
+        return false;
+    }
+
+    progress.numOfFrames = m_numOfFrames;
+    progress.numOfFramesServed = m_numOfFramesServed;
+    progress.numOfSlices = m_numOfSlices;
+    progress.frameInterval = m_frameInterval;
+    progress.traceStartFrame = m_traceStartFrame;
+    progress.nextFrameDelay = Simulator::GetDelayLeft(m_eventNewFrame);
+    return true;
+}
+
+void
+NrtvVideoWorker::Resume(const Progress_t& progress)
+{
+    NS_LOG_FUNCTION(this << progress.numOfFramesServed << progress.numOfFrames);
+    NS_ASSERT_MSG(m_state == NrtvVideoWorker::NOT_READY,
+                  "The video cannot be resumed after it has started");
+    NS_ASSERT(progress.numOfFramesServed < progress.numOfFrames);
+
+    m_numOfFrames = progress.numOfFrames;
+    m_numOfFramesServed = progress.numOfFramesServed;
+    m_traceStartFrame = progress.traceStartFrame;
+    m_resumeDelay = progress.nextFrameDelay;
+    m_isResumed = true;
+
+    if (m_videoTrace == nullptr)
+    {
+        m_numOfSlices = progress.numOfSlices;
+        m_frameInterval = progress.frameInterval;
+    }
+
+    NS_ASSERT(m_numOfSlices > 0);
+    NS_LOG_INFO(this << " resuming the video at frame " << m_numOfFramesServed + 1 << " of "
+                     << m_numOfFrames << " in " << m_resumeDelay.GetMilliSeconds() << " ms");
+}
+
+void
+NrtvVideoWorker::Reset(Ptr<Socket> socket, uint32_t handle)
+{
+    NS_LOG_FUNCTION(this << socket << handle);
+
+    if (m_socket != nullptr && m_socket != socket)
+    {
+        Release(); // detach from the previous socket
+    }
+    else
+    {
+        CancelAllPendingEvents();
+    }
+
+    m_socket = socket;
+    m_handle = handle;
+    m_isReleased = false;
+    m_state = NrtvVideoWorker::NOT_READY;
+    m_numOfFramesServed = 0;
+    m_numOfSlicesServed = 0;
+    m_isResumed = false;
+    m_qualityLevel = m_abrLevels.empty() ? 0 : m_abrLevels.size() - 1;
+    m_abrTxBytes = 0;
+    m_abrLastFeedbackTime = Simulator::Now();
+    m_abrStallCount = 0;
+
+    m_nrtvVariablesView = m_nrtvVariables->CreateView();
+    m_numOfFrames = m_nrtvVariablesView->GetNumOfFrames(); // length of video
+    NS_ASSERT(m_numOfFrames > 0);
+    m_videoTrace = m_nrtvVariables->GetVideoTrace();
+
+    if (m_videoTrace == nullptr)
+    {
+        m_frameInterval = m_nrtvVariablesView->GetFrameInterval(); // frame rate
+        m_numOfSlices = m_nrtvVariablesView->GetNumOfSlices();     // slices per frame
+    }
+    else
+    {
+        // the first frame, the next ones are read by NewFrame ()
+        m_traceStartFrame = m_nrtvVariablesView->GetVideoTraceStartFrame();
+        m_traceFrame = m_traceStartFrame;
+        m_frameInterval = m_videoTrace->GetFrameInterval(m_traceFrame);
+        m_numOfSlices = m_videoTrace->GetNumOfSlices(m_traceFrame);
+        NS_LOG_INFO(this << " this video begins at frame " << m_traceStartFrame << " of "
+                         << m_videoTrace->GetFileName());
+    }
+
+    NS_ASSERT(m_numOfSlices > 0);
+    NS_LOG_INFO(this << " this video is " << m_numOfFrames << " frames long"
+                     << " (each frame is " << m_frameInterval.GetMilliSeconds()
+                     << " ms long and made of " << m_numOfSlices << " slices)");
+
+    if (socket != nullptr)
+    {
+        socket->SetCloseCallbacks(MakeCallback(&NrtvVideoWorker::NormalCloseCallback, this),
+                                  MakeCallback(&NrtvVideoWorker::ErrorCloseCallback, this));
+    }
+
+} // end of `void Reset (Ptr<Socket>, uint32_t)`
+
+void
+NrtvVideoWorker::Release()
+{
+    NS_LOG_FUNCTION(this);
+
+    CancelAllPendingEvents();
+    m_state = NrtvVideoWorker::NOT_READY;
+    m_isReleased = true;
+
+    if (m_socket != nullptr)
+    {
+        m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                    MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        m_socket = nullptr;
+    }
+}
+
 void
 NrtvVideoWorker::NormalCloseCallback(Ptr<Socket> socket)
 {
@@ -143,7 +455,7 @@ NrtvVideoWorker::NormalCloseCallback(Ptr<Socket> socket)
                             << "but socket " << socket << " is received");
     m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     CancelAllPendingEvents(); // cancel any scheduled transmission
-    m_videoCompletedCallback(m_socket);
+    m_videoCompletedCallback(m_socket, m_handle);
 }
 
 void
@@ -155,7 +467,7 @@ NrtvVideoWorker::ErrorCloseCallback(Ptr<Socket> socket)
                             << "but socket " << socket << " is received");
     m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
     CancelAllPendingEvents(); // cancel any scheduled transmission
-    m_videoCompletedCallback(m_socket);
+    m_videoCompletedCallback(m_socket, m_handle);
 }
 
 void
@@ -175,6 +487,7 @@ NrtvVideoWorker::ScheduleNewFrame()
     NS_ASSERT(frameNumber <= m_numOfFrames);
 
     m_eventNewFrame = Simulator::Schedule(m_frameInterval, &NrtvVideoWorker::NewFrame, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     NS_LOG_INFO(this << " video frame " << frameNumber << " will be generated in "
                      << m_frameInterval.GetSeconds() << " seconds");
 }
@@ -185,6 +498,15 @@ NrtvVideoWorker::NewFrame()
     m_numOfFramesServed++;
     NS_LOG_FUNCTION(this << m_numOfFramesServed << m_numOfFrames);
 
+    if (m_videoTrace != nullptr)
+    {
+        // the trace wraps around if the video is longer than the trace
+        m_traceFrame =
+            (m_traceStartFrame + m_numOfFramesServed - 1) % m_videoTrace->GetNumOfFrames();
+        m_frameInterval = m_videoTrace->GetFrameInterval(m_traceFrame);
+        m_numOfSlices = m_videoTrace->GetNumOfSlices(m_traceFrame);
+    }
+
     if (m_numOfFramesServed < m_numOfFrames)
     {
         ScheduleNewFrame(); // schedule the next frame
@@ -194,10 +516,19 @@ NrtvVideoWorker::NewFrame()
         // inform the server instance
         NS_LOG_INFO(this << " no more frame after this");
         m_eventNewFrame = Simulator::Schedule(m_frameInterval, &NrtvVideoWorker::EndVideo, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     }
 
     m_numOfSlicesServed = 0;
-    ScheduleNewSlice(); // the first slice of this frame
+
+    if (m_sliceBatching)
+    {
+        ScheduleBatchedSlices(); // all slices of this frame
+    }
+    else
+    {
+        ScheduleNewSlice(); // the first slice of this frame
+    }
 }
 
 void
@@ -207,7 +538,7 @@ NrtvVideoWorker::ScheduleNewSlice()
     NS_LOG_FUNCTION(this << sliceNumber << m_numOfSlices);
     NS_ASSERT(sliceNumber <= m_numOfSlices);
 
-    const Time encodingDelay = m_nrtvVariables->GetSliceEncodingDelay();
+    const Time encodingDelay = GetSliceEncodingDelay(m_numOfSlicesServed);
     NS_LOG_DEBUG(this << " encoding the slice needs " << encodingDelay.GetMilliSeconds() << " ms,"
                       << " while new frame is coming in "
                       << Simulator::GetDelayLeft(m_eventNewFrame).GetMilliSeconds() << " ms");
@@ -218,6 +549,7 @@ NrtvVideoWorker::ScheduleNewSlice()
         NS_LOG_INFO(this << " video slice " << sliceNumber << " will be generated in "
                          << encodingDelay.GetMilliSeconds() << " ms");
         m_eventNewSlice = Simulator::Schedule(encodingDelay, &NrtvVideoWorker::NewSlice, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
     }
     else
     {
@@ -232,21 +564,105 @@ NrtvVideoWorker::NewSlice()
     m_numOfSlicesServed++;
     NS_LOG_FUNCTION(this << m_numOfSlicesServed << m_numOfSlices);
 
-    const uint32_t socketSize = m_socket->GetTxAvailable();
-    NS_LOG_DEBUG(this << " socket has " << socketSize << " bytes available for Tx");
+    SendSlice(GetSliceSize(m_numOfSlicesServed - 1));
 
-    const uint32_t sliceSize = m_nrtvVariables->GetSliceSize();
-    NS_LOG_INFO(this << " video slice " << m_numOfSlicesServed << " is " << sliceSize << " bytes");
+    // make way for the next slice
+    if (m_numOfSlicesServed < m_numOfSlices)
+    {
+        ScheduleNewSlice();
+    }
 
-    NrtvHeader nrtvHeader;
+} // end of `void NewSlice ()`
+
+void
+NrtvVideoWorker::ScheduleBatchedSlices()
+{
+    NS_LOG_FUNCTION(this << m_numOfFramesServed);
+    NS_ASSERT(m_numOfSlicesServed == 0);
 
-    const uint32_t headerSize = nrtvHeader.GetSerializedSize();
-    const uint32_t contentSize = std::min(sliceSize, socketSize - headerSize);
     /*
-     * We simply assume that our packets are rather small and the socket will
-     * always has space to fit these packets.
+     * Each slice is due after the encoding delay since the previous slice, and
+     * only while it is due before the next frame. The first delay which does
+     * not fit is drawn as well, as in the per-slice mode, so that both modes
+     * consume the same random numbers.
      */
-    NS_ASSERT_MSG(contentSize == sliceSize, "Socket size is too small");
+    const Time frameLeft = Simulator::GetDelayLeft(m_eventNewFrame);
+    Time elapsed = Seconds(0);
+    m_batchedDelays.clear();
+    m_batchedSizes.clear();
+
+    while (m_batchedDelays.size() < m_numOfSlices)
+    {
+        const Time encodingDelay = GetSliceEncodingDelay(m_batchedDelays.size());
+        if (encodingDelay >= frameLeft - elapsed)
+        {
+            break; // not enough time for another slice
+        }
+        elapsed += encodingDelay;
+        m_batchedDelays.push_back(encodingDelay);
+    }
+
+    for (uint32_t i = 0; i < m_batchedDelays.size(); i++)
+    {
+        m_batchedSizes.push_back(GetSliceSize(i));
+    }
+
+    NS_LOG_INFO(this << " " << m_batchedDelays.size() << " video slices will be generated"
+                     << " in the next " << elapsed.GetMilliSeconds() << " ms, "
+                     << (m_numOfSlices - m_batchedDelays.size()) << " slices are skipped");
+
+    if (!m_batchedDelays.empty())
+    {
+        m_eventNewSlice =
+            Simulator::Schedule(m_batchedDelays[0], &NrtvVideoWorker::NewBatchedSlice, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+    }
+
+} // end of `void ScheduleBatchedSlices ()`
+
+void
+NrtvVideoWorker::NewBatchedSlice()
+{
+    NS_ASSERT(m_numOfSlicesServed < m_batchedSizes.size());
+    const uint32_t sliceSize = m_batchedSizes[m_numOfSlicesServed];
+    m_numOfSlicesServed++;
+    NS_LOG_FUNCTION(this << m_numOfSlicesServed << m_batchedSizes.size());
+
+    SendSlice(sliceSize);
+
+    // the cursor moves on to the next pre-drawn slice
+    if (m_numOfSlicesServed < m_batchedDelays.size())
+    {
+        m_eventNewSlice = Simulator::Schedule(m_batchedDelays[m_numOfSlicesServed],
+                                              &NrtvVideoWorker::NewBatchedSlice,
+                                              this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+    }
+}
+
+void
+NrtvVideoWorker::SendSlice(uint32_t sliceSize)
+{
+    NS_LOG_FUNCTION(this << sliceSize);
+    NS_LOG_INFO(this << " video slice " << m_numOfSlicesServed << " is " << sliceSize << " bytes");
+
+    NrtvHeader nrtvHeader;
+
+    const uint32_t headerSize = NrtvHeader::GetStaticSerializedSize();
+    uint32_t contentSize = sliceSize;
+
+    if (m_socket != nullptr)
+    {
+        const uint32_t socketSize = m_socket->GetTxAvailable();
+        NS_LOG_DEBUG(this << " socket has " << socketSize << " bytes available for Tx");
+        contentSize = std::min(sliceSize, socketSize - headerSize);
+        /*
+         * We simply assume that our packets are rather small and the socket will
+         * always has space to fit these packets.
+         */
+        NS_ASSERT_MSG(contentSize == sliceSize, "Socket size is too small");
+        NS_ASSERT((contentSize + headerSize) <= socketSize);
+    }
 
     nrtvHeader.SetFrameNumber(m_numOfFramesServed);
     nrtvHeader.SetNumOfFrames(m_numOfFrames);
@@ -256,15 +672,23 @@ NrtvVideoWorker::NewSlice()
 
     Ptr<Packet> packet = Create<Packet>(contentSize);
     packet->AddHeader(nrtvHeader);
+    TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
 
     const uint32_t packetSize = packet->GetSize();
     NS_ASSERT(packetSize == (contentSize + headerSize));
-    NS_ASSERT(packetSize <= socketSize);
+    m_abrTxBytes += packetSize;
     // NS_ASSERT_MSG (packetSize <= m_maxSliceSize, // hard-coded MTU size 536
     //                "Packet size shall not be larger than MTU size");
 
     NS_LOG_INFO(this << " created packet " << packet << " of " << packetSize << " bytes");
 
+    if (m_socket == nullptr)
+    {
+        // a pure generator, delivering the packet is up to the Tx callback
+        m_txCallback(m_socket, packet);
+        return;
+    }
+
 #ifdef NS3_LOG_ENABLE
     const int actualBytes = m_socket->Send(packet);
     NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packetSize << " bytes,"
@@ -285,19 +709,41 @@ NrtvVideoWorker::NewSlice()
 
     m_txCallback(m_socket, packet);
 
-    // make way for the next slice
-    if (m_numOfSlicesServed < m_numOfSlices)
+} // end of `void SendSlice (uint32_t)`
+
+Time
+NrtvVideoWorker::GetSliceEncodingDelay(uint16_t slice)
+{
+    if (m_videoTrace != nullptr)
     {
-        ScheduleNewSlice();
+        return m_videoTrace->GetSliceEncodingDelay(m_traceFrame, slice);
     }
 
-} // end of `void NewSlice ()`
+    return m_nrtvVariablesView->GetSliceEncodingDelay();
+}
+
+uint32_t
+NrtvVideoWorker::GetSliceSize(uint16_t slice)
+{
+    const uint32_t sliceSize = (m_videoTrace != nullptr)
+                                   ? m_videoTrace->GetSliceSize(m_traceFrame, slice)
+                                   : m_nrtvVariablesView->GetSliceSize();
+
+    if (m_abrLevels.empty())
+    {
+        return sliceSize;
+    }
+
+    // the quality level scales the bitrate, but every slice is still sent
+    const double scaled = std::round(sliceSize * m_abrLevels[m_qualityLevel]);
+    return std::max<uint32_t>(1, static_cast<uint32_t>(scaled));
+}
 
 void
 NrtvVideoWorker::EndVideo()
 {
     NS_LOG_FUNCTION(this);
-    m_videoCompletedCallback(m_socket);
+    m_videoCompletedCallback(m_socket, m_handle);
 }
 
 void
@@ -320,4 +766,100 @@ NrtvVideoWorker::CancelAllPendingEvents()
     }
 }
 
+// WORKER POOL //////////////////////////////////////////////////////////////
+
+NrtvVideoWorkerPool::NrtvVideoWorkerPool()
+    : m_nodeId(0),
+      m_numOfCreatedWorkers(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrtvVideoWorkerPool::SetTxCallback(Callback<void, Ptr<Socket>, Ptr<const Packet>> callback)
+{
+    m_txCallback = callback;
+}
+
+void
+NrtvVideoWorkerPool::SetVideoCompletedCallback(Callback<void, Ptr<Socket>, uint32_t> callback)
+{
+    m_videoCompletedCallback = callback;
+}
+
+void
+NrtvVideoWorkerPool::SetQualitySwitchCallback(
+    Callback<void, Ptr<Socket>, uint32_t, uint32_t> callback)
+{
+    m_qualitySwitchCallback = callback;
+}
+
+void
+NrtvVideoWorkerPool::SetVariables(Ptr<NrtvVariables> variables)
+{
+    NS_LOG_FUNCTION(this << variables);
+    m_variables = variables;
+}
+
+void
+NrtvVideoWorkerPool::SetNodeId(uint32_t nodeId)
+{
+    NS_LOG_FUNCTION(this << nodeId);
+    m_nodeId = nodeId;
+}
+
+Ptr<NrtvVideoWorker>
+NrtvVideoWorkerPool::Acquire(Ptr<Socket> socket, uint32_t handle)
+{
+    NS_LOG_FUNCTION(this << socket << handle);
+
+    if (m_idleWorkers.empty())
+    {
+        Ptr<NrtvVideoWorker> worker =
+            CreateObject<NrtvVideoWorker>(socket, handle, m_variables, m_nodeId);
+        worker->SetTxCallback(m_txCallback);
+        worker->SetVideoCompletedCallback(m_videoCompletedCallback);
+        worker->SetQualitySwitchCallback(m_qualitySwitchCallback);
+        m_numOfCreatedWorkers++;
+        NS_LOG_INFO(this << " created worker " << worker << " ("
+                         << m_numOfCreatedWorkers << " workers so far)");
+        return worker;
+    }
+
+    Ptr<NrtvVideoWorker> worker = m_idleWorkers.back();
+    m_idleWorkers.pop_back();
+    worker->Reset(socket, handle);
+    NS_LOG_INFO(this << " reusing worker " << worker << " (" << m_idleWorkers.size()
+                     << " idle workers left)");
+    return worker;
+}
+
+void
+NrtvVideoWorkerPool::Release(Ptr<NrtvVideoWorker> worker)
+{
+    NS_LOG_FUNCTION(this << worker);
+    NS_ASSERT(worker != nullptr);
+    worker->Release();
+    m_idleWorkers.push_back(worker);
+}
+
+void
+NrtvVideoWorkerPool::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_idleWorkers.clear(); // idle workers have no socket and no pending event
+}
+
+uint32_t
+NrtvVideoWorkerPool::GetNumOfIdleWorkers() const
+{
+    return m_idleWorkers.size();
+}
+
+uint32_t
+NrtvVideoWorkerPool::GetNumOfCreatedWorkers() const
+{
+    return m_numOfCreatedWorkers;
+}
+
 } // namespace ns3
@@ -27,6 +27,10 @@
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
+#include <ns3/traffic-counters.h>
+
+#include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -34,6 +38,8 @@ namespace ns3
 class Socket;
 class Packet;
 class NrtvVariables;
+class NrtvVariablesView;
+class NrtvVideoTrace;
 
 /**
  * \internal
@@ -49,6 +55,14 @@ class NrtvVideoWorker : public Object
      * \param socket pointer to the socket (must be already connected to a
      *               destination client) that will be utilized by the worker to
      *               send video packets
+     * \param handle an arbitrary value identifying the client, which is
+     *               passed to the video completed callback
+     * \param variables the random variable collection to draw from through a
+     *                  new view for every video, or null to create a private
+     *                  collection
+     * \param nodeId ID of the node of the server, under which the
+     *               instrumentation counters are registered if \a socket is
+     *               null, as for the shared stream of NrtvUdpServer
      *
      * The worker will determine the length of video using NrtvVariables class.
      * Other variables are also retrieved from this class, such as number of
@@ -66,13 +80,50 @@ class NrtvVideoWorker : public Object
      * remaining unsent slices would be discarded, without postponing the start
      * time of the next frame.
      *
+     * When the `SliceBatching` attribute is enabled, the encoding delays and the
+     * sizes of all the slices of a frame are drawn at once at the start of the
+     * frame, and the slices are then emitted by a single self-rescheduling event
+     * which walks through the pre-drawn values. The transmitted slices and
+     * their timing are identical to the default per-slice mode.
+     *
+     * If the NrtvVariables instance has a video trace (see its
+     * `VideoTraceFile` attribute), the frame intervals, the number of slices
+     * of each frame, the encoding delays, and the slice sizes are read from the
+     * trace instead, starting from a random frame of the trace and wrapping
+     * around at its end. The trace is shared by all workers, each of them only
+     * keeping its own frame index.
+     *
      * Each slice sent will invoke the callback function specified using
      * SetTxCallback(). After all the frames have been transmitted, another
      * callback function, specified using SetVideoCompletedCallback(), will be
      * invoked.
+     *
+     * Instead of destroying the worker after the video, the worker can be
+     * recycled for another video by using Release() and Reset(), which is what
+     * NrtvVideoWorkerPool does.
+     *
+     * If the `AbrQualityLevels` attribute is set, the worker supports adaptive
+     * bitrate (ABR) streaming. Each quality level is a fraction of the bitrate
+     * of the video, which scales the size of every slice. The video begins at
+     * the highest level, and ReceiveFeedback() then switches between the levels
+     * based on the throughput and the playout buffer level reported by the
+     * client (see NrtvTcpClient). If the client receives less than
+     * `AbrSafetyFactor` of the bitrate sent since its previous feedback, and
+     * the buffer is below `AbrHighBufferLevel`, the quality goes down to the
+     * highest level which the reported throughput can sustain. The quality also
+     * goes down by one level if the buffer falls below `AbrLowBufferLevel` or
+     * the playout has stalled, and goes up by one level at a time only while
+     * the client keeps up and the buffer is at least at `AbrHighBufferLevel`.
+     *
+     * The progress of a video can be taken by GetProgress() and given to
+     * another worker by Resume(), which is how NrtvTcpServer saves and restores
+     * its checkpoints.
      */
     NrtvVideoWorker();
-    NrtvVideoWorker(Ptr<Socket> socket);
+    NrtvVideoWorker(Ptr<Socket> socket,
+                    uint32_t handle = 0,
+                    Ptr<NrtvVariables> variables = nullptr,
+                    uint32_t nodeId = 0);
 
     enum SendState_t
     {
@@ -82,6 +133,36 @@ class NrtvVideoWorker : public Object
 
     void ChangeState(SendState_t state);
 
+    /// Progress of a video in the middle of its transmission.
+    struct Progress_t
+    {
+        uint32_t numOfFrames;       ///< Length of the video in frames.
+        uint32_t numOfFramesServed; ///< Number of frames already started.
+        uint16_t numOfSlices;       ///< Number of slices in one frame, unless traced.
+        Time frameInterval;         ///< Length of time between frames, unless traced.
+        uint32_t traceStartFrame;   ///< Index of the trace frame where the video begins.
+        Time nextFrameDelay;        ///< Time left until the next frame.
+    };
+
+    /**
+     * \param[out] progress the progress of the current video
+     * \return true if the video is in the middle of its transmission, i.e., at
+     *         least one frame has been started and the next frame is pending
+     */
+    bool GetProgress(Progress_t& progress) const;
+
+    /**
+     * \brief Continue a video from the progress taken by GetProgress(), e.g.,
+     *        in an earlier run.
+     * \param progress the progress of the video
+     *
+     * Must be invoked after Reset() and before the worker becomes `READY`. The
+     * length and the variables of the video drawn by Reset() are replaced, and
+     * the first frame is the one following the frame which was in progress,
+     * starting after the time left until it.
+     */
+    void Resume(const Progress_t& progress);
+
     // inherited from ObjectBase base class
     static TypeId GetTypeId();
 
@@ -93,11 +174,94 @@ class NrtvVideoWorker : public Object
 
     /**
      * \param callback this function is invoked after a whole video has been
-     *                 transmitted
+     *                 transmitted, with the socket and the handle of the
+     *                 worker as arguments
      *
      * After a video is completed, the worker will stay idle indefinitely.
      */
-    void SetVideoCompletedCallback(Callback<void, Ptr<Socket>> callback);
+    void SetVideoCompletedCallback(Callback<void, Ptr<Socket>, uint32_t> callback);
+
+    /**
+     * \param callback this function is invoked after the quality level has
+     *                 been switched by ReceiveFeedback(), with the socket, the
+     *                 old level, and the new level as arguments
+     */
+    void SetQualitySwitchCallback(Callback<void, Ptr<Socket>, uint32_t, uint32_t> callback);
+
+    /**
+     * \param levels comma-separated list of quality levels in ascending order,
+     *               each of them a fraction in (0, 1] of the bitrate of the
+     *               video, e.g., "0.25,0.5,1", or an empty string to disable
+     *               the adaptive bitrate
+     */
+    void SetAbrQualityLevels(std::string levels);
+
+    /**
+     * \return the quality levels, in the format of the `AbrQualityLevels`
+     *         attribute
+     */
+    std::string GetAbrQualityLevels() const;
+
+    /**
+     * \return true if the default value of the `AbrQualityLevels` attribute,
+     *         which is given to the workers created by NrtvVideoWorkerPool,
+     *         enables the adaptive bitrate
+     */
+    static bool IsAbrEnabledByDefault();
+
+    /**
+     * \return the index of the current quality level, or zero if the adaptive
+     *         bitrate is disabled
+     */
+    uint32_t GetQualityLevel() const;
+
+    /**
+     * \brief Adapt the quality level to the feedback of the client.
+     * \param throughput the throughput measured by the client in bits per
+     *                   second
+     * \param bufferLevel the length of the frames in the playout buffer of the
+     *                    client
+     * \param stallCount the number of stalls of the current video so far
+     *
+     * Does nothing if the adaptive bitrate is disabled.
+     */
+    void ReceiveFeedback(uint64_t throughput, Time bufferLevel, uint32_t stallCount);
+
+    /**
+     * \return the handle given in the last Reset(), which is an arbitrary
+     *         value the server uses to identify the client of this worker
+     */
+    uint32_t GetHandle() const;
+
+    /**
+     * \brief Prepare the worker for a new video, to be transmitted through the
+     *        given socket.
+     * \param socket pointer to the socket (must be already connected to a
+     *               destination client)
+     * \param handle an arbitrary value identifying the client, which is
+     *               passed to the video completed callback
+     *
+     * If the socket is null, the worker acts as a pure generator of video
+     * slices: the packets are not sent anywhere, but only passed to the
+     * callback given by SetTxCallback(), which is responsible for delivering
+     * them, e.g., to several clients.
+     *
+     * Any ongoing transmission is cancelled. The length of the new video and the
+     * other video variables are drawn again from the same NrtvVariables
+     * instance, through a new view (see NrtvVariables::CreateView()), and the
+     * worker goes back to the `NOT_READY` state. The callbacks given by
+     * SetTxCallback() and SetVideoCompletedCallback() are retained.
+     */
+    void Reset(Ptr<Socket> socket, uint32_t handle = 0);
+
+    /**
+     * \brief Detach the worker from its socket and cancel any ongoing
+     *        transmission, so that the worker becomes idle until the next
+     *        Reset().
+     *
+     * The socket is not closed, it is left for the application.
+     */
+    void Release();
 
   protected:
     /// Instance destructor, will close the socket.
@@ -117,6 +281,37 @@ class NrtvVideoWorker : public Object
     void NewFrame();
     void ScheduleNewSlice();
     void NewSlice();
+
+    /**
+     * \brief Draw the encoding delays and sizes of the slices of the current
+     *        frame, and schedule the first slice. Used in `SliceBatching` mode.
+     */
+    void ScheduleBatchedSlices();
+
+    /**
+     * \brief Send the next pre-drawn slice and schedule the one after it. Used
+     *        in `SliceBatching` mode.
+     */
+    void NewBatchedSlice();
+
+    /**
+     * \brief Send a single video slice through the socket.
+     * \param sliceSize the size of the slice content, excluding the header
+     */
+    void SendSlice(uint32_t sliceSize);
+
+    /**
+     * \param slice index of the slice within the current frame
+     * \return the encoding delay of the slice, from the video trace if any
+     */
+    Time GetSliceEncodingDelay(uint16_t slice);
+
+    /**
+     * \param slice index of the slice within the current frame
+     * \return the size of the slice, from the video trace if any
+     */
+    uint32_t GetSliceSize(uint16_t slice);
+
     void EndVideo();
     void CancelAllPendingEvents();
 
@@ -125,11 +320,14 @@ class NrtvVideoWorker : public Object
     EventId m_eventNewFrame;
     EventId m_eventNewSlice;
 
-    Ptr<Socket> m_socket;               ///< Pointer to the socket for transmission.
-    Ptr<NrtvVariables> m_nrtvVariables; ///< Pointer to a NRTV variable collection.
-    uint32_t m_maxSliceSize;            ///< The maximum slice size in bytes.
+    Ptr<Socket> m_socket;                       ///< Pointer to the socket for transmission.
+    Ptr<NrtvVariables> m_nrtvVariables;         ///< Pointer to a NRTV variable collection.
+    Ptr<NrtvVariablesView> m_nrtvVariablesView; ///< View for the current video.
+    uint32_t m_maxSliceSize;                    ///< The maximum slice size in bytes.
     Callback<void, Ptr<Socket>, Ptr<const Packet>> m_txCallback;
-    Callback<void, Ptr<Socket>> m_videoCompletedCallback;
+    Callback<void, Ptr<Socket>, uint32_t> m_videoCompletedCallback;
+    uint32_t m_handle;   ///< Identifies the client, given by the server.
+    bool m_isReleased;   ///< True after Release(), until the next Reset().
     SendState_t m_state; ///< State for checking if the video worker can start sending packets
 
     /// Length of time between consecutive frames.
@@ -143,8 +341,148 @@ class NrtvVideoWorker : public Object
     /// The number of slices that has been sent, resets to 0 after completing a frame.
     uint16_t m_numOfSlicesServed;
 
+    /// `SliceBatching` attribute.
+    bool m_sliceBatching;
+    /// Pre-drawn encoding delays of the slices of the current frame.
+    std::vector<Time> m_batchedDelays;
+    /// Pre-drawn sizes of the slices of the current frame.
+    std::vector<uint32_t> m_batchedSizes;
+
+    /// The video trace to replay, or null to draw the slices.
+    Ptr<const NrtvVideoTrace> m_videoTrace;
+    /// Index of the trace frame where the current video begins.
+    uint32_t m_traceStartFrame;
+    /// Index of the trace frame being transmitted.
+    uint32_t m_traceFrame;
+
+    /// True if the current video has been given by Resume().
+    bool m_isResumed;
+    /// Delay of the first frame of a resumed video.
+    Time m_resumeDelay;
+
+    /// Invoked after switching the quality level.
+    Callback<void, Ptr<Socket>, uint32_t, uint32_t> m_qualitySwitchCallback;
+    /// `AbrQualityLevels` attribute.
+    std::string m_abrLevelsString;
+    /// Bitrate fraction of each quality level, empty if ABR is disabled.
+    std::vector<double> m_abrLevels;
+    /// `AbrSafetyFactor` attribute.
+    double m_abrSafetyFactor;
+    /// `AbrLowBufferLevel` attribute.
+    Time m_abrLowBufferLevel;
+    /// `AbrHighBufferLevel` attribute.
+    Time m_abrHighBufferLevel;
+    /// Index of the current quality level in #m_abrLevels.
+    uint32_t m_qualityLevel;
+    /// Bytes sent since the previous feedback.
+    uint64_t m_abrTxBytes;
+    /// Time of the previous feedback, or of the start of the video.
+    Time m_abrLastFeedbackTime;
+    /// Number of stalls reported by the previous feedback.
+    uint32_t m_abrStallCount;
+
+    /// Instrumentation counters (if enabled), kept across reuse by the pool.
+    TRAFFIC_COUNTERS_DECLARE(m_counters)
+
 }; // end of `class NrtvVideoWorker`
 
+/**
+ * \internal
+ * \ingroup nrtv
+ * \brief Keeps idle NrtvVideoWorker instances so that a server can reuse them
+ *        for new videos, instead of creating a new worker for every video.
+ *
+ * Every worker created by the pool is bound once to the callbacks given by
+ * SetTxCallback() and SetVideoCompletedCallback(). A worker is taken from the
+ * pool using Acquire() and given back using Release().
+ */
+class NrtvVideoWorkerPool
+{
+  public:
+    /// Creates an empty pool.
+    NrtvVideoWorkerPool();
+
+    /**
+     * \param callback this function is given to every worker created by the
+     *                 pool, see NrtvVideoWorker::SetTxCallback()
+     */
+    void SetTxCallback(Callback<void, Ptr<Socket>, Ptr<const Packet>> callback);
+
+    /**
+     * \param callback this function is given to every worker created by the
+     *                 pool, see NrtvVideoWorker::SetVideoCompletedCallback()
+     */
+    void SetVideoCompletedCallback(Callback<void, Ptr<Socket>, uint32_t> callback);
+
+    /**
+     * \param callback this function is given to every worker created by the
+     *                 pool, see NrtvVideoWorker::SetQualitySwitchCallback()
+     */
+    void SetQualitySwitchCallback(Callback<void, Ptr<Socket>, uint32_t, uint32_t> callback);
+
+    /**
+     * \param variables the random variable collection given to every worker
+     *                  created by the pool afterwards, or null to let each
+     *                  worker create a private collection
+     */
+    void SetVariables(Ptr<NrtvVariables> variables);
+
+    /**
+     * \param nodeId ID of the node of the server, given to every worker
+     *               created by the pool afterwards, see
+     *               NrtvVideoWorker::NrtvVideoWorker()
+     */
+    void SetNodeId(uint32_t nodeId);
+
+    /**
+     * \brief Take an idle worker from the pool, or create a new one if the pool
+     *        is empty, and prepare it for a new video.
+     * \param socket pointer to the socket (must be already connected to a
+     *               destination client), or null for a worker without a
+     *               socket of its own
+     * \param handle an arbitrary value identifying the client, see
+     *               NrtvVideoWorker::Reset()
+     * \return the worker, in `NOT_READY` state
+     */
+    Ptr<NrtvVideoWorker> Acquire(Ptr<Socket> socket, uint32_t handle = 0);
+
+    /**
+     * \brief Detach a worker from its socket and put it back into the pool.
+     * \param worker a worker previously returned by Acquire()
+     */
+    void Release(Ptr<NrtvVideoWorker> worker);
+
+    /// Drop all the idle workers in the pool.
+    void Clear();
+
+    /**
+     * \return the number of idle workers kept in the pool
+     */
+    uint32_t GetNumOfIdleWorkers() const;
+
+    /**
+     * \return the number of workers created by the pool so far
+     */
+    uint32_t GetNumOfCreatedWorkers() const;
+
+  private:
+    /// Idle workers, ready to be acquired.
+    std::vector<Ptr<NrtvVideoWorker>> m_idleWorkers;
+    /// Given to every worker created by the pool.
+    Callback<void, Ptr<Socket>, Ptr<const Packet>> m_txCallback;
+    /// Given to every worker created by the pool.
+    Callback<void, Ptr<Socket>, uint32_t> m_videoCompletedCallback;
+    /// Given to every worker created by the pool.
+    Callback<void, Ptr<Socket>, uint32_t, uint32_t> m_qualitySwitchCallback;
+    /// Given to every worker created by the pool.
+    Ptr<NrtvVariables> m_variables;
+    /// Given to every worker created by the pool.
+    uint32_t m_nodeId;
+    /// Number of workers created by the pool so far.
+    uint32_t m_numOfCreatedWorkers;
+
+}; // end of `class NrtvVideoWorkerPool`
+
 } // namespace ns3
 
 #endif /* NRTV_VIDEO_WORKER_H */
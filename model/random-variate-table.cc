@@ -0,0 +1,216 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "random-variate-table.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("RandomVariateTable");
+
+namespace ns3
+{
+
+RandomVariateTable::RandomVariateTable(Ptr<ParetoRandomVariable> source, uint32_t blockSize)
+    : m_distribution(PARETO),
+      m_pareto(source),
+      m_source(source)
+{
+    NS_LOG_FUNCTION(this << source << blockSize);
+    Initialize(blockSize);
+}
+
+RandomVariateTable::RandomVariateTable(Ptr<LogNormalRandomVariable> source, uint32_t blockSize)
+    : m_distribution(LOG_NORMAL),
+      m_logNormal(source),
+      m_source(source)
+{
+    NS_LOG_FUNCTION(this << source << blockSize);
+    Initialize(blockSize);
+}
+
+RandomVariateTable::RandomVariateTable(Ptr<ExponentialRandomVariable> source, uint32_t blockSize)
+    : m_distribution(EXPONENTIAL),
+      m_exponential(source),
+      m_source(source)
+{
+    NS_LOG_FUNCTION(this << source << blockSize);
+    Initialize(blockSize);
+}
+
+void
+RandomVariateTable::Initialize(uint32_t blockSize)
+{
+    NS_ASSERT(m_source != nullptr);
+    NS_ASSERT_MSG(blockSize > 0, "Block size must be greater than zero");
+
+    // The Box-Muller transform consumes the uniform variates in pairs.
+    m_blockSize = blockSize + (blockSize % 2);
+    m_uniform = CreateObject<UniformRandomVariable>();
+    m_uniforms.resize(m_blockSize);
+    m_buffer.reserve(m_blockSize);
+    m_cursor = 0;
+    m_isInteger = false;
+    m_min = 0;
+    m_max = 0;
+}
+
+double
+RandomVariateTable::GetValue()
+{
+    while (m_cursor >= m_buffer.size())
+    {
+        Refill();
+    }
+
+    return m_buffer[m_cursor++];
+}
+
+uint32_t
+RandomVariateTable::GetInteger()
+{
+    return static_cast<uint32_t>(GetValue());
+}
+
+void
+RandomVariateTable::SetIntegerBounds(uint32_t min, uint32_t max)
+{
+    NS_ASSERT_MSG(min <= max, "Invalid interval [" << min << ", " << max << "]");
+
+    if (!m_isInteger || m_min != min || m_max != max)
+    {
+        NS_LOG_FUNCTION(this << min << max);
+        m_isInteger = true;
+        m_min = min;
+        m_max = max;
+        Reset();
+    }
+}
+
+void
+RandomVariateTable::SetStream(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_uniform->SetStream(stream);
+    Reset();
+}
+
+void
+RandomVariateTable::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_buffer.clear();
+    m_cursor = 0;
+}
+
+void
+RandomVariateTable::Refill()
+{
+    NS_LOG_FUNCTION(this << m_blockSize);
+
+    const bool isAntithetic = m_source->IsAntithetic();
+    for (uint32_t i = 0; i < m_blockSize; i++)
+    {
+        const double u = m_uniform->GetValue();
+        m_uniforms[i] = isAntithetic ? (1.0 - u) : u;
+    }
+
+    double bound = 0.0;
+    Transform(bound);
+
+    // Truncate the whole block at once.
+    std::vector<double>::iterator last = m_buffer.end();
+    if (bound > 0.0)
+    {
+        last =
+            std::remove_if(m_buffer.begin(), last, [bound](double value) { return value > bound; });
+    }
+    if (m_isInteger)
+    {
+        const double min = m_min;
+        const double max = m_max;
+        std::vector<double>::iterator it;
+        for (it = m_buffer.begin(); it != last; ++it)
+        {
+            *it = std::floor(*it);
+        }
+        last = std::remove_if(m_buffer.begin(), last, [min, max](double value) {
+            return value < min || value > max;
+        });
+    }
+    m_buffer.erase(last, m_buffer.end());
+    m_cursor = 0;
+
+    NS_LOG_LOGIC(this << " " << m_buffer.size() << " of " << m_blockSize
+                      << " variates are within the bounds");
+
+} // end of `void Refill ()`
+
+void
+RandomVariateTable::Transform(double& bound)
+{
+    m_buffer.resize(m_blockSize);
+
+    switch (m_distribution)
+    {
+    case PARETO: {
+        const double scale = m_pareto->GetScale();
+        const double exponent = 1.0 / m_pareto->GetShape();
+        for (uint32_t i = 0; i < m_blockSize; i++)
+        {
+            m_buffer[i] = scale / std::pow(m_uniforms[i], exponent);
+        }
+        bound = m_pareto->GetBound();
+        break;
+    }
+
+    case LOG_NORMAL: {
+        const double mu = m_logNormal->GetMu();
+        const double sigma = m_logNormal->GetSigma();
+        for (uint32_t i = 0; i < m_blockSize; i += 2)
+        {
+            const double r = std::sqrt(-2.0 * std::log(m_uniforms[i]));
+            const double theta = 2.0 * M_PI * m_uniforms[i + 1];
+            m_buffer[i] = std::exp(mu + sigma * r * std::cos(theta));
+            m_buffer[i + 1] = std::exp(mu + sigma * r * std::sin(theta));
+        }
+        bound = 0.0;
+        break;
+    }
+
+    case EXPONENTIAL: {
+        const double mean = m_exponential->GetMean();
+        for (uint32_t i = 0; i < m_blockSize; i++)
+        {
+            m_buffer[i] = -mean * std::log(m_uniforms[i]);
+        }
+        bound = m_exponential->GetBound();
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("Unknown distribution " << m_distribution);
+        break;
+    }
+
+} // end of `void Transform (double &)`
+
+} // namespace ns3
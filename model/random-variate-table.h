@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef RANDOM_VARIATE_TABLE_H
+#define RANDOM_VARIATE_TABLE_H
+
+#include <ns3/ptr.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief Block-sampled replacement of a Pareto, log-normal, or exponential
+ *        random variable.
+ *
+ * Instead of drawing one variate per call through the virtual
+ * RandomVariableStream::GetValue(), the table draws a block of uniform
+ * variates at once, transforms the whole block in a single loop (inverse CDF
+ * for Pareto and exponential distributions, Box-Muller transform for the
+ * log-normal distribution), removes the variates outside the bounds, and then
+ * hands out the remaining variates one by one until the block is exhausted.
+ *
+ * The distribution parameters are read from the source random variable every
+ * time a new block is drawn, so the source variable remains the place where
+ * the parameters are configured. Reset() must be invoked after modifying them,
+ * otherwise the variates already in the table are still handed out.
+ *
+ * The uniform variates are drawn from a dedicated UniformRandomVariable, so
+ * the sequence of values is reproducible for a given stream number (see
+ * SetStream()), but differs from the sequence produced by the source variable
+ * itself.
+ */
+class RandomVariateTable : public SimpleRefCount<RandomVariateTable>
+{
+  public:
+    /**
+     * \brief Create a table of truncated Pareto variates.
+     * \param source the variable holding the scale, shape, and bound parameters.
+     * \param blockSize number of uniform variates drawn at a time.
+     */
+    RandomVariateTable(Ptr<ParetoRandomVariable> source, uint32_t blockSize);
+
+    /**
+     * \brief Create a table of log-normal variates.
+     * \param source the variable holding the mu and sigma parameters.
+     * \param blockSize number of uniform variates drawn at a time.
+     */
+    RandomVariateTable(Ptr<LogNormalRandomVariable> source, uint32_t blockSize);
+
+    /**
+     * \brief Create a table of truncated exponential variates.
+     * \param source the variable holding the mean and bound parameters.
+     * \param blockSize number of uniform variates drawn at a time.
+     */
+    RandomVariateTable(Ptr<ExponentialRandomVariable> source, uint32_t blockSize);
+
+    /**
+     * \return the next variate from the table, drawing a new block if needed.
+     */
+    double GetValue();
+
+    /**
+     * \return the next variate from the table as an integer, i.e., truncated
+     *         towards zero like RandomVariableStream::GetInteger().
+     */
+    uint32_t GetInteger();
+
+    /**
+     * \brief Restrict the variates to integers within an interval.
+     * \param min the smallest acceptable integer.
+     * \param max the largest acceptable integer.
+     *
+     * Once set, the variates are truncated towards zero at the time the block
+     * is drawn, and those outside [min, max] are discarded, which is equivalent
+     * with repeatedly drawing integers until one falls inside [min, max]. The
+     * table is reset if the interval differs from the previous one, so it is
+     * cheap to call this method before every GetInteger().
+     */
+    void SetIntegerBounds(uint32_t min, uint32_t max);
+
+    /**
+     * \brief Set a fixed stream number to the underlying uniform variable.
+     * \param stream the stream index to use, or -1 to allocate one automatically.
+     *
+     * The table is reset, so the next variate is drawn from the new stream.
+     */
+    void SetStream(int64_t stream);
+
+    /// Discard all the variates remaining in the table.
+    void Reset();
+
+  private:
+    /// Supported distributions.
+    typedef enum
+    {
+        PARETO = 0,
+        LOG_NORMAL,
+        EXPONENTIAL
+    } Distribution_t;
+
+    /**
+     * \brief Common part of the constructors.
+     * \param blockSize number of uniform variates drawn at a time.
+     */
+    void Initialize(uint32_t blockSize);
+
+    /// Draw a new block of variates into #m_buffer.
+    void Refill();
+
+    /**
+     * \brief Fill #m_buffer with transformed variates, without truncation.
+     * \param[out] bound the upper bound of the distribution, or zero if unbounded.
+     */
+    void Transform(double& bound);
+
+    Distribution_t m_distribution;           ///< Distribution of the variates.
+    Ptr<ParetoRandomVariable> m_pareto;       ///< Source of Pareto parameters.
+    Ptr<LogNormalRandomVariable> m_logNormal; ///< Source of log-normal parameters.
+    Ptr<ExponentialRandomVariable> m_exponential; ///< Source of exponential parameters.
+    Ptr<RandomVariableStream> m_source;       ///< Whichever of the sources above is in use.
+    Ptr<UniformRandomVariable> m_uniform;     ///< Generator of the uniform variates.
+    uint32_t m_blockSize;                     ///< Number of uniform variates per block.
+    std::vector<double> m_uniforms;           ///< Scratch space for the uniform variates.
+    std::vector<double> m_buffer;             ///< Variates ready to be handed out.
+    uint32_t m_cursor;                        ///< Index of the next variate in #m_buffer.
+    bool m_isInteger;                         ///< True if SetIntegerBounds() has been invoked.
+    uint32_t m_min;                           ///< Smallest acceptable integer.
+    uint32_t m_max;                           ///< Largest acceptable integer.
+
+}; // end of `class RandomVariateTable`
+
+} // namespace ns3
+
+#endif /* RANDOM_VARIATE_TABLE_H */
@@ -21,20 +21,26 @@
 
 #include "three-gpp-http-satellite-client.h"
 
+#include <ns3/boolean.h>
 #include <ns3/callback.h>
 #include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/inet-socket-address.h>
+#include <ns3/integer.h>
 #include <ns3/inet6-socket-address.h>
 #include <ns3/log.h>
 #include <ns3/packet.h>
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 #include <ns3/socket.h>
+#include <ns3/string.h>
 #include <ns3/tcp-socket-factory.h>
 #include <ns3/three-gpp-http-variables.h>
 #include <ns3/uinteger.h>
 #include <ns3/unused.h>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteClient");
 
 namespace ns3
@@ -44,12 +50,18 @@ NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpSatelliteClient);
 
 ThreeGppHttpSatelliteClient::ThreeGppHttpSatelliteClient()
     : m_state(NOT_STARTED),
+      m_preconnect(false),
       m_socket(nullptr),
-      m_objectBytesToBeReceived(0),
-      m_objectClientTs(MilliSeconds(0)),
-      m_objectServerTs(MilliSeconds(0)),
       m_embeddedObjectsToBeRequested(0),
-      m_httpVariables(CreateObject<ThreeGppHttpVariables>())
+      m_embeddedObjectsOutstanding(0),
+      m_totalRx(0),
+      m_maxParallelConnections(1),
+      m_cacheModel(CACHE_NONE),
+      m_keepAliveTimeout(Seconds(0)),
+      m_cacheHitProbability(0.5),
+      m_cacheSize(10000000),
+      m_checkpointMode(TrafficScheduleLog::DISABLED),
+      m_cacheUsedBytes(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -78,6 +90,87 @@ ThreeGppHttpSatelliteClient::GetTypeId()
                           UintegerValue(80), // the default HTTP port
                           MakeUintegerAccessor(&ThreeGppHttpSatelliteClient::m_remoteServerPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute(
+                "MaxParallelConnections",
+                "The maximum number of TCP connections used in parallel for receiving the "
+                "embedded objects of a web page, including the connection used for main "
+                "objects. The default value of 1 means receiving embedded objects one by one.",
+                UintegerValue(1),
+                MakeUintegerAccessor(&ThreeGppHttpSatelliteClient::m_maxParallelConnections),
+                MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("KeepAliveTimeout",
+                          "Idle time after which the connections to the server are closed "
+                          "during the reading time. The next web page then needs a new "
+                          "connection. Zero means keeping the connections open indefinitely.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreeGppHttpSatelliteClient::m_keepAliveTimeout),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("Preconnect",
+                          "If true, a connection which has been closed during the reading time "
+                          "is opened again in advance, so that it is ready by the end of the "
+                          "reading time.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppHttpSatelliteClient::m_preconnect),
+                          MakeBooleanChecker())
+            .AddAttribute("CacheModel",
+                          "The model of the browser cache for embedded objects.",
+                          EnumValue(ThreeGppHttpSatelliteClient::CACHE_NONE),
+                          MakeEnumAccessor(&ThreeGppHttpSatelliteClient::m_cacheModel),
+                          MakeEnumChecker(ThreeGppHttpSatelliteClient::CACHE_NONE,
+                                          "NONE",
+                                          ThreeGppHttpSatelliteClient::CACHE_HIT_PROBABILITY,
+                                          "HIT_PROBABILITY",
+                                          ThreeGppHttpSatelliteClient::CACHE_LRU,
+                                          "LRU"))
+            .AddAttribute("CacheHitProbability",
+                          "The probability of finding an embedded object in the cache, "
+                          "used by the HIT_PROBABILITY cache model.",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&ThreeGppHttpSatelliteClient::m_cacheHitProbability),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("CacheSize",
+                          "The capacity of the cache in bytes, used by the LRU cache model.",
+                          UintegerValue(10000000),
+                          MakeUintegerAccessor(&ThreeGppHttpSatelliteClient::m_cacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheObjectIdentity",
+                          "The distribution of the identities of embedded objects, which "
+                          "determines how often the same object appears in the web pages. "
+                          "Used by the LRU cache model. If not set, a Zipf distribution over "
+                          "1000 objects with an exponent of 1 is created upon start.",
+                          PointerValue(),
+                          MakePointerAccessor(&ThreeGppHttpSatelliteClient::m_cacheObjectIdRng),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("CacheHitRandomVariable",
+                          "The random variable uniformly distributed in [0, 1) which is "
+                          "compared against `CacheHitProbability` on each lookup. Used by the "
+                          "HIT_PROBABILITY cache model. If not set, one is created upon start.",
+                          PointerValue(),
+                          MakePointerAccessor(&ThreeGppHttpSatelliteClient::m_cacheHitRng),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("CheckpointMode",
+                          "Whether the state of the client is saved into the checkpoint, or "
+                          "restored from it. Must be set before `CheckpointFile`.",
+                          EnumValue(TrafficScheduleLog::DISABLED),
+                          MakeEnumAccessor(&ThreeGppHttpSatelliteClient::m_checkpointMode),
+                          MakeEnumChecker(TrafficScheduleLog::DISABLED,
+                                          "DISABLED",
+                                          TrafficScheduleLog::RECORD,
+                                          "SAVE",
+                                          TrafficScheduleLog::REPLAY,
+                                          "RESTORE"))
+            .AddAttribute("CheckpointFile",
+                          "Name of the checkpoint file (see TrafficScheduleLog). Empty means "
+                          "neither saving nor restoring.",
+                          StringValue(""),
+                          MakeStringAccessor(&ThreeGppHttpSatelliteClient::SetCheckpointFile,
+                                             &ThreeGppHttpSatelliteClient::GetCheckpointFile),
+                          MakeStringChecker())
+            .AddAttribute("CheckpointTime",
+                          "Simulation time when the state is saved in the SAVE mode.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&ThreeGppHttpSatelliteClient::m_checkpointTime),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource(
                 "ConnectionEstablished",
                 "Connection to the destination web server has been established.",
@@ -88,6 +181,21 @@ ThreeGppHttpSatelliteClient::GetTypeId()
                 "Connection to the destination web server is closed.",
                 MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_connectionClosedTrace),
                 "ns3::ThreeGppHttpSatelliteClient::TracedCallback")
+            .AddTraceSource("ConnectionSetupDelay",
+                            "Time spent by a web page request waiting for a connection to be "
+                            "established. Zero if an established connection has been reused.",
+                            MakeTraceSourceAccessor(
+                                &ThreeGppHttpSatelliteClient::m_connectionSetupDelayTrace),
+                            "ns3::Time::TracedCallback")
+            .AddTraceSource("CacheHit",
+                            "An embedded object has been found in the cache.",
+                            MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_cacheHitTrace),
+                            "ns3::ThreeGppHttpSatelliteClient::CacheTracedCallback")
+            .AddTraceSource("CacheMiss",
+                            "An embedded object has not been found in the cache, so it will be "
+                            "requested from the server.",
+                            MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_cacheMissTrace),
+                            "ns3::ThreeGppHttpSatelliteClient::CacheTracedCallback")
             .AddTraceSource("Tx",
                             "General trace for sending a packet of any kind.",
                             MakeTraceSourceAccessor(&ThreeGppHttpSatelliteClient::m_txTrace),
@@ -153,6 +261,12 @@ ThreeGppHttpSatelliteClient::GetSocket() const
     return m_socket;
 }
 
+uint64_t
+ThreeGppHttpSatelliteClient::GetTotalRx() const
+{
+    return m_totalRx;
+}
+
 ThreeGppHttpSatelliteClient::State_t
 ThreeGppHttpSatelliteClient::GetState() const
 {
@@ -165,6 +279,20 @@ ThreeGppHttpSatelliteClient::GetStateString() const
     return GetStateString(m_state);
 }
 
+void
+ThreeGppHttpSatelliteClient::SetCheckpointFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName << m_checkpointMode);
+    m_checkpointFile = fileName;
+    m_checkpoint.Open(fileName, m_checkpointMode);
+}
+
+std::string
+ThreeGppHttpSatelliteClient::GetCheckpointFile() const
+{
+    return m_checkpointFile;
+}
+
 // static
 std::string
 ThreeGppHttpSatelliteClient::GetStateString(ThreeGppHttpSatelliteClient::State_t state)
@@ -212,6 +340,21 @@ ThreeGppHttpSatelliteClient::DoDispose()
     Application::DoDispose(); // Chain up.
 }
 
+void
+ThreeGppHttpSatelliteClient::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+
+    /*
+     * Create the private variables, if any, while the client is constructed,
+     * so that their random variables take the same automatic streams as they
+     * did when the constructor created them unconditionally.
+     */
+    GetHttpVariables();
+
+    Application::NotifyConstructionCompleted(); // Chain up.
+}
+
 void
 ThreeGppHttpSatelliteClient::StartApplication()
 {
@@ -219,7 +362,37 @@ ThreeGppHttpSatelliteClient::StartApplication()
 
     if (m_state == NOT_STARTED)
     {
-        OpenConnection();
+        TRAFFIC_COUNTERS_REGISTER(m_counters,
+                                  "ns3::ThreeGppHttpSatelliteClient",
+                                  GetNode()->GetId());
+
+        // Only the random variables of the selected cache model are created.
+        if (m_cacheModel == CACHE_LRU && m_cacheObjectIdRng == nullptr)
+        {
+            m_cacheObjectIdRng = CreateObjectWithAttributes<ZipfRandomVariable>("N",
+                                                                                IntegerValue(1000),
+                                                                                "Alpha",
+                                                                                DoubleValue(1.0));
+        }
+        if (m_cacheModel == CACHE_HIT_PROBABILITY && m_cacheHitRng == nullptr)
+        {
+            m_cacheHitRng = CreateObject<UniformRandomVariable>();
+        }
+
+        if (m_checkpoint.IsRecording())
+        {
+            const Time delay = (m_checkpointTime > Simulator::Now())
+                                   ? m_checkpointTime - Simulator::Now()
+                                   : Seconds(0);
+            m_eventSaveCheckpoint =
+                Simulator::Schedule(delay, &ThreeGppHttpSatelliteClient::SaveCheckpoint, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        }
+
+        if (!RestoreCheckpoint())
+        {
+            OpenConnection();
+        }
     }
     else
     {
@@ -234,10 +407,37 @@ ThreeGppHttpSatelliteClient::StopApplication()
 
     SwitchToState(STOPPED);
     CancelAllPendingEvents();
-    m_socket->Close();
-    m_socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
-                                 MakeNullCallback<void, Ptr<Socket>>());
-    m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    if (m_socket != nullptr)
+    {
+        m_socket->Close();
+        m_socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                     MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+
+    CloseParallelConnections();
+}
+
+void
+ThreeGppHttpSatelliteClient::CloseParallelConnections()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Parallel connections are simply forgotten.
+    for (uint32_t i = 1; i < m_connections.size(); i++)
+    {
+        Ptr<Socket> socket = m_connections[i].socket;
+        socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                   MakeNullCallback<void, Ptr<Socket>>());
+        socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                  MakeNullCallback<void, Ptr<Socket>>());
+        socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        socket->Close();
+    }
+    if (m_connections.size() > 1)
+    {
+        m_connections.resize(1);
+    }
 }
 
 void
@@ -245,15 +445,28 @@ ThreeGppHttpSatelliteClient::ConnectionSucceededCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
-    if (m_state == CONNECTING)
+    if (m_state == CONNECTING || m_state == READING)
     {
         NS_ASSERT_MSG(m_socket == socket, "Invalid socket.");
+        m_connections[0].isConnected = true;
+        m_lastConnectionSetupDelay = Simulator::Now() - m_connectionOpenTime;
         m_connectionEstablishedTrace(this);
         socket->SetRecvCallback(
             MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
-        NS_ASSERT(m_embeddedObjectsToBeRequested == 0);
-        m_eventRequestMainObject =
-            Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestMainObject, this);
+
+        if (m_state == CONNECTING)
+        {
+            NS_ASSERT(m_embeddedObjectsToBeRequested == 0);
+            m_connectionSetupDelayTrace(Simulator::Now() - m_pageRequestTime);
+            m_eventRequestMainObject =
+                Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestMainObject, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        }
+        else
+        {
+            // Opened by Preconnect(), so the reading time is still going on.
+            NS_LOG_INFO(this << " Connection is ready in advance for the next web page.");
+        }
     }
     else
     {
@@ -272,6 +485,14 @@ ThreeGppHttpSatelliteClient::ConnectionFailedCallback(Ptr<Socket> socket)
                        << " to remote address " << m_remoteServerAddress << " port "
                        << m_remoteServerPort << ".");
     }
+    else if (m_state == READING)
+    {
+        // Opened by Preconnect(), so try again when the next web page is requested.
+        NS_LOG_WARN(this << " Failed to connect in advance"
+                         << " to remote address " << m_remoteServerAddress << " port "
+                         << m_remoteServerPort << ".");
+        ForgetConnection();
+    }
     else
     {
         NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ConnectionFailed().");
@@ -283,6 +504,16 @@ ThreeGppHttpSatelliteClient::NormalCloseCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
+    if (m_state == READING)
+    {
+        // The connection is not needed now, so open another one later.
+        NS_LOG_INFO(this << " Connection has been closed during the reading time.");
+        ForgetConnection();
+        m_connectionClosedTrace(this);
+        SchedulePreconnect();
+        return;
+    }
+
     CancelAllPendingEvents();
 
     if (socket->GetErrno() != Socket::ERROR_NOTERROR)
@@ -293,6 +524,7 @@ ThreeGppHttpSatelliteClient::NormalCloseCallback(Ptr<Socket> socket)
 
     m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
                                 MakeNullCallback<void, Ptr<Socket>>());
+    m_connections[0].isConnected = false;
 
     m_connectionClosedTrace(this);
 }
@@ -302,21 +534,90 @@ ThreeGppHttpSatelliteClient::ErrorCloseCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
+    if (m_state == READING)
+    {
+        // The connection is not needed now, so open another one later.
+        NS_LOG_WARN(this << " Connection has been terminated during the reading time,"
+                         << " error code: " << socket->GetErrno() << ".");
+        ForgetConnection();
+        m_connectionClosedTrace(this);
+        SchedulePreconnect();
+        return;
+    }
+
     CancelAllPendingEvents();
     if (socket->GetErrno() != Socket::ERROR_NOTERROR)
     {
         NS_LOG_ERROR(this << " Connection has been terminated,"
                           << " error code: " << socket->GetErrno() << ".");
     }
+    m_connections[0].isConnected = false;
 
     m_connectionClosedTrace(this);
 }
 
+void
+ThreeGppHttpSatelliteClient::ParallelConnectionSucceededCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    const uint32_t index = GetConnectionIndex(socket);
+    NS_ASSERT(index > 0);
+    m_connections[index].isConnected = true;
+    NS_LOG_INFO(this << " Parallel connection #" << index << " has been established.");
+
+    if (m_state == EXPECTING_EMBEDDED_OBJECT && m_embeddedObjectsToBeRequested > 0)
+    {
+        SendEmbeddedObjectRequest(index);
+    }
+}
+
+void
+ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    const uint32_t index = GetConnectionIndex(socket);
+    NS_ASSERT(index > 0);
+    if (socket->GetErrno() != Socket::ERROR_NOTERROR)
+    {
+        NS_LOG_ERROR(this << " Parallel connection #" << index << " has been terminated,"
+                          << " error code: " << socket->GetErrno() << ".");
+    }
+
+    socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                               MakeNullCallback<void, Ptr<Socket>>());
+    socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                              MakeNullCallback<void, Ptr<Socket>>());
+    socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+
+    if (m_connections[index].isBusy)
+    {
+        // Request the lost embedded object again through another connection.
+        NS_ASSERT(m_embeddedObjectsOutstanding > 0);
+        m_embeddedObjectsOutstanding--;
+        m_embeddedObjectsToBeRequested++;
+        if (m_cacheModel == CACHE_LRU)
+        {
+            m_objectIdsToBeRequested.push_front(m_connections[index].objectId);
+        }
+        if (Simulator::IsExpired(m_eventRequestEmbeddedObject))
+        {
+            m_eventRequestEmbeddedObject =
+                Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        }
+    }
+
+    m_connections.erase(m_connections.begin() + index);
+}
+
 void
 ThreeGppHttpSatelliteClient::ReceivedDataCallback(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
 
+    const uint32_t index = GetConnectionIndex(socket);
     Ptr<Packet> packet;
     Address from;
 
@@ -345,15 +646,17 @@ ThreeGppHttpSatelliteClient::ReceivedDataCallback(Ptr<Socket> socket)
         }
 #endif /* NS3_LOG_ENABLE */
 
+        m_totalRx += packet->GetSize();
         m_rxTrace(packet, from);
 
         switch (m_state)
         {
         case EXPECTING_MAIN_OBJECT:
+            NS_ASSERT_MSG(index == 0, "Main object received through a parallel connection.");
             ReceiveMainObject(packet, from);
             break;
         case EXPECTING_EMBEDDED_OBJECT:
-            ReceiveEmbeddedObject(packet, from);
+            ReceiveEmbeddedObject(packet, from, index);
             break;
         default:
             NS_FATAL_ERROR("Invalid state " << GetStateString() << " for ReceivedData().");
@@ -372,54 +675,10 @@ ThreeGppHttpSatelliteClient::OpenConnection()
     if (m_state == NOT_STARTED || m_state == EXPECTING_EMBEDDED_OBJECT ||
         m_state == PARSING_MAIN_OBJECT || m_state == READING)
     {
-        m_socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
-
-        int ret;
-
-        if (Ipv4Address::IsMatchingType(m_remoteServerAddress))
-        {
-            ret = m_socket->Bind();
-            NS_LOG_DEBUG(this << " Bind() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-
-            Ipv4Address ipv4 = Ipv4Address::ConvertFrom(m_remoteServerAddress);
-            InetSocketAddress inetSocket = InetSocketAddress(ipv4, m_remoteServerPort);
-            NS_LOG_INFO(this << " Connecting to " << ipv4 << " port " << m_remoteServerPort << " / "
-                             << inetSocket << ".");
-            ret = m_socket->Connect(inetSocket);
-            NS_LOG_DEBUG(this << " Connect() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-        }
-        else if (Ipv6Address::IsMatchingType(m_remoteServerAddress))
-        {
-            ret = m_socket->Bind6();
-            NS_LOG_DEBUG(this << " Bind6() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-
-            Ipv6Address ipv6 = Ipv6Address::ConvertFrom(m_remoteServerAddress);
-            Inet6SocketAddress inet6Socket = Inet6SocketAddress(ipv6, m_remoteServerPort);
-            NS_LOG_INFO(this << " connecting to " << ipv6 << " port " << m_remoteServerPort << " / "
-                             << inet6Socket << ".");
-            ret = m_socket->Connect(inet6Socket);
-            NS_LOG_DEBUG(this << " Connect() return value= " << ret
-                              << " GetErrNo= " << m_socket->GetErrno() << ".");
-        }
-
-        // NS_UNUSED (ret); // Mute compiler warning.
-        NS_ASSERT_MSG(m_socket != nullptr, "Failed creating socket.");
-
+        m_pageRequestTime = Simulator::Now();
+        SetupConnection();
         SwitchToState(CONNECTING);
 
-        m_socket->SetConnectCallback(
-            MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionSucceededCallback, this),
-            MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionFailedCallback, this));
-        m_socket->SetCloseCallbacks(
-            MakeCallback(&ThreeGppHttpSatelliteClient::NormalCloseCallback, this),
-            MakeCallback(&ThreeGppHttpSatelliteClient::ErrorCloseCallback, this));
-        m_socket->SetRecvCallback(
-            MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
-        m_socket->SetAttribute("MaxSegLifetime", DoubleValue(0.02)); // 20 ms.
-
     } // end of `if (m_state == {NOT_STARTED, EXPECTING_EMBEDDED_OBJECT, PARSING_MAIN_OBJECT,
       // READING})`
     else
@@ -429,6 +688,189 @@ ThreeGppHttpSatelliteClient::OpenConnection()
 
 } // end of `void OpenConnection ()`
 
+void
+ThreeGppHttpSatelliteClient::SetupConnection()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_socket = CreateSocket();
+    if (m_connections.empty())
+    {
+        m_connections.push_back(Connection_t());
+    }
+    else
+    {
+        m_connections[0] = Connection_t();
+    }
+    m_connections[0].socket = m_socket;
+    m_connectionOpenTime = Simulator::Now();
+
+    m_socket->SetConnectCallback(
+        MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionSucceededCallback, this),
+        MakeCallback(&ThreeGppHttpSatelliteClient::ConnectionFailedCallback, this));
+    m_socket->SetCloseCallbacks(
+        MakeCallback(&ThreeGppHttpSatelliteClient::NormalCloseCallback, this),
+        MakeCallback(&ThreeGppHttpSatelliteClient::ErrorCloseCallback, this));
+    m_socket->SetRecvCallback(
+        MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
+}
+
+void
+ThreeGppHttpSatelliteClient::ForgetConnection()
+{
+    NS_LOG_FUNCTION(this << m_socket);
+
+    if (m_socket != nullptr)
+    {
+        m_socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                                     MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                                    MakeNullCallback<void, Ptr<Socket>>());
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_socket = nullptr;
+    }
+
+    NS_ASSERT(!m_connections.empty());
+    m_connections[0] = Connection_t();
+}
+
+void
+ThreeGppHttpSatelliteClient::CloseIdleConnections()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_state == READING);
+
+    NS_LOG_INFO(this << " Connections have been idle for " << m_keepAliveTimeout.GetSeconds()
+                     << " seconds and are now closed.");
+    Ptr<Socket> socket = m_socket;
+    ForgetConnection();
+    if (socket != nullptr)
+    {
+        socket->Close();
+    }
+    CloseParallelConnections();
+    m_connectionClosedTrace(this);
+
+    SchedulePreconnect();
+}
+
+void
+ThreeGppHttpSatelliteClient::SchedulePreconnect()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_preconnect || Simulator::IsExpired(m_eventRequestMainObject))
+    {
+        return;
+    }
+
+    // Aim at having the connection ready right when the reading time ends.
+    const Time readingTimeLeft = Simulator::GetDelayLeft(m_eventRequestMainObject);
+    const Time delay = (readingTimeLeft > m_lastConnectionSetupDelay)
+                           ? readingTimeLeft - m_lastConnectionSetupDelay
+                           : Seconds(0);
+    NS_LOG_INFO(this << " A new connection will be opened in " << delay.GetSeconds()
+                     << " seconds.");
+    m_eventPreconnect = Simulator::Schedule(delay, &ThreeGppHttpSatelliteClient::Preconnect, this);
+    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+}
+
+void
+ThreeGppHttpSatelliteClient::Preconnect()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_state == READING && m_socket == nullptr)
+    {
+        SetupConnection();
+    }
+}
+
+void
+ThreeGppHttpSatelliteClient::OpenParallelConnections()
+{
+    NS_LOG_FUNCTION(this);
+
+    const uint32_t numOfWanted =
+        std::min(m_maxParallelConnections,
+                 m_embeddedObjectsOutstanding + m_embeddedObjectsToBeRequested);
+
+    while (m_connections.size() < numOfWanted)
+    {
+        Connection_t connection;
+        connection.socket = CreateSocket();
+        connection.socket->SetConnectCallback(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionSucceededCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback, this));
+        connection.socket->SetCloseCallbacks(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback, this),
+            MakeCallback(&ThreeGppHttpSatelliteClient::ParallelConnectionClosedCallback, this));
+        connection.socket->SetRecvCallback(
+            MakeCallback(&ThreeGppHttpSatelliteClient::ReceivedDataCallback, this));
+        m_connections.push_back(connection);
+        NS_LOG_INFO(this << " Opening parallel connection #" << m_connections.size() - 1 << ".");
+    }
+}
+
+Ptr<Socket>
+ThreeGppHttpSatelliteClient::CreateSocket()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+    NS_ASSERT_MSG(socket != nullptr, "Failed creating socket.");
+
+    [[maybe_unused]] int ret;
+
+    if (Ipv4Address::IsMatchingType(m_remoteServerAddress))
+    {
+        ret = socket->Bind();
+        NS_LOG_DEBUG(this << " Bind() return value= " << ret << " GetErrNo= " << socket->GetErrno()
+                          << ".");
+
+        Ipv4Address ipv4 = Ipv4Address::ConvertFrom(m_remoteServerAddress);
+        InetSocketAddress inetSocket = InetSocketAddress(ipv4, m_remoteServerPort);
+        NS_LOG_INFO(this << " Connecting to " << ipv4 << " port " << m_remoteServerPort << " / "
+                         << inetSocket << ".");
+        ret = socket->Connect(inetSocket);
+        NS_LOG_DEBUG(this << " Connect() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+    }
+    else if (Ipv6Address::IsMatchingType(m_remoteServerAddress))
+    {
+        ret = socket->Bind6();
+        NS_LOG_DEBUG(this << " Bind6() return value= " << ret << " GetErrNo= " << socket->GetErrno()
+                          << ".");
+
+        Ipv6Address ipv6 = Ipv6Address::ConvertFrom(m_remoteServerAddress);
+        Inet6SocketAddress inet6Socket = Inet6SocketAddress(ipv6, m_remoteServerPort);
+        NS_LOG_INFO(this << " connecting to " << ipv6 << " port " << m_remoteServerPort << " / "
+                         << inet6Socket << ".");
+        ret = socket->Connect(inet6Socket);
+        NS_LOG_DEBUG(this << " Connect() return value= " << ret
+                          << " GetErrNo= " << socket->GetErrno() << ".");
+    }
+
+    socket->SetAttribute("MaxSegLifetime", DoubleValue(0.02)); // 20 ms.
+    return socket;
+
+} // end of `Ptr<Socket> CreateSocket ()`
+
+uint32_t
+ThreeGppHttpSatelliteClient::GetConnectionIndex(Ptr<Socket> socket) const
+{
+    for (uint32_t i = 0; i < m_connections.size(); i++)
+    {
+        if (m_connections[i].socket == socket)
+        {
+            return i;
+        }
+    }
+
+    NS_FATAL_ERROR("Unknown socket " << socket << ".");
+    return 0;
+}
+
 void
 ThreeGppHttpSatelliteClient::RequestMainObject()
 {
@@ -436,14 +878,40 @@ ThreeGppHttpSatelliteClient::RequestMainObject()
 
     if (m_state == CONNECTING || m_state == READING)
     {
+        if (!m_connections[0].isConnected)
+        {
+            // The connection has been closed during the reading time.
+            NS_ASSERT(m_state == READING);
+            Simulator::Cancel(m_eventPreconnect);
+            if (m_socket == nullptr)
+            {
+                OpenConnection();
+            }
+            else
+            {
+                // Already being opened by Preconnect().
+                m_pageRequestTime = Simulator::Now();
+                SwitchToState(CONNECTING);
+            }
+            return;
+        }
+
+        if (m_state == READING)
+        {
+            // The connection has been kept alive or opened in advance.
+            Simulator::Cancel(m_eventKeepAliveTimeout);
+            m_connectionSetupDelayTrace(Seconds(0));
+        }
+
         ThreeGppHttpHeader header;
         header.SetContentLength(0); // Request does not need any content length.
         header.SetContentType(ThreeGppHttpHeader::MAIN_OBJECT);
         header.SetClientTs(Simulator::Now());
 
-        const uint32_t requestSize = m_httpVariables->GetRequestSize();
+        const uint32_t requestSize = GetHttpVariables()->GetRequestSize();
         Ptr<Packet> packet = Create<Packet>(requestSize);
         packet->AddHeader(header);
+        TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
         const uint32_t packetSize = packet->GetSize();
         NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
                       "Packet size shall not be larger than MTU size.");
@@ -482,36 +950,17 @@ ThreeGppHttpSatelliteClient::RequestEmbeddedObject()
     {
         if (m_embeddedObjectsToBeRequested > 0)
         {
-            ThreeGppHttpHeader header;
-            header.SetContentLength(0); // Request does not need any content length.
-            header.SetContentType(ThreeGppHttpHeader::EMBEDDED_OBJECT);
-            header.SetClientTs(Simulator::Now());
-
-            const uint32_t requestSize = m_httpVariables->GetRequestSize();
-            Ptr<Packet> packet = Create<Packet>(requestSize);
-            packet->AddHeader(header);
-            const uint32_t packetSize = packet->GetSize();
-            NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
-                          "Packet size shall not be larger than MTU size.");
-
-            m_txEmbeddedObjectRequestTrace(packet);
-            m_txTrace(packet);
-            const int actualBytes = m_socket->Send(packet);
-            NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packet->GetSize()
-                              << " bytes,"
-                              << " return value= " << actualBytes << ".");
-
-            if (actualBytes != static_cast<int>(packetSize))
-            {
-                NS_LOG_ERROR(this << " Failed to send request for embedded object,"
-                                  << " GetErrNo= " << m_socket->GetErrno() << ","
-                                  << " waiting for another Tx opportunity.");
-            }
-            else
+            for (uint32_t i = 0; i < m_connections.size() && m_embeddedObjectsToBeRequested > 0;
+                 i++)
             {
-                m_embeddedObjectsToBeRequested--;
-                SwitchToState(EXPECTING_EMBEDDED_OBJECT);
+                if (m_connections[i].isConnected && !m_connections[i].isBusy &&
+                    !SendEmbeddedObjectRequest(i))
+                {
+                    break;
+                }
             }
+
+            OpenParallelConnections();
         }
         else
         {
@@ -525,6 +974,63 @@ ThreeGppHttpSatelliteClient::RequestEmbeddedObject()
 
 } // end of `void RequestEmbeddedObject ()`
 
+bool
+ThreeGppHttpSatelliteClient::SendEmbeddedObjectRequest(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    NS_ASSERT(index < m_connections.size());
+    NS_ASSERT(m_embeddedObjectsToBeRequested > 0);
+
+    Connection_t& connection = m_connections[index];
+    NS_ASSERT(!connection.isBusy);
+    if (connection.rx.bytesToBeReceived > 0)
+    {
+        NS_FATAL_ERROR("Cannot start a new receiving session"
+                       << " if the previous object"
+                       << " (" << connection.rx.bytesToBeReceived << " bytes)"
+                       << " is not completely received yet.");
+    }
+
+    ThreeGppHttpHeader header;
+    header.SetContentLength(0); // Request does not need any content length.
+    header.SetContentType(ThreeGppHttpHeader::EMBEDDED_OBJECT);
+    header.SetClientTs(Simulator::Now());
+
+    const uint32_t requestSize = GetHttpVariables()->GetRequestSize();
+    Ptr<Packet> packet = Create<Packet>(requestSize);
+    packet->AddHeader(header);
+    TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
+    const uint32_t packetSize = packet->GetSize();
+    NS_ASSERT_MSG(packetSize <= 536, // Hard-coded MTU size.
+                  "Packet size shall not be larger than MTU size.");
+
+    m_txEmbeddedObjectRequestTrace(packet);
+    m_txTrace(packet);
+    const int actualBytes = connection.socket->Send(packet);
+    NS_LOG_DEBUG(this << " Send() packet " << packet << " of " << packet->GetSize() << " bytes,"
+                      << " return value= " << actualBytes << ".");
+
+    if (actualBytes != static_cast<int>(packetSize))
+    {
+        NS_LOG_ERROR(this << " Failed to send request for embedded object,"
+                          << " GetErrNo= " << connection.socket->GetErrno() << ","
+                          << " waiting for another Tx opportunity.");
+        return false;
+    }
+
+    m_embeddedObjectsToBeRequested--;
+    m_embeddedObjectsOutstanding++;
+    connection.isBusy = true;
+    if (!m_objectIdsToBeRequested.empty())
+    {
+        connection.objectId = m_objectIdsToBeRequested.front();
+        m_objectIdsToBeRequested.pop_front();
+    }
+    SwitchToState(EXPECTING_EMBEDDED_OBJECT);
+    return true;
+
+} // end of `bool SendEmbeddedObjectRequest (uint32_t)`
+
 void
 ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address& from)
 {
@@ -533,23 +1039,24 @@ ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address
     if (m_state == EXPECTING_MAIN_OBJECT)
     {
         /*
-         * In the following call to Receive(), #m_objectBytesToBeReceived *will*
-         * be updated. #m_objectClientTs and #m_objectServerTs *may* be updated.
+         * In the following call to Receive(), the number of bytes to be
+         * received *will* be updated. The time stamps *may* be updated.
          * ThreeGppHttpHeader will be removed from the packet, if it is the first
          * packet of the object to be received; the header will be available in
-         * #m_constructedPacketHeader.
-         * #m_constructedPacket will also be updated.
+         * the reception state. The packet is kept there only if the
+         * `RxMainObject` trace source has a sink.
          */
-        Receive(packet);
+        ObjectRx_t& rx = m_connections[0].rx;
+        Receive(packet, rx);
         m_rxMainObjectPacketTrace(packet);
 
-        if (m_objectBytesToBeReceived > 0)
+        if (rx.bytesToBeReceived > 0)
         {
             /*
              * There are more packets of this main object, so just stay still
              * and wait until they arrive.
              */
-            NS_LOG_INFO(this << " " << m_objectBytesToBeReceived << " byte(s)"
+            NS_LOG_INFO(this << " " << rx.bytesToBeReceived << " byte(s)"
                              << " remains from this chunk of main object.");
         }
         else
@@ -559,23 +1066,32 @@ ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address
              * reception of a whole main object
              */
             NS_LOG_INFO(this << " Finished receiving a main object.");
-            m_rxMainObjectTrace(this, m_constructedPacket);
+            /*
+             * Decide by the reception state rather than by the sinks, which
+             * may have been connected in the middle of the object, or lost
+             * with an oversized packet.
+             */
+            if (rx.isAssembling)
+            {
+                m_rxMainObjectTrace(this, AssembleObject(rx));
+            }
+            rx.packets.clear();
 
-            if (!m_objectServerTs.IsZero())
+            if (!rx.serverTs.IsZero())
             {
-                m_rxDelayTrace(Simulator::Now() - m_objectServerTs, from);
-                m_objectServerTs = MilliSeconds(0); // Reset back to zero.
+                m_rxDelayTrace(Simulator::Now() - rx.serverTs, from);
+                rx.serverTs = MilliSeconds(0); // Reset back to zero.
             }
 
-            if (!m_objectClientTs.IsZero())
+            if (!rx.clientTs.IsZero())
             {
-                m_rxRttTrace(Simulator::Now() - m_objectClientTs, from);
-                m_objectClientTs = MilliSeconds(0); // Reset back to zero.
+                m_rxRttTrace(Simulator::Now() - rx.clientTs, from);
+                rx.clientTs = MilliSeconds(0); // Reset back to zero.
             }
 
             EnterParsingTime();
 
-        } // end of else of `if (m_objectBytesToBeReceived > 0)`
+        } // end of else of `if (rx.bytesToBeReceived > 0)`
 
     } // end of `if (m_state == EXPECTING_MAIN_OBJECT)`
     else
@@ -586,29 +1102,35 @@ ThreeGppHttpSatelliteClient::ReceiveMainObject(Ptr<Packet> packet, const Address
 } // end of `void ReceiveMainObject (Ptr<Packet> packet)`
 
 void
-ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Address& from)
+ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet,
+                                                   const Address& from,
+                                                   uint32_t index)
 {
-    NS_LOG_FUNCTION(this << packet << from);
+    NS_LOG_FUNCTION(this << packet << from << index);
+    NS_ASSERT(index < m_connections.size());
 
     if (m_state == EXPECTING_EMBEDDED_OBJECT)
     {
         /*
-         * In the following call to Receive(), #m_objectBytesToBeReceived *will*
-         * be updated. #m_objectClientTs and #m_objectServerTs *may* be updated.
+         * In the following call to Receive(), the number of bytes to be
+         * received *will* be updated. The time stamps *may* be updated.
          * ThreeGppHttpHeader will be removed from the packet, if it is the first
          * packet of the object to be received; the header will be available in
-         * #m_constructedPacket, which will also be updated.
+         * the reception state of the connection. The packet is kept there only
+         * if the `RxEmbeddedObject` trace source has a sink.
          */
-        Receive(packet);
+        Connection_t& connection = m_connections[index];
+        ObjectRx_t& rx = connection.rx;
+        Receive(packet, rx);
         m_rxEmbeddedObjectPacketTrace(packet);
 
-        if (m_objectBytesToBeReceived > 0)
+        if (rx.bytesToBeReceived > 0)
         {
             /*
              * There are more packets of this embedded object, so just stay
              * still and wait until they arrive.
              */
-            NS_LOG_INFO(this << " " << m_objectBytesToBeReceived << " byte(s)"
+            NS_LOG_INFO(this << " " << rx.bytesToBeReceived << " byte(s)"
                              << " remains from this chunk of embedded object");
         }
         else
@@ -618,18 +1140,33 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
              * the reception of a whole embedded object
              */
             NS_LOG_INFO(this << " Finished receiving an embedded object.");
-            m_rxEmbeddedObjectTrace(this, m_constructedPacket);
+            // See ReceiveMainObject() on why the reception state decides.
+            if (rx.isAssembling)
+            {
+                m_rxEmbeddedObjectTrace(this, AssembleObject(rx));
+            }
+            rx.packets.clear();
 
-            if (!m_objectServerTs.IsZero())
+            if (!rx.serverTs.IsZero())
             {
-                m_rxDelayTrace(Simulator::Now() - m_objectServerTs, from);
-                m_objectServerTs = MilliSeconds(0); // Reset back to zero.
+                m_rxDelayTrace(Simulator::Now() - rx.serverTs, from);
+                rx.serverTs = MilliSeconds(0); // Reset back to zero.
             }
 
-            if (!m_objectClientTs.IsZero())
+            if (!rx.clientTs.IsZero())
             {
-                m_rxRttTrace(Simulator::Now() - m_objectClientTs, from);
-                m_objectClientTs = MilliSeconds(0); // Reset back to zero.
+                m_rxRttTrace(Simulator::Now() - rx.clientTs, from);
+                rx.clientTs = MilliSeconds(0); // Reset back to zero.
+            }
+
+            NS_ASSERT(connection.isBusy);
+            NS_ASSERT(m_embeddedObjectsOutstanding > 0);
+            connection.isBusy = false;
+            m_embeddedObjectsOutstanding--;
+
+            if (m_cacheModel == CACHE_LRU)
+            {
+                InsertIntoCache(connection.objectId, rx.header.GetContentLength());
             }
 
             if (m_embeddedObjectsToBeRequested > 0)
@@ -637,9 +1174,18 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
                 NS_LOG_INFO(this << " " << m_embeddedObjectsToBeRequested
                                  << " more embedded object(s) to be requested.");
                 // Immediately request another using the existing connection.
-                m_eventRequestEmbeddedObject =
-                    Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject,
-                                           this);
+                if (Simulator::IsExpired(m_eventRequestEmbeddedObject))
+                {
+                    m_eventRequestEmbeddedObject =
+                        Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject,
+                                               this);
+                    TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+                }
+            }
+            else if (m_embeddedObjectsOutstanding > 0)
+            {
+                NS_LOG_INFO(this << " Waiting for " << m_embeddedObjectsOutstanding
+                                 << " more embedded object(s) from other connections.");
             }
             else
             {
@@ -651,7 +1197,7 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
                 EnterReadingTime();
             }
 
-        } // end of else of `if (m_objectBytesToBeReceived > 0)`
+        } // end of else of `if (rx.bytesToBeReceived > 0)`
 
     } // end of `if (m_state == EXPECTING_EMBEDDED_OBJECT)`
     else
@@ -662,60 +1208,89 @@ ThreeGppHttpSatelliteClient::ReceiveEmbeddedObject(Ptr<Packet> packet, const Add
 } // end of `void ReceiveEmbeddedObject (Ptr<Packet> packet)`
 
 void
-ThreeGppHttpSatelliteClient::Receive(Ptr<Packet> packet)
+ThreeGppHttpSatelliteClient::Receive(Ptr<Packet> packet, ObjectRx_t& rx)
 {
     NS_LOG_FUNCTION(this << packet);
 
     /* In a "real" HTTP message the message size is coded differently. The use of a header
      * is to avoid the burden of doing a real message parser.
      */
-    bool firstPacket = false;
-
-    if (m_objectBytesToBeReceived == 0)
+    if (rx.bytesToBeReceived == 0)
     {
-        // This is the first packet of the object.
-        firstPacket = true;
-
-        // Remove the header in order to calculate remaining data to be received.
+        /*
+         * This is the first packet of the object. Remove the header in order to
+         * calculate remaining data to be received.
+         */
         ThreeGppHttpHeader httpHeader;
         packet->RemoveHeader(httpHeader);
 
-        m_objectBytesToBeReceived = httpHeader.GetContentLength();
-        m_objectClientTs = httpHeader.GetClientTs();
-        m_objectServerTs = httpHeader.GetServerTs();
+        rx.bytesToBeReceived = httpHeader.GetContentLength();
+        rx.clientTs = httpHeader.GetClientTs();
+        rx.serverTs = httpHeader.GetServerTs();
 
-        // Take a copy for constructed packet trace. Note that header is included.
-        m_constructedPacket = packet->Copy();
-        m_constructedPacket->AddHeader(httpHeader);
+        // Keep the packets for the object-level trace only if someone listens to it.
+        rx.header = httpHeader;
+        rx.packets.clear();
+        rx.isAssembling = (m_state == EXPECTING_MAIN_OBJECT)
+                              ? !m_rxMainObjectTrace.IsEmpty()
+                              : !m_rxEmbeddedObjectTrace.IsEmpty();
     }
     uint32_t contentSize = packet->GetSize();
 
     /* Note that the packet does not contain header at this point.
      * The content is purely raw data, which was the only intended data to be received.
      */
-    if (m_objectBytesToBeReceived < contentSize)
+    if (rx.bytesToBeReceived < contentSize)
     {
         NS_LOG_WARN(this << " The received packet"
                          << " (" << contentSize << " bytes of content)"
                          << " is larger than"
                          << " the content that we expected to receive"
-                         << " (" << m_objectBytesToBeReceived << " bytes).");
+                         << " (" << rx.bytesToBeReceived << " bytes).");
         // Stop expecting any more packet of this object.
-        m_objectBytesToBeReceived = 0;
-        m_constructedPacket = NULL;
+        rx.bytesToBeReceived = 0;
+        rx.packets.clear();
+        rx.isAssembling = false;
     }
     else
     {
-        m_objectBytesToBeReceived -= contentSize;
-        if (!firstPacket)
+        rx.bytesToBeReceived -= contentSize;
+        if (rx.isAssembling)
         {
-            Ptr<Packet> packetCopy = packet->Copy();
-            m_constructedPacket->AddAtEnd(packetCopy);
+            // The packet is not modified afterwards, so keeping a reference is enough.
+            rx.packets.push_back(packet);
         }
     }
 
 } // end of `void Receive (packet)`
 
+Ptr<Packet>
+ThreeGppHttpSatelliteClient::AssembleObject(ObjectRx_t& rx)
+{
+    NS_LOG_FUNCTION(this << rx.packets.size());
+
+    if (!rx.isAssembling)
+    {
+        return nullptr;
+    }
+
+    Ptr<Packet> object = Create<Packet>();
+    for (std::vector<Ptr<const Packet>>::const_iterator it = rx.packets.begin();
+         it != rx.packets.end();
+         ++it)
+    {
+        object->AddAtEnd(*it);
+    }
+    TRAFFIC_COUNTERS_ADD(m_counters, PACKETS_CREATED, 1);
+    TRAFFIC_COUNTERS_ADD(m_counters, BYTES_COPIED, object->GetSize());
+    TRAFFIC_COUNTERS_MAX(m_counters, RX_BUFFER_HIGH_WATER_MARK, object->GetSize());
+    object->AddHeader(rx.header); // Note that header is included.
+
+    rx.packets.clear();
+    rx.isAssembling = false;
+    return object;
+}
+
 void
 ThreeGppHttpSatelliteClient::EnterParsingTime()
 {
@@ -723,11 +1298,12 @@ ThreeGppHttpSatelliteClient::EnterParsingTime()
 
     if (m_state == EXPECTING_MAIN_OBJECT)
     {
-        const Time parsingTime = m_httpVariables->GetParsingTime();
+        const Time parsingTime = GetHttpVariables()->GetParsingTime();
         NS_LOG_INFO(this << " The parsing of this main object"
                          << " will complete in " << parsingTime.GetSeconds() << " seconds.");
         m_eventParseMainObject =
             Simulator::Schedule(parsingTime, &ThreeGppHttpSatelliteClient::ParseMainObject, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
         SwitchToState(PARSING_MAIN_OBJECT);
     }
     else
@@ -743,10 +1319,43 @@ ThreeGppHttpSatelliteClient::ParseMainObject()
 
     if (m_state == PARSING_MAIN_OBJECT)
     {
-        m_embeddedObjectsToBeRequested = m_httpVariables->GetNumOfEmbeddedObjects();
-        NS_LOG_INFO(this << " Parsing has determined " << m_embeddedObjectsToBeRequested
+        const uint32_t numOfObjects = GetHttpVariables()->GetNumOfEmbeddedObjects();
+        NS_LOG_INFO(this << " Parsing has determined " << numOfObjects
                          << " embedded object(s) in the main object.");
 
+        m_objectIdsToBeRequested.clear();
+        if (m_cacheModel == CACHE_NONE)
+        {
+            m_embeddedObjectsToBeRequested = numOfObjects;
+        }
+        else
+        {
+            m_embeddedObjectsToBeRequested = 0;
+            for (uint32_t i = 0; i < numOfObjects; i++)
+            {
+                // Only the LRU cache tells the objects apart.
+                const uint32_t objectId =
+                    (m_cacheModel == CACHE_LRU) ? m_cacheObjectIdRng->GetInteger() : 0;
+                uint32_t objectSize = 0;
+                if (LookupCache(objectId, objectSize))
+                {
+                    m_cacheHitTrace(this, objectId, objectSize);
+                }
+                else
+                {
+                    m_cacheMissTrace(this, objectId, 0);
+                    if (m_cacheModel == CACHE_LRU)
+                    {
+                        m_objectIdsToBeRequested.push_back(objectId);
+                    }
+                    m_embeddedObjectsToBeRequested++;
+                }
+            }
+
+            NS_LOG_INFO(this << " " << numOfObjects - m_embeddedObjectsToBeRequested
+                             << " embedded object(s) found in the cache.");
+        }
+
         if (m_embeddedObjectsToBeRequested > 0)
         {
             /*
@@ -755,6 +1364,7 @@ ThreeGppHttpSatelliteClient::ParseMainObject()
              */
             m_eventRequestEmbeddedObject =
                 Simulator::ScheduleNow(&ThreeGppHttpSatelliteClient::RequestEmbeddedObject, this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
         }
         else
         {
@@ -773,6 +1383,85 @@ ThreeGppHttpSatelliteClient::ParseMainObject()
 
 } // end of `void ParseMainObject ()`
 
+bool
+ThreeGppHttpSatelliteClient::LookupCache(uint32_t objectId, uint32_t& objectSize)
+{
+    NS_LOG_FUNCTION(this << objectId);
+
+    objectSize = 0;
+    switch (m_cacheModel)
+    {
+    case CACHE_HIT_PROBABILITY:
+        return m_cacheHitRng->GetValue() < m_cacheHitProbability;
+
+    case CACHE_LRU: {
+        std::map<uint32_t, std::list<std::pair<uint32_t, uint32_t>>::iterator>::iterator it =
+            m_cacheIndex.find(objectId);
+        if (it == m_cacheIndex.end())
+        {
+            return false;
+        }
+
+        // Move the object to the most recently used end.
+        m_cacheEntries.splice(m_cacheEntries.begin(), m_cacheEntries, it->second);
+        objectSize = it->second->second;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+
+} // end of `bool LookupCache (uint32_t, uint32_t &)`
+
+void
+ThreeGppHttpSatelliteClient::InsertIntoCache(uint32_t objectId, uint32_t objectSize)
+{
+    NS_LOG_FUNCTION(this << objectId << objectSize);
+
+    if (objectSize > m_cacheSize)
+    {
+        NS_LOG_INFO(this << " Object " << objectId << " is too large for the cache.");
+        return;
+    }
+
+    std::map<uint32_t, std::list<std::pair<uint32_t, uint32_t>>::iterator>::iterator it =
+        m_cacheIndex.find(objectId);
+    if (it != m_cacheIndex.end())
+    {
+        // The same object has been requested more than once in the web page.
+        m_cacheUsedBytes -= it->second->second;
+        m_cacheEntries.erase(it->second);
+        m_cacheIndex.erase(it);
+    }
+
+    m_cacheEntries.push_front(std::make_pair(objectId, objectSize));
+    m_cacheIndex[objectId] = m_cacheEntries.begin();
+    m_cacheUsedBytes += objectSize;
+
+    while (m_cacheUsedBytes > m_cacheSize)
+    {
+        const std::pair<uint32_t, uint32_t>& lru = m_cacheEntries.back();
+        NS_LOG_LOGIC(this << " Evicting object " << lru.first << " of " << lru.second
+                          << " bytes from the cache.");
+        m_cacheUsedBytes -= lru.second;
+        m_cacheIndex.erase(lru.first);
+        m_cacheEntries.pop_back();
+    }
+
+} // end of `void InsertIntoCache (uint32_t, uint32_t)`
+
+Ptr<ThreeGppHttpVariables>
+ThreeGppHttpSatelliteClient::GetHttpVariables()
+{
+    if (m_httpVariables == nullptr)
+    {
+        m_httpVariables = CreateObject<ThreeGppHttpVariables>();
+    }
+
+    return m_httpVariables;
+}
+
 void
 ThreeGppHttpSatelliteClient::EnterReadingTime()
 {
@@ -780,7 +1469,7 @@ ThreeGppHttpSatelliteClient::EnterReadingTime()
 
     if (m_state == EXPECTING_EMBEDDED_OBJECT || m_state == PARSING_MAIN_OBJECT)
     {
-        const Time readingTime = m_httpVariables->GetReadingTime();
+        const Time readingTime = GetHttpVariables()->GetReadingTime();
         NS_LOG_INFO(this << " Client will finish reading this web page in "
                          << readingTime.GetSeconds() << " seconds.");
 
@@ -789,7 +1478,17 @@ ThreeGppHttpSatelliteClient::EnterReadingTime()
         // Schedule a request of another main object once the reading time expires.
         m_eventRequestMainObject =
             Simulator::Schedule(readingTime, &ThreeGppHttpSatelliteClient::RequestMainObject, this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
         SwitchToState(READING);
+
+        if (!m_keepAliveTimeout.IsZero() && m_keepAliveTimeout < readingTime)
+        {
+            m_eventKeepAliveTimeout =
+                Simulator::Schedule(m_keepAliveTimeout,
+                                    &ThreeGppHttpSatelliteClient::CloseIdleConnections,
+                                    this);
+            TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+        }
     }
     else
     {
@@ -825,29 +1524,113 @@ ThreeGppHttpSatelliteClient::CancelAllPendingEvents()
                          << " seconds.");
         Simulator::Cancel(m_eventParseMainObject);
     }
+
+    Simulator::Cancel(m_eventKeepAliveTimeout);
+    Simulator::Cancel(m_eventPreconnect);
+    Simulator::Cancel(m_eventSaveCheckpoint);
 }
 
+void
+ThreeGppHttpSatelliteClient::SaveCheckpoint()
+{
+    NS_LOG_FUNCTION(this << GetStateString());
+
+    Time readingTimeLeft = Seconds(0);
+    if (m_state == READING && !Simulator::IsExpired(m_eventRequestMainObject))
+    {
+        readingTimeLeft = Simulator::GetDelayLeft(m_eventRequestMainObject);
+    }
+
+    m_checkpoint.Record(CKPT_STATE, static_cast<uint32_t>(m_state));
+    m_checkpoint.Record(CKPT_READING_TIME_LEFT, readingTimeLeft);
+
+    // Least recently used first, so that restoring recreates the same order.
+    m_checkpoint.Record(CKPT_NUM_OF_CACHE_ENTRIES, static_cast<uint32_t>(m_cacheEntries.size()));
+    std::list<std::pair<uint32_t, uint32_t>>::const_reverse_iterator it;
+    for (it = m_cacheEntries.rbegin(); it != m_cacheEntries.rend(); ++it)
+    {
+        m_checkpoint.Record(CKPT_CACHE_OBJECT_ID, it->first);
+        m_checkpoint.Record(CKPT_CACHE_OBJECT_SIZE, it->second);
+    }
+
+    NS_LOG_INFO(this << " Saved a checkpoint in state " << GetStateString() << " with "
+                     << readingTimeLeft.GetSeconds() << " seconds of reading time left and "
+                     << m_cacheEntries.size() << " cached objects.");
+}
+
+bool
+ThreeGppHttpSatelliteClient::RestoreCheckpoint()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_checkpoint.HasValue(CKPT_STATE))
+    {
+        return false;
+    }
+
+    const State_t state = static_cast<State_t>(m_checkpoint.ReplayInteger(CKPT_STATE));
+    const Time readingTimeLeft = m_checkpoint.ReplayTime(CKPT_READING_TIME_LEFT);
+    const uint32_t numOfCacheEntries = m_checkpoint.ReplayInteger(CKPT_NUM_OF_CACHE_ENTRIES);
+    for (uint32_t i = 0; i < numOfCacheEntries; i++)
+    {
+        const uint32_t objectId = m_checkpoint.ReplayInteger(CKPT_CACHE_OBJECT_ID);
+        const uint32_t objectSize = m_checkpoint.ReplayInteger(CKPT_CACHE_OBJECT_SIZE);
+        InsertIntoCache(objectId, objectSize);
+    }
+
+    NS_LOG_INFO(this << " Restored a checkpoint in state " << GetStateString(state) << " with "
+                     << readingTimeLeft.GetSeconds() << " seconds of reading time left and "
+                     << m_cacheEntries.size() << " cached objects.");
+
+    if (state == READING && readingTimeLeft.IsStrictlyPositive())
+    {
+        // Continue the reading time over a connection opened right away, like
+        // a connection kept alive from the previous web page.
+        SetupConnection();
+        SwitchToState(READING);
+        m_eventRequestMainObject =
+            Simulator::Schedule(readingTimeLeft,
+                                &ThreeGppHttpSatelliteClient::RequestMainObject,
+                                this);
+        TRAFFIC_COUNTERS_ADD(m_counters, EVENTS_SCHEDULED, 1);
+    }
+    else
+    {
+        // A web page in progress cannot be resumed, so request a new one.
+        OpenConnection();
+    }
+
+    return true;
+
+} // end of `bool RestoreCheckpoint ()`
+
 void
 ThreeGppHttpSatelliteClient::SwitchToState(ThreeGppHttpSatelliteClient::State_t state)
 {
-    const std::string oldState = GetStateString();
-    const std::string newState = GetStateString(state);
-    NS_LOG_FUNCTION(this << oldState << newState);
+    NS_LOG_FUNCTION(this << GetStateString() << GetStateString(state));
 
-    if ((state == EXPECTING_MAIN_OBJECT) || (state == EXPECTING_EMBEDDED_OBJECT))
+    // Embedded objects are checked per connection by SendEmbeddedObjectRequest().
+    if (state == EXPECTING_MAIN_OBJECT && !m_connections.empty())
     {
-        if (m_objectBytesToBeReceived > 0)
+        if (m_connections[0].rx.bytesToBeReceived > 0)
         {
             NS_FATAL_ERROR("Cannot start a new receiving session"
                            << " if the previous object"
-                           << " (" << m_objectBytesToBeReceived << " bytes)"
+                           << " (" << m_connections[0].rx.bytesToBeReceived << " bytes)"
                            << " is not completely received yet.");
         }
     }
 
+    const State_t oldState = m_state;
     m_state = state;
-    NS_LOG_INFO(this << " HttpClient " << oldState << " --> " << newState << ".");
-    m_stateTransitionTrace(oldState, newState);
+    NS_LOG_INFO(this << " HttpClient " << GetStateString(oldState) << " --> "
+                     << GetStateString(state) << ".");
+
+    // Avoid building the strings when nothing listens to the trace source.
+    if (!m_stateTransitionTrace.IsEmpty())
+    {
+        m_stateTransitionTrace(GetStateString(oldState), GetStateString(state));
+    }
 }
 
 } // namespace ns3
@@ -24,8 +24,15 @@
 
 #include <ns3/address.h>
 #include <ns3/application.h>
+#include <ns3/lazy-traced-callback.h>
+#include <ns3/random-variable-stream.h>
 #include <ns3/three-gpp-http-header.h>
-#include <ns3/traced-callback.h>
+#include <ns3/traffic-counters.h>
+#include <ns3/traffic-schedule-log.h>
+
+#include <list>
+#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -85,7 +92,8 @@ class ThreeGppHttpVariables;
  *    - If at least one embedded object is determined, the application requests
  *      the first embedded object from the server. The request for the next
  *      embedded object follows after the previous embedded object has been
- *      completely received.
+ *      completely received, unless parallel connections are enabled (see
+ *      below).
  *    - If there is no more embedded object to request, the application enters
  *      the *reading time*.
  * 5. Reading time is a long delay (again, randomly determined) where the
@@ -97,11 +105,61 @@ class ThreeGppHttpVariables;
  * connection to the server is maintained and used for transmitting and receiving
  * all objects.
  *
+ * Like a real web browser, the client may fetch embedded objects through
+ * several TCP connections in parallel. The `MaxParallelConnections` attribute
+ * limits the number of connections, including the one used for main objects.
+ * Additional connections are opened when a web page has more embedded objects
+ * than idle connections, and then kept open for the following web pages. At
+ * most one object is outstanding on each connection, because ThreeGppHttpServer
+ * serves one object at a time per socket (i.e., requests are not pipelined).
+ * The `RxDelay` and `RxRtt` trace sources are computed per object, and the
+ * `RxPlt` trace source is fired once the last outstanding embedded object has
+ * been received.
+ *
+ * The connections may be closed during the reading time, either by the server
+ * or by the client itself after the `KeepAliveTimeout` attribute. The next web
+ * page is then requested after a new connection to the server has been
+ * established. If the `Preconnect` attribute is enabled, the new connection is
+ * opened in advance, based on the last measured connection setup time, so that
+ * it is ready by the end of the reading time. The `ConnectionSetupDelay` trace
+ * source reports how long each web page request has waited for a connection.
+ *
  * Each request by default has a constant size of 350 bytes. A ThreeGppHttpHeader
  * is attached to each request packet. The header contains information
  * such as the content type requested (either main object or embedded object)
  * and the timestamp when the packet is transmitted (which will be used to
  * compute the delay and RTT of the packet).
+ *
+ * Optionally, the client models the cache of a web browser, selected by the
+ * `CacheModel` attribute. An embedded object found in the cache is neither
+ * requested nor received. The cache is either:
+ *   - `HIT_PROBABILITY`, where each embedded object is found in the cache with
+ *     the probability given by the `CacheHitProbability` attribute, drawn from
+ *     the `CacheHitRandomVariable` attribute; or
+ *   - `LRU`, where each embedded object determined by parsing is given an
+ *     identity drawn from the `CacheObjectIdentity` random variable, which by
+ *     default picks one of the 1000 objects of a web site by their
+ *     Zipf-distributed popularity. The received embedded objects are stored by
+ *     their identity until the `CacheSize` attribute in bytes is exceeded, and
+ *     then evicted in least recently used order.
+ * Each lookup fires either the `CacheHit` or the `CacheMiss` trace source.
+ * Unless set, the random variable of the selected cache model is created upon
+ * start, and those of the other cache models are never created.
+ *
+ * Received objects are normally tracked only by their byte count and
+ * timestamps. The packets of an object are kept and assembled into a single
+ * packet only if a sink is connected to the `RxMainObject` or
+ * `RxEmbeddedObject` trace source (whichever matches the object) by the time
+ * the first packet of the object arrives. The trace source is fired only for
+ * the objects assembled this way, so a sink connected later misses the object
+ * in reception, and an object cut short by an oversized packet is not traced.
+ *
+ * The logical state of the client can be saved into a checkpoint and restored
+ * in later runs, so that several runs can be forked from one warmed-up state
+ * (see SetCheckpointFile()). The checkpoint holds the state of the client, the
+ * reading time left, and the contents of the LRU cache. A client restored in
+ * the middle of its reading time continues the reading time, while a client
+ * saved in the middle of a web page requests a new web page right away.
  */
 class ThreeGppHttpSatelliteClient : public Application
 {
@@ -127,6 +185,12 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     Ptr<Socket> GetSocket() const;
 
+    /**
+     * Returns the total number of bytes received so far.
+     * \return The sum of the sizes of the packets passed to the `Rx` trace source.
+     */
+    uint64_t GetTotalRx() const;
+
     /// The possible states of the application.
     enum State_t
     {
@@ -158,6 +222,25 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     std::string GetStateString() const;
 
+    /**
+     * \param fileName name of the checkpoint file, or an empty string to
+     *                 neither save nor restore a checkpoint.
+     *
+     * The checkpoint is opened in the mode given by the `CheckpointMode`
+     * attribute, so the mode must be set first. In the `SAVE` mode, the state
+     * is saved at the time given by the `CheckpointTime` attribute. In the
+     * `RESTORE` mode, the saved state replaces the initial state when the
+     * application starts. Each client becomes a new owner of the checkpoint
+     * (see TrafficScheduleLog), so the clients must be created in the same
+     * order when saving and when restoring.
+     */
+    void SetCheckpointFile(std::string fileName);
+
+    /**
+     * \return name of the checkpoint file, or an empty string if none.
+     */
+    std::string GetCheckpointFile() const;
+
     /**
      * Returns the given state in string format.
      * \param state An arbitrary state of an application.
@@ -173,15 +256,74 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     typedef void (*TracedCallback)(Ptr<const ThreeGppHttpSatelliteClient> httpClient);
 
+    /// The possible models of the browser cache.
+    enum CacheModel_t
+    {
+        /// Every embedded object is requested from the server.
+        CACHE_NONE = 0,
+        /// Embedded objects are found in the cache with a fixed probability.
+        CACHE_HIT_PROBABILITY,
+        /// Received embedded objects are cached with least recently used eviction.
+        CACHE_LRU
+    };
+
+    /**
+     * Common callback signature for `CacheHit` and `CacheMiss` trace sources.
+     * \param httpClient Pointer to this instance of ThreeGppHttpSatelliteClient,
+     *                   which is where the trace originated.
+     * \param objectId The identity of the embedded object, or zero in the
+     *                 `HIT_PROBABILITY` cache model.
+     * \param objectSize The size of the cached embedded object in bytes, or zero
+     *                   if not known (always on a cache miss).
+     */
+    typedef void (*CacheTracedCallback)(Ptr<const ThreeGppHttpSatelliteClient> httpClient,
+                                        uint32_t objectId,
+                                        uint32_t objectSize);
+
   protected:
     // Inherited from Object base class.
     virtual void DoDispose();
 
+    // Inherited from ObjectBase base class.
+    virtual void NotifyConstructionCompleted();
+
     // Inherited from Application base class.
     virtual void StartApplication();
     virtual void StopApplication();
 
   private:
+    /// Reception state of the object being received through one connection.
+    struct ObjectRx_t
+    {
+        /// According to the content length specified by the ThreeGppHttpHeader.
+        uint32_t bytesToBeReceived = 0;
+        /// The ThreeGppHttpHeader of the object being received.
+        ThreeGppHttpHeader header;
+        /// Received packets of the current object, kept only while #isAssembling.
+        std::vector<Ptr<const Packet>> packets;
+        /// True if the packets of the current object are kept for AssembleObject().
+        bool isAssembling = false;
+        /// The client time stamp of the ThreeGppHttpHeader from the last received packet.
+        Time clientTs;
+        /// The server time stamp of the ThreeGppHttpHeader from the last received packet.
+        Time serverTs;
+    };
+
+    /// A connection to the web server.
+    struct Connection_t
+    {
+        /// The socket of the connection.
+        Ptr<Socket> socket;
+        /// True once the connection has been established.
+        bool isConnected = false;
+        /// True while an embedded object is outstanding on the connection.
+        bool isBusy = false;
+        /// Identity of the outstanding embedded object, if a cache is modelled.
+        uint32_t objectId = 0;
+        /// Reception state of the connection.
+        ObjectRx_t rx;
+    };
+
     // SOCKET CALLBACK METHODS
 
     /**
@@ -209,11 +351,25 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     void ErrorCloseCallback(Ptr<Socket> socket);
     /**
-     * Invoked when #m_socket receives some packet data. Fires the `Rx` trace
-     * source and triggers ReceiveMainObject() or ReceiveEmbeddedObject().
+     * Invoked when #m_socket or one of the parallel connections receives some
+     * packet data. Fires the `Rx` trace source and triggers ReceiveMainObject()
+     * or ReceiveEmbeddedObject().
      * \param socket Pointer to the socket where the event originates from.
      */
     void ReceivedDataCallback(Ptr<Socket> socket);
+    /**
+     * Invoked when a parallel connection is established successfully. This
+     * triggers a request for an embedded object if there is one to request.
+     * \param socket Pointer to the socket where the event originates from.
+     */
+    void ParallelConnectionSucceededCallback(Ptr<Socket> socket);
+    /**
+     * Invoked when a parallel connection cannot be established or has been
+     * terminated. The connection is forgotten, and the embedded object which was
+     * outstanding on it, if any, is requested again through another connection.
+     * \param socket Pointer to the socket where the event originates from.
+     */
+    void ParallelConnectionClosedCallback(Ptr<Socket> socket);
 
     // CONNECTION-RELATED METHOD
 
@@ -223,6 +379,73 @@ class ThreeGppHttpSatelliteClient : public Application
      * listen to its event. Invoked upon the start of the application.
      */
     void OpenConnection();
+    /**
+     * Create #m_socket, start connecting it to the web server, and set up
+     * callbacks to listen to its event, without changing the state.
+     */
+    void SetupConnection();
+    /**
+     * Remove the callbacks of #m_socket and forget it, so that the next web
+     * page needs a new connection.
+     */
+    void ForgetConnection();
+    /**
+     * Close all connections because they have been idle for the duration of the
+     * `KeepAliveTimeout` attribute during the reading time.
+     */
+    void CloseIdleConnections();
+    /**
+     * Close and forget all parallel connections.
+     */
+    void CloseParallelConnections();
+    /**
+     * If the `Preconnect` attribute is enabled, schedule Preconnect() so that
+     * the new connection would be ready by the end of the reading time.
+     */
+    void SchedulePreconnect();
+    /**
+     * Open a new connection during the reading time, in advance of the next
+     * web page.
+     */
+    void Preconnect();
+    /**
+     * Look up an embedded object in the browser cache.
+     * \param objectId The identity of the embedded object.
+     * \param[out] objectSize The size of the cached object in bytes, or zero if
+     *                        not known.
+     * \return True if the object is found in the cache.
+     */
+    bool LookupCache(uint32_t objectId, uint32_t& objectSize);
+    /**
+     * Store a received embedded object in the LRU cache, evicting the least
+     * recently used objects if the cache size is exceeded.
+     * \param objectId The identity of the embedded object.
+     * \param objectSize The size of the embedded object in bytes.
+     */
+    void InsertIntoCache(uint32_t objectId, uint32_t objectSize);
+    /**
+     * Returns the variables of this client, creating a private instance if the
+     * `Variables` attribute has not been set.
+     * \return Pointer to the variables.
+     */
+    Ptr<ThreeGppHttpVariables> GetHttpVariables();
+    /**
+     * Open additional connections to the web server, so that every embedded
+     * object still to be requested would have its own connection, within the
+     * limit of the `MaxParallelConnections` attribute.
+     */
+    void OpenParallelConnections();
+    /**
+     * Create a new TCP socket and start connecting it to the destination web
+     * server at #m_remoteServerAddress and #m_remoteServerPort.
+     * \return Pointer to the new socket.
+     */
+    Ptr<Socket> CreateSocket();
+    /**
+     * \param socket Pointer to the socket of one of the connections.
+     * \return Index of the connection in #m_connections.
+     */
+    uint32_t GetConnectionIndex(Ptr<Socket> socket) const;
 
     // TX-RELATED METHODS
 
@@ -236,13 +459,21 @@ class ThreeGppHttpSatelliteClient : public Application
      * reading time has elapsed.
      */
     void RequestMainObject();
+    /**
+     * Send requests for embedded objects through every idle connection, as long
+     * as there are embedded objects to be requested, and then open more
+     * parallel connections if needed.
+     */
+    void RequestEmbeddedObject();
     /**
      * Send a request object for an embedded object to the destination web
      * server. The size of the request packet is randomly determined by
      * ThreeGppHttpVariables and is assumed to be smaller than 536 bytes. Fires the
      * `TxEmbeddedObjectRequest` trace source.
+     * \param index Index of the idle connection in #m_connections.
+     * \return True if the request has been sent.
      */
-    void RequestEmbeddedObject();
+    bool SendEmbeddedObjectRequest(uint32_t index);
 
     // RX-RELATED METHODS
 
@@ -252,8 +483,8 @@ class ThreeGppHttpSatelliteClient : public Application
      *
      * A main object may come from more than one packets. This is determined by
      * comparing the content length specified in the ThreeGppHttpHeader of the packet and
-     * the actual packet size. #m_objectBytesToBeReceived keeps track of the
-     * number of bytes that has been received.
+     * the actual packet size. The reception state of #m_socket keeps track of
+     * the number of bytes that has been received.
      *
      * If the received packet is not the last packet of the object, then the
      * method simply quits, expecting it to be invoked again when the next packet
@@ -273,8 +504,8 @@ class ThreeGppHttpSatelliteClient : public Application
      *
      * An embedded object may come from more than one packets. This is determined
      * by comparing the content length specified in the TheeGppHttpHeader of the packet and
-     * the actual packet size. #m_objectBytesToBeReceived keeps track of the
-     * number of bytes that has been received.
+     * the actual packet size. The reception state of the connection keeps track
+     * of the number of bytes that has been received.
      *
      * If the received packet is not the last packet of the object, then the
      * method simply quits, expecting it to be invoked again when the next packet
@@ -283,26 +514,43 @@ class ThreeGppHttpSatelliteClient : public Application
      * If the received packet is the last packet of the object, then the method
      * fires the `RxEmbeddedObject`, `RxDelay`, and `RxRtt` trace sources.
      * Depending on the number of embedded objects remaining
-     * (#m_embeddedObjectsToBeRequested) the client can either trigger
-     * RequestEmbeddedObject() or EnterReadingTime().
+     * (#m_embeddedObjectsToBeRequested and #m_embeddedObjectsOutstanding) the
+     * client can either trigger RequestEmbeddedObject(), keep waiting for the
+     * other connections, or trigger EnterReadingTime().
      *
      * \param packet The received packet.
      * \param from Address of the sender.
+     * \param index Index of the connection in #m_connections.
      */
-    void ReceiveEmbeddedObject(Ptr<Packet> packet, const Address& from);
+    void ReceiveEmbeddedObject(Ptr<Packet> packet, const Address& from, uint32_t index);
+
     /**
      * Simulate a consumption of the received packet by subtracting the packet
-     * size from the internal counter at #m_objectBytesToBeReceived. Also updates
-     * #m_objectClientTs and #m_objectServerTs according to the ThreeGppHttpHeader
-     * found in the packet.
+     * size from the internal counter of the reception state. Also updates the
+     * client and server time stamps according to the ThreeGppHttpHeader found
+     * in the packet.
      *
      * This method is invoked as a sub-procedure of ReceiveMainObject() and
      * ReceiveEmbeddedObject().
      *
      * \param packet The received packet. If it is the first packet of the object,
      *               then it must have a ThreeGppHttpHeader attached to it.
+     * \param rx The reception state of the connection where the packet came from.
+     */
+    void Receive(Ptr<Packet> packet, ObjectRx_t& rx);
+    /**
+     * Assemble the packets kept by Receive() into a single packet, with the
+     * ThreeGppHttpHeader of the object attached to it, and forget the packets.
+     *
+     * This method is invoked only when the last packet of an object has been
+     * received and a sink is connected to the matching object-level trace
+     * source.
+     *
+     * \param rx The reception state of the connection where the object came from.
+     * \return The whole object, or a null pointer if the packets of the object
+     *         have not been kept.
      */
-    void Receive(Ptr<Packet> packet);
+    Ptr<Packet> AssembleObject(ObjectRx_t& rx);
 
     // OFF-TIME-RELATED METHODS
 
@@ -332,12 +580,37 @@ class ThreeGppHttpSatelliteClient : public Application
      */
     void EnterReadingTime();
     /**
-     * Cancels #m_eventRequestMainObject, #m_eventRequestEmbeddedObject, and
-     * #m_eventParseMainObject. Invoked by StopApplication() and when connection
+     * Cancels #m_eventRequestMainObject, #m_eventRequestEmbeddedObject,
+     * #m_eventParseMainObject, #m_eventKeepAliveTimeout, and
+     * #m_eventPreconnect. Invoked by StopApplication() and when connection
      * has been terminated.
      */
     void CancelAllPendingEvents();
 
+    // CHECKPOINT-RELATED METHODS
+
+    /// Variables of the checkpoint, each of them stored as a separate channel.
+    typedef enum
+    {
+        CKPT_STATE = 0,            ///< State of the client.
+        CKPT_READING_TIME_LEFT,    ///< Reading time left, or zero if not reading.
+        CKPT_NUM_OF_CACHE_ENTRIES, ///< Number of objects in the LRU cache.
+        CKPT_CACHE_OBJECT_ID,      ///< Identity of each cached object.
+        CKPT_CACHE_OBJECT_SIZE     ///< Size of each cached object in bytes.
+    } CheckpointVariable_t;
+
+    /**
+     * Write the current state into #m_checkpoint. Scheduled at the time given
+     * by the `CheckpointTime` attribute.
+     */
+    void SaveCheckpoint();
+    /**
+     * Replace the initial state by the one read from #m_checkpoint.
+     * \return True if a state has been restored, or false if the application
+     *         should start from scratch.
+     */
+    bool RestoreCheckpoint();
+
     /**
      * Change the state of the client. Fires the `StateTransition` trace source.
      * \param state The new state.
@@ -346,62 +619,109 @@ class ThreeGppHttpSatelliteClient : public Application
 
     /// The current state of the client application. Begins with NOT_STARTED.
     State_t m_state;
+    /// The `Preconnect` attribute, kept next to #m_state to avoid padding.
+    bool m_preconnect;
     /// The socket for sending and receiving packets to/from the web server.
     Ptr<Socket> m_socket;
-    /// According to the content length specified by the ThreeGppHttpHeader.
-    uint32_t m_objectBytesToBeReceived;
-    /// The packet constructed of one or more parts with ThreeGppHttpHeader.
-    Ptr<Packet> m_constructedPacket;
-    /// The client time stamp of the ThreeGppHttpHeader from the last received packet.
-    Time m_objectClientTs;
-    /// The server time stamp of the ThreeGppHttpHeader from the last received packet.
-    Time m_objectServerTs;
+    /// Connections to the web server. The first one always belongs to #m_socket.
+    std::vector<Connection_t> m_connections;
     /// Determined after parsing the main object.
     uint32_t m_embeddedObjectsToBeRequested;
+    /// Number of embedded objects requested but not completely received yet.
+    uint32_t m_embeddedObjectsOutstanding;
+    /// Total number of bytes received from all connections.
+    uint64_t m_totalRx;
 
     // ATTRIBUTES
 
-    /// The `Variables` attribute.
+    // The attributes are ordered so that the 4-byte fields come in pairs.
+
+    /// The `Variables` attribute. A private instance is created upon
+    /// construction unless the attribute is set, e.g., to an instance shared
+    /// by many clients.
     Ptr<ThreeGppHttpVariables> m_httpVariables;
     /// The `RemoteServerAddress` attribute. The address of the web server.
     Address m_remoteServerAddress;
     /// The `RemoteServerPort` attribute.
     uint16_t m_remoteServerPort;
+    /// The `MaxParallelConnections` attribute.
+    uint32_t m_maxParallelConnections;
+    /// The `CacheModel` attribute.
+    CacheModel_t m_cacheModel;
+    /// The `KeepAliveTimeout` attribute.
+    Time m_keepAliveTimeout;
+    /// The `CacheHitProbability` attribute.
+    double m_cacheHitProbability;
+    /// The `CacheSize` attribute.
+    uint32_t m_cacheSize;
+    /// The `CheckpointMode` attribute.
+    TrafficScheduleLog::Mode_t m_checkpointMode;
+    /// The `CacheObjectIdentity` attribute.
+    Ptr<RandomVariableStream> m_cacheObjectIdRng;
+    /// The `CheckpointFile` attribute.
+    std::string m_checkpointFile;
+    /// The `CheckpointTime` attribute.
+    Time m_checkpointTime;
+    /// Membership in the checkpoint, closed unless `CheckpointFile` is set.
+    TrafficScheduleLogHandle m_checkpoint;
+    /// The `CacheHitRandomVariable` attribute.
+    Ptr<RandomVariableStream> m_cacheHitRng;
+    /// Identities of the embedded objects of the web page not requested yet.
+    /// A list, because an empty deque already allocates a block of memory.
+    std::list<uint32_t> m_objectIdsToBeRequested;
+    /// Identity and size of the objects in the LRU cache, most recently used first.
+    std::list<std::pair<uint32_t, uint32_t>> m_cacheEntries;
+    /// Position of each object in #m_cacheEntries, indexed by identity.
+    std::map<uint32_t, std::list<std::pair<uint32_t, uint32_t>>::iterator> m_cacheIndex;
+    /// Total size of the objects in the LRU cache in bytes.
+    uint64_t m_cacheUsedBytes;
     /// Time of request for main object
     Time m_requestTime;
+    /// Time when the next web page has been requested by the user.
+    Time m_pageRequestTime;
+    /// Time when #m_socket started connecting.
+    Time m_connectionOpenTime;
+    /// Time needed for establishing the last connection.
+    Time m_lastConnectionSetupDelay;
 
     // TRACE SOURCES
 
     /// The `ConnectionEstablished` trace source.
-    ns3::TracedCallback<Ptr<const ThreeGppHttpSatelliteClient>> m_connectionEstablishedTrace;
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>> m_connectionEstablishedTrace;
     /// The `ConnectionClosed` trace source.
-    ns3::TracedCallback<Ptr<const ThreeGppHttpSatelliteClient>> m_connectionClosedTrace;
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>> m_connectionClosedTrace;
+    /// The `ConnectionSetupDelay` trace source.
+    LazyTracedCallback<Time> m_connectionSetupDelayTrace;
+    /// The `CacheHit` trace source.
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, uint32_t, uint32_t> m_cacheHitTrace;
+    /// The `CacheMiss` trace source.
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, uint32_t, uint32_t> m_cacheMissTrace;
     /// The `Tx` trace source.
-    ns3::TracedCallback<Ptr<const Packet>> m_txTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_txTrace;
     /// The `TxMainObjectRequest` trace source.
-    ns3::TracedCallback<Ptr<const Packet>> m_txMainObjectRequestTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_txMainObjectRequestTrace;
     /// The `TxEmbeddedObjectRequest` trace source.
-    ns3::TracedCallback<Ptr<const Packet>> m_txEmbeddedObjectRequestTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_txEmbeddedObjectRequestTrace;
     /// The `TxMainObjectPacket` trace source.
-    ns3::TracedCallback<Ptr<const Packet>> m_rxMainObjectPacketTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_rxMainObjectPacketTrace;
     /// The `TxMainObject` trace source.
-    ns3::TracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, Ptr<const Packet>>
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, Ptr<const Packet>>
         m_rxMainObjectTrace;
     /// The `TxEmbeddedObjectPacket` trace source.
-    ns3::TracedCallback<Ptr<const Packet>> m_rxEmbeddedObjectPacketTrace;
+    LazyTracedCallback<Ptr<const Packet>> m_rxEmbeddedObjectPacketTrace;
     /// The `TxEmbeddedObject` trace source.
-    ns3::TracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, Ptr<const Packet>>
+    LazyTracedCallback<Ptr<const ThreeGppHttpSatelliteClient>, Ptr<const Packet>>
         m_rxEmbeddedObjectTrace;
     /// The `Rx` trace source.
-    ns3::TracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
+    LazyTracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
     /// The `RxDelay` trace source.
-    ns3::TracedCallback<const Time&, const Address&> m_rxDelayTrace;
+    LazyTracedCallback<const Time&, const Address&> m_rxDelayTrace;
     /// The `RxPlt` trace source.
-    ns3::TracedCallback<const Time&, const Address&> m_rxPltTrace;
+    LazyTracedCallback<const Time&, const Address&> m_rxPltTrace;
     /// The `RxRtt` trace source.
-    ns3::TracedCallback<const Time&, const Address&> m_rxRttTrace;
+    LazyTracedCallback<const Time&, const Address&> m_rxRttTrace;
     /// The `StateTransition` trace source.
-    ns3::TracedCallback<const std::string&, const std::string&> m_stateTransitionTrace;
+    LazyTracedCallback<const std::string&, const std::string&> m_stateTransitionTrace;
 
     // EVENTS
 
@@ -420,6 +740,23 @@ class ThreeGppHttpSatelliteClient : public Application
      * elapsed.
      */
     EventId m_eventParseMainObject;
+    /**
+     * An event of CloseIdleConnections(), scheduled when the reading time
+     * begins.
+     */
+    EventId m_eventKeepAliveTimeout;
+    /**
+     * An event of Preconnect(), scheduled after the connection has been closed
+     * during the reading time.
+     */
+    EventId m_eventPreconnect;
+    /**
+     * An event of SaveCheckpoint(), scheduled upon start in the `SAVE` mode.
+     */
+    EventId m_eventSaveCheckpoint;
+
+    /// Instrumentation counters (if enabled).
+    TRAFFIC_COUNTERS_DECLARE(m_counters)
 
 }; // end of `class ThreeGppHttpSatelliteClient`
 
@@ -0,0 +1,197 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "traffic-counters.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("TrafficCounters");
+
+namespace ns3
+{
+
+// TRAFFIC COUNTERS ///////////////////////////////////////////////////////////
+
+std::string
+TrafficCounters::GetCounterName(Counter_t counter)
+{
+    switch (counter)
+    {
+    case EVENTS_SCHEDULED:
+        return "events_scheduled";
+    case PACKETS_CREATED:
+        return "packets_created";
+    case BYTES_COPIED:
+        return "bytes_copied";
+    case RX_BUFFER_HIGH_WATER_MARK:
+        return "rx_buffer_high_water_mark";
+    case REASSEMBLY_SPLITS:
+        return "reassembly_splits";
+    default:
+        NS_FATAL_ERROR("Unknown counter " << static_cast<uint32_t>(counter));
+        return "";
+    }
+}
+
+TrafficCounters::TrafficCounters(std::string owner, uint32_t nodeId)
+    : m_owner(owner),
+      m_nodeId(nodeId)
+{
+    NS_LOG_FUNCTION(this << owner << nodeId);
+    Reset();
+}
+
+uint64_t
+TrafficCounters::Get(Counter_t counter) const
+{
+    NS_ASSERT(counter < NUM_OF_COUNTERS);
+    return m_values[counter];
+}
+
+std::string
+TrafficCounters::GetOwner() const
+{
+    return m_owner;
+}
+
+uint32_t
+TrafficCounters::GetNodeId() const
+{
+    return m_nodeId;
+}
+
+void
+TrafficCounters::Reset()
+{
+    for (uint32_t i = 0; i < NUM_OF_COUNTERS; i++)
+    {
+        m_values[i] = 0;
+    }
+}
+
+// TRAFFIC COUNTER REGISTRY ///////////////////////////////////////////////////
+
+bool
+TrafficCounterRegistry::IsEnabled()
+{
+#ifdef NS3_TRAFFIC_COUNTERS_ENABLE
+    return true;
+#else
+    return false;
+#endif
+}
+
+Ptr<TrafficCounters>
+TrafficCounterRegistry::Register(std::string owner, uint32_t nodeId)
+{
+    NS_LOG_FUNCTION(owner << nodeId);
+    Ptr<TrafficCounters> counters = Create<TrafficCounters>(owner, nodeId);
+    GetList().push_back(counters);
+    return counters;
+}
+
+const std::vector<Ptr<TrafficCounters>>&
+TrafficCounterRegistry::GetAll()
+{
+    return GetList();
+}
+
+uint64_t
+TrafficCounterRegistry::GetTotal(TrafficCounters::Counter_t counter)
+{
+    uint64_t total = 0;
+    for (const Ptr<TrafficCounters>& counters : GetList())
+    {
+        const uint64_t value = counters->Get(counter);
+        if (counter == TrafficCounters::RX_BUFFER_HIGH_WATER_MARK)
+        {
+            total = std::max(total, value);
+        }
+        else
+        {
+            total += value;
+        }
+    }
+    return total;
+}
+
+void
+TrafficCounterRegistry::Dump(std::ostream& os)
+{
+    os << "owner node";
+    for (uint32_t i = 0; i < TrafficCounters::NUM_OF_COUNTERS; i++)
+    {
+        os << " " << TrafficCounters::GetCounterName(static_cast<TrafficCounters::Counter_t>(i));
+    }
+    os << "\n";
+
+    const std::vector<Ptr<TrafficCounters>>& list = GetList();
+    if (list.empty())
+    {
+        return;
+    }
+
+    for (const Ptr<TrafficCounters>& counters : list)
+    {
+        os << counters->GetOwner() << " " << counters->GetNodeId();
+        for (uint32_t i = 0; i < TrafficCounters::NUM_OF_COUNTERS; i++)
+        {
+            os << " " << counters->Get(static_cast<TrafficCounters::Counter_t>(i));
+        }
+        os << "\n";
+    }
+
+    os << "total -";
+    for (uint32_t i = 0; i < TrafficCounters::NUM_OF_COUNTERS; i++)
+    {
+        os << " " << GetTotal(static_cast<TrafficCounters::Counter_t>(i));
+    }
+    os << "\n";
+
+} // end of `void Dump (std::ostream &)`
+
+void
+TrafficCounterRegistry::DumpToFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(fileName);
+    std::ofstream ofs(fileName.c_str());
+    NS_ABORT_MSG_UNLESS(ofs.is_open(), "Unable to open file " << fileName);
+    Dump(ofs);
+}
+
+void
+TrafficCounterRegistry::Clear()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    GetList().clear();
+}
+
+std::vector<Ptr<TrafficCounters>>&
+TrafficCounterRegistry::GetList()
+{
+    // Constructed on first use, so that registration works during static initialization.
+    static std::vector<Ptr<TrafficCounters>> list;
+    return list;
+}
+
+} // namespace ns3
@@ -0,0 +1,232 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_COUNTERS_H
+#define TRAFFIC_COUNTERS_H
+
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief Set of hot-path instrumentation counters of one traffic application
+ *        instance.
+ *
+ * Instances are created by TrafficCounterRegistry::Register() and are updated
+ * only through the `TRAFFIC_COUNTERS_*` macros below, which expand to nothing
+ * unless the module is built with `NS3_TRAFFIC_COUNTERS_ENABLE` defined (see
+ * the `TRAFFIC_ENABLE_COUNTERS` CMake option or the
+ * `--enable-traffic-counters` waf option).
+ */
+class TrafficCounters : public SimpleRefCount<TrafficCounters>
+{
+  public:
+    /// The available counters.
+    typedef enum
+    {
+        EVENTS_SCHEDULED = 0,      ///< Number of events scheduled to the simulator.
+        PACKETS_CREATED,           ///< Number of new packets created.
+        BYTES_COPIED,              ///< Bytes added into composed packets.
+        RX_BUFFER_HIGH_WATER_MARK, ///< Largest number of bytes in the Rx buffer.
+        REASSEMBLY_SPLITS,         ///< Received packets split across two slices.
+        NUM_OF_COUNTERS
+    } Counter_t;
+
+    /**
+     * \param counter an arbitrary counter.
+     * \return the column name of the counter, e.g., "events_scheduled".
+     */
+    static std::string GetCounterName(Counter_t counter);
+
+    /**
+     * \param owner name of the owner, e.g., the name of the application type.
+     * \param nodeId ID of the node where the owner is installed.
+     */
+    TrafficCounters(std::string owner, uint32_t nodeId);
+
+    /**
+     * \param counter the counter to increase.
+     * \param value the amount to add.
+     */
+    void Add(Counter_t counter, uint64_t value)
+    {
+        m_values[counter] += value;
+    }
+
+    /**
+     * \param counter the counter to update.
+     * \param value the new value, which is kept if larger than the current one.
+     */
+    void Max(Counter_t counter, uint64_t value)
+    {
+        if (value > m_values[counter])
+        {
+            m_values[counter] = value;
+        }
+    }
+
+    /**
+     * \param counter an arbitrary counter.
+     * \return the current value of the counter.
+     */
+    uint64_t Get(Counter_t counter) const;
+
+    /// \return name of the owner.
+    std::string GetOwner() const;
+
+    /// \return ID of the node where the owner is installed.
+    uint32_t GetNodeId() const;
+
+    /// Set all counters to zero.
+    void Reset();
+
+  private:
+    std::string m_owner;                ///< Name of the owner.
+    uint32_t m_nodeId;                  ///< Node of the owner.
+    uint64_t m_values[NUM_OF_COUNTERS]; ///< Value of each counter.
+
+}; // end of class TrafficCounters
+
+/**
+ * \ingroup traffic
+ * \brief Process-wide list of all TrafficCounters instances.
+ *
+ * The counters are kept by the registry even after their owners are
+ * destroyed, so a scenario can dump them after Simulator::Destroy(), e.g.:
+ * \code
+ *     Simulator::Run ();
+ *     Simulator::Destroy ();
+ *     TrafficCounterRegistry::Dump (std::cout);
+ * \endcode
+ *
+ * Without `NS3_TRAFFIC_COUNTERS_ENABLE`, nothing is ever registered and the
+ * dump contains only the heading.
+ */
+class TrafficCounterRegistry
+{
+  public:
+    /**
+     * \return true if the module is built with its instrumentation counters.
+     */
+    static bool IsEnabled();
+
+    /**
+     * \brief Create a new set of counters and register it.
+     * \param owner name of the owner, e.g., the name of the application type.
+     * \param nodeId ID of the node where the owner is installed.
+     * \return the new counters.
+     */
+    static Ptr<TrafficCounters> Register(std::string owner, uint32_t nodeId);
+
+    /// \return all the registered counters, in the order of registration.
+    static const std::vector<Ptr<TrafficCounters>>& GetAll();
+
+    /**
+     * \param counter an arbitrary counter.
+     * \return the sum of the counter over all registered instances, or the
+     *         maximum in case of RX_BUFFER_HIGH_WATER_MARK.
+     */
+    static uint64_t GetTotal(TrafficCounters::Counter_t counter);
+
+    /**
+     * \brief Write one line per registered instance and a final line of totals.
+     * \param os the output stream.
+     */
+    static void Dump(std::ostream& os);
+
+    /**
+     * \brief Write the output of Dump() into a file.
+     * \param fileName name of the output file.
+     */
+    static void DumpToFile(std::string fileName);
+
+    /// Forget all the registered counters.
+    static void Clear();
+
+  private:
+    /// \return the list of registered counters.
+    static std::vector<Ptr<TrafficCounters>>& GetList();
+
+}; // end of class TrafficCounterRegistry
+
+} // namespace ns3
+
+/**
+ * \ingroup traffic
+ * \brief Instrumentation macros, all of them expanding to nothing unless
+ *        `NS3_TRAFFIC_COUNTERS_ENABLE` is defined.
+ *
+ * `TRAFFIC_COUNTERS_DECLARE` declares a class member holding the counters.
+ * `TRAFFIC_COUNTERS_REGISTER` assigns a newly registered set of counters to
+ * that member, and `TRAFFIC_COUNTERS_SHARE` assigns an existing one. The
+ * remaining macros update a counter, if the member has been assigned.
+ */
+#ifdef NS3_TRAFFIC_COUNTERS_ENABLE
+
+#define TRAFFIC_COUNTERS_DECLARE(member) ns3::Ptr<ns3::TrafficCounters> member;
+
+#define TRAFFIC_COUNTERS_REGISTER(member, owner, nodeId)                                           \
+    do                                                                                             \
+    {                                                                                              \
+        member = ns3::TrafficCounterRegistry::Register(owner, nodeId);                             \
+    } while (false)
+
+#define TRAFFIC_COUNTERS_SHARE(member, counters)                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        member = counters;                                                                         \
+    } while (false)
+
+#define TRAFFIC_COUNTERS_ADD(member, counter, value)                                               \
+    do                                                                                             \
+    {                                                                                              \
+        if (member != nullptr)                                                                     \
+        {                                                                                          \
+            member->Add(ns3::TrafficCounters::counter, value);                                     \
+        }                                                                                          \
+    } while (false)
+
+#define TRAFFIC_COUNTERS_MAX(member, counter, value)                                               \
+    do                                                                                             \
+    {                                                                                              \
+        if (member != nullptr)                                                                     \
+        {                                                                                          \
+            member->Max(ns3::TrafficCounters::counter, value);                                     \
+        }                                                                                          \
+    } while (false)
+
+#else /* NS3_TRAFFIC_COUNTERS_ENABLE */
+
+#define TRAFFIC_COUNTERS_DECLARE(member)
+#define TRAFFIC_COUNTERS_REGISTER(member, owner, nodeId)
+#define TRAFFIC_COUNTERS_SHARE(member, counters)
+#define TRAFFIC_COUNTERS_ADD(member, counter, value)
+#define TRAFFIC_COUNTERS_MAX(member, counter, value)
+
+#endif /* NS3_TRAFFIC_COUNTERS_ENABLE */
+
+#endif /* TRAFFIC_COUNTERS_H */
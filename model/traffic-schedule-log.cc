@@ -0,0 +1,339 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "traffic-schedule-log.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE("TrafficScheduleLog");
+
+namespace ns3
+{
+
+const char TrafficScheduleLog::MAGIC[8] = {'T', 'R', 'A', 'F', 'S', 'C', 'H', 'D'};
+
+namespace
+{
+
+/// Number of values buffered per channel before being written as a block.
+const uint32_t BLOCK_SIZE = 256;
+
+/// \return the logs currently in use, indexed by file name
+std::map<std::string, TrafficScheduleLog*>&
+GetOpenLogs()
+{
+    static std::map<std::string, TrafficScheduleLog*> openLogs;
+    return openLogs;
+}
+
+} // namespace
+
+Ptr<TrafficScheduleLog>
+TrafficScheduleLog::Open(std::string fileName, Mode_t mode)
+{
+    NS_LOG_FUNCTION(fileName << mode);
+    NS_ABORT_MSG_IF(mode == DISABLED, "Unable to open a disabled schedule log");
+
+    std::map<std::string, TrafficScheduleLog*>& openLogs = GetOpenLogs();
+    std::map<std::string, TrafficScheduleLog*>::iterator it = openLogs.find(fileName);
+    if (it != openLogs.end())
+    {
+        NS_ABORT_MSG_UNLESS(it->second->GetMode() == mode,
+                            "Schedule log " << fileName << " is already in use in another mode");
+        return Ptr<TrafficScheduleLog>(it->second);
+    }
+
+    Ptr<TrafficScheduleLog> log =
+        Ptr<TrafficScheduleLog>(new TrafficScheduleLog(fileName, mode), false);
+    openLogs[fileName] = PeekPointer(log);
+    return log;
+}
+
+TrafficScheduleLog::TrafficScheduleLog(std::string fileName, Mode_t mode)
+    : m_fileName(fileName),
+      m_mode(mode),
+      m_numOfOwners(0)
+{
+    NS_LOG_FUNCTION(this << fileName << mode);
+
+    if (mode == REPLAY)
+    {
+        Load();
+        return;
+    }
+
+    m_ofs.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_ofs.is_open(), "Unable to open file " << fileName);
+    const uint32_t header[2] = {0x01020304, VERSION};
+    m_ofs.write(MAGIC, sizeof(MAGIC));
+    m_ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // The owners may outlive the simulation, but the log is complete by then.
+    Simulator::ScheduleDestroy(&TrafficScheduleLog::FlushAll);
+}
+
+TrafficScheduleLog::~TrafficScheduleLog()
+{
+    NS_LOG_FUNCTION(this);
+    GetOpenLogs().erase(m_fileName);
+
+    if (m_mode == RECORD)
+    {
+        Flush();
+        m_ofs.close();
+    }
+}
+
+TrafficScheduleLog::Mode_t
+TrafficScheduleLog::GetMode() const
+{
+    return m_mode;
+}
+
+uint32_t
+TrafficScheduleLog::AddOwner()
+{
+    NS_LOG_FUNCTION(this << m_numOfOwners);
+    return m_numOfOwners++;
+}
+
+void
+TrafficScheduleLog::Record(uint32_t owner, uint32_t variable, double value)
+{
+    NS_ASSERT(m_mode == RECORD);
+    const uint64_t key = GetKey(owner, variable);
+    Channel& channel = m_channels[key];
+    channel.values.push_back(value);
+
+    if (channel.values.size() >= BLOCK_SIZE)
+    {
+        FlushBlock(key, channel);
+    }
+}
+
+double
+TrafficScheduleLog::Replay(uint32_t owner, uint32_t variable)
+{
+    NS_ASSERT(m_mode == REPLAY);
+    std::map<uint64_t, Channel>::iterator it = m_channels.find(GetKey(owner, variable));
+    if (it == m_channels.end() || it->second.cursor >= it->second.values.size())
+    {
+        NS_FATAL_ERROR("Schedule log " << m_fileName << " has no more values of variable "
+                                       << variable << " of owner " << owner);
+    }
+
+    return it->second.values[it->second.cursor++];
+}
+
+bool
+TrafficScheduleLog::HasValue(uint32_t owner, uint32_t variable) const
+{
+    if (m_mode != REPLAY)
+    {
+        return false;
+    }
+
+    std::map<uint64_t, Channel>::const_iterator it = m_channels.find(GetKey(owner, variable));
+    return it != m_channels.end() && it->second.cursor < it->second.values.size();
+}
+
+void
+TrafficScheduleLog::FlushAll()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    std::map<std::string, TrafficScheduleLog*>& openLogs = GetOpenLogs();
+    for (std::map<std::string, TrafficScheduleLog*>::iterator it = openLogs.begin();
+         it != openLogs.end();
+         ++it)
+    {
+        if (it->second->m_mode == RECORD)
+        {
+            it->second->Flush();
+        }
+    }
+}
+
+void
+TrafficScheduleLog::Load()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::ifstream ifs(m_fileName.c_str(), std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(ifs.is_open(), "Unable to open file " << m_fileName);
+
+    char magic[sizeof(MAGIC)];
+    uint32_t header[2];
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+    NS_ABORT_MSG_UNLESS(ifs.good() && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0,
+                        m_fileName << " is not a schedule log file");
+    NS_ABORT_MSG_UNLESS(header[0] == 0x01020304, m_fileName << " has a different byte order");
+    NS_ABORT_MSG_UNLESS(header[1] == VERSION,
+                        m_fileName << " has unsupported version " << header[1]);
+
+    uint32_t block[3];
+    uint64_t numOfValues = 0;
+    while (ifs.read(reinterpret_cast<char*>(block), sizeof(block)))
+    {
+        Channel& channel = m_channels[GetKey(block[0], block[1])];
+        const uint32_t offset = channel.values.size();
+        channel.values.resize(offset + block[2]);
+        channel.cursor = 0;
+        ifs.read(reinterpret_cast<char*>(&channel.values[offset]), block[2] * sizeof(double));
+        NS_ABORT_MSG_UNLESS(ifs.good(), m_fileName << " ends in the middle of a block");
+        numOfValues += block[2];
+    }
+
+    NS_LOG_INFO(this << " loaded " << numOfValues << " values in " << m_channels.size()
+                     << " channels from " << m_fileName);
+
+} // end of `void Load ()`
+
+void
+TrafficScheduleLog::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (std::map<uint64_t, Channel>::iterator it = m_channels.begin(); it != m_channels.end();
+         ++it)
+    {
+        FlushBlock(it->first, it->second);
+    }
+
+    m_ofs.flush();
+}
+
+void
+TrafficScheduleLog::FlushBlock(uint64_t key, Channel& channel)
+{
+    const uint32_t n = channel.values.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    NS_LOG_LOGIC(this << " writing a block of " << n << " values of channel " << key);
+    const uint32_t block[3] = {static_cast<uint32_t>(key >> 32),
+                               static_cast<uint32_t>(key & 0xFFFFFFFF),
+                               n};
+    m_ofs.write(reinterpret_cast<const char*>(block), sizeof(block));
+    m_ofs.write(reinterpret_cast<const char*>(&channel.values[0]), n * sizeof(double));
+    channel.values.clear();
+}
+
+uint64_t
+TrafficScheduleLog::GetKey(uint32_t owner, uint32_t variable)
+{
+    return (static_cast<uint64_t>(owner) << 32) | variable;
+}
+
+// HANDLE /////////////////////////////////////////////////////////////////////
+
+TrafficScheduleLogHandle::TrafficScheduleLogHandle()
+    : m_owner(0)
+{
+}
+
+void
+TrafficScheduleLogHandle::Open(std::string fileName, TrafficScheduleLog::Mode_t mode)
+{
+    NS_LOG_FUNCTION(this << fileName << mode);
+    Close();
+
+    if (!fileName.empty() && mode != TrafficScheduleLog::DISABLED)
+    {
+        m_log = TrafficScheduleLog::Open(fileName, mode);
+        m_owner = m_log->AddOwner();
+    }
+}
+
+void
+TrafficScheduleLogHandle::Close()
+{
+    m_log = nullptr;
+    m_owner = 0;
+}
+
+bool
+TrafficScheduleLogHandle::IsReplaying() const
+{
+    return m_log != nullptr && m_log->GetMode() == TrafficScheduleLog::REPLAY;
+}
+
+bool
+TrafficScheduleLogHandle::IsRecording() const
+{
+    return m_log != nullptr && m_log->GetMode() == TrafficScheduleLog::RECORD;
+}
+
+bool
+TrafficScheduleLogHandle::HasValue(uint32_t variable) const
+{
+    return m_log != nullptr && m_log->HasValue(m_owner, variable);
+}
+
+double
+TrafficScheduleLogHandle::Record(uint32_t variable, double value)
+{
+    if (m_log != nullptr)
+    {
+        m_log->Record(m_owner, variable, value);
+    }
+    return value;
+}
+
+uint32_t
+TrafficScheduleLogHandle::Record(uint32_t variable, uint32_t value)
+{
+    Record(variable, static_cast<double>(value));
+    return value;
+}
+
+Time
+TrafficScheduleLogHandle::Record(uint32_t variable, Time value)
+{
+    Record(variable, static_cast<double>(value.GetNanoSeconds()));
+    return value;
+}
+
+double
+TrafficScheduleLogHandle::Replay(uint32_t variable)
+{
+    NS_ASSERT(IsReplaying());
+    return m_log->Replay(m_owner, variable);
+}
+
+uint32_t
+TrafficScheduleLogHandle::ReplayInteger(uint32_t variable)
+{
+    return static_cast<uint32_t>(Replay(variable));
+}
+
+Time
+TrafficScheduleLogHandle::ReplayTime(uint32_t variable)
+{
+    return NanoSeconds(static_cast<int64_t>(Replay(variable)));
+}
+
+} // namespace ns3
@@ -0,0 +1,282 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_SCHEDULE_LOG_H
+#define TRAFFIC_SCHEDULE_LOG_H
+
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <fstream>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief Binary log of the values drawn by traffic generators, written in a
+ *        recording run and read back in later replaying runs.
+ *
+ * Every generator sharing a log is an owner, identified by the order in which
+ * it opened the log (see AddOwner()), and every kind of value drawn by an
+ * owner is a variable, identified by a number chosen by the owner. The values
+ * of each owner and variable form a separate channel, which is replayed in the
+ * order it was recorded. The values of a channel therefore do not depend on
+ * the order in which the owners, or the variables of an owner, draw them, so a
+ * recorded workload can be replayed on a different network, as long as the
+ * generators are created in the same order.
+ *
+ * Logs are opened through TrafficScheduleLogHandle, which shares one instance
+ * per file name. In recording mode, the values of each channel are buffered
+ * and written in blocks. They are all written when the last user releases the
+ * log, or at the latest when the simulator is destroyed. In replaying mode,
+ * the whole file is read at once and the values are then handed out
+ * sequentially.
+ *
+ * All integers and floating point numbers are in the byte order of the host.
+ * The file begins with a header:
+ * - magic string `TRAFSCHD` (8 bytes);
+ * - byte order marker 0x01020304 (uint32); and
+ * - format version, currently 1 (uint32).
+ *
+ * After the header, the file contains any number of blocks, each of them
+ * consisting of:
+ * - owner index (uint32);
+ * - variable number (uint32);
+ * - number of values in the block, N (uint32); and
+ * - N values (double).
+ *
+ * Times are stored as nanoseconds, which are exact for up to 2^53 ns.
+ *
+ * The same format also stores the checkpoints of the traffic applications
+ * (e.g., ThreeGppHttpSatelliteClient::SetCheckpointFile()), where each
+ * channel holds one field of the saved state instead of a sequence of drawn
+ * values.
+ */
+class TrafficScheduleLog : public SimpleRefCount<TrafficScheduleLog>
+{
+  public:
+    /// Whether the log is written or read.
+    typedef enum
+    {
+        DISABLED = 0, ///< Values are drawn and not logged.
+        RECORD,       ///< Values are drawn and written into the log.
+        REPLAY        ///< Values are read from the log instead of being drawn.
+    } Mode_t;
+
+    /// The magic string at the beginning of the file.
+    static const char MAGIC[8];
+
+    /// Version of the file format.
+    static const uint32_t VERSION = 1;
+
+    /**
+     * \brief Get the log stored in a file, opening the file if it is not in
+     *        use yet.
+     * \param fileName name of the log file.
+     * \param mode either `RECORD`, which truncates the file, or `REPLAY`.
+     * \return the log, shared with every other user of the same file name
+     */
+    static Ptr<TrafficScheduleLog> Open(std::string fileName, Mode_t mode);
+
+    /// Write the buffered values, if recording, and close the file.
+    ~TrafficScheduleLog();
+
+    /// \return either `RECORD` or `REPLAY`
+    Mode_t GetMode() const;
+
+    /**
+     * \brief Register a new owner of the log.
+     * \return the owner index, counted from zero in the order of registration
+     */
+    uint32_t AddOwner();
+
+    /**
+     * \brief Append a value into a channel. Only in `RECORD` mode.
+     * \param owner the owner index.
+     * \param variable the variable number chosen by the owner.
+     * \param value the drawn value.
+     */
+    void Record(uint32_t owner, uint32_t variable, double value);
+
+    /**
+     * \brief Read the next value of a channel. Only in `REPLAY` mode.
+     * \param owner the owner index.
+     * \param variable the variable number chosen by the owner.
+     * \return the value, in the order it was recorded
+     *
+     * The simulation is aborted if the channel has no more values.
+     */
+    double Replay(uint32_t owner, uint32_t variable);
+
+    /**
+     * \param owner the owner index.
+     * \param variable the variable number chosen by the owner.
+     * \return true if the channel has a value left to replay, always false in
+     *         `RECORD` mode
+     */
+    bool HasValue(uint32_t owner, uint32_t variable) const;
+
+    /// Write the buffered values of every log in `RECORD` mode.
+    static void FlushAll();
+
+  private:
+    /// Values of one owner and variable.
+    struct Channel
+    {
+        std::vector<double> values; ///< Buffered or loaded values.
+        uint32_t cursor;            ///< Index of the next value to replay.
+    };
+
+    /**
+     * \brief Open a log file.
+     * \param fileName name of the log file.
+     * \param mode either `RECORD` or `REPLAY`.
+     */
+    TrafficScheduleLog(std::string fileName, Mode_t mode);
+
+    /// Read all the blocks of the file into #m_channels. Used in `REPLAY` mode.
+    void Load();
+
+    /// Write the buffered values of every channel. Used in `RECORD` mode.
+    void Flush();
+
+    /**
+     * \brief Write the buffered values of a channel as a block.
+     * \param key the channel key.
+     * \param channel the channel.
+     */
+    void FlushBlock(uint64_t key, Channel& channel);
+
+    /**
+     * \param owner the owner index.
+     * \param variable the variable number.
+     * \return the key of the channel in #m_channels
+     */
+    static uint64_t GetKey(uint32_t owner, uint32_t variable);
+
+    std::string m_fileName;                 ///< Name of the log file.
+    Mode_t m_mode;                          ///< Either `RECORD` or `REPLAY`.
+    std::ofstream m_ofs;                    ///< The log file, open while recording.
+    uint32_t m_numOfOwners;                 ///< Number of owners registered so far.
+    std::map<uint64_t, Channel> m_channels; ///< Channels, indexed by owner and variable.
+
+}; // end of `class TrafficScheduleLog`
+
+/**
+ * \ingroup traffic
+ * \brief Membership of a traffic generator in a TrafficScheduleLog.
+ *
+ * Kept by value by the generators. A closed handle, which is the default,
+ * neither records nor replays anything, so the generators can use it
+ * unconditionally:
+ *
+ * \code
+ *   if (m_scheduleLog.IsReplaying ())
+ *     {
+ *       return m_scheduleLog.ReplayInteger (SLICE_SIZE);
+ *     }
+ *   const uint32_t value = ...; // draw the value
+ *   return m_scheduleLog.Record (SLICE_SIZE, value);
+ * \endcode
+ */
+class TrafficScheduleLogHandle
+{
+  public:
+    /// Create a closed handle.
+    TrafficScheduleLogHandle();
+
+    /**
+     * \brief Open a log and register as a new owner of it, closing the
+     *        previous log, if any.
+     * \param fileName name of the log file, or an empty string to only close
+     *                 the handle.
+     * \param mode the mode of the log, `DISABLED` to only close the handle.
+     */
+    void Open(std::string fileName, TrafficScheduleLog::Mode_t mode);
+
+    /// Release the log.
+    void Close();
+
+    /// \return true if the values are read from the log
+    bool IsReplaying() const;
+
+    /// \return true if the values are written into the log
+    bool IsRecording() const;
+
+    /**
+     * \param variable the variable number.
+     * \return true if the log is being replayed and the variable has a value
+     *         left
+     */
+    bool HasValue(uint32_t variable) const;
+
+    /**
+     * \param variable the variable number.
+     * \param value the drawn value.
+     * \return \p value, after writing it into the log if recording
+     */
+    double Record(uint32_t variable, double value);
+
+    /**
+     * \param variable the variable number.
+     * \param value the drawn value.
+     * \return \p value, after writing it into the log if recording
+     */
+    uint32_t Record(uint32_t variable, uint32_t value);
+
+    /**
+     * \param variable the variable number.
+     * \param value the drawn value.
+     * \return \p value, after writing it into the log if recording
+     */
+    Time Record(uint32_t variable, Time value);
+
+    /**
+     * \param variable the variable number.
+     * \return the next value of the variable read from the log
+     */
+    double Replay(uint32_t variable);
+
+    /**
+     * \param variable the variable number.
+     * \return the next value of the variable read from the log, as an integer
+     */
+    uint32_t ReplayInteger(uint32_t variable);
+
+    /**
+     * \param variable the variable number.
+     * \return the next value of the variable read from the log, as a time
+     */
+    Time ReplayTime(uint32_t variable);
+
+  private:
+    Ptr<TrafficScheduleLog> m_log; ///< The log, or null if closed.
+    uint32_t m_owner;              ///< Owner index in the log.
+
+}; // end of `class TrafficScheduleLogHandle`
+
+} // namespace ns3
+
+#endif /* TRAFFIC_SCHEDULE_LOG_H */
@@ -20,6 +20,9 @@
 
 #include "traffic-time-tag.h"
 
+#include <ns3/simulator.h>
+#include <ns3/traffic-timestamp.h>
+
 namespace ns3
 {
 
@@ -54,22 +57,36 @@ TrafficTimeTag::GetInstanceTypeId(void) const
 uint32_t
 TrafficTimeTag::GetSerializedSize(void) const
 {
-    return sizeof(Time);
+    return TrafficTimestamp::GetSerializedSize();
 }
 
 void
 TrafficTimeTag::Serialize(TagBuffer i) const
 {
-    int64_t senderTimestamp = m_senderTimestamp.GetNanoSeconds();
-    i.Write((const uint8_t*)&senderTimestamp, sizeof(int64_t));
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        int64_t senderTimestamp = m_senderTimestamp.GetNanoSeconds();
+        i.Write((const uint8_t*)&senderTimestamp, sizeof(int64_t));
+    }
+    else
+    {
+        i.WriteU32(TrafficTimestamp::EncodeCompact(m_senderTimestamp));
+    }
 }
 
 void
 TrafficTimeTag::Deserialize(TagBuffer i)
 {
-    int64_t senderTimestamp;
-    i.Read((uint8_t*)&senderTimestamp, 8);
-    m_senderTimestamp = NanoSeconds(senderTimestamp);
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        int64_t senderTimestamp;
+        i.Read((uint8_t*)&senderTimestamp, 8);
+        m_senderTimestamp = NanoSeconds(senderTimestamp);
+    }
+    else
+    {
+        m_senderTimestamp = TrafficTimestamp::DecodeCompact(i.ReadU32(), Simulator::Now());
+    }
 }
 
 void
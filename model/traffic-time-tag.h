@@ -32,6 +32,11 @@ namespace ns3
  * \brief Time tag used at the traffic model to time stamp a generated
  * packet. Time tag may be used to calculated delay and jitter statistics
  * at the receiver side.
+ *
+ * The tag occupies 8 bytes, or only 4 bytes if a compact timestamp encoding is
+ * selected through TrafficTimestamp::SetEncoding(). In the latter case, the
+ * full sender timestamp is restored against the current simulation time when
+ * the tag is read from the received packet.
  */
 class TrafficTimeTag : public Tag
 {
@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "traffic-timestamp-header.h"
+
+#include <ns3/log.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/traffic-timestamp.h>
+
+NS_LOG_COMPONENT_DEFINE("TrafficTimestampHeader");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(TrafficTimestampHeader);
+
+TrafficTimestampHeader::TrafficTimestampHeader()
+    : m_senderTimestamp(Simulator::Now()),
+      m_isValid(true)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TrafficTimestampHeader::TrafficTimestampHeader(Time senderTimestamp)
+    : m_senderTimestamp(senderTimestamp),
+      m_isValid(true)
+{
+    NS_LOG_FUNCTION(this << senderTimestamp.GetSeconds());
+}
+
+TypeId
+TrafficTimestampHeader::GetTypeId(void)
+{
+    static TypeId tid = TypeId("ns3::TrafficTimestampHeader")
+                            .SetParent<Header>()
+                            .AddConstructor<TrafficTimestampHeader>();
+    return tid;
+}
+
+uint32_t
+TrafficTimestampHeader::GetStaticSerializedSize()
+{
+    return 4 + TrafficTimestamp::GetSerializedSize();
+}
+
+bool
+TrafficTimestampHeader::PeekSenderTimestamp(Ptr<const Packet> packet, Time& senderTimestamp)
+{
+    if (packet->GetSize() < GetStaticSerializedSize())
+    {
+        return false;
+    }
+
+    TrafficTimestampHeader header;
+    packet->PeekHeader(header);
+    if (!header.IsValid())
+    {
+        return false;
+    }
+
+    senderTimestamp = header.GetSenderTimestamp();
+    return true;
+}
+
+bool
+TrafficTimestampHeader::IsValid() const
+{
+    return m_isValid;
+}
+
+Time
+TrafficTimestampHeader::GetSenderTimestamp() const
+{
+    return m_senderTimestamp;
+}
+
+uint32_t
+TrafficTimestampHeader::GetSerializedSize() const
+{
+    return GetStaticSerializedSize();
+}
+
+void
+TrafficTimestampHeader::Print(std::ostream& os) const
+{
+    os << "(senderTimestamp: " << m_senderTimestamp << ")";
+}
+
+void
+TrafficTimestampHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteHtonU32(MARKER);
+
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        i.WriteHtonU64(m_senderTimestamp.GetNanoSeconds());
+    }
+    else
+    {
+        i.WriteHtonU32(TrafficTimestamp::EncodeCompact(m_senderTimestamp));
+    }
+}
+
+uint32_t
+TrafficTimestampHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    m_isValid = (i.ReadNtohU32() == MARKER);
+
+    if (TrafficTimestamp::GetEncoding() == TrafficTimestamp::FULL)
+    {
+        m_senderTimestamp = NanoSeconds(i.ReadNtohU64());
+    }
+    else
+    {
+        m_senderTimestamp = TrafficTimestamp::DecodeCompact(i.ReadNtohU32(), Simulator::Now());
+    }
+    return GetSerializedSize();
+}
+
+TypeId
+TrafficTimestampHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_TIMESTAMP_HEADER_H
+#define TRAFFIC_TIMESTAMP_HEADER_H
+
+#include <ns3/header.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \ingroup traffic
+ * \brief Payload header carrying the sender timestamp of a packet, as a
+ *        replacement of TrafficTimeTag.
+ *
+ * Unlike a packet tag, which is copied along with the packet through every
+ * layer and every copy of the packet, the header is serialized once into the
+ * payload bytes. The header is 12 bytes in length, with 2 fields:
+ * - marker (4 bytes), the characters "TSTP", which distinguishes the header
+ *   from arbitrary payload; and
+ * - sender timestamp (8 bytes) in nanoseconds.
+ *
+ * If a compact timestamp encoding is selected through
+ * TrafficTimestamp::SetEncoding(), the timestamp field is only 4 bytes long,
+ * making the header 8 bytes in length, and the full timestamp is restored
+ * against the current simulation time upon deserialization.
+ *
+ * Used by CbrApplication when both the `EnableStatisticsTags` and the
+ * `EnableTimestampHeader` attributes are enabled. The header is added in
+ * front of the payload, so the packet size stays the same. At the receiver,
+ * PeekSenderTimestamp() reads the timestamp without removing the header, e.g.:
+ *
+ *     Time senderTimestamp;
+ *     if (TrafficTimestampHeader::PeekSenderTimestamp (packet, senderTimestamp))
+ *       {
+ *         Time delay = Simulator::Now () - senderTimestamp;
+ *       }
+ */
+class TrafficTimestampHeader : public Header
+{
+  public:
+    /// Create a header with the current time as the sender timestamp.
+    TrafficTimestampHeader();
+
+    /**
+     * \param senderTimestamp the sender timestamp to be carried.
+     */
+    TrafficTimestampHeader(Time senderTimestamp);
+
+    // Inherited from ObjectBase base class
+    static TypeId GetTypeId(void);
+
+    /// The marker at the beginning of the header, i.e., "TSTP".
+    static constexpr uint32_t MARKER = 0x54535450;
+
+    /**
+     * \return the size of the header in bytes with the timestamp encoding
+     *         currently in use, i.e., the same value as GetSerializedSize(),
+     *         but without the need of creating a header instance
+     */
+    static uint32_t GetStaticSerializedSize();
+
+    /**
+     * \brief Read the sender timestamp of the header at the beginning of a
+     *        packet, if there is one.
+     * \param packet the received packet.
+     * \param[out] senderTimestamp the sender timestamp, if found.
+     * \return true if the packet is large enough and begins with the marker.
+     */
+    static bool PeekSenderTimestamp(Ptr<const Packet> packet, Time& senderTimestamp);
+
+    /**
+     * \return true if the marker was found by the last Deserialize(), or if
+     *         the header has been created locally.
+     */
+    bool IsValid() const;
+
+    /**
+     * \return the sender timestamp carried by the header.
+     */
+    Time GetSenderTimestamp() const;
+
+    // Inherited from Header base class
+    virtual uint32_t GetSerializedSize() const;
+    virtual void Serialize(Buffer::Iterator start) const;
+    virtual uint32_t Deserialize(Buffer::Iterator start);
+    virtual void Print(std::ostream& os) const;
+
+    // Inherited from ObjectBase base class
+    virtual TypeId GetInstanceTypeId() const;
+
+  private:
+    Time m_senderTimestamp; ///< Sender timestamp field.
+    bool m_isValid;         ///< True unless the marker was not found.
+
+}; // end of `class TrafficTimestampHeader`
+
+} // namespace ns3
+
+#endif /* TRAFFIC_TIMESTAMP_HEADER_H */
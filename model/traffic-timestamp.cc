@@ -0,0 +1,90 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "traffic-timestamp.h"
+
+#include <ns3/log.h>
+
+NS_LOG_COMPONENT_DEFINE("TrafficTimestamp");
+
+namespace ns3
+{
+
+TrafficTimestamp::Encoding_t TrafficTimestamp::m_encoding = TrafficTimestamp::FULL;
+
+void
+TrafficTimestamp::SetEncoding(Encoding_t encoding)
+{
+    NS_LOG_FUNCTION(GetEncodingName(encoding));
+    m_encoding = encoding;
+}
+
+TrafficTimestamp::Encoding_t
+TrafficTimestamp::GetEncoding()
+{
+    return m_encoding;
+}
+
+std::string
+TrafficTimestamp::GetEncodingName(Encoding_t encoding)
+{
+    switch (encoding)
+    {
+    case FULL:
+        return "FULL";
+    case COMPACT_NANOSECONDS:
+        return "COMPACT_NANOSECONDS";
+    case COMPACT_MICROSECONDS:
+        return "COMPACT_MICROSECONDS";
+    default:
+        NS_FATAL_ERROR("Unknown encoding " << static_cast<uint32_t>(encoding));
+        return "FAILED_TO_RECOGNIZE_ENCODING";
+    }
+}
+
+uint32_t
+TrafficTimestamp::GetSerializedSize()
+{
+    return (m_encoding == FULL) ? 8 : 4;
+}
+
+uint32_t
+TrafficTimestamp::EncodeCompact(Time timestamp)
+{
+    NS_ASSERT_MSG(m_encoding != FULL, "The full encoding is not compact");
+    NS_ASSERT_MSG(!timestamp.IsStrictlyNegative(), "Negative timestamp " << timestamp);
+    const int64_t ticks = (m_encoding == COMPACT_MICROSECONDS) ? timestamp.GetMicroSeconds()
+                                                                : timestamp.GetNanoSeconds();
+    return static_cast<uint32_t>(ticks);
+}
+
+Time
+TrafficTimestamp::DecodeCompact(uint32_t value, Time reference)
+{
+    NS_ASSERT_MSG(m_encoding != FULL, "The full encoding is not compact");
+    const bool isMicro = (m_encoding == COMPACT_MICROSECONDS);
+    const int64_t ticks = isMicro ? reference.GetMicroSeconds() : reference.GetNanoSeconds();
+
+    // The unsigned subtraction takes care of the wrap-around.
+    const uint32_t elapsed = static_cast<uint32_t>(ticks) - value;
+    const int64_t restored = ticks - elapsed;
+    return isMicro ? MicroSeconds(restored) : NanoSeconds(restored);
+}
+
+} // namespace ns3
@@ -0,0 +1,113 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRAFFIC_TIMESTAMP_H
+#define TRAFFIC_TIMESTAMP_H
+
+#include <ns3/nstime.h>
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic
+ * \brief Encoding of the sender timestamps carried by NrtvHeader and
+ *        TrafficTimeTag.
+ *
+ * By default, a timestamp is carried as a full 64-bit number of nanoseconds.
+ * The compact encodings carry only the 32 least significant bits of the
+ * timestamp, and the receiver restores the full value from its own clock,
+ * taking the most recent time (not later than the current simulation time)
+ * which matches the carried bits. This is exact as long as the packet delay
+ * is shorter than the wrap-around period of the encoding:
+ * - `COMPACT_NANOSECONDS` keeps nanosecond resolution, so the computed delay
+ *   is identical to the one of the full encoding, but wraps around every
+ *   2^32 ns (about 4.29 seconds); and
+ * - `COMPACT_MICROSECONDS` truncates the timestamp to microseconds, so the
+ *   computed delay is exact only in microseconds, but wraps around every
+ *   2^32 us (about 71.6 minutes).
+ *
+ * The encoding is a simulation-wide setting, because the senders and the
+ * receivers must agree on it. It must be set before the simulation starts,
+ * and must not be changed while there are packets in flight, e.g.:
+ *
+ *     TrafficTimestamp::SetEncoding (TrafficTimestamp::COMPACT_NANOSECONDS);
+ */
+class TrafficTimestamp
+{
+  public:
+    /// Supported encodings of a timestamp.
+    typedef enum
+    {
+        FULL = 0,             ///< 64-bit nanoseconds.
+        COMPACT_NANOSECONDS,  ///< 32-bit wrap-around nanoseconds.
+        COMPACT_MICROSECONDS, ///< 32-bit wrap-around microseconds.
+    } Encoding_t;
+
+    /**
+     * \param encoding the encoding to be used by all senders and receivers.
+     */
+    static void SetEncoding(Encoding_t encoding);
+
+    /**
+     * \return the encoding currently in use.
+     */
+    static Encoding_t GetEncoding();
+
+    /**
+     * \param encoding an arbitrary encoding.
+     * \return the name of the encoding in string format.
+     */
+    static std::string GetEncodingName(Encoding_t encoding);
+
+    /**
+     * \return the number of bytes occupied by a timestamp in the encoding
+     *         currently in use, i.e., 8 or 4 bytes.
+     */
+    static uint32_t GetSerializedSize();
+
+    /**
+     * \param timestamp the timestamp to be carried, which must not be negative.
+     * \return the 32 least significant bits of the timestamp in the compact
+     *         encoding currently in use.
+     */
+    static uint32_t EncodeCompact(Time timestamp);
+
+    /**
+     * \brief Restore a timestamp from its compact encoding.
+     * \param value the 32 least significant bits of the timestamp.
+     * \param reference the time at the receiver, typically the current
+     *                  simulation time, which is not earlier than the
+     *                  timestamp.
+     * \return the most recent time not later than the reference which matches
+     *         the given bits in the compact encoding currently in use.
+     */
+    static Time DecodeCompact(uint32_t value, Time reference);
+
+  private:
+    static Encoding_t m_encoding; ///< The encoding currently in use.
+
+}; // end of `class TrafficTimestamp`
+
+} // namespace ns3
+
+#endif /* TRAFFIC_TIMESTAMP_H */
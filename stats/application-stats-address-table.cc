@@ -0,0 +1,174 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-address-table.h"
+
+#include <ns3/application.h>
+#include <ns3/ipv4.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsAddressTable");
+
+namespace ns3
+{
+
+/**
+ * The direct-indexed array is used as long as it is not larger than this many
+ * entries, or four times the number of addresses, whichever is larger.
+ */
+static const uint32_t APPLICATION_STATS_MIN_DENSE_SPAN = 65536;
+
+const uint32_t ApplicationStatsAddressTable::INVALID_IDENTIFIER;
+
+ApplicationStatsAddressTable::ApplicationStatsAddressTable()
+    : m_base(0),
+      m_isDense(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsAddressTable::Add(const Ipv4Address& address, uint32_t identifier)
+{
+    NS_LOG_FUNCTION(this << address << identifier);
+    NS_ASSERT_MSG(identifier != INVALID_IDENTIFIER, "Invalid identifier " << identifier);
+    m_entries.push_back(std::make_pair(address.Get(), identifier));
+}
+
+uint32_t
+ApplicationStatsAddressTable::AddApplication(Ptr<Application> application, uint32_t identifier)
+{
+    NS_LOG_FUNCTION(this << application << identifier);
+
+    Ptr<Node> node = application->GetNode();
+    NS_ASSERT_MSG(node != nullptr, "Application is not attached to any Node");
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t n = 0;
+
+    if (ipv4 == nullptr)
+    {
+        NS_LOG_INFO(this << " Node " << node->GetId() << " does not support IPv4 protocol");
+    }
+    else
+    {
+        NS_LOG_DEBUG(this << " found " << ipv4->GetNInterfaces() << " interface(s)"
+                          << " in Node " << node->GetId());
+
+        // Skipping interface #0 because it is assumed to be a loopback interface.
+        for (uint32_t i = 1; i < ipv4->GetNInterfaces(); i++)
+        {
+            NS_LOG_DEBUG(this << " found " << ipv4->GetNAddresses(i) << " address(es)"
+                              << " in Node " << node->GetId() << " interface #" << i);
+
+            for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+            {
+                const Ipv4Address addr = ipv4->GetAddress(i, j).GetLocal();
+                Add(addr, identifier);
+                n++;
+                NS_LOG_INFO(this << " associated address " << addr << " with identifier "
+                                 << identifier);
+            }
+        }
+    }
+
+    return n;
+
+} // end of `uint32_t AddApplication (Ptr<Application>, uint32_t)`
+
+void
+ApplicationStatsAddressTable::Build()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Sort by address, keeping the most recently added identifier of each address.
+    std::stable_sort(m_entries.begin(),
+                     m_entries.end(),
+                     [](const std::pair<uint32_t, uint32_t>& a,
+                        const std::pair<uint32_t, uint32_t>& b) { return a.first < b.first; });
+    std::vector<std::pair<uint32_t, uint32_t>> unique;
+    unique.reserve(m_entries.size());
+    for (std::vector<std::pair<uint32_t, uint32_t>>::const_iterator it = m_entries.begin();
+         it != m_entries.end();
+         ++it)
+    {
+        if (!unique.empty() && unique.back().first == it->first)
+        {
+            unique.back().second = it->second;
+        }
+        else
+        {
+            unique.push_back(*it);
+        }
+    }
+    m_entries.swap(unique);
+
+    m_denseTable.clear();
+    m_isDense = false;
+
+    if (m_entries.empty())
+    {
+        return;
+    }
+
+    m_base = m_entries.front().first;
+    const uint64_t span = static_cast<uint64_t>(m_entries.back().first) - m_base + 1;
+    const uint64_t maxSpan =
+        std::max<uint64_t>(APPLICATION_STATS_MIN_DENSE_SPAN, 4 * m_entries.size());
+
+    if (span <= maxSpan)
+    {
+        m_denseTable.assign(span, INVALID_IDENTIFIER);
+        for (std::vector<std::pair<uint32_t, uint32_t>>::const_iterator it = m_entries.begin();
+             it != m_entries.end();
+             ++it)
+        {
+            m_denseTable[it->first - m_base] = it->second;
+        }
+        m_isDense = true;
+    }
+
+    NS_LOG_INFO(this << " built a " << (m_isDense ? "direct-indexed" : "sorted") << " table of "
+                     << m_entries.size() << " address(es) spanning " << span << " address(es)");
+
+} // end of `void Build ()`
+
+uint32_t
+ApplicationStatsAddressTable::GetN() const
+{
+    return m_entries.size();
+}
+
+bool
+ApplicationStatsAddressTable::IsDense() const
+{
+    return m_isDense;
+}
+
+void
+ApplicationStatsAddressTable::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_entries.clear();
+    m_denseTable.clear();
+    m_base = 0;
+    m_isDense = false;
+}
+
+} // end of namespace ns3
@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_ADDRESS_TABLE_H
+#define APPLICATION_STATS_ADDRESS_TABLE_H
+
+#include <ns3/ipv4-address.h>
+#include <ns3/ptr.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class Application;
+
+/**
+ * \ingroup applicationstats
+ * \brief Look-up table from sender IPv4 address to statistics identifier.
+ *
+ * Utilized by the statistics helpers when the `SENDER` identifier type is
+ * active. The table is filled during installation using Add() or
+ * AddApplication(), and then finalised using Build(). After that, Lookup() can
+ * be used from trace sinks to resolve an identifier for every received sample.
+ *
+ * Simulation scripts typically assign addresses from one or a few contiguous
+ * subnets, so the table tries to use a direct-indexed array covering the range
+ * between the lowest and the highest address. If the range is too sparse, the
+ * table falls back to a sorted array searched by bisection. In both cases, the
+ * look-up does not allocate memory nor traverse any tree.
+ */
+class ApplicationStatsAddressTable
+{
+  public:
+    /// Value returned by Lookup() for unknown addresses.
+    static const uint32_t INVALID_IDENTIFIER = 0xFFFFFFFF;
+
+    /// Create an empty table.
+    ApplicationStatsAddressTable();
+
+    /**
+     * \brief Associate an IPv4 address with an identifier.
+     * \param address the IPv4 address.
+     * \param identifier the number to be associated with.
+     *
+     * If the address has been added before, the new identifier replaces the old
+     * one. Must be followed by Build() before any Lookup().
+     */
+    void Add(const Ipv4Address& address, uint32_t identifier);
+
+    /**
+     * \brief Associate the IPv4 address(es) of the given application's Node with
+     *        an identifier.
+     * \param application an application instance.
+     * \param identifier the number to be associated with.
+     * \return number of addresses added.
+     *
+     * Interface #0 is skipped because it is assumed to be a loopback interface.
+     */
+    uint32_t AddApplication(Ptr<Application> application, uint32_t identifier);
+
+    /// Finalise the table, making it ready for Lookup().
+    void Build();
+
+    /**
+     * \param address an IPv4 address.
+     * \return the identifier associated with the address, or
+     *         #INVALID_IDENTIFIER if the address is not in the table.
+     */
+    inline uint32_t Lookup(const Ipv4Address& address) const
+    {
+        const uint32_t key = address.Get();
+
+        if (m_isDense)
+        {
+            // unsigned wrap-around also takes care of addresses below the base
+            const uint32_t index = key - m_base;
+            return index < m_denseTable.size() ? m_denseTable[index] : INVALID_IDENTIFIER;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>>::const_iterator it =
+            std::lower_bound(m_entries.begin(),
+                             m_entries.end(),
+                             std::make_pair(key, static_cast<uint32_t>(0)));
+        return (it != m_entries.end() && it->first == key) ? it->second : INVALID_IDENTIFIER;
+    }
+
+    /**
+     * \return number of addresses in the table.
+     */
+    uint32_t GetN() const;
+
+    /**
+     * \return true if the table uses the direct-indexed array.
+     */
+    bool IsDense() const;
+
+    /// Remove all entries from the table.
+    void Clear();
+
+  private:
+    /// Pairs of address (in host order) and identifier, sorted by Build().
+    std::vector<std::pair<uint32_t, uint32_t>> m_entries;
+    /// Direct-indexed identifiers, where index 0 corresponds to #m_base.
+    std::vector<uint32_t> m_denseTable;
+    /// The lowest address in the table (in host order).
+    uint32_t m_base;
+    /// True if #m_denseTable is used for look-up.
+    bool m_isDense;
+
+}; // end of class ApplicationStatsAddressTable
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_ADDRESS_TABLE_H */
@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-async-writer.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <chrono>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsAsyncWriter");
+
+namespace ns3
+{
+
+ApplicationStatsAsyncWriter::ApplicationStatsAsyncWriter(std::string fileName,
+                                                         uint32_t chunkSize,
+                                                         uint32_t numOfChunks)
+    : m_chunks(numOfChunks),
+      m_chunkSize(chunkSize),
+      m_head(0),
+      m_tail(0),
+      m_isClosing(false),
+      m_numOfStalls(0),
+      m_isClosed(false)
+{
+    NS_LOG_FUNCTION(this << fileName << chunkSize << numOfChunks);
+    NS_ABORT_MSG_IF(chunkSize == 0, "Chunk size must be greater than zero");
+    NS_ABORT_MSG_IF(numOfChunks < 2, "At least two chunks are required");
+
+    // The chunks are already as large as the writes should be, so the stream
+    // buffer only needs to hold one of them.
+    m_fileBuffer.resize(chunkSize);
+    m_ofs.rdbuf()->pubsetbuf(&m_fileBuffer[0], m_fileBuffer.size());
+    m_ofs.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_ofs.is_open(), "Unable to open file " << fileName);
+
+    for (std::vector<std::vector<char>>::iterator it = m_chunks.begin(); it != m_chunks.end();
+         ++it)
+    {
+        it->reserve(chunkSize);
+    }
+
+    m_thread = std::thread(&ApplicationStatsAsyncWriter::DoWrite, this);
+
+} // end of `ApplicationStatsAsyncWriter (std::string, uint32_t, uint32_t)`
+
+ApplicationStatsAsyncWriter::~ApplicationStatsAsyncWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+ApplicationStatsAsyncWriter::Write(const void* data, uint32_t size)
+{
+    if (m_isClosed)
+    {
+        return;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        // The chunk at the head belongs to this thread until it is published.
+        std::vector<char>& chunk = m_chunks[m_head.load(std::memory_order_relaxed) %
+                                            m_chunks.size()];
+        const uint32_t n = std::min<uint32_t>(size, m_chunkSize - chunk.size());
+        chunk.insert(chunk.end(), bytes, bytes + n);
+        bytes += n;
+        size -= n;
+
+        if (chunk.size() >= m_chunkSize)
+        {
+            PublishChunk();
+        }
+    }
+}
+
+void
+ApplicationStatsAsyncWriter::Flush()
+{
+    if (!m_isClosed &&
+        !m_chunks[m_head.load(std::memory_order_relaxed) % m_chunks.size()].empty())
+    {
+        PublishChunk();
+    }
+}
+
+void
+ApplicationStatsAsyncWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_isClosed)
+    {
+        return;
+    }
+
+    Flush();
+    m_isClosing.store(true, std::memory_order_release);
+    m_thread.join();
+    m_ofs.close();
+    m_isClosed = true;
+
+    NS_LOG_INFO(this << " closed after " << m_head.load() << " chunk(s) and " << m_numOfStalls
+                     << " stall(s)");
+}
+
+uint64_t
+ApplicationStatsAsyncWriter::GetNumOfStalls() const
+{
+    return m_numOfStalls;
+}
+
+void
+ApplicationStatsAsyncWriter::PublishChunk()
+{
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+
+    // The next chunk must have been written by the I/O thread before reuse.
+    if (head + 1 - m_tail.load(std::memory_order_acquire) >= m_chunks.size())
+    {
+        NS_LOG_LOGIC(this << " waiting for the I/O thread");
+        m_numOfStalls++;
+        while (head + 1 - m_tail.load(std::memory_order_acquire) >= m_chunks.size())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+void
+ApplicationStatsAsyncWriter::DoWrite()
+{
+    while (true)
+    {
+        // Read the flag before the head, so that no chunk published before
+        // closing is missed.
+        const bool isClosing = m_isClosing.load(std::memory_order_acquire);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == head)
+        {
+            if (isClosing)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        while (tail != head)
+        {
+            std::vector<char>& chunk = m_chunks[tail % m_chunks.size()];
+            m_ofs.write(&chunk[0], chunk.size());
+            chunk.clear();
+            tail++;
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        // Nothing else to write for now, so let readers of the file see it.
+        m_ofs.flush();
+    }
+
+} // end of `void DoWrite ()`
+
+} // end of namespace ns3
@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_ASYNC_WRITER_H
+#define APPLICATION_STATS_ASYNC_WRITER_H
+
+#include <ns3/simple-ref-count.h>
+
+#include <atomic>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Output file whose writes are carried out by a background I/O thread.
+ *
+ * The bytes given to Write() are appended into the chunk currently owned by
+ * the simulator thread. A full chunk is published into a lock-free single
+ * producer, single consumer ring of chunks, which a dedicated I/O thread
+ * drains with one large write per chunk. Therefore a slow file system, e.g.,
+ * a network file system, no longer stalls the event loop, as long as the I/O
+ * thread keeps up on average.
+ *
+ * When all chunks of the ring are waiting for the I/O thread, Write() blocks
+ * until one of them is released, so the memory usage is bounded by the number
+ * of chunks times the chunk size.
+ *
+ * The bytes appear in the file in the same order as they were given to
+ * Write(). Flush() publishes the partially filled chunk without waiting, which
+ * suits occasional records that should become visible in the file soon, and
+ * the I/O thread flushes the file whenever it has nothing left to write.
+ * Close() publishes the partially filled chunk, waits until the I/O thread has
+ * written everything, and closes the file. Only one thread may invoke Write(),
+ * Flush(), and Close().
+ */
+class ApplicationStatsAsyncWriter : public SimpleRefCount<ApplicationStatsAsyncWriter>
+{
+  public:
+    /**
+     * \brief Open the file and start the I/O thread.
+     * \param fileName name of the output file, which is truncated.
+     * \param chunkSize number of bytes written by the I/O thread at a time.
+     * \param numOfChunks number of chunks in the ring.
+     */
+    ApplicationStatsAsyncWriter(std::string fileName,
+                                uint32_t chunkSize = 1048576,
+                                uint32_t numOfChunks = 8);
+
+    /// Destructor, which closes the file if still open.
+    ~ApplicationStatsAsyncWriter();
+
+    /**
+     * \brief Append bytes to the file.
+     * \param data pointer to the first byte.
+     * \param size number of bytes.
+     *
+     * Ignored after Close() has been invoked.
+     */
+    void Write(const void* data, uint32_t size);
+
+    /**
+     * \brief Hand the bytes written so far over to the I/O thread, without
+     *        waiting for them to be written.
+     *
+     * Ignored after Close() has been invoked.
+     */
+    void Flush();
+
+    /// Write all pending bytes, stop the I/O thread, and close the file.
+    void Close();
+
+    /**
+     * \return number of times Write() had to wait for the I/O thread because
+     *         all chunks were full, which hints that the I/O thread does not
+     *         keep up.
+     */
+    uint64_t GetNumOfStalls() const;
+
+  private:
+    /// Hand the chunk at #m_head over to the I/O thread, waiting for a free slot.
+    void PublishChunk();
+
+    /// Body of the I/O thread.
+    void DoWrite();
+
+    std::ofstream m_ofs;                     ///< The output file, used by the I/O thread.
+    std::vector<char> m_fileBuffer;          ///< Stream buffer of #m_ofs.
+    std::vector<std::vector<char>> m_chunks; ///< The ring of chunks.
+    uint32_t m_chunkSize;                    ///< Capacity of each chunk in bytes.
+    std::atomic<uint64_t> m_head;            ///< Number of chunks published so far.
+    std::atomic<uint64_t> m_tail;            ///< Number of chunks written so far.
+    std::atomic<bool> m_isClosing;           ///< True when the I/O thread should stop.
+    std::thread m_thread;                    ///< The I/O thread.
+    uint64_t m_numOfStalls;                  ///< Number of times Write() waited.
+    bool m_isClosed;                         ///< True after Close() has been invoked.
+
+}; // end of class ApplicationStatsAsyncWriter
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_ASYNC_WRITER_H */
@@ -0,0 +1,212 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-binary-writer.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsBinaryWriter");
+
+namespace ns3
+{
+
+const char ApplicationStatsBinaryWriter::MAGIC[8] = {'A', 'P', 'P', 'S', 'T', 'A', 'T', 'S'};
+
+ApplicationStatsBinaryWriter::ApplicationStatsBinaryWriter(
+    std::string fileName,
+    std::string timeColumnName,
+    std::string valueColumnName,
+    const std::vector<std::string>& identifierNames,
+    uint32_t blockSize,
+    bool isAsync)
+    : m_blockSize(blockSize),
+      m_isClosed(false)
+{
+    NS_LOG_FUNCTION(this << fileName << timeColumnName << valueColumnName
+                         << identifierNames.size() << blockSize << isAsync);
+    NS_ABORT_MSG_IF(blockSize == 0, "Block size must be greater than zero");
+
+    if (isAsync)
+    {
+        m_asyncWriter = Create<ApplicationStatsAsyncWriter>(fileName);
+    }
+    else
+    {
+        m_ofs.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(m_ofs.is_open(), "Unable to open file " << fileName);
+    }
+
+    // Self-describing header.
+    WriteBytes(MAGIC, sizeof(MAGIC));
+    WriteUint32(0x01020304);
+    WriteUint32(VERSION);
+    WriteName(timeColumnName);
+    WriteName(valueColumnName);
+    WriteUint32(identifierNames.size());
+    for (std::vector<std::string>::const_iterator it = identifierNames.begin();
+         it != identifierNames.end();
+         ++it)
+    {
+        WriteName(*it);
+    }
+
+    for (uint32_t i = 0; i < identifierNames.size(); i++)
+    {
+        Ptr<Column> column = Create<Column>(this, i);
+        column->m_times.reserve(blockSize);
+        column->m_values.reserve(blockSize);
+        m_columns.push_back(column);
+    }
+
+} // end of `ApplicationStatsBinaryWriter (...)`
+
+ApplicationStatsBinaryWriter::~ApplicationStatsBinaryWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+ApplicationStatsBinaryWriter::Write(uint32_t identifier, double time, double value)
+{
+    if (m_isClosed)
+    {
+        return;
+    }
+
+    NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+    Column* column = PeekPointer(m_columns[identifier]);
+    column->m_times.push_back(time);
+    column->m_values.push_back(value);
+
+    if (column->m_times.size() >= m_blockSize)
+    {
+        FlushBlock(identifier);
+    }
+}
+
+Callback<void, double, double>
+ApplicationStatsBinaryWriter::GetSink(uint32_t identifier)
+{
+    NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+    return MakeCallback(&Column::TraceSink, m_columns[identifier]);
+}
+
+void
+ApplicationStatsBinaryWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_isClosed)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_columns.size(); i++)
+    {
+        FlushBlock(i);
+        m_columns[i]->Detach();
+    }
+
+    if (m_asyncWriter != nullptr)
+    {
+        m_asyncWriter->Close();
+    }
+    else
+    {
+        m_ofs.close();
+    }
+
+    m_isClosed = true;
+}
+
+void
+ApplicationStatsBinaryWriter::FlushBlock(uint32_t identifier)
+{
+    NS_ASSERT(identifier < m_columns.size());
+    Column* column = PeekPointer(m_columns[identifier]);
+    const uint32_t n = column->m_times.size();
+    NS_ASSERT(column->m_values.size() == n);
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    NS_LOG_LOGIC(this << " writing a block of " << n << " samples of identifier " << identifier);
+    WriteUint32(identifier);
+    WriteUint32(n);
+    WriteBytes(&column->m_times[0], n * sizeof(double));
+    WriteBytes(&column->m_values[0], n * sizeof(double));
+    column->m_times.clear();
+    column->m_values.clear();
+}
+
+void
+ApplicationStatsBinaryWriter::WriteBytes(const void* data, uint32_t size)
+{
+    if (m_asyncWriter != nullptr)
+    {
+        m_asyncWriter->Write(data, size);
+    }
+    else
+    {
+        m_ofs.write(static_cast<const char*>(data), size);
+    }
+}
+
+void
+ApplicationStatsBinaryWriter::WriteUint32(uint32_t value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void
+ApplicationStatsBinaryWriter::WriteName(const std::string& name)
+{
+    WriteUint32(name.size());
+    WriteBytes(name.data(), name.size());
+}
+
+// COLUMN /////////////////////////////////////////////////////////////////////
+
+ApplicationStatsBinaryWriter::Column::Column(ApplicationStatsBinaryWriter* writer,
+                                             uint32_t identifier)
+    : m_writer(writer),
+      m_identifier(identifier)
+{
+}
+
+void
+ApplicationStatsBinaryWriter::Column::TraceSink(double time, double value)
+{
+    if (m_writer != nullptr)
+    {
+        m_writer->Write(m_identifier, time, value);
+    }
+}
+
+void
+ApplicationStatsBinaryWriter::Column::Detach()
+{
+    m_writer = nullptr;
+}
+
+} // end of namespace ns3
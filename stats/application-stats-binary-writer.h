@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_BINARY_WRITER_H
+#define APPLICATION_STATS_BINARY_WRITER_H
+
+#include "application-stats-async-writer.h"
+
+#include <ns3/callback.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Writer of time/value samples into a binary, column-oriented file.
+ *
+ * Used by the `OUTPUT_SCATTER_BINARY_FILE` output type as a replacement of
+ * text output through MultiFileAggregator. Samples of each identifier are
+ * buffered in memory and written in blocks, which avoids text formatting and
+ * per-sample I/O.
+ *
+ * All integers and floating point numbers are written in the byte order of the
+ * host. The file begins with a self-describing header:
+ * - magic string `APPSTATS` (8 bytes);
+ * - byte order marker 0x01020304 (uint32);
+ * - format version, currently 1 (uint32);
+ * - name of the time column and name of the value column; and
+ * - number of identifiers (uint32), followed by the name of each identifier.
+ *
+ * Every name is written as its length in bytes (uint32) followed by the
+ * characters, without any terminating null character. After the header, the
+ * file contains any number of blocks, each of them consisting of:
+ * - identifier, i.e., index to the list of identifier names (uint32);
+ * - number of samples in the block, N (uint32);
+ * - N time values in seconds (double); and
+ * - N sample values (double).
+ *
+ * Blocks of different identifiers may be interleaved, but the samples of the
+ * same identifier always appear in chronological order.
+ *
+ * If the writer is created as asynchronous, the header and the blocks are
+ * handed over to an ApplicationStatsAsyncWriter, so that the actual file I/O
+ * takes place in a background thread. The content of the file is the same.
+ */
+class ApplicationStatsBinaryWriter : public SimpleRefCount<ApplicationStatsBinaryWriter>
+{
+  public:
+    /// The magic string at the beginning of the file.
+    static const char MAGIC[8];
+
+    /// Version of the file format.
+    static const uint32_t VERSION = 1;
+
+    /**
+     * \brief Create a new writer and write the file header.
+     * \param fileName name of the output file.
+     * \param timeColumnName name of the time column, e.g., "time_sec".
+     * \param valueColumnName name of the value column, e.g., "delay_sec".
+     * \param identifierNames names of the identifiers.
+     * \param blockSize number of samples buffered per identifier before being
+     *                  written as a block.
+     * \param isAsync if true, the file is written by a background I/O thread.
+     */
+    ApplicationStatsBinaryWriter(std::string fileName,
+                                 std::string timeColumnName,
+                                 std::string valueColumnName,
+                                 const std::vector<std::string>& identifierNames,
+                                 uint32_t blockSize = 256,
+                                 bool isAsync = false);
+
+    /// Destructor, which closes the file if still open.
+    ~ApplicationStatsBinaryWriter();
+
+    /**
+     * \brief Append a sample into the buffer of the given identifier.
+     * \param identifier index of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     */
+    void Write(uint32_t identifier, double time, double value);
+
+    /**
+     * \param identifier index of the identifier.
+     * \return a callback which appends samples into the buffer of the given
+     *         identifier, suitable as a sink of trace sources with two double
+     *         arguments (time and value).
+     */
+    Callback<void, double, double> GetSink(uint32_t identifier);
+
+    /// Write all buffered samples and close the file. Further samples are ignored.
+    void Close();
+
+  private:
+    /// Buffered samples of one identifier.
+    class Column : public SimpleRefCount<Column>
+    {
+      public:
+        /**
+         * \param writer the parent writer.
+         * \param identifier index of the identifier.
+         */
+        Column(ApplicationStatsBinaryWriter* writer, uint32_t identifier);
+
+        /**
+         * \param time the time of the sample in seconds.
+         * \param value the sample value.
+         */
+        void TraceSink(double time, double value);
+
+        /// Forget the parent writer, so that further samples are ignored.
+        void Detach();
+
+        std::vector<double> m_times;  ///< Buffered time values.
+        std::vector<double> m_values; ///< Buffered sample values.
+
+      private:
+        ApplicationStatsBinaryWriter* m_writer; ///< The parent writer.
+        uint32_t m_identifier;                 ///< Index of the identifier.
+    };
+
+    /**
+     * \brief Write the buffered samples of an identifier as a block.
+     * \param identifier index of the identifier.
+     */
+    void FlushBlock(uint32_t identifier);
+
+    /**
+     * \brief Write bytes into the file, or into #m_asyncWriter if it exists.
+     * \param data pointer to the first byte.
+     * \param size number of bytes.
+     */
+    void WriteBytes(const void* data, uint32_t size);
+
+    /**
+     * \param value an integer to be written into the file.
+     */
+    void WriteUint32(uint32_t value);
+
+    /**
+     * \param name a string to be written into the file, prefixed by its length.
+     */
+    void WriteName(const std::string& name);
+
+    std::ofstream m_ofs;                             ///< The output file, if synchronous.
+    Ptr<ApplicationStatsAsyncWriter> m_asyncWriter; ///< The output file, if asynchronous.
+    uint32_t m_blockSize;                            ///< Number of samples per block.
+    std::vector<Ptr<Column>> m_columns;              ///< Buffers, indexed by identifier.
+    bool m_isClosed;                                 ///< True after Close() has been invoked.
+
+}; // end of class ApplicationStatsBinaryWriter
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_BINARY_WRITER_H */
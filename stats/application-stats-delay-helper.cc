@@ -29,13 +29,13 @@
 #include <ns3/enum.h>
 #include <ns3/gnuplot-aggregator.h>
 #include <ns3/inet-socket-address.h>
-#include <ns3/ipv4.h>
 #include <ns3/log.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/node.h>
 #include <ns3/nstime.h>
 #include <ns3/probe.h>
 #include <ns3/scalar-collector.h>
+#include <ns3/simulator.h>
 #include <ns3/string.h>
 #include <ns3/unit-conversion-collector.h>
 #include <ns3/unused.h>
@@ -72,7 +72,121 @@ ApplicationStatsDelayHelper::DoInstall()
 {
     NS_LOG_FUNCTION(this);
 
-    // Setup aggregators and collectors.
+    if (IsInlinePipeline() && (GetOutputType() == ApplicationStatsHelper::OUTPUT_SCALAR_FILE))
+    {
+        /*
+         * Average the samples of each identifier inline, without probes and
+         * collectors, and write the averages into the same file as the
+         * ScalarCollector instances would.
+         */
+        m_aggregator = CreateScalarFileAggregator();
+        typedef ApplicationStatsInlinePipeline<ApplicationStatsInlineAverage> Pipeline_t;
+        Ptr<Pipeline_t> pipeline = Create<Pipeline_t>(GetIdentifierNames().size(),
+                                                      ApplicationStatsInlineAverage(),
+                                                      CreateInlineOutput(m_aggregator));
+        const uint32_t n =
+            SetupInlineSinksAtReceiver<Time, ApplicationStatsDelayConversion>(pipeline);
+        NS_LOG_INFO(this << " connected to " << n << " trace sources");
+        return;
+    }
+
+    InstallCollectors();
+
+    // Setup probes and connect them to the collectors.
+
+    switch (GetIdentifierType())
+    {
+    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
+    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
+        if (GetBoundTraceSinks() || GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY ||
+            GetOutputType() == ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE ||
+            m_scatterSampler != nullptr)
+        {
+            /*
+             * Connect each receiver to its own trace sink, which passes the
+             * samples directly to the collector with the bound identifier.
+             */
+            CreateTerminalSinks();
+            const uint32_t n = SetupBoundListenersAtReceiver(
+                MakeCallback(&ApplicationStatsDelayHelper::PassSampleToCollector, this));
+            NS_LOG_INFO(this << " connected to " << n << " trace sources");
+            break;
+        }
+
+        /*
+         * Install a probe on each receiver and connect them to the
+         * first-level collectors.
+         */
+        uint32_t n = 0;
+        switch (GetOutputType())
+        {
+        case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
+        case ApplicationStatsHelper::OUTPUT_SCALAR_PLOT:
+            n = SetupProbesAtReceiver<ApplicationDelayProbe>("OutputSeconds",
+                                                             m_terminalCollectors,
+                                                             &ScalarCollector::TraceSinkDouble,
+                                                             m_probes);
+            break;
+
+        case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+        case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
+            n = SetupProbesAtReceiver<ApplicationDelayProbe>(
+                "OutputSeconds",
+                m_terminalCollectors,
+                &UnitConversionCollector::TraceSinkDouble,
+                m_probes);
+            break;
+
+        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
+        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+        case ApplicationStatsHelper::OUTPUT_PDF_FILE:
+        case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
+        case ApplicationStatsHelper::OUTPUT_CDF_FILE:
+        case ApplicationStatsHelper::OUTPUT_CDF_PLOT:
+            n = SetupProbesAtReceiver<ApplicationDelayProbe>(
+                "OutputSeconds",
+                m_terminalCollectors,
+                &DistributionCollector::TraceSinkDouble,
+                m_probes);
+            break;
+
+        default:
+            NS_FATAL_ERROR(GetOutputTypeName(GetOutputType())
+                           << " is not a valid output type for this statistics.");
+            break;
+        }
+
+        NS_LOG_INFO(this << " created " << n << " instance(s)"
+                         << " of ApplicationDelayProbe");
+        break;
+    }
+
+    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
+        // Create a look-up table of sender addresses and collector identifiers.
+        BuildAddressTable();
+        CreateTerminalSinks();
+
+        // Connect with trace sources in receiver applications.
+        const uint32_t n = SetupListenersAtReceiver(
+            MakeCallback(&ApplicationStatsDelayHelper::RxDelayCallback, this));
+        NS_LOG_INFO(this << " connected to " << n << " trace sources");
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("ApplicationStatsDelayHelper - Invalid identifier type");
+        break;
+
+    } // end of `switch (GetIdentifierType ())`
+
+} // end of `void DoInstall ();`
+
+void
+ApplicationStatsDelayHelper::InstallCollectors()
+{
+    NS_LOG_FUNCTION(this);
+
+    const std::string columnName = GetColumnName();
 
     switch (GetOutputType())
     {
@@ -83,15 +197,7 @@ ApplicationStatsDelayHelper::DoInstall()
 
     case ApplicationStatsHelper::OUTPUT_SCALAR_FILE: {
         // Setup aggregator.
-        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
-                                        "OutputFileName",
-                                        StringValue(GetName()),
-                                        "MultiFileMode",
-                                        BooleanValue(false),
-                                        "EnableContextPrinting",
-                                        BooleanValue(true),
-                                        "GeneralHeading",
-                                        StringValue("% identifier delay_sec"));
+        m_aggregator = CreateScalarFileAggregator();
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::ScalarCollector");
@@ -113,7 +219,7 @@ ApplicationStatsDelayHelper::DoInstall()
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "GeneralHeading",
-                                        StringValue("% time_sec delay_sec"));
+                                        StringValue("% time_sec " + columnName));
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::UnitConversionCollector");
@@ -134,7 +240,7 @@ ApplicationStatsDelayHelper::DoInstall()
                                         "OutputFileName",
                                         StringValue(GetName()),
                                         "GeneralHeading",
-                                        StringValue("% delay_sec freq"));
+                                        StringValue("% " + columnName + " freq"));
 
         // Setup collectors.
         m_terminalCollectors.SetType("ns3::DistributionCollector");
@@ -172,7 +278,7 @@ ApplicationStatsDelayHelper::DoInstall()
         // Setup aggregator.
         Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
         // plot->SetTitle ("");
-        plotAggregator->SetLegend("Time (in seconds)", "Packet delay (in seconds)");
+        plotAggregator->SetLegend("Time (in seconds)", GetAxisLabel());
         plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
         m_aggregator = plotAggregator;
 
@@ -200,7 +306,7 @@ ApplicationStatsDelayHelper::DoInstall()
         // Setup aggregator.
         Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
         // plot->SetTitle ("");
-        plotAggregator->SetLegend("Packet delay (in seconds)", "Frequency");
+        plotAggregator->SetLegend(GetAxisLabel(), "Frequency");
         plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
         m_aggregator = plotAggregator;
 
@@ -231,95 +337,82 @@ ApplicationStatsDelayHelper::DoInstall()
         break;
     }
 
+    case ApplicationStatsHelper::OUTPUT_SUMMARY:
+        // No collector and aggregator, the summaries are written upon disposal.
+        CreateSummaryPerIdentifier("% identifier " + columnName);
+        break;
+
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
+        // No collector and aggregator, the samples are written in blocks.
+        CreateBinaryWriter("time_sec", columnName);
+        break;
+
     default:
         NS_FATAL_ERROR("ApplicationStatsDelayHelper - Invalid output type");
         break;
 
     } // end of `switch (GetOutputType ())`
 
-    // Setup probes and connect them to the collectors.
-
-    switch (GetIdentifierType())
+    if (IsScatterSampling() || IsSlidingWindow())
     {
-    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
-    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
-        /*
-         * Install a probe on each receiver and connect them to the
-         * first-level collectors.
-         */
-        uint32_t n = 0;
-        switch (GetOutputType())
-        {
-        case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
-        case ApplicationStatsHelper::OUTPUT_SCALAR_PLOT:
-            n = SetupProbesAtReceiver<ApplicationDelayProbe>("OutputSeconds",
-                                                             m_terminalCollectors,
-                                                             &ScalarCollector::TraceSinkDouble,
-                                                             m_probes);
-            break;
+        // Thinned samples bypass the collectors and go straight to the output.
+        CreateScatterSampler(m_aggregator);
+    }
 
-        case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
-        case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
-            n = SetupProbesAtReceiver<ApplicationDelayProbe>(
-                "OutputSeconds",
-                m_terminalCollectors,
-                &UnitConversionCollector::TraceSinkDouble,
-                m_probes);
-            break;
+    if (IsSlidingWindow())
+    {
+        CreateSlidingWindow(ApplicationStatsSlidingWindow::OUTPUT_MEAN, 1.0);
+    }
 
-        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
-        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-        case ApplicationStatsHelper::OUTPUT_PDF_FILE:
-        case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
-        case ApplicationStatsHelper::OUTPUT_CDF_FILE:
-        case ApplicationStatsHelper::OUTPUT_CDF_PLOT:
-            n = SetupProbesAtReceiver<ApplicationDelayProbe>(
-                "OutputSeconds",
-                m_terminalCollectors,
-                &DistributionCollector::TraceSinkDouble,
-                m_probes);
-            break;
+} // end of `void InstallCollectors ()`
 
-        default:
-            NS_FATAL_ERROR(GetOutputTypeName(GetOutputType())
-                           << " is not a valid output type for this statistics.");
-            break;
-        }
+Ptr<DataCollectionObject>
+ApplicationStatsDelayHelper::CreateScalarFileAggregator()
+{
+    NS_LOG_FUNCTION(this);
+    return CreateAggregator("ns3::MultiFileAggregator",
+                            "OutputFileName",
+                            StringValue(GetName()),
+                            "MultiFileMode",
+                            BooleanValue(false),
+                            "EnableContextPrinting",
+                            BooleanValue(true),
+                            "GeneralHeading",
+                            StringValue("% identifier " + GetColumnName()));
+}
 
-        NS_LOG_INFO(this << " created " << n << " instance(s)"
-                         << " of ApplicationDelayProbe");
-        break;
-    }
+void
+ApplicationStatsDelayHelper::BuildAddressTable()
+{
+    NS_LOG_FUNCTION(this);
 
-    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
-        // Create a look-up table of sender addresses and collector identifiers.
-        uint32_t identifier = 0;
-        std::map<std::string, ApplicationContainer>::const_iterator it1;
-        for (it1 = m_senderInfo.begin(); it1 != m_senderInfo.end(); ++it1)
+    m_addressTable.Clear();
+    uint32_t identifier = 0;
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_senderInfo.begin(); it1 != m_senderInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
         {
-            for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
-                 ++it2)
-            {
-                SaveAddressAndIdentifier(*it2, identifier);
-            }
-
-            identifier++;
+            SaveAddressAndIdentifier(*it2, identifier);
         }
 
-        // Connect with trace sources in receiver applications.
-        const uint32_t n = SetupListenersAtReceiver(
-            MakeCallback(&ApplicationStatsDelayHelper::RxDelayCallback, this));
-        NS_LOG_INFO(this << " connected to " << n << " trace sources");
-        break;
+        identifier++;
     }
+    m_addressTable.Build();
+}
 
-    default:
-        NS_FATAL_ERROR("ApplicationStatsDelayHelper - Invalid identifier type");
-        break;
-
-    } // end of `switch (GetIdentifierType ())`
+std::string
+ApplicationStatsDelayHelper::GetColumnName() const
+{
+    return "delay_sec";
+}
 
-} // end of `void DoInstall ();`
+std::string
+ApplicationStatsDelayHelper::GetAxisLabel() const
+{
+    return "Packet delay (in seconds)";
+}
 
 void
 ApplicationStatsDelayHelper::RxDelayCallback(Time delay, const Address& from)
@@ -329,10 +422,10 @@ ApplicationStatsDelayHelper::RxDelayCallback(Time delay, const Address& from)
     if (InetSocketAddress::IsMatchingType(from))
     {
         // Determine the identifier associated with the sender address.
-        const Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
-        std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find(ipv4Addr);
+        const Ipv4Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
+        const uint32_t identifier = m_addressTable.Lookup(ipv4Addr);
 
-        if (it1 == m_identifierMap.end())
+        if (identifier == ApplicationStatsAddressTable::INVALID_IDENTIFIER)
         {
             NS_LOG_WARN(this << " discarding a packet delay of " << delay.GetSeconds()
                              << " from statistics collection because of"
@@ -340,7 +433,7 @@ ApplicationStatsDelayHelper::RxDelayCallback(Time delay, const Address& from)
         }
         else
         {
-            PassSampleToCollector(delay, it1->second);
+            PassSampleToCollector(delay, identifier);
         }
     }
     else
@@ -358,83 +451,107 @@ ApplicationStatsDelayHelper::SaveAddressAndIdentifier(Ptr<Application> applicati
                                                       uint32_t identifier)
 {
     NS_LOG_FUNCTION(this << application << identifier);
+    m_addressTable.AddApplication(application, identifier);
+}
+
+void
+ApplicationStatsDelayHelper::CreateTerminalSinks()
+{
+    NS_LOG_FUNCTION(this);
 
-    Ptr<Node> node = application->GetNode();
-    NS_ASSERT_MSG(node != nullptr, "Application is not attached to any Node");
-    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    m_terminalSinks.clear();
 
-    if (ipv4 == nullptr)
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY ||
+        GetOutputType() == ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE ||
+        m_scatterSampler != nullptr)
     {
-        NS_LOG_INFO(this << " Node " << node->GetId() << " does not support IPv4 protocol");
+        return; // samples go to the summaries, the binary writer, or the sampler instead
     }
-    else
+
+    m_terminalSinks.reserve(m_terminalCollectors.GetN());
+
+    for (CollectorMap::Iterator it = m_terminalCollectors.Begin();
+         it != m_terminalCollectors.End();
+         ++it)
     {
-        NS_LOG_DEBUG(this << " found " << ipv4->GetNInterfaces() << " interface(s)"
-                          << " in Node " << node->GetId());
+        // The collectors are labelled using running integers starting from 0.
+        NS_ASSERT(it->first == m_terminalSinks.size());
+        Ptr<DataCollectionObject> collector = it->second;
 
-        // Skipping interface #0 because it is assumed to be a loopback interface.
-        for (uint32_t i = 1; i < ipv4->GetNInterfaces(); i++)
+        switch (GetOutputType())
         {
-            NS_LOG_DEBUG(this << " found " << ipv4->GetNAddresses(i) << " address(es)"
-                              << " in Node " << node->GetId() << " interface #" << i);
-
-            for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
-            {
-                const Address addr = ipv4->GetAddress(i, j).GetLocal();
-                m_identifierMap[addr] = identifier;
-                NS_LOG_INFO(this << " associated address " << addr << " with identifier "
-                                 << identifier);
-            }
+        case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
+        case ApplicationStatsHelper::OUTPUT_SCALAR_PLOT: {
+            Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector>();
+            NS_ASSERT(c != nullptr);
+            m_terminalSinks.push_back(MakeCallback(&ScalarCollector::TraceSinkDouble, c));
+            break;
         }
-    }
 
-} // end of `void SaveAddressAndIdentifier (Ptr<Application>, uint32_t)`
+        case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+        case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT: {
+            Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector>();
+            NS_ASSERT(c != nullptr);
+            m_terminalSinks.push_back(MakeCallback(&UnitConversionCollector::TraceSinkDouble, c));
+            break;
+        }
+
+        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
+        case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+        case ApplicationStatsHelper::OUTPUT_PDF_FILE:
+        case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
+        case ApplicationStatsHelper::OUTPUT_CDF_FILE:
+        case ApplicationStatsHelper::OUTPUT_CDF_PLOT: {
+            Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector>();
+            NS_ASSERT(c != nullptr);
+            m_terminalSinks.push_back(MakeCallback(&DistributionCollector::TraceSinkDouble, c));
+            break;
+        }
+
+        default:
+            NS_FATAL_ERROR(GetOutputTypeName(GetOutputType())
+                           << " is not a valid output type for this statistics.");
+            break;
+
+        } // end of `switch (GetOutputType ())`
+
+    } // end of `for (it = m_terminalCollectors)`
+
+} // end of `void CreateTerminalSinks ()`
 
 void
 ApplicationStatsDelayHelper::PassSampleToCollector(Time delay, uint32_t identifier)
 {
     // NS_LOG_FUNCTION (this << delay.GetSeconds () << identifier);
 
-    Ptr<DataCollectionObject> collector = m_terminalCollectors.Get(identifier);
-    NS_ASSERT_MSG(collector != nullptr, "Unable to find collector with identifier " << identifier);
-
-    switch (GetOutputType())
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY)
     {
-    case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
-    case ApplicationStatsHelper::OUTPUT_SCALAR_PLOT: {
-        Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector>();
-        NS_ASSERT(c != nullptr);
-        c->TraceSinkDouble(0.0, delay.GetSeconds());
-        break;
+        AddSummarySample(identifier, delay.GetSeconds());
+        return;
     }
 
-    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
-    case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT: {
-        Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector>();
-        NS_ASSERT(c != nullptr);
-        c->TraceSinkDouble(0.0, delay.GetSeconds());
-        break;
+    if (m_slidingWindow != nullptr)
+    {
+        m_slidingWindow->Add(identifier, delay.GetSeconds());
+        return;
     }
 
-    case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
-    case ApplicationStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-    case ApplicationStatsHelper::OUTPUT_PDF_FILE:
-    case ApplicationStatsHelper::OUTPUT_PDF_PLOT:
-    case ApplicationStatsHelper::OUTPUT_CDF_FILE:
-    case ApplicationStatsHelper::OUTPUT_CDF_PLOT: {
-        Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector>();
-        NS_ASSERT(c != nullptr);
-        c->TraceSinkDouble(0.0, delay.GetSeconds());
-        break;
+    if (m_scatterSampler != nullptr)
+    {
+        m_scatterSampler->Write(identifier, Simulator::Now().GetSeconds(), delay.GetSeconds());
+        return;
     }
 
-    default:
-        NS_FATAL_ERROR(GetOutputTypeName(GetOutputType())
-                       << " is not a valid output type for this statistics.");
-        break;
-
-    } // end of `switch (GetOutputType ())`
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE)
+    {
+        NS_ASSERT(m_binaryWriter != nullptr);
+        m_binaryWriter->Write(identifier, Simulator::Now().GetSeconds(), delay.GetSeconds());
+        return;
+    }
 
-} // end of `void PassSampleToCollector (Time, uint32_t)`
+    NS_ASSERT_MSG(identifier < m_terminalSinks.size(),
+                  "Unable to find collector with identifier " << identifier);
+    m_terminalSinks[identifier](0.0, delay.GetSeconds());
+}
 
 } // end of namespace ns3
@@ -23,12 +23,15 @@
 #define APPLICATION_STATS_DELAY_HELPER_H
 
 #include <ns3/address.h>
+#include <ns3/application-stats-address-table.h>
 #include <ns3/application-stats-helper.h>
+#include <ns3/callback.h>
 #include <ns3/collector-map.h>
 #include <ns3/ptr.h>
 
 #include <list>
-#include <map>
+#include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -73,6 +76,50 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
     // inherited from ApplicationStatsHelper base class
     virtual void DoInstall();
 
+    /**
+     * \brief Create the aggregator and the terminal collectors according to the
+     *        output type.
+     *
+     * The first part of DoInstall(), which is shared with child classes
+     * producing other time-valued statistics.
+     */
+    void InstallCollectors();
+
+    /**
+     * \brief Fill #m_addressTable with the addresses of the sender
+     *        applications. Used only with `SENDER` identifier.
+     */
+    void BuildAddressTable();
+
+    /**
+     * \return the name of the sample column in the output files, e.g.,
+     *         "delay_sec".
+     */
+    virtual std::string GetColumnName() const;
+
+    /**
+     * \return the label of the sample axis in the output plots, e.g.,
+     *         "Packet delay (in seconds)".
+     */
+    virtual std::string GetAxisLabel() const;
+
+    /**
+     * \brief Bind the trace sink of every terminal collector to a callback and
+     *        store them in #m_terminalSinks, indexed by identifier.
+     */
+    void CreateTerminalSinks();
+
+    /**
+     * \brief Find a collector with the right identifier and pass a sample data
+     *        to it.
+     * \param delay packet delay.
+     * \param identifier collector identifier.
+     */
+    void PassSampleToCollector(Time delay, uint32_t identifier);
+
+    /// Look-up table of address and the `SENDER` identifier associated with it.
+    ApplicationStatsAddressTable m_addressTable;
+
   private:
     /**
      * \brief Associate the given application's IPv4 address with the given
@@ -81,18 +128,16 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
      * \param identifier the number to be associated with.
      *
      * Any IPv4 address(es) which belong to the Node of the given application
-     * will be saved in the #m_identifierMap member variable. Used only with
+     * will be saved in the #m_addressTable member variable. Used only with
      * `SENDER` identifier.
      */
     void SaveAddressAndIdentifier(Ptr<Application> application, uint32_t identifier);
 
     /**
-     * \brief Find a collector with the right identifier and pass a sample data
-     *        to it.
-     * \param delay packet delay.
-     * \param identifier collector identifier.
+     * \return a new MultiFileAggregator for the `OUTPUT_SCALAR_FILE` output
+     *         type, with one line per identifier.
      */
-    void PassSampleToCollector(Time delay, uint32_t identifier);
+    Ptr<DataCollectionObject> CreateScalarFileAggregator();
 
     /// Maintains a list of probes created by this helper.
     std::list<Ptr<Probe>> m_probes;
@@ -103,8 +148,8 @@ class ApplicationStatsDelayHelper : public ApplicationStatsHelper
     /// The aggregator created by this helper.
     Ptr<DataCollectionObject> m_aggregator;
 
-    /// Map of address and the `SENDER` identifier associated with it.
-    std::map<const Address, uint32_t> m_identifierMap;
+    /// Trace sinks of the terminal collectors, indexed by identifier.
+    std::vector<Callback<void, double, double>> m_terminalSinks;
 
 }; // end of class ApplicationStatsDelayHelper
 
@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-frame-delay-helper.h"
+
+#include <ns3/application-container.h>
+#include <ns3/application.h>
+#include <ns3/log.h>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsFrameDelayHelper");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsFrameDelayHelper);
+
+ApplicationStatsFrameDelayHelper::ApplicationStatsFrameDelayHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ApplicationStatsFrameDelayHelper::~ApplicationStatsFrameDelayHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationStatsFrameDelayHelper::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ApplicationStatsFrameDelayHelper").SetParent<ApplicationStatsDelayHelper>();
+    return tid;
+}
+
+void
+ApplicationStatsFrameDelayHelper::DoInstall()
+{
+    NS_LOG_FUNCTION(this);
+
+    InstallCollectors();
+
+    if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER)
+    {
+        // Create a look-up table of sender addresses and collector identifiers.
+        BuildAddressTable();
+    }
+
+    CreateTerminalSinks();
+
+    uint32_t n = 0;
+    uint32_t identifier = 0;
+
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
+        {
+            if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName("RxFrameStats") == nullptr)
+            {
+                continue;
+            }
+
+            Ptr<FrameSink> sink = Create<FrameSink>(this, identifier);
+            if ((*it2)->TraceConnectWithoutContext("RxFrameStats",
+                                                   MakeCallback(&FrameSink::RxFrameStats, sink)))
+            {
+                m_sinks.push_back(sink);
+                n++;
+            }
+        }
+
+        if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+        {
+            identifier++; // Move to the next collector.
+        }
+
+    } // end of `for (it1 = m_receiverInfo)`
+
+    NS_LOG_INFO(this << " connected to " << n << " trace sources");
+
+} // end of `void DoInstall ()`
+
+std::string
+ApplicationStatsFrameDelayHelper::GetColumnName() const
+{
+    return "frame_delay_sec";
+}
+
+std::string
+ApplicationStatsFrameDelayHelper::GetAxisLabel() const
+{
+    return "Frame delay (in seconds)";
+}
+
+// FRAME SINK /////////////////////////////////////////////////////////////////
+
+ApplicationStatsFrameDelayHelper::FrameSink::FrameSink(ApplicationStatsFrameDelayHelper* helper,
+                                                       uint32_t identifier)
+    : m_helper(helper),
+      m_identifier(identifier)
+{
+}
+
+void
+ApplicationStatsFrameDelayHelper::FrameSink::RxFrameStats(uint32_t frameNumber,
+                                                          uint32_t frameSize,
+                                                          const Time& frameDelay,
+                                                          const Time& maxSliceDelay,
+                                                          const Address& from)
+{
+    if (m_helper->GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER)
+    {
+        m_helper->RxDelayCallback(frameDelay, from);
+    }
+    else
+    {
+        m_helper->PassSampleToCollector(frameDelay, m_identifier);
+    }
+}
+
+} // end of namespace ns3
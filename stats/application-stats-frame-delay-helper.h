@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_FRAME_DELAY_HELPER_H
+#define APPLICATION_STATS_FRAME_DELAY_HELPER_H
+
+#include <ns3/address.h>
+#include <ns3/application-stats-delay-helper.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <list>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Produce frame delay statistics of the videos received by the
+ *        receiver applications.
+ *
+ * A frame delay sample is the time since the earliest timestamp of the slices
+ * of a video frame until all of them have been received. The samples are
+ * taken from the `RxFrameStats` trace source of the receiver applications
+ * (see NrtvTcpClient), which is fired once per frame, so the trace sinks and
+ * the collectors handle the slices-per-frame fraction of the samples of the
+ * packet delay statistics.
+ *
+ * The `RxFrameStats` trace source is always used, regardless of the
+ * `TraceSourceName` attribute, so the frame delay statistics can be added to
+ * the same ApplicationStatsHelperContainer as the packet delay statistics.
+ * Receiver applications without such trace source are skipped. The samples
+ * are written out in the same output types as the delay statistics.
+ */
+class ApplicationStatsFrameDelayHelper : public ApplicationStatsDelayHelper
+{
+  public:
+    // inherited from ApplicationStatsHelper base class
+    ApplicationStatsFrameDelayHelper();
+
+    /// Destructor.
+    virtual ~ApplicationStatsFrameDelayHelper();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+  protected:
+    // inherited from ApplicationStatsHelper base class
+    virtual void DoInstall();
+
+    // inherited from ApplicationStatsDelayHelper base class
+    virtual std::string GetColumnName() const;
+    virtual std::string GetAxisLabel() const;
+
+  private:
+    /// Trace sink of a single receiver application.
+    class FrameSink : public SimpleRefCount<FrameSink>
+    {
+      public:
+        /**
+         * \param helper the parent helper.
+         * \param identifier the collector identifier of the receiver, ignored
+         *                   with `SENDER` identifier.
+         */
+        FrameSink(ApplicationStatsFrameDelayHelper* helper, uint32_t identifier);
+
+        /**
+         * \param frameNumber the number of the frame within the video.
+         * \param frameSize the size of the frame in bytes.
+         * \param frameDelay the frame delay.
+         * \param maxSliceDelay the largest delay among the slices of the frame.
+         * \param from the address of the sender of the frame.
+         */
+        void RxFrameStats(uint32_t frameNumber,
+                          uint32_t frameSize,
+                          const Time& frameDelay,
+                          const Time& maxSliceDelay,
+                          const Address& from);
+
+      private:
+        ApplicationStatsFrameDelayHelper* m_helper; ///< The parent helper.
+        uint32_t m_identifier;                      ///< The bound identifier.
+    };
+
+    /// Trace sinks created by this helper, kept alive until the helper is destroyed.
+    std::list<Ptr<FrameSink>> m_sinks;
+
+}; // end of class ApplicationStatsFrameDelayHelper
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_FRAME_DELAY_HELPER_H */
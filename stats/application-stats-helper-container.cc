@@ -21,13 +21,22 @@
 
 #include "application-stats-helper-container.h"
 
+#include <ns3/abort.h>
 #include <ns3/application-stats-delay-helper.h>
+#include <ns3/application-stats-frame-delay-helper.h>
 #include <ns3/application-stats-helper.h>
+#include <ns3/application-stats-jitter-helper.h>
 #include <ns3/application-stats-throughput-helper.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
 #include <ns3/enum.h>
 #include <ns3/log.h>
+#include <ns3/simulator.h>
 #include <ns3/string.h>
+#include <ns3/trace-source-accessor.h>
+#include <ns3/uinteger.h>
 
+#include <iterator>
 #include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ApplicationStatsHelperContainer");
@@ -38,6 +47,13 @@ namespace ns3
 NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsHelperContainer);
 
 ApplicationStatsHelperContainer::ApplicationStatsHelperContainer()
+    : m_perRankOutput(false),
+      m_steadyStateDetection(false),
+      m_targetRelativePrecision(0.05),
+      m_steadyStateMinSamples(100),
+      m_steadyStateCheckInterval(Seconds(1)),
+      m_stopOnSteadyState(false),
+      m_isSteadyStateReached(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -46,6 +62,7 @@ void
 ApplicationStatsHelperContainer::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_steadyStateCheckEvent.Cancel();
 }
 
 /*
@@ -57,6 +74,8 @@ ApplicationStatsHelperContainer::DoDispose()
  * - [Global,PerReceiver,PerSender] Delay
  * - Average [PerReceiver,PerSender] Throughput
  * - Average [PerReceiver,PerSender] Delay
+ * - [Global,PerReceiver,PerSender] Jitter
+ * - [Global,PerReceiver,PerSender] FrameDelay
  *
  * Also check the Doxygen documentation of this class for more information.
  */
@@ -68,7 +87,9 @@ ApplicationStatsHelperContainer::DoDispose()
   MakeEnumChecker (ST_HE_CL::OUTPUT_NONE,           "NONE",                   \
                    ST_HE_CL::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",            \
                    ST_HE_CL::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",           \
-                   ST_HE_CL::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT"))
+                   ST_HE_CL::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",           \
+                   ST_HE_CL::OUTPUT_SUMMARY,        "SUMMARY",                \
+                   ST_HE_CL::OUTPUT_SCATTER_BINARY_FILE, "SCATTER_BINARY_FILE"))
 
 #define ADD_APPLICATION_STATS_DISTRIBUTION_OUTPUT_CHECKER                                          \
   MakeEnumChecker (ST_HE_CL::OUTPUT_NONE,           "NONE",                   \
@@ -80,7 +101,9 @@ ApplicationStatsHelperContainer::DoDispose()
                    ST_HE_CL::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",           \
                    ST_HE_CL::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",         \
                    ST_HE_CL::OUTPUT_PDF_PLOT,       "PDF_PLOT",               \
-                   ST_HE_CL::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
+                   ST_HE_CL::OUTPUT_CDF_PLOT,       "CDF_PLOT",               \
+                   ST_HE_CL::OUTPUT_SUMMARY,        "SUMMARY",                \
+                   ST_HE_CL::OUTPUT_SCATTER_BINARY_FILE, "SCATTER_BINARY_FILE"))
 
 #define ADD_APPLICATION_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER                                 \
   MakeEnumChecker (ST_HE_CL::OUTPUT_NONE,           "NONE",                   \
@@ -139,6 +162,54 @@ ApplicationStatsHelperContainer::GetTypeId()
                 MakeStringAccessor(&ApplicationStatsHelperContainer::SetTraceSourceName,
                                    &ApplicationStatsHelperContainer::GetTraceSourceName),
                 MakeStringChecker())
+            .AddAttribute("PerRankOutput",
+                          "Append the system ID of this process (the rank of the distributed "
+                          "simulator) to the name, so that processes write separate files",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsHelperContainer::SetPerRankOutput,
+                                              &ApplicationStatsHelperContainer::GetPerRankOutput),
+                          MakeBooleanChecker())
+            .AddAttribute(
+                "SteadyStateDetection",
+                "Track the warm-up truncation point (MSER-5) and the confidence interval of "
+                "the steady-state mean of every identifier of the statistics with SUMMARY "
+                "output type which are added afterwards",
+                BooleanValue(false),
+                MakeBooleanAccessor(&ApplicationStatsHelperContainer::SetSteadyStateDetection,
+                                    &ApplicationStatsHelperContainer::GetSteadyStateDetection),
+                MakeBooleanChecker())
+            .AddAttribute("TargetRelativePrecision",
+                          "The steady state is reached once the half-width of the 95% "
+                          "confidence interval of every tracked mean is within this fraction "
+                          "of the mean",
+                          DoubleValue(0.05),
+                          MakeDoubleAccessor(
+                              &ApplicationStatsHelperContainer::m_targetRelativePrecision),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("SteadyStateMinSamples",
+                          "Minimum number of samples after the truncation point of every "
+                          "tracked identifier before the steady state can be reached",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(
+                              &ApplicationStatsHelperContainer::m_steadyStateMinSamples),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SteadyStateCheckInterval",
+                          "Interval between two checks of the steady state",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(
+                              &ApplicationStatsHelperContainer::m_steadyStateCheckInterval),
+                          MakeTimeChecker())
+            .AddAttribute("StopOnSteadyState",
+                          "Stop the simulation once the steady state is reached",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(
+                              &ApplicationStatsHelperContainer::m_stopOnSteadyState),
+                          MakeBooleanChecker())
+            .AddTraceSource("SteadyStateReached",
+                            "Every tracked statistic has reached the target relative precision",
+                            MakeTraceSourceAccessor(
+                                &ApplicationStatsHelperContainer::m_steadyStateTrace),
+                            "ns3::Time::TracedCallback")
 
         // Throughput statistics.
         ADD_APPLICATION_STATS_ATTRIBUTES_BASIC_SET(Throughput, "throughput statistics")
@@ -149,6 +220,12 @@ ApplicationStatsHelperContainer::GetTypeId()
         //    ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (Delay,
         //                                                        "packet delay statistics")
 
+        // Jitter statistics.
+        ADD_APPLICATION_STATS_ATTRIBUTES_DISTRIBUTION_SET(Jitter, "packet jitter statistics")
+
+        // Frame delay statistics.
+        ADD_APPLICATION_STATS_ATTRIBUTES_DISTRIBUTION_SET(FrameDelay, "frame delay statistics")
+
         ;
     return tid;
 }
@@ -166,6 +243,7 @@ ApplicationStatsHelperContainer::SetName(std::string name)
     }
 
     m_name = name;
+    SetPerRankOutput(m_perRankOutput);
 }
 
 std::string
@@ -187,6 +265,140 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
     return m_traceSourceName;
 }
 
+void
+ApplicationStatsHelperContainer::SetPerRankOutput(bool perRankOutput)
+{
+    NS_LOG_FUNCTION(this << perRankOutput);
+    m_perRankOutput = perRankOutput;
+
+    std::ostringstream oss;
+    oss << m_name;
+    if (perRankOutput)
+    {
+        oss << "-rank-" << Simulator::GetSystemId();
+    }
+    m_prefix = oss.str();
+}
+
+bool
+ApplicationStatsHelperContainer::GetPerRankOutput() const
+{
+    return m_perRankOutput;
+}
+
+void
+ApplicationStatsHelperContainer::SetSteadyStateDetection(bool steadyStateDetection)
+{
+    NS_LOG_FUNCTION(this << steadyStateDetection);
+    m_steadyStateDetection = steadyStateDetection;
+}
+
+bool
+ApplicationStatsHelperContainer::GetSteadyStateDetection() const
+{
+    return m_steadyStateDetection;
+}
+
+bool
+ApplicationStatsHelperContainer::IsSteadyStateReached() const
+{
+    return m_isSteadyStateReached;
+}
+
+uint32_t
+ApplicationStatsHelperContainer::GetNumOfStats() const
+{
+    return m_stats.size();
+}
+
+Ptr<const ApplicationStatsHelper>
+ApplicationStatsHelperContainer::GetStats(uint32_t index) const
+{
+    NS_ASSERT_MSG(index < m_stats.size(), "Invalid index " << index);
+    std::list<Ptr<const ApplicationStatsHelper>>::const_iterator it = m_stats.begin();
+    std::advance(it, index);
+    return *it;
+}
+
+void
+ApplicationStatsHelperContainer::TrackSteadyState(Ptr<const ApplicationStatsHelper> stat)
+{
+    NS_LOG_FUNCTION(this << stat);
+
+    if (!stat->GetSteadyStateDetection())
+    {
+        return;
+    }
+
+    if (stat->GetNumOfSteadyStates() == 0)
+    {
+        NS_LOG_WARN(this << " steady state of " << stat->GetName() << " is not tracked,"
+                         << " because only SUMMARY output type is supported");
+        return;
+    }
+
+    if (!m_steadyStateCheckEvent.IsRunning() && !m_isSteadyStateReached)
+    {
+        NS_ABORT_MSG_UNLESS(m_steadyStateCheckInterval.IsStrictlyPositive(),
+                            "Steady-state check interval must be positive");
+        m_steadyStateCheckEvent =
+            Simulator::Schedule(m_steadyStateCheckInterval,
+                                &ApplicationStatsHelperContainer::CheckSteadyState,
+                                this);
+    }
+}
+
+void
+ApplicationStatsHelperContainer::CheckSteadyState()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t numOfTracked = 0;
+    uint32_t numOfReached = 0;
+
+    for (std::list<Ptr<const ApplicationStatsHelper>>::const_iterator it = m_stats.begin();
+         it != m_stats.end();
+         ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNumOfSteadyStates(); i++)
+        {
+            const ApplicationStatsSteadyState::Estimate_t estimate =
+                (*it)->GetSteadyState(i).GetEstimate();
+            NS_LOG_INFO(this << " " << (*it)->GetName() << " " << (*it)->GetSteadyStateName(i)
+                             << " truncated=" << estimate.truncatedCount
+                             << " retained=" << estimate.retainedCount
+                             << " mean=" << estimate.mean << " halfWidth=" << estimate.halfWidth);
+            numOfTracked++;
+
+            if (estimate.retainedCount >= m_steadyStateMinSamples &&
+                estimate.relativePrecision <= m_targetRelativePrecision)
+            {
+                numOfReached++;
+            }
+        }
+    }
+
+    if (numOfTracked > 0 && numOfReached == numOfTracked)
+    {
+        NS_LOG_INFO(this << " steady state of " << numOfTracked << " identifier(s) reached at "
+                         << Simulator::Now().GetSeconds() << "s");
+        m_isSteadyStateReached = true;
+        m_steadyStateTrace(Simulator::Now());
+
+        if (m_stopOnSteadyState)
+        {
+            Simulator::Stop();
+        }
+        return;
+    }
+
+    m_steadyStateCheckEvent =
+        Simulator::Schedule(m_steadyStateCheckInterval,
+                            &ApplicationStatsHelperContainer::CheckSteadyState,
+                            this);
+
+} // end of `void CheckSteadyState ()`
+
 /*
  * The macro definitions following this comment block are used to declare the
  * majority of methods in this class. Below is the list of the class methods
@@ -196,6 +408,8 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
  * - AddAverage [Receiver,Sender] Throughput
  * - Add [Global,PerReceiver,PerSender] Delay
  * - AddAverage [Receiver,Sender] Delay
+ * - Add [Global,PerReceiver,PerSender] Jitter
+ * - Add [Global,PerReceiver,PerSender] FrameDelay
  *
  * Also check the Doxygen documentation of this class for more information.
  */
@@ -207,14 +421,16 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         if (type != ApplicationStatsHelper::OUTPUT_NONE)                                           \
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
-            stat->SetName(m_name + "-global-" + name + GetOutputTypeSuffix(type));                 \
+            stat->SetName(m_prefix + "-global-" + name + GetOutputTypeSuffix(type));               \
             stat->SetTraceSourceName(m_traceSourceName);                                           \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL);                    \
             stat->SetOutputType(type);                                                             \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
+            stat->SetSteadyStateDetection(m_steadyStateDetection);                                 \
             stat->Install();                                                                       \
             m_stats.push_back(stat);                                                               \
+            TrackSteadyState(stat);                                                                \
         }                                                                                          \
     }                                                                                              \
     void ApplicationStatsHelperContainer::AddPerReceiver##id(                                      \
@@ -224,14 +440,16 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         if (type != ApplicationStatsHelper::OUTPUT_NONE)                                           \
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
-            stat->SetName(m_name + "-per-receiver-" + name + GetOutputTypeSuffix(type));           \
+            stat->SetName(m_prefix + "-per-receiver-" + name + GetOutputTypeSuffix(type));         \
             stat->SetTraceSourceName(m_traceSourceName);                                           \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);                  \
             stat->SetOutputType(type);                                                             \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
+            stat->SetSteadyStateDetection(m_steadyStateDetection);                                 \
             stat->Install();                                                                       \
             m_stats.push_back(stat);                                                               \
+            TrackSteadyState(stat);                                                                \
         }                                                                                          \
     }                                                                                              \
     void ApplicationStatsHelperContainer::AddPerSender##id(                                        \
@@ -241,14 +459,16 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         if (type != ApplicationStatsHelper::OUTPUT_NONE)                                           \
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
-            stat->SetName(m_name + "-per-sender-" + name + GetOutputTypeSuffix(type));             \
+            stat->SetName(m_prefix + "-per-sender-" + name + GetOutputTypeSuffix(type));           \
             stat->SetTraceSourceName(m_traceSourceName);                                           \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_SENDER);                    \
             stat->SetOutputType(type);                                                             \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
+            stat->SetSteadyStateDetection(m_steadyStateDetection);                                 \
             stat->Install();                                                                       \
             m_stats.push_back(stat);                                                               \
+            TrackSteadyState(stat);                                                                \
         }                                                                                          \
     }
 
@@ -260,15 +480,17 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         if (type != ApplicationStatsHelper::OUTPUT_NONE)                                           \
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
-            stat->SetName(m_name + "-average-receiver-" + name + GetOutputTypeSuffix(type));       \
+            stat->SetName(m_prefix + "-average-receiver-" + name + GetOutputTypeSuffix(type));     \
             stat->SetTraceSourceName(m_traceSourceName);                                           \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_RECEIVER);                  \
             stat->SetOutputType(type);                                                             \
             stat->SetAveragingMode(true);                                                          \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
+            stat->SetSteadyStateDetection(m_steadyStateDetection);                                 \
             stat->Install();                                                                       \
             m_stats.push_back(stat);                                                               \
+            TrackSteadyState(stat);                                                                \
         }                                                                                          \
     }                                                                                              \
     void ApplicationStatsHelperContainer::AddAverageSender##id(                                    \
@@ -278,15 +500,17 @@ ApplicationStatsHelperContainer::GetTraceSourceName() const
         if (type != ApplicationStatsHelper::OUTPUT_NONE)                                           \
         {                                                                                          \
             Ptr<ApplicationStats##id##Helper> stat = CreateObject<ApplicationStats##id##Helper>(); \
-            stat->SetName(m_name + "-average-sender-" + name + GetOutputTypeSuffix(type));         \
+            stat->SetName(m_prefix + "-average-sender-" + name + GetOutputTypeSuffix(type));       \
             stat->SetTraceSourceName(m_traceSourceName);                                           \
             stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_SENDER);                    \
             stat->SetOutputType(type);                                                             \
             stat->SetAveragingMode(true);                                                          \
             stat->SetSenderInformation(m_senderInfo);                                              \
             stat->SetReceiverInformation(m_receiverInfo);                                          \
+            stat->SetSteadyStateDetection(m_steadyStateDetection);                                 \
             stat->Install();                                                                       \
             m_stats.push_back(stat);                                                               \
+            TrackSteadyState(stat);                                                                \
         }                                                                                          \
     }
 
@@ -299,6 +523,12 @@ APPLICATION_STATS_METHOD_DEFINITION(Delay, "delay")
 
 // APPLICATION_STATS_AVERAGE_METHOD_DEFINITION (Delay, "delay")
 
+// Jitter statistics.
+APPLICATION_STATS_METHOD_DEFINITION(Jitter, "jitter")
+
+// Frame delay statistics.
+APPLICATION_STATS_METHOD_DEFINITION(FrameDelay, "frame-delay")
+
 std::string // static
 ApplicationStatsHelperContainer::GetOutputTypeSuffix(
     ApplicationStatsHelper::OutputType_t outputType)
@@ -314,6 +544,7 @@ ApplicationStatsHelperContainer::GetOutputTypeSuffix(
 
     case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
     case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
         return "-scatter";
 
     case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
@@ -328,6 +559,9 @@ ApplicationStatsHelperContainer::GetOutputTypeSuffix(
     case ApplicationStatsHelper::OUTPUT_CDF_PLOT:
         return "-cdf";
 
+    case ApplicationStatsHelper::OUTPUT_SUMMARY:
+        return "-summary";
+
     default:
         NS_FATAL_ERROR("ApplicationStatsHelperContainer - Invalid output type");
         break;
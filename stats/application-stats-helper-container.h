@@ -24,9 +24,12 @@
 
 #include <ns3/application-container.h>
 #include <ns3/application-stats-helper.h>
+#include <ns3/event-id.h>
 #include <ns3/node-container.h>
+#include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
+#include <ns3/traced-callback.h>
 
 #include <list>
 #include <map>
@@ -41,6 +44,8 @@ namespace ns3
  *
  * - Add [Global,PerReceiver,PerSender] Throughput
  * - Add [Global,PerReceiver,PerSender] Delay
+ * - Add [Global,PerReceiver,PerSender] Jitter
+ * - Add [Global,PerReceiver,PerSender] FrameDelay
  *
  * Also check the Doxygen documentation of this class for more information.
  */
@@ -79,6 +84,17 @@ namespace ns3
  * which will produce output files with the names such as
  * `stat-per-receiver-throughput-scalar.txt`,
  * `stat-per-receiver-delay-cdf-receiver-1.txt`, etc.
+ *
+ * If the `SteadyStateDetection` attribute is enabled, every statistic with
+ * `SUMMARY` output type added afterwards also tracks the warm-up truncation
+ * point and the confidence interval of the steady-state mean of each of its
+ * identifiers (see ApplicationStatsSteadyState). Every
+ * `SteadyStateCheckInterval`, the container checks whether all of them have
+ * at least `SteadyStateMinSamples` samples after the truncation point and a
+ * relative precision within `TargetRelativePrecision`. Once they do, the
+ * `SteadyStateReached` trace source is fired and, if `StopOnSteadyState` is
+ * enabled, the simulation is stopped. The summary files still cover all
+ * samples, including the warm-up period.
  */
 class ApplicationStatsHelperContainer : public Object
 {
@@ -126,6 +142,54 @@ class ApplicationStatsHelperContainer : public Object
      */
     std::string GetTraceSourceName() const;
 
+    /**
+     * \param perRankOutput if true, the system ID of this process, i.e., the
+     *                      rank in the distributed simulator, is appended to
+     *                      the name, so that the output files of different
+     *                      processes do not overwrite each other.
+     *
+     * The output file names become e.g. `stat-rank-1-global-delay-summary.txt`.
+     * The summary files of all ranks may be combined afterwards using
+     * ApplicationStatsHelper::MergeSummaryFiles(). Like SetName(), it only
+     * affects the statistics added afterwards.
+     */
+    void SetPerRankOutput(bool perRankOutput);
+
+    /**
+     * \return true if the system ID is appended to the name.
+     */
+    bool GetPerRankOutput() const;
+
+    /**
+     * \param steadyStateDetection if true, the statistics with `SUMMARY` output
+     *                             type which are added afterwards are tracked
+     *                             until they reach the target relative
+     *                             precision.
+     */
+    void SetSteadyStateDetection(bool steadyStateDetection);
+
+    /**
+     * \return true if the statistics added afterwards are tracked.
+     */
+    bool GetSteadyStateDetection() const;
+
+    /**
+     * \return true if every tracked statistic has reached the target relative
+     *         precision.
+     */
+    bool IsSteadyStateReached() const;
+
+    /**
+     * \return the number of statistics added to this container.
+     */
+    uint32_t GetNumOfStats() const;
+
+    /**
+     * \param index index of the statistic, in the order they were added.
+     * \return the statistic.
+     */
+    Ptr<const ApplicationStatsHelper> GetStats(uint32_t index) const;
+
     // Throughput statistics.
     APPLICATION_STATS_METHOD_DECLARATION(Throughput)
     void AddAverageSenderThroughput(ApplicationStatsHelper::OutputType_t outputType);
@@ -136,6 +200,12 @@ class ApplicationStatsHelperContainer : public Object
     //  void AddAverageSenderDelay (ApplicationStatsHelper::OutputType_t outputType);
     //  void AddAverageReceiverDelay (ApplicationStatsHelper::OutputType_t outputType);
 
+    // Jitter statistics.
+    APPLICATION_STATS_METHOD_DECLARATION(Jitter)
+
+    // Frame delay statistics, always from the `RxFrameStats` trace source.
+    APPLICATION_STATS_METHOD_DECLARATION(FrameDelay)
+
     /**
      * \param outputType an arbitrary output type.
      * \return a string suffix to be appended at the end of the corresponding
@@ -230,9 +300,28 @@ class ApplicationStatsHelperContainer : public Object
     virtual void DoDispose();
 
   private:
-    /// Prefix of every ApplicationStatsHelper instance names and every output file.
+    /**
+     * \brief Start tracking the steady state of a newly installed statistic.
+     * \param stat the statistic, configured with the current steady-state
+     *             detection setting before it was installed.
+     */
+    void TrackSteadyState(Ptr<const ApplicationStatsHelper> stat);
+
+    /**
+     * \brief Check whether every tracked statistic has reached the target
+     *        relative precision, and schedule the next check if not.
+     */
+    void CheckSteadyState();
+
+    /// Name given by SetName().
     std::string m_name;
 
+    /// Whether the system ID is appended to #m_name in #m_prefix.
+    bool m_perRankOutput;
+
+    /// Prefix of every ApplicationStatsHelper instance names and every output file.
+    std::string m_prefix;
+
     /// The name of the application's trace source which produce the required information.
     std::string m_traceSourceName;
 
@@ -245,6 +334,17 @@ class ApplicationStatsHelperContainer : public Object
     /// Internal map of receiver applications, indexed by their names.
     std::map<std::string, ApplicationContainer> m_receiverInfo;
 
+    bool m_steadyStateDetection;       ///< `SteadyStateDetection` attribute.
+    double m_targetRelativePrecision;  ///< `TargetRelativePrecision` attribute.
+    uint32_t m_steadyStateMinSamples;  ///< `SteadyStateMinSamples` attribute.
+    Time m_steadyStateCheckInterval;   ///< `SteadyStateCheckInterval` attribute.
+    bool m_stopOnSteadyState;          ///< `StopOnSteadyState` attribute.
+    bool m_isSteadyStateReached;       ///< True after the target precision is reached.
+    EventId m_steadyStateCheckEvent;   ///< The next steady-state check.
+
+    /// `SteadyStateReached` trace source, fired with the current time.
+    TracedCallback<Time> m_steadyStateTrace;
+
 }; // end of class ApplicationStatsHelperContainer
 
 } // end of namespace ns3
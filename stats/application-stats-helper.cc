@@ -21,13 +21,24 @@
 
 #include "application-stats-helper.h"
 
+#include <ns3/abort.h>
 #include <ns3/address.h>
+#include <ns3/boolean.h>
 #include <ns3/data-collection-object.h>
 #include <ns3/enum.h>
+#include <ns3/gnuplot-aggregator.h>
 #include <ns3/log.h>
+#include <ns3/multi-file-aggregator.h>
+#include <ns3/nstime.h>
 #include <ns3/object-factory.h>
 #include <ns3/string.h>
+#include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ApplicationStatsHelper");
@@ -85,6 +96,10 @@ ApplicationStatsHelper::GetOutputTypeName(ApplicationStatsHelper::OutputType_t o
         return "OUTPUT_PDF_PLOT";
     case ApplicationStatsHelper::OUTPUT_CDF_PLOT:
         return "OUTPUT_CDF_PLOT";
+    case ApplicationStatsHelper::OUTPUT_SUMMARY:
+        return "OUTPUT_SUMMARY";
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
+        return "OUTPUT_SCATTER_BINARY_FILE";
     default:
         NS_FATAL_ERROR("ApplicationStatsHelper - Invalid output type");
         break;
@@ -99,7 +114,15 @@ ApplicationStatsHelper::ApplicationStatsHelper()
       m_identifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL),
       m_outputType(ApplicationStatsHelper::OUTPUT_SCATTER_FILE),
       m_traceSourceName(""),
-      m_isInstalled(false)
+      m_isInstalled(false),
+      m_boundTraceSinks(true),
+      m_inlinePipelines(false),
+      m_asyncOutput(false),
+      m_scatterDecimation(1),
+      m_scatterReservoirSize(0),
+      m_slidingWindowLength(Seconds(0)),
+      m_slidingStep(Seconds(1)),
+      m_steadyStateDetection(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -163,10 +186,126 @@ ApplicationStatsHelper::GetTypeId()
                                           ApplicationStatsHelper::OUTPUT_PDF_PLOT,
                                           "PDF_PLOT",
                                           ApplicationStatsHelper::OUTPUT_CDF_PLOT,
-                                          "CDF_PLOT"));
+                                          "CDF_PLOT",
+                                          ApplicationStatsHelper::OUTPUT_SUMMARY,
+                                          "SUMMARY",
+                                          ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE,
+                                          "SCATTER_BINARY_FILE"))
+            .AddAttribute("BoundTraceSinks",
+                          "If true, every receiver application is connected to its own "
+                          "trace sink which is bound to its identifier in advance, "
+                          "instead of a probe. Only affects GLOBAL and RECEIVER "
+                          "identifier types.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&ApplicationStatsHelper::SetBoundTraceSinks,
+                                              &ApplicationStatsHelper::GetBoundTraceSinks),
+                          MakeBooleanChecker())
+            .AddAttribute("InlinePipelines",
+                          "If true, the statistics which have a specialized pipeline for "
+                          "the current output type, e.g., the SCALAR_FILE output of "
+                          "packet delay or the SCATTER_FILE output of throughput, keep "
+                          "their state inline instead of in probes and collectors. Only "
+                          "affects GLOBAL and RECEIVER identifier types, without scatter "
+                          "sampling and sliding window.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsHelper::SetInlinePipelines,
+                                              &ApplicationStatsHelper::GetInlinePipelines),
+                          MakeBooleanChecker())
+            .AddAttribute("AsyncOutput",
+                          "If true, the SCATTER_BINARY_FILE output type hands its blocks "
+                          "over to a background I/O thread through a lock-free queue, so "
+                          "that slow file systems do not stall the simulation. The file "
+                          "is completely written when the helper is disposed.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsHelper::SetAsyncOutput,
+                                              &ApplicationStatsHelper::GetAsyncOutput),
+                          MakeBooleanChecker())
+            .AddAttribute("ScatterDecimation",
+                          "Keep only the first sample out of every this many samples "
+                          "of each identifier. Only affects SCATTER_FILE, SCATTER_PLOT, "
+                          "and SCATTER_BINARY_FILE output types. The default value of 1 "
+                          "keeps all samples.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ApplicationStatsHelper::SetScatterDecimation,
+                                               &ApplicationStatsHelper::GetScatterDecimation),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ScatterReservoirSize",
+                          "If greater than zero, write at most this many samples of each "
+                          "identifier, chosen uniformly at random among the samples "
+                          "surviving the decimation, at the end of the simulation. Only "
+                          "affects SCATTER_FILE, SCATTER_PLOT, and SCATTER_BINARY_FILE "
+                          "output types.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ApplicationStatsHelper::SetScatterReservoirSize,
+                                               &ApplicationStatsHelper::GetScatterReservoirSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SlidingWindow",
+                          "If positive, the scatter output consists of estimates over a "
+                          "sliding window of this length, produced every SlidingStep, "
+                          "i.e., the throughput or the mean of the samples within the "
+                          "window. Only affects SCATTER_FILE, SCATTER_PLOT, and "
+                          "SCATTER_BINARY_FILE output types.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ApplicationStatsHelper::SetSlidingWindow,
+                                           &ApplicationStatsHelper::GetSlidingWindow),
+                          MakeTimeChecker())
+            .AddAttribute("SlidingStep",
+                          "Interval between two estimates of the sliding window. The "
+                          "memory used per identifier is proportional to "
+                          "SlidingWindow / SlidingStep.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&ApplicationStatsHelper::SetSlidingStep,
+                                           &ApplicationStatsHelper::GetSlidingStep),
+                          MakeTimeChecker());
     return tid;
 }
 
+void
+ApplicationStatsHelper::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_isInstalled && (m_outputType == ApplicationStatsHelper::OUTPUT_SUMMARY))
+    {
+        WriteSummaryFile();
+    }
+
+    if (m_slidingWindow != nullptr)
+    {
+        m_slidingWindow->Stop();
+        m_slidingWindow = nullptr;
+    }
+
+    if (m_inlinePipeline != nullptr)
+    {
+        // Write the remaining state before the aggregators are closed.
+        m_inlinePipeline->Flush();
+        m_inlinePipeline = nullptr;
+    }
+
+    if (m_scatterSampler != nullptr)
+    {
+        // Write the reservoirs before the aggregators and the binary writer are closed.
+        m_scatterSampler->Flush();
+        m_scatterSampler = nullptr;
+    }
+
+    m_scatterFileAggregator = nullptr;
+    m_scatterPlotAggregator = nullptr;
+    m_scatterNames.clear();
+
+    if (m_binaryWriter != nullptr)
+    {
+        m_binaryWriter->Close();
+        m_binaryWriter = nullptr;
+    }
+
+    m_summaries.clear();
+    m_summaryNames.clear();
+    m_steadyStates.clear();
+    Object::DoDispose(); // chain up
+}
+
 void
 ApplicationStatsHelper::SetSenderInformation(std::map<std::string, ApplicationContainer> info)
 {
@@ -282,6 +421,228 @@ ApplicationStatsHelper::GetOutputType() const
     return m_outputType;
 }
 
+void
+ApplicationStatsHelper::SetBoundTraceSinks(bool boundTraceSinks)
+{
+    NS_LOG_FUNCTION(this << boundTraceSinks);
+
+    if (m_isInstalled && (m_boundTraceSinks != boundTraceSinks))
+    {
+        NS_LOG_WARN(this << " cannot modify the current trace sink mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_boundTraceSinks = boundTraceSinks;
+    }
+}
+
+bool
+ApplicationStatsHelper::GetBoundTraceSinks() const
+{
+    return m_boundTraceSinks;
+}
+
+void
+ApplicationStatsHelper::SetInlinePipelines(bool inlinePipelines)
+{
+    NS_LOG_FUNCTION(this << inlinePipelines);
+
+    if (m_isInstalled && (m_inlinePipelines != inlinePipelines))
+    {
+        NS_LOG_WARN(this << " cannot modify the current pipeline mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_inlinePipelines = inlinePipelines;
+    }
+}
+
+bool
+ApplicationStatsHelper::GetInlinePipelines() const
+{
+    return m_inlinePipelines;
+}
+
+void
+ApplicationStatsHelper::SetAsyncOutput(bool asyncOutput)
+{
+    NS_LOG_FUNCTION(this << asyncOutput);
+
+    if (m_isInstalled && (m_asyncOutput != asyncOutput))
+    {
+        NS_LOG_WARN(this << " cannot modify the current output mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_asyncOutput = asyncOutput;
+    }
+}
+
+bool
+ApplicationStatsHelper::GetAsyncOutput() const
+{
+    return m_asyncOutput;
+}
+
+void
+ApplicationStatsHelper::SetScatterDecimation(uint32_t scatterDecimation)
+{
+    NS_LOG_FUNCTION(this << scatterDecimation);
+    NS_ABORT_MSG_IF(scatterDecimation == 0, "Decimation factor must be greater than zero");
+
+    if (m_isInstalled && (m_scatterDecimation != scatterDecimation))
+    {
+        NS_LOG_WARN(this << " cannot modify the current decimation factor"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_scatterDecimation = scatterDecimation;
+    }
+}
+
+uint32_t
+ApplicationStatsHelper::GetScatterDecimation() const
+{
+    return m_scatterDecimation;
+}
+
+void
+ApplicationStatsHelper::SetScatterReservoirSize(uint32_t scatterReservoirSize)
+{
+    NS_LOG_FUNCTION(this << scatterReservoirSize);
+
+    if (m_isInstalled && (m_scatterReservoirSize != scatterReservoirSize))
+    {
+        NS_LOG_WARN(this << " cannot modify the current reservoir size"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_scatterReservoirSize = scatterReservoirSize;
+    }
+}
+
+uint32_t
+ApplicationStatsHelper::GetScatterReservoirSize() const
+{
+    return m_scatterReservoirSize;
+}
+
+void
+ApplicationStatsHelper::SetSlidingWindow(Time slidingWindow)
+{
+    NS_LOG_FUNCTION(this << slidingWindow.GetSeconds());
+
+    if (m_isInstalled && (m_slidingWindowLength != slidingWindow))
+    {
+        NS_LOG_WARN(this << " cannot modify the current sliding window"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_slidingWindowLength = slidingWindow;
+    }
+}
+
+Time
+ApplicationStatsHelper::GetSlidingWindow() const
+{
+    return m_slidingWindowLength;
+}
+
+void
+ApplicationStatsHelper::SetSlidingStep(Time slidingStep)
+{
+    NS_LOG_FUNCTION(this << slidingStep.GetSeconds());
+    NS_ABORT_MSG_UNLESS(slidingStep.IsStrictlyPositive(), "Sliding step must be positive");
+
+    if (m_isInstalled && (m_slidingStep != slidingStep))
+    {
+        NS_LOG_WARN(this << " cannot modify the current sliding step"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_slidingStep = slidingStep;
+    }
+}
+
+Time
+ApplicationStatsHelper::GetSlidingStep() const
+{
+    return m_slidingStep;
+}
+
+void
+ApplicationStatsHelper::SetSteadyStateDetection(bool steadyStateDetection)
+{
+    NS_LOG_FUNCTION(this << steadyStateDetection);
+
+    if (m_isInstalled && (m_steadyStateDetection != steadyStateDetection))
+    {
+        NS_LOG_WARN(this << " cannot modify the current steady-state detection"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_steadyStateDetection = steadyStateDetection;
+    }
+}
+
+bool
+ApplicationStatsHelper::GetSteadyStateDetection() const
+{
+    return m_steadyStateDetection;
+}
+
+uint32_t
+ApplicationStatsHelper::GetNumOfSteadyStates() const
+{
+    return m_steadyStates.size();
+}
+
+const ApplicationStatsSteadyState&
+ApplicationStatsHelper::GetSteadyState(uint32_t identifier) const
+{
+    NS_ASSERT_MSG(identifier < m_steadyStates.size(),
+                  "Unable to find steady-state estimator with identifier " << identifier);
+    return m_steadyStates[identifier];
+}
+
+std::string
+ApplicationStatsHelper::GetSteadyStateName(uint32_t identifier) const
+{
+    NS_ASSERT_MSG(identifier < m_steadyStates.size(),
+                  "Unable to find steady-state estimator with identifier " << identifier);
+    return m_summaryNames[identifier];
+}
+
+uint32_t
+ApplicationStatsHelper::GetNumOfSummaries() const
+{
+    return m_summaries.size();
+}
+
+const ApplicationStatsSummary&
+ApplicationStatsHelper::GetSummary(uint32_t identifier) const
+{
+    NS_ASSERT_MSG(identifier < m_summaries.size(),
+                  "Unable to find summary with identifier " << identifier);
+    return m_summaries[identifier];
+}
+
+std::string
+ApplicationStatsHelper::GetSummaryName(uint32_t identifier) const
+{
+    NS_ASSERT_MSG(identifier < m_summaries.size(),
+                  "Unable to find summary with identifier " << identifier);
+    return m_summaryNames[identifier];
+}
+
 bool
 ApplicationStatsHelper::IsInstalled() const
 {
@@ -364,4 +725,397 @@ ApplicationStatsHelper::CreateCollectorPerIdentifier(CollectorMap& collectorMap)
 
 } // end of `uint32_t CreateCollectorPerIdentifier (CollectorMap &);`
 
+uint32_t
+ApplicationStatsHelper::CreateSummaryPerIdentifier(std::string heading)
+{
+    NS_LOG_FUNCTION(this << heading);
+
+    m_summaryNames = GetIdentifierNames();
+    m_summaryHeading = heading;
+    m_summaries.clear();
+    m_summaries.resize(m_summaryNames.size());
+    m_steadyStates.clear();
+    if (m_steadyStateDetection)
+    {
+        m_steadyStates.resize(m_summaryNames.size());
+    }
+    NS_LOG_INFO(this << " created " << m_summaries.size() << " instance(s)"
+                     << " of summary for " << GetIdentifierTypeName(GetIdentifierType()));
+
+    return m_summaries.size();
+
+} // end of `uint32_t CreateSummaryPerIdentifier (std::string);`
+
+void
+ApplicationStatsHelper::WriteSummaryFile() const
+{
+    NS_LOG_FUNCTION(this);
+
+    const std::string fileName = GetName() + ".txt";
+    std::ofstream ofs(fileName.c_str());
+
+    if (!ofs.is_open())
+    {
+        NS_LOG_WARN(this << " unable to open file " << fileName);
+        return;
+    }
+
+    // Full precision, so that MergeSummaryFiles() can combine the moments.
+    ofs << std::setprecision(std::numeric_limits<double>::max_digits10);
+    ofs << m_summaryHeading << " count mean stddev min max p50 p95 p99\n";
+    NS_ASSERT(m_summaries.size() == m_summaryNames.size());
+
+    for (uint32_t i = 0; i < m_summaries.size(); i++)
+    {
+        const ApplicationStatsSummary& summary = m_summaries[i];
+        ofs << m_summaryNames[i] << " " << summary.GetCount() << " " << summary.GetMean() << " "
+            << summary.GetStdDev() << " " << summary.GetMin() << " " << summary.GetMax() << " "
+            << summary.GetP50() << " " << summary.GetP95() << " " << summary.GetP99() << "\n";
+    }
+
+    NS_LOG_INFO(this << " written " << m_summaries.size() << " summaries into " << fileName);
+
+} // end of `void WriteSummaryFile () const`
+
+void // static
+ApplicationStatsHelper::MergeSummaryFiles(const std::vector<std::string>& inputFileNames,
+                                          const std::string& outputFileName)
+{
+    NS_LOG_FUNCTION(inputFileNames.size() << outputFileName);
+
+    /// Combined row of one identifier.
+    struct Row
+    {
+        uint64_t count;
+        double mean;
+        double m2; // sum of squared differences from the mean
+        double min;
+        double max;
+        double p50;
+        double p95;
+        double p99;
+    };
+
+    std::string heading;
+    std::vector<std::string> names; // in the order of first appearance
+    std::map<std::string, Row> rows;
+
+    for (std::vector<std::string>::const_iterator it = inputFileNames.begin();
+         it != inputFileNames.end();
+         ++it)
+    {
+        std::ifstream ifs(it->c_str());
+        NS_ABORT_MSG_UNLESS(ifs.is_open(), "Unable to open file " << *it);
+
+        std::string line;
+        if (!std::getline(ifs, line))
+        {
+            continue; // empty file
+        }
+        if (heading.empty())
+        {
+            heading = line;
+        }
+
+        while (std::getline(ifs, line))
+        {
+            std::istringstream iss(line);
+            std::string name;
+            Row b;
+            double stddev;
+            if (!(iss >> name >> b.count >> b.mean >> stddev >> b.min >> b.max >> b.p50 >> b.p95 >>
+                  b.p99))
+            {
+                NS_LOG_WARN("Ignoring malformed line \"" << line << "\" in " << *it);
+                continue;
+            }
+            b.m2 = (b.count > 1) ? stddev * stddev * (b.count - 1) : 0.0;
+
+            std::map<std::string, Row>::iterator it2 = rows.find(name);
+            if (it2 == rows.end())
+            {
+                names.push_back(name);
+                rows[name] = b;
+                continue;
+            }
+
+            Row& a = it2->second;
+            if (b.count == 0)
+            {
+                continue;
+            }
+            if (a.count == 0)
+            {
+                a = b;
+                continue;
+            }
+
+            // Combine the moments as in Chan et al.'s parallel algorithm.
+            const double n = a.count + b.count;
+            const double wa = a.count / n;
+            const double wb = b.count / n;
+            const double delta = b.mean - a.mean;
+            a.m2 += b.m2 + delta * delta * a.count * wb;
+            a.mean += delta * wb;
+            a.min = std::min(a.min, b.min);
+            a.max = std::max(a.max, b.max);
+            a.p50 = wa * a.p50 + wb * b.p50;
+            a.p95 = wa * a.p95 + wb * b.p95;
+            a.p99 = wa * a.p99 + wb * b.p99;
+            a.count += b.count;
+        }
+    }
+
+    std::ofstream ofs(outputFileName.c_str());
+    NS_ABORT_MSG_UNLESS(ofs.is_open(), "Unable to open file " << outputFileName);
+    ofs << std::setprecision(std::numeric_limits<double>::max_digits10);
+    ofs << heading << "\n";
+
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+    {
+        const Row& row = rows[*it];
+        const double stddev = (row.count > 1) ? std::sqrt(row.m2 / (row.count - 1)) : 0.0;
+        ofs << *it << " " << row.count << " " << row.mean << " " << stddev << " " << row.min << " "
+            << row.max << " " << row.p50 << " " << row.p95 << " " << row.p99 << "\n";
+    }
+
+    NS_LOG_INFO("Merged " << inputFileNames.size() << " files into " << outputFileName);
+
+} // end of `void MergeSummaryFiles (const std::vector<std::string> &, const std::string &)`
+
+uint32_t
+ApplicationStatsHelper::CreateBinaryWriter(std::string timeColumnName,
+                                           std::string valueColumnName)
+{
+    NS_LOG_FUNCTION(this << timeColumnName << valueColumnName);
+
+    const std::vector<std::string> names = GetIdentifierNames();
+    m_binaryWriter = Create<ApplicationStatsBinaryWriter>(GetName() + ".bin",
+                                                          timeColumnName,
+                                                          valueColumnName,
+                                                          names,
+                                                          256,
+                                                          m_asyncOutput);
+    NS_LOG_INFO(this << " created " << (m_asyncOutput ? "asynchronous " : "")
+                     << "binary writer with " << names.size() << " identifier(s)"
+                     << " for " << GetIdentifierTypeName(GetIdentifierType()));
+
+    return names.size();
+}
+
+void
+ApplicationStatsHelper::ConnectCollectorsToBinaryWriter(CollectorMap& collectorMap,
+                                                        std::string traceSourceName) const
+{
+    NS_LOG_FUNCTION(this << traceSourceName);
+    NS_ASSERT_MSG(m_binaryWriter != nullptr, "CreateBinaryWriter() must be called beforehand");
+
+    for (CollectorMap::Iterator it = collectorMap.Begin(); it != collectorMap.End(); ++it)
+    {
+        [[maybe_unused]] const bool ret =
+            it->second->TraceConnectWithoutContext(traceSourceName,
+                                                   m_binaryWriter->GetSink(it->first));
+        NS_ASSERT_MSG(ret,
+                      "Error connecting trace source " << traceSourceName << " of collector "
+                                                       << it->first << " to the binary writer");
+    }
+}
+
+bool
+ApplicationStatsHelper::IsScatterSampling() const
+{
+    switch (m_outputType)
+    {
+    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+    case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
+        return (m_scatterDecimation > 1) || (m_scatterReservoirSize > 0);
+    default:
+        return false;
+    }
+}
+
+void
+ApplicationStatsHelper::CreateScatterSampler(Ptr<DataCollectionObject> aggregator)
+{
+    NS_LOG_FUNCTION(this << aggregator);
+
+    switch (m_outputType)
+    {
+    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+        m_scatterFileAggregator = DynamicCast<MultiFileAggregator>(aggregator);
+        NS_ASSERT(m_scatterFileAggregator != nullptr);
+        break;
+    case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
+        m_scatterPlotAggregator = DynamicCast<GnuplotAggregator>(aggregator);
+        NS_ASSERT(m_scatterPlotAggregator != nullptr);
+        break;
+    default:
+        NS_ASSERT_MSG(m_binaryWriter != nullptr, "CreateBinaryWriter() must be called beforehand");
+        break;
+    }
+
+    m_scatterNames = GetIdentifierNames();
+    m_scatterSampler = Create<ApplicationStatsScatterSampler>(
+        m_scatterNames.size(),
+        m_scatterDecimation,
+        m_scatterReservoirSize,
+        MakeCallback(&ApplicationStatsHelper::WriteScatterSample, this));
+    NS_LOG_INFO(this << " created scatter sampler with " << m_scatterNames.size()
+                     << " identifier(s), decimation " << m_scatterDecimation
+                     << ", and reservoir size " << m_scatterReservoirSize);
+}
+
+void
+ApplicationStatsHelper::ConnectCollectorsToScatterSampler(CollectorMap& collectorMap,
+                                                          std::string traceSourceName) const
+{
+    NS_LOG_FUNCTION(this << traceSourceName);
+    NS_ASSERT_MSG(m_scatterSampler != nullptr,
+                  "CreateScatterSampler() must be called beforehand");
+
+    for (CollectorMap::Iterator it = collectorMap.Begin(); it != collectorMap.End(); ++it)
+    {
+        [[maybe_unused]] const bool ret =
+            it->second->TraceConnectWithoutContext(traceSourceName,
+                                                   m_scatterSampler->GetSink(it->first));
+        NS_ASSERT_MSG(ret,
+                      "Error connecting trace source " << traceSourceName << " of collector "
+                                                       << it->first << " to the scatter sampler");
+    }
+}
+
+bool
+ApplicationStatsHelper::IsSlidingWindow() const
+{
+    switch (m_outputType)
+    {
+    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+    case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT:
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
+        return m_slidingWindowLength.IsStrictlyPositive();
+    default:
+        return false;
+    }
+}
+
+void
+ApplicationStatsHelper::CreateSlidingWindow(ApplicationStatsSlidingWindow::OutputType_t outputType,
+                                            double scale)
+{
+    NS_LOG_FUNCTION(this << outputType << scale);
+    NS_ASSERT(IsSlidingWindow());
+    NS_ASSERT_MSG(m_scatterSampler != nullptr,
+                  "CreateScatterSampler() must be called beforehand");
+
+    m_slidingWindow = Create<ApplicationStatsSlidingWindow>(
+        m_scatterNames.size(),
+        m_slidingWindowLength,
+        m_slidingStep,
+        outputType,
+        scale,
+        MakeCallback(&ApplicationStatsScatterSampler::Write, m_scatterSampler));
+    m_slidingWindow->Start();
+    NS_LOG_INFO(this << " created sliding window of " << m_slidingWindowLength.GetSeconds()
+                     << " seconds with " << m_slidingWindow->GetNumOfBuckets() << " buckets");
+}
+
+bool
+ApplicationStatsHelper::IsInlinePipeline() const
+{
+    return m_inlinePipelines &&
+           ((m_identifierType == ApplicationStatsHelper::IDENTIFIER_GLOBAL) ||
+            (m_identifierType == ApplicationStatsHelper::IDENTIFIER_RECEIVER)) &&
+           !IsScatterSampling() && !IsSlidingWindow();
+}
+
+ApplicationStatsInlinePipelineBase::OutputCallback
+ApplicationStatsHelper::CreateInlineOutput(Ptr<DataCollectionObject> aggregator)
+{
+    NS_LOG_FUNCTION(this << aggregator);
+
+    m_scatterFileAggregator = DynamicCast<MultiFileAggregator>(aggregator);
+    NS_ASSERT(m_scatterFileAggregator != nullptr);
+    m_scatterNames = GetIdentifierNames();
+
+    switch (m_outputType)
+    {
+    case ApplicationStatsHelper::OUTPUT_SCALAR_FILE:
+        return MakeCallback(&ApplicationStatsHelper::WriteScalarSample, this);
+    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+        return MakeCallback(&ApplicationStatsHelper::WriteScatterSample, this);
+    default:
+        NS_FATAL_ERROR(GetOutputTypeName(m_outputType)
+                       << " is not a valid output type for inline pipelines.");
+        break;
+    }
+
+    return MakeNullCallback<void, uint32_t, double, double>();
+}
+
+void
+ApplicationStatsHelper::WriteScalarSample(uint32_t identifier, double time, double value)
+{
+    NS_ASSERT(identifier < m_scatterNames.size());
+    NS_ASSERT(m_scatterFileAggregator != nullptr);
+    m_scatterFileAggregator->Write1d(m_scatterNames[identifier], value);
+}
+
+void
+ApplicationStatsHelper::WriteScatterSample(uint32_t identifier, double time, double value)
+{
+    NS_ASSERT(identifier < m_scatterNames.size());
+
+    if (m_scatterFileAggregator != nullptr)
+    {
+        m_scatterFileAggregator->Write2d(m_scatterNames[identifier], time, value);
+    }
+    else if (m_scatterPlotAggregator != nullptr)
+    {
+        m_scatterPlotAggregator->Write2d(m_scatterNames[identifier], time, value);
+    }
+    else if (m_binaryWriter != nullptr)
+    {
+        m_binaryWriter->Write(identifier, time, value);
+    }
+}
+
+std::vector<std::string>
+ApplicationStatsHelper::GetIdentifierNames() const
+{
+    std::vector<std::string> names;
+
+    switch (GetIdentifierType())
+    {
+    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
+        names.push_back("global");
+        break;
+
+    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
+        std::map<std::string, ApplicationContainer>::const_iterator it;
+        for (it = m_receiverInfo.begin(); it != m_receiverInfo.end(); ++it)
+        {
+            names.push_back(it->first);
+        }
+        break;
+    }
+
+    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
+        std::map<std::string, ApplicationContainer>::const_iterator it;
+        for (it = m_senderInfo.begin(); it != m_senderInfo.end(); ++it)
+        {
+            names.push_back(it->first);
+        }
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("ApplicationStatsHelper - Invalid identifier type");
+        break;
+    }
+
+    return names;
+
+} // end of `std::vector<std::string> GetIdentifierNames () const`
+
 } // end of namespace ns3
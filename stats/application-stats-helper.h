@@ -23,21 +23,31 @@
 #define APPLICATION_STATS_HELPER_H
 
 #include <ns3/application-container.h>
+#include <ns3/application-stats-binary-writer.h>
+#include <ns3/application-stats-inline-pipeline.h>
+#include <ns3/application-stats-scatter-sampler.h>
+#include <ns3/application-stats-sliding-window.h>
+#include <ns3/application-stats-steady-state.h>
+#include <ns3/application-stats-summary.h>
 #include <ns3/callback.h>
 #include <ns3/collector-map.h>
 #include <ns3/object.h>
 #include <ns3/probe.h>
 #include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
 #include <ns3/type-id.h>
 
 #include <list>
 #include <map>
+#include <vector>
 
 namespace ns3
 {
 
 class DataCollectionObject;
 class Address;
+class GnuplotAggregator;
+class MultiFileAggregator;
 
 /**
  * \ingroup traffic
@@ -131,6 +141,8 @@ class ApplicationStatsHelper : public Object
         OUTPUT_HISTOGRAM_PLOT,
         OUTPUT_PDF_PLOT, // probability distribution function
         OUTPUT_CDF_PLOT, // cumulative distribution function
+        OUTPUT_SUMMARY,  // summary statistics, computed in memory
+        OUTPUT_SCATTER_BINARY_FILE, // binary, column-oriented scatter file
     } OutputType_t;
 
     /**
@@ -139,6 +151,24 @@ class ApplicationStatsHelper : public Object
      */
     static std::string GetOutputTypeName(OutputType_t outputType);
 
+    /**
+     * \brief Combine several files written with `OUTPUT_SUMMARY` output type
+     *        into a single file of the same format.
+     * \param inputFileNames names of the files to be read, e.g., the files
+     *                       written by every rank of a distributed simulation
+     *                       (see ApplicationStatsHelperContainer::SetPerRankOutput()).
+     * \param outputFileName name of the file to be written.
+     *
+     * Rows with the same identifier are combined into one row. The count, the
+     * mean, the standard deviation, the minimum, and the maximum are combined
+     * exactly up to floating point rounding, since the summary files are written
+     * with the full precision of `double`. The percentiles are averaged with the
+     * counts as weights, which is only an approximation of the percentiles of
+     * all samples.
+     */
+    static void MergeSummaryFiles(const std::vector<std::string>& inputFileNames,
+                                  const std::string& outputFileName);
+
     // CONSTRUCTOR AND DESTRUCTOR ///////////////////////////////////////////////
 
     /// Creates a new helper instance.
@@ -231,12 +261,159 @@ class ApplicationStatsHelper : public Object
      */
     OutputType_t GetOutputType() const;
 
+    /**
+     * \param boundTraceSinks if true, receiver applications are connected to
+     *                        trace sinks which are bound to their identifiers,
+     *                        instead of probes.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetBoundTraceSinks(bool boundTraceSinks);
+
+    /**
+     * \return true if receiver applications are connected to bound trace sinks
+     *         instead of probes.
+     */
+    bool GetBoundTraceSinks() const;
+
+    /**
+     * \param inlinePipelines if true, the combinations of identifier type and
+     *                        output type which have a specialized
+     *                        ApplicationStatsInlinePipeline use it instead of
+     *                        probes and collectors.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetInlinePipelines(bool inlinePipelines);
+
+    /**
+     * \return true if specialized inline pipelines are used where available.
+     */
+    bool GetInlinePipelines() const;
+
+    /**
+     * \param asyncOutput if true, the SCATTER_BINARY_FILE output type writes
+     *                    its file in a background I/O thread.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetAsyncOutput(bool asyncOutput);
+
+    /**
+     * \return true if binary output files are written in a background thread.
+     */
+    bool GetAsyncOutput() const;
+
+    /**
+     * \param scatterDecimation keep only one sample out of this many in scatter
+     *                          output types, or 1 to keep all samples.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetScatterDecimation(uint32_t scatterDecimation);
+
+    /**
+     * \return the number of samples out of which one is kept in scatter output
+     *         types.
+     */
+    uint32_t GetScatterDecimation() const;
+
+    /**
+     * \param scatterReservoirSize maximum number of samples written per
+     *                             identifier in scatter output types, chosen
+     *                             uniformly at random, or 0 to disable
+     *                             reservoir sampling.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetScatterReservoirSize(uint32_t scatterReservoirSize);
+
+    /**
+     * \return the maximum number of samples written per identifier in scatter
+     *         output types, or 0 if reservoir sampling is disabled.
+     */
+    uint32_t GetScatterReservoirSize() const;
+
+    /**
+     * \param slidingWindow length of the sliding window over which the scatter
+     *                      output is estimated, or zero to disable the sliding
+     *                      window.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetSlidingWindow(Time slidingWindow);
+
+    /**
+     * \return length of the sliding window, or zero if disabled.
+     */
+    Time GetSlidingWindow() const;
+
+    /**
+     * \param slidingStep interval between two estimates of the sliding window.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetSlidingStep(Time slidingStep);
+
+    /**
+     * \return interval between two estimates of the sliding window.
+     */
+    Time GetSlidingStep() const;
+
+    /**
+     * \param steadyStateDetection if true, the samples of the `OUTPUT_SUMMARY`
+     *                             output type are also passed to one
+     *                             ApplicationStatsSteadyState per identifier.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetSteadyStateDetection(bool steadyStateDetection);
+
+    /**
+     * \return true if the samples are passed to steady-state estimators.
+     */
+    bool GetSteadyStateDetection() const;
+
+    /**
+     * \return the number of steady-state estimators, i.e., the number of
+     *         identifiers if steady-state detection is enabled and the output
+     *         type is `OUTPUT_SUMMARY`, otherwise zero.
+     */
+    uint32_t GetNumOfSteadyStates() const;
+
+    /**
+     * \param identifier index of the identifier.
+     * \return the steady-state estimator of the identifier.
+     */
+    const ApplicationStatsSteadyState& GetSteadyState(uint32_t identifier) const;
+
+    /**
+     * \param identifier index of the identifier.
+     * \return the name of the identifier, as written in the summary file.
+     */
+    std::string GetSteadyStateName(uint32_t identifier) const;
+
+    /**
+     * \return the number of in-memory summaries, i.e., the number of
+     *         identifiers if the output type is `OUTPUT_SUMMARY` and Install()
+     *         has been invoked, otherwise zero.
+     */
+    uint32_t GetNumOfSummaries() const;
+
+    /**
+     * \param identifier index of the identifier.
+     * \return the running summary of the identifier, which covers all the
+     *         samples received so far.
+     */
+    const ApplicationStatsSummary& GetSummary(uint32_t identifier) const;
+
+    /**
+     * \param identifier index of the identifier.
+     * \return the name of the identifier, as written in the summary file.
+     */
+    std::string GetSummaryName(uint32_t identifier) const;
+
     /**
      * \return true if Install() has been invoked, otherwise false.
      */
     bool IsInstalled() const;
 
   protected:
+    // inherited from Object base class
+    virtual void DoDispose();
+
     /**
      * \brief Install the probes, collectors, and aggregators necessary to
      *        produce the statistics output.
@@ -294,6 +471,152 @@ class ApplicationStatsHelper : public Object
      */
     uint32_t CreateCollectorPerIdentifier(CollectorMap& collectorMap) const;
 
+    /**
+     * \brief Create one in-memory summary for each identifier in the
+     *        simulation, to be used with `OUTPUT_SUMMARY` output type.
+     * \param heading the first line of the output file, describing the unit of
+     *                the samples, e.g., "% identifier delay_sec".
+     * \return number of summary instances created.
+     *
+     * Identifiers are determined in the same way as in
+     * CreateCollectorPerIdentifier(), and the summaries are stored in
+     * #m_summaries. Upon disposal, the summaries are written into a single
+     * file, which is named after GetName(), with one line for each identifier.
+     */
+    uint32_t CreateSummaryPerIdentifier(std::string heading);
+
+    /// Write the summaries in #m_summaries into the output file.
+    void WriteSummaryFile() const;
+
+    /**
+     * \brief Add a sample to the summary of an identifier, and to its
+     *        steady-state estimator if steady-state detection is enabled.
+     * \param identifier index of the identifier.
+     * \param sample the sample value.
+     */
+    void AddSummarySample(uint32_t identifier, double sample)
+    {
+        NS_ASSERT_MSG(identifier < m_summaries.size(),
+                      "Unable to find summary with identifier " << identifier);
+        m_summaries[identifier].AddSample(sample);
+        if (!m_steadyStates.empty())
+        {
+            m_steadyStates[identifier].AddSample(sample);
+        }
+    }
+
+    /**
+     * \brief Create the binary writer used with `OUTPUT_SCATTER_BINARY_FILE`
+     *        output type.
+     * \param timeColumnName name of the time column, e.g., "time_sec".
+     * \param valueColumnName name of the value column, e.g., "delay_sec".
+     * \return number of identifiers in the output file.
+     *
+     * Identifiers are determined in the same way as in
+     * CreateCollectorPerIdentifier(). The writer is stored in #m_binaryWriter
+     * and the output file is named after GetName() with `.bin` extension. The
+     * file is closed upon disposal.
+     */
+    uint32_t CreateBinaryWriter(std::string timeColumnName, std::string valueColumnName);
+
+    /**
+     * \brief Connect every collector in a map to the binary writer.
+     * \param collectorMap a map containing the collectors, labelled in the same
+     *                     way as in CreateCollectorPerIdentifier().
+     * \param traceSourceName the name of the trace source of the collectors,
+     *                        which must have two double arguments (time and
+     *                        value), e.g., "OutputTimeValue".
+     *
+     * CreateBinaryWriter() must be called beforehand.
+     */
+    void ConnectCollectorsToBinaryWriter(CollectorMap& collectorMap,
+                                         std::string traceSourceName) const;
+
+    /**
+     * \return true if the output type is `OUTPUT_SCATTER_FILE`,
+     *         `OUTPUT_SCATTER_PLOT`, or `OUTPUT_SCATTER_BINARY_FILE`, and either
+     *         decimation or reservoir sampling is enabled.
+     */
+    bool IsScatterSampling() const;
+
+    /**
+     * \brief Create the sampler which thins the samples of scatter output
+     *        types before they are written.
+     * \param aggregator the aggregator which receives the surviving samples,
+     *                   i.e., a MultiFileAggregator or a GnuplotAggregator, or
+     *                   a null pointer with `OUTPUT_SCATTER_BINARY_FILE`.
+     *
+     * Identifiers are determined in the same way as in
+     * CreateCollectorPerIdentifier(), and the surviving samples of each
+     * identifier are written into the aggregator using the identifier name as
+     * the context, or into #m_binaryWriter. The sampler is stored in
+     * #m_scatterSampler and flushed upon disposal. If IsScatterSampling() is
+     * false, the sampler simply passes every sample through.
+     */
+    void CreateScatterSampler(Ptr<DataCollectionObject> aggregator);
+
+    /**
+     * \brief Connect every collector in a map to the scatter sampler.
+     * \param collectorMap a map containing the collectors, labelled in the same
+     *                     way as in CreateCollectorPerIdentifier().
+     * \param traceSourceName the name of the trace source of the collectors,
+     *                        which must have two double arguments (time and
+     *                        value), e.g., "OutputWithTime".
+     *
+     * CreateScatterSampler() must be called beforehand.
+     */
+    void ConnectCollectorsToScatterSampler(CollectorMap& collectorMap,
+                                           std::string traceSourceName) const;
+
+    /**
+     * \return true if the output type is `OUTPUT_SCATTER_FILE`,
+     *         `OUTPUT_SCATTER_PLOT`, or `OUTPUT_SCATTER_BINARY_FILE`, and the
+     *         sliding window is enabled.
+     */
+    bool IsSlidingWindow() const;
+
+    /**
+     * \brief Create and start the sliding-window estimator.
+     * \param outputType the estimate produced every step.
+     * \param scale factor applied to every estimate.
+     *
+     * The estimator is stored in #m_slidingWindow and its estimates are passed
+     * to #m_scatterSampler, so CreateScatterSampler() must be called
+     * beforehand. Samples are then passed to the estimator using
+     * ApplicationStatsSlidingWindow::Add(). The estimator is stopped upon
+     * disposal.
+     */
+    void CreateSlidingWindow(ApplicationStatsSlidingWindow::OutputType_t outputType, double scale);
+
+    /**
+     * \return true if the `InlinePipelines` attribute is enabled, the
+     *         identifier type is `GLOBAL` or `RECEIVER`, and neither scatter
+     *         sampling nor the sliding window is enabled. Child classes then
+     *         use an inline pipeline if they have one for the output type.
+     */
+    bool IsInlinePipeline() const;
+
+    /**
+     * \brief Prepare the output of an inline pipeline.
+     * \param aggregator the MultiFileAggregator which receives the output.
+     * \return a callback which writes the output of the given identifier into
+     *         the aggregator, using the identifier name as the context, i.e.,
+     *         the value alone with `OUTPUT_SCALAR_FILE`, or the time and the
+     *         value with `OUTPUT_SCATTER_FILE`.
+     *
+     * Identifiers are determined in the same way as in
+     * CreateCollectorPerIdentifier().
+     */
+    ApplicationStatsInlinePipelineBase::OutputCallback CreateInlineOutput(
+        Ptr<DataCollectionObject> aggregator);
+
+    /**
+     * \return the names of the identifiers in the simulation, according to
+     *         the currently active identifier type, in the same order as the
+     *         collectors created by CreateCollectorPerIdentifier().
+     */
+    std::vector<std::string> GetIdentifierNames() const;
+
     /**
      * \brief Create a probe attached to every receiver application and connected
      *        to a collector.
@@ -351,21 +674,155 @@ class ApplicationStatsHelper : public Object
     template <typename Q>
     uint32_t SetupListenersAtReceiver(Callback<void, Q, const Address&> cb);
 
+    /**
+     * \brief Connect the trace source of every receiver application to its own
+     *        trace sink, which is bound in advance to the identifier of the
+     *        receiver.
+     * \param cb a callback function whose second argument is the identifier of
+     *           the collector which should receive the sample.
+     * \return number of trace sources connected.
+     *
+     * Used as a replacement of SetupProbesAtReceiver() for `GLOBAL` and
+     * `RECEIVER` identifiers. The identifiers are assigned in the same way as
+     * in SetupProbesAtReceiver(). Since every trace sink already knows its
+     * identifier, the sender address given by the trace source is ignored, and
+     * the callback can be used to pass the sample directly to the collector.
+     */
+    template <typename Q>
+    uint32_t SetupBoundListenersAtReceiver(Callback<void, Q, uint32_t> cb);
+
+    /**
+     * \brief Connect the trace source of every receiver application to its own
+     *        sink of an inline pipeline, which is bound in advance to the
+     *        identifier of the receiver.
+     * \param pipeline the pipeline which receives the samples, to be stored in
+     *                 #m_inlinePipeline and flushed upon disposal.
+     * \return number of trace sources connected.
+     *
+     * Used as a replacement of SetupBoundListenersAtReceiver(), with the
+     * identifiers assigned in the same way. For example:
+     * \code
+     *   SetupInlineSinksAtReceiver<Time, ApplicationStatsDelayConversion> (pipeline);
+     * \endcode
+     *
+     * \tparam Q the type of the first argument of the trace source.
+     * \tparam C the conversion of the first argument into a sample value.
+     * \tparam A the accumulator type of the pipeline.
+     */
+    template <typename Q, typename C, typename A>
+    uint32_t SetupInlineSinksAtReceiver(Ptr<ApplicationStatsInlinePipeline<A>> pipeline);
+
     /// Internal map of sender applications, indexed by their names.
     std::map<std::string, ApplicationContainer> m_senderInfo;
 
     /// Internal map of receiver applications, indexed by their names.
     std::map<std::string, ApplicationContainer> m_receiverInfo;
 
+    /// In-memory summaries used with `OUTPUT_SUMMARY`, indexed by identifier.
+    std::vector<ApplicationStatsSummary> m_summaries;
+
+    /// Writer of the output file of `OUTPUT_SCATTER_BINARY_FILE`.
+    Ptr<ApplicationStatsBinaryWriter> m_binaryWriter;
+
+    /// Thinning of scatter output, or a null pointer if not enabled.
+    Ptr<ApplicationStatsScatterSampler> m_scatterSampler;
+
+    /// Sliding-window estimator of scatter output, or a null pointer if not enabled.
+    Ptr<ApplicationStatsSlidingWindow> m_slidingWindow;
+
+    /// The specialized pipeline replacing the collectors, or a null pointer if not used.
+    Ptr<ApplicationStatsInlinePipelineBase> m_inlinePipeline;
+
   private:
+    /**
+     * \brief Write a sample surviving the scatter sampler into the output.
+     * \param identifier index of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     */
+    void WriteScatterSample(uint32_t identifier, double time, double value);
+
+    /**
+     * \brief Write the output of an inline pipeline as a scalar.
+     * \param identifier index of the identifier.
+     * \param time the time of the output in seconds (ignored).
+     * \param value the output value.
+     */
+    void WriteScalarSample(uint32_t identifier, double time, double value);
+
+    /// Names of the identifiers of #m_summaries.
+    std::vector<std::string> m_summaryNames;
+
+    /// First line of the summary output file.
+    std::string m_summaryHeading;
+
+    /// Steady-state estimators of #m_summaries, or empty if not enabled.
+    std::vector<ApplicationStatsSteadyState> m_steadyStates;
+
+    /// Names of the identifiers of #m_scatterSampler and #m_inlinePipeline, used as contexts.
+    std::vector<std::string> m_scatterNames;
+
+    /// Receiver of the surviving samples of `OUTPUT_SCATTER_FILE`, or of the inline pipeline.
+    Ptr<MultiFileAggregator> m_scatterFileAggregator;
+
+    /// Receiver of the surviving samples of `OUTPUT_SCATTER_PLOT`.
+    Ptr<GnuplotAggregator> m_scatterPlotAggregator;
+
     std::string m_name;                ///<
     IdentifierType_t m_identifierType; ///<
     OutputType_t m_outputType;         ///<
     std::string m_traceSourceName;     ///<
     bool m_isInstalled;                ///<
+    bool m_boundTraceSinks;            ///< `BoundTraceSinks` attribute.
+    bool m_inlinePipelines;            ///< `InlinePipelines` attribute.
+    bool m_asyncOutput;                ///< `AsyncOutput` attribute.
+    uint32_t m_scatterDecimation;      ///< `ScatterDecimation` attribute.
+    uint32_t m_scatterReservoirSize;   ///< `ScatterReservoirSize` attribute.
+    Time m_slidingWindowLength;        ///< `SlidingWindow` attribute.
+    Time m_slidingStep;                ///< `SlidingStep` attribute.
+    bool m_steadyStateDetection;       ///< Whether #m_steadyStates are created.
 
 }; // end of class ApplicationStatsHelper
 
+/**
+ * \ingroup applicationstats
+ * \brief Trace sink of a single receiver application, which forwards every
+ *        sample to a callback together with a pre-determined identifier.
+ *
+ * Created by ApplicationStatsHelper::SetupBoundListenersAtReceiver(). The
+ * instance is kept alive by the trace source it is connected to.
+ */
+template <typename Q>
+class ApplicationStatsBoundSink : public SimpleRefCount<ApplicationStatsBoundSink<Q>>
+{
+  public:
+    /**
+     * \brief Create a new trace sink.
+     * \param cb the callback which receives the samples.
+     * \param identifier the identifier to be passed along with every sample.
+     */
+    ApplicationStatsBoundSink(Callback<void, Q, uint32_t> cb, uint32_t identifier)
+        : m_callback(cb),
+          m_identifier(identifier)
+    {
+    }
+
+    /**
+     * \brief Receive a sample from the trace source.
+     * \param value the sample.
+     * \param from the address of the sender (ignored).
+     */
+    void TraceSink(Q value, const Address& from)
+    {
+        m_callback(value, m_identifier);
+    }
+
+  private:
+    Callback<void, Q, uint32_t> m_callback; ///< The callback which receives the samples.
+    uint32_t m_identifier;                  ///< The identifier bound to this sink.
+
+}; // end of class ApplicationStatsBoundSink
+
 // TEMPLATE METHOD DEFINITIONS ////////////////////////////////////////////////
 
 template <typename P, typename Q, typename R, typename C>
@@ -452,6 +909,88 @@ ApplicationStatsHelper::SetupListenersAtReceiver(Callback<void, Q, const Address
     return n;
 }
 
+template <typename Q>
+uint32_t
+ApplicationStatsHelper::SetupBoundListenersAtReceiver(Callback<void, Q, uint32_t> cb)
+{
+    NS_ASSERT((m_identifierType == ApplicationStatsHelper::IDENTIFIER_GLOBAL) ||
+              (m_identifierType == ApplicationStatsHelper::IDENTIFIER_RECEIVER));
+
+    uint32_t n = 0;
+    uint32_t identifier = 0;
+
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
+        {
+            if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName(m_traceSourceName) != nullptr)
+            {
+                Ptr<ApplicationStatsBoundSink<Q>> sink =
+                    Create<ApplicationStatsBoundSink<Q>>(cb, identifier);
+
+                if ((*it2)->TraceConnectWithoutContext(
+                        m_traceSourceName,
+                        MakeCallback(&ApplicationStatsBoundSink<Q>::TraceSink, sink)))
+                {
+                    n++;
+                }
+            }
+        }
+
+        if (m_identifierType == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+        {
+            identifier++; // Move to the next collector.
+        }
+
+    } // end of `for (it1 = m_receiverInfo)`
+
+    return n;
+}
+
+template <typename Q, typename C, typename A>
+uint32_t
+ApplicationStatsHelper::SetupInlineSinksAtReceiver(Ptr<ApplicationStatsInlinePipeline<A>> pipeline)
+{
+    NS_ASSERT((m_identifierType == ApplicationStatsHelper::IDENTIFIER_GLOBAL) ||
+              (m_identifierType == ApplicationStatsHelper::IDENTIFIER_RECEIVER));
+    NS_ASSERT(pipeline != nullptr);
+
+    typedef typename ApplicationStatsInlinePipeline<A>::template Sink<Q, C> Sink_t;
+    m_inlinePipeline = pipeline;
+    uint32_t n = 0;
+    uint32_t identifier = 0;
+
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
+        {
+            if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName(m_traceSourceName) != nullptr)
+            {
+                Ptr<Sink_t> sink = Create<Sink_t>(pipeline, identifier);
+
+                if ((*it2)->TraceConnectWithoutContext(m_traceSourceName,
+                                                       MakeCallback(&Sink_t::TraceSink, sink)))
+                {
+                    n++;
+                }
+            }
+        }
+
+        if (m_identifierType == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+        {
+            identifier++; // Move to the next accumulator.
+        }
+
+    } // end of `for (it1 = m_receiverInfo)`
+
+    NS_ASSERT(identifier <= pipeline->GetN());
+    return n;
+}
+
 } // end of namespace ns3
 
 #endif /* APPLICATION_STATS_HELPER_H */
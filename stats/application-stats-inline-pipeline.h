@@ -0,0 +1,367 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_INLINE_PIPELINE_H
+#define APPLICATION_STATS_INLINE_PIPELINE_H
+
+#include <ns3/address.h>
+#include <ns3/assert.h>
+#include <ns3/callback.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/simulator.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Type-independent part of ApplicationStatsInlinePipeline, which lets
+ *        ApplicationStatsHelper flush the pipeline upon disposal.
+ */
+class ApplicationStatsInlinePipelineBase : public SimpleRefCount<ApplicationStatsInlinePipelineBase>
+{
+  public:
+    /**
+     * \brief Callback signature of the output of the pipeline.
+     * \param identifier index of the identifier.
+     * \param time the time of the output in seconds.
+     * \param value the output value.
+     */
+    typedef Callback<void, uint32_t, double, double> OutputCallback;
+
+    /// Destructor.
+    virtual ~ApplicationStatsInlinePipelineBase()
+    {
+    }
+
+    /**
+     * \brief Pass the remaining state of every identifier to the output
+     *        callback. Further samples are ignored.
+     */
+    virtual void Flush() = 0;
+
+}; // end of class ApplicationStatsInlinePipelineBase
+
+/**
+ * \ingroup applicationstats
+ * \brief Accumulator of ApplicationStatsInlinePipeline which computes the
+ *        average of all samples, like ScalarCollector with
+ *        `OUTPUT_TYPE_AVERAGE_PER_SAMPLE`.
+ *
+ * The average is passed to the output once, when the pipeline is flushed.
+ */
+class ApplicationStatsInlineAverage
+{
+  public:
+    /// Create an empty average.
+    ApplicationStatsInlineAverage()
+        : m_sum(0.0),
+          m_count(0)
+    {
+    }
+
+    /**
+     * \param identifier index of the identifier (unused).
+     * \param time the time of the sample in seconds (unused).
+     * \param value the sample value.
+     * \param output the output callback of the pipeline (unused).
+     */
+    void Add(uint32_t identifier,
+             double time,
+             double value,
+             const ApplicationStatsInlinePipelineBase::OutputCallback& output)
+    {
+        m_sum += value;
+        m_count++;
+    }
+
+    /**
+     * \param identifier index of the identifier.
+     * \param time the current time in seconds.
+     * \param output the output callback of the pipeline.
+     */
+    void Flush(uint32_t identifier,
+               double time,
+               const ApplicationStatsInlinePipelineBase::OutputCallback& output)
+    {
+        output(identifier, time, (m_count == 0) ? 0.0 : (m_sum / m_count));
+    }
+
+  private:
+    double m_sum;     ///< Sum of the samples.
+    uint64_t m_count; ///< Number of samples.
+
+}; // end of class ApplicationStatsInlineAverage
+
+/**
+ * \ingroup applicationstats
+ * \brief Accumulator of ApplicationStatsInlinePipeline which computes the
+ *        sum of the samples over consecutive intervals divided by the interval
+ *        length, like IntervalRateCollector.
+ *
+ * The intervals are aligned with the beginning of the simulation. Instead of
+ * scheduling an event at the end of every interval, each interval is closed by
+ * the first sample (or the flush) which falls after it, and any idle interval
+ * in between is passed to the output as a zero rate. The output time of each
+ * interval is its end time.
+ */
+class ApplicationStatsInlineIntervalRate
+{
+  public:
+    /**
+     * \param intervalLength length of each interval in seconds.
+     */
+    explicit ApplicationStatsInlineIntervalRate(double intervalLength)
+        : m_intervalLength(intervalLength),
+          m_intervalIndex(0),
+          m_sum(0.0)
+    {
+        NS_ASSERT(intervalLength > 0.0);
+    }
+
+    /**
+     * \param identifier index of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     * \param output the output callback of the pipeline.
+     */
+    void Add(uint32_t identifier,
+             double time,
+             double value,
+             const ApplicationStatsInlinePipelineBase::OutputCallback& output)
+    {
+        CloseIntervals(identifier, time, output);
+        m_sum += value;
+    }
+
+    /**
+     * \param identifier index of the identifier.
+     * \param time the current time in seconds.
+     * \param output the output callback of the pipeline.
+     *
+     * The ongoing interval is discarded, as it has not been completed yet.
+     */
+    void Flush(uint32_t identifier,
+               double time,
+               const ApplicationStatsInlinePipelineBase::OutputCallback& output)
+    {
+        CloseIntervals(identifier, time, output);
+    }
+
+  private:
+    /**
+     * \brief Pass every interval which ends before the given time to the output.
+     * \param identifier index of the identifier.
+     * \param time the current time in seconds.
+     * \param output the output callback of the pipeline.
+     */
+    void CloseIntervals(uint32_t identifier,
+                        double time,
+                        const ApplicationStatsInlinePipelineBase::OutputCallback& output)
+    {
+        const uint64_t index = static_cast<uint64_t>(time / m_intervalLength);
+        while (m_intervalIndex < index)
+        {
+            m_intervalIndex++;
+            output(identifier, m_intervalIndex * m_intervalLength, m_sum / m_intervalLength);
+            m_sum = 0.0;
+        }
+    }
+
+    double m_intervalLength;  ///< Length of each interval in seconds.
+    uint64_t m_intervalIndex; ///< Index of the ongoing interval.
+    double m_sum;             ///< Sum of the samples in the ongoing interval.
+
+}; // end of class ApplicationStatsInlineIntervalRate
+
+/**
+ * \ingroup applicationstats
+ * \brief Conversion of ApplicationStatsInlinePipeline::Sink which passes
+ *        packet delays in seconds.
+ */
+struct ApplicationStatsDelayConversion
+{
+    /**
+     * \param delay the packet delay.
+     * \return the packet delay in seconds.
+     */
+    static double Convert(Time delay)
+    {
+        return delay.GetSeconds();
+    }
+};
+
+/**
+ * \ingroup applicationstats
+ * \brief Conversion of ApplicationStatsInlinePipeline::Sink which passes
+ *        packet sizes in kilobits, like UnitConversionCollector with
+ *        `FROM_BYTES_TO_KBIT`.
+ */
+struct ApplicationStatsPacketConversion
+{
+    /**
+     * \param packet the received packet.
+     * \return the size of the packet in kilobits.
+     */
+    static double Convert(Ptr<const Packet> packet)
+    {
+        return packet->GetSize() * 0.008;
+    }
+};
+
+/**
+ * \ingroup applicationstats
+ * \brief Replacement of a probe and a chain of collectors, in which the state
+ *        of every identifier is kept in an accumulator held by value.
+ *
+ * Used by ApplicationStatsHelper when the `InlinePipelines` attribute is
+ * enabled, for the combinations of statistics, identifier type, and output
+ * type which have a matching accumulator, e.g., ApplicationStatsInlineAverage
+ * for the scalar output of packet delay. The accumulator and the conversion
+ * of the trace source arguments are template arguments, so every sample is
+ * passed from the trace source to the accumulator through a single callback
+ * invocation and inlined function calls, without going through the trace
+ * sources of probes and collectors. Only the output, which is much less
+ * frequent than the samples, goes through the output callback.
+ *
+ * An accumulator is a copyable class with the following methods:
+ * - `void Add (uint32_t identifier, double time, double value, const OutputCallback &output)`
+ * - `void Flush (uint32_t identifier, double time, const OutputCallback &output)`
+ *
+ * \tparam A the accumulator type.
+ */
+template <typename A>
+class ApplicationStatsInlinePipeline : public ApplicationStatsInlinePipelineBase
+{
+  public:
+    /**
+     * \brief Trace sink of a single receiver application, which converts every
+     *        sample and passes it to the pipeline together with a
+     *        pre-determined identifier.
+     *
+     * \tparam Q the type of the first argument of the trace source.
+     * \tparam C the conversion, i.e., a class with a static
+     *           `double Convert (Q)` method.
+     */
+    template <typename Q, typename C>
+    class Sink : public SimpleRefCount<Sink<Q, C>>
+    {
+      public:
+        /**
+         * \param pipeline the pipeline which receives the samples.
+         * \param identifier the identifier to be passed along with every sample.
+         */
+        Sink(Ptr<ApplicationStatsInlinePipeline<A>> pipeline, uint32_t identifier)
+            : m_pipeline(pipeline),
+              m_identifier(identifier)
+        {
+        }
+
+        /**
+         * \brief Receive a sample from the trace source.
+         * \param value the sample.
+         * \param from the address of the sender (ignored).
+         */
+        void TraceSink(Q value, const Address& from)
+        {
+            m_pipeline->Add(m_identifier, C::Convert(value));
+        }
+
+      private:
+        Ptr<ApplicationStatsInlinePipeline<A>> m_pipeline; ///< The receiving pipeline.
+        uint32_t m_identifier;                             ///< The identifier bound to this sink.
+
+    }; // end of class Sink
+
+    /**
+     * \brief Create a new pipeline.
+     * \param numOfIdentifiers number of identifiers.
+     * \param prototype the initial state of the accumulator of every identifier.
+     * \param output the callback which receives the output of the accumulators.
+     */
+    ApplicationStatsInlinePipeline(uint32_t numOfIdentifiers,
+                                   const A& prototype,
+                                   OutputCallback output)
+        : m_accumulators(numOfIdentifiers, prototype),
+          m_output(output),
+          m_isFlushed(false)
+    {
+    }
+
+    /**
+     * \brief Pass a sample to the accumulator of an identifier.
+     * \param identifier index of the identifier.
+     * \param value the sample value.
+     */
+    void Add(uint32_t identifier, double value)
+    {
+        if (m_isFlushed)
+        {
+            return;
+        }
+
+        NS_ASSERT_MSG(identifier < m_accumulators.size(), "Invalid identifier " << identifier);
+        m_accumulators[identifier].Add(identifier,
+                                       Simulator::Now().GetSeconds(),
+                                       value,
+                                       m_output);
+    }
+
+    // inherited from ApplicationStatsInlinePipelineBase base class
+    virtual void Flush()
+    {
+        if (m_isFlushed)
+        {
+            return;
+        }
+
+        const double time = Simulator::Now().GetSeconds();
+        for (uint32_t i = 0; i < m_accumulators.size(); i++)
+        {
+            m_accumulators[i].Flush(i, time, m_output);
+        }
+
+        m_output = MakeNullCallback<void, uint32_t, double, double>();
+        m_isFlushed = true;
+    }
+
+    /**
+     * \return the number of identifiers.
+     */
+    uint32_t GetN() const
+    {
+        return m_accumulators.size();
+    }
+
+  private:
+    std::vector<A> m_accumulators; ///< The state, indexed by identifier.
+    OutputCallback m_output;       ///< The output of the accumulators.
+    bool m_isFlushed;              ///< True after Flush() has been invoked.
+
+}; // end of class ApplicationStatsInlinePipeline
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_INLINE_PIPELINE_H */
@@ -0,0 +1,181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-jitter-helper.h"
+
+#include <ns3/application-container.h>
+#include <ns3/application.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsJitterHelper");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsJitterHelper);
+
+ApplicationStatsJitterHelper::ApplicationStatsJitterHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ApplicationStatsJitterHelper::~ApplicationStatsJitterHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationStatsJitterHelper::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ApplicationStatsJitterHelper").SetParent<ApplicationStatsDelayHelper>();
+    return tid;
+}
+
+void
+ApplicationStatsJitterHelper::DoInstall()
+{
+    NS_LOG_FUNCTION(this);
+
+    InstallCollectors();
+
+    if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER)
+    {
+        // Create a look-up table of sender addresses and collector identifiers.
+        BuildAddressTable();
+    }
+
+    CreateTerminalSinks();
+
+    /*
+     * The jitter is computed per flow, so every receiver gets its own trace
+     * sink regardless of the identifier type.
+     */
+    const std::string traceSourceName = GetTraceSourceName();
+    uint32_t n = 0;
+    uint32_t identifier = 0;
+
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
+        {
+            if ((*it2)->GetInstanceTypeId().LookupTraceSourceByName(traceSourceName) == nullptr)
+            {
+                continue;
+            }
+
+            Ptr<JitterSink> sink = Create<JitterSink>(this, identifier);
+            const bool isConnected =
+                IsPacketTraceSource(traceSourceName, *it2)
+                    ? (*it2)->TraceConnectWithoutContext(
+                          traceSourceName,
+                          MakeCallback(&JitterSink::PacketSink, sink))
+                    : (*it2)->TraceConnectWithoutContext(traceSourceName,
+                                                         MakeCallback(&JitterSink::DelaySink, sink));
+            if (isConnected)
+            {
+                m_sinks.push_back(sink);
+                n++;
+            }
+        }
+
+        if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+        {
+            identifier++; // Move to the next collector.
+        }
+
+    } // end of `for (it1 = m_receiverInfo)`
+
+    NS_LOG_INFO(this << " connected to " << n << " trace sources");
+
+} // end of `void DoInstall ()`
+
+std::string
+ApplicationStatsJitterHelper::GetColumnName() const
+{
+    return "jitter_sec";
+}
+
+std::string
+ApplicationStatsJitterHelper::GetAxisLabel() const
+{
+    return "Packet jitter (in seconds)";
+}
+
+bool // static
+ApplicationStatsJitterHelper::IsPacketTraceSource(std::string traceSourceName,
+                                                  Ptr<Application> application)
+{
+    TypeId::TraceSourceInformation info;
+    application->GetInstanceTypeId().LookupTraceSourceByName(traceSourceName, &info);
+    return info.callback.find("ns3::Packet::") == 0;
+}
+
+// JITTER SINK ////////////////////////////////////////////////////////////////
+
+ApplicationStatsJitterHelper::JitterSink::JitterSink(ApplicationStatsJitterHelper* helper,
+                                                     uint32_t identifier)
+    : m_helper(helper),
+      m_identifier(identifier)
+{
+}
+
+void
+ApplicationStatsJitterHelper::JitterSink::DelaySink(Time delay, const Address& from)
+{
+    JitterEstimator& estimator = m_estimators[from];
+    estimator.AddDelay(delay);
+    Forward(estimator, from);
+}
+
+void
+ApplicationStatsJitterHelper::JitterSink::PacketSink(Ptr<const Packet> packet,
+                                                     const Address& from)
+{
+    JitterEstimator& estimator = m_estimators[from];
+    if (estimator.AddPacket(packet))
+    {
+        Forward(estimator, from);
+    }
+}
+
+void
+ApplicationStatsJitterHelper::JitterSink::Forward(const JitterEstimator& estimator,
+                                                  const Address& from)
+{
+    if (!estimator.HasJitter())
+    {
+        return;
+    }
+
+    if (m_helper->GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER)
+    {
+        m_helper->RxDelayCallback(estimator.GetJitter(), from);
+    }
+    else
+    {
+        m_helper->PassSampleToCollector(estimator.GetJitter(), m_identifier);
+    }
+}
+
+} // end of namespace ns3
@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_JITTER_HELPER_H
+#define APPLICATION_STATS_JITTER_HELPER_H
+
+#include <ns3/address.h>
+#include <ns3/application-stats-delay-helper.h>
+#include <ns3/jitter-estimator.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <list>
+#include <map>
+#include <string>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \ingroup applicationstats
+ * \brief Produce RFC 3550 interarrival jitter statistics of the packets
+ *        received by the receiver applications.
+ *
+ * The trace source given by the `TraceSourceName` attribute of the helper is
+ * connected to a trace sink per receiver application, which keeps one
+ * JitterEstimator per sender address. Two kinds of trace sources are supported:
+ * - delay trace sources with `(Time, const Address &)` signature, e.g.,
+ *   `RxDelay` of NrtvTcpClient; and
+ * - packet trace sources with `(Ptr<const Packet>, const Address &)` signature,
+ *   e.g., `Rx` of PacketSink, where the delay is read from the TrafficTimeTag
+ *   or the TrafficTimestampHeader added by CbrApplication. Packets without
+ *   either of them are ignored.
+ *
+ * Every packet after the first one of a flow produces a jitter sample, which
+ * is written out in the same output types as the delay statistics.
+ */
+class ApplicationStatsJitterHelper : public ApplicationStatsDelayHelper
+{
+  public:
+    // inherited from ApplicationStatsHelper base class
+    ApplicationStatsJitterHelper();
+
+    /// Destructor.
+    virtual ~ApplicationStatsJitterHelper();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+  protected:
+    // inherited from ApplicationStatsHelper base class
+    virtual void DoInstall();
+
+    // inherited from ApplicationStatsDelayHelper base class
+    virtual std::string GetColumnName() const;
+    virtual std::string GetAxisLabel() const;
+
+  private:
+    /// Trace sink of a single receiver application, estimating jitter per sender.
+    class JitterSink : public SimpleRefCount<JitterSink>
+    {
+      public:
+        /**
+         * \param helper the parent helper.
+         * \param identifier the collector identifier of the receiver, ignored
+         *                   with `SENDER` identifier.
+         */
+        JitterSink(ApplicationStatsJitterHelper* helper, uint32_t identifier);
+
+        /**
+         * \param delay packet delay.
+         * \param from the address of the sender of the packet.
+         */
+        void DelaySink(Time delay, const Address& from);
+
+        /**
+         * \param packet the received packet, possibly carrying a TrafficTimeTag.
+         * \param from the address of the sender of the packet.
+         */
+        void PacketSink(Ptr<const Packet> packet, const Address& from);
+
+      private:
+        /**
+         * \brief Pass the current jitter of a sender to the parent helper.
+         * \param estimator the estimator of the sender.
+         * \param from the address of the sender.
+         */
+        void Forward(const JitterEstimator& estimator, const Address& from);
+
+        ApplicationStatsJitterHelper* m_helper;           ///< The parent helper.
+        uint32_t m_identifier;                            ///< The bound identifier.
+        std::map<Address, JitterEstimator> m_estimators; ///< Estimators per sender.
+    };
+
+    /**
+     * \param traceSourceName name of a trace source of a receiver application.
+     * \param application the receiver application.
+     * \return true if the trace source delivers packets instead of delays.
+     */
+    static bool IsPacketTraceSource(std::string traceSourceName, Ptr<Application> application);
+
+    /// Trace sinks created by this helper, kept alive until the helper is destroyed.
+    std::list<Ptr<JitterSink>> m_sinks;
+
+}; // end of class ApplicationStatsJitterHelper
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_JITTER_HELPER_H */
@@ -0,0 +1,233 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "application-stats-scatter-sampler.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsScatterSampler");
+
+namespace ns3
+{
+
+ApplicationStatsScatterSampler::ApplicationStatsScatterSampler(
+    uint32_t numOfIdentifiers,
+    uint32_t decimation,
+    uint32_t reservoirSize,
+    Callback<void, uint32_t, double, double> output)
+    : m_decimation(decimation),
+      m_reservoirSize(reservoirSize),
+      m_output(output),
+      m_isFlushed(false)
+{
+    NS_LOG_FUNCTION(this << numOfIdentifiers << decimation << reservoirSize);
+    NS_ABORT_MSG_IF(decimation == 0, "Decimation factor must be greater than zero");
+    NS_ABORT_MSG_IF(output.IsNull(), "Output callback must not be null");
+
+    m_uniform = CreateObject<UniformRandomVariable>();
+
+    for (uint32_t i = 0; i < numOfIdentifiers; i++)
+    {
+        Ptr<Column> column = Create<Column>(this, i);
+        column->m_times.reserve(reservoirSize);
+        column->m_values.reserve(reservoirSize);
+        m_columns.push_back(column);
+    }
+}
+
+ApplicationStatsScatterSampler::~ApplicationStatsScatterSampler()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (uint32_t i = 0; i < m_columns.size(); i++)
+    {
+        m_columns[i]->Detach();
+    }
+}
+
+void
+ApplicationStatsScatterSampler::Write(uint32_t identifier, double time, double value)
+{
+    if (m_isFlushed)
+    {
+        return;
+    }
+
+    NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+    Column* column = PeekPointer(m_columns[identifier]);
+
+    if ((column->m_numOfSamples++ % m_decimation) != 0)
+    {
+        return; // dropped by the decimation
+    }
+
+    if (m_reservoirSize == 0)
+    {
+        m_output(identifier, time, value);
+    }
+    else
+    {
+        AddToReservoir(column, time, value);
+    }
+}
+
+Callback<void, double, double>
+ApplicationStatsScatterSampler::GetSink(uint32_t identifier)
+{
+    NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+    return MakeCallback(&Column::TraceSink, m_columns[identifier]);
+}
+
+void
+ApplicationStatsScatterSampler::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_isFlushed)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_columns.size(); i++)
+    {
+        Column* column = PeekPointer(m_columns[i]);
+        const std::vector<double>& times = column->m_times;
+        NS_ASSERT(column->m_values.size() == times.size());
+        NS_LOG_INFO(this << " identifier " << i << " kept " << times.size() << " out of "
+                         << column->m_numOfSamples << " samples");
+
+        // Replacements in the reservoir do not preserve the chronological order.
+        std::vector<uint32_t> order(times.size());
+        for (uint32_t j = 0; j < order.size(); j++)
+        {
+            order[j] = j;
+        }
+        std::stable_sort(order.begin(), order.end(), [&times](uint32_t a, uint32_t b) {
+            return times[a] < times[b];
+        });
+
+        for (std::vector<uint32_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+        {
+            m_output(i, times[*it], column->m_values[*it]);
+        }
+
+        column->m_times.clear();
+        column->m_values.clear();
+        column->Detach();
+    }
+
+    m_isFlushed = true;
+
+} // end of `void Flush ()`
+
+uint64_t
+ApplicationStatsScatterSampler::GetNumOfSamples(uint32_t identifier) const
+{
+    NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+    return m_columns[identifier]->m_numOfSamples;
+}
+
+int64_t
+ApplicationStatsScatterSampler::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_uniform->SetStream(stream);
+    return 1;
+}
+
+void
+ApplicationStatsScatterSampler::AddToReservoir(Column* column, double time, double value)
+{
+    const uint64_t index = column->m_numOfDecimated++;
+
+    if (index < m_reservoirSize)
+    {
+        column->m_times.push_back(time);
+        column->m_values.push_back(value);
+        if (index + 1 < m_reservoirSize)
+        {
+            return;
+        }
+
+        // The reservoir has just become full.
+        column->m_weight = std::exp(std::log(GetUniform()) / m_reservoirSize);
+        column->m_nextReplacement = index;
+    }
+    else if (index == column->m_nextReplacement)
+    {
+        const uint32_t slot =
+            std::min<uint32_t>(GetUniform() * m_reservoirSize, m_reservoirSize - 1);
+        column->m_times[slot] = time;
+        column->m_values[slot] = value;
+        column->m_weight *= std::exp(std::log(GetUniform()) / m_reservoirSize);
+    }
+    else
+    {
+        return; // skipped by Algorithm L
+    }
+
+    // Number of samples to skip before the next replacement.
+    const double skip = std::floor(std::log(GetUniform()) / std::log1p(-column->m_weight));
+    column->m_nextReplacement += 1 + static_cast<uint64_t>(std::min(skip, 1e18));
+
+} // end of `void AddToReservoir (Column *, double, double)`
+
+double
+ApplicationStatsScatterSampler::GetUniform()
+{
+    double u = 0.0;
+    while (u <= 0.0)
+    {
+        u = m_uniform->GetValue(); // within [0, 1)
+    }
+    return u;
+}
+
+// COLUMN /////////////////////////////////////////////////////////////////////
+
+ApplicationStatsScatterSampler::Column::Column(ApplicationStatsScatterSampler* sampler,
+                                               uint32_t identifier)
+    : m_numOfSamples(0),
+      m_numOfDecimated(0),
+      m_nextReplacement(0),
+      m_weight(0.0),
+      m_sampler(sampler),
+      m_identifier(identifier)
+{
+}
+
+void
+ApplicationStatsScatterSampler::Column::TraceSink(double time, double value)
+{
+    if (m_sampler != nullptr)
+    {
+        m_sampler->Write(m_identifier, time, value);
+    }
+}
+
+void
+ApplicationStatsScatterSampler::Column::Detach()
+{
+    m_sampler = nullptr;
+}
+
+} // end of namespace ns3
@@ -0,0 +1,163 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef APPLICATION_STATS_SCATTER_SAMPLER_H
+#define APPLICATION_STATS_SCATTER_SAMPLER_H
+
+#include <ns3/callback.h>
+#include <ns3/ptr.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Thinning of the time/value samples of scatter output types.
+ *
+ * Used by ApplicationStatsHelper when the `ScatterDecimation` or the
+ * `ScatterReservoirSize` attribute is set. The samples of each identifier go
+ * through up to two stages before being passed to the output callback:
+ * - decimation, which keeps only the first sample out of every N samples; and
+ * - reservoir sampling, which keeps a uniformly random subset of up to K of
+ *   the samples surviving the decimation (Algorithm L by Li, 1994).
+ *
+ * Without reservoir sampling, the surviving samples are passed to the output
+ * callback right away. Otherwise, they are kept in memory and passed to the
+ * output callback in chronological order upon Flush().
+ *
+ * Algorithm L draws random variates only when a sample is put into the
+ * reservoir, so the cost of every other sample is a single comparison.
+ */
+class ApplicationStatsScatterSampler : public SimpleRefCount<ApplicationStatsScatterSampler>
+{
+  public:
+    /**
+     * \brief Create a new sampler.
+     * \param numOfIdentifiers number of identifiers.
+     * \param decimation keep one sample out of this many, or 1 to keep all.
+     * \param reservoirSize maximum number of samples kept per identifier, or 0
+     *                      to disable reservoir sampling.
+     * \param output callback receiving the identifier, the time in seconds, and
+     *               the value of the surviving samples.
+     */
+    ApplicationStatsScatterSampler(uint32_t numOfIdentifiers,
+                                   uint32_t decimation,
+                                   uint32_t reservoirSize,
+                                   Callback<void, uint32_t, double, double> output);
+
+    /// Destructor.
+    ~ApplicationStatsScatterSampler();
+
+    /**
+     * \brief Offer a sample of the given identifier.
+     * \param identifier index of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     */
+    void Write(uint32_t identifier, double time, double value);
+
+    /**
+     * \param identifier index of the identifier.
+     * \return a callback which offers samples of the given identifier,
+     *         suitable as a sink of trace sources with two double arguments
+     *         (time and value).
+     */
+    Callback<void, double, double> GetSink(uint32_t identifier);
+
+    /**
+     * \brief Pass the samples in the reservoirs to the output callback. Further
+     *        samples are ignored.
+     */
+    void Flush();
+
+    /**
+     * \param identifier index of the identifier.
+     * \return number of samples offered so far, including the dropped ones.
+     */
+    uint64_t GetNumOfSamples(uint32_t identifier) const;
+
+    /**
+     * \brief Set a fixed stream number to the underlying uniform variable.
+     * \param stream the stream index to use.
+     * \return the number of stream indices used.
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  private:
+    /// Sampling state of one identifier.
+    class Column : public SimpleRefCount<Column>
+    {
+      public:
+        /**
+         * \param sampler the parent sampler.
+         * \param identifier index of the identifier.
+         */
+        Column(ApplicationStatsScatterSampler* sampler, uint32_t identifier);
+
+        /**
+         * \param time the time of the sample in seconds.
+         * \param value the sample value.
+         */
+        void TraceSink(double time, double value);
+
+        /// Forget the parent sampler, so that further samples are ignored.
+        void Detach();
+
+        uint64_t m_numOfSamples;      ///< Number of samples offered so far.
+        uint64_t m_numOfDecimated;    ///< Number of samples surviving the decimation.
+        uint64_t m_nextReplacement;   ///< Index of the next sample put into the reservoir.
+        double m_weight;              ///< The W variable of Algorithm L.
+        std::vector<double> m_times;  ///< Time values in the reservoir.
+        std::vector<double> m_values; ///< Sample values in the reservoir.
+
+      private:
+        ApplicationStatsScatterSampler* m_sampler; ///< The parent sampler.
+        uint32_t m_identifier;                     ///< Index of the identifier.
+    };
+
+    /**
+     * \brief Put a sample surviving the decimation into the reservoir of a
+     *        column, possibly replacing a random earlier sample.
+     * \param column the column of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     */
+    void AddToReservoir(Column* column, double time, double value);
+
+    /**
+     * \return a uniform variate in (0, 1).
+     */
+    double GetUniform();
+
+    uint32_t m_decimation;                             ///< Keep one sample out of this many.
+    uint32_t m_reservoirSize;                          ///< Maximum samples per identifier.
+    Callback<void, uint32_t, double, double> m_output; ///< Receiver of surviving samples.
+    Ptr<UniformRandomVariable> m_uniform;              ///< Source of reservoir randomness.
+    std::vector<Ptr<Column>> m_columns;                ///< State, indexed by identifier.
+    bool m_isFlushed;                                  ///< True after Flush() has been invoked.
+
+}; // end of class ApplicationStatsScatterSampler
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_SCATTER_SAMPLER_H */
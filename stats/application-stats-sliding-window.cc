@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "application-stats-sliding-window.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsSlidingWindow");
+
+namespace ns3
+{
+
+ApplicationStatsSlidingWindow::ApplicationStatsSlidingWindow(
+    uint32_t numOfIdentifiers,
+    Time window,
+    Time step,
+    OutputType_t outputType,
+    double scale,
+    Callback<void, uint32_t, double, double> output)
+    : m_step(step),
+      m_outputType(outputType),
+      m_scale(scale),
+      m_output(output),
+      m_cursor(0),
+      m_numOfSteps(0)
+{
+    NS_LOG_FUNCTION(this << numOfIdentifiers << window.GetSeconds() << step.GetSeconds()
+                         << outputType << scale);
+    NS_ABORT_MSG_UNLESS(step.IsStrictlyPositive(), "Step must be positive");
+    NS_ABORT_MSG_IF(window < step, "Window must not be shorter than the step");
+    NS_ABORT_MSG_IF(output.IsNull(), "Output callback must not be null");
+
+    const int64_t steps = window.GetTimeStep() / step.GetTimeStep();
+    m_numOfBuckets = steps + ((window.GetTimeStep() % step.GetTimeStep()) == 0 ? 0 : 1);
+
+    Column column;
+    column.m_sums.assign(m_numOfBuckets, 0.0);
+    column.m_counts.assign(m_numOfBuckets, 0);
+    column.m_windowSum = 0.0;
+    column.m_windowCount = 0;
+    m_columns.assign(numOfIdentifiers, column);
+}
+
+ApplicationStatsSlidingWindow::~ApplicationStatsSlidingWindow()
+{
+    NS_LOG_FUNCTION(this);
+    m_stepEvent.Cancel();
+}
+
+void
+ApplicationStatsSlidingWindow::Start()
+{
+    NS_LOG_FUNCTION(this);
+    m_stepEvent.Cancel();
+    m_stepEvent = Simulator::Schedule(m_step, &ApplicationStatsSlidingWindow::Step, this);
+}
+
+void
+ApplicationStatsSlidingWindow::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stepEvent.Cancel();
+}
+
+uint32_t
+ApplicationStatsSlidingWindow::GetNumOfBuckets() const
+{
+    return m_numOfBuckets;
+}
+
+void
+ApplicationStatsSlidingWindow::Step()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_numOfSteps++;
+    const double now = Simulator::Now().GetSeconds();
+    const uint64_t numOfCoveredSteps = std::min<uint64_t>(m_numOfSteps, m_numOfBuckets);
+    const double coveredSeconds = numOfCoveredSteps * m_step.GetSeconds();
+    const uint32_t next = (m_cursor + 1) % m_numOfBuckets;
+
+    for (uint32_t i = 0; i < m_columns.size(); i++)
+    {
+        Column& column = m_columns[i];
+
+        if (m_outputType == ApplicationStatsSlidingWindow::OUTPUT_RATE)
+        {
+            m_output(i, now, m_scale * column.m_windowSum / coveredSeconds);
+        }
+        else if (column.m_windowCount > 0)
+        {
+            m_output(i, now, m_scale * column.m_windowSum / column.m_windowCount);
+        }
+
+        // Recycle the oldest bucket for the next step.
+        column.m_windowSum -= column.m_sums[next];
+        column.m_windowCount -= column.m_counts[next];
+        column.m_sums[next] = 0.0;
+        column.m_counts[next] = 0;
+
+        if (next == 0)
+        {
+            // Once per window, drop the rounding errors of the running sum.
+            column.m_windowSum = 0.0;
+            for (uint32_t j = 0; j < m_numOfBuckets; j++)
+            {
+                column.m_windowSum += column.m_sums[j];
+            }
+        }
+    }
+
+    m_cursor = next;
+    m_stepEvent = Simulator::Schedule(m_step, &ApplicationStatsSlidingWindow::Step, this);
+
+} // end of `void Step ()`
+
+} // end of namespace ns3
@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef APPLICATION_STATS_SLIDING_WINDOW_H
+#define APPLICATION_STATS_SLIDING_WINDOW_H
+
+#include <ns3/assert.h>
+#include <ns3/callback.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Sliding-window estimator of the rate or the mean of samples, with
+ *        constant cost per sample and per step.
+ *
+ * Used by ApplicationStatsHelper when the `SlidingWindow` attribute is set.
+ * The window of each identifier is a ring buffer of `ceil (window / step)`
+ * buckets, each of them holding the sum and the number of the samples received
+ * within one step, together with a running sum over all buckets. Every step, a
+ * single simulator event passes one estimate per identifier to the output
+ * callback, time-stamped with the end of the step, and then recycles the
+ * oldest bucket. Memory is therefore bounded by the number of buckets,
+ * regardless of the number of samples.
+ *
+ * Before the first full window has elapsed, the estimates cover the time
+ * elapsed since Start(). A mean estimate is not produced while the window
+ * does not contain any sample.
+ */
+class ApplicationStatsSlidingWindow : public SimpleRefCount<ApplicationStatsSlidingWindow>
+{
+  public:
+    /// The estimate produced every step.
+    typedef enum
+    {
+        OUTPUT_RATE = 0, ///< Sum of the samples in the window, per second.
+        OUTPUT_MEAN      ///< Mean of the samples in the window.
+    } OutputType_t;
+
+    /**
+     * \brief Create a new estimator.
+     * \param numOfIdentifiers number of identifiers.
+     * \param window length of the window.
+     * \param step interval between two estimates, not longer than the window.
+     * \param outputType the estimate produced every step.
+     * \param scale factor applied to every estimate, e.g., to convert bytes
+     *              into kilobits.
+     * \param output callback receiving the identifier, the time in seconds, and
+     *               the estimate.
+     */
+    ApplicationStatsSlidingWindow(uint32_t numOfIdentifiers,
+                                  Time window,
+                                  Time step,
+                                  OutputType_t outputType,
+                                  double scale,
+                                  Callback<void, uint32_t, double, double> output);
+
+    /// Destructor, which cancels the next step.
+    ~ApplicationStatsSlidingWindow();
+
+    /**
+     * \brief Account a sample of the given identifier in the current step.
+     * \param identifier index of the identifier.
+     * \param value the sample value.
+     */
+    void Add(uint32_t identifier, double value)
+    {
+        NS_ASSERT_MSG(identifier < m_columns.size(), "Invalid identifier " << identifier);
+        Column& column = m_columns[identifier];
+        column.m_sums[m_cursor] += value;
+        column.m_counts[m_cursor]++;
+        column.m_windowSum += value;
+        column.m_windowCount++;
+    }
+
+    /// Schedule the first step, one step from now.
+    void Start();
+
+    /// Cancel the next step. Further samples are still accounted, but never output.
+    void Stop();
+
+    /// \return the number of buckets in the window of each identifier.
+    uint32_t GetNumOfBuckets() const;
+
+  private:
+    /// Ring buffer of one identifier.
+    struct Column
+    {
+        std::vector<double> m_sums;     ///< Sum of the samples of each bucket.
+        std::vector<uint64_t> m_counts; ///< Number of samples of each bucket.
+        double m_windowSum;             ///< Sum over all buckets.
+        uint64_t m_windowCount;         ///< Number of samples over all buckets.
+    };
+
+    /// Output the estimates of the ending step and move to the next bucket.
+    void Step();
+
+    uint32_t m_numOfBuckets;                           ///< Number of buckets per window.
+    Time m_step;                                       ///< Interval between two estimates.
+    OutputType_t m_outputType;                         ///< The estimate produced every step.
+    double m_scale;                                    ///< Factor applied to every estimate.
+    Callback<void, uint32_t, double, double> m_output; ///< Receiver of the estimates.
+    std::vector<Column> m_columns;                     ///< Ring buffers, indexed by identifier.
+    uint32_t m_cursor;                                 ///< Bucket of the ongoing step.
+    uint64_t m_numOfSteps;                             ///< Steps completed since Start().
+    EventId m_stepEvent;                               ///< The end of the ongoing step.
+
+}; // end of class ApplicationStatsSlidingWindow
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_SLIDING_WINDOW_H */
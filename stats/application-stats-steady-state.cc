@@ -0,0 +1,185 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-steady-state.h"
+
+#include <ns3/abort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+/// Two-sided 97.5th percentile of Student's t-distribution with 19 degrees of freedom.
+static const double T_QUANTILE = 2.093;
+
+ApplicationStatsSteadyState::ApplicationStatsSteadyState(uint32_t maxNumOfBatches)
+    : m_maxNumOfBatches(maxNumOfBatches),
+      m_count(0),
+      m_batchSize(BATCH_SIZE),
+      m_partialSum(0.0),
+      m_partialCount(0)
+{
+    NS_ABORT_MSG_IF(maxNumOfBatches % 2 != 0 || maxNumOfBatches < 2 * NUM_OF_CI_BATCHES,
+                    "Invalid maximum number of batches " << maxNumOfBatches);
+    m_batchMeans.reserve(maxNumOfBatches);
+}
+
+void
+ApplicationStatsSteadyState::AddSample(double sample)
+{
+    m_count++;
+    m_partialSum += sample;
+    m_partialCount++;
+
+    if (m_partialCount == m_batchSize)
+    {
+        m_batchMeans.push_back(m_partialSum / m_batchSize);
+        m_partialSum = 0.0;
+        m_partialCount = 0;
+
+        if (m_batchMeans.size() == m_maxNumOfBatches)
+        {
+            MergeBatches();
+        }
+    }
+}
+
+uint64_t
+ApplicationStatsSteadyState::GetCount() const
+{
+    return m_count;
+}
+
+uint64_t
+ApplicationStatsSteadyState::GetBatchSize() const
+{
+    return m_batchSize;
+}
+
+ApplicationStatsSteadyState::Estimate_t
+ApplicationStatsSteadyState::GetEstimate() const
+{
+    Estimate_t estimate;
+    estimate.truncatedCount = 0;
+    estimate.retainedCount = 0;
+    estimate.mean = 0.0;
+    estimate.halfWidth = 0.0;
+    estimate.relativePrecision = std::numeric_limits<double>::infinity();
+
+    const uint32_t n = m_batchMeans.size();
+    if (n == 0)
+    {
+        return estimate;
+    }
+
+    // MSER statistic of every truncation point, using running sums of the tail.
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sum += m_batchMeans[i];
+        sumOfSquares += m_batchMeans[i] * m_batchMeans[i];
+    }
+
+    uint32_t truncation = 0;
+    double minMser = std::numeric_limits<double>::infinity();
+    for (uint32_t d = 0; d <= n / 2; d++)
+    {
+        const double k = n - d;
+        const double squaredDeviations = std::max(0.0, sumOfSquares - sum * sum / k);
+        const double mser = squaredDeviations / (k * k);
+        if (mser < minMser)
+        {
+            minMser = mser;
+            truncation = d;
+        }
+        sum -= m_batchMeans[d];
+        sumOfSquares -= m_batchMeans[d] * m_batchMeans[d];
+    }
+
+    const uint32_t retained = n - truncation;
+    estimate.truncatedCount = truncation * m_batchSize;
+    estimate.retainedCount = retained * m_batchSize;
+
+    // Regroup the most recent retained batches into batches of equal size.
+    const uint32_t groupSize = retained / NUM_OF_CI_BATCHES;
+    if (groupSize == 0)
+    {
+        double retainedSum = 0.0;
+        for (uint32_t i = truncation; i < n; i++)
+        {
+            retainedSum += m_batchMeans[i];
+        }
+        estimate.mean = retainedSum / retained;
+        return estimate;
+    }
+
+    const uint32_t first = n - groupSize * NUM_OF_CI_BATCHES;
+    double groupMeans[NUM_OF_CI_BATCHES];
+    double mean = 0.0;
+    for (uint32_t g = 0; g < NUM_OF_CI_BATCHES; g++)
+    {
+        double groupSum = 0.0;
+        for (uint32_t i = 0; i < groupSize; i++)
+        {
+            groupSum += m_batchMeans[first + g * groupSize + i];
+        }
+        groupMeans[g] = groupSum / groupSize;
+        mean += groupMeans[g];
+    }
+    mean /= NUM_OF_CI_BATCHES;
+
+    double variance = 0.0;
+    for (uint32_t g = 0; g < NUM_OF_CI_BATCHES; g++)
+    {
+        variance += (groupMeans[g] - mean) * (groupMeans[g] - mean);
+    }
+    variance /= NUM_OF_CI_BATCHES - 1;
+
+    estimate.mean = mean;
+    estimate.halfWidth = T_QUANTILE * std::sqrt(variance / NUM_OF_CI_BATCHES);
+    if (estimate.halfWidth == 0.0)
+    {
+        estimate.relativePrecision = 0.0;
+    }
+    else if (mean != 0.0)
+    {
+        estimate.relativePrecision = estimate.halfWidth / std::abs(mean);
+    }
+
+    return estimate;
+
+} // end of `Estimate_t GetEstimate () const`
+
+void
+ApplicationStatsSteadyState::MergeBatches()
+{
+    const uint32_t n = m_batchMeans.size() / 2;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        m_batchMeans[i] = (m_batchMeans[2 * i] + m_batchMeans[2 * i + 1]) / 2.0;
+    }
+    m_batchMeans.resize(n);
+    m_batchSize *= 2;
+}
+
+} // end of namespace ns3
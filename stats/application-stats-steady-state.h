@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_STEADY_STATE_H
+#define APPLICATION_STATS_STEADY_STATE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Streaming detection of the end of the warm-up period of a series of
+ *        samples, and confidence interval of its steady-state mean.
+ *
+ * The samples are grouped into batches of BATCH_SIZE samples, and only the
+ * batch means are kept. The warm-up truncation point is chosen using the
+ * MSER-5 rule (K. P. White, Jr., "An effective truncation heuristic for bias
+ * reduction in simulation output," Simulation, vol. 69, no. 6, 1997), i.e.,
+ * the number of leading batches, at most half of them, whose removal minimizes
+ * the variance of the remaining batch means divided by their number. The
+ * remaining batches are then regrouped into NUM_OF_CI_BATCHES batches of
+ * equal size, and the 95% confidence interval of the steady-state mean is
+ * computed from them with the batch means method.
+ *
+ * Memory is bounded by the maximum number of batches given to the
+ * constructor. Once it is reached, every two adjacent batches are merged into
+ * one, which doubles the batch size, so MSER-5 gradually becomes MSER-10,
+ * MSER-20, and so on in long simulations.
+ */
+class ApplicationStatsSteadyState
+{
+  public:
+    /// Number of samples in a batch before any merging, i.e., the 5 of MSER-5.
+    static const uint32_t BATCH_SIZE = 5;
+
+    /// Number of batches from which the confidence interval is computed.
+    static const uint32_t NUM_OF_CI_BATCHES = 20;
+
+    /// Estimates computed by GetEstimate().
+    struct Estimate_t
+    {
+        uint64_t truncatedCount;  ///< Number of leading samples discarded as warm-up.
+        uint64_t retainedCount;   ///< Number of samples after the truncation point.
+        double mean;              ///< Steady-state mean of the retained samples.
+        double halfWidth;         ///< Half-width of the 95% confidence interval of the mean.
+        double relativePrecision; ///< Half-width divided by the absolute value of the mean.
+    };
+
+    /**
+     * \brief Create an empty estimator.
+     * \param maxNumOfBatches number of batches kept before adjacent batches are
+     *                        merged; must be even and at least twice
+     *                        NUM_OF_CI_BATCHES.
+     */
+    explicit ApplicationStatsSteadyState(uint32_t maxNumOfBatches = 1024);
+
+    /**
+     * \param sample a new observation.
+     */
+    void AddSample(double sample);
+
+    /**
+     * \return number of samples received so far.
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * \return the current number of samples in a batch.
+     */
+    uint64_t GetBatchSize() const;
+
+    /**
+     * \brief Compute the truncation point and the confidence interval of the
+     *        samples received so far.
+     * \return the estimates. The relative precision is infinite if there are
+     *         not enough retained batches to compute the confidence interval,
+     *         or if the mean is zero while the half-width is not.
+     *
+     * The cost is linear in the number of batches kept. The samples of the
+     * incomplete last batch are not taken into account.
+     */
+    Estimate_t GetEstimate() const;
+
+  private:
+    /// Merge every two adjacent batches in #m_batchMeans.
+    void MergeBatches();
+
+    uint32_t m_maxNumOfBatches;       ///< Number of batches kept before merging.
+    uint64_t m_count;                 ///< Number of samples.
+    uint64_t m_batchSize;             ///< Number of samples in a complete batch.
+    std::vector<double> m_batchMeans; ///< Means of the complete batches.
+    double m_partialSum;              ///< Sum of the samples of the incomplete batch.
+    uint64_t m_partialCount;          ///< Number of samples of the incomplete batch.
+
+}; // end of class ApplicationStatsSteadyState
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_STEADY_STATE_H */
@@ -0,0 +1,274 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-summary.h"
+
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+// P-SQUARE QUANTILE ESTIMATOR ////////////////////////////////////////////////
+
+ApplicationStatsP2Quantile::ApplicationStatsP2Quantile(double probability)
+    : m_probability(probability),
+      m_count(0)
+{
+    NS_ASSERT_MSG(probability >= 0.0 && probability <= 1.0,
+                  "Invalid probability " << probability);
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        m_height[i] = 0.0;
+        m_position[i] = i;
+    }
+
+    m_desired[0] = 0.0;
+    m_desired[1] = 2.0 * probability;
+    m_desired[2] = 4.0 * probability;
+    m_desired[3] = 2.0 + 2.0 * probability;
+    m_desired[4] = 4.0;
+
+    m_increment[0] = 0.0;
+    m_increment[1] = probability / 2.0;
+    m_increment[2] = probability;
+    m_increment[3] = (1.0 + probability) / 2.0;
+    m_increment[4] = 1.0;
+}
+
+void
+ApplicationStatsP2Quantile::AddSample(double sample)
+{
+    if (m_count < 5)
+    {
+        // The first five samples become the initial marker heights.
+        m_height[m_count] = sample;
+        m_count++;
+        if (m_count == 5)
+        {
+            std::sort(m_height, m_height + 5);
+        }
+        return;
+    }
+
+    m_count++;
+
+    // Find the cell which contains the sample, extending the extremes if needed.
+    uint32_t k;
+    if (sample < m_height[0])
+    {
+        m_height[0] = sample;
+        k = 0;
+    }
+    else if (sample < m_height[1])
+    {
+        k = 0;
+    }
+    else if (sample < m_height[2])
+    {
+        k = 1;
+    }
+    else if (sample < m_height[3])
+    {
+        k = 2;
+    }
+    else if (sample <= m_height[4])
+    {
+        k = 3;
+    }
+    else
+    {
+        m_height[4] = sample;
+        k = 3;
+    }
+
+    for (uint32_t i = k + 1; i < 5; i++)
+    {
+        m_position[i] += 1.0;
+    }
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        m_desired[i] += m_increment[i];
+    }
+
+    // Adjust the heights of the three middle markers if necessary.
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        const double d = m_desired[i] - m_position[i];
+
+        if ((d >= 1.0 && m_position[i + 1] - m_position[i] > 1.0) ||
+            (d <= -1.0 && m_position[i - 1] - m_position[i] < -1.0))
+        {
+            const double sign = (d >= 0.0) ? 1.0 : -1.0;
+            const double height = Parabolic(i, sign);
+
+            if (m_height[i - 1] < height && height < m_height[i + 1])
+            {
+                m_height[i] = height;
+            }
+            else
+            {
+                m_height[i] = Linear(i, sign);
+            }
+
+            m_position[i] += sign;
+        }
+    }
+
+} // end of `void AddSample (double)`
+
+double
+ApplicationStatsP2Quantile::GetQuantile() const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+
+    if (m_count < 5)
+    {
+        // Not enough samples for the markers yet, so compute it exactly.
+        double sorted[5];
+        std::copy(m_height, m_height + m_count, sorted);
+        std::sort(sorted, sorted + m_count);
+        // nearest-rank method
+        const double rank = std::ceil(m_probability * m_count);
+        const uint32_t index = (rank < 1.0) ? 0 : static_cast<uint32_t>(rank) - 1;
+        return sorted[std::min<uint32_t>(index, m_count - 1)];
+    }
+
+    return m_height[2];
+}
+
+double
+ApplicationStatsP2Quantile::GetProbability() const
+{
+    return m_probability;
+}
+
+double
+ApplicationStatsP2Quantile::Parabolic(uint32_t i, double d) const
+{
+    const double n0 = m_position[i - 1];
+    const double n1 = m_position[i];
+    const double n2 = m_position[i + 1];
+    return m_height[i] + d / (n2 - n0) *
+                             ((n1 - n0 + d) * (m_height[i + 1] - m_height[i]) / (n2 - n1) +
+                              (n2 - n1 - d) * (m_height[i] - m_height[i - 1]) / (n1 - n0));
+}
+
+double
+ApplicationStatsP2Quantile::Linear(uint32_t i, double d) const
+{
+    const uint32_t j = (d > 0.0) ? i + 1 : i - 1;
+    return m_height[i] + d * (m_height[j] - m_height[i]) / (m_position[j] - m_position[i]);
+}
+
+// SUMMARY STATISTICS /////////////////////////////////////////////////////////
+
+ApplicationStatsSummary::ApplicationStatsSummary()
+    : m_count(0),
+      m_mean(0.0),
+      m_m2(0.0),
+      m_min(0.0),
+      m_max(0.0),
+      m_p50(0.50),
+      m_p95(0.95),
+      m_p99(0.99)
+{
+}
+
+void
+ApplicationStatsSummary::AddSample(double sample)
+{
+    if (m_count == 0)
+    {
+        m_min = sample;
+        m_max = sample;
+    }
+    else
+    {
+        m_min = std::min(m_min, sample);
+        m_max = std::max(m_max, sample);
+    }
+
+    // Welford's method.
+    m_count++;
+    const double delta = sample - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (sample - m_mean);
+
+    m_p50.AddSample(sample);
+    m_p95.AddSample(sample);
+    m_p99.AddSample(sample);
+}
+
+uint64_t
+ApplicationStatsSummary::GetCount() const
+{
+    return m_count;
+}
+
+double
+ApplicationStatsSummary::GetMean() const
+{
+    return m_mean;
+}
+
+double
+ApplicationStatsSummary::GetStdDev() const
+{
+    return (m_count > 1) ? std::sqrt(m_m2 / (m_count - 1)) : 0.0;
+}
+
+double
+ApplicationStatsSummary::GetMin() const
+{
+    return m_min;
+}
+
+double
+ApplicationStatsSummary::GetMax() const
+{
+    return m_max;
+}
+
+double
+ApplicationStatsSummary::GetP50() const
+{
+    return m_p50.GetQuantile();
+}
+
+double
+ApplicationStatsSummary::GetP95() const
+{
+    return m_p95.GetQuantile();
+}
+
+double
+ApplicationStatsSummary::GetP99() const
+{
+    return m_p99.GetQuantile();
+}
+
+} // end of namespace ns3
@@ -0,0 +1,164 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_SUMMARY_H
+#define APPLICATION_STATS_SUMMARY_H
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup applicationstats
+ * \brief Streaming estimator of a single quantile using the P-square
+ *        algorithm.
+ *
+ * The algorithm is described in R. Jain and I. Chlamtac, "The P^2 algorithm
+ * for dynamic calculation of quantiles and histograms without storing
+ * observations," Communications of the ACM, vol. 28, no. 10, 1985.
+ *
+ * Only five markers are kept, regardless of the number of samples. Until five
+ * samples have been received, the exact quantile of the samples is returned.
+ */
+class ApplicationStatsP2Quantile
+{
+  public:
+    /**
+     * \brief Create a new estimator.
+     * \param probability the quantile to be estimated, between 0 and 1.
+     */
+    explicit ApplicationStatsP2Quantile(double probability = 0.5);
+
+    /**
+     * \param sample a new observation.
+     */
+    void AddSample(double sample);
+
+    /**
+     * \return the current estimate of the quantile, or zero if no sample has
+     *         been received yet.
+     */
+    double GetQuantile() const;
+
+    /**
+     * \return the quantile which is estimated, between 0 and 1.
+     */
+    double GetProbability() const;
+
+  private:
+    /**
+     * \param i index of the marker to be adjusted.
+     * \param d direction of the adjustment, either -1 or +1.
+     * \return the piecewise-parabolic prediction of the new marker height.
+     */
+    double Parabolic(uint32_t i, double d) const;
+
+    /**
+     * \param i index of the marker to be adjusted.
+     * \param d direction of the adjustment, either -1 or +1.
+     * \return the linear prediction of the new marker height.
+     */
+    double Linear(uint32_t i, double d) const;
+
+    double m_probability;  ///< The quantile to be estimated.
+    uint64_t m_count;      ///< Number of samples received so far.
+    double m_height[5];    ///< Marker heights.
+    double m_position[5];  ///< Actual marker positions.
+    double m_desired[5];   ///< Desired marker positions.
+    double m_increment[5]; ///< Increments of the desired marker positions.
+
+}; // end of class ApplicationStatsP2Quantile
+
+/**
+ * \ingroup applicationstats
+ * \brief Streaming summary statistics of a series of samples.
+ *
+ * Keeps the number of samples, the mean and the variance (using Welford's
+ * method), the minimum and maximum values, and estimates of the 50th, 95th,
+ * and 99th percentiles (see ApplicationStatsP2Quantile). The memory usage is
+ * constant, regardless of the number of samples.
+ */
+class ApplicationStatsSummary
+{
+  public:
+    /// Create an empty summary.
+    ApplicationStatsSummary();
+
+    /**
+     * \param sample a new observation.
+     */
+    void AddSample(double sample);
+
+    /**
+     * \return number of samples received so far.
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * \return the mean of the samples, or zero if there is no sample.
+     */
+    double GetMean() const;
+
+    /**
+     * \return the sample standard deviation, or zero if there are less than two
+     *         samples.
+     */
+    double GetStdDev() const;
+
+    /**
+     * \return the smallest sample, or zero if there is no sample.
+     */
+    double GetMin() const;
+
+    /**
+     * \return the largest sample, or zero if there is no sample.
+     */
+    double GetMax() const;
+
+    /**
+     * \return the estimated median of the samples.
+     */
+    double GetP50() const;
+
+    /**
+     * \return the estimated 95th percentile of the samples.
+     */
+    double GetP95() const;
+
+    /**
+     * \return the estimated 99th percentile of the samples.
+     */
+    double GetP99() const;
+
+  private:
+    uint64_t m_count;                 ///< Number of samples.
+    double m_mean;                    ///< Running mean.
+    double m_m2;                      ///< Running sum of squared differences from the mean.
+    double m_min;                     ///< Smallest sample.
+    double m_max;                     ///< Largest sample.
+    ApplicationStatsP2Quantile m_p50; ///< Estimator of the 50th percentile.
+    ApplicationStatsP2Quantile m_p95; ///< Estimator of the 95th percentile.
+    ApplicationStatsP2Quantile m_p99; ///< Estimator of the 99th percentile.
+
+}; // end of class ApplicationStatsSummary
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_SUMMARY_H */
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "application-stats-telemetry.h"
+
+#include <ns3/abort.h>
+#include <ns3/application-stats-helper-container.h>
+#include <ns3/application-stats-summary.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/trace-source-accessor.h>
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsTelemetry");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsTelemetry);
+
+ApplicationStatsTelemetry::ApplicationStatsTelemetry()
+    : m_fileName("telemetry.txt"),
+      m_interval(Seconds(10)),
+      m_numOfSnapshots(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId // static
+ApplicationStatsTelemetry::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ApplicationStatsTelemetry")
+            .SetParent<Object>()
+            .AddConstructor<ApplicationStatsTelemetry>()
+            .AddAttribute("FileName",
+                          "Name of the append-only file receiving the snapshots",
+                          StringValue("telemetry.txt"),
+                          MakeStringAccessor(&ApplicationStatsTelemetry::m_fileName),
+                          MakeStringChecker())
+            .AddAttribute("Interval",
+                          "Interval between two snapshots of the running summaries",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&ApplicationStatsTelemetry::m_interval),
+                          MakeTimeChecker())
+            .AddTraceSource("Snapshot",
+                            "A snapshot has been handed over to the output file",
+                            MakeTraceSourceAccessor(&ApplicationStatsTelemetry::m_snapshotTrace),
+                            "ns3::Time::TracedCallback");
+    return tid;
+}
+
+void
+ApplicationStatsTelemetry::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_snapshotEvent.Cancel();
+    m_stats.clear();
+
+    if (m_writer != nullptr)
+    {
+        m_writer->Close();
+        m_writer = nullptr;
+    }
+
+    Object::DoDispose();
+}
+
+void
+ApplicationStatsTelemetry::AddStats(Ptr<const ApplicationStatsHelper> stat)
+{
+    NS_LOG_FUNCTION(this << stat);
+    NS_ASSERT(stat != nullptr);
+
+    if (stat->GetOutputType() != ApplicationStatsHelper::OUTPUT_SUMMARY)
+    {
+        NS_LOG_WARN(this << " " << stat->GetName() << " is not included in the snapshots,"
+                         << " because only SUMMARY output type is supported");
+        return;
+    }
+
+    m_stats.push_back(stat);
+
+    if (!m_snapshotEvent.IsRunning())
+    {
+        NS_ABORT_MSG_UNLESS(m_interval.IsStrictlyPositive(),
+                            "Telemetry interval must be positive");
+        m_snapshotEvent =
+            Simulator::Schedule(m_interval, &ApplicationStatsTelemetry::PeriodicSnapshot, this);
+    }
+}
+
+void
+ApplicationStatsTelemetry::AddStats(Ptr<const ApplicationStatsHelperContainer> container)
+{
+    NS_LOG_FUNCTION(this << container);
+    NS_ASSERT(container != nullptr);
+
+    for (uint32_t i = 0; i < container->GetNumOfStats(); i++)
+    {
+        AddStats(container->GetStats(i));
+    }
+}
+
+void
+ApplicationStatsTelemetry::Snapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::ostringstream oss;
+    if (m_writer == nullptr)
+    {
+        m_writer = Create<ApplicationStatsAsyncWriter>(m_fileName, 65536, 4);
+        m_wallClockStart = std::chrono::steady_clock::now();
+        oss << "% time_sec wall_sec stat identifier"
+            << " count mean stddev min max p50 p95 p99\n";
+    }
+
+    const double now = Simulator::Now().GetSeconds();
+    const double wallClock =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallClockStart)
+            .count();
+    uint32_t numOfRows = 0;
+
+    for (std::list<Ptr<const ApplicationStatsHelper>>::const_iterator it = m_stats.begin();
+         it != m_stats.end();
+         ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNumOfSummaries(); i++)
+        {
+            const ApplicationStatsSummary& summary = (*it)->GetSummary(i);
+            oss << now << " " << wallClock << " " << (*it)->GetName() << " "
+                << (*it)->GetSummaryName(i) << " " << summary.GetCount() << " "
+                << summary.GetMean() << " " << summary.GetStdDev() << " " << summary.GetMin()
+                << " " << summary.GetMax() << " " << summary.GetP50() << " " << summary.GetP95()
+                << " " << summary.GetP99() << "\n";
+            numOfRows++;
+        }
+    }
+
+    const std::string lines = oss.str();
+    m_writer->Write(lines.data(), lines.size());
+    m_writer->Flush();
+    m_numOfSnapshots++;
+    NS_LOG_INFO(this << " snapshot " << m_numOfSnapshots << " with " << numOfRows << " row(s)");
+    m_snapshotTrace(Simulator::Now());
+
+} // end of `void Snapshot ()`
+
+uint32_t
+ApplicationStatsTelemetry::GetNumOfSnapshots() const
+{
+    return m_numOfSnapshots;
+}
+
+void
+ApplicationStatsTelemetry::PeriodicSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    Snapshot();
+    m_snapshotEvent =
+        Simulator::Schedule(m_interval, &ApplicationStatsTelemetry::PeriodicSnapshot, this);
+}
+
+} // end of namespace ns3
@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef APPLICATION_STATS_TELEMETRY_H
+#define APPLICATION_STATS_TELEMETRY_H
+
+#include <ns3/application-stats-async-writer.h>
+#include <ns3/application-stats-helper.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+#include <ns3/traced-callback.h>
+
+#include <chrono>
+#include <list>
+#include <string>
+
+namespace ns3
+{
+
+class ApplicationStatsHelperContainer;
+
+/**
+ * \ingroup applicationstats
+ * \brief Periodic export of the running summaries of statistics helpers while
+ *        the simulation is still running.
+ *
+ * The summaries of the statistics with `OUTPUT_SUMMARY` output type are kept
+ * in memory and written only upon disposal. Every `Interval`, this object takes
+ * a snapshot of the running summary (count, mean, standard deviation, minimum,
+ * maximum, and percentiles) of every identifier of the statistics added to it,
+ * e.g., of the throughput, delay, or page load time, and appends it to
+ * `FileName`. The first line of the file is a heading, and each following line
+ * has the columns:
+ * - simulation time of the snapshot in seconds;
+ * - wall-clock time since the first snapshot in seconds;
+ * - name of the statistic;
+ * - name of the identifier; and
+ * - the columns of the summary file, from `count` to `p99`.
+ *
+ * The snapshot costs work only at the time of the snapshot, proportional to
+ * the number of identifiers, and nothing per sample. The lines are formatted
+ * on the simulator thread and handed over to an ApplicationStatsAsyncWriter,
+ * whose background thread appends them to the file and flushes it, so that
+ * external tools can follow the file, e.g., with `tail -f`, and stop a run
+ * which does not converge.
+ *
+ * Snapshots are scheduled as long as the simulation runs, so the simulation
+ * must be ended with Simulator::Stop().
+ *
+ * \code
+ *     Ptr<ApplicationStatsTelemetry> telemetry = CreateObject<ApplicationStatsTelemetry> ();
+ *     telemetry->SetAttribute ("Interval", TimeValue (Seconds (60)));
+ *     telemetry->AddStats (stat); // a container with SUMMARY output types
+ * \endcode
+ */
+class ApplicationStatsTelemetry : public Object
+{
+  public:
+    /// Creates a new instance without any statistics.
+    ApplicationStatsTelemetry();
+
+    // inherited from ObjectBase base class
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Include a statistic in the following snapshots.
+     * \param stat the statistic. Only those with `OUTPUT_SUMMARY` output type
+     *             contribute to the snapshots.
+     *
+     * The first statistic schedules the first snapshot after `Interval`.
+     */
+    void AddStats(Ptr<const ApplicationStatsHelper> stat);
+
+    /**
+     * \brief Include every statistic of a container in the following
+     *        snapshots.
+     * \param container the container. Only the statistics which have been
+     *                  added to it so far are included.
+     */
+    void AddStats(Ptr<const ApplicationStatsHelperContainer> container);
+
+    /**
+     * \brief Append a snapshot to the file immediately, in addition to the
+     *        periodic ones.
+     */
+    void Snapshot();
+
+    /**
+     * \return the number of snapshots taken so far.
+     */
+    uint32_t GetNumOfSnapshots() const;
+
+  protected:
+    // Inherited from Object base class
+    virtual void DoDispose();
+
+  private:
+    /// Take a snapshot and schedule the next one.
+    void PeriodicSnapshot();
+
+    std::string m_fileName;                    ///< `FileName` attribute.
+    Time m_interval;                           ///< `Interval` attribute.
+    Ptr<ApplicationStatsAsyncWriter> m_writer; ///< Output file, opened on the first snapshot.
+    uint32_t m_numOfSnapshots;                 ///< Number of snapshots taken.
+    EventId m_snapshotEvent;                   ///< The next periodic snapshot.
+
+    /// Statistics included in the snapshots.
+    std::list<Ptr<const ApplicationStatsHelper>> m_stats;
+
+    /// Wall-clock time of the first snapshot.
+    std::chrono::steady_clock::time_point m_wallClockStart;
+
+    /// `Snapshot` trace source, fired with the simulation time of each snapshot.
+    TracedCallback<Time> m_snapshotTrace;
+
+}; // end of class ApplicationStatsTelemetry
+
+} // end of namespace ns3
+
+#endif /* APPLICATION_STATS_TELEMETRY_H */
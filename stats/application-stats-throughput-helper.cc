@@ -21,6 +21,7 @@
 
 #include "application-stats-throughput-helper.h"
 
+#include <ns3/abort.h>
 #include <ns3/application-container.h>
 #include <ns3/application-packet-probe.h>
 #include <ns3/boolean.h>
@@ -30,14 +31,18 @@
 #include <ns3/gnuplot-aggregator.h>
 #include <ns3/inet-socket-address.h>
 #include <ns3/interval-rate-collector.h>
-#include <ns3/ipv4.h>
 #include <ns3/log.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/node.h>
+#include <ns3/nrtv-tcp-client.h>
+#include <ns3/nrtv-udp-client.h>
 #include <ns3/nstime.h>
+#include <ns3/packet-sink.h>
 #include <ns3/probe.h>
 #include <ns3/scalar-collector.h>
+#include <ns3/simulator.h>
 #include <ns3/string.h>
+#include <ns3/three-gpp-http-satellite-client.h>
 #include <ns3/unit-conversion-collector.h>
 #include <ns3/unused.h>
 
@@ -51,8 +56,10 @@ namespace ns3
 NS_OBJECT_ENSURE_REGISTERED(ApplicationStatsThroughputHelper);
 
 ApplicationStatsThroughputHelper::ApplicationStatsThroughputHelper()
-    : m_averagingMode(false)
-
+    : m_averagingMode(false),
+      m_summaryInterval(Seconds(1)),
+      m_pollingMode(false),
+      m_pollingInterval(Seconds(1))
 {
     NS_LOG_FUNCTION(this);
 }
@@ -74,7 +81,31 @@ ApplicationStatsThroughputHelper::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&ApplicationStatsThroughputHelper::SetAveragingMode,
                                               &ApplicationStatsThroughputHelper::GetAveragingMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("SummaryInterval",
+                          "Length of the intervals used to compute throughput samples "
+                          "when SUMMARY output type is selected.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&ApplicationStatsThroughputHelper::SetSummaryInterval,
+                                           &ApplicationStatsThroughputHelper::GetSummaryInterval),
+                          MakeTimeChecker())
+            .AddAttribute("PollingMode",
+                          "If true, the received byte counters of the receiver applications "
+                          "are read once per PollingInterval by a single event, instead of "
+                          "listening to every received packet. Only supports GLOBAL and "
+                          "RECEIVER identifier types, and SCATTER_FILE, SCATTER_PLOT, "
+                          "SCATTER_BINARY_FILE, and SUMMARY output types.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApplicationStatsThroughputHelper::SetPollingMode,
+                                              &ApplicationStatsThroughputHelper::GetPollingMode),
+                          MakeBooleanChecker())
+            .AddAttribute("PollingInterval",
+                          "Length of the intervals between two polls of the received byte "
+                          "counters when PollingMode is enabled.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&ApplicationStatsThroughputHelper::SetPollingInterval,
+                                           &ApplicationStatsThroughputHelper::GetPollingInterval),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -91,13 +122,218 @@ ApplicationStatsThroughputHelper::GetAveragingMode() const
     return m_averagingMode;
 }
 
+void
+ApplicationStatsThroughputHelper::SetSummaryInterval(Time summaryInterval)
+{
+    NS_LOG_FUNCTION(this << summaryInterval.GetSeconds());
+    NS_ASSERT_MSG(summaryInterval.IsStrictlyPositive(), "Summary interval must be positive");
+    m_summaryInterval = summaryInterval;
+}
+
+Time
+ApplicationStatsThroughputHelper::GetSummaryInterval() const
+{
+    return m_summaryInterval;
+}
+
+void
+ApplicationStatsThroughputHelper::SetPollingMode(bool pollingMode)
+{
+    NS_LOG_FUNCTION(this << pollingMode);
+
+    if (IsInstalled() && (m_pollingMode != pollingMode))
+    {
+        NS_LOG_WARN(this << " cannot modify the current polling mode"
+                         << " because this instance have already been installed");
+    }
+    else
+    {
+        m_pollingMode = pollingMode;
+    }
+}
+
+bool
+ApplicationStatsThroughputHelper::GetPollingMode() const
+{
+    return m_pollingMode;
+}
+
+void
+ApplicationStatsThroughputHelper::SetPollingInterval(Time pollingInterval)
+{
+    NS_LOG_FUNCTION(this << pollingInterval.GetSeconds());
+    NS_ASSERT_MSG(pollingInterval.IsStrictlyPositive(), "Polling interval must be positive");
+    m_pollingInterval = pollingInterval;
+}
+
+Time
+ApplicationStatsThroughputHelper::GetPollingInterval() const
+{
+    return m_pollingInterval;
+}
+
+Callback<uint64_t> // static
+ApplicationStatsThroughputHelper::GetRxCounter(Ptr<Application> application)
+{
+    Ptr<PacketSink> packetSink = DynamicCast<PacketSink>(application);
+    if (packetSink != nullptr)
+    {
+        return MakeCallback(&PacketSink::GetTotalRx, packetSink);
+    }
+
+    Ptr<NrtvTcpClient> nrtvClient = DynamicCast<NrtvTcpClient>(application);
+    if (nrtvClient != nullptr)
+    {
+        return MakeCallback(&NrtvTcpClient::GetTotalRx, nrtvClient);
+    }
+
+    Ptr<NrtvUdpClient> nrtvUdpClient = DynamicCast<NrtvUdpClient>(application);
+    if (nrtvUdpClient != nullptr)
+    {
+        return MakeCallback(&NrtvUdpClient::GetTotalRx, nrtvUdpClient);
+    }
+
+    Ptr<ThreeGppHttpSatelliteClient> httpClient =
+        DynamicCast<ThreeGppHttpSatelliteClient>(application);
+    if (httpClient != nullptr)
+    {
+        return MakeCallback(&ThreeGppHttpSatelliteClient::GetTotalRx, httpClient);
+    }
+
+    return MakeNullCallback<uint64_t>();
+}
+
+void
+ApplicationStatsThroughputHelper::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_pollingEvent.Cancel();
+    m_rxCounters.clear();
+    m_lastRxBytes.clear();
+    ApplicationStatsHelper::DoDispose(); // chain up
+}
+
 void
 ApplicationStatsThroughputHelper::DoInstall()
 {
     NS_LOG_FUNCTION(this);
 
+    if (m_pollingMode)
+    {
+        InstallPolling();
+        return;
+    }
+
+    if (IsInlinePipeline() && (GetOutputType() == ApplicationStatsHelper::OUTPUT_SCATTER_FILE))
+    {
+        /*
+         * Compute the throughput of each identifier over one-second intervals
+         * inline, like the default IntervalRateCollector, without probes and
+         * collectors.
+         */
+        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+                                        "OutputFileName",
+                                        StringValue(GetName()),
+                                        "GeneralHeading",
+                                        StringValue("% time_sec throughput_kbps"));
+        typedef ApplicationStatsInlinePipeline<ApplicationStatsInlineIntervalRate> Pipeline_t;
+        Ptr<Pipeline_t> pipeline = Create<Pipeline_t>(GetIdentifierNames().size(),
+                                                      ApplicationStatsInlineIntervalRate(1.0),
+                                                      CreateInlineOutput(m_aggregator));
+        const uint32_t n =
+            SetupInlineSinksAtReceiver<Ptr<const Packet>, ApplicationStatsPacketConversion>(
+                pipeline);
+        NS_LOG_INFO(this << " connected to " << n << " trace sources");
+        return;
+    }
+
     // Setup aggregators and collectors.
 
+    if (IsSlidingWindow())
+    {
+        // The sliding window replaces the collectors.
+        InstallDirectOutput();
+        CreateSlidingWindow(ApplicationStatsSlidingWindow::OUTPUT_RATE, 8.0 / 1000.0);
+    }
+    else
+    {
+        InstallCollectors();
+    }
+
+    // Setup probes and connect them to the collectors.
+
+    switch (GetIdentifierType())
+    {
+    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
+    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
+        if (GetBoundTraceSinks() || GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY ||
+            m_slidingWindow != nullptr)
+        {
+            /*
+             * Connect each receiver to its own trace sink, which passes the
+             * samples directly to the first-level collector with the bound
+             * identifier.
+             */
+            CreateConversionCollectorList();
+            const uint32_t n = SetupBoundListenersAtReceiver(
+                MakeCallback(&ApplicationStatsThroughputHelper::PassSampleToCollector, this));
+            NS_LOG_INFO(this << " connected to " << n << " trace sources");
+            break;
+        }
+
+        /*
+         * Install a probe on each receiver and connect them to the
+         * first-level collectors.
+         */
+        const uint32_t n = SetupProbesAtReceiver<ApplicationPacketProbe>(
+            "OutputBytes",
+            m_conversionCollectors,
+            &UnitConversionCollector::TraceSinkUinteger32,
+            m_probes);
+        NS_LOG_INFO(this << " created " << n << " instance(s)"
+                         << " of ApplicationPacketProbe");
+        break;
+    }
+
+    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
+        // Create a look-up table of sender addresses and collector identifiers.
+        m_addressTable.Clear();
+        uint32_t identifier = 0;
+        std::map<std::string, ApplicationContainer>::const_iterator it1;
+        for (it1 = m_senderInfo.begin(); it1 != m_senderInfo.end(); ++it1)
+        {
+            for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+                 ++it2)
+            {
+                SaveAddressAndIdentifier(*it2, identifier);
+            }
+
+            identifier++;
+        }
+        m_addressTable.Build();
+        CreateConversionCollectorList();
+
+        // Connect with trace sources in receiver applications.
+        const uint32_t n = SetupListenersAtReceiver(
+            MakeCallback(&ApplicationStatsThroughputHelper::RxCallback, this));
+        NS_LOG_INFO(this << " connected to " << n << " trace sources");
+        break;
+    }
+
+    default:
+        NS_FATAL_ERROR("ApplicationStatsThroughputHelper - Invalid identifier type");
+        break;
+
+    } // end of `switch (GetIdentifierType ())`
+
+} // end of `void DoInstall ();`
+
+void
+ApplicationStatsThroughputHelper::InstallCollectors()
+{
+    NS_LOG_FUNCTION(this);
+
     switch (GetOutputType())
     {
     case ApplicationStatsHelper::OUTPUT_NONE:
@@ -153,9 +389,17 @@ ApplicationStatsThroughputHelper::DoInstall()
         m_terminalCollectors.SetAttribute("InputDataType",
                                           EnumValue(IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
         CreateCollectorPerIdentifier(m_terminalCollectors);
-        m_terminalCollectors.ConnectToAggregator("OutputWithTime",
-                                                 m_aggregator,
-                                                 &MultiFileAggregator::Write2d);
+        if (IsScatterSampling())
+        {
+            CreateScatterSampler(m_aggregator);
+            ConnectCollectorsToScatterSampler(m_terminalCollectors, "OutputWithTime");
+        }
+        else
+        {
+            m_terminalCollectors.ConnectToAggregator("OutputWithTime",
+                                                     m_aggregator,
+                                                     &MultiFileAggregator::Write2d);
+        }
         m_terminalCollectors.ConnectToAggregator("OutputString",
                                                  m_aggregator,
                                                  &MultiFileAggregator::AddContextHeading);
@@ -171,6 +415,36 @@ ApplicationStatsThroughputHelper::DoInstall()
         break;
     }
 
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE: {
+        // Setup the binary writer instead of an aggregator.
+        CreateBinaryWriter("time_sec", "throughput_kbps");
+
+        // Setup second-level collectors.
+        m_terminalCollectors.SetType("ns3::IntervalRateCollector");
+        m_terminalCollectors.SetAttribute("InputDataType",
+                                          EnumValue(IntervalRateCollector::INPUT_DATA_TYPE_DOUBLE));
+        CreateCollectorPerIdentifier(m_terminalCollectors);
+        if (IsScatterSampling())
+        {
+            CreateScatterSampler(nullptr);
+            ConnectCollectorsToScatterSampler(m_terminalCollectors, "OutputWithTime");
+        }
+        else
+        {
+            ConnectCollectorsToBinaryWriter(m_terminalCollectors, "OutputWithTime");
+        }
+
+        // Setup first-level collectors.
+        m_conversionCollectors.SetType("ns3::UnitConversionCollector");
+        m_conversionCollectors.SetAttribute("ConversionType",
+                                            EnumValue(UnitConversionCollector::FROM_BYTES_TO_KBIT));
+        CreateCollectorPerIdentifier(m_conversionCollectors);
+        m_conversionCollectors.ConnectToCollector("Output",
+                                                  m_terminalCollectors,
+                                                  &IntervalRateCollector::TraceSinkDouble);
+        break;
+    }
+
     case ApplicationStatsHelper::OUTPUT_HISTOGRAM_FILE:
     case ApplicationStatsHelper::OUTPUT_PDF_FILE:
     case ApplicationStatsHelper::OUTPUT_CDF_FILE: {
@@ -274,9 +548,17 @@ ApplicationStatsThroughputHelper::DoInstall()
             const std::string context = it->second->GetName();
             plotAggregator->Add2dDataset(context, context);
         }
-        m_terminalCollectors.ConnectToAggregator("OutputWithTime",
-                                                 m_aggregator,
-                                                 &GnuplotAggregator::Write2d);
+        if (IsScatterSampling())
+        {
+            CreateScatterSampler(m_aggregator);
+            ConnectCollectorsToScatterSampler(m_terminalCollectors, "OutputWithTime");
+        }
+        else
+        {
+            m_terminalCollectors.ConnectToAggregator("OutputWithTime",
+                                                     m_aggregator,
+                                                     &GnuplotAggregator::Write2d);
+        }
 
         // Setup first-level collectors.
         m_conversionCollectors.SetType("ns3::UnitConversionCollector");
@@ -352,61 +634,24 @@ ApplicationStatsThroughputHelper::DoInstall()
         break;
     }
 
-    default:
-        NS_FATAL_ERROR("ApplicationStatsThroughputHelper - Invalid output type");
-        break;
-
-    } // end of `switch (GetOutputType ())`
-
-    // Setup probes and connect them to the collectors.
-
-    switch (GetIdentifierType())
-    {
-    case ApplicationStatsHelper::IDENTIFIER_GLOBAL:
-    case ApplicationStatsHelper::IDENTIFIER_RECEIVER: {
-        /*
-         * Install a probe on each receiver and connect them to the
-         * first-level collectors.
-         */
-        const uint32_t n = SetupProbesAtReceiver<ApplicationPacketProbe>(
-            "OutputBytes",
-            m_conversionCollectors,
-            &UnitConversionCollector::TraceSinkUinteger32,
-            m_probes);
-        NS_LOG_INFO(this << " created " << n << " instance(s)"
-                         << " of ApplicationPacketProbe");
-        break;
-    }
-
-    case ApplicationStatsHelper::IDENTIFIER_SENDER: {
-        // Create a look-up table of sender addresses and collector identifiers.
-        uint32_t identifier = 0;
-        std::map<std::string, ApplicationContainer>::const_iterator it1;
-        for (it1 = m_senderInfo.begin(); it1 != m_senderInfo.end(); ++it1)
-        {
-            for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
-                 ++it2)
-            {
-                SaveAddressAndIdentifier(*it2, identifier);
-            }
-
-            identifier++;
-        }
-
-        // Connect with trace sources in receiver applications.
-        const uint32_t n = SetupListenersAtReceiver(
-            MakeCallback(&ApplicationStatsThroughputHelper::RxCallback, this));
-        NS_LOG_INFO(this << " connected to " << n << " trace sources");
+    case ApplicationStatsHelper::OUTPUT_SUMMARY: {
+        // No collector and aggregator, the summaries are written upon disposal.
+        const uint32_t n = CreateSummaryPerIdentifier("% identifier throughput_kbps");
+        SummaryInterval_t interval;
+        interval.isStarted = false;
+        interval.index = 0;
+        interval.bytes = 0;
+        m_summaryIntervals.assign(n, interval);
         break;
     }
 
     default:
-        NS_FATAL_ERROR("ApplicationStatsThroughputHelper - Invalid identifier type");
+        NS_FATAL_ERROR("ApplicationStatsThroughputHelper - Invalid output type");
         break;
 
-    } // end of `switch (GetIdentifierType ())`
+    } // end of `switch (GetOutputType ())`
 
-} // end of `void DoInstall ();`
+} // end of `void InstallCollectors ()`
 
 void
 ApplicationStatsThroughputHelper::RxCallback(Ptr<const Packet> packet, const Address& from)
@@ -416,10 +661,10 @@ ApplicationStatsThroughputHelper::RxCallback(Ptr<const Packet> packet, const Add
     if (InetSocketAddress::IsMatchingType(from))
     {
         // Determine the identifier associated with the sender address.
-        const Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
-        std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find(ipv4Addr);
+        const Ipv4Address ipv4Addr = InetSocketAddress::ConvertFrom(from).GetIpv4();
+        const uint32_t identifier = m_addressTable.Lookup(ipv4Addr);
 
-        if (it1 == m_identifierMap.end())
+        if (identifier == ApplicationStatsAddressTable::INVALID_IDENTIFIER)
         {
             NS_LOG_WARN(this << " discarding packet " << packet << " (" << packet->GetSize()
                              << " bytes)"
@@ -428,15 +673,7 @@ ApplicationStatsThroughputHelper::RxCallback(Ptr<const Packet> packet, const Add
         }
         else
         {
-            // Find the collector with the right identifier.
-            Ptr<DataCollectionObject> collector = m_conversionCollectors.Get(it1->second);
-            NS_ASSERT_MSG(collector != nullptr,
-                          "Unable to find collector with identifier " << it1->second);
-            Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector>();
-            NS_ASSERT(c != nullptr);
-
-            // Pass the sample to the collector.
-            c->TraceSinkUinteger32(0, packet->GetSize());
+            PassSampleToCollector(packet, identifier);
         }
     }
     else
@@ -454,36 +691,230 @@ ApplicationStatsThroughputHelper::SaveAddressAndIdentifier(Ptr<Application> appl
                                                            uint32_t identifier)
 {
     NS_LOG_FUNCTION(this << application << identifier);
+    m_addressTable.AddApplication(application, identifier);
+}
 
-    Ptr<Node> node = application->GetNode();
-    NS_ASSERT_MSG(node != nullptr, "Application is not attached to any Node");
-    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+void
+ApplicationStatsThroughputHelper::PassSampleToCollector(Ptr<const Packet> packet,
+                                                        uint32_t identifier)
+{
+    // NS_LOG_FUNCTION (this << packet->GetSize () << identifier);
 
-    if (ipv4 == nullptr)
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY)
     {
-        NS_LOG_INFO(this << " Node " << node->GetId() << " does not support IPv4 protocol");
+        AddBytesToSummary(packet->GetSize(), identifier);
+        return;
     }
-    else
+
+    if (m_slidingWindow != nullptr)
     {
-        NS_LOG_DEBUG(this << " found " << ipv4->GetNInterfaces() << " interface(s)"
-                          << " in Node " << node->GetId());
+        m_slidingWindow->Add(identifier, packet->GetSize());
+        return;
+    }
 
-        // Skipping interface #0 because it is assumed to be a loopback interface.
-        for (uint32_t i = 1; i < ipv4->GetNInterfaces(); i++)
-        {
-            NS_LOG_DEBUG(this << " found " << ipv4->GetNAddresses(i) << " address(es)"
-                              << " in Node " << node->GetId() << " interface #" << i);
+    NS_ASSERT_MSG(identifier < m_conversionCollectorList.size(),
+                  "Unable to find collector with identifier " << identifier);
+    m_conversionCollectorList[identifier]->TraceSinkUinteger32(0, packet->GetSize());
+}
+
+void
+ApplicationStatsThroughputHelper::AddBytesToSummary(uint32_t bytes, uint32_t identifier)
+{
+    // NS_LOG_FUNCTION (this << bytes << identifier);
+
+    NS_ASSERT_MSG(identifier < m_summaries.size(),
+                  "Unable to find summary with identifier " << identifier);
+    NS_ASSERT(m_summaryIntervals.size() == m_summaries.size());
+
+    const int64_t index = Simulator::Now().GetTimeStep() / m_summaryInterval.GetTimeStep();
+    SummaryInterval_t& interval = m_summaryIntervals[identifier];
+
+    if (!interval.isStarted)
+    {
+        interval.isStarted = true;
+        interval.index = index;
+    }
+
+    // Close the ongoing interval and any idle interval after it.
+    const double intervalSeconds = m_summaryInterval.GetSeconds();
+    while (interval.index < index)
+    {
+        AddSummarySample(identifier, interval.bytes * 8.0 / 1000.0 / intervalSeconds);
+        interval.bytes = 0;
+        interval.index++;
+    }
+
+    interval.bytes += bytes;
+}
+
+void
+ApplicationStatsThroughputHelper::CreateConversionCollectorList()
+{
+    NS_LOG_FUNCTION(this);
 
-            for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+    m_conversionCollectorList.clear();
+
+    if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY || m_slidingWindow != nullptr)
+    {
+        return; // samples go to the summaries or the sliding window instead
+    }
+
+    m_conversionCollectorList.reserve(m_conversionCollectors.GetN());
+
+    for (CollectorMap::Iterator it = m_conversionCollectors.Begin();
+         it != m_conversionCollectors.End();
+         ++it)
+    {
+        // The collectors are labelled using running integers starting from 0.
+        NS_ASSERT(it->first == m_conversionCollectorList.size());
+        Ptr<UnitConversionCollector> c = it->second->GetObject<UnitConversionCollector>();
+        NS_ASSERT(c != nullptr);
+        m_conversionCollectorList.push_back(c);
+    }
+}
+
+void
+ApplicationStatsThroughputHelper::InstallPolling()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_SENDER,
+                    "PollingMode does not support "
+                        << GetIdentifierTypeName(GetIdentifierType()));
+
+    InstallDirectOutput();
+
+    // Find the received byte counter of every receiver application.
+
+    m_rxCounters.clear();
+    m_rxCounters.resize(GetIdentifierNames().size());
+    uint32_t identifier = 0;
+    uint32_t n = 0;
+    std::map<std::string, ApplicationContainer>::const_iterator it1;
+    for (it1 = m_receiverInfo.begin(); it1 != m_receiverInfo.end(); ++it1)
+    {
+        for (ApplicationContainer::Iterator it2 = it1->second.Begin(); it2 != it1->second.End();
+             ++it2)
+        {
+            const Callback<uint64_t> counter = GetRxCounter(*it2);
+            if (counter.IsNull())
             {
-                const Address addr = ipv4->GetAddress(i, j).GetLocal();
-                m_identifierMap[addr] = identifier;
-                NS_LOG_INFO(this << " associated address " << addr << " with identifier "
-                                 << identifier);
+                NS_LOG_WARN(this << " application " << (*it2)->GetInstanceTypeId().GetName()
+                                 << " does not have a received byte counter");
+                continue;
             }
+
+            NS_ASSERT(identifier < m_rxCounters.size());
+            m_rxCounters[identifier].push_back(counter);
+            n++;
+        }
+
+        if (GetIdentifierType() == ApplicationStatsHelper::IDENTIFIER_RECEIVER)
+        {
+            identifier++; // Move to the next identifier.
         }
     }
 
-} // end of `void SaveAddressAndIdentifier (Ptr<Application>, uint32_t)`
+    m_lastRxBytes.assign(m_rxCounters.size(), 0);
+    for (uint32_t i = 0; i < m_rxCounters.size(); i++)
+    {
+        for (uint32_t j = 0; j < m_rxCounters[i].size(); j++)
+        {
+            m_lastRxBytes[i] += m_rxCounters[i][j]();
+        }
+    }
+
+    NS_LOG_INFO(this << " polling " << n << " received byte counters"
+                     << " every " << m_pollingInterval.GetSeconds() << " seconds");
+    m_pollingEvent = Simulator::Schedule(m_pollingInterval,
+                                         &ApplicationStatsThroughputHelper::PollCounters,
+                                         this);
+
+} // end of `void InstallPolling ()`
+
+void
+ApplicationStatsThroughputHelper::InstallDirectOutput()
+{
+    NS_LOG_FUNCTION(this);
+
+    switch (GetOutputType())
+    {
+    case ApplicationStatsHelper::OUTPUT_SCATTER_FILE:
+        m_aggregator = CreateAggregator("ns3::MultiFileAggregator",
+                                        "OutputFileName",
+                                        StringValue(GetName()),
+                                        "GeneralHeading",
+                                        StringValue("% time_sec throughput_kbps"));
+        CreateScatterSampler(m_aggregator);
+        break;
+
+    case ApplicationStatsHelper::OUTPUT_SCATTER_PLOT: {
+        Ptr<GnuplotAggregator> plotAggregator = CreateObject<GnuplotAggregator>(GetName());
+        plotAggregator->SetLegend("Time (in seconds)",
+                                  "Received throughput (in kilobits per second)");
+        plotAggregator->Set2dDatasetDefaultStyle(Gnuplot2dDataset::LINES);
+        const std::vector<std::string> names = GetIdentifierNames();
+        for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+        {
+            plotAggregator->Add2dDataset(*it, *it);
+        }
+        m_aggregator = plotAggregator;
+        CreateScatterSampler(m_aggregator);
+        break;
+    }
+
+    case ApplicationStatsHelper::OUTPUT_SCATTER_BINARY_FILE:
+        CreateBinaryWriter("time_sec", "throughput_kbps");
+        CreateScatterSampler(nullptr);
+        break;
+
+    case ApplicationStatsHelper::OUTPUT_SUMMARY:
+        CreateSummaryPerIdentifier("% identifier throughput_kbps");
+        break;
+
+    default:
+        NS_FATAL_ERROR(GetOutputTypeName(GetOutputType())
+                       << " is not a valid output type for PollingMode or SlidingWindow.");
+        break;
+    }
+
+} // end of `void InstallDirectOutput ()`
+
+void
+ApplicationStatsThroughputHelper::PollCounters()
+{
+    NS_LOG_FUNCTION(this);
+
+    const double now = Simulator::Now().GetSeconds();
+    const double intervalSeconds = m_pollingInterval.GetSeconds();
+
+    for (uint32_t i = 0; i < m_rxCounters.size(); i++)
+    {
+        uint64_t rxBytes = 0;
+        for (uint32_t j = 0; j < m_rxCounters[i].size(); j++)
+        {
+            rxBytes += m_rxCounters[i][j]();
+        }
+
+        NS_ASSERT(rxBytes >= m_lastRxBytes[i]);
+        const double throughput = (rxBytes - m_lastRxBytes[i]) * 8.0 / 1000.0 / intervalSeconds;
+        m_lastRxBytes[i] = rxBytes;
+
+        if (GetOutputType() == ApplicationStatsHelper::OUTPUT_SUMMARY)
+        {
+            AddSummarySample(i, throughput);
+        }
+        else
+        {
+            NS_ASSERT(m_scatterSampler != nullptr);
+            m_scatterSampler->Write(i, now, throughput);
+        }
+    }
+
+    m_pollingEvent = Simulator::Schedule(m_pollingInterval,
+                                         &ApplicationStatsThroughputHelper::PollCounters,
+                                         this);
+
+} // end of `void PollCounters ()`
 
 } // end of namespace ns3
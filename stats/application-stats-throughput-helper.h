@@ -23,12 +23,16 @@
 #define APPLICATION_STATS_THROUGHPUT_HELPER_H
 
 #include <ns3/address.h>
+#include <ns3/application-stats-address-table.h>
 #include <ns3/application-stats-helper.h>
+#include <ns3/callback.h>
 #include <ns3/collector-map.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
 #include <ns3/ptr.h>
 
 #include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -39,6 +43,7 @@ class Application;
 class Time;
 class DataCollectionObject;
 class DistributionCollector;
+class UnitConversionCollector;
 
 /**
  * \ingroup applicationstats
@@ -66,6 +71,55 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
      */
     bool GetAveragingMode() const;
 
+    /**
+     * \param summaryInterval length of the intervals which are used to compute
+     *                        the throughput samples of `OUTPUT_SUMMARY`.
+     */
+    void SetSummaryInterval(Time summaryInterval);
+
+    /**
+     * \return length of the intervals which are used to compute the
+     *         throughput samples of `OUTPUT_SUMMARY`.
+     */
+    Time GetSummaryInterval() const;
+
+    /**
+     * \param pollingMode if true, poll the received byte counters of the
+     *                    receiver applications once per interval, instead of
+     *                    listening to every received packet.
+     * \warning Does not have any effect if invoked after Install().
+     */
+    void SetPollingMode(bool pollingMode);
+
+    /**
+     * \return true if the received byte counters are polled instead of
+     *         listening to every received packet.
+     */
+    bool GetPollingMode() const;
+
+    /**
+     * \param pollingInterval length of the intervals between two polls of the
+     *                        received byte counters.
+     */
+    void SetPollingInterval(Time pollingInterval);
+
+    /**
+     * \return length of the intervals between two polls of the received byte
+     *         counters.
+     */
+    Time GetPollingInterval() const;
+
+    /**
+     * \param application a receiver application.
+     * \return a callback returning the total number of bytes received by the
+     *         application so far, or a null callback if the application type
+     *         does not have such counter.
+     *
+     * Supported application types are PacketSink, NrtvTcpClient,
+     * NrtvUdpClient, and ThreeGppHttpSatelliteClient.
+     */
+    static Callback<uint64_t> GetRxCounter(Ptr<Application> application);
+
     /**
      * \brief Receive inputs from trace sources and determine the right collector
      *        to forward the inputs to.
@@ -84,7 +138,29 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
     // inherited from ApplicationStatsHelper base class
     virtual void DoInstall();
 
+    // inherited from Object base class
+    virtual void DoDispose();
+
   private:
+    /**
+     * \brief Create the aggregator and the collectors according to the output
+     *        type.
+     *
+     * The first part of DoInstall(), unless the sliding window is enabled.
+     */
+    void InstallCollectors();
+
+    /**
+     * \brief Create the output which receives throughput samples without any
+     *        collector, i.e., the aggregator or the binary writer behind
+     *        #m_scatterSampler, or the summaries.
+     *
+     * Used by the polling mode and the sliding window. Supports only
+     * `SCATTER_FILE`, `SCATTER_PLOT`, `SCATTER_BINARY_FILE`, and `SUMMARY`
+     * output types.
+     */
+    void InstallDirectOutput();
+
     /**
      * \brief Associate the given application's IPv4 address with the given
      *        identifier.
@@ -92,11 +168,57 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
      * \param identifier the number to be associated with.
      *
      * Any IPv4 address(es) which belong to the Node of the given application
-     * will be saved in the #m_identifierMap member variable. Used only with
+     * will be saved in the #m_addressTable member variable. Used only with
      * `SENDER` identifier.
      */
     void SaveAddressAndIdentifier(Ptr<Application> application, uint32_t identifier);
 
+    /**
+     * \brief Pass the size of a received packet to the first-level collector
+     *        with the right identifier.
+     * \param packet received packet data.
+     * \param identifier collector identifier.
+     */
+    void PassSampleToCollector(Ptr<const Packet> packet, uint32_t identifier);
+
+    /**
+     * \brief Account received bytes in the summary with the right identifier.
+     * \param bytes number of bytes received.
+     * \param identifier summary identifier.
+     *
+     * Bytes are accumulated in intervals of `SummaryInterval` length, which
+     * are aligned to the beginning of the simulation. When an interval ends,
+     * its throughput becomes a sample of the summary. The intervals start
+     * upon the first packet of each identifier, and the interval which is
+     * still ongoing upon disposal is not included.
+     */
+    void AddBytesToSummary(uint32_t bytes, uint32_t identifier);
+
+    /**
+     * \brief Store the first-level collectors in #m_conversionCollectorList,
+     *        indexed by identifier.
+     */
+    void CreateConversionCollectorList();
+
+    /**
+     * \brief Install the output and the received byte counters of the polling
+     *        mode, and schedule the first poll.
+     *
+     * Replaces the whole DoInstall() when `PollingMode` is enabled. Supports
+     * only `GLOBAL` and `RECEIVER` identifiers, and `SCATTER_FILE`,
+     * `SCATTER_PLOT`, `SCATTER_BINARY_FILE`, and `SUMMARY` output types.
+     */
+    void InstallPolling();
+
+    /**
+     * \brief Read the received byte counters, write one throughput sample per
+     *        identifier, and schedule the next poll.
+     *
+     * The sample is the throughput over the interval which has just ended, and
+     * is time-stamped with the end of the interval.
+     */
+    void PollCounters();
+
     /// Maintains a list of probes created by this helper.
     std::list<Ptr<Probe>> m_probes;
 
@@ -112,11 +234,37 @@ class ApplicationStatsThroughputHelper : public ApplicationStatsHelper
     /// The aggregator created by this helper.
     Ptr<DataCollectionObject> m_aggregator;
 
-    /// Map of address and the `SENDER` identifier associated with it.
-    std::map<const Address, uint32_t> m_identifierMap;
+    /// First-level collectors created by this helper, indexed by identifier.
+    std::vector<Ptr<UnitConversionCollector>> m_conversionCollectorList;
+
+    /// Look-up table of address and the `SENDER` identifier associated with it.
+    ApplicationStatsAddressTable m_addressTable;
 
     bool m_averagingMode; ///< `AveragingMode` attribute.
 
+    Time m_summaryInterval; ///< `SummaryInterval` attribute.
+
+    /// State of the ongoing throughput interval of an `OUTPUT_SUMMARY` identifier.
+    struct SummaryInterval_t
+    {
+        bool isStarted; ///< True after the first packet has been received.
+        int64_t index;  ///< Index of the ongoing interval since the beginning of simulation.
+        uint64_t bytes; ///< Bytes received so far within the ongoing interval.
+    };
+
+    /// Ongoing throughput intervals, indexed by identifier.
+    std::vector<SummaryInterval_t> m_summaryIntervals;
+
+    bool m_pollingMode;     ///< `PollingMode` attribute.
+    Time m_pollingInterval; ///< `PollingInterval` attribute.
+    EventId m_pollingEvent; ///< The next poll of the received byte counters.
+
+    /// Received byte counters of the receiver applications, indexed by identifier.
+    std::vector<std::vector<Callback<uint64_t>>> m_rxCounters;
+
+    /// Sum of the received byte counters at the previous poll, indexed by identifier.
+    std::vector<uint64_t> m_lastRxBytes;
+
 }; // end of class ApplicationStatsThroughputHelper
 
 } // end of namespace ns3
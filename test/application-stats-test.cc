@@ -0,0 +1,1181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file application-stats-test.cc
+ * \ingroup applicationstats
+ * \brief Test cases for the building blocks of application statistics,
+ *        grouped in `application-stats` test suite.
+ */
+
+#include <ns3/application-stats-async-writer.h>
+#include <ns3/application-stats-binary-writer.h>
+#include <ns3/application-stats-helper.h>
+#include <ns3/application-stats-inline-pipeline.h>
+#include <ns3/application-stats-scatter-sampler.h>
+#include <ns3/application-stats-sliding-window.h>
+#include <ns3/application-stats-steady-state.h>
+#include <ns3/application-stats-summary.h>
+#include <ns3/application-stats-telemetry.h>
+#include <ns3/jitter-estimator.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ApplicationStatsTest");
+
+using namespace ns3;
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the streaming estimators of ApplicationStatsSummary.
+ *
+ * Feeds a deterministic pseudo-random series of samples into a summary and
+ * compares the result with the exact statistics computed from the whole
+ * series.
+ */
+class ApplicationStatsSummaryTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param numOfSamples number of samples to be fed into the summary.
+     */
+    ApplicationStatsSummaryTestCase(uint32_t numOfSamples);
+
+  private:
+    virtual void DoRun();
+
+    uint32_t m_numOfSamples; ///< Number of samples.
+
+}; // end of `class ApplicationStatsSummaryTestCase`
+
+ApplicationStatsSummaryTestCase::ApplicationStatsSummaryTestCase(uint32_t numOfSamples)
+    : TestCase("Streaming summary statistics"),
+      m_numOfSamples(numOfSamples)
+{
+    NS_LOG_FUNCTION(this << numOfSamples);
+}
+
+void
+ApplicationStatsSummaryTestCase::DoRun()
+{
+    ApplicationStatsSummary summary;
+    std::vector<double> samples;
+    uint32_t x = 12345;
+
+    for (uint32_t i = 0; i < m_numOfSamples; i++)
+    {
+        // An exponentially distributed series from a linear congruential generator.
+        x = x * 1664525 + 1013904223;
+        const double u = (x + 0.5) / 4294967296.0;
+        const double sample = -std::log(u);
+        summary.AddSample(sample);
+        samples.push_back(sample);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (std::vector<double>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        sum += *it;
+    }
+    const double mean = sum / m_numOfSamples;
+    double sumSquares = 0.0;
+    for (std::vector<double>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        sumSquares += (*it - mean) * (*it - mean);
+    }
+    const double stdDev = std::sqrt(sumSquares / (m_numOfSamples - 1));
+
+    NS_TEST_ASSERT_MSG_EQ(summary.GetCount(), m_numOfSamples, "Invalid count");
+    NS_TEST_ASSERT_MSG_EQ_TOL(summary.GetMean(), mean, 1e-9, "Invalid mean");
+    NS_TEST_ASSERT_MSG_EQ_TOL(summary.GetStdDev(), stdDev, 1e-9, "Invalid standard deviation");
+    NS_TEST_ASSERT_MSG_EQ(summary.GetMin(), samples.front(), "Invalid minimum");
+    NS_TEST_ASSERT_MSG_EQ(summary.GetMax(), samples.back(), "Invalid maximum");
+
+    // The quantile estimates are approximations, so allow a 2% relative error.
+    const double p50 = samples[m_numOfSamples / 2];
+    const double p95 = samples[m_numOfSamples * 95 / 100];
+    const double p99 = samples[m_numOfSamples * 99 / 100];
+    NS_TEST_ASSERT_MSG_EQ_TOL(summary.GetP50(), p50, 0.02 * p50, "Inaccurate median");
+    NS_TEST_ASSERT_MSG_EQ_TOL(summary.GetP95(), p95, 0.02 * p95, "Inaccurate 95th percentile");
+    NS_TEST_ASSERT_MSG_EQ_TOL(summary.GetP99(), p99, 0.02 * p99, "Inaccurate 99th percentile");
+
+    // Below five samples, the quantiles are exact.
+    ApplicationStatsSummary small;
+    small.AddSample(3.0);
+    small.AddSample(1.0);
+    small.AddSample(2.0);
+    NS_TEST_ASSERT_MSG_EQ(small.GetP50(), 2.0, "Invalid median of a small series");
+    NS_TEST_ASSERT_MSG_EQ(small.GetP99(), 3.0, "Invalid 99th percentile of a small series");
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the file format written by ApplicationStatsBinaryWriter.
+ *
+ * Writes samples of two identifiers through the writer's sinks, using a small
+ * block size so that several blocks are written, then reads the file back and
+ * compares the header and the samples with what was written. The file must be
+ * the same whether it is written synchronously or by a background thread.
+ */
+class ApplicationStatsBinaryWriterTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param isAsync whether the file is written by a background I/O thread.
+     */
+    ApplicationStatsBinaryWriterTestCase(bool isAsync);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \param ifs the input file.
+     * \return the next integer read from the file.
+     */
+    static uint32_t ReadUint32(std::ifstream& ifs);
+
+    /**
+     * \param ifs the input file.
+     * \return the next length-prefixed string read from the file.
+     */
+    static std::string ReadName(std::ifstream& ifs);
+
+    bool m_isAsync; ///< Whether the file is written by a background I/O thread.
+
+}; // end of `class ApplicationStatsBinaryWriterTestCase`
+
+ApplicationStatsBinaryWriterTestCase::ApplicationStatsBinaryWriterTestCase(bool isAsync)
+    : TestCase(isAsync ? "Binary columnar scatter file, asynchronous"
+                       : "Binary columnar scatter file"),
+      m_isAsync(isAsync)
+{
+    NS_LOG_FUNCTION(this << isAsync);
+}
+
+uint32_t // static
+ApplicationStatsBinaryWriterTestCase::ReadUint32(std::ifstream& ifs)
+{
+    uint32_t value = 0;
+    ifs.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+std::string // static
+ApplicationStatsBinaryWriterTestCase::ReadName(std::ifstream& ifs)
+{
+    const uint32_t length = ReadUint32(ifs);
+    std::string name(length, '\0');
+    ifs.read(&name[0], length);
+    return name;
+}
+
+void
+ApplicationStatsBinaryWriterTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("application-stats-binary-writer.bin");
+    std::vector<std::string> names;
+    names.push_back("first");
+    names.push_back("second");
+    const uint32_t numOfSamples[2] = {10, 3};
+
+    Ptr<ApplicationStatsBinaryWriter> writer =
+        Create<ApplicationStatsBinaryWriter>(fileName, "time_sec", "value", names, 4, m_isAsync);
+    Callback<void, double, double> sink0 = writer->GetSink(0);
+    Callback<void, double, double> sink1 = writer->GetSink(1);
+    for (uint32_t i = 0; i < numOfSamples[0]; i++)
+    {
+        sink0(i, 10.0 * i);
+        if (i < numOfSamples[1])
+        {
+            sink1(i + 0.5, -1.0 * i);
+        }
+    }
+    writer->Close();
+    sink0(100.0, 100.0); // must be ignored after closing
+
+    std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+    NS_TEST_ASSERT_MSG_EQ(ifs.is_open(), true, "Unable to open " << fileName);
+
+    char magic[8];
+    ifs.read(magic, sizeof(magic));
+    NS_TEST_ASSERT_MSG_EQ(std::memcmp(magic, ApplicationStatsBinaryWriter::MAGIC, 8),
+                          0,
+                          "Invalid magic string");
+    NS_TEST_ASSERT_MSG_EQ(ReadUint32(ifs), 0x01020304, "Invalid byte order marker");
+    NS_TEST_ASSERT_MSG_EQ(ReadUint32(ifs),
+                          ApplicationStatsBinaryWriter::VERSION,
+                          "Invalid version");
+    NS_TEST_ASSERT_MSG_EQ(ReadName(ifs), "time_sec", "Invalid time column name");
+    NS_TEST_ASSERT_MSG_EQ(ReadName(ifs), "value", "Invalid value column name");
+    NS_TEST_ASSERT_MSG_EQ(ReadUint32(ifs), 2, "Invalid number of identifiers");
+    NS_TEST_ASSERT_MSG_EQ(ReadName(ifs), "first", "Invalid identifier name");
+    NS_TEST_ASSERT_MSG_EQ(ReadName(ifs), "second", "Invalid identifier name");
+
+    uint32_t numOfRead[2] = {0, 0};
+    uint32_t numOfBlocks = 0;
+    while (ifs.peek() != std::ifstream::traits_type::eof())
+    {
+        const uint32_t identifier = ReadUint32(ifs);
+        const uint32_t n = ReadUint32(ifs);
+        NS_TEST_ASSERT_MSG_LT(identifier, 2, "Invalid identifier");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(n, 4, "Block larger than the block size");
+        std::vector<double> times(n);
+        std::vector<double> values(n);
+        ifs.read(reinterpret_cast<char*>(&times[0]), n * sizeof(double));
+        ifs.read(reinterpret_cast<char*>(&values[0]), n * sizeof(double));
+        NS_TEST_ASSERT_MSG_EQ(ifs.good(), true, "Truncated block");
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const uint32_t k = numOfRead[identifier] + i;
+            const double time = (identifier == 0) ? k : k + 0.5;
+            const double value = (identifier == 0) ? 10.0 * k : -1.0 * k;
+            NS_TEST_ASSERT_MSG_EQ(times[i], time, "Invalid time value");
+            NS_TEST_ASSERT_MSG_EQ(values[i], value, "Invalid sample value");
+        }
+
+        numOfRead[identifier] += n;
+        numOfBlocks++;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(numOfRead[0], numOfSamples[0], "Invalid number of samples");
+    NS_TEST_ASSERT_MSG_EQ(numOfRead[1], numOfSamples[1], "Invalid number of samples");
+    NS_TEST_ASSERT_MSG_EQ(numOfBlocks, 4, "Invalid number of blocks");
+
+    ifs.close();
+    std::remove(fileName.c_str());
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies that ApplicationStatsAsyncWriter preserves the byte stream.
+ *
+ * Writes records of varying sizes, some larger than a chunk, through a writer
+ * with tiny chunks, so that the ring wraps around many times and the producer
+ * has to wait for the I/O thread. The file must contain exactly the bytes which
+ * were written before Close().
+ */
+class ApplicationStatsAsyncWriterTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsAsyncWriterTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class ApplicationStatsAsyncWriterTestCase`
+
+ApplicationStatsAsyncWriterTestCase::ApplicationStatsAsyncWriterTestCase()
+    : TestCase("Asynchronous output file")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsAsyncWriterTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("application-stats-async-writer.bin");
+    std::string expected;
+
+    Ptr<ApplicationStatsAsyncWriter> writer =
+        Create<ApplicationStatsAsyncWriter>(fileName, 16, 2);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        const std::string record(i % 37, static_cast<char>('a' + (i % 26)));
+        writer->Write(record.data(), record.size());
+        expected += record;
+    }
+    writer->Close();
+    writer->Write("ignored", 7); // must be ignored after closing
+
+    std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+    NS_TEST_ASSERT_MSG_EQ(ifs.is_open(), true, "Unable to open " << fileName);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    const std::string actual = oss.str();
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Invalid file size");
+    NS_TEST_ASSERT_MSG_EQ((actual == expected), true, "Invalid file content");
+
+    ifs.close();
+    std::remove(fileName.c_str());
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies ApplicationStatsHelper::MergeSummaryFiles().
+ *
+ * Splits a series of samples into two summary files, as if written by two
+ * ranks of a distributed simulation, merges them, and compares the merged row
+ * with a summary of the whole series. The samples have a large mean compared
+ * to their spread, so the standard deviation only merges correctly if every
+ * file is written with the full precision of `double`. An identifier present in one file only
+ * must be copied as is.
+ */
+class ApplicationStatsMergeSummaryTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsMergeSummaryTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \brief Write a summary file with a single row.
+     * \param fileName name of the file.
+     * \param name identifier of the row.
+     * \param summary the summary to be written.
+     */
+    static void WriteSummary(const std::string& fileName,
+                             const std::string& name,
+                             const ApplicationStatsSummary& summary);
+
+}; // end of `class ApplicationStatsMergeSummaryTestCase`
+
+ApplicationStatsMergeSummaryTestCase::ApplicationStatsMergeSummaryTestCase()
+    : TestCase("Merging of summary files")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void // static
+ApplicationStatsMergeSummaryTestCase::WriteSummary(const std::string& fileName,
+                                                   const std::string& name,
+                                                   const ApplicationStatsSummary& summary)
+{
+    std::ofstream ofs(fileName.c_str());
+    ofs << std::setprecision(std::numeric_limits<double>::max_digits10);
+    ofs << "% identifier delay_sec count mean stddev min max p50 p95 p99\n";
+    ofs << name << " " << summary.GetCount() << " " << summary.GetMean() << " "
+        << summary.GetStdDev() << " " << summary.GetMin() << " " << summary.GetMax() << " "
+        << summary.GetP50() << " " << summary.GetP95() << " " << summary.GetP99() << "\n";
+}
+
+void
+ApplicationStatsMergeSummaryTestCase::DoRun()
+{
+    ApplicationStatsSummary first;
+    ApplicationStatsSummary second;
+    ApplicationStatsSummary all;
+    for (uint32_t i = 1; i <= 300; i++)
+    {
+        const double sample = 1e6 + 0.001 * i * i;
+        (i <= 100 ? first : second).AddSample(sample);
+        all.AddSample(sample);
+    }
+
+    std::vector<std::string> inputFileNames;
+    inputFileNames.push_back(CreateTempDirFilename("stat-rank-0-summary.txt"));
+    inputFileNames.push_back(CreateTempDirFilename("stat-rank-1-summary.txt"));
+    WriteSummary(inputFileNames[0], "global", first);
+    WriteSummary(inputFileNames[1], "global", second);
+    {
+        std::ofstream ofs(inputFileNames[1].c_str(), std::ios::app);
+        ofs << "only-in-second 1 2.5 0 2.5 2.5 2.5 2.5 2.5\n";
+    }
+
+    const std::string outputFileName = CreateTempDirFilename("stat-summary.txt");
+    ApplicationStatsHelper::MergeSummaryFiles(inputFileNames, outputFileName);
+
+    std::ifstream ifs(outputFileName.c_str());
+    NS_TEST_ASSERT_MSG_EQ(ifs.is_open(), true, "Unable to open the merged file");
+    std::string line;
+    std::getline(ifs, line);
+    NS_TEST_ASSERT_MSG_EQ(line,
+                          "% identifier delay_sec count mean stddev min max p50 p95 p99",
+                          "Invalid heading");
+
+    std::string name;
+    uint64_t count = 0;
+    double mean = 0.0;
+    double stdDev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    ifs >> name >> count >> mean >> stdDev >> min >> max >> p50 >> p95 >> p99;
+    NS_TEST_ASSERT_MSG_EQ(name, "global", "Invalid identifier of the first row");
+    NS_TEST_ASSERT_MSG_EQ(count, all.GetCount(), "Invalid merged count");
+    NS_TEST_ASSERT_MSG_EQ_TOL(mean, all.GetMean(), 1e-12 * all.GetMean(), "Invalid merged mean");
+    NS_TEST_ASSERT_MSG_EQ_TOL(stdDev,
+                              all.GetStdDev(),
+                              1e-6 * all.GetStdDev(),
+                              "Invalid merged standard deviation");
+    NS_TEST_ASSERT_MSG_EQ_TOL(min, all.GetMin(), 1e-9, "Invalid merged minimum");
+    NS_TEST_ASSERT_MSG_EQ_TOL(max, all.GetMax(), 1e-9, "Invalid merged maximum");
+    const double expectedP50 = (first.GetP50() + 2.0 * second.GetP50()) / 3.0;
+    NS_TEST_ASSERT_MSG_EQ_TOL(p50, expectedP50, 1e-5 * expectedP50, "Invalid merged median");
+
+    ifs >> name >> count >> mean;
+    NS_TEST_ASSERT_MSG_EQ(name, "only-in-second", "Invalid identifier of the second row");
+    NS_TEST_ASSERT_MSG_EQ(count, 1, "Invalid count of the second row");
+    NS_TEST_ASSERT_MSG_EQ_TOL(mean, 2.5, 1e-9, "Invalid mean of the second row");
+
+    ifs.close();
+    std::remove(outputFileName.c_str());
+    std::remove(inputFileNames[0].c_str());
+    std::remove(inputFileNames[1].c_str());
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the RFC 3550 jitter and the delay variation computed by
+ *        JitterEstimator.
+ *
+ * Feeds delays alternating between two values, so that every difference is
+ * the same, and compares the estimates with the closed form of the RFC 3550
+ * recursion. Zero delays must be accepted as regular samples.
+ */
+class JitterEstimatorTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    JitterEstimatorTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class JitterEstimatorTestCase`
+
+JitterEstimatorTestCase::JitterEstimatorTestCase()
+    : TestCase("RFC 3550 jitter estimator")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+JitterEstimatorTestCase::DoRun()
+{
+    JitterEstimator estimator;
+    NS_TEST_ASSERT_MSG_EQ(estimator.HasJitter(), false, "Jitter defined without samples");
+
+    // A zero delay is a valid sample, not a missing one.
+    estimator.AddDelay(Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(estimator.HasJitter(), false, "Jitter defined with one sample");
+    estimator.AddDelay(Seconds(0));
+    NS_TEST_ASSERT_MSG_EQ(estimator.HasJitter(), true, "Zero delays must be counted");
+    NS_TEST_ASSERT_MSG_EQ(estimator.GetJitter(), Seconds(0), "Constant delay has no jitter");
+
+    estimator.Reset();
+    NS_TEST_ASSERT_MSG_EQ(estimator.GetNumOfSamples(), 0, "Samples left after reset");
+
+    const uint32_t numOfSamples = 100;
+    for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+        estimator.AddDelay(MilliSeconds((i % 2 == 0) ? 20 : 30));
+    }
+
+    // J(n) = D * (1 - (15/16)^n) after n differences of D.
+    const double expected = 0.010 * (1.0 - std::pow(15.0 / 16.0, numOfSamples - 1));
+    NS_TEST_ASSERT_MSG_EQ_TOL(estimator.GetJitter().GetSeconds(),
+                              expected,
+                              1e-9,
+                              "Invalid jitter");
+    NS_TEST_ASSERT_MSG_EQ(estimator.GetMinDelay(), MilliSeconds(20), "Invalid minimum delay");
+    NS_TEST_ASSERT_MSG_EQ(estimator.GetDelayVariation(),
+                          MilliSeconds(10),
+                          "Invalid delay variation");
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the decimation and the reservoir sampling of
+ *        ApplicationStatsScatterSampler.
+ *
+ * Offers samples whose values are their own running indices, so that the
+ * surviving samples can be traced back to their position in the input.
+ */
+class ApplicationStatsScatterSamplerTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsScatterSamplerTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \brief Output callback of the sampler.
+     * \param identifier index of the identifier.
+     * \param time the time of the sample in seconds.
+     * \param value the sample value.
+     */
+    void Output(uint32_t identifier, double time, double value);
+
+    std::vector<uint32_t> m_identifiers; ///< Identifiers of the surviving samples.
+    std::vector<double> m_times;         ///< Time values of the surviving samples.
+    std::vector<double> m_values;        ///< Values of the surviving samples.
+
+}; // end of `class ApplicationStatsScatterSamplerTestCase`
+
+ApplicationStatsScatterSamplerTestCase::ApplicationStatsScatterSamplerTestCase()
+    : TestCase("Decimation and reservoir sampling of scatter output")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsScatterSamplerTestCase::Output(uint32_t identifier, double time, double value)
+{
+    m_identifiers.push_back(identifier);
+    m_times.push_back(time);
+    m_values.push_back(value);
+}
+
+void
+ApplicationStatsScatterSamplerTestCase::DoRun()
+{
+    const Callback<void, uint32_t, double, double> output =
+        MakeCallback(&ApplicationStatsScatterSamplerTestCase::Output, this);
+
+    // Decimation alone passes the first of every 10 samples right away.
+    Ptr<ApplicationStatsScatterSampler> decimator =
+        Create<ApplicationStatsScatterSampler>(2, 10, 0, output);
+    Callback<void, double, double> sink = decimator->GetSink(1);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        decimator->Write(0, i * 0.001, i);
+        sink(i * 0.001, i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), 200, "Invalid number of decimated samples");
+    NS_TEST_ASSERT_MSG_EQ(decimator->GetNumOfSamples(0), 1000, "Invalid number of samples");
+    for (uint32_t j = 0; j < m_values.size(); j++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_identifiers[j], j % 2, "Invalid identifier");
+        NS_TEST_ASSERT_MSG_EQ(m_values[j], (j / 2) * 10, "Invalid decimated sample");
+    }
+    decimator->Flush();
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), 200, "Samples written upon flush");
+
+    // Reservoir sampling keeps a random subset until flushed.
+    m_identifiers.clear();
+    m_times.clear();
+    m_values.clear();
+    const uint32_t numOfSamples = 100000;
+    const uint32_t reservoirSize = 1000;
+    Ptr<ApplicationStatsScatterSampler> reservoir =
+        Create<ApplicationStatsScatterSampler>(1, 2, reservoirSize, output);
+    reservoir->AssignStreams(1);
+    for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+        reservoir->Write(0, i * 0.001, i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), 0, "Samples written before flush");
+    reservoir->Flush();
+    reservoir->Write(0, numOfSamples * 0.001, numOfSamples);
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), reservoirSize, "Invalid reservoir size");
+
+    double sum = 0.0;
+    for (uint32_t j = 0; j < m_values.size(); j++)
+    {
+        const uint32_t index = m_values[j];
+        NS_TEST_ASSERT_MSG_EQ(index % 2, 0, "Sample " << index << " should have been decimated");
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_times[j], index * 0.001, 1e-9, "Invalid time of sample");
+        if (j > 0)
+        {
+            NS_TEST_ASSERT_MSG_GT(m_times[j], m_times[j - 1], "Not in chronological order");
+        }
+        sum += index;
+    }
+
+    // The mean index of a uniform subset is (N - 2) / 2 with a standard error of about N / 110.
+    NS_TEST_ASSERT_MSG_EQ_TOL(sum / reservoirSize,
+                              (numOfSamples - 2) / 2.0,
+                              numOfSamples / 20.0,
+                              "Reservoir is not uniform");
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the rate and the mean estimates of
+ *        ApplicationStatsSlidingWindow.
+ *
+ * Adds one sample in the middle of each of the first five steps, and compares
+ * the estimates of a three-step window with the values computed by hand,
+ * including the partial windows at the beginning and the end.
+ */
+class ApplicationStatsSlidingWindowTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsSlidingWindowTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \brief Add a sample to both estimators.
+     * \param value the sample value.
+     */
+    void AddSample(double value);
+
+    /**
+     * \brief Output callback of the rate estimator.
+     * \param identifier index of the identifier.
+     * \param time the time of the estimate in seconds.
+     * \param value the estimate.
+     */
+    void RateOutput(uint32_t identifier, double time, double value);
+
+    /**
+     * \brief Output callback of the mean estimator.
+     * \param identifier index of the identifier.
+     * \param time the time of the estimate in seconds.
+     * \param value the estimate.
+     */
+    void MeanOutput(uint32_t identifier, double time, double value);
+
+    Ptr<ApplicationStatsSlidingWindow> m_rate; ///< The rate estimator.
+    Ptr<ApplicationStatsSlidingWindow> m_mean; ///< The mean estimator.
+    std::vector<double> m_rateTimes;           ///< Time values of the rate estimates.
+    std::vector<double> m_rates;               ///< The rate estimates.
+    std::vector<double> m_meanTimes;           ///< Time values of the mean estimates.
+    std::vector<double> m_means;               ///< The mean estimates.
+
+}; // end of `class ApplicationStatsSlidingWindowTestCase`
+
+ApplicationStatsSlidingWindowTestCase::ApplicationStatsSlidingWindowTestCase()
+    : TestCase("Sliding-window rate and mean estimates")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsSlidingWindowTestCase::AddSample(double value)
+{
+    m_rate->Add(0, value);
+    m_mean->Add(0, value);
+}
+
+void
+ApplicationStatsSlidingWindowTestCase::RateOutput(uint32_t identifier, double time, double value)
+{
+    NS_TEST_ASSERT_MSG_EQ(identifier, 0, "Invalid identifier");
+    m_rateTimes.push_back(time);
+    m_rates.push_back(value);
+}
+
+void
+ApplicationStatsSlidingWindowTestCase::MeanOutput(uint32_t identifier, double time, double value)
+{
+    NS_TEST_ASSERT_MSG_EQ(identifier, 0, "Invalid identifier");
+    m_meanTimes.push_back(time);
+    m_means.push_back(value);
+}
+
+void
+ApplicationStatsSlidingWindowTestCase::DoRun()
+{
+    Ptr<ApplicationStatsSlidingWindow> partial = Create<ApplicationStatsSlidingWindow>(
+        1,
+        MilliSeconds(2500),
+        Seconds(1),
+        ApplicationStatsSlidingWindow::OUTPUT_RATE,
+        1.0,
+        MakeCallback(&ApplicationStatsSlidingWindowTestCase::RateOutput, this));
+    NS_TEST_ASSERT_MSG_EQ(partial->GetNumOfBuckets(), 3, "Partial steps must be rounded up");
+
+    m_rate = Create<ApplicationStatsSlidingWindow>(
+        1,
+        Seconds(3),
+        Seconds(1),
+        ApplicationStatsSlidingWindow::OUTPUT_RATE,
+        0.5,
+        MakeCallback(&ApplicationStatsSlidingWindowTestCase::RateOutput, this));
+    m_mean = Create<ApplicationStatsSlidingWindow>(
+        1,
+        Seconds(3),
+        Seconds(1),
+        ApplicationStatsSlidingWindow::OUTPUT_MEAN,
+        1.0,
+        MakeCallback(&ApplicationStatsSlidingWindowTestCase::MeanOutput, this));
+    m_rate->Start();
+    m_mean->Start();
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Simulator::Schedule(MilliSeconds(500 + 1000 * i),
+                            &ApplicationStatsSlidingWindowTestCase::AddSample,
+                            this,
+                            i + 1.0);
+    }
+
+    Simulator::Stop(MilliSeconds(8500));
+    Simulator::Run();
+    m_rate->Stop();
+    m_mean->Stop();
+    Simulator::Destroy();
+
+    // Half of the sum of the samples within the last 3 seconds, per second covered.
+    const double rates[] = {0.5, 0.75, 1.0, 1.5, 2.0, 1.5, 0.833333, 0.0};
+    NS_TEST_ASSERT_MSG_EQ(m_rates.size(), 8, "Invalid number of rate estimates");
+    for (uint32_t i = 0; i < m_rates.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_rateTimes[i], i + 1.0, 1e-9, "Invalid time of estimate");
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_rates[i], rates[i], 1e-5, "Invalid rate at step " << i);
+    }
+
+    // The window becomes empty at the last step, so it has no mean.
+    const double means[] = {1.0, 1.5, 2.0, 3.0, 4.0, 4.5, 5.0};
+    NS_TEST_ASSERT_MSG_EQ(m_means.size(), 7, "Invalid number of mean estimates");
+    for (uint32_t i = 0; i < m_means.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_meanTimes[i], i + 1.0, 1e-9, "Invalid time of estimate");
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_means[i], means[i], 1e-9, "Invalid mean at step " << i);
+    }
+
+    m_rate = nullptr;
+    m_mean = nullptr;
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the warm-up truncation and the confidence interval computed
+ *        by ApplicationStatsSteadyState.
+ *
+ * Feeds a series with an exponentially decaying initial bias and uniform
+ * noise around a known steady-state mean, and checks that the warm-up is
+ * truncated, that the mean is estimated without the bias, and that the
+ * confidence interval is tight. The same series is fed into an estimator with
+ * a small number of batches to exercise the merging of batches.
+ */
+class ApplicationStatsSteadyStateTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsSteadyStateTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class ApplicationStatsSteadyStateTestCase`
+
+ApplicationStatsSteadyStateTestCase::ApplicationStatsSteadyStateTestCase()
+    : TestCase("MSER-5 truncation and steady-state confidence interval")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsSteadyStateTestCase::DoRun()
+{
+    ApplicationStatsSteadyState empty;
+    ApplicationStatsSteadyState::Estimate_t estimate = empty.GetEstimate();
+    NS_TEST_ASSERT_MSG_EQ(estimate.retainedCount, 0, "Invalid retained count without samples");
+    NS_TEST_ASSERT_MSG_EQ(std::isinf(estimate.relativePrecision),
+                          true,
+                          "Precision must be unknown without samples");
+
+    ApplicationStatsSteadyState constant;
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        constant.AddSample(3.0);
+    }
+    estimate = constant.GetEstimate();
+    NS_TEST_ASSERT_MSG_EQ(estimate.truncatedCount, 0, "A constant series has no warm-up");
+    NS_TEST_ASSERT_MSG_EQ(estimate.retainedCount, 200, "Invalid retained count");
+    NS_TEST_ASSERT_MSG_EQ_TOL(estimate.mean, 3.0, 1e-9, "Invalid mean of a constant series");
+    NS_TEST_ASSERT_MSG_EQ(estimate.relativePrecision, 0.0, "Invalid precision");
+
+    ApplicationStatsSteadyState unbounded;
+    ApplicationStatsSteadyState merged(64);
+    double sum = 0.0;
+    uint32_t x = 12345;
+    const uint32_t numOfSamples = 5000;
+
+    for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+        // Steady-state mean of 10, with a warm-up bias of 20 decaying over ~1000 samples.
+        x = x * 1664525 + 1013904223;
+        const double u = (x + 0.5) / 4294967296.0;
+        const double sample = 10.0 + 20.0 * std::exp(-(i / 200.0)) + 4.0 * (u - 0.5);
+        unbounded.AddSample(sample);
+        merged.AddSample(sample);
+        sum += sample;
+    }
+
+    // The mean of the whole series is biased by the warm-up.
+    NS_TEST_ASSERT_MSG_GT(sum / numOfSamples, 10.5, "The test series must be biased");
+
+    estimate = unbounded.GetEstimate();
+    NS_TEST_ASSERT_MSG_EQ(unbounded.GetCount(), numOfSamples, "Invalid count");
+    NS_TEST_ASSERT_MSG_EQ(unbounded.GetBatchSize(), 5, "Batches must not be merged");
+    NS_TEST_ASSERT_MSG_GT(estimate.truncatedCount, 200, "Warm-up is not truncated");
+    NS_TEST_ASSERT_MSG_LT(estimate.truncatedCount, 2500, "Truncation beyond half of the series");
+    NS_TEST_ASSERT_MSG_EQ(estimate.truncatedCount + estimate.retainedCount,
+                          numOfSamples,
+                          "Invalid retained count");
+    NS_TEST_ASSERT_MSG_EQ_TOL(estimate.mean, 10.0, 0.1, "Biased steady-state mean");
+    NS_TEST_ASSERT_MSG_GT(estimate.halfWidth, 0.0, "Invalid half-width");
+    NS_TEST_ASSERT_MSG_LT(estimate.relativePrecision, 0.01, "Confidence interval too wide");
+
+    // 5000 samples fill 1000 batches of 5, i.e., 62 batches of 80 with 64 batches at most.
+    estimate = merged.GetEstimate();
+    NS_TEST_ASSERT_MSG_EQ(merged.GetBatchSize(), 80, "Invalid batch size after merging");
+    NS_TEST_ASSERT_MSG_EQ(estimate.truncatedCount + estimate.retainedCount,
+                          4960,
+                          "The incomplete batch must be excluded");
+    NS_TEST_ASSERT_MSG_GT(estimate.truncatedCount, 0, "Warm-up is not truncated");
+    NS_TEST_ASSERT_MSG_EQ_TOL(estimate.mean, 10.0, 0.1, "Biased steady-state mean");
+    NS_TEST_ASSERT_MSG_LT(estimate.relativePrecision, 0.01, "Confidence interval too wide");
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the accumulators and the trace sinks of
+ *        ApplicationStatsInlinePipeline.
+ *
+ * Feeds packet delays to an average pipeline with two identifiers, one of
+ * them without samples, and packets to an interval rate pipeline with an idle
+ * interval in the middle. Checks the outputs upon flush, and that samples
+ * after the flush are ignored.
+ */
+class ApplicationStatsInlinePipelineTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsInlinePipelineTestCase();
+
+  private:
+    virtual void DoRun();
+
+    /// Average pipeline of packet delays.
+    typedef ApplicationStatsInlinePipeline<ApplicationStatsInlineAverage> AveragePipeline_t;
+
+    /// Interval rate pipeline of packet sizes.
+    typedef ApplicationStatsInlinePipeline<ApplicationStatsInlineIntervalRate> RatePipeline_t;
+
+    /// Trace sink of packet delays.
+    typedef AveragePipeline_t::Sink<Time, ApplicationStatsDelayConversion> DelaySink_t;
+
+    /// Trace sink of received packets.
+    typedef RatePipeline_t::Sink<Ptr<const Packet>, ApplicationStatsPacketConversion> PacketSink_t;
+
+    /**
+     * \brief Pass a packet delay to the average pipeline.
+     * \param delay the packet delay.
+     */
+    void AddDelay(Time delay);
+
+    /**
+     * \brief Pass a received packet to the interval rate pipeline.
+     * \param size the size of the packet in bytes.
+     */
+    void AddPacket(uint32_t size);
+
+    /**
+     * \brief Output callback of the average pipeline.
+     * \param identifier index of the identifier.
+     * \param time the time of the output in seconds.
+     * \param value the average.
+     */
+    void AverageOutput(uint32_t identifier, double time, double value);
+
+    /**
+     * \brief Output callback of the interval rate pipeline.
+     * \param identifier index of the identifier.
+     * \param time the time of the output in seconds.
+     * \param value the rate.
+     */
+    void RateOutput(uint32_t identifier, double time, double value);
+
+    Ptr<DelaySink_t> m_delaySink;       ///< Sink of identifier 0 of the average pipeline.
+    Ptr<PacketSink_t> m_packetSink;     ///< Sink of the interval rate pipeline.
+    std::vector<uint32_t> m_averageIds; ///< Identifiers of the averages.
+    std::vector<double> m_averageTimes; ///< Time values of the averages.
+    std::vector<double> m_averages;     ///< The averages.
+    std::vector<double> m_rateTimes;    ///< Time values of the rates.
+    std::vector<double> m_rates;        ///< The rates.
+
+}; // end of `class ApplicationStatsInlinePipelineTestCase`
+
+ApplicationStatsInlinePipelineTestCase::ApplicationStatsInlinePipelineTestCase()
+    : TestCase("Inline average and interval rate pipelines")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsInlinePipelineTestCase::AddDelay(Time delay)
+{
+    m_delaySink->TraceSink(delay, Address());
+}
+
+void
+ApplicationStatsInlinePipelineTestCase::AddPacket(uint32_t size)
+{
+    m_packetSink->TraceSink(Create<Packet>(size), Address());
+}
+
+void
+ApplicationStatsInlinePipelineTestCase::AverageOutput(uint32_t identifier,
+                                                      double time,
+                                                      double value)
+{
+    m_averageIds.push_back(identifier);
+    m_averageTimes.push_back(time);
+    m_averages.push_back(value);
+}
+
+void
+ApplicationStatsInlinePipelineTestCase::RateOutput(uint32_t identifier, double time, double value)
+{
+    NS_TEST_ASSERT_MSG_EQ(identifier, 0, "Invalid identifier");
+    m_rateTimes.push_back(time);
+    m_rates.push_back(value);
+}
+
+void
+ApplicationStatsInlinePipelineTestCase::DoRun()
+{
+    Ptr<AveragePipeline_t> average = Create<AveragePipeline_t>(
+        2,
+        ApplicationStatsInlineAverage(),
+        MakeCallback(&ApplicationStatsInlinePipelineTestCase::AverageOutput, this));
+    m_delaySink = Create<DelaySink_t>(average, 0);
+    Simulator::Schedule(MilliSeconds(100),
+                        &ApplicationStatsInlinePipelineTestCase::AddDelay,
+                        this,
+                        MilliSeconds(10));
+    Simulator::Schedule(MilliSeconds(200),
+                        &ApplicationStatsInlinePipelineTestCase::AddDelay,
+                        this,
+                        MilliSeconds(30));
+
+    // 125 bytes are one kilobit.
+    Ptr<RatePipeline_t> rate = Create<RatePipeline_t>(
+        1,
+        ApplicationStatsInlineIntervalRate(1.0),
+        MakeCallback(&ApplicationStatsInlinePipelineTestCase::RateOutput, this));
+    m_packetSink = Create<PacketSink_t>(rate, 0);
+    const double packetTimes[] = {0.25, 0.5, 1.5, 3.5, 4.25};
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Simulator::Schedule(Seconds(packetTimes[i]),
+                            &ApplicationStatsInlinePipelineTestCase::AddPacket,
+                            this,
+                            125);
+    }
+
+    Simulator::Stop(MilliSeconds(4500));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_averages.size(), 0, "Averages must wait for the flush");
+    average->Flush();
+    rate->Flush();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_averages.size(), 2, "Invalid number of averages");
+    NS_TEST_ASSERT_MSG_EQ(m_averageIds[0], 0, "Invalid identifier");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_averageTimes[0], 4.5, 1e-9, "Invalid time of the average");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_averages[0], 0.02, 1e-9, "Invalid average");
+    NS_TEST_ASSERT_MSG_EQ(m_averageIds[1], 1, "Invalid identifier");
+    NS_TEST_ASSERT_MSG_EQ(m_averages[1], 0.0, "An identifier without samples must average zero");
+
+    // The samples after the flush are ignored.
+    AddDelay(Seconds(1));
+    average->Flush();
+    NS_TEST_ASSERT_MSG_EQ(m_averages.size(), 2, "Output after the flush");
+
+    // The completed intervals, including the idle one, but not the ongoing one.
+    const double rates[] = {2.0, 1.0, 0.0, 1.0};
+    NS_TEST_ASSERT_MSG_EQ(m_rates.size(), 4, "Invalid number of rates");
+    for (uint32_t i = 0; i < m_rates.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_rateTimes[i], i + 1.0, 1e-9, "Invalid time of interval " << i);
+        NS_TEST_ASSERT_MSG_EQ_TOL(m_rates[i], rates[i], 1e-9, "Invalid rate of interval " << i);
+    }
+
+    m_delaySink = nullptr;
+    m_packetSink = nullptr;
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applicationstats
+ * \brief A statistic with a single global summary, fed directly by the test.
+ */
+class ApplicationStatsTelemetryTestHelper : public ApplicationStatsHelper
+{
+  public:
+    /**
+     * \param sample a sample to be added to the summary.
+     */
+    void AddSample(double sample)
+    {
+        AddSummarySample(0, sample);
+    }
+
+  protected:
+    // Inherited from ApplicationStatsHelper base class.
+    virtual void DoInstall()
+    {
+        CreateSummaryPerIdentifier("% identifier value");
+    }
+
+}; // end of `class ApplicationStatsTelemetryTestHelper`
+
+/**
+ * \ingroup applicationstats
+ * \brief Verifies the periodic snapshots of ApplicationStatsTelemetry.
+ *
+ * Feeds one sample per second into a summary, takes a snapshot every second,
+ * and checks that each line of the telemetry file reflects the samples
+ * received up to the time of the snapshot.
+ */
+class ApplicationStatsTelemetryTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ApplicationStatsTelemetryTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class ApplicationStatsTelemetryTestCase`
+
+ApplicationStatsTelemetryTestCase::ApplicationStatsTelemetryTestCase()
+    : TestCase("Periodic telemetry snapshots")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ApplicationStatsTelemetryTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("application-stats-telemetry.txt");
+    // The name of a statistic cannot contain slashes, so its file is in the current directory.
+    const std::string statName = "application-stats-telemetry-stat";
+
+    Ptr<ApplicationStatsTelemetryTestHelper> stat =
+        CreateObject<ApplicationStatsTelemetryTestHelper>();
+    stat->SetName(statName);
+    stat->SetTraceSourceName("Rx");
+    stat->SetIdentifierType(ApplicationStatsHelper::IDENTIFIER_GLOBAL);
+    stat->SetOutputType(ApplicationStatsHelper::OUTPUT_SUMMARY);
+    stat->Install();
+
+    Ptr<ApplicationStatsTelemetry> telemetry = CreateObject<ApplicationStatsTelemetry>();
+    telemetry->SetAttribute("FileName", StringValue(fileName));
+    telemetry->SetAttribute("Interval", TimeValue(Seconds(1)));
+    telemetry->AddStats(stat);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(MilliSeconds(500 + 1000 * i),
+                            &ApplicationStatsTelemetryTestHelper::AddSample,
+                            stat,
+                            2.0 * i + 1.0);
+    }
+
+    Simulator::Stop(MilliSeconds(3500));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(telemetry->GetNumOfSnapshots(), 3, "Invalid number of snapshots");
+    telemetry->Dispose();
+    stat->Dispose();
+    Simulator::Destroy();
+
+    std::ifstream ifs(fileName.c_str());
+    NS_TEST_ASSERT_MSG_EQ(ifs.is_open(), true, "Unable to open " << fileName);
+    std::string line;
+    std::getline(ifs, line);
+    NS_TEST_ASSERT_MSG_EQ(line.substr(0, 1), "%", "Missing heading");
+
+    // The mean of 1, 3, 5, ... is the number of samples.
+    uint32_t numOfRows = 0;
+    while (std::getline(ifs, line))
+    {
+        std::istringstream iss(line);
+        double time = 0.0;
+        double wallClock = 0.0;
+        std::string name;
+        std::string identifier;
+        uint64_t count = 0;
+        double mean = 0.0;
+        iss >> time >> wallClock >> name >> identifier >> count >> mean;
+        NS_TEST_ASSERT_MSG_EQ(iss.fail(), false, "Invalid line: " << line);
+        NS_TEST_ASSERT_MSG_EQ_TOL(time, numOfRows + 1.0, 1e-9, "Invalid time of snapshot");
+        NS_TEST_ASSERT_MSG_EQ(name, stat->GetName(), "Invalid name of statistic");
+        NS_TEST_ASSERT_MSG_EQ(identifier, "global", "Invalid identifier");
+        NS_TEST_ASSERT_MSG_EQ(count, numOfRows + 1, "Invalid count");
+        NS_TEST_ASSERT_MSG_EQ_TOL(mean, numOfRows + 1.0, 1e-9, "Invalid mean");
+        numOfRows++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(numOfRows, 3, "Invalid number of rows");
+
+    ifs.close();
+    std::remove(fileName.c_str());
+    std::remove((statName + ".txt").c_str());
+
+} // end of `void DoRun ()`
+
+/**
+ * \brief Test suite `application-stats`, verifying the building blocks of
+ *        application statistics.
+ */
+class ApplicationStatsTestSuite : public TestSuite
+{
+  public:
+    ApplicationStatsTestSuite();
+};
+
+ApplicationStatsTestSuite::ApplicationStatsTestSuite()
+    : TestSuite("application-stats", UNIT)
+{
+    AddTestCase(new ApplicationStatsSummaryTestCase(100000), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsBinaryWriterTestCase(false), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsBinaryWriterTestCase(true), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsAsyncWriterTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsMergeSummaryTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsScatterSamplerTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsSlidingWindowTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsSteadyStateTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsInlinePipelineTestCase(), TestCase::QUICK);
+    AddTestCase(new ApplicationStatsTelemetryTestCase(), TestCase::QUICK);
+    AddTestCase(new JitterEstimatorTestCase(), TestCase::QUICK);
+}
+
+static ApplicationStatsTestSuite g_applicationStatsTestSuiteInstance;
@@ -18,11 +18,15 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/cbr-application.h"
 #include "ns3/cbr-helper.h"
+#include "ns3/cbr-multi-flow-application.h"
+#include "ns3/enum.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/jitter-estimator.h"
 #include "ns3/log.h"
 #include "ns3/packet-sink-helper.h"
 #include "ns3/packet-sink.h"
@@ -31,6 +35,14 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/traffic-schedule-log.h"
+#include "ns3/traffic-time-tag.h"
+#include "ns3/traffic-timestamp-header.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
 
 using namespace ns3;
 
@@ -112,6 +124,496 @@ CbrTestCase1::DoRun(void)
     NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), sender->GetSent(), "Packets were lost !");
 }
 
+// \brief Test case to verify that CbrMultiFlowApplication drives every flow at
+// its interval through the timer wheel, without synchronized bursts.
+class CbrMultiFlowTestCase : public TestCase
+{
+  public:
+    CbrMultiFlowTestCase();
+
+  private:
+    virtual void DoRun(void);
+
+    // Records the transmission time of every packet.
+    void TxCallback(Ptr<const Packet> packet);
+
+    std::set<int64_t> m_txTimes;
+    uint32_t m_numOfTx;
+};
+
+CbrMultiFlowTestCase::CbrMultiFlowTestCase()
+    : TestCase("Multi-flow Cbr test case to verify all flows are sent and received."),
+      m_numOfTx(0)
+{
+}
+
+void
+CbrMultiFlowTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    m_txTimes.insert(Simulator::Now().GetMicroSeconds());
+    m_numOfTx++;
+}
+
+void
+CbrMultiFlowTestCase::DoRun(void)
+{
+    NodeContainer n;
+    n.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(n);
+
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    n.Get(0)->AddDevice(txDev);
+    n.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer d;
+    d.Add(txDev);
+    d.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(d);
+
+    // two flows towards each of the three sinks
+    const uint32_t numOfSinks = 3;
+    std::vector<Address> remotes;
+    ApplicationContainer serverApps;
+    for (uint16_t port = 4000; port < 4000 + numOfSinks; port++)
+    {
+        PacketSinkHelper server("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+        serverApps.Add(server.Install(n.Get(1)));
+        remotes.push_back(InetSocketAddress(i.GetAddress(1), port));
+        remotes.push_back(InetSocketAddress(i.GetAddress(1), port));
+    }
+    serverApps.Start(Seconds(1.0));
+    serverApps.Stop(Seconds(10.0));
+
+    CbrHelper client("ns3::UdpSocketFactory", Address());
+    client.SetConstantTraffic(MilliSeconds(100), 200);
+    client.SetAttribute("TickDuration", TimeValue(MilliSeconds(1)));
+    client.SetAttribute("StartOffset", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=0.1]"));
+    ApplicationContainer clientApps = client.InstallMultiFlow(n.Get(0), remotes);
+    clientApps.Start(Seconds(2.0));
+    clientApps.Stop(Seconds(8.0));
+
+    Ptr<CbrMultiFlowApplication> sender = DynamicCast<CbrMultiFlowApplication>(clientApps.Get(0));
+    NS_TEST_ASSERT_MSG_EQ(sender->GetNumOfFlows(), remotes.size(), "Unexpected number of flows");
+    sender->TraceConnectWithoutContext("Tx", MakeCallback(&CbrMultiFlowTestCase::TxCallback, this));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    uint64_t totalRx = 0;
+    for (uint32_t j = 0; j < serverApps.GetN(); j++)
+    {
+        totalRx += DynamicCast<PacketSink>(serverApps.Get(j))->GetTotalRx();
+    }
+
+    NS_TEST_ASSERT_MSG_NE(sender->GetSent(), 0, "Nothing sent !");
+    NS_TEST_ASSERT_MSG_EQ(totalRx, sender->GetSent(), "Packets were lost !");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfTx * 200, sender->GetSent(), "Inconsistent Tx trace");
+
+    for (uint32_t j = 0; j < sender->GetNumOfFlows(); j++)
+    {
+        // 6 seconds of 100 ms intervals, minus the start offset
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(sender->GetSent(j), 58 * 200, "Flow " << j << " sent too few");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(sender->GetSent(j), 60 * 200, "Flow " << j << " sent too much");
+    }
+
+    for (std::set<int64_t>::const_iterator it = m_txTimes.begin(); it != m_txTimes.end(); ++it)
+    {
+        NS_TEST_ASSERT_MSG_EQ(*it % 1000, 0, "Transmission at " << *it << " us is not on a tick");
+    }
+    // if all flows were synchronized, every tick would carry one packet of each flow
+    NS_TEST_ASSERT_MSG_GT(m_txTimes.size(),
+                          m_numOfTx / remotes.size(),
+                          "All flows are sent in synchronized bursts");
+}
+
+// \brief Test case to verify the number of packets sent by CbrApplication within
+// time windows of a rate profile.
+class CbrRateProfileTestCase : public TestCase
+{
+  public:
+    // Expected number of packets sent within (start, end], relative to the
+    // start of the application.
+    struct Window_t
+    {
+        double start;
+        double end;
+        uint32_t expected;
+    };
+
+    CbrRateProfileTestCase(std::string name,
+                           Time interval,
+                           std::string envelope,
+                           bool isOnOffEnabled,
+                           const std::vector<Window_t>& windows);
+
+  private:
+    virtual void DoRun(void);
+
+    // Records the transmission time of every packet.
+    void TxCallback(Ptr<const Packet> packet);
+
+    Time m_interval;
+    std::string m_envelope;
+    bool m_isOnOffEnabled;
+    std::vector<Window_t> m_windows;
+    std::vector<Time> m_txTimes;
+};
+
+CbrRateProfileTestCase::CbrRateProfileTestCase(std::string name,
+                                               Time interval,
+                                               std::string envelope,
+                                               bool isOnOffEnabled,
+                                               const std::vector<Window_t>& windows)
+    : TestCase(name),
+      m_interval(interval),
+      m_envelope(envelope),
+      m_isOnOffEnabled(isOnOffEnabled),
+      m_windows(windows)
+{
+}
+
+void
+CbrRateProfileTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    m_txTimes.push_back(Simulator::Now());
+}
+
+void
+CbrRateProfileTestCase::DoRun(void)
+{
+    NodeContainer n;
+    n.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(n);
+
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    n.Get(0)->AddDevice(txDev);
+    n.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer d;
+    d.Add(txDev);
+    d.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(d);
+
+    uint16_t port = 4000;
+    Address serverAddress(InetSocketAddress(i.GetAddress(1), port));
+
+    PacketSinkHelper server("ns3::UdpSocketFactory",
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer serverApps = server.Install(n.Get(1));
+    serverApps.Start(Seconds(1.0));
+    serverApps.Stop(Seconds(20.0));
+
+    const Time startTime = Seconds(2.0);
+    CbrHelper client("ns3::UdpSocketFactory", serverAddress);
+    client.SetAttribute("Interval", TimeValue(m_interval));
+    client.SetAttribute("RateEnvelope", StringValue(m_envelope));
+    client.SetAttribute("EnableOnOff", BooleanValue(m_isOnOffEnabled));
+    client.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=0.5]"));
+    client.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0.5]"));
+    client.SetAttribute("ScheduleChunkSize", UintegerValue(7));
+    ApplicationContainer clientApps = client.Install(n.Get(0));
+    clientApps.Start(startTime);
+    clientApps.Stop(Seconds(18.0));
+
+    Ptr<CbrApplication> sender = DynamicCast<CbrApplication>(clientApps.Get(0));
+    sender->TraceConnectWithoutContext("Tx",
+                                       MakeCallback(&CbrRateProfileTestCase::TxCallback, this));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(serverApps.Get(0));
+    NS_TEST_ASSERT_MSG_NE(sender->GetSent(), (uint32_t)0, "Nothing sent !");
+    NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), sender->GetSent(), "Packets were lost !");
+
+    for (std::vector<Window_t>::const_iterator it = m_windows.begin(); it != m_windows.end(); ++it)
+    {
+        uint32_t count = 0;
+        for (std::vector<Time>::const_iterator jt = m_txTimes.begin(); jt != m_txTimes.end(); ++jt)
+        {
+            const double t = (*jt - startTime).GetSeconds();
+            if (t > it->start + 1e-9 && t <= it->end + 1e-9)
+            {
+                count++;
+            }
+        }
+
+        // allow one packet of rounding error at each boundary
+        NS_TEST_ASSERT_MSG_EQ_TOL(count,
+                                  it->expected,
+                                  (it->expected == 0) ? 0u : 1u,
+                                  "Unexpected number of packets within (" << it->start << ", "
+                                                                          << it->end << "]");
+    }
+}
+
+// \brief Test case to verify that CbrApplication replays the transmission times
+// recorded into a schedule log, instead of drawing new on/off periods. The
+// replaying run uses a constant on time, which would not produce any off
+// period within the simulation.
+class CbrScheduleLogTestCase : public TestCase
+{
+  public:
+    CbrScheduleLogTestCase();
+
+  private:
+    virtual void DoRun(void);
+
+    // Runs a single simulation and returns the transmission times relative to
+    // the start of the application.
+    std::vector<Time> RunSimulation(TrafficScheduleLog::Mode_t mode,
+                                    std::string onTime,
+                                    std::string fileName);
+
+    // Records the transmission time of every packet.
+    void TxCallback(Ptr<const Packet> packet);
+
+    std::vector<Time> m_txTimes;
+};
+
+CbrScheduleLogTestCase::CbrScheduleLogTestCase()
+    : TestCase("Cbr schedule log")
+{
+}
+
+void
+CbrScheduleLogTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    m_txTimes.push_back(Simulator::Now());
+}
+
+void
+CbrScheduleLogTestCase::DoRun(void)
+{
+    const std::string fileName = CreateTempDirFilename("cbr-schedule-log.bin");
+    const std::string randomOnTime = "ns3::ExponentialRandomVariable[Mean=0.3]";
+    const std::string constantOnTime = "ns3::ConstantRandomVariable[Constant=5.0]";
+
+    const std::vector<Time> recorded =
+        RunSimulation(TrafficScheduleLog::RECORD, randomOnTime, fileName);
+    const std::vector<Time> replayed =
+        RunSimulation(TrafficScheduleLog::REPLAY, constantOnTime, fileName);
+
+    NS_TEST_ASSERT_MSG_GT(recorded.size(), 0, "Nothing sent !");
+    NS_TEST_ASSERT_MSG_EQ(replayed.size(), recorded.size(), "Different number of packets");
+    for (uint32_t k = 0; k < std::min(replayed.size(), recorded.size()); k++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(replayed[k], recorded[k], "Packet " << k << " not replayed");
+    }
+}
+
+std::vector<Time>
+CbrScheduleLogTestCase::RunSimulation(TrafficScheduleLog::Mode_t mode,
+                                      std::string onTime,
+                                      std::string fileName)
+{
+    NodeContainer n;
+    n.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(n);
+
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    n.Get(0)->AddDevice(txDev);
+    n.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer d;
+    d.Add(txDev);
+    d.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(d);
+
+    uint16_t port = 4000;
+    Address serverAddress(InetSocketAddress(i.GetAddress(1), port));
+
+    PacketSinkHelper server("ns3::UdpSocketFactory",
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer serverApps = server.Install(n.Get(1));
+    serverApps.Start(Seconds(1.0));
+    serverApps.Stop(Seconds(10.0));
+
+    const Time startTime = Seconds(2.0);
+    CbrHelper client("ns3::UdpSocketFactory", serverAddress);
+    client.SetAttribute("Interval", TimeValue(MilliSeconds(10)));
+    client.SetAttribute("EnableOnOff", BooleanValue(true));
+    client.SetAttribute("OnTime", StringValue(onTime));
+    client.SetAttribute("OffTime", StringValue("ns3::ExponentialRandomVariable[Mean=0.2]"));
+    client.SetAttribute("ScheduleLogMode", EnumValue(mode));
+    client.SetAttribute("ScheduleLogFile", StringValue(fileName));
+    ApplicationContainer clientApps = client.Install(n.Get(0));
+    clientApps.Start(startTime);
+    clientApps.Stop(Seconds(8.0));
+
+    m_txTimes.clear();
+    clientApps.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&CbrScheduleLogTestCase::TxCallback, this));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::vector<Time> txTimes;
+    for (std::vector<Time>::const_iterator it = m_txTimes.begin(); it != m_txTimes.end(); ++it)
+    {
+        txTimes.push_back(*it - startTime);
+    }
+    return txTimes;
+}
+
+// \brief Test case to verify that CbrApplication carries the send time in a
+// TrafficTimestampHeader instead of a tag, optionally copying a packet template.
+class CbrTimestampHeaderTestCase : public TestCase
+{
+  public:
+    CbrTimestampHeaderTestCase(bool usePacketTemplate);
+
+  private:
+    virtual void DoRun(void);
+
+    // Records the transmission time of every packet.
+    void TxCallback(Ptr<const Packet> packet);
+
+    // Verifies the timestamp of every received packet.
+    void RxCallback(Ptr<const Packet> packet, const Address& from);
+
+    bool m_usePacketTemplate;
+    std::vector<Time> m_txTimes;
+    std::vector<Time> m_senderTimestamps;
+    uint32_t m_numOfTaggedPackets;
+    JitterEstimator m_jitterEstimator;
+};
+
+CbrTimestampHeaderTestCase::CbrTimestampHeaderTestCase(bool usePacketTemplate)
+    : TestCase(usePacketTemplate ? "Cbr timestamp header with packet template"
+                                 : "Cbr timestamp header"),
+      m_usePacketTemplate(usePacketTemplate),
+      m_numOfTaggedPackets(0)
+{
+}
+
+void
+CbrTimestampHeaderTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    m_txTimes.push_back(Simulator::Now());
+}
+
+void
+CbrTimestampHeaderTestCase::RxCallback(Ptr<const Packet> packet, const Address& from)
+{
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 200, "The header must not change the packet size");
+
+    TrafficTimeTag timeTag;
+    if (packet->PeekPacketTag(timeTag))
+    {
+        m_numOfTaggedPackets++;
+    }
+
+    Time senderTimestamp;
+    const bool hasHeader = TrafficTimestampHeader::PeekSenderTimestamp(packet, senderTimestamp);
+    NS_TEST_ASSERT_MSG_EQ(hasHeader, true, "Received a packet without timestamp header");
+    m_senderTimestamps.push_back(senderTimestamp);
+    NS_TEST_ASSERT_MSG_EQ(m_jitterEstimator.AddPacket(packet),
+                          true,
+                          "The jitter estimator must read the header");
+}
+
+void
+CbrTimestampHeaderTestCase::DoRun(void)
+{
+    NodeContainer n;
+    n.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(n);
+
+    // link the two nodes
+    Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice>();
+    n.Get(0)->AddDevice(txDev);
+    n.Get(1)->AddDevice(rxDev);
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    txDev->SetChannel(channel1);
+    NetDeviceContainer d;
+    d.Add(txDev);
+    d.Add(rxDev);
+
+    Ipv4AddressHelper ipv4;
+
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(d);
+
+    uint16_t port = 4000;
+    Address serverAddress(InetSocketAddress(i.GetAddress(1), port));
+
+    PacketSinkHelper server("ns3::UdpSocketFactory",
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer serverApps = server.Install(n.Get(1));
+    serverApps.Start(Seconds(1.0));
+    serverApps.Stop(Seconds(10.0));
+
+    CbrHelper client("ns3::UdpSocketFactory", serverAddress);
+    client.SetConstantTraffic(MilliSeconds(100), 200);
+    client.SetAttribute("EnableStatisticsTags", BooleanValue(true));
+    client.SetAttribute("EnableTimestampHeader", BooleanValue(true));
+    client.SetAttribute("UsePacketTemplate", BooleanValue(m_usePacketTemplate));
+    ApplicationContainer clientApps = client.Install(n.Get(0));
+    clientApps.Start(Seconds(2.0));
+    clientApps.Stop(Seconds(8.0));
+
+    clientApps.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&CbrTimestampHeaderTestCase::TxCallback, this));
+    serverApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&CbrTimestampHeaderTestCase::RxCallback, this));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(serverApps.Get(0));
+    Ptr<CbrApplication> sender = DynamicCast<CbrApplication>(clientApps.Get(0));
+    NS_TEST_ASSERT_MSG_NE(sender->GetSent(), 0, "Nothing sent !");
+    NS_TEST_ASSERT_MSG_EQ(sink->GetTotalRx(), sender->GetSent(), "Packets were lost !");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfTaggedPackets, 0, "The send time must not be tagged");
+
+    // every copy of the template carries its own timestamp
+    NS_TEST_ASSERT_MSG_EQ(m_senderTimestamps.size(), m_txTimes.size(), "Packets were lost !");
+    for (uint32_t k = 0; k < std::min(m_senderTimestamps.size(), m_txTimes.size()); k++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_senderTimestamps[k], m_txTimes[k], "Invalid timestamp " << k);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_jitterEstimator.GetJitter(), Seconds(0), "Invalid jitter");
+}
+
 // The CbrTestSuite class names the TestSuite as cbr-test, identifies what type of TestSuite (UNIT),
 // and enables the TestCases to be run CbrTestCase1.
 //
@@ -125,6 +627,46 @@ CbrTestSuite::CbrTestSuite()
     : TestSuite("cbr-test", UNIT)
 {
     AddTestCase(new CbrTestCase1, TestCase::QUICK);
+    AddTestCase(new CbrMultiFlowTestCase, TestCase::QUICK);
+
+    // 1 s at 10 packets per second, 1 s of silence, 2 s at 20 packets per second
+    std::vector<CbrRateProfileTestCase::Window_t> envelopeWindows = {{0.0, 1.0, 10},
+                                                                     {1.0, 2.0, 0},
+                                                                     {2.0, 4.0, 40},
+                                                                     {4.0, 5.0, 10},
+                                                                     {5.0, 6.0, 0},
+                                                                     {6.0, 8.0, 40}};
+    AddTestCase(new CbrRateProfileTestCase("Cbr rate envelope",
+                                           MilliSeconds(100),
+                                           "1s:1.0,1s:0,2s:2.0",
+                                           false,
+                                           envelopeWindows),
+                TestCase::QUICK);
+
+    // alternating 0.5 s on and off periods at 100 packets per second
+    std::vector<CbrRateProfileTestCase::Window_t> onOffWindows;
+    for (uint32_t k = 0; k < 8; k++)
+    {
+        onOffWindows.push_back({0.5 * k, 0.5 * (k + 1), (k % 2 == 0) ? 50u : 0u});
+    }
+    AddTestCase(
+        new CbrRateProfileTestCase("Cbr on/off", MilliSeconds(10), "", true, onOffWindows),
+        TestCase::QUICK);
+
+    // half rate during the on periods
+    std::vector<CbrRateProfileTestCase::Window_t> combinedWindows = {{0.0, 0.5, 25},
+                                                                     {0.5, 1.0, 0},
+                                                                     {1.0, 2.0, 25}};
+    AddTestCase(new CbrRateProfileTestCase("Cbr rate envelope with on/off",
+                                           MilliSeconds(10),
+                                           "10s:0.5",
+                                           true,
+                                           combinedWindows),
+                TestCase::QUICK);
+
+    AddTestCase(new CbrScheduleLogTestCase, TestCase::QUICK);
+    AddTestCase(new CbrTimestampHeaderTestCase(false), TestCase::QUICK);
+    AddTestCase(new CbrTimestampHeaderTestCase(true), TestCase::QUICK);
 }
 
 // Allocate an instance of this TestSuite
@@ -27,31 +27,52 @@
  * \brief Test cases for NRTV traffic models, grouped in `nrtv` test suite.
  */
 
+#include <ns3/application-stats-throughput-helper.h>
 #include <ns3/application.h>
+#include <ns3/boolean.h>
 #include <ns3/config.h>
 #include <ns3/data-rate.h>
+#include <ns3/enum.h>
+#include <ns3/error-model.h>
 #include <ns3/integer.h>
 #include <ns3/internet-stack-helper.h>
 #include <ns3/ipv4-address-helper.h>
+#include <ns3/ipv4-global-routing-helper.h>
 #include <ns3/ipv4-interface-container.h>
+#include <ns3/ipv4.h>
 #include <ns3/log.h>
 #include <ns3/net-device-container.h>
 #include <ns3/node-container.h>
+#include <ns3/nrtv-feedback-header.h>
 #include <ns3/nrtv-header.h>
 #include <ns3/nrtv-helper.h>
+#include <ns3/nrtv-udp-client.h>
+#include <ns3/nrtv-variables.h>
+#include <ns3/nrtv-video-trace.h>
 #include <ns3/nstime.h>
+#include <ns3/packet.h>
 #include <ns3/point-to-point-helper.h>
+#include <ns3/pointer.h>
+#include <ns3/server-shard-helper.h>
 #include <ns3/simulator.h>
 #include <ns3/string.h>
 #include <ns3/tcp-socket-factory.h>
+#include <ns3/traffic-counters.h>
+#include <ns3/traffic-schedule-log.h>
+#include <ns3/traffic-time-tag.h>
+#include <ns3/traffic-timestamp.h>
 #include <ns3/test.h>
 #include <ns3/type-id.h>
 #include <ns3/udp-socket-factory.h>
 #include <ns3/uinteger.h>
 #include <ns3/unused.h>
 
+#include <algorithm>
 #include <list>
+#include <map>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("NrtvTest");
 
@@ -249,9 +270,2201 @@ NrtvClientRxBufferTestCase::RxSliceCallback(std::string context, Ptr<const Packe
     m_packetsInTransit.pop_front();
 }
 
+/**
+ * \ingroup applications
+ * \brief Verifies whether the NRTV TCP client properly detects video slice
+ *        boundaries when the slices are not re-assembled into packets.
+ *
+ * The `RxSlice` trace source of the client is left unconnected, so that the
+ * client Rx buffer skips re-assembling video slices into packets. The test
+ * case verifies that every slice reported by the `RxDelay` trace source
+ * corresponds to a slice sent by the server, by comparing the total number of
+ * bytes received with the sizes of the slices sent.
+ */
+class NrtvClientRxHeaderOnlyTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param rngRun the number of run to be used by the random number generator
+     * \param channelDelay fixed transmission delay to be set on the
+     *                     point-to-point channel
+     * \param duration length of simulation
+     * \param rxBufferCapacity value of the `RxBufferCapacity` attribute of the
+     *                         client, zero for an unbounded Rx buffer
+     * \param recvBatchSize value of the `RecvBatchSize` attribute of the
+     *                      client, zero for reading one packet at a time
+     */
+    NrtvClientRxHeaderOnlyTestCase(std::string name,
+                                   uint32_t rngRun,
+                                   Time channelDelay,
+                                   Time duration,
+                                   uint32_t rxBufferCapacity = 0,
+                                   uint32_t recvBatchSize = 0);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+    void RxCallback(Ptr<const Packet> packet, const Address& from);
+    void RxDelayCallback(const Time& delay, const Address& from);
+    void RxBufferOccupancyCallback(uint32_t oldValue, uint32_t newValue);
+
+    /// Size of packets which have been transmitted but not yet received as a slice.
+    std::list<uint32_t> m_packetsInTransit;
+    /// Number of bytes received but not yet accounted as a complete slice.
+    uint64_t m_pendingRxBytes;
+    /// Number of bytes received in total.
+    uint64_t m_totalRxBytes;
+    /// Number of slices received.
+    uint32_t m_numOfSlices;
+    /// Largest occupancy of the Rx buffer.
+    uint32_t m_maxOccupancy;
+    uint32_t m_rngRun;
+    Time m_channelDelay;
+    Time m_duration;
+    uint32_t m_rxBufferCapacity;
+    uint32_t m_recvBatchSize;
+
+}; // end of `class NrtvClientRxHeaderOnlyTestCase`
+
+NrtvClientRxHeaderOnlyTestCase::NrtvClientRxHeaderOnlyTestCase(std::string name,
+                                                               uint32_t rngRun,
+                                                               Time channelDelay,
+                                                               Time duration,
+                                                               uint32_t rxBufferCapacity,
+                                                               uint32_t recvBatchSize)
+    : TestCase(name),
+      m_pendingRxBytes(0),
+      m_totalRxBytes(0),
+      m_numOfSlices(0),
+      m_maxOccupancy(0),
+      m_rngRun(rngRun),
+      m_channelDelay(channelDelay),
+      m_duration(duration),
+      m_rxBufferCapacity(rxBufferCapacity),
+      m_recvBatchSize(recvBatchSize)
+{
+    NS_LOG_FUNCTION(this << name << rngRun);
+}
+
+void
+NrtvClientRxHeaderOnlyTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(m_channelDelay));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.SetClientAttribute("RxBufferCapacity", UintegerValue(m_rxBufferCapacity));
+    helper.SetClientAttribute("RecvBatchSize", UintegerValue(m_recvBatchSize));
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    server->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&NrtvClientRxHeaderOnlyTestCase::TxCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxBufferOccupancy",
+        MakeCallback(&NrtvClientRxHeaderOnlyTestCase::RxBufferOccupancyCallback, this));
+    client->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&NrtvClientRxHeaderOnlyTestCase::RxCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxDelay",
+        MakeCallback(&NrtvClientRxHeaderOnlyTestCase::RxDelayCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+
+    // The counter read by the polling mode of the throughput statistics.
+    const Callback<uint64_t> rxCounter = ApplicationStatsThroughputHelper::GetRxCounter(client);
+    NS_TEST_ASSERT_MSG_EQ(rxCounter.IsNull(), false, "Client has no received byte counter");
+    NS_TEST_ASSERT_MSG_EQ(rxCounter(), m_totalRxBytes, "Invalid received byte counter");
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfSlices, 0, "No video slice has been received");
+    const uint32_t nextSliceSize = m_packetsInTransit.empty() ? 0 : m_packetsInTransit.front();
+    NS_TEST_ASSERT_MSG_LT(m_pendingRxBytes,
+                          nextSliceSize + 1,
+                          "Received bytes which have not been recognised as a slice");
+    if (m_rxBufferCapacity > 0)
+    {
+        NS_TEST_ASSERT_MSG_LT(m_maxOccupancy,
+                              m_rxBufferCapacity + 1,
+                              "Rx buffer occupancy exceeds its capacity");
+    }
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+
+} // end of `void DoRun ()`
+
+void
+NrtvClientRxHeaderOnlyTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_packetsInTransit.push_back(packet->GetSize());
+}
+
+void
+NrtvClientRxHeaderOnlyTestCase::RxCallback(Ptr<const Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_pendingRxBytes += packet->GetSize();
+    m_totalRxBytes += packet->GetSize();
+    if (m_rxBufferCapacity > 0)
+    {
+        NS_TEST_ASSERT_MSG_LT(packet->GetSize(),
+                              m_rxBufferCapacity + 1,
+                              "Read more bytes than the Rx buffer capacity");
+    }
+    if (m_recvBatchSize > 0)
+    {
+        NS_TEST_ASSERT_MSG_LT(packet->GetSize(),
+                              m_recvBatchSize + 1,
+                              "Read more bytes than the Recv batch size");
+    }
+}
+
+void
+NrtvClientRxHeaderOnlyTestCase::RxBufferOccupancyCallback(uint32_t oldValue, uint32_t newValue)
+{
+    NS_LOG_FUNCTION(this << oldValue << newValue);
+    m_maxOccupancy = std::max(m_maxOccupancy, newValue);
+}
+
+void
+NrtvClientRxHeaderOnlyTestCase::RxDelayCallback(const Time& delay, const Address& from)
+{
+    NS_LOG_FUNCTION(this << delay.GetSeconds());
+    NS_ASSERT_MSG(m_packetsInTransit.size() > 0,
+                  "Received a slice before any packet was transmitted before");
+
+    /*
+     * The Rx trace is fired before the slices which the packet completes are
+     * reported, so the bytes received so far must cover the slice.
+     */
+    const uint32_t sliceSize = m_packetsInTransit.front();
+    NS_TEST_ASSERT_MSG_GT(m_pendingRxBytes + 1,
+                          sliceSize,
+                          "Slice reported before all its bytes were received at "
+                              << Simulator::Now().GetSeconds());
+    m_pendingRxBytes -= std::min<uint64_t>(m_pendingRxBytes, sliceSize);
+    m_packetsInTransit.pop_front();
+    m_numOfSlices++;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the de-jitter playout buffer of NrtvTcpClient.
+ *
+ * Runs a simulation of an NRTV TCP client connected to an NRTV server through
+ * a simple point-to-point interface, with a short de-jitter buffer window. The
+ * test case verifies that the playout begins only after the window, that frames
+ * are played in order, only after they have been received, and no faster than
+ * the frame interval, and that every stall lasts at least the window.
+ */
+class NrtvPlayoutTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param rngRun the number of run to be used by the random number generator
+     * \param channelDelay fixed transmission delay to be set on the
+     *                     point-to-point channel
+     * \param duration length of simulation
+     */
+    NrtvPlayoutTestCase(std::string name, uint32_t rngRun, Time channelDelay, Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+    void PlayoutFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+    void StartupDelayCallback(Time delay);
+    void StallCallback(uint32_t stallCount);
+    void StallDurationCallback(Time duration);
+
+    uint32_t m_numOfRxFrames;     ///< Number of frames received.
+    uint32_t m_numOfPlayedFrames; ///< Number of frames played.
+    uint32_t m_numOfStartups;     ///< Number of times the playout has begun.
+    uint32_t m_numOfStalls;       ///< Number of times the playout has stalled.
+    Time m_lastPlayoutTime;       ///< Time when the last frame was played.
+    bool m_isStalled;             ///< True between a stall and its end.
+    uint32_t m_rngRun;
+    Time m_channelDelay;
+    Time m_duration;
+    Time m_windowSize;
+    Time m_frameInterval;
+
+}; // end of `class NrtvPlayoutTestCase`
+
+NrtvPlayoutTestCase::NrtvPlayoutTestCase(std::string name,
+                                         uint32_t rngRun,
+                                         Time channelDelay,
+                                         Time duration)
+    : TestCase(name),
+      m_numOfRxFrames(0),
+      m_numOfPlayedFrames(0),
+      m_numOfStartups(0),
+      m_numOfStalls(0),
+      m_isStalled(false),
+      m_rngRun(rngRun),
+      m_channelDelay(channelDelay),
+      m_duration(duration),
+      m_windowSize(Seconds(1)),
+      m_frameInterval(MilliSeconds(100))
+{
+    NS_LOG_FUNCTION(this << name << rngRun);
+}
+
+void
+NrtvPlayoutTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVariables::DejitterBufferWindowSize", TimeValue(m_windowSize));
+    Config::SetDefault("ns3::NrtvVariables::FrameInterval", TimeValue(m_frameInterval));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(m_channelDelay));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    client->TraceConnectWithoutContext(
+        "RxFrame",
+        MakeCallback(&NrtvPlayoutTestCase::RxFrameCallback, this));
+    client->TraceConnectWithoutContext(
+        "PlayoutFrame",
+        MakeCallback(&NrtvPlayoutTestCase::PlayoutFrameCallback, this));
+    client->TraceConnectWithoutContext(
+        "PlayoutStartupDelay",
+        MakeCallback(&NrtvPlayoutTestCase::StartupDelayCallback, this));
+    client->TraceConnectWithoutContext("PlayoutStall",
+                                       MakeCallback(&NrtvPlayoutTestCase::StallCallback, this));
+    client->TraceConnectWithoutContext(
+        "PlayoutStallDuration",
+        MakeCallback(&NrtvPlayoutTestCase::StallDurationCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfRxFrames, 0, "No frame has been received");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfStartups, 1, "The playout must begin exactly once");
+    NS_TEST_ASSERT_MSG_GT(m_numOfPlayedFrames, 0, "No frame has been played");
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+    Config::SetDefault("ns3::NrtvVariables::DejitterBufferWindowSize", TimeValue(Seconds(5)));
+    Config::SetDefault("ns3::NrtvVariables::FrameInterval", TimeValue(MilliSeconds(100)));
+
+} // end of `void DoRun ()`
+
+void
+NrtvPlayoutTestCase::RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+    m_numOfRxFrames++;
+}
+
+void
+NrtvPlayoutTestCase::PlayoutFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+    NS_TEST_ASSERT_MSG_EQ(frameNumber, m_numOfPlayedFrames + 1, "Frame played out of order");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(frameNumber,
+                                m_numOfRxFrames,
+                                "Frame played before it has been received");
+    NS_TEST_ASSERT_MSG_EQ(m_isStalled, false, "Frame played during a stall");
+
+    if (m_numOfPlayedFrames > 0)
+    {
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(Simulator::Now() - m_lastPlayoutTime,
+                                    m_frameInterval,
+                                    "Frames played faster than the frame interval");
+    }
+
+    m_numOfPlayedFrames++;
+    m_lastPlayoutTime = Simulator::Now();
+}
+
+void
+NrtvPlayoutTestCase::StartupDelayCallback(Time delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetSeconds());
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(delay, m_windowSize, "Playout began before the window");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfPlayedFrames, 0, "Frames played before the startup");
+    m_numOfStartups++;
+}
+
+void
+NrtvPlayoutTestCase::StallCallback(uint32_t stallCount)
+{
+    NS_LOG_FUNCTION(this << stallCount);
+    m_numOfStalls++;
+    NS_TEST_ASSERT_MSG_EQ(stallCount, m_numOfStalls, "Invalid stall count");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfPlayedFrames, m_numOfRxFrames, "Stalled with frames in buffer");
+    m_isStalled = true;
+}
+
+void
+NrtvPlayoutTestCase::StallDurationCallback(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration.GetSeconds());
+    NS_TEST_ASSERT_MSG_EQ(m_isStalled, true, "Stall ended without beginning");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(duration, m_windowSize, "Stall shorter than the window");
+    m_isStalled = false;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the `RxFrameStats` trace source of NrtvTcpClient.
+ *
+ * Runs a simulation of an NRTV TCP client connected to an NRTV server, and
+ * accumulates the size and the largest delay of the slices of every frame from
+ * the `RxSlice` trace source. The test case verifies that `RxFrameStats` is
+ * fired for every frame reported by `RxFrame`, with the same frame number,
+ * frame size, and largest slice delay, and with a frame delay not less than
+ * the largest slice delay.
+ */
+class NrtvFrameStatsTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param channelDelay transmission delay between the client and the server
+     * \param duration length of simulation
+     */
+    NrtvFrameStatsTestCase(Time channelDelay, Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxSliceCallback(Ptr<const Packet> slice);
+    void RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+    void RxFrameStatsCallback(uint32_t frameNumber,
+                              uint32_t frameSize,
+                              const Time& frameDelay,
+                              const Time& maxSliceDelay,
+                              const Address& from);
+
+    uint32_t m_frameNumber;    ///< Frame of the slices accumulated so far.
+    uint32_t m_frameSize;      ///< Sum of the slice sizes of the frame.
+    Time m_maxSliceDelay;      ///< Largest delay of the slices of the frame.
+    uint32_t m_numOfRxFrames;  ///< Number of `RxFrame` traces.
+    uint32_t m_numOfRxStats;   ///< Number of `RxFrameStats` traces.
+    Time m_channelDelay;
+    Time m_duration;
+
+}; // end of `class NrtvFrameStatsTestCase`
+
+NrtvFrameStatsTestCase::NrtvFrameStatsTestCase(Time channelDelay, Time duration)
+    : TestCase("frame stats, delay=" + std::to_string(channelDelay.GetMilliSeconds()) + "ms"),
+      m_frameNumber(0),
+      m_frameSize(0),
+      m_numOfRxFrames(0),
+      m_numOfRxStats(0),
+      m_channelDelay(channelDelay),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << channelDelay.GetSeconds() << duration.GetSeconds());
+}
+
+void
+NrtvFrameStatsTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(m_channelDelay));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    client->TraceConnectWithoutContext(
+        "RxSlice",
+        MakeCallback(&NrtvFrameStatsTestCase::RxSliceCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxFrame",
+        MakeCallback(&NrtvFrameStatsTestCase::RxFrameCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxFrameStats",
+        MakeCallback(&NrtvFrameStatsTestCase::RxFrameStatsCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfRxStats, 0, "No frame statistics have been reported");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfRxStats, m_numOfRxFrames, "Frame statistics were missed");
+
+} // end of `void DoRun ()`
+
+void
+NrtvFrameStatsTestCase::RxSliceCallback(Ptr<const Packet> slice)
+{
+    NrtvHeader nrtvHeader;
+    slice->PeekHeader(nrtvHeader);
+    const Time delay = Simulator::Now() - nrtvHeader.GetArrivalTime();
+    NS_LOG_FUNCTION(this << nrtvHeader.GetFrameNumber() << nrtvHeader.GetSliceNumber()
+                         << delay.GetSeconds());
+
+    if (nrtvHeader.GetFrameNumber() != m_frameNumber || m_frameSize == 0)
+    {
+        // the first slice of a frame, or the previous frame was not complete
+        m_frameNumber = nrtvHeader.GetFrameNumber();
+        m_frameSize = 0;
+        m_maxSliceDelay = delay;
+    }
+    m_frameSize += nrtvHeader.GetSliceSize();
+    m_maxSliceDelay = std::max(m_maxSliceDelay, delay);
+}
+
+void
+NrtvFrameStatsTestCase::RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+    m_numOfRxFrames++;
+}
+
+void
+NrtvFrameStatsTestCase::RxFrameStatsCallback(uint32_t frameNumber,
+                                             uint32_t frameSize,
+                                             const Time& frameDelay,
+                                             const Time& maxSliceDelay,
+                                             const Address& from)
+{
+    NS_LOG_FUNCTION(this << frameNumber << frameSize << frameDelay.GetSeconds()
+                         << maxSliceDelay.GetSeconds());
+    NS_TEST_ASSERT_MSG_EQ(frameNumber, m_frameNumber, "Unexpected frame number");
+    NS_TEST_ASSERT_MSG_EQ(frameSize, m_frameSize, "Unexpected frame size");
+    NS_TEST_ASSERT_MSG_EQ(maxSliceDelay, m_maxSliceDelay, "Unexpected largest slice delay");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(frameDelay, maxSliceDelay, "Frame delay is too short");
+    m_numOfRxStats++;
+    m_frameSize = 0;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies that the `SliceBatching` mode of NrtvVideoWorker transmits
+ *        the same video slices at the same time as the per-slice mode.
+ *
+ * Runs the same simulation of an NRTV server and client twice, first in
+ * per-slice mode and then with `SliceBatching` enabled, and compares the time
+ * and size of every packet reported by the `Tx` trace source of the server.
+ */
+class NrtvSliceBatchingTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param rngRun the number of run to be used by the random number generator
+     * \param protocolTypeId determines the socket type (TCP or UDP)
+     * \param duration length of simulation
+     */
+    NrtvSliceBatchingTestCase(std::string name,
+                              uint32_t rngRun,
+                              TypeId protocolTypeId,
+                              Time duration);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \brief Run a single simulation.
+     * \param sliceBatching value of the `SliceBatching` attribute
+     * \param txLog output argument, where the time and size of each
+     *              transmitted packet are appended
+     */
+    void RunSimulation(bool sliceBatching, std::vector<std::pair<Time, uint32_t>>& txLog);
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+
+    /// Where TxCallback() stores the time and size of transmitted packets.
+    std::vector<std::pair<Time, uint32_t>>* m_txLog;
+    uint32_t m_rngRun;
+    TypeId m_protocolTypeId;
+    Time m_duration;
+
+}; // end of `class NrtvSliceBatchingTestCase`
+
+NrtvSliceBatchingTestCase::NrtvSliceBatchingTestCase(std::string name,
+                                                     uint32_t rngRun,
+                                                     TypeId protocolTypeId,
+                                                     Time duration)
+    : TestCase(name),
+      m_txLog(nullptr),
+      m_rngRun(rngRun),
+      m_protocolTypeId(protocolTypeId),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << rngRun);
+}
+
+void
+NrtvSliceBatchingTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    std::vector<std::pair<Time, uint32_t>> perSliceLog;
+    std::vector<std::pair<Time, uint32_t>> batchedLog;
+    RunSimulation(false, perSliceLog);
+    RunSimulation(true, batchedLog);
+
+    NS_TEST_ASSERT_MSG_GT(perSliceLog.size(), 0, "No video slice has been transmitted");
+    NS_TEST_ASSERT_MSG_EQ(batchedLog.size(),
+                          perSliceLog.size(),
+                          "Different number of transmitted slices");
+
+    const uint32_t n = std::min(perSliceLog.size(), batchedLog.size());
+    for (uint32_t i = 0; i < n; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(batchedLog[i].first,
+                              perSliceLog[i].first,
+                              "Different transmission time of slice " << i);
+        NS_TEST_ASSERT_MSG_EQ(batchedLog[i].second,
+                              perSliceLog[i].second,
+                              "Different size of slice " << i);
+    }
+
+} // end of `void DoRun ()`
+
+void
+NrtvSliceBatchingTestCase::RunSimulation(bool sliceBatching,
+                                         std::vector<std::pair<Time, uint32_t>>& txLog)
+{
+    NS_LOG_FUNCTION(this << sliceBatching);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVideoWorker::SliceBatching", BooleanValue(sliceBatching));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(m_protocolTypeId);
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    m_txLog = &txLog;
+    server->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&NrtvSliceBatchingTestCase::TxCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+    m_txLog = nullptr;
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+    Config::SetDefault("ns3::NrtvVideoWorker::SliceBatching", BooleanValue(false));
+
+} // end of `void RunSimulation (bool, std::vector<std::pair<Time, uint32_t> > &)`
+
+void
+NrtvSliceBatchingTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    NS_ASSERT(m_txLog != nullptr);
+    m_txLog->push_back(std::make_pair(Simulator::Now(), packet->GetSize()));
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the `SharedStream` mode of NrtvUdpServer.
+ *
+ * Runs a simulation of an NRTV UDP server connected to two clients through
+ * separate point-to-point links with equal delays. The test case verifies that
+ * both clients receive the same sequence of video slices, and that the `Tx`
+ * trace source of the server is fired for every packet sent to every client.
+ */
+class NrtvUdpSharedStreamTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param rngRun the number of run to be used by the random number generator
+     * \param duration length of simulation
+     */
+    NrtvUdpSharedStreamTestCase(std::string name, uint32_t rngRun, Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+    void RxCallback(std::string context, Ptr<const Packet> packet, const Address& from);
+
+    /// Number of packets reported by the `Tx` trace source of the server.
+    uint32_t m_numOfTxPackets;
+    /// Size of packets received by each client.
+    std::vector<uint32_t> m_rxSizes[2];
+    uint32_t m_rngRun;
+    Time m_duration;
+
+}; // end of `class NrtvUdpSharedStreamTestCase`
+
+NrtvUdpSharedStreamTestCase::NrtvUdpSharedStreamTestCase(std::string name,
+                                                         uint32_t rngRun,
+                                                         Time duration)
+    : TestCase(name),
+      m_numOfTxPackets(0),
+      m_rngRun(rngRun),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << rngRun);
+}
+
+void
+NrtvUdpSharedStreamTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices1 = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    NetDeviceContainer devices2 = pointToPoint.Install(nodes.Get(0), nodes.Get(2));
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices1);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    address.Assign(devices2);
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.SetServerAttribute("SharedStream", BooleanValue(true));
+    NodeContainer clientNodes(nodes.Get(1), nodes.Get(2));
+    helper.InstallUsingIpv4(nodes.Get(0), clientNodes);
+    Ptr<Application> server = helper.GetServer().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    server->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&NrtvUdpSharedStreamTestCase::TxCallback, this));
+    NS_TEST_ASSERT_MSG_EQ(helper.GetClients().GetN(), 2, "Unexpected number of clients");
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        std::ostringstream context;
+        context << i;
+        helper.GetClients().Get(i)->TraceConnect(
+            "Rx",
+            context.str(),
+            MakeCallback(&NrtvUdpSharedStreamTestCase::RxCallback, this));
+    }
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_rxSizes[0].size(), 0, "No video slice has been received");
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes[1].size(),
+                          m_rxSizes[0].size(),
+                          "Clients received different number of slices");
+    NS_TEST_ASSERT_MSG_EQ((m_rxSizes[0] == m_rxSizes[1]),
+                          true,
+                          "Clients received different slices");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfTxPackets % 2, 0, "Every slice must be sent to both clients");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_numOfTxPackets,
+                                m_rxSizes[0].size() + m_rxSizes[1].size(),
+                                "Received more packets than sent");
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+
+} // end of `void DoRun ()`
+
+void
+NrtvUdpSharedStreamTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_numOfTxPackets++;
+}
+
+void
+NrtvUdpSharedStreamTestCase::RxCallback(std::string context,
+                                        Ptr<const Packet> packet,
+                                        const Address& from)
+{
+    NS_LOG_FUNCTION(this << context << packet << packet->GetSize());
+    const uint32_t i = (context == "0") ? 0 : 1;
+    m_rxSizes[i].push_back(packet->GetSize());
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the instrumentation counters in the `SharedStream` mode of
+ *        NrtvUdpServer.
+ *
+ * The shared stream is served by a video worker without a socket of its own.
+ * Runs a simulation of an NRTV UDP server in this mode with two clients. If
+ * the module is built with its instrumentation counters, the test case
+ * verifies that the counters of the worker are registered under the server
+ * node and have counted the slices sent. Otherwise, it verifies that nothing
+ * is registered at all.
+ */
+class NrtvSharedStreamCountersTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param duration length of simulation
+     */
+    NrtvSharedStreamCountersTestCase(Time duration);
+
+  private:
+    virtual void DoRun();
+
+    Time m_duration;
+
+}; // end of `class NrtvSharedStreamCountersTestCase`
+
+NrtvSharedStreamCountersTestCase::NrtvSharedStreamCountersTestCase(Time duration)
+    : TestCase("shared stream, counters"),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << duration.GetSeconds());
+}
+
+void
+NrtvSharedStreamCountersTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    TrafficCounterRegistry::Clear();
+
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices1 = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    NetDeviceContainer devices2 = pointToPoint.Install(nodes.Get(0), nodes.Get(2));
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices1);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    address.Assign(devices2);
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.SetServerAttribute("SharedStream", BooleanValue(true));
+    helper.InstallUsingIpv4(nodes.Get(0), NodeContainer(nodes.Get(1), nodes.Get(2)));
+    helper.GetServer().Get(0)->SetStartTime(MilliSeconds(1));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const std::vector<Ptr<TrafficCounters>>& all = TrafficCounterRegistry::GetAll();
+    if (TrafficCounterRegistry::IsEnabled())
+    {
+        uint32_t numOfWorkers = 0;
+        for (std::vector<Ptr<TrafficCounters>>::const_iterator it = all.begin(); it != all.end();
+             ++it)
+        {
+            if ((*it)->GetOwner() == "ns3::NrtvVideoWorker")
+            {
+                NS_TEST_ASSERT_MSG_EQ((*it)->GetNodeId(),
+                                      nodes.Get(0)->GetId(),
+                                      "Worker counters registered under another node");
+                NS_TEST_ASSERT_MSG_GT((*it)->Get(TrafficCounters::PACKETS_CREATED),
+                                      0,
+                                      "The worker has not counted any slice");
+                numOfWorkers++;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(numOfWorkers, 1, "Expected a single shared worker");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(all.empty(), true, "Counters registered in a build without them");
+    }
+
+    TrafficCounterRegistry::Clear();
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applications
+ * \brief Verifies the loss and frame tracking of NrtvUdpClient.
+ *
+ * Runs a simulation of an NRTV UDP server streaming to an NrtvUdpClient over a
+ * point-to-point link which drops the given fraction of the packets at the
+ * client. The test case verifies that the counters of the client agree with
+ * its trace sources and with the number of packets sent, and that losses are
+ * detected if and only if packets are dropped.
+ */
+class NrtvUdpClientTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param packetErrorRate fraction of packets dropped by the link
+     * \param duration length of simulation
+     */
+    NrtvUdpClientTestCase(std::string name, double packetErrorRate, Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+    void RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+    void SliceLossCallback(uint32_t frameNumber, uint32_t numOfLostSlices);
+
+    uint64_t m_numOfTxPackets;  ///< Number of packets sent by the server.
+    uint64_t m_numOfRxFrames;   ///< Number of `RxFrame` traces.
+    uint64_t m_numOfLostSlices; ///< Sum of the `SliceLoss` traces.
+    double m_packetErrorRate;
+    Time m_duration;
+
+}; // end of `class NrtvUdpClientTestCase`
+
+NrtvUdpClientTestCase::NrtvUdpClientTestCase(std::string name,
+                                             double packetErrorRate,
+                                             Time duration)
+    : TestCase(name),
+      m_numOfTxPackets(0),
+      m_numOfRxFrames(0),
+      m_numOfLostSlices(0),
+      m_packetErrorRate(packetErrorRate),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << packetErrorRate << duration.GetSeconds());
+}
+
+void
+NrtvUdpClientTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+    errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errorModel->SetRate(m_packetErrorRate);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    NrtvHelper helper(UdpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<NrtvUdpClient> client = DynamicCast<NrtvUdpClient>(helper.GetClients().Get(0));
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "The UDP client is not an NrtvUdpClient");
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    server->TraceConnectWithoutContext("Tx",
+                                       MakeCallback(&NrtvUdpClientTestCase::TxCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxFrame",
+        MakeCallback(&NrtvUdpClientTestCase::RxFrameCallback, this));
+    client->TraceConnectWithoutContext(
+        "SliceLoss",
+        MakeCallback(&NrtvUdpClientTestCase::SliceLossCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+
+    const uint64_t numOfReceivedSlices = client->GetNumOfReceivedSlices();
+    const uint64_t numOfLostSlices = client->GetNumOfLostSlices();
+    NS_TEST_ASSERT_MSG_GT(numOfReceivedSlices, 0, "No video slice has been received");
+    NS_TEST_ASSERT_MSG_GT(client->GetNumOfCompleteFrames(), 0, "No frame has been completed");
+    NS_TEST_ASSERT_MSG_EQ(client->GetNumOfCompleteFrames(),
+                          m_numOfRxFrames,
+                          "Inconsistent number of complete frames");
+    NS_TEST_ASSERT_MSG_EQ(numOfLostSlices, m_numOfLostSlices, "Inconsistent number of losses");
+    NS_TEST_ASSERT_MSG_EQ(client->GetNumOfDuplicateSlices(), 0, "Unexpected duplicates");
+    NS_TEST_ASSERT_MSG_EQ(client->GetNumOfReorderedSlices(), 0, "Unexpected reordering");
+    NS_TEST_ASSERT_MSG_EQ(client->GetNumOfLateSlices(), 0, "Unexpected late slices");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(numOfReceivedSlices + numOfLostSlices,
+                                m_numOfTxPackets,
+                                "Received and lost more slices than sent");
+
+    if (m_packetErrorRate > 0.0)
+    {
+        NS_TEST_ASSERT_MSG_GT(numOfLostSlices, 0, "Dropped packets have not been detected");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(numOfLostSlices, 0, "Detected losses on a lossless link");
+        NS_TEST_ASSERT_MSG_EQ(client->GetNumOfLostFrames(), 0, "Detected lost frames");
+    }
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+NrtvUdpClientTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    m_numOfTxPackets++;
+}
+
+void
+NrtvUdpClientTestCase::RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+    m_numOfRxFrames++;
+}
+
+void
+NrtvUdpClientTestCase::SliceLossCallback(uint32_t frameNumber, uint32_t numOfLostSlices)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfLostSlices);
+    NS_TEST_ASSERT_MSG_GT(numOfLostSlices, 0, "Reported a loss of no slices");
+    m_numOfLostSlices += numOfLostSlices;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the `VariateBlockSize` mode of NrtvVariables.
+ *
+ * Draws values from two NrtvVariables instances which use the same stream
+ * number and block size, and verifies that both produce the same sequence,
+ * that the values respect the truncation of the distributions, and that the
+ * mean slice size matches the expected mean of the truncated distribution.
+ */
+class NrtvVariateTableTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param blockSize number of variates drawn at a time
+     * \param numOfDraws number of values to draw from each random variable
+     */
+    NrtvVariateTableTestCase(uint32_t blockSize, uint32_t numOfDraws);
+
+  private:
+    virtual void DoRun();
+
+    uint32_t m_blockSize;
+    uint32_t m_numOfDraws;
+
+}; // end of `class NrtvVariateTableTestCase`
+
+NrtvVariateTableTestCase::NrtvVariateTableTestCase(uint32_t blockSize, uint32_t numOfDraws)
+    : TestCase("variate table, block size=" + std::to_string(blockSize)),
+      m_blockSize(blockSize),
+      m_numOfDraws(numOfDraws)
+{
+    NS_LOG_FUNCTION(this << blockSize << numOfDraws);
+}
+
+void
+NrtvVariateTableTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Ptr<NrtvVariables> first = CreateObject<NrtvVariables>();
+    Ptr<NrtvVariables> second = CreateObject<NrtvVariables>();
+    first->SetStream(7);
+    first->SetVariateBlockSize(m_blockSize);
+    second->SetVariateBlockSize(m_blockSize); // the order must not matter
+    second->SetStream(7);
+
+    double sum = 0.0;
+    for (uint32_t i = 0; i < m_numOfDraws; i++)
+    {
+        const uint32_t sliceSize = first->GetSliceSize();
+        NS_TEST_ASSERT_MSG_EQ(second->GetSliceSize(), sliceSize, "Different slice sizes");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(sliceSize, 40, "Slice size below the scale");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(sliceSize, 250, "Slice size above the bound");
+        sum += sliceSize;
+
+        const Time delay = first->GetSliceEncodingDelay();
+        NS_TEST_ASSERT_MSG_EQ(second->GetSliceEncodingDelay(), delay, "Different delays");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(delay, MilliSeconds(15), "Delay above the bound");
+
+        const uint32_t numOfFrames = first->GetNumOfFrames();
+        NS_TEST_ASSERT_MSG_EQ(second->GetNumOfFrames(), numOfFrames, "Different video lengths");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(numOfFrames, 200, "Video length below the minimum");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(numOfFrames, 36000, "Video length above the maximum");
+
+        NS_TEST_ASSERT_MSG_EQ(second->GetIdleTime(), first->GetIdleTime(), "Different idle times");
+    }
+
+    // Truncated Pareto with scale 40, shape 1.2, and bound 250, rounded down.
+    NS_TEST_ASSERT_MSG_EQ_TOL(sum / m_numOfDraws, 82.14, 1.5, "Unexpected mean slice size");
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applications
+ * \brief Verifies NrtvVariablesView.
+ *
+ * Without `ViewSubstreams`, a view must produce the same sequence as the
+ * parent NrtvVariables itself. With `ViewSubstreams`, the values of a view
+ * must respect the truncation of the distributions, and depend only on the
+ * assigned stream and the index of the view, not on the draws of other views.
+ */
+class NrtvVariablesViewTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param numOfDraws number of values to draw from each random variable
+     */
+    NrtvVariablesViewTestCase(uint32_t numOfDraws);
+
+  private:
+    virtual void DoRun();
+
+    uint32_t m_numOfDraws;
+
+}; // end of `class NrtvVariablesViewTestCase`
+
+NrtvVariablesViewTestCase::NrtvVariablesViewTestCase(uint32_t numOfDraws)
+    : TestCase("variables view"),
+      m_numOfDraws(numOfDraws)
+{
+    NS_LOG_FUNCTION(this << numOfDraws);
+}
+
+void
+NrtvVariablesViewTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    // Forwarding to the parent.
+    Ptr<NrtvVariables> parent = CreateObject<NrtvVariables>();
+    Ptr<NrtvVariables> reference = CreateObject<NrtvVariables>();
+    parent->SetStream(7);
+    reference->SetStream(7);
+    Ptr<NrtvVariablesView> view = parent->CreateView();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(view->GetSliceSize(),
+                              reference->GetSliceSize(),
+                              "Different slice sizes");
+        NS_TEST_ASSERT_MSG_EQ(view->GetIdleTime(),
+                              reference->GetIdleTime(),
+                              "Different idle times");
+    }
+
+    // Private substreams.
+    Ptr<NrtvVariables> shared = CreateObject<NrtvVariables>();
+    shared->SetViewSubstreams(true);
+    NS_TEST_ASSERT_MSG_EQ(shared->AssignStreams(100), 2, "Invalid number of streams");
+    Ptr<NrtvVariablesView> first = shared->CreateView();
+    Ptr<NrtvVariablesView> second = shared->CreateView();
+    NS_TEST_ASSERT_MSG_EQ(first->GetIndex(), 0, "Invalid index of the first view");
+    NS_TEST_ASSERT_MSG_EQ(second->GetIndex(), 1, "Invalid index of the second view");
+
+    double sum = 0.0;
+    for (uint32_t i = 0; i < m_numOfDraws; i++)
+    {
+        const uint32_t sliceSize = first->GetSliceSize();
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(sliceSize, 40, "Slice size below the scale");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(sliceSize, 250, "Slice size above the bound");
+        sum += sliceSize;
+
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(first->GetSliceEncodingDelay(),
+                                    MilliSeconds(15),
+                                    "Delay above the bound");
+
+        const uint32_t numOfFrames = first->GetNumOfFrames();
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(numOfFrames, 200, "Video length below the minimum");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(numOfFrames, 36000, "Video length above the maximum");
+    }
+
+    // Truncated Pareto with scale 40, shape 1.2, and bound 250, rounded down.
+    NS_TEST_ASSERT_MSG_EQ_TOL(sum / m_numOfDraws, 82.14, 1.5, "Unexpected mean slice size");
+
+    // The second view of another collection with the same stream must not see
+    // the draws made through the first view above.
+    Ptr<NrtvVariables> other = CreateObject<NrtvVariables>();
+    other->SetViewSubstreams(true);
+    other->AssignStreams(100);
+    other->CreateView();
+    Ptr<NrtvVariablesView> otherSecond = other->CreateView();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(otherSecond->GetSliceSize(),
+                              second->GetSliceSize(),
+                              "Different slice sizes of the second views");
+        NS_TEST_ASSERT_MSG_EQ(otherSecond->GetIdleTime(),
+                              second->GetIdleTime(),
+                              "Different idle times of the second views");
+    }
+
+} // end of `void DoRun ()`
+
+/**
+ * \ingroup applications
+ * \brief Verifies the record and replay modes of NrtvVariables.
+ *
+ * Two NrtvVariables instances record the values drawn by themselves and by a
+ * view with its own substream into a shared schedule log. Two new instances,
+ * with different streams, then replay the log in a different order of draws.
+ * The test case verifies that every replayed value equals the recorded one.
+ */
+class NrtvScheduleLogTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param numOfDraws number of values to draw from each random variable
+     */
+    NrtvScheduleLogTestCase(uint32_t numOfDraws);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \param mode the schedule log mode.
+     * \param fileName name of the schedule log file.
+     * \param stream the stream assigned to the instance.
+     * \return a new instance using the schedule log
+     */
+    Ptr<NrtvVariables> CreateVariables(TrafficScheduleLog::Mode_t mode,
+                                       std::string fileName,
+                                       int64_t stream);
+
+    uint32_t m_numOfDraws;
+
+}; // end of `class NrtvScheduleLogTestCase`
+
+NrtvScheduleLogTestCase::NrtvScheduleLogTestCase(uint32_t numOfDraws)
+    : TestCase("schedule log"),
+      m_numOfDraws(numOfDraws)
+{
+    NS_LOG_FUNCTION(this << numOfDraws);
+}
+
+void
+NrtvScheduleLogTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string fileName = CreateTempDirFilename("nrtv-schedule-log.bin");
+    std::vector<uint32_t> sliceSizes[2];
+    std::vector<Time> idleTimes[2];
+    std::vector<uint32_t> viewNumOfFrames;
+
+    {
+        Ptr<NrtvVariables> first = CreateVariables(TrafficScheduleLog::RECORD, fileName, 10);
+        Ptr<NrtvVariables> second = CreateVariables(TrafficScheduleLog::RECORD, fileName, 20);
+        Ptr<NrtvVariablesView> view = second->CreateView();
+        for (uint32_t i = 0; i < m_numOfDraws; i++)
+        {
+            sliceSizes[0].push_back(first->GetSliceSize());
+            sliceSizes[1].push_back(second->GetSliceSize());
+            idleTimes[0].push_back(first->GetIdleTime());
+            idleTimes[1].push_back(second->GetIdleTime());
+            viewNumOfFrames.push_back(view->GetNumOfFrames());
+        }
+    } // the log is written once its last user is gone
+
+    Ptr<NrtvVariables> first = CreateVariables(TrafficScheduleLog::REPLAY, fileName, 30);
+    Ptr<NrtvVariables> second = CreateVariables(TrafficScheduleLog::REPLAY, fileName, 40);
+    Ptr<NrtvVariablesView> view = second->CreateView();
+    for (uint32_t i = 0; i < m_numOfDraws; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(view->GetNumOfFrames(),
+                              viewNumOfFrames[i],
+                              "Different number of frames of the view");
+        NS_TEST_ASSERT_MSG_EQ(second->GetIdleTime(),
+                              idleTimes[1][i],
+                              "Different idle time of the second instance");
+        NS_TEST_ASSERT_MSG_EQ(second->GetSliceSize(),
+                              sliceSizes[1][i],
+                              "Different slice size of the second instance");
+    }
+    for (uint32_t i = 0; i < m_numOfDraws; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(first->GetSliceSize(),
+                              sliceSizes[0][i],
+                              "Different slice size of the first instance");
+        NS_TEST_ASSERT_MSG_EQ(first->GetIdleTime(),
+                              idleTimes[0][i],
+                              "Different idle time of the first instance");
+    }
+
+} // end of `void DoRun ()`
+
+Ptr<NrtvVariables>
+NrtvScheduleLogTestCase::CreateVariables(TrafficScheduleLog::Mode_t mode,
+                                         std::string fileName,
+                                         int64_t stream)
+{
+    Ptr<NrtvVariables> variables = CreateObject<NrtvVariables>();
+    variables->SetViewSubstreams(true);
+    variables->AssignStreams(stream);
+    variables->SetAttribute("ScheduleLogMode", EnumValue(mode));
+    variables->SetAttribute("ScheduleLogFile", StringValue(fileName));
+    return variables;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies that NrtvTcpServer continues its videos from a checkpoint.
+ *
+ * Runs a simulation of an NRTV TCP client connected to an NRTV server through
+ * a simple point-to-point interface, saving a checkpoint of the server in the
+ * middle of the video. The same simulation is then run again while restoring
+ * the checkpoint. The test case verifies that the restored video has the same
+ * length and begins from the frame following the last one received before the
+ * checkpoint, and that the client plays the video from that frame on.
+ */
+class NrtvCheckpointTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param checkpointTime the time when the checkpoint is saved
+     */
+    NrtvCheckpointTestCase(Time checkpointTime);
+
+  private:
+    virtual void DoRun();
+
+    /**
+     * \brief Run a single simulation.
+     * \param mode the checkpoint mode of the server
+     * \param fileName name of the checkpoint file
+     */
+    void RunSimulation(TrafficScheduleLog::Mode_t mode, std::string fileName);
+
+    // CALLBACK FUNCTIONS
+    void RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+    void PlayoutFrameCallback(uint32_t frameNumber, uint32_t numOfFrames);
+
+    uint32_t m_firstRxFrame;     ///< Number of the first frame received.
+    uint32_t m_lastRxFrame;      ///< Last frame received before the checkpoint.
+    uint32_t m_firstPlayedFrame; ///< Number of the first frame played.
+    uint32_t m_numOfFrames;      ///< Length of the video in frames.
+    Time m_checkpointTime;
+
+}; // end of `class NrtvCheckpointTestCase`
+
+NrtvCheckpointTestCase::NrtvCheckpointTestCase(Time checkpointTime)
+    : TestCase("checkpoint"),
+      m_firstRxFrame(0),
+      m_lastRxFrame(0),
+      m_firstPlayedFrame(0),
+      m_numOfFrames(0),
+      m_checkpointTime(checkpointTime)
+{
+    NS_LOG_FUNCTION(this << checkpointTime.GetSeconds());
+}
+
+void
+NrtvCheckpointTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    const std::string fileName = CreateTempDirFilename("nrtv-checkpoint.bin");
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVariables::DejitterBufferWindowSize", TimeValue(Seconds(1)));
+
+    RunSimulation(TrafficScheduleLog::RECORD, fileName);
+    const uint32_t savedLastRxFrame = m_lastRxFrame;
+    const uint32_t savedNumOfFrames = m_numOfFrames;
+    NS_TEST_ASSERT_MSG_GT(savedLastRxFrame, 0, "No frame received before the checkpoint");
+    NS_TEST_ASSERT_MSG_GT(savedNumOfFrames,
+                          savedLastRxFrame + 1,
+                          "The video has ended before the checkpoint");
+
+    RunSimulation(TrafficScheduleLog::REPLAY, fileName);
+    NS_TEST_ASSERT_MSG_EQ(m_numOfFrames, savedNumOfFrames, "The restored video has another length");
+    NS_TEST_ASSERT_MSG_GT(m_firstRxFrame,
+                          savedLastRxFrame,
+                          "The restored video does not continue the saved one");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_firstRxFrame,
+                                savedLastRxFrame + 2,
+                                "The restored video skips too many frames");
+    NS_TEST_ASSERT_MSG_EQ(m_firstPlayedFrame,
+                          m_firstRxFrame,
+                          "The restored video is not played from its first frame");
+
+    // return default values to their default
+    Config::SetDefault("ns3::NrtvVariables::DejitterBufferWindowSize", TimeValue(Seconds(5)));
+
+} // end of `void DoRun ()`
+
+void
+NrtvCheckpointTestCase::RunSimulation(TrafficScheduleLog::Mode_t mode, std::string fileName)
+{
+    NS_LOG_FUNCTION(this << mode << fileName);
+
+    m_firstRxFrame = 0;
+    m_lastRxFrame = 0;
+    m_firstPlayedFrame = 0;
+    m_numOfFrames = 0;
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetAttribute("CheckpointMode", EnumValue(mode));
+    server->SetAttribute("CheckpointFile", StringValue(fileName));
+    server->SetAttribute("CheckpointTime", TimeValue(m_checkpointTime));
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    client->TraceConnectWithoutContext(
+        "RxFrame",
+        MakeCallback(&NrtvCheckpointTestCase::RxFrameCallback, this));
+    client->TraceConnectWithoutContext(
+        "PlayoutFrame",
+        MakeCallback(&NrtvCheckpointTestCase::PlayoutFrameCallback, this));
+
+    Simulator::Stop(m_checkpointTime + Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy(); // also writes the checkpoint
+
+} // end of `void RunSimulation (TrafficScheduleLog::Mode_t, std::string)`
+
+void
+NrtvCheckpointTestCase::RxFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+
+    if (m_firstRxFrame == 0)
+    {
+        m_firstRxFrame = frameNumber;
+        m_numOfFrames = numOfFrames;
+    }
+    if (Simulator::Now() <= m_checkpointTime)
+    {
+        m_lastRxFrame = frameNumber;
+    }
+}
+
+void
+NrtvCheckpointTestCase::PlayoutFrameCallback(uint32_t frameNumber, uint32_t numOfFrames)
+{
+    NS_LOG_FUNCTION(this << frameNumber << numOfFrames);
+
+    if (m_firstPlayedFrame == 0)
+    {
+        m_firstPlayedFrame = frameNumber;
+    }
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies that NrtvVideoWorker lowers the quality level when the
+ *        feedback of NrtvTcpClient shows that the client falls behind.
+ *
+ * Runs a simulation of an NRTV TCP client connected to an NRTV server through
+ * a point-to-point interface whose data rate is below the bitrate of the video
+ * at full quality, but above the bitrate at the lowest quality level. The test
+ * case verifies that the feedback of the client reaches the server, that every
+ * switch happens upon a received feedback, that the quality goes down at least
+ * once, that the reported
+ * switches form a consistent sequence of levels, and that the video does not
+ * end up at the highest quality level.
+ */
+class NrtvAdaptiveBitrateTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param dataRate data rate of the point-to-point channel
+     * \param duration length of simulation
+     */
+    NrtvAdaptiveBitrateTestCase(DataRate dataRate, Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxFeedbackCallback(Ptr<const Packet> packet);
+    void QualitySwitchCallback(uint32_t oldLevel, uint32_t newLevel);
+
+    uint32_t m_numOfFeedbacks; ///< Number of feedback reports received by the server.
+    Time m_lastFeedbackTime;   ///< Time when the server received the last feedback.
+    uint32_t m_level;          ///< Current quality level according to the trace.
+    uint32_t m_numOfSwitches;  ///< Number of quality switches.
+    uint32_t m_numOfDowns;     ///< Number of switches to a lower quality level.
+    DataRate m_dataRate;
+    Time m_duration;
+
+}; // end of `class NrtvAdaptiveBitrateTestCase`
+
+NrtvAdaptiveBitrateTestCase::NrtvAdaptiveBitrateTestCase(DataRate dataRate, Time duration)
+    : TestCase("adaptive bitrate, " + dataRate.GetBitRateString()),
+      m_numOfFeedbacks(0),
+      m_lastFeedbackTime(Seconds(-1)),
+      m_level(2),
+      m_numOfSwitches(0),
+      m_numOfDowns(0),
+      m_dataRate(dataRate),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << dataRate << duration.GetSeconds());
+}
+
+void
+NrtvAdaptiveBitrateTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVideoWorker::AbrQualityLevels", StringValue("0.25,0.5,1"));
+    Config::SetDefault("ns3::NrtvTcpClient::AbrFeedbackInterval", TimeValue(Seconds(1)));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(m_dataRate));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(TcpSocketFactory::GetTypeId());
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    server->TraceConnectWithoutContext(
+        "RxFeedback",
+        MakeCallback(&NrtvAdaptiveBitrateTestCase::RxFeedbackCallback, this));
+    server->TraceConnectWithoutContext(
+        "QualitySwitch",
+        MakeCallback(&NrtvAdaptiveBitrateTestCase::QualitySwitchCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // one feedback per second, except the first second and the last one in flight
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_numOfFeedbacks,
+                                static_cast<uint32_t>(m_duration.GetSeconds()) - 2,
+                                "The server has not received the feedback of the client");
+    NS_TEST_ASSERT_MSG_GT(m_numOfDowns, 0, "The quality has never gone down");
+    NS_TEST_ASSERT_MSG_LT(m_level, 2, "The video has ended up at the highest quality");
+
+    // return default values to their default
+    Config::SetDefault("ns3::NrtvVideoWorker::AbrQualityLevels", StringValue(""));
+    Config::SetDefault("ns3::NrtvTcpClient::AbrFeedbackInterval", TimeValue(Seconds(0)));
+
+} // end of `void DoRun ()`
+
+void
+NrtvAdaptiveBitrateTestCase::RxFeedbackCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(),
+                          NrtvFeedbackHeader::GetStaticSerializedSize(),
+                          "Received feedback of an unexpected size");
+    m_numOfFeedbacks++;
+    m_lastFeedbackTime = Simulator::Now();
+}
+
+void
+NrtvAdaptiveBitrateTestCase::QualitySwitchCallback(uint32_t oldLevel, uint32_t newLevel)
+{
+    NS_LOG_FUNCTION(this << oldLevel << newLevel);
+    NS_TEST_ASSERT_MSG_EQ(m_lastFeedbackTime,
+                          Simulator::Now(),
+                          "Switched without a feedback from the client");
+    NS_TEST_ASSERT_MSG_EQ(oldLevel, m_level, "Switched from an unexpected level");
+    NS_TEST_ASSERT_MSG_NE(oldLevel, newLevel, "Switched to the same level");
+    NS_TEST_ASSERT_MSG_LT(newLevel, 3, "Switched to a nonexistent level");
+    if (newLevel < oldLevel)
+    {
+        m_numOfDowns++;
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(newLevel, oldLevel + 1, "Switched up more than one level");
+    }
+    m_numOfSwitches++;
+    m_level = newLevel;
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the timestamp encodings of NrtvHeader and TrafficTimeTag.
+ *
+ * A packet carrying both the header and the tag is created shortly before
+ * the 32-bit nanosecond counter wraps around, and read again after a delay
+ * which crosses the wrap-around. The test case verifies the serialized sizes
+ * and that the restored timestamps, and hence the computed delays, are exact
+ * in the resolution of the encoding.
+ */
+class NrtvTimestampEncodingTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param encoding the timestamp encoding to be verified
+     */
+    NrtvTimestampEncodingTestCase(TrafficTimestamp::Encoding_t encoding);
+
+  private:
+    virtual void DoRun();
+    virtual void DoTeardown();
+
+    /// Create #m_packet with the current time as the timestamps.
+    void Send();
+    /// Read the timestamps of #m_packet and verify them.
+    void Receive();
+
+    TrafficTimestamp::Encoding_t m_encoding;
+    Ptr<Packet> m_packet;
+    Time m_sendTime;
+    uint32_t m_numOfReceived;
+
+}; // end of `class NrtvTimestampEncodingTestCase`
+
+NrtvTimestampEncodingTestCase::NrtvTimestampEncodingTestCase(
+    TrafficTimestamp::Encoding_t encoding)
+    : TestCase("timestamp encoding, " + TrafficTimestamp::GetEncodingName(encoding)),
+      m_encoding(encoding),
+      m_numOfReceived(0)
+{
+    NS_LOG_FUNCTION(this << GetName());
+}
+
+void
+NrtvTimestampEncodingTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    TrafficTimestamp::SetEncoding(m_encoding);
+    const uint32_t timestampSize = (m_encoding == TrafficTimestamp::FULL) ? 8 : 4;
+    NS_TEST_ASSERT_MSG_EQ(NrtvHeader().GetSerializedSize(),
+                          16 + timestampSize,
+                          "Unexpected header size");
+    NS_TEST_ASSERT_MSG_EQ(NrtvHeader::GetStaticSerializedSize(),
+                          (m_encoding == TrafficTimestamp::FULL)
+                              ? NrtvHeader::FULL_SERIALIZED_SIZE
+                              : NrtvHeader::COMPACT_SERIALIZED_SIZE,
+                          "Inconsistent static header size");
+    NS_TEST_ASSERT_MSG_EQ(TrafficTimeTag().GetSerializedSize(),
+                          timestampSize,
+                          "Unexpected tag size");
+
+    // 2^32 ns is about 4.295 seconds.
+    const Time wrapTime = NanoSeconds(4294967296LL);
+    Simulator::Schedule(wrapTime - NanoSeconds(1234567),
+                        &NrtvTimestampEncodingTestCase::Send,
+                        this);
+    Simulator::Schedule(wrapTime + NanoSeconds(300000123),
+                        &NrtvTimestampEncodingTestCase::Receive,
+                        this);
+    // Without any wrap-around in between.
+    Simulator::Schedule(Seconds(6) + NanoSeconds(999), &NrtvTimestampEncodingTestCase::Send, this);
+    Simulator::Schedule(Seconds(6.5) + NanoSeconds(1),
+                        &NrtvTimestampEncodingTestCase::Receive,
+                        this);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_numOfReceived, 2, "Unexpected number of received packets");
+
+} // end of `void DoRun ()`
+
+void
+NrtvTimestampEncodingTestCase::DoTeardown()
+{
+    NS_LOG_FUNCTION(this << GetName());
+    TrafficTimestamp::SetEncoding(TrafficTimestamp::FULL);
+}
+
+void
+NrtvTimestampEncodingTestCase::Send()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendTime = Simulator::Now();
+    m_packet = Create<Packet>(100);
+    NrtvHeader nrtvHeader;
+    nrtvHeader.SetSliceSize(100);
+    m_packet->AddHeader(nrtvHeader);
+    m_packet->AddPacketTag(TrafficTimeTag(m_sendTime));
+}
+
+void
+NrtvTimestampEncodingTestCase::Receive()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_packet != nullptr);
+
+    Time expected = m_sendTime;
+    if (m_encoding == TrafficTimestamp::COMPACT_MICROSECONDS)
+    {
+        expected = MicroSeconds(m_sendTime.GetMicroSeconds());
+    }
+
+    NrtvHeader nrtvHeader;
+    NS_TEST_ASSERT_MSG_EQ(m_packet->GetSize(),
+                          100 + nrtvHeader.GetSerializedSize(),
+                          "Unexpected packet size");
+    NS_TEST_ASSERT_MSG_EQ(NrtvHeader::PeekSliceSize(m_packet), 100, "Unexpected peeked slice size");
+    m_packet->RemoveHeader(nrtvHeader);
+    NS_TEST_ASSERT_MSG_EQ(nrtvHeader.GetSliceSize(), 100, "Corrupted header");
+    NS_TEST_ASSERT_MSG_EQ(nrtvHeader.GetArrivalTime(), expected, "Inexact header timestamp");
+
+    TrafficTimeTag timeTag;
+    NS_TEST_ASSERT_MSG_EQ(m_packet->PeekPacketTag(timeTag), true, "Missing time tag");
+    NS_TEST_ASSERT_MSG_EQ(timeTag.GetSenderTimestamp(), expected, "Inexact tag timestamp");
+
+    m_packet = nullptr;
+    m_numOfReceived++;
+}
+
 /**
  * \brief Test suite `nrtv`, verifying the NRTV traffic model.
  */
+/**
+ * \ingroup applications
+ * \brief Verifies that NrtvVideoWorker replays a video trace.
+ *
+ * Writes a short trace file with a distinct size for every slice, and verifies
+ * that NrtvVideoTrace restores it and is shared by every user of the same
+ * file. Then runs a simulation of an NRTV server and client using the trace,
+ * and verifies that every packet reported by the `Tx` trace source of the
+ * server carries a slice of the trace, at the encoding delay of the slice
+ * after the previous slice of the same frame.
+ */
+class NrtvVideoTraceTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param protocolTypeId determines the socket type (TCP or UDP)
+     * \param sliceBatching value of the `SliceBatching` attribute
+     */
+    NrtvVideoTraceTestCase(TypeId protocolTypeId, bool sliceBatching);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void TxCallback(Ptr<const Packet> packet);
+
+    /// Transmission time of each slice content size.
+    std::vector<std::pair<Time, uint32_t>> m_txLog;
+    TypeId m_protocolTypeId;
+    bool m_sliceBatching;
+
+}; // end of `class NrtvVideoTraceTestCase`
+
+NrtvVideoTraceTestCase::NrtvVideoTraceTestCase(TypeId protocolTypeId, bool sliceBatching)
+    : TestCase("video trace, " + protocolTypeId.GetName() +
+               (sliceBatching ? ", slice batching" : "")),
+      m_protocolTypeId(protocolTypeId),
+      m_sliceBatching(sliceBatching)
+{
+    NS_LOG_FUNCTION(this << protocolTypeId.GetName() << sliceBatching);
+}
+
+void
+NrtvVideoTraceTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    // Frame i lasts 40 + 10 i ms and has i + 1 slices of 100 i + 10 j + 50 bytes.
+    const uint32_t numOfFrames = 5;
+    std::vector<Time> frameTimes;
+    std::vector<std::vector<NrtvVideoTrace::Slice_t>> frameSlices(numOfFrames);
+    Time frameTime = MilliSeconds(20);
+    for (uint32_t i = 0; i < numOfFrames; i++)
+    {
+        frameTimes.push_back(frameTime);
+        frameTime += MilliSeconds(40 + 10 * i);
+        for (uint32_t j = 0; j <= i; j++)
+        {
+            NrtvVideoTrace::Slice_t slice;
+            slice.size = 100 * i + 10 * j + 50;
+            slice.encodingDelay = 2000 + 500 * j;
+            frameSlices[i].push_back(slice);
+        }
+    }
+    const std::string fileName = CreateTempDirFilename("nrtv-video-trace.bin");
+    NrtvVideoTrace::Write(fileName, frameTimes, frameSlices, frameTime);
+
+    Ptr<NrtvVideoTrace> trace = NrtvVideoTrace::Open(fileName);
+    NS_TEST_ASSERT_MSG_EQ(NrtvVideoTrace::Open(fileName),
+                          trace,
+                          "The same file must be mapped only once");
+    NS_TEST_ASSERT_MSG_EQ(trace->GetNumOfFrames(), numOfFrames, "Invalid number of frames");
+    for (uint32_t i = 0; i < numOfFrames; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(trace->GetFrameInterval(i),
+                              MilliSeconds(40 + 10 * i),
+                              "Invalid interval of frame " << i);
+        NS_TEST_ASSERT_MSG_EQ(trace->GetNumOfSlices(i), i + 1, "Invalid slices of frame " << i);
+        for (uint16_t j = 0; j <= i; j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(trace->GetSliceSize(i, j),
+                                  100 * i + 10 * j + 50,
+                                  "Invalid size of slice " << j << " of frame " << i);
+            NS_TEST_ASSERT_MSG_EQ(trace->GetSliceEncodingDelay(i, j),
+                                  MicroSeconds(2000 + 500 * j),
+                                  "Invalid delay of slice " << j << " of frame " << i);
+        }
+    }
+
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
+    Config::SetDefault("ns3::NrtvVideoWorker::SliceBatching", BooleanValue(m_sliceBatching));
+    Config::SetDefault("ns3::NrtvVariables::VideoTraceFile", StringValue(fileName));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    NetDeviceContainer devices;
+    devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    NrtvHelper helper(m_protocolTypeId);
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    Ptr<Application> server = helper.GetServer().Get(0);
+    Ptr<Application> client = helper.GetClients().Get(0);
+    server->SetStartTime(MilliSeconds(1));
+    client->SetStartTime(MilliSeconds(2));
+    server->TraceConnectWithoutContext("Tx",
+                                       MakeCallback(&NrtvVideoTraceTestCase::TxCallback, this));
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // return default values to their default
+    Config::SetDefault("ns3::NrtvVideoWorker::SliceBatching", BooleanValue(false));
+    Config::SetDefault("ns3::NrtvVariables::VideoTraceFile", StringValue(""));
+
+    NS_TEST_ASSERT_MSG_GT(m_txLog.size(), numOfFrames, "Too few video slices transmitted");
+    for (uint32_t n = 0; n < m_txLog.size(); n++)
+    {
+        const uint32_t size = m_txLog[n].second;
+        const uint32_t i = size / 100;
+        const uint32_t j = (size % 100 - 50) / 10;
+        NS_TEST_ASSERT_MSG_EQ(size % 10, 0, "Slice size " << size << " is not in the trace");
+        NS_TEST_ASSERT_MSG_LT(i, numOfFrames, "Slice size " << size << " is not in the trace");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(j, i, "Slice size " << size << " is not in the trace");
+        if (j > 0 && n > 0)
+        {
+            NS_TEST_ASSERT_MSG_EQ(m_txLog[n - 1].second,
+                                  size - 10,
+                                  "Slice " << j << " of frame " << i << " is out of order");
+            NS_TEST_ASSERT_MSG_EQ(m_txLog[n].first - m_txLog[n - 1].first,
+                                  MicroSeconds(2000 + 500 * j),
+                                  "Slice " << j << " of frame " << i << " is not on time");
+        }
+    }
+
+} // end of `void DoRun ()`
+
+void
+NrtvVideoTraceTestCase::TxCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    const uint32_t contentSize = packet->GetSize() - NrtvHeader::GetStaticSerializedSize();
+    m_txLog.push_back(std::make_pair(Simulator::Now(), contentSize));
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the sharded install mode of NrtvHelper.
+ *
+ * Runs a simulation of two NRTV servers and four clients, all of them
+ * connected to a common router node, where the clients are split between the
+ * servers by the given shard policy. The test case verifies that the clients
+ * are assigned as the policy dictates, that each TCP client is connected to
+ * the address of its own server, and that every client receives video.
+ */
+class NrtvShardedInstallTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param protocolTypeId determines the socket type (TCP or UDP)
+     * \param policy the shard policy of the helper
+     * \param duration length of simulation
+     */
+    NrtvShardedInstallTestCase(TypeId protocolTypeId,
+                               ServerShardHelper::ShardPolicy_t policy,
+                               Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void RxCallback(std::string context, Ptr<const Packet> packet, const Address& from);
+
+    /// Number of bytes received by each client.
+    std::map<std::string, uint64_t> m_rxBytes;
+    TypeId m_protocolTypeId;
+    ServerShardHelper::ShardPolicy_t m_policy;
+    Time m_duration;
+
+}; // end of `class NrtvShardedInstallTestCase`
+
+NrtvShardedInstallTestCase::NrtvShardedInstallTestCase(TypeId protocolTypeId,
+                                                       ServerShardHelper::ShardPolicy_t policy,
+                                                       Time duration)
+    : TestCase("sharded install, " + protocolTypeId.GetName() + ", " +
+               ServerShardHelper::GetShardPolicyName(policy)),
+      m_protocolTypeId(protocolTypeId),
+      m_policy(policy),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << GetName());
+}
+
+void
+NrtvShardedInstallTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Ptr<Node> router = CreateObject<Node>();
+    NodeContainer serverNodes;
+    serverNodes.Create(2);
+    NodeContainer clientNodes;
+    clientNodes.Create(4);
+    NodeContainer leafNodes(serverNodes, clientNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(MilliSeconds(3)));
+
+    InternetStackHelper stack;
+    stack.Install(router);
+    stack.Install(leafNodes);
+
+    Ipv4AddressHelper address;
+    for (uint32_t i = 0; i < leafNodes.GetN(); i++)
+    {
+        std::ostringstream oss;
+        oss << "10.1." << i + 1 << ".0";
+        address.SetBase(oss.str().c_str(), "255.255.255.0");
+        address.Assign(pointToPoint.Install(leafNodes.Get(i), router));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    NrtvHelper helper(m_protocolTypeId);
+    helper.SetShardPolicy(m_policy);
+    helper.InstallUsingIpv4(serverNodes, clientNodes);
+
+    NS_TEST_ASSERT_MSG_EQ(helper.GetNumOfShards(), 2, "Unexpected number of shards");
+    NS_TEST_ASSERT_MSG_EQ(helper.GetServer().GetN(), 2, "Unexpected number of servers");
+    NS_TEST_ASSERT_MSG_EQ(helper.GetClients().GetN(), 4, "Unexpected number of clients");
+    NS_TEST_ASSERT_MSG_EQ(helper.GetShardInformation().size(), 2, "Unexpected shard groups");
+
+    // The same policy applied to the same nodes must give the same shards.
+    ServerShardHelper shardHelper(m_policy);
+    const std::vector<NodeContainer> expected = shardHelper.Assign(serverNodes, clientNodes);
+    uint32_t numOfClients = 0;
+
+    for (uint32_t i = 0; i < helper.GetNumOfShards(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(helper.GetShardServer(i).GetN(), 1, "Missing server " << i);
+        NS_TEST_ASSERT_MSG_EQ(helper.GetShardServer(i).Get(0)->GetNode(),
+                              serverNodes.Get(i),
+                              "Server " << i << " is installed on a wrong node");
+        helper.GetShardServer(i).Get(0)->SetStartTime(MilliSeconds(1));
+
+        ApplicationContainer clients = helper.GetShardClients(i);
+        NS_TEST_ASSERT_MSG_EQ(clients.GetN(),
+                              expected[i].GetN(),
+                              "Unexpected number of clients of server " << i);
+        if (m_policy == ServerShardHelper::SHARD_ROUND_ROBIN)
+        {
+            NS_TEST_ASSERT_MSG_EQ(clients.GetN(), 2, "Round-robin must balance the servers");
+        }
+
+        const Ipv4Address serverAddress =
+            serverNodes.Get(i)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+        for (uint32_t j = 0; j < clients.GetN(); j++)
+        {
+            Ptr<Application> client = clients.Get(j);
+            NS_TEST_ASSERT_MSG_EQ(client->GetNode(),
+                                  expected[i].Get(j),
+                                  "Client " << j << " of server " << i << " is on a wrong node");
+            if (m_protocolTypeId == TcpSocketFactory::GetTypeId())
+            {
+                AddressValue remote;
+                client->GetAttribute("RemoteServerAddress", remote);
+                NS_TEST_ASSERT_MSG_EQ(Ipv4Address::ConvertFrom(remote.Get()),
+                                      serverAddress,
+                                      "Client " << j << " is not connected to server " << i);
+            }
+
+            std::ostringstream context;
+            context << client->GetNode()->GetId();
+            m_rxBytes[context.str()] = 0;
+            client->SetStartTime(MilliSeconds(2));
+            client->TraceConnect("Rx",
+                                 context.str(),
+                                 MakeCallback(&NrtvShardedInstallTestCase::RxCallback, this));
+            numOfClients++;
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(numOfClients, 4, "Some clients do not belong to any shard");
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    for (auto it = m_rxBytes.begin(); it != m_rxBytes.end(); ++it)
+    {
+        NS_TEST_ASSERT_MSG_GT(it->second, 0, "Client node " << it->first << " received nothing");
+    }
+
+} // end of `void DoRun ()`
+
+void
+NrtvShardedInstallTestCase::RxCallback(std::string context,
+                                       Ptr<const Packet> packet,
+                                       const Address& from)
+{
+    NS_LOG_FUNCTION(this << context << packet << packet->GetSize());
+    m_rxBytes[context] += packet->GetSize();
+}
+
+/**
+ * \ingroup applications
+ * \brief Verifies the shard policies of ServerShardHelper without simulation.
+ *
+ * The test case verifies that the hash policy does not depend on the order of
+ * the clients, and that the least-loaded policy fills the servers which have
+ * fewer clients, including those added through AddLoad().
+ */
+class ServerShardHelperTestCase : public TestCase
+{
+  public:
+    ServerShardHelperTestCase();
+
+  private:
+    virtual void DoRun();
+
+}; // end of `class ServerShardHelperTestCase`
+
+ServerShardHelperTestCase::ServerShardHelperTestCase()
+    : TestCase("server shard policies")
+{
+}
+
+void
+ServerShardHelperTestCase::DoRun()
+{
+    NodeContainer serverNodes;
+    serverNodes.Create(3);
+    NodeContainer clientNodes;
+    clientNodes.Create(30);
+    NodeContainer reversedNodes;
+    for (uint32_t i = clientNodes.GetN(); i > 0; i--)
+    {
+        reversedNodes.Add(clientNodes.Get(i - 1));
+    }
+
+    // Hash: every client goes to the same server regardless of the order.
+    ServerShardHelper hash(ServerShardHelper::SHARD_HASH);
+    const std::vector<NodeContainer> forward = hash.Assign(serverNodes, clientNodes);
+    const std::vector<NodeContainer> backward = hash.Assign(serverNodes, reversedNodes);
+    NS_TEST_ASSERT_MSG_EQ(forward.size(), 3, "Unexpected number of shards");
+    for (uint32_t i = 0; i < forward.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(forward[i].GetN(),
+                              backward[i].GetN(),
+                              "Hash depends on the order of the clients");
+        NS_TEST_ASSERT_MSG_GT(forward[i].GetN(), 0, "Hash leaves server " << i << " unused");
+        for (uint32_t j = 0; j < forward[i].GetN(); j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(forward[i].Get(j),
+                                  backward[i].Get(forward[i].GetN() - j - 1),
+                                  "Hash depends on the order of the clients");
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(hash.GetLoad(serverNodes.Get(0)),
+                          2 * forward[0].GetN(),
+                          "Load is not accumulated");
+
+    // Least loaded: the existing load of the first server is compensated first.
+    NodeContainer firstNodes;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        firstNodes.Add(clientNodes.Get(i));
+    }
+    ServerShardHelper leastLoaded(ServerShardHelper::SHARD_LEAST_LOADED);
+    leastLoaded.AddLoad(serverNodes.Get(0), 10);
+    std::vector<NodeContainer> shards = leastLoaded.Assign(serverNodes, firstNodes);
+    NS_TEST_ASSERT_MSG_EQ(shards[0].GetN(), 0, "Loaded server receives clients");
+    NS_TEST_ASSERT_MSG_EQ(shards[1].GetN(), 5, "Unbalanced assignment");
+    NS_TEST_ASSERT_MSG_EQ(shards[2].GetN(), 5, "Unbalanced assignment");
+    leastLoaded.Assign(serverNodes, clientNodes);
+    for (uint32_t i = 0; i < serverNodes.GetN(); i++)
+    {
+        // 10 + 10 + 30 clients in total.
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(leastLoaded.GetLoad(serverNodes.Get(i)),
+                                    16,
+                                    "Unbalanced load of server " << i);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(leastLoaded.GetLoad(serverNodes.Get(i)),
+                                    17,
+                                    "Unbalanced load of server " << i);
+    }
+
+    // Round-robin continues across calls until reset.
+    ServerShardHelper roundRobin(ServerShardHelper::SHARD_ROUND_ROBIN);
+    shards = roundRobin.Assign(serverNodes, NodeContainer(clientNodes.Get(0)));
+    shards = roundRobin.Assign(serverNodes, NodeContainer(clientNodes.Get(1)));
+    NS_TEST_ASSERT_MSG_EQ(shards[1].GetN(), 1, "Round-robin restarted");
+    roundRobin.Reset();
+    shards = roundRobin.Assign(serverNodes, NodeContainer(clientNodes.Get(2)));
+    NS_TEST_ASSERT_MSG_EQ(shards[0].GetN(), 1, "Round-robin was not reset");
+    NS_TEST_ASSERT_MSG_EQ(roundRobin.GetLoad(serverNodes.Get(1)), 0, "Load was not reset");
+
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
 class NrtvTestSuite : public TestSuite
 {
   public:
@@ -290,6 +2503,96 @@ NrtvTestSuite::NrtvTestSuite()
         }
     }
 
+    for (uint8_t j = 0; j < 3; j++)
+    {
+        std::ostringstream oss;
+        oss << "header-only, "
+            << "delay=" << delayMs[j] << "ms, "
+            << "run=" << rngRun[0];
+        AddTestCase(new NrtvClientRxHeaderOnlyTestCase(oss.str(),
+                                                       rngRun[0],
+                                                       MilliSeconds(delayMs[j]),
+                                                       Seconds(5)),
+                    TestCase::QUICK);
+    }
+
+    AddTestCase(new NrtvClientRxHeaderOnlyTestCase("header-only, bounded Rx buffer, "
+                                                   "delay=30ms, run=1",
+                                                   rngRun[0],
+                                                   MilliSeconds(30),
+                                                   Seconds(5),
+                                                   1000),
+                TestCase::QUICK);
+
+    AddTestCase(new NrtvClientRxHeaderOnlyTestCase("header-only, batched Recv, "
+                                                   "delay=30ms, run=1",
+                                                   rngRun[0],
+                                                   MilliSeconds(30),
+                                                   Seconds(5),
+                                                   0,
+                                                   536),
+                TestCase::QUICK);
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        std::ostringstream oss;
+        oss << "slice batching, " << protocols[i].GetName() << ", "
+            << "run=" << rngRun[1];
+        AddTestCase(
+            new NrtvSliceBatchingTestCase(oss.str(), rngRun[1], protocols[i], Seconds(5)),
+            TestCase::QUICK);
+    }
+
+    for (uint8_t j = 0; j < 3; j++)
+    {
+        std::ostringstream oss;
+        oss << "playout, "
+            << "delay=" << delayMs[j] << "ms, "
+            << "run=" << rngRun[2];
+        AddTestCase(
+            new NrtvPlayoutTestCase(oss.str(), rngRun[2], MilliSeconds(delayMs[j]), Seconds(10)),
+            TestCase::QUICK);
+    }
+
+    AddTestCase(new NrtvFrameStatsTestCase(MilliSeconds(3), Seconds(5)), TestCase::QUICK);
+    AddTestCase(new NrtvFrameStatsTestCase(MilliSeconds(300), Seconds(5)), TestCase::QUICK);
+
+    AddTestCase(new NrtvUdpSharedStreamTestCase("shared stream, run=1", rngRun[0], Seconds(5)),
+                TestCase::QUICK);
+    AddTestCase(new NrtvSharedStreamCountersTestCase(Seconds(5)), TestCase::QUICK);
+    AddTestCase(new NrtvUdpClientTestCase("UDP client, lossless", 0.0, Seconds(10)),
+                TestCase::QUICK);
+    AddTestCase(new NrtvUdpClientTestCase("UDP client, 10% loss", 0.1, Seconds(10)),
+                TestCase::QUICK);
+
+    AddTestCase(new NrtvVariateTableTestCase(1, 20000), TestCase::QUICK);
+    AddTestCase(new NrtvVariateTableTestCase(256, 20000), TestCase::QUICK);
+    AddTestCase(new NrtvVariablesViewTestCase(20000), TestCase::QUICK);
+    AddTestCase(new NrtvScheduleLogTestCase(1000), TestCase::QUICK);
+    AddTestCase(new NrtvCheckpointTestCase(Seconds(2)), TestCase::QUICK);
+    AddTestCase(new NrtvAdaptiveBitrateTestCase(DataRate("60kbps"), Seconds(30)),
+                TestCase::QUICK);
+
+    AddTestCase(new ServerShardHelperTestCase(), TestCase::QUICK);
+    AddTestCase(
+        new NrtvShardedInstallTestCase(tcp, ServerShardHelper::SHARD_ROUND_ROBIN, Seconds(5)),
+        TestCase::QUICK);
+    AddTestCase(new NrtvShardedInstallTestCase(tcp, ServerShardHelper::SHARD_HASH, Seconds(5)),
+                TestCase::QUICK);
+    AddTestCase(
+        new NrtvShardedInstallTestCase(udp, ServerShardHelper::SHARD_ROUND_ROBIN, Seconds(5)),
+        TestCase::QUICK);
+
+    AddTestCase(new NrtvVideoTraceTestCase(tcp, false), TestCase::QUICK);
+    AddTestCase(new NrtvVideoTraceTestCase(tcp, true), TestCase::QUICK);
+    AddTestCase(new NrtvVideoTraceTestCase(udp, false), TestCase::QUICK);
+
+    AddTestCase(new NrtvTimestampEncodingTestCase(TrafficTimestamp::FULL), TestCase::QUICK);
+    AddTestCase(new NrtvTimestampEncodingTestCase(TrafficTimestamp::COMPACT_NANOSECONDS),
+                TestCase::QUICK);
+    AddTestCase(new NrtvTimestampEncodingTestCase(TrafficTimestamp::COMPACT_MICROSECONDS),
+                TestCase::QUICK);
+
 } // end of `NrtvTestSuite ()`
 
 static NrtvTestSuite g_nrtvTestSuiteInstance;
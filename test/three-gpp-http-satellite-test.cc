@@ -0,0 +1,1318 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file three-gpp-http-satellite-test.cc
+ * \ingroup http
+ * \brief Test cases for ThreeGppHttpSatelliteClient, grouped in
+ *        `three-gpp-http-satellite` test suite.
+ */
+
+#include <ns3/boolean.h>
+#include <ns3/config.h>
+#include <ns3/data-rate.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
+#include <ns3/error-model.h>
+#include <ns3/integer.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/ipv4-address-helper.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/lazy-traced-callback.h>
+#include <ns3/log.h>
+#include <ns3/net-device-container.h>
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/pointer.h>
+#include <ns3/ppp-header.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/tcp-header.h>
+#include <ns3/tcp-l4-protocol.h>
+#include <ns3/test.h>
+#include <ns3/three-gpp-http-header.h>
+#include <ns3/three-gpp-http-satellite-client.h>
+#include <ns3/three-gpp-http-satellite-helper.h>
+#include <ns3/three-gpp-http-variables.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <list>
+#include <set>
+#include <sstream>
+#include <utility>
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppHttpSatelliteTest");
+
+using namespace ns3;
+
+/**
+ * \brief Install an HTTP server and a ThreeGppHttpSatelliteClient on two nodes
+ *        connected through a point-to-point link.
+ * \param helper the helper, whose client and server attributes are already set
+ * \param channelDelay delay of the link
+ * \param serverErrorModel optional error model applied to the packets received
+ *                         by the server node
+ * \return the client, which starts at 2 ms, while the server starts at 1 ms
+ */
+static Ptr<ThreeGppHttpSatelliteClient>
+InstallHttpSatelliteScenario(ThreeGppHttpHelper& helper,
+                             Time channelDelay,
+                             Ptr<ErrorModel> serverErrorModel = nullptr)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+    pointToPoint.SetChannelAttribute("Delay", TimeValue(channelDelay));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+    if (serverErrorModel != nullptr)
+    {
+        devices.Get(0)->SetAttribute("ReceiveErrorModel", PointerValue(serverErrorModel));
+    }
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devices);
+
+    helper.InstallUsingIpv4(nodes.Get(0), nodes.Get(1));
+    helper.GetServer().Get(0)->SetStartTime(MilliSeconds(1));
+    Ptr<Application> client = helper.GetClients().Get(0);
+    client->SetStartTime(MilliSeconds(2));
+    return DynamicCast<ThreeGppHttpSatelliteClient>(client);
+}
+
+/**
+ * \ingroup http
+ * \brief Verifies that every object sent by the HTTP server is received by
+ *        ThreeGppHttpSatelliteClient with the same size.
+ *
+ * Runs a simulation of one HTTP server and one client connected through a
+ * point-to-point link. The sizes of the objects generated by the server are
+ * compared, in order, against the objects assembled by the client through its
+ * `RxMainObject` and `RxEmbeddedObject` trace sources. The test case also
+ * verifies that the page load time is reported once for every web page.
+ */
+class ThreeGppHttpSatelliteObjectTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param rngRun the number of run to be used by the random number generator
+     * \param channelDelay delay of the point-to-point link
+     * \param duration length of simulation
+     */
+    ThreeGppHttpSatelliteObjectTestCase(std::string name,
+                                        uint32_t rngRun,
+                                        Time channelDelay,
+                                        Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void ServerMainObjectCallback(uint32_t size);
+    void ServerEmbeddedObjectCallback(uint32_t size);
+    void RxMainObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                              Ptr<const Packet> packet);
+    void RxEmbeddedObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                                  Ptr<const Packet> packet);
+    void RxPltCallback(const Time& plt, const Address& from);
+
+    /**
+     * \brief Compare a received object against the oldest object sent.
+     * \param packet the received object, including its header
+     * \param sizes sizes of the objects sent but not received yet
+     */
+    void CheckObject(Ptr<const Packet> packet, std::list<uint32_t>& sizes);
+
+    std::list<uint32_t> m_mainObjectSizes;     ///< Main objects not received yet.
+    std::list<uint32_t> m_embeddedObjectSizes; ///< Embedded objects not received yet.
+    uint32_t m_numOfMainObjects;               ///< Number of main objects received.
+    uint32_t m_numOfPages;                     ///< Number of web pages completed.
+    uint32_t m_rngRun;
+    Time m_channelDelay;
+    Time m_duration;
+
+}; // end of `class ThreeGppHttpSatelliteObjectTestCase`
+
+ThreeGppHttpSatelliteObjectTestCase::ThreeGppHttpSatelliteObjectTestCase(std::string name,
+                                                                         uint32_t rngRun,
+                                                                         Time channelDelay,
+                                                                         Time duration)
+    : TestCase(name),
+      m_numOfMainObjects(0),
+      m_numOfPages(0),
+      m_rngRun(rngRun),
+      m_channelDelay(channelDelay),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << rngRun << channelDelay.GetSeconds());
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(1)));
+
+    ThreeGppHttpHelper helper;
+    Ptr<ThreeGppHttpSatelliteClient> client = InstallHttpSatelliteScenario(helper, m_channelDelay);
+    Ptr<Application> server = helper.GetServer().Get(0);
+    server->TraceConnectWithoutContext(
+        "MainObject",
+        MakeCallback(&ThreeGppHttpSatelliteObjectTestCase::ServerMainObjectCallback, this));
+    server->TraceConnectWithoutContext(
+        "EmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteObjectTestCase::ServerEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxMainObject",
+        MakeCallback(&ThreeGppHttpSatelliteObjectTestCase::RxMainObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxEmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteObjectTestCase::RxEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxPlt",
+        MakeCallback(&ThreeGppHttpSatelliteObjectTestCase::RxPltCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfPages, 0, "No web page has been completed");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_numOfMainObjects,
+                                m_numOfPages,
+                                "More web pages than main objects");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_mainObjectSizes.size(),
+                                1,
+                                "More than one main object is still on its way");
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(30)));
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteObjectTestCase::ServerMainObjectCallback(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_mainObjectSizes.push_back(size);
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::ServerEmbeddedObjectCallback(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_embeddedObjectSizes.push_back(size);
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::RxMainObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << client << packet);
+    CheckObject(packet, m_mainObjectSizes);
+    m_numOfMainObjects++;
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::RxEmbeddedObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << client << packet);
+    CheckObject(packet, m_embeddedObjectSizes);
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::RxPltCallback(const Time& plt, const Address& from)
+{
+    NS_LOG_FUNCTION(this << plt.GetSeconds() << from);
+    NS_TEST_ASSERT_MSG_EQ(m_numOfPages + 1,
+                          m_numOfMainObjects,
+                          "Page load time is not reported once per web page");
+    NS_TEST_ASSERT_MSG_EQ(m_embeddedObjectSizes.empty(),
+                          true,
+                          "Web page completed before all its embedded objects");
+    NS_TEST_ASSERT_MSG_GT(plt, 2 * m_channelDelay, "Page load time shorter than the round trip");
+    m_numOfPages++;
+}
+
+void
+ThreeGppHttpSatelliteObjectTestCase::CheckObject(Ptr<const Packet> packet,
+                                                 std::list<uint32_t>& sizes)
+{
+    NS_TEST_ASSERT_MSG_EQ((packet != nullptr), true, "Trace source fired without an object");
+    NS_TEST_ASSERT_MSG_EQ(sizes.empty(), false, "Received an object which has not been sent");
+
+    ThreeGppHttpHeader header;
+    packet->PeekHeader(header);
+    NS_TEST_ASSERT_MSG_EQ(header.GetContentLength(),
+                          sizes.front(),
+                          "Received an object of a different size than sent");
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(),
+                          header.GetSerializedSize() + header.GetContentLength(),
+                          "The assembled object does not match its header");
+    sizes.pop_front();
+}
+
+/**
+ * \ingroup http
+ * \brief Verifies the `KeepAliveTimeout` and `Preconnect` attributes of
+ *        ThreeGppHttpSatelliteClient.
+ *
+ * Runs a simulation of one HTTP server and one client with a keep-alive
+ * timeout shorter than some of the random reading times. A web page requested
+ * within the timeout must reuse the connection without any setup delay. Once
+ * the timeout expires, the connection must be closed right away. Without
+ * preconnecting, the next web page must then wait for a new connection to be
+ * established. With preconnecting, the connection must be ready by the time
+ * the next web page is requested, so the setup delay is removed or at least
+ * shortened.
+ */
+class ThreeGppHttpSatelliteKeepAliveTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param keepAliveTimeout the `KeepAliveTimeout` of the client
+     * \param preconnect the `Preconnect` of the client
+     * \param duration length of simulation
+     */
+    ThreeGppHttpSatelliteKeepAliveTestCase(std::string name,
+                                           Time keepAliveTimeout,
+                                           bool preconnect,
+                                           Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void ConnectionEstablishedCallback(Ptr<const ThreeGppHttpSatelliteClient> client);
+    void ConnectionClosedCallback(Ptr<const ThreeGppHttpSatelliteClient> client);
+    void ConnectionSetupDelayCallback(Time delay);
+    void RxPltCallback(const Time& plt, const Address& from);
+
+    uint32_t m_numOfConnections;    ///< Number of connections established.
+    uint32_t m_numOfPages;          ///< Number of web pages completed.
+    uint32_t m_numOfReuses;         ///< Web pages which have reused the connection.
+    uint32_t m_numOfNewConnections; ///< Web pages which have waited for a new connection.
+    uint32_t m_numOfPreconnected;   ///< Web pages which have found a connection ready.
+    bool m_isReading;               ///< True between a web page and the next request.
+    bool m_isClosed;                ///< True if the connection has been closed while reading.
+    Time m_lastPltTime;             ///< Time when the last web page was completed.
+    Time m_channelDelay;
+    Time m_keepAliveTimeout;
+    bool m_preconnect;
+    Time m_duration;
+
+}; // end of `class ThreeGppHttpSatelliteKeepAliveTestCase`
+
+ThreeGppHttpSatelliteKeepAliveTestCase::ThreeGppHttpSatelliteKeepAliveTestCase(
+    std::string name,
+    Time keepAliveTimeout,
+    bool preconnect,
+    Time duration)
+    : TestCase(name),
+      m_numOfConnections(0),
+      m_numOfPages(0),
+      m_numOfReuses(0),
+      m_numOfNewConnections(0),
+      m_numOfPreconnected(0),
+      m_isReading(false),
+      m_isClosed(false),
+      m_channelDelay(MilliSeconds(30)),
+      m_keepAliveTimeout(keepAliveTimeout),
+      m_preconnect(preconnect),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << keepAliveTimeout.GetSeconds() << preconnect);
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(1)));
+
+    ThreeGppHttpHelper helper;
+    helper.SetClientAttribute("KeepAliveTimeout", TimeValue(m_keepAliveTimeout));
+    helper.SetClientAttribute("Preconnect", BooleanValue(m_preconnect));
+
+    Ptr<ThreeGppHttpSatelliteClient> client = InstallHttpSatelliteScenario(helper, m_channelDelay);
+    client->TraceConnectWithoutContext(
+        "ConnectionEstablished",
+        MakeCallback(&ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionEstablishedCallback, this));
+    client->TraceConnectWithoutContext(
+        "ConnectionClosed",
+        MakeCallback(&ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionClosedCallback, this));
+    client->TraceConnectWithoutContext(
+        "ConnectionSetupDelay",
+        MakeCallback(&ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionSetupDelayCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxPlt",
+        MakeCallback(&ThreeGppHttpSatelliteKeepAliveTestCase::RxPltCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfPages, 0, "No web page has been completed");
+    NS_TEST_ASSERT_MSG_GT(m_numOfReuses, 0, "No web page has reused the connection");
+    NS_TEST_ASSERT_MSG_GT(m_numOfConnections, 1, "The connection has never been opened again");
+
+    if (m_preconnect)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_numOfPreconnected,
+                              0,
+                              "No web page has found a connection opened in advance");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_GT(m_numOfNewConnections,
+                              0,
+                              "No web page has waited for a new connection");
+    }
+
+    // return default values to their default
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(30)));
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionEstablishedCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client)
+{
+    NS_LOG_FUNCTION(this << client);
+    m_numOfConnections++;
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionClosedCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client)
+{
+    NS_LOG_FUNCTION(this << client);
+    NS_TEST_ASSERT_MSG_EQ(m_isReading, true, "Connection closed outside the reading time");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(),
+                          m_lastPltTime + m_keepAliveTimeout,
+                          "Connection not closed right when the keep-alive timeout expires");
+    m_isClosed = true;
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::ConnectionSetupDelayCallback(Time delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetSeconds());
+
+    if (!m_isReading)
+    {
+        return; // the first web page always needs a new connection
+    }
+
+    const Time readingTime = Simulator::Now() - delay - m_lastPltTime;
+    if (readingTime <= m_keepAliveTimeout)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_isClosed, false, "Connection closed within the timeout");
+        NS_TEST_ASSERT_MSG_EQ(delay, Seconds(0), "Connection not reused within the timeout");
+        m_numOfReuses++;
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_isClosed, true, "Connection kept after the timeout");
+        if (m_preconnect)
+        {
+            NS_TEST_ASSERT_MSG_LT(delay,
+                                  2 * m_channelDelay,
+                                  "Preconnecting has not shortened the setup delay");
+            if (delay.IsZero())
+            {
+                m_numOfPreconnected++;
+            }
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_GT_OR_EQ(delay,
+                                        2 * m_channelDelay,
+                                        "New connection established faster than a round trip");
+            m_numOfNewConnections++;
+        }
+    }
+
+    m_isReading = false;
+    m_isClosed = false;
+}
+
+void
+ThreeGppHttpSatelliteKeepAliveTestCase::RxPltCallback(const Time& plt, const Address& from)
+{
+    NS_LOG_FUNCTION(this << plt.GetSeconds() << from);
+    m_numOfPages++;
+    m_lastPltTime = Simulator::Now();
+    m_isReading = true;
+    m_isClosed = false;
+}
+
+/**
+ * \ingroup http
+ * \brief Drops every request sent through one parallel connection of
+ *        ThreeGppHttpSatelliteClient.
+ *
+ * Applied to the packets received by the server. The connection opened second
+ * by the client, i.e., its first parallel connection, is established normally,
+ * but none of its TCP segments carrying data reaches the server. The client
+ * eventually gives up the connection while it waits for an embedded object.
+ */
+class ThreeGppHttpSatelliteDropConnectionErrorModel : public ErrorModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /// Construct a new error model.
+    ThreeGppHttpSatelliteDropConnectionErrorModel();
+
+    /// \return the number of segments dropped so far
+    uint32_t GetNumOfDrops() const;
+
+  private:
+    // Inherited from ErrorModel base class.
+    virtual bool DoCorrupt(Ptr<Packet> p);
+    virtual void DoReset();
+
+    uint32_t m_numOfConnections; ///< Number of connection requests seen.
+    uint16_t m_victimPort;       ///< Client port of the connection to drop, or zero.
+    uint32_t m_numOfDrops;       ///< Number of segments dropped.
+
+}; // end of `class ThreeGppHttpSatelliteDropConnectionErrorModel`
+
+NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpSatelliteDropConnectionErrorModel);
+
+TypeId
+ThreeGppHttpSatelliteDropConnectionErrorModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ThreeGppHttpSatelliteDropConnectionErrorModel")
+                            .SetParent<ErrorModel>()
+                            .AddConstructor<ThreeGppHttpSatelliteDropConnectionErrorModel>();
+    return tid;
+}
+
+ThreeGppHttpSatelliteDropConnectionErrorModel::ThreeGppHttpSatelliteDropConnectionErrorModel()
+    : m_numOfConnections(0),
+      m_victimPort(0),
+      m_numOfDrops(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+ThreeGppHttpSatelliteDropConnectionErrorModel::GetNumOfDrops() const
+{
+    return m_numOfDrops;
+}
+
+bool
+ThreeGppHttpSatelliteDropConnectionErrorModel::DoCorrupt(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+
+    Ptr<Packet> copy = p->Copy();
+    PppHeader pppHeader;
+    copy->RemoveHeader(pppHeader);
+    if (pppHeader.GetProtocol() != 0x0021) // IPv4
+    {
+        return false;
+    }
+
+    Ipv4Header ipv4Header;
+    copy->RemoveHeader(ipv4Header);
+    if (ipv4Header.GetProtocol() != TcpL4Protocol::PROT_NUMBER)
+    {
+        return false;
+    }
+
+    TcpHeader tcpHeader;
+    copy->RemoveHeader(tcpHeader);
+    if (tcpHeader.GetFlags() == TcpHeader::SYN)
+    {
+        m_numOfConnections++;
+        if (m_numOfConnections == 2)
+        {
+            m_victimPort = tcpHeader.GetSourcePort();
+            NS_LOG_INFO(this << " Dropping the requests from port " << m_victimPort);
+        }
+        return false;
+    }
+
+    if (m_victimPort != 0 && tcpHeader.GetSourcePort() == m_victimPort && copy->GetSize() > 0)
+    {
+        m_numOfDrops++;
+        return true;
+    }
+
+    return false;
+}
+
+void
+ThreeGppHttpSatelliteDropConnectionErrorModel::DoReset()
+{
+    NS_LOG_FUNCTION(this);
+    m_numOfConnections = 0;
+    m_victimPort = 0;
+    m_numOfDrops = 0;
+}
+
+/**
+ * \ingroup http
+ * \brief Verifies ThreeGppHttpSatelliteClient receiving the embedded objects
+ *        through parallel connections.
+ *
+ * Runs a simulation of one HTTP server and one client with the given
+ * `MaxParallelConnections`. Every embedded object determined by parsing is
+ * counted through the `CacheMiss` trace source of a cache which never hits.
+ * Each web page must complete right upon receiving its last object, after
+ * receiving exactly as many embedded objects as parsed, and with a page load
+ * time measured from the request of the main object. Each received object must
+ * match an object sent by the server and not received yet, so that nothing is
+ * received twice.
+ *
+ * Optionally, the first parallel connection of the client is made to lose its
+ * requests (see ThreeGppHttpSatelliteDropConnectionErrorModel). The client
+ * must then request the lost object once more through another connection,
+ * and otherwise send exactly one request per embedded object.
+ */
+class ThreeGppHttpSatelliteParallelTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param maxParallelConnections the `MaxParallelConnections` of the client
+     * \param rngRun the number of run to be used by the random number generator
+     * \param isDroppingConnection whether the first parallel connection loses
+     *                             its requests
+     * \param duration length of simulation
+     */
+    ThreeGppHttpSatelliteParallelTestCase(std::string name,
+                                          uint32_t maxParallelConnections,
+                                          uint32_t rngRun,
+                                          bool isDroppingConnection,
+                                          Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void ServerEmbeddedObjectCallback(uint32_t size);
+    void CacheMissCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                           uint32_t objectId,
+                           uint32_t objectSize);
+    void TxMainObjectRequestCallback(Ptr<const Packet> packet);
+    void TxEmbeddedObjectRequestCallback(Ptr<const Packet> packet);
+    void RxMainObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                              Ptr<const Packet> packet);
+    void RxEmbeddedObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                                  Ptr<const Packet> packet);
+    void RxPltCallback(const Time& plt, const Address& from);
+
+    /// \return the number of requests lost so far, either zero or one
+    uint32_t GetNumOfLostRequests() const;
+
+    Ptr<ThreeGppHttpSatelliteDropConnectionErrorModel> m_errorModel;
+    std::multiset<uint32_t> m_embeddedObjectSizes; ///< Embedded objects not received yet.
+    uint32_t m_numOfParsedObjects;   ///< Number of embedded objects determined by parsing.
+    uint32_t m_numOfRequests;        ///< Number of embedded object requests sent.
+    uint32_t m_numOfEmbeddedObjects; ///< Number of embedded objects received.
+    uint32_t m_maxOutstanding;       ///< Most requests waiting for an object at once.
+    uint32_t m_numOfPages;           ///< Number of web pages completed.
+    uint32_t m_numOfPagesAfterLoss;  ///< Number of web pages completed after a lost request.
+    uint32_t m_pageFirstObject;      ///< Value of #m_numOfParsedObjects when the page began.
+    Time m_mainObjectRequestTime;    ///< Time when the last main object was requested.
+    Time m_lastObjectRxTime;         ///< Time when the last object was received.
+    uint32_t m_maxParallelConnections;
+    uint32_t m_rngRun;
+    bool m_isDroppingConnection;
+    Time m_duration;
+
+}; // end of `class ThreeGppHttpSatelliteParallelTestCase`
+
+ThreeGppHttpSatelliteParallelTestCase::ThreeGppHttpSatelliteParallelTestCase(
+    std::string name,
+    uint32_t maxParallelConnections,
+    uint32_t rngRun,
+    bool isDroppingConnection,
+    Time duration)
+    : TestCase(name),
+      m_numOfParsedObjects(0),
+      m_numOfRequests(0),
+      m_numOfEmbeddedObjects(0),
+      m_maxOutstanding(0),
+      m_numOfPages(0),
+      m_numOfPagesAfterLoss(0),
+      m_pageFirstObject(0),
+      m_maxParallelConnections(maxParallelConnections),
+      m_rngRun(rngRun),
+      m_isDroppingConnection(isDroppingConnection),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << maxParallelConnections << rngRun << isDroppingConnection);
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName() << m_rngRun);
+
+    Config::SetGlobal("RngRun", UintegerValue(m_rngRun));
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(1)));
+    // Give up the dropping connection in seconds rather than minutes.
+    Config::SetDefault("ns3::TcpSocket::DataRetries", UintegerValue(2));
+
+    ThreeGppHttpHelper helper;
+    helper.SetClientAttribute("MaxParallelConnections", UintegerValue(m_maxParallelConnections));
+    helper.SetClientAttribute("CacheModel",
+                              EnumValue(ThreeGppHttpSatelliteClient::CACHE_HIT_PROBABILITY));
+    helper.SetClientAttribute("CacheHitProbability", DoubleValue(0.0));
+
+    if (m_isDroppingConnection)
+    {
+        m_errorModel = CreateObject<ThreeGppHttpSatelliteDropConnectionErrorModel>();
+    }
+    Ptr<ThreeGppHttpSatelliteClient> client =
+        InstallHttpSatelliteScenario(helper, MilliSeconds(3), m_errorModel);
+    helper.GetServer().Get(0)->TraceConnectWithoutContext(
+        "EmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::ServerEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "CacheMiss",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::CacheMissCallback, this));
+    client->TraceConnectWithoutContext(
+        "TxMainObjectRequest",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::TxMainObjectRequestCallback, this));
+    client->TraceConnectWithoutContext(
+        "TxEmbeddedObjectRequest",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::TxEmbeddedObjectRequestCallback,
+                     this));
+    client->TraceConnectWithoutContext(
+        "RxMainObject",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::RxMainObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxEmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::RxEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxPlt",
+        MakeCallback(&ThreeGppHttpSatelliteParallelTestCase::RxPltCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfPages, 0, "No web page has been completed");
+    NS_TEST_ASSERT_MSG_GT(m_maxOutstanding,
+                          1,
+                          "Embedded objects have never been received in parallel");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_maxOutstanding,
+                                m_maxParallelConnections + GetNumOfLostRequests(),
+                                "More requests outstanding than parallel connections");
+
+    if (m_isDroppingConnection)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_errorModel->GetNumOfDrops(), 0, "No request has been lost");
+        NS_TEST_ASSERT_MSG_GT(m_numOfPagesAfterLoss,
+                              0,
+                              "No web page has been completed after losing a request");
+    }
+
+    // return default values to their default
+    Config::SetGlobal("RngRun", UintegerValue(1));
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(30)));
+    Config::SetDefault("ns3::TcpSocket::DataRetries", UintegerValue(6));
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteParallelTestCase::ServerEmbeddedObjectCallback(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_embeddedObjectSizes.insert(size);
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::CacheMissCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    uint32_t objectId,
+    uint32_t objectSize)
+{
+    NS_LOG_FUNCTION(this << client << objectId << objectSize);
+    m_numOfParsedObjects++;
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::TxMainObjectRequestCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    m_mainObjectRequestTime = Simulator::Now();
+    m_pageFirstObject = m_numOfParsedObjects;
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::TxEmbeddedObjectRequestCallback(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    m_numOfRequests++;
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_numOfRequests,
+                                m_numOfParsedObjects + GetNumOfLostRequests(),
+                                "Requested more embedded objects than parsed");
+    m_maxOutstanding = std::max(m_maxOutstanding, m_numOfRequests - m_numOfEmbeddedObjects);
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::RxMainObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << client << packet);
+    m_lastObjectRxTime = Simulator::Now();
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::RxEmbeddedObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << client << packet);
+    m_lastObjectRxTime = Simulator::Now();
+    m_numOfEmbeddedObjects++;
+
+    ThreeGppHttpHeader header;
+    packet->PeekHeader(header);
+    std::multiset<uint32_t>::iterator it = m_embeddedObjectSizes.find(header.GetContentLength());
+    NS_TEST_ASSERT_MSG_EQ((it != m_embeddedObjectSizes.end()),
+                          true,
+                          "Received an embedded object which is not expected");
+    m_embeddedObjectSizes.erase(it);
+}
+
+void
+ThreeGppHttpSatelliteParallelTestCase::RxPltCallback(const Time& plt, const Address& from)
+{
+    NS_LOG_FUNCTION(this << plt.GetSeconds() << from);
+    NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjects,
+                          m_numOfParsedObjects,
+                          "Web page completed with a different number of embedded objects");
+    NS_TEST_ASSERT_MSG_EQ(m_embeddedObjectSizes.empty(),
+                          true,
+                          "Web page completed before receiving all objects sent");
+    NS_TEST_ASSERT_MSG_EQ(m_numOfRequests,
+                          m_numOfParsedObjects + GetNumOfLostRequests(),
+                          "Not exactly one request per embedded object and lost request");
+    NS_TEST_ASSERT_MSG_EQ(plt,
+                          Simulator::Now() - m_mainObjectRequestTime,
+                          "Page load time not measured from the main object request");
+    if (m_numOfParsedObjects > m_pageFirstObject)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_lastObjectRxTime,
+                              Simulator::Now(),
+                              "Web page not completed upon its last embedded object");
+    }
+
+    m_numOfPages++;
+    if (GetNumOfLostRequests() > 0)
+    {
+        m_numOfPagesAfterLoss++;
+    }
+}
+
+uint32_t
+ThreeGppHttpSatelliteParallelTestCase::GetNumOfLostRequests() const
+{
+    // The dropping connection carries one request before it is given up.
+    return (m_errorModel != nullptr && m_errorModel->GetNumOfDrops() > 0) ? 1 : 0;
+}
+
+/**
+ * \ingroup http
+ * \brief Verifies the browser cache models of ThreeGppHttpSatelliteClient.
+ *
+ * Runs a simulation of one HTTP server and one client with the given cache
+ * model. Every web page must complete only after receiving exactly the
+ * embedded objects reported by the `CacheMiss` trace source. In the
+ * `HIT_PROBABILITY` cache model, the traces must not carry any object identity
+ * and the `CacheObjectIdentity` random variable must never be drawn. In the
+ * `LRU` cache model, the `CacheHit` and `CacheMiss` traces are compared against
+ * a reference LRU cache of the same size fed by the received objects, which
+ * must have evicted some objects by the end of the simulation.
+ */
+class ThreeGppHttpSatelliteCacheTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param name the test case name, which will be printed on the report
+     * \param cacheModel the cache model of the client, either
+     *                   `CACHE_HIT_PROBABILITY` or `CACHE_LRU`
+     * \param duration length of simulation
+     */
+    ThreeGppHttpSatelliteCacheTestCase(std::string name,
+                                       ThreeGppHttpSatelliteClient::CacheModel_t cacheModel,
+                                       Time duration);
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void CacheHitCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                          uint32_t objectId,
+                          uint32_t objectSize);
+    void CacheMissCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                           uint32_t objectId,
+                           uint32_t objectSize);
+    void RxEmbeddedObjectCallback(Ptr<const ThreeGppHttpSatelliteClient> client,
+                                  Ptr<const Packet> packet);
+    void RxPltCallback(const Time& plt, const Address& from);
+
+    /**
+     * \brief Find an object in the reference LRU cache.
+     * \param objectId the identity of the object
+     * \return the entry of the object, or the end of #m_cacheEntries
+     */
+    std::list<std::pair<uint32_t, uint32_t>>::iterator FindCacheEntry(uint32_t objectId);
+
+    /// Identity and size of the objects in the reference LRU cache, most recent first.
+    std::list<std::pair<uint32_t, uint32_t>> m_cacheEntries;
+    uint32_t m_cacheUsedBytes;           ///< Total size of #m_cacheEntries.
+    std::list<uint32_t> m_requestedIds;  ///< Objects missed but not received yet.
+    uint32_t m_numOfHits;                ///< Number of `CacheHit` traces.
+    uint32_t m_numOfMisses;              ///< Number of `CacheMiss` traces.
+    uint32_t m_numOfEmbeddedObjects;     ///< Number of embedded objects received.
+    uint32_t m_numOfEvictions;           ///< Number of evictions from the reference cache.
+    uint32_t m_numOfPages;               ///< Number of web pages completed.
+    uint32_t m_cacheSize;
+    ThreeGppHttpSatelliteClient::CacheModel_t m_cacheModel;
+    Time m_duration;
+
+}; // end of `class ThreeGppHttpSatelliteCacheTestCase`
+
+ThreeGppHttpSatelliteCacheTestCase::ThreeGppHttpSatelliteCacheTestCase(
+    std::string name,
+    ThreeGppHttpSatelliteClient::CacheModel_t cacheModel,
+    Time duration)
+    : TestCase(name),
+      m_cacheUsedBytes(0),
+      m_numOfHits(0),
+      m_numOfMisses(0),
+      m_numOfEmbeddedObjects(0),
+      m_numOfEvictions(0),
+      m_numOfPages(0),
+      m_cacheSize(50000),
+      m_cacheModel(cacheModel),
+      m_duration(duration)
+{
+    NS_LOG_FUNCTION(this << name << cacheModel << duration.GetSeconds());
+}
+
+void
+ThreeGppHttpSatelliteCacheTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this << GetName());
+
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(1)));
+
+    ThreeGppHttpHelper helper;
+    helper.SetClientAttribute("CacheModel", EnumValue(m_cacheModel));
+    helper.SetClientAttribute("CacheHitProbability", DoubleValue(0.5));
+    helper.SetClientAttribute("CacheSize", UintegerValue(m_cacheSize));
+
+    // A small web site, so that the same objects often appear again.
+    Ptr<RandomVariableStream> objectIdRng;
+    if (m_cacheModel == ThreeGppHttpSatelliteClient::CACHE_LRU)
+    {
+        objectIdRng = CreateObjectWithAttributes<ZipfRandomVariable>("N",
+                                                                     IntegerValue(20),
+                                                                     "Alpha",
+                                                                     DoubleValue(1.0));
+    }
+    else
+    {
+        objectIdRng = CreateObjectWithAttributes<SequentialRandomVariable>("Min",
+                                                                           DoubleValue(1),
+                                                                           "Max",
+                                                                           DoubleValue(1000));
+    }
+    helper.SetClientAttribute("CacheObjectIdentity", PointerValue(objectIdRng));
+
+    Ptr<ThreeGppHttpSatelliteClient> client = InstallHttpSatelliteScenario(helper, MilliSeconds(3));
+    client->TraceConnectWithoutContext(
+        "CacheHit",
+        MakeCallback(&ThreeGppHttpSatelliteCacheTestCase::CacheHitCallback, this));
+    client->TraceConnectWithoutContext(
+        "CacheMiss",
+        MakeCallback(&ThreeGppHttpSatelliteCacheTestCase::CacheMissCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxEmbeddedObject",
+        MakeCallback(&ThreeGppHttpSatelliteCacheTestCase::RxEmbeddedObjectCallback, this));
+    client->TraceConnectWithoutContext(
+        "RxPlt",
+        MakeCallback(&ThreeGppHttpSatelliteCacheTestCase::RxPltCallback, this));
+
+    Simulator::Stop(m_duration);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_numOfPages, 0, "No web page has been completed");
+    NS_TEST_ASSERT_MSG_GT(m_numOfHits, 0, "No embedded object has been found in the cache");
+    NS_TEST_ASSERT_MSG_GT(m_numOfMisses, 0, "Every embedded object has been found in the cache");
+
+    if (m_cacheModel == ThreeGppHttpSatelliteClient::CACHE_LRU)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_numOfEvictions, 0, "No object has been evicted from the cache");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(objectIdRng->GetInteger(),
+                              1,
+                              "Object identities have been drawn without the LRU cache");
+    }
+
+    // return default values to their default
+    Config::SetDefault("ns3::ThreeGppHttpVariables::ReadingTimeMean", TimeValue(Seconds(30)));
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteCacheTestCase::CacheHitCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    uint32_t objectId,
+    uint32_t objectSize)
+{
+    NS_LOG_FUNCTION(this << client << objectId << objectSize);
+    m_numOfHits++;
+
+    if (m_cacheModel == ThreeGppHttpSatelliteClient::CACHE_LRU)
+    {
+        std::list<std::pair<uint32_t, uint32_t>>::iterator it = FindCacheEntry(objectId);
+        NS_TEST_ASSERT_MSG_EQ((it != m_cacheEntries.end()),
+                              true,
+                              "Found object " << objectId << " which is not in the cache");
+        NS_TEST_ASSERT_MSG_EQ(objectSize,
+                              it->second,
+                              "Found object " << objectId << " with a different size");
+        m_cacheEntries.splice(m_cacheEntries.begin(), m_cacheEntries, it);
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(objectId, 0, "Unexpected object identity");
+        NS_TEST_ASSERT_MSG_EQ(objectSize, 0, "Unexpected object size");
+    }
+}
+
+void
+ThreeGppHttpSatelliteCacheTestCase::CacheMissCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    uint32_t objectId,
+    uint32_t objectSize)
+{
+    NS_LOG_FUNCTION(this << client << objectId << objectSize);
+    NS_TEST_ASSERT_MSG_EQ(objectSize, 0, "Unexpected object size on a cache miss");
+    m_numOfMisses++;
+
+    if (m_cacheModel == ThreeGppHttpSatelliteClient::CACHE_LRU)
+    {
+        NS_TEST_ASSERT_MSG_EQ((FindCacheEntry(objectId) == m_cacheEntries.end()),
+                              true,
+                              "Missed object " << objectId << " which is in the cache");
+        m_requestedIds.push_back(objectId);
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(objectId, 0, "Unexpected object identity");
+    }
+}
+
+void
+ThreeGppHttpSatelliteCacheTestCase::RxEmbeddedObjectCallback(
+    Ptr<const ThreeGppHttpSatelliteClient> client,
+    Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << client << packet);
+    m_numOfEmbeddedObjects++;
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_numOfEmbeddedObjects,
+                                m_numOfMisses,
+                                "Received an embedded object which has been found in the cache");
+
+    if (m_cacheModel != ThreeGppHttpSatelliteClient::CACHE_LRU)
+    {
+        return;
+    }
+
+    // With a single connection, the objects arrive in the order of the misses.
+    NS_TEST_ASSERT_MSG_EQ(m_requestedIds.empty(), false, "Received an unexpected object");
+    const uint32_t objectId = m_requestedIds.front();
+    m_requestedIds.pop_front();
+
+    ThreeGppHttpHeader header;
+    packet->PeekHeader(header);
+    const uint32_t objectSize = header.GetContentLength();
+    if (objectSize > m_cacheSize)
+    {
+        return;
+    }
+
+    std::list<std::pair<uint32_t, uint32_t>>::iterator it = FindCacheEntry(objectId);
+    if (it != m_cacheEntries.end())
+    {
+        m_cacheUsedBytes -= it->second;
+        m_cacheEntries.erase(it);
+    }
+
+    m_cacheEntries.push_front(std::make_pair(objectId, objectSize));
+    m_cacheUsedBytes += objectSize;
+    while (m_cacheUsedBytes > m_cacheSize)
+    {
+        m_cacheUsedBytes -= m_cacheEntries.back().second;
+        m_cacheEntries.pop_back();
+        m_numOfEvictions++;
+    }
+}
+
+void
+ThreeGppHttpSatelliteCacheTestCase::RxPltCallback(const Time& plt, const Address& from)
+{
+    NS_LOG_FUNCTION(this << plt.GetSeconds() << from);
+    NS_TEST_ASSERT_MSG_EQ(m_numOfEmbeddedObjects,
+                          m_numOfMisses,
+                          "Web page completed without receiving exactly the missed objects");
+    m_numOfPages++;
+}
+
+std::list<std::pair<uint32_t, uint32_t>>::iterator
+ThreeGppHttpSatelliteCacheTestCase::FindCacheEntry(uint32_t objectId)
+{
+    std::list<std::pair<uint32_t, uint32_t>>::iterator it;
+    for (it = m_cacheEntries.begin(); it != m_cacheEntries.end(); ++it)
+    {
+        if (it->first == objectId)
+        {
+            break;
+        }
+    }
+    return it;
+}
+
+/**
+ * \ingroup http
+ * \brief Verifies the parts of ThreeGppHttpSatelliteClient which are allocated
+ *        on demand.
+ *
+ * A LazyTracedCallback must behave like a TracedCallback, and must still be
+ * reachable through the attribute system of the client. A new client must own
+ * private variables right after construction, as it did before the variables
+ * could be shared, so that the automatic random streams stay the same. A client
+ * constructed with the `Variables` attribute must use the given instance. The
+ * random variables of the cache models must not be created before the client
+ * starts.
+ */
+class ThreeGppHttpSatelliteFootprintTestCase : public TestCase
+{
+  public:
+    /// Construct a new test case.
+    ThreeGppHttpSatelliteFootprintTestCase();
+
+  private:
+    virtual void DoRun();
+
+    // CALLBACK FUNCTIONS
+    void Sink(uint32_t value);
+    void RxCallback(Ptr<const Packet> packet, const Address& from);
+
+    uint32_t m_sum; ///< Sum of the values received by Sink().
+
+}; // end of `class ThreeGppHttpSatelliteFootprintTestCase`
+
+ThreeGppHttpSatelliteFootprintTestCase::ThreeGppHttpSatelliteFootprintTestCase()
+    : TestCase("on-demand members"),
+      m_sum(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ThreeGppHttpSatelliteFootprintTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this);
+
+    LazyTracedCallback<uint32_t> trace;
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "A new trace source must be empty");
+    trace(1); // must be ignored
+
+    Callback<void, uint32_t> callback =
+        MakeCallback(&ThreeGppHttpSatelliteFootprintTestCase::Sink, this);
+    trace.ConnectWithoutContext(callback);
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), false, "The trace source must not be empty");
+    trace(5);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 5, "The connected sink has not been invoked");
+
+    trace.DisconnectWithoutContext(callback);
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "The trace source must be empty again");
+    trace(7); // must be ignored
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 5, "A disconnected sink has been invoked");
+
+    Ptr<ThreeGppHttpSatelliteClient> client = CreateObject<ThreeGppHttpSatelliteClient>();
+    const bool isConnected = client->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&ThreeGppHttpSatelliteFootprintTestCase::RxCallback, this));
+    NS_TEST_ASSERT_MSG_EQ(isConnected, true, "Unable to connect to the Rx trace source");
+
+    PointerValue variables;
+    client->GetAttribute("Variables", variables);
+    NS_TEST_ASSERT_MSG_EQ((variables.Get<ThreeGppHttpVariables>() != nullptr),
+                          true,
+                          "A new client must own its private variables");
+
+    Ptr<ThreeGppHttpVariables> shared = CreateObject<ThreeGppHttpVariables>();
+    Ptr<ThreeGppHttpSatelliteClient> sharing =
+        CreateObjectWithAttributes<ThreeGppHttpSatelliteClient>("Variables", PointerValue(shared));
+    sharing->GetAttribute("Variables", variables);
+    NS_TEST_ASSERT_MSG_EQ(variables.Get<ThreeGppHttpVariables>(),
+                          shared,
+                          "The given variables must be used as is");
+
+    PointerValue cacheRng;
+    client->GetAttribute("CacheObjectIdentity", cacheRng);
+    NS_TEST_ASSERT_MSG_EQ((cacheRng.Get<RandomVariableStream>() == nullptr),
+                          true,
+                          "A client which has not started must not own a cache object identity");
+    client->GetAttribute("CacheHitRandomVariable", cacheRng);
+    NS_TEST_ASSERT_MSG_EQ((cacheRng.Get<RandomVariableStream>() == nullptr),
+                          true,
+                          "A client which has not started must not own a cache hit variable");
+
+    client->Dispose();
+    sharing->Dispose();
+    Simulator::Destroy();
+
+} // end of `void DoRun ()`
+
+void
+ThreeGppHttpSatelliteFootprintTestCase::Sink(uint32_t value)
+{
+    NS_LOG_FUNCTION(this << value);
+    m_sum += value;
+}
+
+void
+ThreeGppHttpSatelliteFootprintTestCase::RxCallback(Ptr<const Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << packet << from);
+}
+
+/**
+ * \ingroup http
+ * \brief Test suite of ThreeGppHttpSatelliteClient.
+ */
+class ThreeGppHttpSatelliteTestSuite : public TestSuite
+{
+  public:
+    ThreeGppHttpSatelliteTestSuite();
+};
+
+ThreeGppHttpSatelliteTestSuite::ThreeGppHttpSatelliteTestSuite()
+    : TestSuite("three-gpp-http-satellite", SYSTEM)
+{
+    // LogComponentEnable ("ThreeGppHttpSatelliteTest", LOG_INFO);
+    // LogComponentEnable ("ThreeGppHttpSatelliteClient", LOG_INFO);
+
+    AddTestCase(new ThreeGppHttpSatelliteFootprintTestCase(), TestCase::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("keep-alive, timeout=1s",
+                                                           Seconds(1),
+                                                           false,
+                                                           Seconds(60)),
+                TestCase::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteKeepAliveTestCase("keep-alive, timeout=1s, preconnect",
+                                                           Seconds(1),
+                                                           true,
+                                                           Seconds(60)),
+                TestCase::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteParallelTestCase("parallel, connections=4, run=1",
+                                                          4,
+                                                          1,
+                                                          false,
+                                                          Seconds(30)),
+                TestCase::QUICK);
+    AddTestCase(
+        new ThreeGppHttpSatelliteParallelTestCase("parallel, connections=4, run=22, lost request",
+                                                  4,
+                                                  22,
+                                                  true,
+                                                  Seconds(60)),
+        TestCase::QUICK);
+    AddTestCase(
+        new ThreeGppHttpSatelliteParallelTestCase("parallel, connections=2, run=1, lost request",
+                                                  2,
+                                                  1,
+                                                  true,
+                                                  Seconds(60)),
+        TestCase::QUICK);
+    AddTestCase(
+        new ThreeGppHttpSatelliteCacheTestCase("cache, HIT_PROBABILITY",
+                                               ThreeGppHttpSatelliteClient::CACHE_HIT_PROBABILITY,
+                                               Seconds(60)),
+        TestCase::QUICK);
+    AddTestCase(new ThreeGppHttpSatelliteCacheTestCase("cache, LRU",
+                                                       ThreeGppHttpSatelliteClient::CACHE_LRU,
+                                                       Seconds(100)),
+                TestCase::QUICK);
+
+    const uint64_t delayMs[3] = {3, 30, 300};
+    const uint32_t rngRun[2] = {1, 22};
+
+    for (uint8_t j = 0; j < 3; j++)
+    {
+        for (uint8_t k = 0; k < 2; k++)
+        {
+            std::ostringstream oss;
+            oss << "objects, "
+                << "delay=" << delayMs[j] << "ms, "
+                << "run=" << rngRun[k];
+            AddTestCase(new ThreeGppHttpSatelliteObjectTestCase(oss.str(),
+                                                                rngRun[k],
+                                                                MilliSeconds(delayMs[j]),
+                                                                Seconds(30)),
+                        TestCase::QUICK);
+        }
+    }
+
+} // end of `ThreeGppHttpSatelliteTestSuite ()`
+
+static ThreeGppHttpSatelliteTestSuite g_threeGppHttpSatelliteTestSuiteInstance;